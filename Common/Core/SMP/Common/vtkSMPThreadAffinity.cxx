@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadAffinity.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/Common/vtkSMPThreadAffinity.h"
+
+#include <mutex>  // For std::call_once
+#include <vector> // For std::vector
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include "vtkWindows.h"
+#endif
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+#if defined(__linux__)
+
+namespace
+{
+// Affinity of the process before any thread was pinned.
+std::once_flag ProcessMaskFlag;
+cpu_set_t ProcessMask;
+std::vector<int> AllowedCPUs;
+
+void InitializeProcessMask()
+{
+  CPU_ZERO(&ProcessMask);
+  if (sched_getaffinity(0, sizeof(ProcessMask), &ProcessMask) != 0)
+  {
+    return;
+  }
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &ProcessMask))
+    {
+      AllowedCPUs.push_back(cpu);
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPPinCurrentThread(int threadIndex)
+{
+  std::call_once(ProcessMaskFlag, InitializeProcessMask);
+  if (AllowedCPUs.empty() || threadIndex < 0)
+  {
+    return false;
+  }
+
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(AllowedCPUs[threadIndex % AllowedCPUs.size()], &mask);
+  return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPUnpinCurrentThread()
+{
+  std::call_once(ProcessMaskFlag, InitializeProcessMask);
+  if (AllowedCPUs.empty())
+  {
+    return false;
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(ProcessMask), &ProcessMask) == 0;
+}
+
+#elif defined(_WIN32)
+
+namespace
+{
+// Affinity of the process before any thread was pinned.
+std::once_flag ProcessMaskFlag;
+DWORD_PTR ProcessMask = 0;
+std::vector<DWORD_PTR> AllowedCPUs;
+
+void InitializeProcessMask()
+{
+  DWORD_PTR systemMask = 0;
+  if (!GetProcessAffinityMask(GetCurrentProcess(), &ProcessMask, &systemMask))
+  {
+    ProcessMask = 0;
+    return;
+  }
+  for (unsigned int cpu = 0; cpu < sizeof(DWORD_PTR) * 8; ++cpu)
+  {
+    const DWORD_PTR cpuMask = static_cast<DWORD_PTR>(1) << cpu;
+    if (ProcessMask & cpuMask)
+    {
+      AllowedCPUs.push_back(cpuMask);
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPPinCurrentThread(int threadIndex)
+{
+  std::call_once(ProcessMaskFlag, InitializeProcessMask);
+  if (AllowedCPUs.empty() || threadIndex < 0)
+  {
+    return false;
+  }
+  return SetThreadAffinityMask(
+           GetCurrentThread(), AllowedCPUs[threadIndex % AllowedCPUs.size()]) != 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPUnpinCurrentThread()
+{
+  std::call_once(ProcessMaskFlag, InitializeProcessMask);
+  if (AllowedCPUs.empty())
+  {
+    return false;
+  }
+  return SetThreadAffinityMask(GetCurrentThread(), ProcessMask) != 0;
+}
+
+#else
+
+//------------------------------------------------------------------------------
+bool vtkSMPPinCurrentThread(int)
+{
+  return false;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPUnpinCurrentThread()
+{
+  return false;
+}
+
+#endif
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -0,0 +1,56 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPThreadAffinity.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkSMPThreadAffinity - Thread to core pinning helpers for vtkSMPTools backends
+//
+// .SECTION Description
+// Helpers used by the STDThread and OpenMP backends of vtkSMPTools when thread
+// pinning is enabled with vtkSMPTools::SetThreadPinning(). A pinned thread
+// only runs on one logical CPU, so the memory it touches first is allocated
+// on its NUMA node and stays close to it.
+//
+// Logical CPUs are numbered among the CPUs the process was allowed to run on
+// when the first thread was pinned, so pinning respects a restriction set
+// with taskset, numactl or a job scheduler. Pinning is only implemented on
+// Linux and Windows, these functions do nothing and return false elsewhere.
+
+#ifndef vtkSMPThreadAffinity_h
+#define vtkSMPThreadAffinity_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+/**
+ * Pin the calling thread to the (threadIndex modulo the number of allowed
+ * logical CPUs)-th allowed logical CPU. Return true on success.
+ */
+bool VTKCOMMONCORE_EXPORT vtkSMPPinCurrentThread(int threadIndex);
+
+/**
+ * Let the calling thread run again on every logical CPU the process was
+ * allowed to run on. Return true on success.
+ */
+bool VTKCOMMONCORE_EXPORT vtkSMPUnpinCurrentThread();
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
@@ -200,6 +200,43 @@ bool vtkSMPToolsAPI::GetNestedParallelism()
   return false;
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPToolsAPI::SetThreadPinning(bool isPinned)
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      this->SequentialBackend->SetThreadPinning(isPinned);
+      break;
+    case BackendType::STDThread:
+      this->STDThreadBackend->SetThreadPinning(isPinned);
+      break;
+    case BackendType::TBB:
+      this->TBBBackend->SetThreadPinning(isPinned);
+      break;
+    case BackendType::OpenMP:
+      this->OpenMPBackend->SetThreadPinning(isPinned);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPToolsAPI::GetThreadPinning()
+{
+  switch (this->ActivatedBackend)
+  {
+    case BackendType::Sequential:
+      return this->SequentialBackend->GetThreadPinning();
+    case BackendType::STDThread:
+      return this->STDThreadBackend->GetThreadPinning();
+    case BackendType::TBB:
+      return this->TBBBackend->GetThreadPinning();
+    case BackendType::OpenMP:
+      return this->OpenMPBackend->GetThreadPinning();
+  }
+  return false;
+}
+
 //------------------------------------------------------------------------------
 bool vtkSMPToolsAPI::IsParallelScope()
 {
@@ -73,6 +73,12 @@ public:
   //--------------------------------------------------------------------------------
   bool GetNestedParallelism();
 
+  //------------------------------------------------------------------------------
+  void SetThreadPinning(bool isPinned);
+
+  //--------------------------------------------------------------------------------
+  bool GetThreadPinning();
+
   //--------------------------------------------------------------------------------
   bool IsParallelScope();
 
@@ -224,6 +230,106 @@ public:
     }
   }
 
+  //--------------------------------------------------------------------------------
+  template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+  T TransformReduce(Iterator begin, Iterator end, T init, BinaryOp& reduce, UnaryOp& transform)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->TransformReduce(begin, end, init, reduce, transform);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->TransformReduce(begin, end, init, reduce, transform);
+      case BackendType::TBB:
+        return this->TBBBackend->TransformReduce(begin, end, init, reduce, transform);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->TransformReduce(begin, end, init, reduce, transform);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp& op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        this->SequentialBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+        break;
+      case BackendType::STDThread:
+        this->STDThreadBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+        break;
+      case BackendType::TBB:
+        this->TBBBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+        break;
+      case BackendType::OpenMP:
+        this->OpenMPBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp& op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        this->SequentialBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+        break;
+      case BackendType::STDThread:
+        this->STDThreadBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+        break;
+      case BackendType::TBB:
+        this->TBBBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+        break;
+      case BackendType::OpenMP:
+        this->OpenMPBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Compare>
+  void StableSort(RandomAccessIterator begin, RandomAccessIterator end, Compare& comp)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        this->SequentialBackend->StableSort(begin, end, comp);
+        break;
+      case BackendType::STDThread:
+        this->STDThreadBackend->StableSort(begin, end, comp);
+        break;
+      case BackendType::TBB:
+        this->TBBBackend->StableSort(begin, end, comp);
+        break;
+      case BackendType::OpenMP:
+        this->OpenMPBackend->StableSort(begin, end, comp);
+        break;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Predicate>
+  RandomAccessIterator Partition(
+    RandomAccessIterator begin, RandomAccessIterator end, Predicate& pred)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->Partition(begin, end, pred);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->Partition(begin, end, pred);
+      case BackendType::TBB:
+        return this->TBBBackend->Partition(begin, end, pred);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->Partition(begin, end, pred);
+    }
+    return end;
+  }
+
   // disable copying
   vtkSMPToolsAPI(vtkSMPToolsAPI const&) = delete;
   void operator=(vtkSMPToolsAPI const&) = delete;
@@ -68,6 +68,12 @@ public:
   //--------------------------------------------------------------------------------
   bool GetNestedParallelism() { return this->NestedActivated; }
 
+  //--------------------------------------------------------------------------------
+  void SetThreadPinning(bool isPinned) { this->ThreadPinning = isPinned; }
+
+  //--------------------------------------------------------------------------------
+  bool GetThreadPinning() { return this->ThreadPinning; }
+
   //--------------------------------------------------------------------------------
   bool IsParallelScope() { return this->IsParallel; }
 
@@ -96,8 +102,30 @@ public:
   template <typename RandomAccessIterator, typename Compare>
   void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
 
+  //--------------------------------------------------------------------------------
+  template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+  T TransformReduce(Iterator begin, Iterator end, T init, BinaryOp reduce, UnaryOp transform);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Compare>
+  void StableSort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
+
+  //--------------------------------------------------------------------------------
+  template <typename RandomAccessIterator, typename Predicate>
+  RandomAccessIterator Partition(
+    RandomAccessIterator begin, RandomAccessIterator end, Predicate pred);
+
 private:
   bool NestedActivated = true;
+  bool ThreadPinning = false;
   bool IsParallel = false;
 };
 
@@ -16,7 +16,11 @@
 #ifndef vtkSMPToolsInternal_h
 #define vtkSMPToolsInternal_h
 
-#include <iterator> // For std::advance
+#include <algorithm>   // For std::merge, std::min
+#include <iterator>    // For std::advance
+#include <type_traits> // For std::decay
+#include <utility>     // For std::move
+#include <vector>      // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -101,6 +105,374 @@ public:
   T operator()(T vtkNotUsed(inValue)) { return Value; }
 };
 
+//--------------------------------------------------------------------------------
+// Blocked building blocks for the Reduce, Scan, StableSort and Partition
+// algorithms of the backends that only provide a parallel For.
+//
+// The input is cut into a number of blocks that only depends on its size, so
+// that the order in which partial results are combined, hence the result of
+// non exactly associative operations such as floating point sums, does not
+// depend on the number of threads nor on the scheduling.
+//--------------------------------------------------------------------------------
+const vtkIdType SMPMinimumBlockSize = 1024;
+const vtkIdType SMPMaximumNumberOfBlocks = 512;
+
+inline vtkIdType GetNumberOfBlocks(vtkIdType size)
+{
+  const vtkIdType nbOfBlocks = (size + SMPMinimumBlockSize - 1) / SMPMinimumBlockSize;
+  return std::min(std::max<vtkIdType>(nbOfBlocks, 1), SMPMaximumNumberOfBlocks);
+}
+
+inline vtkIdType GetBlockBegin(vtkIdType block, vtkIdType nbOfBlocks, vtkIdType size)
+{
+  return block * (size / nbOfBlocks) + std::min(block, size % nbOfBlocks);
+}
+
+// Adapts a functor with a (first, last) call operator to the interface
+// expected by the backend For methods.
+template <typename Functor>
+struct BlockFunctorCall
+{
+  Functor& F;
+
+  void Execute(vtkIdType first, vtkIdType last) { this->F(first, last); }
+};
+
+template <typename Backend, typename Functor>
+void ForEachBlock(Backend& backend, vtkIdType nbOfBlocks, Functor& functor)
+{
+  BlockFunctorCall<Functor> call{ functor };
+  backend.For(0, nbOfBlocks, 1, call);
+}
+
+struct IdentityFunctor
+{
+  template <typename T>
+  T&& operator()(T&& value) const
+  {
+    return std::forward<T>(value);
+  }
+};
+
+//--------------------------------------------------------------------------------
+template <typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+T BlockedTransformReduceSerial(
+  InputIt begin, InputIt end, T init, BinaryOp& reduce, UnaryOp& transform)
+{
+  for (; begin != end; ++begin)
+  {
+    init = reduce(init, transform(*begin));
+  }
+  return init;
+}
+
+//--------------------------------------------------------------------------------
+template <typename Backend, typename InputIt, typename T, typename BinaryOp, typename UnaryOp>
+T BlockedTransformReduce(
+  Backend& backend, InputIt begin, InputIt end, T init, BinaryOp& reduce, UnaryOp& transform)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return init;
+  }
+
+  const vtkIdType nbOfBlocks = GetNumberOfBlocks(size);
+  std::vector<T> partials(nbOfBlocks, init);
+  auto reduceBlocks = [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+    for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+    {
+      const vtkIdType blockBegin = GetBlockBegin(block, nbOfBlocks, size);
+      const vtkIdType blockEnd = GetBlockBegin(block + 1, nbOfBlocks, size);
+      InputIt it(begin);
+      std::advance(it, blockBegin);
+      T value = transform(*it);
+      for (vtkIdType i = blockBegin + 1; i < blockEnd; ++i)
+      {
+        ++it;
+        value = reduce(value, transform(*it));
+      }
+      partials[block] = std::move(value);
+    }
+  };
+  ForEachBlock(backend, nbOfBlocks, reduceBlocks);
+
+  for (vtkIdType block = 0; block < nbOfBlocks; ++block)
+  {
+    init = reduce(init, partials[block]);
+  }
+  return init;
+}
+
+//--------------------------------------------------------------------------------
+// Two passes scan: reduce each block, scan the block sums sequentially, then
+// scan each block again starting from its carry. For an inclusive scan init is
+// only used to construct the temporary values and is not part of the result.
+template <bool Exclusive, typename Backend, typename InputIt, typename OutputIt, typename T,
+  typename BinaryOp>
+void BlockedScan(
+  Backend& backend, InputIt begin, InputIt end, OutputIt outBegin, T init, BinaryOp& op)
+{
+  const vtkIdType size = std::distance(begin, end);
+  if (size <= 0)
+  {
+    return;
+  }
+
+  const vtkIdType nbOfBlocks = GetNumberOfBlocks(size);
+  IdentityFunctor identity;
+
+  // carries[b] holds the combination of every value before block b. The first
+  // block of an inclusive scan has no carry.
+  std::vector<T> carries(nbOfBlocks, init);
+  if (nbOfBlocks > 1)
+  {
+    std::vector<T> partials(nbOfBlocks, init);
+    auto reduceBlocks = [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        InputIt blockBegin(begin);
+        std::advance(blockBegin, GetBlockBegin(block, nbOfBlocks, size));
+        InputIt blockEnd(blockBegin);
+        std::advance(blockEnd,
+          GetBlockBegin(block + 1, nbOfBlocks, size) - GetBlockBegin(block, nbOfBlocks, size));
+        T first = *blockBegin;
+        partials[block] = BlockedTransformReduceSerial(++blockBegin, blockEnd, first, op, identity);
+      }
+    };
+    ForEachBlock(backend, nbOfBlocks - 1, reduceBlocks);
+
+    carries[1] = Exclusive ? op(init, partials[0]) : partials[0];
+    for (vtkIdType block = 2; block < nbOfBlocks; ++block)
+    {
+      carries[block] = op(carries[block - 1], partials[block - 1]);
+    }
+  }
+
+  auto scanBlocks = [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+    for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+    {
+      const vtkIdType blockBegin = GetBlockBegin(block, nbOfBlocks, size);
+      const vtkIdType blockEnd = GetBlockBegin(block + 1, nbOfBlocks, size);
+      InputIt in(begin);
+      std::advance(in, blockBegin);
+      OutputIt out(outBegin);
+      std::advance(out, blockBegin);
+      vtkIdType i = blockBegin;
+      T value = carries[block];
+      if (!Exclusive && block == 0)
+      {
+        value = *in;
+        *out = value;
+        ++in;
+        ++out;
+        ++i;
+      }
+      for (; i < blockEnd; ++i, ++in, ++out)
+      {
+        // Read before writing so that the scan can be done in place.
+        T current = *in;
+        if (Exclusive)
+        {
+          *out = value;
+          value = op(value, current);
+        }
+        else
+        {
+          value = op(value, current);
+          *out = value;
+        }
+      }
+    }
+  };
+  ForEachBlock(backend, nbOfBlocks, scanBlocks);
+}
+
+//--------------------------------------------------------------------------------
+// Number of elements of [a, a + sizeA) within the first diagonal elements of
+// the stable merge of [a, a + sizeA) and [b, b + sizeB).
+template <typename RandomAccessIterator, typename Compare>
+vtkIdType MergePath(RandomAccessIterator a, vtkIdType sizeA, RandomAccessIterator b,
+  vtkIdType sizeB, vtkIdType diagonal, Compare& comp)
+{
+  vtkIdType low = std::max<vtkIdType>(0, diagonal - sizeB);
+  vtkIdType high = std::min(diagonal, sizeA);
+  while (low < high)
+  {
+    const vtkIdType middle = low + (high - low) / 2;
+    // Stability: a[middle] goes first unless b[diagonal - middle - 1] is strictly smaller.
+    if (!comp(b[diagonal - middle - 1], a[middle]))
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+//--------------------------------------------------------------------------------
+// Merge the output elements [diagBegin, diagEnd) of the two consecutive sorted
+// runs of in starting at pairBegin into out.
+template <typename InputIt, typename OutputIt, typename Compare>
+void MergePiece(InputIt in, OutputIt out, vtkIdType pairBegin, vtkIdType sizeA, vtkIdType sizeB,
+  vtkIdType diagBegin, vtkIdType diagEnd, Compare& comp)
+{
+  InputIt a = in + pairBegin;
+  InputIt b = a + sizeA;
+  const vtkIdType aBegin = MergePath(a, sizeA, b, sizeB, diagBegin, comp);
+  const vtkIdType aEnd = MergePath(a, sizeA, b, sizeB, diagEnd, comp);
+  std::merge(std::make_move_iterator(a + aBegin), std::make_move_iterator(a + aEnd),
+    std::make_move_iterator(b + (diagBegin - aBegin)),
+    std::make_move_iterator(b + (diagEnd - aEnd)), out + pairBegin + diagBegin, comp);
+}
+
+//--------------------------------------------------------------------------------
+// Parallel stable merge sort: sort every block with std::stable_sort, then
+// merge the sorted runs two by two. Each merge round is cut in pieces with
+// MergePath so that the last rounds, which merge a few large runs, still run
+// in parallel. The value type must be default constructible.
+template <typename Backend, typename RandomAccessIterator, typename Compare>
+void BlockedStableSort(
+  Backend& backend, RandomAccessIterator begin, RandomAccessIterator end, Compare& comp)
+{
+  using ValueType = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  const vtkIdType size = std::distance(begin, end);
+  const vtkIdType nbOfBlocks = GetNumberOfBlocks(size);
+  if (nbOfBlocks <= 1)
+  {
+    std::stable_sort(begin, end, comp);
+    return;
+  }
+
+  auto sortBlocks = [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+    for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+    {
+      std::stable_sort(begin + GetBlockBegin(block, nbOfBlocks, size),
+        begin + GetBlockBegin(block + 1, nbOfBlocks, size), comp);
+    }
+  };
+  ForEachBlock(backend, nbOfBlocks, sortBlocks);
+
+  std::vector<ValueType> buffer(size);
+  bool inBuffer = false;
+  for (vtkIdType runWidth = 1; runWidth < nbOfBlocks; runWidth *= 2)
+  {
+    const vtkIdType nbOfPairs = (nbOfBlocks + 2 * runWidth - 1) / (2 * runWidth);
+    // Keep about nbOfBlocks pieces per round.
+    const vtkIdType piecesPerPair = std::max<vtkIdType>(1, nbOfBlocks / nbOfPairs);
+
+    auto mergePieces = [&](vtkIdType firstPiece, vtkIdType lastPiece) {
+      for (vtkIdType piece = firstPiece; piece < lastPiece; ++piece)
+      {
+        const vtkIdType pair = piece / piecesPerPair;
+        const vtkIdType pairPiece = piece % piecesPerPair;
+        const vtkIdType pairBegin = GetBlockBegin(
+          std::min(2 * pair * runWidth, nbOfBlocks), nbOfBlocks, size);
+        const vtkIdType pairMiddle = GetBlockBegin(
+          std::min((2 * pair + 1) * runWidth, nbOfBlocks), nbOfBlocks, size);
+        const vtkIdType pairEnd = GetBlockBegin(
+          std::min((2 * pair + 2) * runWidth, nbOfBlocks), nbOfBlocks, size);
+        const vtkIdType pairSize = pairEnd - pairBegin;
+        const vtkIdType sizeA = pairMiddle - pairBegin;
+        const vtkIdType sizeB = pairEnd - pairMiddle;
+        const vtkIdType diagBegin = GetBlockBegin(pairPiece, piecesPerPair, pairSize);
+        const vtkIdType diagEnd = GetBlockBegin(pairPiece + 1, piecesPerPair, pairSize);
+
+        if (inBuffer)
+        {
+          MergePiece(buffer.begin(), begin, pairBegin, sizeA, sizeB, diagBegin, diagEnd, comp);
+        }
+        else
+        {
+          MergePiece(begin, buffer.begin(), pairBegin, sizeA, sizeB, diagBegin, diagEnd, comp);
+        }
+      }
+    };
+    ForEachBlock(backend, nbOfPairs * piecesPerPair, mergePieces);
+    inBuffer = !inBuffer;
+  }
+
+  if (inBuffer)
+  {
+    auto copyBack = [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+      std::move(buffer.begin() + GetBlockBegin(firstBlock, nbOfBlocks, size),
+        buffer.begin() + GetBlockBegin(lastBlock, nbOfBlocks, size),
+        begin + GetBlockBegin(firstBlock, nbOfBlocks, size));
+    };
+    ForEachBlock(backend, nbOfBlocks, copyBack);
+  }
+}
+
+//--------------------------------------------------------------------------------
+// Stable parallel partition: flag and count the elements of each block that
+// satisfy the predicate, scan the counts, scatter every block to its place in a
+// buffer and move the buffer back. The value type must be default constructible.
+template <typename Backend, typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator BlockedPartition(
+  Backend& backend, RandomAccessIterator begin, RandomAccessIterator end, Predicate& pred)
+{
+  using ValueType = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  const vtkIdType size = std::distance(begin, end);
+  const vtkIdType nbOfBlocks = GetNumberOfBlocks(size);
+  if (nbOfBlocks <= 1)
+  {
+    return std::stable_partition(begin, end, pred);
+  }
+
+  std::vector<unsigned char> flags(size);
+  std::vector<vtkIdType> trueOffsets(nbOfBlocks + 1, 0);
+  auto countBlocks = [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+    for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+    {
+      vtkIdType count = 0;
+      const vtkIdType blockEnd = GetBlockBegin(block + 1, nbOfBlocks, size);
+      for (vtkIdType i = GetBlockBegin(block, nbOfBlocks, size); i < blockEnd; ++i)
+      {
+        flags[i] = pred(begin[i]) ? 1 : 0;
+        count += flags[i];
+      }
+      trueOffsets[block + 1] = count;
+    }
+  };
+  ForEachBlock(backend, nbOfBlocks, countBlocks);
+
+  for (vtkIdType block = 0; block < nbOfBlocks; ++block)
+  {
+    trueOffsets[block + 1] += trueOffsets[block];
+  }
+  const vtkIdType nbOfTrues = trueOffsets[nbOfBlocks];
+
+  std::vector<ValueType> buffer(size);
+  auto scatterBlocks = [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+    for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+    {
+      const vtkIdType blockBegin = GetBlockBegin(block, nbOfBlocks, size);
+      const vtkIdType blockEnd = GetBlockBegin(block + 1, nbOfBlocks, size);
+      vtkIdType trueId = trueOffsets[block];
+      vtkIdType falseId = nbOfTrues + blockBegin - trueOffsets[block];
+      for (vtkIdType i = blockBegin; i < blockEnd; ++i)
+      {
+        buffer[flags[i] ? trueId++ : falseId++] = std::move(begin[i]);
+      }
+    }
+  };
+  ForEachBlock(backend, nbOfBlocks, scatterBlocks);
+
+  auto copyBack = [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+    std::move(buffer.begin() + GetBlockBegin(firstBlock, nbOfBlocks, size),
+      buffer.begin() + GetBlockBegin(lastBlock, nbOfBlocks, size),
+      begin + GetBlockBegin(firstBlock, nbOfBlocks, size));
+  };
+  ForEachBlock(backend, nbOfBlocks, copyBack);
+
+  return begin + nbOfTrues;
+}
+
 } // namespace smp
 } // namespace detail
 } // namespace vtk
@@ -13,6 +13,7 @@
 
 =========================================================================*/
 
+#include "SMP/Common/vtkSMPThreadAffinity.h" // For vtkSMPPinCurrentThread
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/OpenMP/vtkSMPToolsImpl.txx"
 
@@ -27,6 +28,40 @@ namespace smp
 {
 static int specifiedNumThreads = 0;
 
+// Index of the CPU the calling thread is pinned to, -1 if it is not pinned.
+static thread_local int pinnedThreadIndex = -1;
+
+//------------------------------------------------------------------------------
+// Pin or unpin the calling thread of an outermost parallel region. Nested
+// regions keep the affinity of the thread that created them. The master thread
+// is the calling thread of vtkSMPTools: it is only pinned for the duration of
+// the region, return true if it has to be unpinned at the end of it.
+static bool UpdateThreadPinningOpenMP(bool threadPinning)
+{
+  if (omp_get_level() != 1)
+  {
+    return false;
+  }
+  const int threadIndex = threadPinning ? omp_get_thread_num() : -1;
+  if (threadIndex == 0)
+  {
+    return vtkSMPPinCurrentThread(threadIndex);
+  }
+  if (threadIndex != pinnedThreadIndex)
+  {
+    if (threadPinning)
+    {
+      vtkSMPPinCurrentThread(threadIndex);
+    }
+    else
+    {
+      vtkSMPUnpinCurrentThread();
+    }
+    pinnedThreadIndex = threadIndex;
+  }
+  return false;
+}
+
 //------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::OpenMP>::Initialize(int numThreads)
@@ -69,7 +104,7 @@ int vtkSMPToolsImpl<BackendType::OpenMP>::GetEstimatedNumberOfThreads()
 
 //------------------------------------------------------------------------------
 void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
-  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated)
+  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated, bool threadPinning)
 {
   if (grain <= 0)
   {
@@ -79,10 +114,20 @@ void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
 
   omp_set_nested(nestedActivated);
 
-#pragma omp parallel for schedule(runtime)
-  for (vtkIdType from = first; from < last; from += grain)
+#pragma omp parallel
   {
-    functorExecuter(functor, from, grain, last);
+    const bool unpinMaster = UpdateThreadPinningOpenMP(threadPinning);
+
+#pragma omp for schedule(runtime)
+    for (vtkIdType from = first; from < last; from += grain)
+    {
+      functorExecuter(functor, from, grain, last);
+    }
+
+    if (unpinMaster)
+    {
+      vtkSMPUnpinCurrentThread();
+    }
   }
 }
 
@@ -31,7 +31,7 @@ namespace smp
 
 int VTKCOMMONCORE_EXPORT GetNumberOfThreadsOpenMP();
 void VTKCOMMONCORE_EXPORT vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
-  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated);
+  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated, bool threadPinning);
 
 //--------------------------------------------------------------------------------
 template <typename FunctorInternal>
@@ -68,8 +68,8 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::For(
     bool fromParallelCode = this->IsParallel;
     this->IsParallel = true;
 
-    vtkSMPToolsImplForOpenMP(
-      first, last, grain, ExecuteFunctorOpenMP<FunctorInternal>, &fi, this->NestedActivated);
+    vtkSMPToolsImplForOpenMP(first, last, grain, ExecuteFunctorOpenMP<FunctorInternal>, &fi,
+      this->NestedActivated, this->ThreadPinning);
 
     this->IsParallel &= fromParallelCode;
   }
@@ -130,6 +130,56 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+T vtkSMPToolsImpl<BackendType::OpenMP>::TransformReduce(
+  Iterator begin, Iterator end, T init, BinaryOp reduce, UnaryOp transform)
+{
+  return BlockedTransformReduce(*this, begin, end, init, reduce, transform);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::OpenMP>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  if (inBegin != inEnd)
+  {
+    using ValueType = typename std::decay<decltype(op(*inBegin, *inBegin))>::type;
+    ValueType first = *inBegin;
+    BlockedScan<false>(*this, inBegin, inEnd, outBegin, first, op);
+  }
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::OpenMP>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  BlockedScan<true>(*this, inBegin, inEnd, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::OpenMP>::StableSort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  BlockedStableSort(*this, begin, end, comp);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator vtkSMPToolsImpl<BackendType::OpenMP>::Partition(
+  RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+{
+  return BlockedPartition(*this, begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::OpenMP>::Initialize(int);
@@ -14,61 +14,317 @@
 =========================================================================*/
 
 #include "SMP/STDThread/vtkSMPThreadPool.h"
+#include "SMP/Common/vtkSMPThreadAffinity.h" // For vtkSMPPinCurrentThread
 
-#include <iostream>
+#include <algorithm> // For std::max
+#include <deque>     // For std::deque
 
-vtk::detail::smp::vtkSMPThreadPool::vtkSMPThreadPool(int threadNumber)
+namespace vtk
 {
+namespace detail
+{
+namespace smp
+{
+
+namespace
+{
+// Pool and queue index of the calling thread when it is a worker.
+thread_local vtkSMPThreadPool* CurrentPool = nullptr;
+thread_local std::size_t CurrentQueueId = 0;
+
+std::mutex InstanceMutex;
+std::shared_ptr<vtkSMPThreadPool> Instance;
+}
+
+//------------------------------------------------------------------------------
+// A TaskGroup holds everything shared by the tasks of one ParallelFor() call.
+// It lives on the stack of the calling thread.
+struct vtkSMPThreadPool::TaskGroup
+{
+  ExecuteFunctorType Executer;
+  void* Functor;
+  vtkIdType Grain;
+
+  // Number of tasks of this group that are queued or running.
+  std::atomic<vtkIdType> Pending{ 1 };
+
+  // External (non-worker) callers sleep until Done is set instead of helping.
+  bool External;
+  bool Done = false;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+};
+
+//------------------------------------------------------------------------------
+// A Task is a grain aligned sub-range of a TaskGroup range.
+struct vtkSMPThreadPool::Task
+{
+  TaskGroup* Group;
+  vtkIdType First;
+  vtkIdType Last;
+};
+
+//------------------------------------------------------------------------------
+// The owner thread pushes and pops at the back, thieves steal at the front.
+// The mutex is only contended when a thief and the owner meet on a queue.
+struct vtkSMPThreadPool::TaskQueue
+{
+  std::mutex Mutex;
+  std::deque<Task> Tasks;
+  std::atomic<std::size_t> Size{ 0 };
+};
+
+//------------------------------------------------------------------------------
+vtkSMPThreadPool::vtkSMPThreadPool(int threadNumber, bool threadPinning)
+  : ThreadPinning(threadPinning)
+  , PendingTasks(0)
+  , SleepingThreads(0)
+  , Joining(false)
+{
+  threadNumber = std::max(threadNumber, 1);
+
+  // One queue per worker plus one queue for tasks submitted by external threads.
+  this->Queues.reserve(threadNumber + 1);
+  for (int i = 0; i <= threadNumber; ++i)
+  {
+    this->Queues.emplace_back(new TaskQueue);
+  }
+
   this->Threads.reserve(threadNumber);
   for (int i = 0; i < threadNumber; ++i)
   {
-    this->Threads.emplace_back(std::bind(&vtkSMPThreadPool::ThreadJob, this));
+    this->Threads.emplace_back(&vtkSMPThreadPool::ThreadJob, this, i);
   }
 }
 
-void vtk::detail::smp::vtkSMPThreadPool::Join()
+//------------------------------------------------------------------------------
+vtkSMPThreadPool::~vtkSMPThreadPool()
 {
   {
-    std::unique_lock<std::mutex> lock(this->Mutex);
-
+    std::lock_guard<std::mutex> lock(this->SleepMutex);
     this->Joining = true;
-    this->ConditionVariable.notify_all();
+    this->SleepCondition.notify_all();
   }
 
-  for (auto& it : this->Threads)
+  for (auto& thread : this->Threads)
   {
-    it.join();
+    thread.join();
   }
 }
 
-void vtk::detail::smp::vtkSMPThreadPool::DoJob(std::function<void(void)> job)
+//------------------------------------------------------------------------------
+std::shared_ptr<vtkSMPThreadPool> vtkSMPThreadPool::GetInstance(
+  int threadNumber, bool threadPinning)
 {
-  std::unique_lock<std::mutex> lock(this->Mutex);
+  if (CurrentPool)
+  {
+    return CurrentPool->shared_from_this();
+  }
 
-  this->JobQueue.emplace(std::move(job));
-  this->ConditionVariable.notify_one();
+  std::lock_guard<std::mutex> lock(InstanceMutex);
+  // Only replace the pool when the global reference is the last one, i.e. no
+  // other thread is running a ParallelFor on it. The old pool is joined here.
+  if (!Instance ||
+    ((Instance->GetNumberOfThreads() != threadNumber ||
+       Instance->GetThreadPinning() != threadPinning) &&
+      Instance.use_count() == 1))
+  {
+    Instance.reset();
+    Instance = std::make_shared<vtkSMPThreadPool>(threadNumber, threadPinning);
+  }
+  return Instance;
 }
 
-void vtk::detail::smp::vtkSMPThreadPool::ThreadJob()
+//------------------------------------------------------------------------------
+bool vtkSMPThreadPool::IsWorkerThread()
 {
-  std::function<void(void)> job;
+  return CurrentPool != nullptr;
+}
 
-  while (true)
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorType functorExecuter, void* functor)
+{
+  if (first >= last)
+  {
+    return;
+  }
+
+  const bool fromWorker = (CurrentPool == this);
+
+  TaskGroup group;
+  group.Executer = functorExecuter;
+  group.Functor = functor;
+  group.Grain = std::max<vtkIdType>(grain, 1);
+  group.External = !fromWorker;
+
+  if (!fromWorker)
+  {
+    this->Push(this->Queues.size() - 1, Task{ &group, first, last });
+
+    std::unique_lock<std::mutex> lock(group.Mutex);
+    group.Condition.wait(lock, [&group] { return group.Done; });
+    return;
+  }
+
+  // Nested parallel for: push the range on our own queue and keep executing
+  // tasks (ours first, then stolen ones) until every task of the group is done.
+  const std::size_t queueId = CurrentQueueId;
+  this->Push(queueId, Task{ &group, first, last });
+
+  Task task;
+  while (group.Pending.load() != 0)
+  {
+    if (this->Pop(queueId, task) || this->Steal(queueId, task))
+    {
+      this->RunTask(queueId, task);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::Push(std::size_t queueId, const Task& task)
+{
+  TaskQueue& queue = *this->Queues[queueId];
   {
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    queue.Tasks.push_back(task);
+    ++queue.Size;
+  }
+
+  ++this->PendingTasks;
+  if (this->SleepingThreads.load() > 0)
+  {
+    std::lock_guard<std::mutex> lock(this->SleepMutex);
+    this->SleepCondition.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPThreadPool::Pop(std::size_t queueId, Task& task)
+{
+  TaskQueue& queue = *this->Queues[queueId];
+  if (queue.Size.load() == 0)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(queue.Mutex);
+  if (queue.Tasks.empty())
+  {
+    return false;
+  }
+  task = queue.Tasks.back();
+  queue.Tasks.pop_back();
+  --queue.Size;
+  --this->PendingTasks;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPThreadPool::Steal(std::size_t thiefId, Task& task)
+{
+  const std::size_t nbOfQueues = this->Queues.size();
+  for (std::size_t i = 1; i <= nbOfQueues; ++i)
+  {
+    TaskQueue& queue = *this->Queues[(thiefId + i) % nbOfQueues];
+    if (queue.Size.load() == 0)
     {
-      std::unique_lock<std::mutex> lock(this->Mutex);
+      continue;
+    }
 
-      this->ConditionVariable.wait(
-        lock, [this] { return (!this->JobQueue.empty() || this->Joining); });
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (!queue.Tasks.empty())
+    {
+      // The oldest task is the largest remaining range of its group.
+      task = queue.Tasks.front();
+      queue.Tasks.pop_front();
+      --queue.Size;
+      --this->PendingTasks;
+      return true;
+    }
+  }
+  return false;
+}
 
-      if (this->JobQueue.empty())
-      {
-        return;
-      }
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::RunTask(std::size_t queueId, Task& task)
+{
+  TaskGroup* group = task.Group;
+  const vtkIdType grain = group->Grain;
+  const TaskQueue& queue = *this->Queues[queueId];
 
-      job = std::move(this->JobQueue.front());
-      this->JobQueue.pop();
+  while (task.Last - task.First > grain)
+  {
+    if (queue.Size.load() == 0)
+    {
+      // Nothing left for the thieves: expose the upper half of the range.
+      const vtkIdType nbOfChunks = (task.Last - task.First + grain - 1) / grain;
+      const vtkIdType middle = task.First + (nbOfChunks / 2) * grain;
+      ++group->Pending;
+      this->Push(queueId, Task{ group, middle, task.Last });
+      task.Last = middle;
     }
-    job();
+    else
+    {
+      group->Executer(group->Functor, task.First, grain, task.Last);
+      task.First += grain;
+    }
+  }
+  group->Executer(group->Functor, task.First, grain, task.Last);
+
+  vtkSMPThreadPool::FinishTask(group);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::FinishTask(TaskGroup* group)
+{
+  // Copy External before decrementing: a worker waiting on this group may
+  // return (and destroy the group) as soon as Pending reaches zero.
+  const bool external = group->External;
+  if (group->Pending.fetch_sub(1) == 1 && external)
+  {
+    std::lock_guard<std::mutex> lock(group->Mutex);
+    group->Done = true;
+    group->Condition.notify_all();
   }
 }
+
+//------------------------------------------------------------------------------
+void vtkSMPThreadPool::ThreadJob(int threadId)
+{
+  CurrentPool = this;
+  CurrentQueueId = static_cast<std::size_t>(threadId);
+  if (this->ThreadPinning)
+  {
+    vtkSMPPinCurrentThread(threadId);
+  }
+
+  Task task;
+  while (true)
+  {
+    if (this->Pop(CurrentQueueId, task) || this->Steal(CurrentQueueId, task))
+    {
+      this->RunTask(CurrentQueueId, task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->SleepMutex);
+    ++this->SleepingThreads;
+    this->SleepCondition.wait(
+      lock, [this] { return this->PendingTasks.load() > 0 || this->Joining.load(); });
+    --this->SleepingThreads;
+    if (this->Joining && this->PendingTasks.load() == 0)
+    {
+      return;
+    }
+  }
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
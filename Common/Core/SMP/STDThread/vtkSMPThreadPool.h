@@ -12,14 +12,33 @@
     PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
-// .NAME vtkSMPThreadPool - A thread pool implementation using std::thread
+// .NAME vtkSMPThreadPool - A work-stealing thread pool implementation using std::thread
 //
 // .SECTION Description
-// vtkSMPThreadPool class creates a thread pool of std::thread, the number
-// of thread must be specified at the initialization of the class.
-// The DoJob() method is used attributes the job to a free thread, if all
-// threads are working, the job is kept in a queue. Note that vtkSMPThreadPool
-// destructor joins threads and finish the jobs in the queue.
+// vtkSMPThreadPool is a persistent pool of std::thread used by the STDThread
+// backend of vtkSMPTools. Each worker owns a double-ended task queue: it pushes
+// and pops tasks at the back of its own queue while idle workers steal from the
+// front of the other queues, so the execution of a parallel for never goes
+// through a single shared lock.
+//
+// A task is a range of indices. Ranges are split lazily, in grain-aligned
+// halves, only when the worker executing them has nothing left in its own
+// queue for the others to steal ("lazy binary splitting"). The functor is
+// always invoked on chunks [first + k * grain, first + (k + 1) * grain), the
+// same chunks as a plain loop over the range would produce.
+//
+// ParallelFor() may be called from a worker thread (nested parallelism). In
+// that case the new range is pushed on the calling worker queue and the caller
+// keeps executing tasks until the nested range is done, so nested loops reuse
+// the idle workers of the pool instead of spawning new threads.
+//
+// The pool is shared: use GetInstance() to get the pool sized with the
+// requested number of threads. A pool is only resized when no other thread is
+// currently using it.
+//
+// When created with threadPinning set, the i-th worker is pinned to the i-th
+// logical CPU the process is allowed to run on, so that a worker keeps the
+// NUMA node of the memory it touched first.
 
 #ifndef vtkSMPThreadPool_h
 #define vtkSMPThreadPool_h
@@ -27,11 +46,12 @@
 #include "vtkCommonCoreModule.h" // For export macro
 #include "vtkSystemIncludes.h"
 
+#include <atomic>             // For std::atomic
 #include <condition_variable> // For std::condition_variable
-#include <functional>         // For std::function
+#include <memory>             // For std::shared_ptr, std::enable_shared_from_this
 #include <mutex>              // For std::mutex
-#include <queue>              // For std::queue
 #include <thread>             // For std::thread
+#include <vector>             // For std::vector
 
 namespace vtk
 {
@@ -41,22 +61,64 @@ namespace smp
 {
 
 class VTKCOMMONCORE_EXPORT vtkSMPThreadPool
+  : public std::enable_shared_from_this<vtkSMPThreadPool>
 {
 public:
-  explicit vtkSMPThreadPool(int ThreadNumber);
+  using ExecuteFunctorType = void (*)(void*, vtkIdType, vtkIdType, vtkIdType);
 
-  void Join();
-  void DoJob(std::function<void(void)> job);
+  explicit vtkSMPThreadPool(int threadNumber, bool threadPinning = false);
+  ~vtkSMPThreadPool();
 
-private:
-  void ThreadJob();
+  /**
+   * Return a pool with threadNumber workers, pinned to logical CPUs if
+   * threadPinning is true. The returned pool may have a different size or
+   * pinning if another thread is running a parallel for on the current one.
+   * When called from a worker thread, the pool owning that worker is returned.
+   */
+  static std::shared_ptr<vtkSMPThreadPool> GetInstance(
+    int threadNumber, bool threadPinning = false);
+
+  /**
+   * Execute functorExecuter(functor, from, grain, last) on every chunk of
+   * [first, last) and return once all chunks have been processed.
+   * grain must be strictly positive.
+   */
+  void ParallelFor(vtkIdType first, vtkIdType last, vtkIdType grain,
+    ExecuteFunctorType functorExecuter, void* functor);
+
+  /**
+   * Return true if the calling thread is a worker of any vtkSMPThreadPool.
+   */
+  static bool IsWorkerThread();
+
+  int GetNumberOfThreads() const { return static_cast<int>(this->Threads.size()); }
+
+  bool GetThreadPinning() const { return this->ThreadPinning; }
+
+  vtkSMPThreadPool(const vtkSMPThreadPool&) = delete;
+  void operator=(const vtkSMPThreadPool&) = delete;
 
 private:
-  std::mutex Mutex;
-  bool Joining = false;
-  std::condition_variable ConditionVariable;
-  std::queue<std::function<void(void)>> JobQueue;
+  struct TaskGroup;
+  struct Task;
+  struct TaskQueue;
+
+  void ThreadJob(int threadId);
+  void Push(std::size_t queueId, const Task& task);
+  bool Pop(std::size_t queueId, Task& task);
+  bool Steal(std::size_t thiefId, Task& task);
+  void RunTask(std::size_t queueId, Task& task);
+  static void FinishTask(TaskGroup* group);
+
+  std::vector<std::unique_ptr<TaskQueue>> Queues;
   std::vector<std::thread> Threads;
+  const bool ThreadPinning;
+
+  std::atomic<vtkIdType> PendingTasks;
+  std::atomic<int> SleepingThreads;
+  std::atomic<bool> Joining;
+  std::mutex SleepMutex;
+  std::condition_variable SleepCondition;
 };
 
 } // namespace smp
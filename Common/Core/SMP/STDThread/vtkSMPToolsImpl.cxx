@@ -14,6 +14,7 @@
 =========================================================================*/
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
+#include "SMP/STDThread/vtkSMPThreadPool.h" // For vtkSMPThreadPool
 #include "SMP/STDThread/vtkSMPToolsImpl.txx"
 
 #include <cstdlib> // For std::getenv()
@@ -64,6 +65,23 @@ int vtkSMPToolsImpl<BackendType::STDThread>::GetEstimatedNumberOfThreads()
   return GetNumberOfThreadsSTDThread();
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPToolsImplForSTDThread(vtkIdType first, vtkIdType last, vtkIdType grain,
+  ExecuteFunctorPtrType functorExecuter, void* functor, bool threadPinning)
+{
+  const int threadNumber = GetNumberOfThreadsSTDThread();
+
+  if (grain <= 0)
+  {
+    vtkIdType estimateGrain = (last - first) / (threadNumber * 4);
+    grain = (estimateGrain > 0) ? estimateGrain : 1;
+  }
+
+  // Nested calls from a worker thread reuse the pool of that worker.
+  auto pool = vtkSMPThreadPool::GetInstance(threadNumber, threadPinning);
+  pool->ParallelFor(first, last, grain, functorExecuter, functor);
+}
+
 } // namespace smp
 } // namespace detail
 } // namespace vtk
@@ -16,12 +16,10 @@
 #ifndef STDThreadvtkSMPToolsImpl_txx
 #define STDThreadvtkSMPToolsImpl_txx
 
-#include <algorithm>  // For std::sort
-#include <functional> // For std::bind
+#include <algorithm> // For std::sort
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
-#include "SMP/STDThread/vtkSMPThreadPool.h" // For vtkSMPThreadPool
 #include "vtkCommonCoreModule.h"            // For export macro
 
 namespace vtk
@@ -32,6 +30,8 @@ namespace smp
 {
 
 int VTKCOMMONCORE_EXPORT GetNumberOfThreadsSTDThread();
+void VTKCOMMONCORE_EXPORT vtkSMPToolsImplForSTDThread(vtkIdType first, vtkIdType last,
+  vtkIdType grain, ExecuteFunctorPtrType functorExecuter, void* functor, bool threadPinning);
 
 //--------------------------------------------------------------------------------
 template <typename FunctorInternal>
@@ -61,14 +61,6 @@ void vtkSMPToolsImpl<BackendType::STDThread>::For(
   }
   else
   {
-    int threadNumber = GetNumberOfThreadsSTDThread();
-
-    if (grain <= 0)
-    {
-      vtkIdType estimateGrain = (last - first) / (threadNumber * 4);
-      grain = (estimateGrain > 0) ? estimateGrain : 1;
-    }
-
     // this->IsParallel may have threads conficts but it will be always between true and true,
     // it is set to false only in sequential code.
     // /!\ This behaviour should be changed if we want more control on nested
@@ -76,13 +68,8 @@ void vtkSMPToolsImpl<BackendType::STDThread>::For(
     bool fromParallelCode = this->IsParallel;
     this->IsParallel = true;
 
-    vtkSMPThreadPool pool(threadNumber);
-    for (vtkIdType from = first; from < last; from += grain)
-    {
-      auto job = std::bind(ExecuteFunctorSTDThread<FunctorInternal>, &fi, from, grain, last);
-      pool.DoJob(job);
-    }
-    pool.Join();
+    vtkSMPToolsImplForSTDThread(
+      first, last, grain, ExecuteFunctorSTDThread<FunctorInternal>, &fi, this->ThreadPinning);
 
     this->IsParallel &= fromParallelCode;
   }
@@ -143,6 +130,56 @@ void vtkSMPToolsImpl<BackendType::STDThread>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+T vtkSMPToolsImpl<BackendType::STDThread>::TransformReduce(
+  Iterator begin, Iterator end, T init, BinaryOp reduce, UnaryOp transform)
+{
+  return BlockedTransformReduce(*this, begin, end, init, reduce, transform);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::STDThread>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  if (inBegin != inEnd)
+  {
+    using ValueType = typename std::decay<decltype(op(*inBegin, *inBegin))>::type;
+    ValueType first = *inBegin;
+    BlockedScan<false>(*this, inBegin, inEnd, outBegin, first, op);
+  }
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::STDThread>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  BlockedScan<true>(*this, inBegin, inEnd, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::STDThread>::StableSort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  BlockedStableSort(*this, begin, end, comp);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator vtkSMPToolsImpl<BackendType::STDThread>::Partition(
+  RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+{
+  return BlockedPartition(*this, begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::STDThread>::Initialize(int);
@@ -16,7 +16,8 @@
 #ifndef SequentialvtkSMPToolsImpl_txx
 #define SequentialvtkSMPToolsImpl_txx
 
-#include <algorithm> // For std::sort, std::transform, std::fill
+#include <algorithm>   // For std::sort, std::transform, std::fill, std::stable_sort
+#include <type_traits> // For std::decay
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
@@ -104,6 +105,68 @@ void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::TransformReduce(
+  Iterator begin, Iterator end, T init, BinaryOp reduce, UnaryOp transform)
+{
+  return BlockedTransformReduceSerial(begin, end, init, reduce, transform);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::Sequential>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  if (inBegin == inEnd)
+  {
+    return;
+  }
+  using ValueType = typename std::decay<decltype(op(*inBegin, *inBegin))>::type;
+  ValueType value = *inBegin;
+  *outBegin = value;
+  for (++inBegin, ++outBegin; inBegin != inEnd; ++inBegin, ++outBegin)
+  {
+    value = op(value, *inBegin);
+    *outBegin = value;
+  }
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::Sequential>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  for (; inBegin != inEnd; ++inBegin, ++outBegin)
+  {
+    // Read before writing so that the scan can be done in place.
+    T current = *inBegin;
+    *outBegin = init;
+    init = op(init, current);
+  }
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::Sequential>::StableSort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  std::stable_sort(begin, end, comp);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator vtkSMPToolsImpl<BackendType::Sequential>::Partition(
+  RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+{
+  return std::stable_partition(begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int);
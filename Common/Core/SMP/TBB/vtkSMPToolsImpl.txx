@@ -27,6 +27,8 @@
 
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
 #include <tbb/parallel_sort.h>
 
 #ifdef _MSC_VER
@@ -103,6 +105,155 @@ void ExecuteFunctorTBB(void* functor, vtkIdType first, vtkIdType last, vtkIdType
   }
 }
 
+//--------------------------------------------------------------------------------
+// Run a callable in the task arena of the backend, see vtkSMPToolsImplForTBB.
+template <typename Callable>
+void ExecuteCallableTBB(void* callable, vtkIdType, vtkIdType, vtkIdType)
+{
+  (*reinterpret_cast<Callable*>(callable))();
+}
+
+template <typename Callable>
+void ExecuteInArenaTBB(Callable& callable)
+{
+  vtkSMPToolsImplForTBB(0, 0, 0, ExecuteCallableTBB<Callable>, &callable);
+}
+
+//--------------------------------------------------------------------------------
+// Body of tbb::parallel_deterministic_reduce. The first transformed value of a
+// range is used as its starting value so that no identity element is needed.
+template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+class TransformReduceBodyTBB
+{
+  Iterator Begin;
+  BinaryOp& Reduce;
+  UnaryOp& Transform;
+
+public:
+  T Value;
+  bool HasValue = false;
+
+  TransformReduceBodyTBB(Iterator begin, BinaryOp& reduce, UnaryOp& transform, const T& init)
+    : Begin(begin)
+    , Reduce(reduce)
+    , Transform(transform)
+    , Value(init)
+  {
+  }
+
+  TransformReduceBodyTBB(TransformReduceBodyTBB& other, tbb::split)
+    : Begin(other.Begin)
+    , Reduce(other.Reduce)
+    , Transform(other.Transform)
+    , Value(other.Value)
+  {
+  }
+
+  void operator()(const tbb::blocked_range<vtkIdType>& range)
+  {
+    Iterator it(this->Begin);
+    std::advance(it, range.begin());
+    for (vtkIdType i = range.begin(); i < range.end(); ++i, ++it)
+    {
+      if (this->HasValue)
+      {
+        this->Value = this->Reduce(this->Value, this->Transform(*it));
+      }
+      else
+      {
+        this->Value = this->Transform(*it);
+        this->HasValue = true;
+      }
+    }
+  }
+
+  void join(TransformReduceBodyTBB& rhs)
+  {
+    if (rhs.HasValue)
+    {
+      this->Value = this->HasValue ? this->Reduce(this->Value, rhs.Value) : rhs.Value;
+      this->HasValue = true;
+    }
+  }
+};
+
+//--------------------------------------------------------------------------------
+// Body of tbb::parallel_scan. Sum holds the combination of every value on the
+// left of the current range. The scan can be done in place.
+template <bool Exclusive, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+class ScanBodyTBB
+{
+  InputIt In;
+  OutputIt Out;
+  BinaryOp& Op;
+  T Sum;
+  bool HasSum;
+
+public:
+  ScanBodyTBB(InputIt in, OutputIt out, BinaryOp& op, const T& init, bool hasInit)
+    : In(in)
+    , Out(out)
+    , Op(op)
+    , Sum(init)
+    , HasSum(hasInit)
+  {
+  }
+
+  ScanBodyTBB(ScanBodyTBB& other, tbb::split)
+    : In(other.In)
+    , Out(other.Out)
+    , Op(other.Op)
+    , Sum(other.Sum)
+    , HasSum(false)
+  {
+  }
+
+  template <typename Tag>
+  void operator()(const tbb::blocked_range<vtkIdType>& range, Tag)
+  {
+    InputIt in(this->In);
+    std::advance(in, range.begin());
+    OutputIt out(this->Out);
+    if (Tag::is_final_scan())
+    {
+      std::advance(out, range.begin());
+    }
+    for (vtkIdType i = range.begin(); i < range.end(); ++i, ++in)
+    {
+      T current = *in;
+      if (Exclusive && Tag::is_final_scan())
+      {
+        *out = this->Sum;
+      }
+      this->Sum = this->HasSum ? this->Op(this->Sum, current) : current;
+      this->HasSum = true;
+      if (Tag::is_final_scan())
+      {
+        if (!Exclusive)
+        {
+          *out = this->Sum;
+        }
+        ++out;
+      }
+    }
+  }
+
+  void reverse_join(ScanBodyTBB& left)
+  {
+    if (left.HasSum)
+    {
+      this->Sum = this->HasSum ? this->Op(left.Sum, this->Sum) : left.Sum;
+      this->HasSum = true;
+    }
+  }
+
+  void assign(ScanBodyTBB& other)
+  {
+    this->Sum = other.Sum;
+    this->HasSum = other.HasSum;
+  }
+};
+
 //--------------------------------------------------------------------------------
 template <>
 template <typename FunctorInternal>
@@ -180,6 +331,80 @@ void vtkSMPToolsImpl<BackendType::TBB>::Sort(
   tbb::parallel_sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+T vtkSMPToolsImpl<BackendType::TBB>::TransformReduce(
+  Iterator begin, Iterator end, T init, BinaryOp reduce, UnaryOp transform)
+{
+  const vtkIdType size = std::distance(begin, end);
+  TransformReduceBodyTBB<Iterator, T, BinaryOp, UnaryOp> body(begin, reduce, transform, init);
+  auto reduceInArena = [&]() {
+    tbb::parallel_deterministic_reduce(
+      tbb::blocked_range<vtkIdType>(0, size, SMPMinimumBlockSize), body);
+  };
+  ExecuteInArenaTBB(reduceInArena);
+  return body.HasValue ? reduce(init, body.Value) : init;
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::TBB>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  const vtkIdType size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+  using ValueType = typename std::decay<decltype(op(*inBegin, *inBegin))>::type;
+  ValueType first = *inBegin;
+  ScanBodyTBB<false, InputIt, OutputIt, ValueType, BinaryOp> body(
+    inBegin, outBegin, op, first, false);
+  auto scanInArena = [&]() {
+    tbb::parallel_scan(tbb::blocked_range<vtkIdType>(0, size, SMPMinimumBlockSize), body);
+  };
+  ExecuteInArenaTBB(scanInArena);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+void vtkSMPToolsImpl<BackendType::TBB>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  const vtkIdType size = std::distance(inBegin, inEnd);
+  if (size <= 0)
+  {
+    return;
+  }
+  ScanBodyTBB<true, InputIt, OutputIt, T, BinaryOp> body(inBegin, outBegin, op, init, true);
+  auto scanInArena = [&]() {
+    tbb::parallel_scan(tbb::blocked_range<vtkIdType>(0, size, SMPMinimumBlockSize), body);
+  };
+  ExecuteInArenaTBB(scanInArena);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Compare>
+void vtkSMPToolsImpl<BackendType::TBB>::StableSort(
+  RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+{
+  // tbb::parallel_sort is not stable
+  BlockedStableSort(*this, begin, end, comp);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator vtkSMPToolsImpl<BackendType::TBB>::Partition(
+  RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+{
+  return BlockedPartition(*this, begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 void vtkSMPToolsImpl<BackendType::TBB>::Initialize(int);
@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestArrayDispatchFallback.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the accounting of the failed dispatches and the block accessor used by
+// the fallback paths.
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayBlockAccessor.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                                                     \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(cond))                                                                                   \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;                                \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+// Scale an array by blocks.
+struct ScaleWorker
+{
+  vtkIdType BlockSize;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array, double factor)
+  {
+    using APIType = typename vtkDataArrayBlockAccessor<ArrayT>::APIType;
+    vtkDataArrayBlockAccessor<ArrayT> accessor(array, this->BlockSize);
+    const int numComps = array->GetNumberOfComponents();
+    const vtkIdType numTuples = array->GetNumberOfTuples();
+    for (vtkIdType begin = 0; begin < numTuples; begin += accessor.GetBlockSize())
+    {
+      const vtkIdType end = std::min(begin + accessor.GetBlockSize(), numTuples);
+      APIType* block = accessor.Read(begin, end);
+      for (vtkIdType i = 0; i < (end - begin) * numComps; ++i)
+      {
+        block[i] = static_cast<APIType>(block[i] * factor);
+      }
+      accessor.Write(begin, end, block);
+    }
+  }
+};
+
+template <typename ArrayT>
+void FillArray(ArrayT* array)
+{
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(1000);
+  for (vtkIdType t = 0; t < 1000; ++t)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      array->SetTypedComponent(t, c, static_cast<float>(t * 3 + c));
+    }
+  }
+}
+
+bool CheckScaled(vtkDataArray* array, double factor)
+{
+  for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      if (array->GetComponent(t, c) != (t * 3 + c) * factor)
+      {
+        std::cerr << "Wrong value at tuple " << t << ", component " << c << ": "
+                  << array->GetComponent(t, c) << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestArrayDispatchFallback(int, char*[])
+{
+  vtkNew<vtkAOSDataArrayTemplate<float>> aos;
+  vtkNew<vtkSOADataArrayTemplate<float>> soa;
+  FillArray(aos.Get());
+  FillArray(soa.Get());
+
+  // Dispatch misses are counted and logged.
+  using AOSArrays = vtkTypeList::Create<vtkAOSDataArrayTemplate<float>>;
+  using AOSDispatch = vtkArrayDispatch::DispatchByArray<AOSArrays>;
+  using AOSDispatch2 = vtkArrayDispatch::Dispatch2ByArray<AOSArrays, AOSArrays>;
+  vtkArrayDispatch::SetDispatchMissLogVerbosity(vtkLogger::VERBOSITY_INFO);
+  TEST_ASSERT(vtkArrayDispatch::GetDispatchMissLogVerbosity() == vtkLogger::VERBOSITY_INFO,
+    "Wrong log verbosity.");
+  vtkArrayDispatch::ResetNumberOfDispatchMisses();
+
+  ScaleWorker worker{ 100 };
+  TEST_ASSERT(AOSDispatch::Execute(aos, worker, 2.), "AOS dispatch failed.");
+  TEST_ASSERT(vtkArrayDispatch::GetNumberOfDispatchMisses() == 0, "Unexpected dispatch miss.");
+  TEST_ASSERT(!AOSDispatch::Execute(soa, worker, 2.), "SOA dispatch succeeded.");
+  TEST_ASSERT(vtkArrayDispatch::GetNumberOfDispatchMisses() == 1, "Dispatch miss not counted.");
+  auto noop = [](vtkDataArray*, vtkDataArray*) {};
+  TEST_ASSERT(!AOSDispatch2::Execute(aos, soa, noop), "Dual dispatch succeeded.");
+  TEST_ASSERT(vtkArrayDispatch::GetNumberOfDispatchMisses() == 2, "Dual miss not counted.");
+  vtkArrayDispatch::ResetNumberOfDispatchMisses();
+  TEST_ASSERT(vtkArrayDispatch::GetNumberOfDispatchMisses() == 0, "Reset failed.");
+  vtkArrayDispatch::SetDispatchMissLogVerbosity(vtkLogger::VERBOSITY_TRACE);
+
+  // The block accessor gives the same results whatever the array type.
+  TEST_ASSERT(CheckScaled(aos, 2.), "Wrong AOS values.");
+  worker(soa.Get(), 2.);
+  TEST_ASSERT(CheckScaled(soa, 2.), "Wrong SOA values.");
+  worker(static_cast<vtkDataArray*>(soa), 0.5);
+  TEST_ASSERT(CheckScaled(soa, 1.), "Wrong values through the vtkDataArray API.");
+
+  // Blocks larger than the scratch buffer and partial last blocks.
+  worker.BlockSize = 333;
+  worker(static_cast<vtkDataArray*>(aos), 3.);
+  TEST_ASSERT(CheckScaled(aos, 6.), "Wrong values with partial blocks.");
+  vtkDataArrayBlockAccessor<vtkSOADataArrayTemplate<float>> accessor(soa, 10);
+  const float* block = accessor.Read(0, 1000);
+  TEST_ASSERT(block[2999] == 2999.f, "Wrong values of a large block.");
+
+  // Array-of-structs arrays are read in place.
+  vtkDataArrayBlockAccessor<vtkAOSDataArrayTemplate<float>> aosAccessor(aos);
+  TEST_ASSERT(aosAccessor.Read(10, 20) == aos->GetPointer(30), "AOS blocks must not be copied.");
+
+  // vtkDataArray copies that miss the dispatch go through the block accessor.
+  vtkNew<vtkAOSDataArrayTemplate<double>> copy;
+  copy->DeepCopy(soa);
+  TEST_ASSERT(copy->GetNumberOfTuples() == 1000 && CheckScaled(copy, 1.), "Wrong deep copy.");
+  vtkNew<vtkAOSDataArrayTemplate<double>> range;
+  range->SetNumberOfComponents(3);
+  range->SetNumberOfTuples(600);
+  soa->GetTuples(100, 699, range);
+  TEST_ASSERT(range->GetComponent(0, 0) == 300. && range->GetComponent(599, 2) == 2099.,
+    "Wrong tuple range.");
+
+  return EXIT_SUCCESS;
+}
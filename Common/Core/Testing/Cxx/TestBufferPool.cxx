@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBufferPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the recycling of data array buffers by vtkBufferPool.
+
+#include "vtkBufferPool.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                                                     \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(cond))                                                                                   \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;                                \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+// Simulate the re-execution of a filter: the output array is released and a
+// new one of the same size is allocated.
+double Execute(vtkIdType numberOfTuples, double value)
+{
+  vtkNew<vtkDoubleArray> output;
+  output->SetNumberOfComponents(3);
+  output->SetNumberOfTuples(numberOfTuples);
+  output->Fill(value);
+  return output->GetComponent(numberOfTuples - 1, 2);
+}
+}
+
+int TestBufferPool(int, char*[])
+{
+  const vtkIdType numberOfTuples = 100000; // 2.4 MB
+  const vtkTypeUInt64 arraySize = numberOfTuples * 3 * sizeof(double);
+
+  TEST_ASSERT(!vtkBufferPool::GetEnabled(), "The pool must be disabled by default.");
+  vtkBufferPool::SetEnabled(true);
+  vtkBufferPool::ResetStatistics();
+
+  // First execution: miss. Following executions: hits.
+  for (int step = 0; step < 4; ++step)
+  {
+    TEST_ASSERT(Execute(numberOfTuples, step) == step, "Wrong array content.");
+  }
+  TEST_ASSERT(vtkBufferPool::GetNumberOfMisses() == 1,
+    "Expected 1 miss, got " << vtkBufferPool::GetNumberOfMisses());
+  TEST_ASSERT(vtkBufferPool::GetNumberOfHits() == 3,
+    "Expected 3 hits, got " << vtkBufferPool::GetNumberOfHits());
+  TEST_ASSERT(vtkBufferPool::GetNumberOfRetainedBuffers() == 1, "Expected 1 retained buffer.");
+  TEST_ASSERT(vtkBufferPool::GetRetainedSize() >= arraySize &&
+      vtkBufferPool::GetRetainedSize() < arraySize + arraySize / 4,
+    "Unexpected retained size " << vtkBufferPool::GetRetainedSize());
+
+  // Small arrays are not pooled.
+  vtkBufferPool::ResetStatistics();
+  {
+    vtkNew<vtkFloatArray> small;
+    small->SetNumberOfValues(10);
+    small->SetValue(9, 1.f);
+  }
+  TEST_ASSERT(vtkBufferPool::GetNumberOfHits() + vtkBufferPool::GetNumberOfMisses() == 0,
+    "Small arrays must not be pooled.");
+
+  // Shrinking an array inside its size class keeps the buffer, growing it
+  // preserves the values.
+  {
+    vtkNew<vtkDoubleArray> array;
+    array->SetNumberOfValues(1 << 16);
+    for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+    {
+      array->SetValue(i, static_cast<double>(i));
+    }
+    double* pointer = array->GetPointer(0);
+    array->Resize((1 << 16) - 100);
+    TEST_ASSERT(array->GetPointer(0) == pointer, "Resize in the same size class moved the buffer.");
+    array->Resize(1 << 20);
+    for (vtkIdType i = 0; i < (1 << 16) - 100; ++i)
+    {
+      TEST_ASSERT(array->GetValue(i) == static_cast<double>(i), "Resize lost values.");
+    }
+  }
+
+  // Struct-of-arrays buffers use the pool too.
+  vtkBufferPool::ResetStatistics();
+  for (int step = 0; step < 2; ++step)
+  {
+    vtkNew<vtkSOADataArrayTemplate<float>> soa;
+    soa->SetNumberOfComponents(2);
+    soa->SetNumberOfTuples(numberOfTuples);
+    soa->SetTypedComponent(numberOfTuples - 1, 1, 1.f);
+  }
+  TEST_ASSERT(vtkBufferPool::GetNumberOfHits() >= 2, "SOA buffers were not recycled.");
+
+  // Arrays taking ownership of user memory are not affected.
+  {
+    vtkNew<vtkDoubleArray> array;
+    double* data = static_cast<double*>(malloc(1000 * sizeof(double)));
+    array->SetArray(data, 1000, 0, vtkAbstractArray::VTK_DATA_ARRAY_FREE);
+    array->Resize(200000);
+    array->SetNumberOfValues(500000);
+    array->SetValue(499999, 1.0);
+  }
+
+  // The cap limits the retained memory.
+  vtkBufferPool::SetMaximumRetainedSize(arraySize);
+  TEST_ASSERT(vtkBufferPool::GetRetainedSize() <= arraySize, "The cap was not applied.");
+  {
+    vtkNew<vtkDoubleArray> a;
+    vtkNew<vtkDoubleArray> b;
+    a->SetNumberOfValues(3 * numberOfTuples);
+    b->SetNumberOfValues(6 * numberOfTuples);
+  }
+  TEST_ASSERT(vtkBufferPool::GetRetainedSize() <= arraySize, "The cap was exceeded.");
+
+  vtkBufferPool::ReleaseRetainedBuffers();
+  TEST_ASSERT(vtkBufferPool::GetRetainedSize() == 0, "Buffers were not released.");
+  TEST_ASSERT(vtkBufferPool::GetNumberOfRetainedBuffers() == 0, "Buffers were not released.");
+
+  // Arrays allocated while the pool was enabled outlive it.
+  vtkNew<vtkDoubleArray> survivor;
+  survivor->SetNumberOfValues(3 * numberOfTuples);
+  vtkBufferPool::SetEnabled(false);
+  survivor->Resize(6 * numberOfTuples);
+  survivor->Initialize();
+  TEST_ASSERT(vtkBufferPool::GetRetainedSize() == 0, "Disabled pool retained memory.");
+
+  vtkNew<vtkBufferPool> pool;
+  pool->Print(std::cout);
+
+  return EXIT_SUCCESS;
+}
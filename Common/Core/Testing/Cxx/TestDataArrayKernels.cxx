@@ -0,0 +1,343 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayKernels.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the vectorized kernels of vtkDataArrayKernels for every instruction
+// set supported by the processor, against scalar loops.
+
+#include "vtkDataArrayKernels.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkShortArray.h"
+#include "vtkTypeTraits.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                                                     \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(cond))                                                                                   \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;                                \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+template <typename T>
+std::vector<T> MakeValues(vtkIdType numValues)
+{
+  std::vector<T> values(numValues);
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    values[i] = static_cast<T>((i * 37 + 11) % 251);
+  }
+  return values;
+}
+
+template <typename T>
+bool TestRange(const std::vector<T>& values, int numComps, bool finiteOnly)
+{
+  const vtkIdType numTuples = static_cast<vtkIdType>(values.size()) / numComps;
+  std::vector<T> expected(2 * numComps), ranges(2 * numComps);
+  for (int c = 0; c < numComps; ++c)
+  {
+    expected[2 * c] = ranges[2 * c] = vtkTypeTraits<T>::Max();
+    expected[2 * c + 1] = ranges[2 * c + 1] = vtkTypeTraits<T>::Min();
+  }
+  for (vtkIdType t = 0; t < numTuples; ++t)
+  {
+    for (int c = 0; c < numComps; ++c)
+    {
+      const T value = values[t * numComps + c];
+      const double asDouble = static_cast<double>(value);
+      if (std::isnan(asDouble) || (finiteOnly && std::isinf(asDouble)))
+      {
+        continue;
+      }
+      expected[2 * c] = value < expected[2 * c] ? value : expected[2 * c];
+      expected[2 * c + 1] = value > expected[2 * c + 1] ? value : expected[2 * c + 1];
+    }
+  }
+
+  TEST_ASSERT(vtkDataArrayKernels::ComputeRange(
+                values.data(), numTuples, numComps, ranges.data(), finiteOnly),
+    "Type not supported.");
+  TEST_ASSERT(ranges == expected,
+    "Wrong range for " << numComps << " components, finite only: " << finiteOnly);
+  return true;
+}
+
+template <typename T>
+bool TestRanges()
+{
+  for (int numComps = 1; numComps <= 6; ++numComps)
+  {
+    // Sizes around the block sizes of the kernels.
+    for (vtkIdType numTuples : { 1, 7, 64, 257, 1000 })
+    {
+      const std::vector<T> values = MakeValues<T>(numTuples * numComps);
+      if (!TestRange(values, numComps, false) || !TestRange(values, numComps, true))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool TestFloatingPointRanges()
+{
+  std::vector<T> values = MakeValues<T>(3 * 1000);
+  values[5] = std::numeric_limits<T>::quiet_NaN();
+  values[0] = std::numeric_limits<T>::quiet_NaN();
+  values[301] = std::numeric_limits<T>::infinity();
+  values[2000] = -std::numeric_limits<T>::infinity();
+  for (int numComps = 1; numComps <= 5; ++numComps)
+  {
+    if (!TestRange(values, numComps, false) || !TestRange(values, numComps, true))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename S, typename D>
+bool TestConversion()
+{
+  const std::vector<S> source = MakeValues<S>(1001);
+  std::vector<D> destination(source.size());
+  TEST_ASSERT(vtkDataArrayKernels::ConvertValues(source.data(), vtkTypeTraits<S>::VTK_TYPE_ID,
+                destination.data(), vtkTypeTraits<D>::VTK_TYPE_ID,
+                static_cast<vtkIdType>(source.size())),
+    "Conversion not supported.");
+  for (size_t i = 0; i < source.size(); ++i)
+  {
+    TEST_ASSERT(destination[i] == static_cast<D>(source[i]), "Wrong converted value " << i);
+  }
+  return true;
+}
+
+template <typename S>
+bool TestConversions()
+{
+  return TestConversion<S, float>() && TestConversion<S, double>() &&
+    TestConversion<S, vtkTypeInt32>() && TestConversion<S, vtkTypeInt64>() &&
+    TestConversion<S, vtkTypeUInt8>();
+}
+
+template <typename T>
+bool TestTupleCopies()
+{
+  const vtkIdType numTuples = 500;
+  for (int numComps = 1; numComps <= 6; ++numComps)
+  {
+    const std::vector<T> source = MakeValues<T>(numTuples * numComps);
+    std::vector<vtkIdType> ids;
+    for (vtkIdType i = numTuples - 1; i >= 0; i -= 3)
+    {
+      ids.push_back(i);
+    }
+    const vtkIdType numIds = static_cast<vtkIdType>(ids.size());
+    const int valueSize = static_cast<int>(sizeof(T));
+
+    // Gather.
+    std::vector<T> gathered(numIds * numComps);
+    TEST_ASSERT(vtkDataArrayKernels::GatherTuples(
+                  source.data(), ids.data(), numIds, valueSize, numComps, gathered.data()),
+      "Gather failed.");
+    for (vtkIdType i = 0; i < numIds; ++i)
+    {
+      for (int c = 0; c < numComps; ++c)
+      {
+        TEST_ASSERT(gathered[i * numComps + c] == source[ids[i] * numComps + c],
+          "Wrong gathered value.");
+      }
+    }
+
+    // Scatter back.
+    std::vector<T> scattered(numTuples * numComps, T(0));
+    TEST_ASSERT(vtkDataArrayKernels::ScatterTuples(
+                  gathered.data(), ids.data(), numIds, valueSize, numComps, scattered.data()),
+      "Scatter failed.");
+    for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+      const bool selected = (numTuples - 1 - i) % 3 == 0;
+      for (int c = 0; c < numComps; ++c)
+      {
+        TEST_ASSERT(scattered[i * numComps + c] == (selected ? source[i * numComps + c] : T(0)),
+          "Wrong scattered value.");
+      }
+    }
+
+    // Indexed copy: tuple i of the destination gets tuple ids[i].
+    std::vector<vtkIdType> destinationIds(numIds);
+    for (vtkIdType i = 0; i < numIds; ++i)
+    {
+      destinationIds[i] = 2 * i;
+    }
+    std::vector<T> copied(2 * numIds * numComps, T(0));
+    TEST_ASSERT(vtkDataArrayKernels::CopyTuples(source.data(), ids.data(), destinationIds.data(),
+                  numIds, valueSize, numComps, copied.data()),
+      "Copy failed.");
+    for (vtkIdType i = 0; i < numIds; ++i)
+    {
+      for (int c = 0; c < numComps; ++c)
+      {
+        TEST_ASSERT(copied[2 * i * numComps + c] == source[ids[i] * numComps + c],
+          "Wrong copied value.");
+      }
+    }
+  }
+  return true;
+}
+
+bool TestKernels()
+{
+  return TestRanges<float>() && TestRanges<double>() && TestRanges<vtkTypeInt32>() &&
+    TestRanges<vtkTypeInt64>() && TestRanges<vtkTypeUInt8>() && TestFloatingPointRanges<float>() &&
+    TestFloatingPointRanges<double>() && TestConversions<float>() && TestConversions<double>() &&
+    TestConversions<vtkTypeInt32>() && TestConversions<vtkTypeInt64>() &&
+    TestConversions<vtkTypeUInt8>() && TestTupleCopies<vtkTypeUInt8>() &&
+    TestTupleCopies<short>() && TestTupleCopies<float>() && TestTupleCopies<double>();
+}
+
+// The array methods using the kernels.
+bool TestArrays()
+{
+  vtkNew<vtkFloatArray> floats;
+  floats->SetNumberOfComponents(3);
+  floats->SetNumberOfTuples(10000);
+  for (vtkIdType i = 0; i < 30000; ++i)
+  {
+    floats->SetValue(i, static_cast<float>(i % 1000) - 500.f);
+  }
+  floats->SetValue(3 * 5000 + 1, std::numeric_limits<float>::quiet_NaN());
+  floats->SetValue(3 * 6000 + 1, std::numeric_limits<float>::infinity());
+  double range[2];
+  floats->GetRange(range, 0);
+  TEST_ASSERT(range[0] == -500 && range[1] == 499, "Wrong component range.");
+  floats->GetRange(range, 1);
+  TEST_ASSERT(range[0] == -500 && std::isinf(range[1]), "Wrong range with infinity.");
+  floats->GetFiniteRange(range, 1);
+  TEST_ASSERT(range[0] == -500 && range[1] == 499, "Wrong finite range.");
+  float valueRange[2];
+  floats->GetValueRange(valueRange, 2);
+  TEST_ASSERT(valueRange[0] == -500 && valueRange[1] == 499, "Wrong value range.");
+
+  // Unsupported value type.
+  vtkNew<vtkShortArray> shorts;
+  shorts->SetNumberOfTuples(100);
+  for (vtkIdType i = 0; i < 100; ++i)
+  {
+    shorts->SetValue(i, static_cast<short>(i - 10));
+  }
+  shorts->GetRange(range, 0);
+  TEST_ASSERT(range[0] == -10 && range[1] == 89, "Wrong range of an unsupported type.");
+
+  // Conversion.
+  vtkNew<vtkUnsignedCharArray> bytes;
+  bytes->DeepCopy(floats);
+  TEST_ASSERT(bytes->GetNumberOfTuples() == 10000, "Wrong number of converted tuples.");
+  TEST_ASSERT(bytes->GetValue(3 * 100 + 2) == static_cast<unsigned char>(floats->GetValue(302)),
+    "Wrong converted value.");
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->DeepCopy(floats);
+  TEST_ASSERT(doubles->GetValue(29999) == 499., "Wrong converted double.");
+
+  // Gather and indexed copies.
+  vtkNew<vtkIdList> ids;
+  ids->InsertNextId(9999);
+  ids->InsertNextId(3);
+  ids->InsertNextId(42);
+  vtkNew<vtkFloatArray> gathered;
+  gathered->SetNumberOfComponents(3);
+  gathered->SetNumberOfTuples(3);
+  floats->GetTuples(ids, gathered);
+  TEST_ASSERT(gathered->GetComponent(0, 2) == floats->GetComponent(9999, 2), "Wrong GetTuples.");
+  TEST_ASSERT(gathered->GetComponent(2, 0) == floats->GetComponent(42, 0), "Wrong GetTuples.");
+
+  vtkNew<vtkIdList> destinationIds;
+  destinationIds->InsertNextId(4);
+  destinationIds->InsertNextId(0);
+  destinationIds->InsertNextId(2);
+  vtkNew<vtkFloatArray> inserted;
+  inserted->SetNumberOfComponents(3);
+  inserted->InsertTuples(destinationIds, ids, floats);
+  TEST_ASSERT(inserted->GetNumberOfTuples() == 5, "Wrong InsertTuples size.");
+  TEST_ASSERT(inserted->GetComponent(4, 1) == floats->GetComponent(9999, 1), "Wrong InsertTuples.");
+  TEST_ASSERT(inserted->GetComponent(2, 2) == floats->GetComponent(42, 2), "Wrong InsertTuples.");
+
+  inserted->InsertTuplesStartingAt(5, ids, floats);
+  TEST_ASSERT(inserted->GetComponent(6, 0) == floats->GetComponent(3, 0),
+    "Wrong InsertTuplesStartingAt.");
+  return true;
+}
+}
+
+int TestDataArrayKernels(int, char*[])
+{
+  std::cout << "Best instruction set: "
+            << vtkDataArrayKernels::GetInstructionSetAsString(
+                 vtkDataArrayKernels::GetBestInstructionSet())
+            << std::endl;
+
+  const int instructionSets[] = { vtkDataArrayKernels::GENERIC, vtkDataArrayKernels::SSE4_2,
+    vtkDataArrayKernels::AVX2, vtkDataArrayKernels::AVX512, vtkDataArrayKernels::NEON };
+  for (int instructionSet : instructionSets)
+  {
+    if (!vtkDataArrayKernels::IsInstructionSetSupported(instructionSet))
+    {
+      continue;
+    }
+    vtkDataArrayKernels::SetInstructionSet(instructionSet);
+    if (vtkDataArrayKernels::GetInstructionSet() != instructionSet)
+    {
+      std::cerr << "Could not select "
+                << vtkDataArrayKernels::GetInstructionSetAsString(instructionSet) << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!TestKernels() || !TestArrays())
+    {
+      std::cerr << "Failed with "
+                << vtkDataArrayKernels::GetInstructionSetAsString(instructionSet) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  vtkDataArrayKernels::SetInstructionSet(vtkDataArrayKernels::GetBestInstructionSet());
+
+  // Unsupported types and sizes.
+  short shorts[2] = { 1, 2 };
+  short shortRange[2] = { 0, 0 };
+  int ints[2] = { 0, 0 };
+  if (vtkDataArrayKernels::ComputeRange(shorts, 2, 1, shortRange, false) ||
+    vtkDataArrayKernels::ConvertValues(shorts, VTK_SHORT, ints, VTK_INT, 2) ||
+    vtkDataArrayKernels::GatherTuples(shorts, nullptr, 0, 3, 1, ints))
+  {
+    std::cerr << "Unsupported types must be rejected." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the implicit arrays and their backends.
+
+#include "vtkAffineArray.h"
+#include "vtkArrayDispatch.h"
+#include "vtkCompositeArray.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIndexedArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkStdFunctionArray.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#define TEST_ASSERT(cond, msg)                                                                     \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(cond))                                                                                   \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;                                \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+// Sum of the values of an array, through the generic value range.
+struct SumWorker
+{
+  double Sum = 0.0;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    this->Sum = 0.0;
+    for (const auto value : vtk::DataArrayValueRange(array))
+    {
+      this->Sum += value;
+    }
+  }
+};
+
+double Squared(vtkIdType i)
+{
+  return static_cast<double>(i * i);
+}
+}
+
+int TestImplicitArrays(int, char*[])
+{
+  // Constant array.
+  vtkNew<vtkConstantArray<float>> constant;
+  constant->ConstructBackend(2.5f);
+  constant->SetNumberOfComponents(3);
+  constant->SetNumberOfTuples(100);
+  TEST_ASSERT(constant->GetNumberOfValues() == 300, "Wrong number of values.");
+  TEST_ASSERT(constant->GetDataType() == VTK_FLOAT, "Wrong data type.");
+  TEST_ASSERT(constant->GetValue(299) == 2.5f, "Wrong constant value.");
+  TEST_ASSERT(constant->GetComponent(42, 1) == 2.5, "Wrong constant component.");
+  TEST_ASSERT(constant->GetArrayType() == vtkAbstractArray::ImplicitArray, "Wrong array type.");
+  TEST_ASSERT(vtkDataArray::FastDownCast(constant) == constant.Get(), "FastDownCast failed.");
+  TEST_ASSERT(constant->GetActualMemorySize() == 1, "An implicit array must not store values.");
+
+  // Writes are ignored.
+  constant->SetValue(0, 1.f);
+  constant->SetComponent(1, 1, 1.);
+  TEST_ASSERT(constant->GetValue(0) == 2.5f, "An implicit array is read-only.");
+
+  double range[2];
+  constant->GetRange(range, 2);
+  TEST_ASSERT(range[0] == 2.5 && range[1] == 2.5, "Wrong range.");
+
+  // Affine array.
+  vtkNew<vtkAffineArray<vtkIdType>> affine;
+  affine->ConstructBackend(2, 10);
+  affine->SetNumberOfTuples(1000);
+  TEST_ASSERT(affine->GetValue(0) == 10 && affine->GetValue(999) == 2008, "Wrong affine values.");
+  affine->GetRange(range, 0);
+  TEST_ASSERT(range[0] == 10 && range[1] == 2008, "Wrong affine range.");
+  vtkIdType tuple[1];
+  affine->GetTypedTuple(5, tuple);
+  TEST_ASSERT(tuple[0] == 20, "Wrong affine tuple.");
+
+  // Values ranges and dispatch.
+  SumWorker worker;
+  worker(affine.Get());
+  TEST_ASSERT(worker.Sum == 1000 * 10 + 2 * (999 * 1000 / 2), "Wrong sum over the value range.");
+
+  using ImplicitArrays = vtkTypeList::Create<vtkConstantArray<float>, vtkAffineArray<vtkIdType>>;
+  using Dispatcher = vtkArrayDispatch::DispatchByArray<ImplicitArrays>;
+  TEST_ASSERT(Dispatcher::Execute(constant, worker), "Dispatch of a constant array failed.");
+  TEST_ASSERT(worker.Sum == 300 * 2.5, "Wrong sum of the dispatched constant array.");
+  vtkNew<vtkConstantArray<double>> otherConstant;
+  otherConstant->ConstructBackend(1.0);
+  TEST_ASSERT(
+    !Dispatcher::Execute(otherConstant, worker), "Dispatch matched the wrong value type.");
+  TEST_ASSERT(vtkArrayDownCast<vtkAffineArray<vtkIdType>>(constant) == nullptr,
+    "Downcast matched a wrong type.");
+
+  // Indexed array: reversed tuples of a base array.
+  vtkNew<vtkDoubleArray> base;
+  base->SetNumberOfComponents(2);
+  base->SetNumberOfTuples(10);
+  for (vtkIdType i = 0; i < 10; ++i)
+  {
+    base->SetTuple2(i, i, -i);
+  }
+  vtkNew<vtkIdList> indexes;
+  for (vtkIdType i = 9; i >= 0; i -= 2)
+  {
+    indexes->InsertNextId(i);
+  }
+  vtkNew<vtkIndexedArray<double>> indexed;
+  indexed->ConstructBackend(indexes.Get(), base.Get());
+  indexed->SetNumberOfComponents(2);
+  indexed->SetNumberOfTuples(indexes->GetNumberOfIds());
+  TEST_ASSERT(indexed->GetTypedComponent(0, 0) == 9 && indexed->GetTypedComponent(0, 1) == -9,
+    "Wrong indexed values.");
+  TEST_ASSERT(indexed->GetTypedComponent(4, 0) == 1, "Wrong indexed values.");
+  const auto indexedTuples = vtk::DataArrayTupleRange<2>(indexed.Get());
+  TEST_ASSERT(indexedTuples[2][1] == -5, "Wrong indexed tuple range.");
+
+  // Indexed array reading a base array of another value type.
+  vtkNew<vtkIntArray> intBase;
+  intBase->SetNumberOfValues(10);
+  for (vtkIdType i = 0; i < 10; ++i)
+  {
+    intBase->SetValue(i, static_cast<int>(i * 3));
+  }
+  vtkNew<vtkIndexedArray<double>> converted;
+  converted->ConstructBackend(indexes.Get(), intBase.Get());
+  converted->SetNumberOfTuples(indexes->GetNumberOfIds());
+  TEST_ASSERT(converted->GetValue(1) == 21, "Wrong converted indexed values.");
+
+  // Composite array.
+  vtkNew<vtkDoubleArray> first;
+  first->SetNumberOfComponents(2);
+  first->SetNumberOfTuples(3);
+  first->Fill(1.0);
+  vtkNew<vtkDoubleArray> empty;
+  empty->SetNumberOfComponents(2);
+  auto composite = vtk::ConcatenateDataArrays<double>({ first, empty, base });
+  TEST_ASSERT(composite->GetNumberOfTuples() == 13, "Wrong composite size.");
+  TEST_ASSERT(composite->GetNumberOfComponents() == 2, "Wrong composite components.");
+  TEST_ASSERT(composite->GetTypedComponent(2, 1) == 1.0, "Wrong composite values.");
+  TEST_ASSERT(composite->GetTypedComponent(3, 0) == 0.0, "Wrong composite values.");
+  TEST_ASSERT(composite->GetTypedComponent(12, 1) == -9.0, "Wrong composite values.");
+
+  // std::function array.
+  vtkNew<vtkStdFunctionArray<double>> function;
+  function->ConstructBackend(Squared);
+  function->SetNumberOfTuples(10);
+  TEST_ASSERT(function->GetValue(7) == 49, "Wrong function values.");
+
+  // Copies share the backend, new instances are writable explicit arrays.
+  vtkNew<vtkAffineArray<vtkIdType>> affineCopy;
+  affineCopy->DeepCopy(affine);
+  TEST_ASSERT(affineCopy->GetBackend() == affine->GetBackend(), "DeepCopy must share the backend.");
+  TEST_ASSERT(affineCopy->GetNumberOfTuples() == 1000, "DeepCopy lost the tuples.");
+
+  vtkDataArray* instance = affine->NewInstance();
+  TEST_ASSERT(vtkArrayDownCast<vtkAOSDataArrayTemplate<vtkIdType>>(instance) != nullptr,
+    "NewInstance must return an explicit array.");
+  instance->DeepCopy(affine);
+  TEST_ASSERT(instance->GetComponent(999, 0) == 2008, "Copy to an explicit array failed.");
+  instance->Delete();
+
+  // Legacy pointer access materializes the values.
+  vtkObject::GlobalWarningDisplayOff();
+  const vtkIdType* pointer = static_cast<const vtkIdType*>(affine->GetVoidPointer(0));
+  TEST_ASSERT(pointer[999] == 2008, "Wrong materialized values.");
+  vtkObject::GlobalWarningDisplayOn();
+  TEST_ASSERT(affine->GetActualMemorySize() > 1, "The materialized values are not accounted.");
+
+  return EXIT_SUCCESS;
+}
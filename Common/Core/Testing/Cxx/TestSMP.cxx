@@ -19,6 +19,7 @@
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <algorithm>
 #include <cstdlib>
 #include <deque>
 #include <functional>
@@ -426,6 +427,91 @@ int doTestSMP()
       return EXIT_FAILURE;
     }
   }
+
+  // Test reductions, large enough to be split in several blocks
+  const vtkIdType reduceSize = 100003;
+  std::vector<vtkIdType> reduceData(reduceSize);
+  std::iota(reduceData.begin(), reduceData.end(), 0);
+  const vtkIdType expectedSum = reduceSize * (reduceSize - 1) / 2;
+  if (vtkSMPTools::Reduce(reduceData.cbegin(), reduceData.cend(), vtkIdType(10)) !=
+    expectedSum + 10)
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::Reduce!" << endl;
+    return EXIT_FAILURE;
+  }
+  const vtkIdType maxValue = vtkSMPTools::Reduce(reduceData.cbegin(), reduceData.cend(),
+    vtkIdType(-1), [](vtkIdType a, vtkIdType b) { return std::max(a, b); });
+  if (maxValue != reduceSize - 1)
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::Reduce with max!" << endl;
+    return EXIT_FAILURE;
+  }
+  const std::set<double> reduceSet = { 1, 2, 3, 4 };
+  const double norm2 = vtkSMPTools::TransformReduce(reduceSet.cbegin(), reduceSet.cend(), 0.0,
+    std::plus<double>(), [](double x) { return x * x; });
+  if (norm2 != 30.0)
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::TransformReduce applied on std::set!" << endl;
+    return EXIT_FAILURE;
+  }
+  if (vtkSMPTools::Reduce(reduceData.cbegin(), reduceData.cbegin(), vtkIdType(7)) != 7)
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::Reduce on an empty range!" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test scans, including in place scans
+  std::vector<vtkIdType> scanData(reduceSize, 1);
+  std::vector<vtkIdType> scanOutput(reduceSize, -1);
+  vtkSMPTools::InclusiveScan(scanData.cbegin(), scanData.cend(), scanOutput.begin());
+  vtkSMPTools::ExclusiveScan(scanData.cbegin(), scanData.cend(), scanData.begin(), vtkIdType(5));
+  for (vtkIdType i = 0; i < reduceSize; ++i)
+  {
+    if (scanOutput[i] != i + 1 || scanData[i] != i + 5)
+    {
+      cerr << "Error: Invalid output for vtkSMPTools scans at " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test stable sort: sort on the key only, the values must keep their order
+  std::vector<std::pair<int, vtkIdType>> sortData(reduceSize);
+  for (vtkIdType i = 0; i < reduceSize; ++i)
+  {
+    sortData[i] = std::make_pair(static_cast<int>((i * 7919) % 101), i);
+  }
+  vtkSMPTools::StableSort(sortData.begin(), sortData.end(),
+    [](const std::pair<int, vtkIdType>& a, const std::pair<int, vtkIdType>& b) {
+      return a.first < b.first;
+    });
+  for (vtkIdType i = 1; i < reduceSize; ++i)
+  {
+    if (sortData[i - 1].first > sortData[i].first ||
+      (sortData[i - 1].first == sortData[i].first && sortData[i - 1].second > sortData[i].second))
+    {
+      cerr << "Error: Invalid output for vtkSMPTools::StableSort at " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test partition: multiples of 3 first, order kept in both groups
+  std::vector<vtkIdType> partitionData(reduceData);
+  auto partitionMiddle = vtkSMPTools::Partition(
+    partitionData.begin(), partitionData.end(), [](vtkIdType x) { return x % 3 == 0; });
+  if (partitionMiddle - partitionData.begin() != (reduceSize + 2) / 3)
+  {
+    cerr << "Error: Invalid partition point for vtkSMPTools::Partition!" << endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<vtkIdType> expectedPartition(reduceData);
+  std::stable_partition(
+    expectedPartition.begin(), expectedPartition.end(), [](vtkIdType x) { return x % 3 == 0; });
+  if (partitionData != expectedPartition)
+  {
+    cerr << "Error: Invalid output for vtkSMPTools::Partition!" << endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
 
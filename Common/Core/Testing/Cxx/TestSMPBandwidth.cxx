@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPBandwidth.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test memory bandwidth of vtkSMPTools loops over vtkDoubleArray.
+// .SECTION Description
+// Measure the bandwidth of copy and triad loops run with vtkSMPTools::For on
+// large vtkDoubleArray, with and without thread pinning and with and without
+// parallel first touch allocation. On NUMA machines the serial first touch
+// puts every page on the NUMA node of the main thread, the parallel first
+// touch spreads them on the nodes of the threads that use them. Results are
+// also checked.
+
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+// Number of times each measure is repeated, the best bandwidth is reported.
+const int StressCount = 5;
+
+//------------------------------------------------------------------------------
+struct InitializeFunctor
+{
+  double* A;
+  double* B;
+  double* C;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->A[i] = 0.0;
+      this->B[i] = 1.0;
+      this->C[i] = static_cast<double>(i % 16);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// a = b
+struct CopyFunctor
+{
+  double* A;
+  const double* B;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::copy(this->B + begin, this->B + end, this->A + begin);
+  }
+};
+
+//------------------------------------------------------------------------------
+// a = b + scalar * c
+struct TriadFunctor
+{
+  double* A;
+  const double* B;
+  const double* C;
+  double Scalar;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->A[i] = this->B[i] + this->Scalar * this->C[i];
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+template <typename T>
+double MeasureBandwidth(double nbOfBytes, T&& lambda)
+{
+  double best = VTK_DOUBLE_MAX;
+  for (int i = 0; i < StressCount; ++i)
+  {
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    lambda();
+    timer->StopTimer();
+    best = std::min(best, timer->GetElapsedTime());
+  }
+  // GB/s
+  return best > 0.0 ? nbOfBytes / best * 1e-9 : 0.0;
+}
+
+//------------------------------------------------------------------------------
+void Report(const std::string& name, double bandwidth)
+{
+  std::cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">" << bandwidth
+            << "</DartMeasurement>" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+bool RunCase(const std::string& backend, bool pinning, bool parallelFirstTouch)
+{
+  const vtkIdType size = 1 << 23;
+  const std::string name = backend + (pinning ? "-Pinned" : "-Unpinned") +
+    (parallelFirstTouch ? "-ParallelFirstTouch" : "-SerialFirstTouch");
+
+  vtkNew<vtkDoubleArray> a;
+  vtkNew<vtkDoubleArray> b;
+  vtkNew<vtkDoubleArray> c;
+  for (vtkDoubleArray* array : { a.Get(), b.Get(), c.Get() })
+  {
+    array->SetParallelFirstTouch(parallelFirstTouch);
+    array->SetNumberOfValues(size);
+  }
+
+  InitializeFunctor initialize{ a->GetPointer(0), b->GetPointer(0), c->GetPointer(0) };
+  if (parallelFirstTouch)
+  {
+    vtkSMPTools::For(0, size, initialize);
+  }
+  else
+  {
+    initialize(0, size);
+  }
+
+  CopyFunctor copy{ a->GetPointer(0), b->GetPointer(0) };
+  Report(name + "-Copy",
+    MeasureBandwidth(2.0 * size * sizeof(double), [&]() { vtkSMPTools::For(0, size, copy); }));
+
+  TriadFunctor triad{ a->GetPointer(0), b->GetPointer(0), c->GetPointer(0), 3.0 };
+  Report(name + "-Triad",
+    MeasureBandwidth(3.0 * size * sizeof(double), [&]() { vtkSMPTools::For(0, size, triad); }));
+
+  for (vtkIdType i = 0; i < size; i += 4099)
+  {
+    if (a->GetValue(i) != 1.0 + 3.0 * static_cast<double>(i % 16))
+    {
+      std::cerr << "Error: wrong triad result for " << name << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool RunBackend(const std::string& backend)
+{
+  bool success = true;
+  const bool oldPinning = vtkSMPTools::GetThreadPinning();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ backend }, [&]() {
+    for (bool pinning : { false, true })
+    {
+      vtkSMPTools::SetThreadPinning(pinning);
+      for (bool parallelFirstTouch : { false, true })
+      {
+        success &= RunCase(backend, pinning, parallelFirstTouch);
+      }
+    }
+    vtkSMPTools::SetThreadPinning(oldPinning);
+  });
+  return success;
+}
+}
+
+int TestSMPBandwidth(int argc, char* argv[])
+{
+  int returnValue = EXIT_SUCCESS;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument(argv[i] + 2);
+    std::size_t separator = argument.find('=');
+    std::string backend = argument.substr(0, separator);
+    int value = std::atoi(argument.substr(separator + 1, argument.size()).c_str());
+    if (value)
+    {
+      std::cout << "Testing SMP Tools bandwidth with " << backend << " backend." << std::endl;
+      if (!RunBackend(backend))
+      {
+        returnValue = EXIT_FAILURE;
+      }
+    }
+  }
+  return returnValue;
+}
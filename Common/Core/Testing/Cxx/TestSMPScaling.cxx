@@ -0,0 +1,230 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSMPScaling.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test scaling of the vtkSMPTools backends.
+// .SECTION Description
+// Run the same functors with every enabled vtkSMPTools backend for an
+// increasing number of threads and report the elapsed times. The functors are
+// fine grained (small grain, cheap work) and nested to stress the scheduling
+// overhead rather than the computation. Results are also checked.
+
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Number of times each measure is repeated, the minimum is reported.
+const int StressCount = 3;
+
+//------------------------------------------------------------------------------
+// Cheap work per index with a small grain: dominated by the scheduling cost.
+struct FineGrainedFunctor
+{
+  const std::vector<double>& Input;
+  std::vector<double>& Output;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Output[i] = std::sqrt(this->Input[i]) + 1.0;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// An outer loop over a few rows, each row running its own parallel loop.
+struct NestedFunctor
+{
+  const vtkIdType RowSize;
+  std::vector<double>& Output;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType row = begin; row < end; ++row)
+    {
+      double* rowData = this->Output.data() + row * this->RowSize;
+      vtkSMPTools::For(0, this->RowSize, 256, [rowData, row](vtkIdType b, vtkIdType e) {
+        for (vtkIdType i = b; i < e; ++i)
+        {
+          rowData[i] = static_cast<double>(row + i);
+        }
+      });
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Reduction through vtkSMPThreadLocal, to include the thread local cost.
+struct SumFunctor
+{
+  const std::vector<double>& Input;
+  vtkSMPThreadLocal<double> Sum;
+  double Total = 0.0;
+
+  explicit SumFunctor(const std::vector<double>& input)
+    : Input(input)
+    , Sum(0.0)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double& sum = this->Sum.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      sum += this->Input[i];
+    }
+  }
+
+  void Reduce()
+  {
+    this->Total = 0.0;
+    for (const double& sum : this->Sum)
+    {
+      this->Total += sum;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+template <typename T>
+double Measure(T&& lambda)
+{
+  double best = VTK_DOUBLE_MAX;
+  for (int i = 0; i < StressCount; ++i)
+  {
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    lambda();
+    timer->StopTimer();
+    best = std::min(best, timer->GetElapsedTime());
+  }
+  return best;
+}
+
+//------------------------------------------------------------------------------
+void Report(const std::string& backend, const char* test, int nbOfThreads, double time)
+{
+  std::cout << "<DartMeasurement name=\"" << backend << "-" << test << "-" << nbOfThreads
+            << "\" type=\"numeric/double\">" << time << "</DartMeasurement>" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+bool RunBackend(const std::string& backend)
+{
+  const vtkIdType size = 1 << 20;
+  const vtkIdType nbOfRows = 64;
+  const vtkIdType rowSize = size / nbOfRows;
+
+  std::vector<double> input(size);
+  for (vtkIdType i = 0; i < size; ++i)
+  {
+    input[i] = static_cast<double>(i % 1024);
+  }
+  std::vector<double> output(size);
+
+  int maxThreads = 0;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 0, backend, true },
+    [&]() { maxThreads = vtkSMPTools::GetEstimatedNumberOfThreads(); });
+
+  std::vector<int> threadCounts;
+  for (int nbOfThreads = 1; nbOfThreads < maxThreads; nbOfThreads *= 2)
+  {
+    threadCounts.push_back(nbOfThreads);
+  }
+  threadCounts.push_back(std::max(maxThreads, 1));
+
+  bool success = true;
+  for (int nbOfThreads : threadCounts)
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ nbOfThreads, backend, true }, [&]() {
+      FineGrainedFunctor fine{ input, output };
+      Report(backend, "FineGrained", nbOfThreads,
+        Measure([&]() { vtkSMPTools::For(0, size, 64, fine); }));
+      for (vtkIdType i = 0; i < size; i += 4099)
+      {
+        if (output[i] != std::sqrt(input[i]) + 1.0)
+        {
+          std::cerr << "Error: wrong fine grained result with " << backend << std::endl;
+          success = false;
+          break;
+        }
+      }
+
+      NestedFunctor nested{ rowSize, output };
+      Report(backend, "Nested", nbOfThreads,
+        Measure([&]() { vtkSMPTools::For(0, nbOfRows, 1, nested); }));
+      for (vtkIdType i = 0; i < size; i += 4099)
+      {
+        if (output[i] != static_cast<double>(i / rowSize + i % rowSize))
+        {
+          std::cerr << "Error: wrong nested result with " << backend << std::endl;
+          success = false;
+          break;
+        }
+      }
+
+      SumFunctor sum(input);
+      Report(backend, "Reduce", nbOfThreads, Measure([&]() {
+        vtkSMPTools::For(0, size, 1024, sum);
+      }));
+      // Each Measure() run accumulates in the same thread local storage.
+      double expected = 0.0;
+      for (vtkIdType i = 0; i < size; ++i)
+      {
+        expected += input[i];
+      }
+      if (sum.Total != StressCount * expected)
+      {
+        std::cerr << "Error: wrong reduction result with " << backend << std::endl;
+        success = false;
+      }
+    });
+  }
+  return success;
+}
+}
+
+int TestSMPScaling(int argc, char* argv[])
+{
+  int returnValue = EXIT_SUCCESS;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument(argv[i] + 2);
+    std::size_t separator = argument.find('=');
+    std::string backend = argument.substr(0, separator);
+    int value = std::atoi(argument.substr(separator + 1, argument.size()).c_str());
+    if (value)
+    {
+      std::cout << "Testing SMP Tools scaling with " << backend << " backend." << std::endl;
+      if (!RunBackend(backend))
+      {
+        returnValue = EXIT_FAILURE;
+      }
+    }
+  }
+  return returnValue;
+}
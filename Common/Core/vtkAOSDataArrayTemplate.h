@@ -250,6 +250,28 @@ public:
   static vtkAOSDataArrayTemplate<ValueType>* FastDownCast(vtkAbstractArray* source);
   ///@}
 
+  ///@{
+  /**
+   * When on, the memory allocated when the array grows (Allocate(), Resize(),
+   * SetNumberOfTuples(), ...) is first written in parallel by a
+   * vtkSMPTools::For over the tuples with the default grain: the existing
+   * values are copied and the new values are zero-initialized. On NUMA
+   * machines a page is placed on the node of the thread that touches it first,
+   * so the pages of the array end up spread on the nodes of the threads that
+   * will process the same tuples in later vtkSMPTools::For calls instead of
+   * all being placed on the node of the thread that allocated the array. See
+   * also vtkSMPTools::SetThreadPinning().
+   *
+   * When off (the default) new memory is left uninitialized.
+   * The initial value is given by vtkDataArray::GetDefaultParallelFirstTouch().
+   */
+  void SetParallelFirstTouch(bool parallelFirstTouch)
+  {
+    this->ParallelFirstTouch = parallelFirstTouch;
+  }
+  bool GetParallelFirstTouch() const { return this->ParallelFirstTouch; }
+  ///@}
+
   int GetArrayType() const override { return vtkAbstractArray::AoSDataArrayTemplate; }
   VTK_NEWINSTANCE vtkArrayIterator* NewIterator() override;
   bool HasStandardMemoryLayout() const override { return true; }
@@ -287,6 +309,7 @@ protected:
   bool ReallocateTuples(vtkIdType numTuples);
 
   vtkBuffer<ValueType>* Buffer;
+  bool ParallelFirstTouch;
 
 private:
   vtkAOSDataArrayTemplate(const vtkAOSDataArrayTemplate&) = delete;
@@ -24,6 +24,53 @@
 #include "vtkAOSDataArrayTemplate.h"
 
 #include "vtkArrayIteratorTemplate.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm> // for std::copy, std::fill, std::min
+
+namespace vtkAOSDataArrayTemplatePrivate
+{
+// Below this size, the first touch is not worth a parallel loop.
+const vtkIdType ParallelFirstTouchMinimumSize = 1 << 20;
+
+//-----------------------------------------------------------------------------
+// Copy the first NumberOfValuesToCopy values of Source into Target and
+// zero-initialize the remaining values, one range of tuples at a time.
+template <typename ValueType>
+struct FirstTouchWorker
+{
+  const ValueType* Source;
+  vtkIdType NumberOfValuesToCopy;
+  ValueType* Target;
+  int NumberOfComponents;
+
+  void operator()(vtkIdType beginTuple, vtkIdType endTuple) const
+  {
+    const vtkIdType begin = beginTuple * this->NumberOfComponents;
+    const vtkIdType end = endTuple * this->NumberOfComponents;
+    const vtkIdType copyEnd = std::max(begin, std::min(end, this->NumberOfValuesToCopy));
+    std::copy(this->Source + begin, this->Source + copyEnd, this->Target + begin);
+    std::fill(this->Target + copyEnd, this->Target + end, ValueType());
+  }
+};
+
+//-----------------------------------------------------------------------------
+template <typename ValueType>
+void FirstTouch(const ValueType* source, vtkIdType numberOfValuesToCopy, ValueType* target,
+  vtkIdType numberOfTuples, int numberOfComponents)
+{
+  FirstTouchWorker<ValueType> worker{ source, numberOfValuesToCopy, target, numberOfComponents };
+  if (numberOfTuples * numberOfComponents * static_cast<vtkIdType>(sizeof(ValueType)) <
+    ParallelFirstTouchMinimumSize)
+  {
+    worker(0, numberOfTuples);
+  }
+  else
+  {
+    vtkSMPTools::For(0, numberOfTuples, worker);
+  }
+}
+} // end namespace vtkAOSDataArrayTemplatePrivate
 
 //-----------------------------------------------------------------------------
 template <class ValueTypeT>
@@ -57,6 +104,7 @@ template <class ValueTypeT>
 vtkAOSDataArrayTemplate<ValueTypeT>::vtkAOSDataArrayTemplate()
 {
   this->Buffer = vtkBuffer<ValueType>::New();
+  this->ParallelFirstTouch = vtkDataArray::GetDefaultParallelFirstTouch();
 }
 
 //-----------------------------------------------------------------------------
@@ -452,6 +500,11 @@ bool vtkAOSDataArrayTemplate<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
   if (this->Buffer->Allocate(numValues))
   {
     this->Size = this->Buffer->GetSize();
+    if (this->ParallelFirstTouch)
+    {
+      vtkAOSDataArrayTemplatePrivate::FirstTouch<ValueType>(
+        nullptr, 0, this->Buffer->GetBuffer(), numTuples, this->GetNumberOfComponents());
+    }
     return true;
   }
   return false;
@@ -461,6 +514,26 @@ bool vtkAOSDataArrayTemplate<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
 template <class ValueTypeT>
 bool vtkAOSDataArrayTemplate<ValueTypeT>::ReallocateTuples(vtkIdType numTuples)
 {
+  if (this->ParallelFirstTouch && numTuples > 0)
+  {
+    // realloc() would copy the values from the calling thread: allocate a new
+    // buffer and copy the values from the threads that first touch the pages.
+    const vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+    vtkBuffer<ValueType>* buffer = vtkBuffer<ValueType>::New();
+    if (!buffer->Allocate(numValues))
+    {
+      buffer->Delete();
+      return false;
+    }
+    vtkAOSDataArrayTemplatePrivate::FirstTouch<ValueType>(this->Buffer->GetBuffer(),
+      std::min(this->MaxId + 1, numValues), buffer->GetBuffer(), numTuples,
+      this->GetNumberOfComponents());
+    this->Buffer->Delete();
+    this->Buffer = buffer;
+    this->Size = this->Buffer->GetSize();
+    return true;
+  }
+
   if (this->Buffer->Reallocate(numTuples * this->GetNumberOfComponents()))
   {
     this->Size = this->Buffer->GetSize();
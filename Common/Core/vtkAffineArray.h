@@ -0,0 +1,63 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAffineArray
+ * @brief   An implicit array whose values are an affine function of the index
+ *
+ * vtkAffineArray<T> is a vtkImplicitArray returning Slope * index + Intercept
+ * for the value index. It represents ramps, for instance point ids or the
+ * coordinates of a uniform grid along one axis:
+ *
+ * @code
+ * vtkNew<vtkAffineArray<vtkIdType>> ids;
+ * ids->ConstructBackend(1, 0); // slope, intercept
+ * ids->SetNumberOfTuples(numberOfPoints);
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkConstantArray
+ */
+
+#ifndef vtkAffineArray_h
+#define vtkAffineArray_h
+
+#include "vtkImplicitArray.h"
+
+/**
+ * Backend of vtkAffineArray.
+ */
+template <typename ValueType>
+struct vtkAffineImplicitBackend
+{
+  vtkAffineImplicitBackend(ValueType slope, ValueType intercept)
+    : Slope(slope)
+    , Intercept(intercept)
+  {
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    return static_cast<ValueType>(this->Slope * valueIdx + this->Intercept);
+  }
+
+  const ValueType Slope;
+  const ValueType Intercept;
+};
+
+template <typename T>
+using vtkAffineArray = vtkImplicitArray<vtkAffineImplicitBackend<T>>;
+
+#endif
+// VTK-HeaderTest-Exclude: vtkAffineArray.h
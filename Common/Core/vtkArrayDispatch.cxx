@@ -0,0 +1,103 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkArrayDispatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Non-template part of vtkArrayDispatch: accounting of the failed dispatches.
+
+#include "vtkArrayDispatch.h"
+
+#include "vtkDataArray.h"
+#include "vtkLogger.h"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+namespace
+{
+std::atomic<vtkTypeUInt64> NumberOfDispatchMisses(0);
+std::atomic<int> DispatchMissLogVerbosity(vtkLogger::VERBOSITY_TRACE);
+
+//------------------------------------------------------------------------------
+void DescribeArray(std::ostringstream& stream, vtkDataArray* array)
+{
+  if (array)
+  {
+    stream << array->GetClassName() << " (" << array->GetDataTypeAsString() << ", "
+           << array->GetNumberOfComponents() << " components)";
+  }
+  else
+  {
+    stream << "nullptr";
+  }
+}
+}
+
+namespace vtkArrayDispatch
+{
+//------------------------------------------------------------------------------
+vtkTypeUInt64 GetNumberOfDispatchMisses()
+{
+  return NumberOfDispatchMisses;
+}
+
+//------------------------------------------------------------------------------
+void ResetNumberOfDispatchMisses()
+{
+  NumberOfDispatchMisses = 0;
+}
+
+//------------------------------------------------------------------------------
+void SetDispatchMissLogVerbosity(int verbosity)
+{
+  DispatchMissLogVerbosity = vtkLogger::ConvertToVerbosity(verbosity);
+}
+
+//------------------------------------------------------------------------------
+int GetDispatchMissLogVerbosity()
+{
+  return DispatchMissLogVerbosity;
+}
+
+namespace impl
+{
+//------------------------------------------------------------------------------
+void ReportDispatchMiss(vtkDataArray* array1, vtkDataArray* array2, vtkDataArray* array3)
+{
+  ++NumberOfDispatchMisses;
+
+  const vtkLogger::Verbosity verbosity =
+    static_cast<vtkLogger::Verbosity>(DispatchMissLogVerbosity.load());
+  if (verbosity > vtkLogger::GetCurrentVerbosityCutoff())
+  {
+    return;
+  }
+
+  std::ostringstream stream;
+  DescribeArray(stream, array1);
+  if (array2 || array3)
+  {
+    stream << ", ";
+    DescribeArray(stream, array2);
+  }
+  if (array3)
+  {
+    stream << ", ";
+    DescribeArray(stream, array3);
+  }
+  const std::string arrays = stream.str();
+  vtkVLogF(verbosity, "vtkArrayDispatch: no fast path for %s.", arrays.c_str());
+}
+} // end namespace impl
+} // end namespace vtkArrayDispatch
@@ -184,6 +184,16 @@
  * }
  * @endcode
  *
+ * Dispatch misses:
+ * When an array is not in the list of a dispatcher, Execute() returns false
+ * and the caller usually falls back to the slow vtkDataArray double API. Such
+ * misses are counted (see GetNumberOfDispatchMisses()) and logged with
+ * vtkLogger at the verbosity set by SetDispatchMissLogVerbosity()
+ * (VERBOSITY_TRACE by default), with the class names of the arrays, to find
+ * the array types worth adding to the dispatch list. When a fallback cannot be
+ * avoided, vtkDataArrayBlockAccessor keeps it vectorizable by copying blocks
+ * of tuples into a contiguous scratch buffer.
+ *
  * Examples:
  * See TestArrayDispatchers.cxx for examples of each dispatch type and
  * ExampleDataArrayRangeDispatch.cxx for more real-world examples.
@@ -196,9 +206,12 @@
 #define vtkArrayDispatch_h
 
 #include "vtkArrayDispatchArrayList.h"
+#include "vtkCommonCoreModule.h" // For export macro
 #include "vtkType.h"
 #include "vtkTypeList.h"
 
+class vtkDataArray;
+
 namespace vtkArrayDispatch
 {
 
@@ -415,6 +428,35 @@ struct Dispatch3BySameValueType;
 template <typename ArrayList, typename ValueList>
 struct FilterArraysByValueType;
 
+//------------------------------------------------------------------------------
+///@{
+/**
+ * Number of failed dispatches since the start of the program or the last
+ * reset, over all dispatchers and threads.
+ */
+VTKCOMMONCORE_EXPORT vtkTypeUInt64 GetNumberOfDispatchMisses();
+VTKCOMMONCORE_EXPORT void ResetNumberOfDispatchMisses();
+///@}
+
+///@{
+/**
+ * Verbosity of the vtkLogger messages reporting failed dispatches. Default is
+ * vtkLogger::VERBOSITY_TRACE.
+ */
+VTKCOMMONCORE_EXPORT void SetDispatchMissLogVerbosity(int verbosity);
+VTKCOMMONCORE_EXPORT int GetDispatchMissLogVerbosity();
+///@}
+
+namespace impl
+{
+/**
+ * Count and log a failed dispatch of the given arrays. Used by the terminal
+ * cases of the dispatchers.
+ */
+VTKCOMMONCORE_EXPORT void ReportDispatchMiss(
+  vtkDataArray* array1, vtkDataArray* array2 = nullptr, vtkDataArray* array3 = nullptr);
+} // end namespace impl
+
 } // end namespace vtkArrayDispatch
 
 #include "vtkArrayDispatch.txx"
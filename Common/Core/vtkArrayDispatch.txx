@@ -40,11 +40,12 @@ template <>
 struct Dispatch<vtkTypeList::NullType>
 {
   template <typename... T>
-  static bool Execute(T&&...)
+  static bool Execute(vtkDataArray* array, T&&...)
   {
 #ifdef VTK_WARN_ON_DISPATCH_FAILURE
     vtkGenericWarningMacro("Array dispatch failed.");
 #endif
+    ReportDispatchMiss(array);
     return false;
   }
 };
@@ -86,11 +87,12 @@ template <typename ArrayList2>
 struct Dispatch2<vtkTypeList::NullType, ArrayList2>
 {
   template <typename... T>
-  static bool Execute(T&&...)
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2, T&&...)
   {
 #ifdef VTK_WARN_ON_DISPATCH_FAILURE
     vtkGenericWarningMacro("Dual array dispatch failed.");
 #endif
+    ReportDispatchMiss(array1, array2);
     return false;
   }
 };
@@ -124,11 +126,12 @@ template <typename Array1T>
 struct Dispatch2Trampoline<Array1T, vtkTypeList::NullType>
 {
   template <typename... T>
-  static bool Execute(T&&...)
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2, T&&...)
   {
 #ifdef VTK_WARN_ON_DISPATCH_FAILURE
     vtkGenericWarningMacro("Dual array dispatch failed.");
 #endif
+    ReportDispatchMiss(array1, array2);
     return false;
   }
 };
@@ -166,11 +169,12 @@ template <typename ArrayList2>
 struct Dispatch2Same<vtkTypeList::NullType, ArrayList2>
 {
   template <typename... T>
-  static bool Execute(T&&...)
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2, T&&...)
   {
 #ifdef VTK_WARN_ON_DISPATCH_FAILURE
     vtkGenericWarningMacro("Dual array dispatch failed.");
 #endif
+    ReportDispatchMiss(array1, array2);
     return false;
   }
 };
@@ -224,11 +228,12 @@ template <typename ArrayList2, typename ArrayList3>
 struct Dispatch3<vtkTypeList::NullType, ArrayList2, ArrayList3>
 {
   template <typename... T>
-  static bool Execute(T&&...)
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2, vtkDataArray* array3, T&&...)
   {
 #ifdef VTK_WARN_ON_DISPATCH_FAILURE
     vtkGenericWarningMacro("Triple array dispatch failed.");
 #endif
+    ReportDispatchMiss(array1, array2, array3);
     return false;
   }
 };
@@ -264,11 +269,12 @@ template <typename Array1T, typename ArrayList3>
 struct Dispatch3Trampoline1<Array1T, vtkTypeList::NullType, ArrayList3>
 {
   template <typename... T>
-  static bool Execute(T&&...)
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2, vtkDataArray* array3, T&&...)
   {
 #ifdef VTK_WARN_ON_DISPATCH_FAILURE
     vtkGenericWarningMacro("Triple array dispatch failed.");
 #endif
+    ReportDispatchMiss(array1, array2, array3);
     return false;
   }
 };
@@ -304,11 +310,12 @@ template <typename Array1T, typename Array2T>
 struct Dispatch3Trampoline2<Array1T, Array2T, vtkTypeList::NullType>
 {
   template <typename... T>
-  static bool Execute(T&&...)
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2, vtkDataArray* array3, T&&...)
   {
 #ifdef VTK_WARN_ON_DISPATCH_FAILURE
     vtkGenericWarningMacro("Triple array dispatch failed.");
 #endif
+    ReportDispatchMiss(array1, array2, array3);
     return false;
   }
 };
@@ -352,11 +359,12 @@ template <typename ArrayList2, typename ArrayList3>
 struct Dispatch3Same<vtkTypeList::NullType, ArrayList2, ArrayList3>
 {
   template <typename... T>
-  static bool Execute(T&&...)
+  static bool Execute(vtkDataArray* array1, vtkDataArray* array2, vtkDataArray* array3, T&&...)
   {
 #ifdef VTK_WARN_ON_DISPATCH_FAILURE
     vtkGenericWarningMacro("Triple array dispatch failed.");
 #endif
+    ReportDispatchMiss(array1, array2, array3);
     return false;
   }
 };
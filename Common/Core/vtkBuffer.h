@@ -20,11 +20,15 @@
  * vtkBuffer makes it easier to keep data pointers in vtkDataArray subclasses.
  * This is an internal class and not intended for direct use expect when writing
  * new types of vtkDataArray subclasses.
+ *
+ * When vtkBufferPool is enabled, the buffers created afterwards allocate their
+ * memory from the pool, which recycles the memory of released buffers.
  */
 
 #ifndef vtkBuffer_h
 #define vtkBuffer_h
 
+#include "vtkBufferPool.h" // For vtkBufferPool
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
 
@@ -92,9 +96,18 @@ protected:
     : Pointer(nullptr)
     , Size(0)
   {
-    this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
-    this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
-    this->SetFreeFunction(false, vtkObjectBase::GetCurrentFreeFunction());
+    if (vtkBufferPool::GetEnabled() && !vtkObjectBase::GetUsingMemkind())
+    {
+      this->SetMallocFunction(vtkBufferPool::Malloc);
+      this->SetReallocFunction(vtkBufferPool::Realloc);
+      this->SetFreeFunction(false, vtkBufferPool::Free);
+    }
+    else
+    {
+      this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
+      this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
+      this->SetFreeFunction(false, vtkObjectBase::GetCurrentFreeFunction());
+    }
   }
 
   ~vtkBuffer() override { this->SetBuffer(nullptr, 0); }
@@ -188,6 +201,11 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
       {
         this->DeleteFunction = free;
       }
+      else if (this->MallocFunction == vtkBufferPool::Malloc)
+      {
+        // The delete function may have been changed by SetFreeFunction().
+        this->DeleteFunction = vtkBufferPool::Free;
+      }
       return true;
     }
     return false;
@@ -204,7 +222,9 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     return this->Allocate(0);
   }
 
-  if (this->Pointer && this->DeleteFunction != free)
+  // Memory allocated by the pool is reallocated by the pool.
+  const bool pooled = (this->DeleteFunction == vtkBufferPool::Free);
+  if (this->Pointer && this->DeleteFunction != free && !pooled)
   {
     ScalarType* newArray;
     bool forceFreeFunction = false;
@@ -237,25 +257,35 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     {
       this->DeleteFunction = free;
     }
+    else if (this->MallocFunction == vtkBufferPool::Malloc)
+    {
+      this->DeleteFunction = vtkBufferPool::Free;
+    }
   }
   else
   {
     // Try to reallocate with minimal memory usage and possibly avoid
     // copying.
-    ScalarType* newArray = nullptr;
-    if (this->ReallocFunction)
+    vtkReallocingFunction reallocFunction = this->ReallocFunction ? this->ReallocFunction : realloc;
+    if (pooled)
     {
-      newArray = static_cast<ScalarType*>(
-        this->ReallocFunction(this->Pointer, newsize * sizeof(ScalarType)));
+      reallocFunction = vtkBufferPool::Realloc;
     }
-    else
+    else if (this->Pointer && reallocFunction == vtkBufferPool::Realloc)
     {
-      newArray = static_cast<ScalarType*>(realloc(this->Pointer, newsize * sizeof(ScalarType)));
+      // The current memory was not allocated by the pool.
+      reallocFunction = realloc;
     }
+    ScalarType* newArray =
+      static_cast<ScalarType*>(reallocFunction(this->Pointer, newsize * sizeof(ScalarType)));
     if (!newArray)
     {
       return false;
     }
+    if (!this->Pointer && reallocFunction == vtkBufferPool::Realloc)
+    {
+      this->DeleteFunction = vtkBufferPool::Free;
+    }
     this->Pointer = newArray;
     this->Size = newsize;
   }
@@ -0,0 +1,350 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBufferPool.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBufferPool.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm> // For std::min
+#include <atomic>    // For std::atomic
+#include <cstdlib>   // For malloc, realloc, free
+#include <cstring>   // For memcpy
+#include <map>       // For std::map
+#include <mutex>     // For std::mutex
+#include <vector>    // For std::vector
+
+vtkStandardNewMacro(vtkBufferPool);
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Every block starts with a header giving its usable size, padded to keep the
+// alignment of malloc for the returned pointer.
+union BlockHeader
+{
+  struct
+  {
+    size_t Size;
+    bool Pooled;
+  } Info;
+  std::max_align_t Alignment;
+};
+
+//------------------------------------------------------------------------------
+struct PoolState
+{
+  std::mutex Mutex;
+  // Retained blocks (pointers to their header) by size class.
+  std::map<size_t, std::vector<BlockHeader*>> Retained;
+
+  vtkTypeUInt64 MaximumRetainedSize = vtkTypeUInt64(1) << 30;
+  vtkTypeUInt64 MinimumPooledSize = vtkTypeUInt64(1) << 16;
+
+  vtkTypeUInt64 NumberOfHits = 0;
+  vtkTypeUInt64 NumberOfMisses = 0;
+  vtkTypeUInt64 RetainedSize = 0;
+  vtkTypeUInt64 PeakRetainedSize = 0;
+  vtkTypeUInt64 NumberOfRetainedBuffers = 0;
+};
+
+std::atomic<bool> Enabled(false);
+
+//------------------------------------------------------------------------------
+// The state is never destroyed: buffers may be released by static objects
+// after the end of main().
+PoolState& GetState()
+{
+  static PoolState* state = new PoolState;
+  return *state;
+}
+
+//------------------------------------------------------------------------------
+// Size classes are spaced by a quarter of the largest power of two below size.
+size_t GetClassSize(size_t size)
+{
+  size_t power = 1;
+  while (power <= size / 2)
+  {
+    power *= 2;
+  }
+  const size_t step = std::max<size_t>(power / 4, 1);
+  return (size + step - 1) / step * step;
+}
+
+//------------------------------------------------------------------------------
+void* ToUser(BlockHeader* header)
+{
+  return header + 1;
+}
+
+//------------------------------------------------------------------------------
+BlockHeader* ToHeader(void* ptr)
+{
+  return static_cast<BlockHeader*>(ptr) - 1;
+}
+
+//------------------------------------------------------------------------------
+// Free retained blocks, largest first, until at most maximumSize bytes are
+// retained. The mutex must be locked.
+void TrimRetained(PoolState& state, vtkTypeUInt64 maximumSize)
+{
+  auto it = state.Retained.end();
+  while (state.RetainedSize > maximumSize && it != state.Retained.begin())
+  {
+    --it;
+    std::vector<BlockHeader*>& blocks = it->second;
+    while (state.RetainedSize > maximumSize && !blocks.empty())
+    {
+      free(blocks.back());
+      blocks.pop_back();
+      state.RetainedSize -= it->first;
+      --state.NumberOfRetainedBuffers;
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferPool::SetEnabled(bool enabled)
+{
+  Enabled = enabled;
+  if (!enabled)
+  {
+    vtkBufferPool::ReleaseRetainedBuffers();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkBufferPool::GetEnabled()
+{
+  return Enabled;
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferPool::SetMaximumRetainedSize(vtkTypeUInt64 size)
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.MaximumRetainedSize = size;
+  TrimRetained(state, size);
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetMaximumRetainedSize()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.MaximumRetainedSize;
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferPool::SetMinimumPooledSize(vtkTypeUInt64 size)
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.MinimumPooledSize = size;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetMinimumPooledSize()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.MinimumPooledSize;
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferPool::ReleaseRetainedBuffers()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  TrimRetained(state, 0);
+  state.Retained.clear();
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetNumberOfHits()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.NumberOfHits;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetNumberOfMisses()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.NumberOfMisses;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetRetainedSize()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.RetainedSize;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetPeakRetainedSize()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.PeakRetainedSize;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeUInt64 vtkBufferPool::GetNumberOfRetainedBuffers()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.NumberOfRetainedBuffers;
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferPool::ResetStatistics()
+{
+  PoolState& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.NumberOfHits = 0;
+  state.NumberOfMisses = 0;
+  state.PeakRetainedSize = state.RetainedSize;
+}
+
+//------------------------------------------------------------------------------
+void* vtkBufferPool::Malloc(size_t size)
+{
+  PoolState& state = GetState();
+  BlockHeader* header = nullptr;
+  size_t classSize = 0;
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    if (size >= state.MinimumPooledSize)
+    {
+      classSize = GetClassSize(size);
+      auto it = state.Retained.find(classSize);
+      if (it != state.Retained.end() && !it->second.empty())
+      {
+        header = it->second.back();
+        it->second.pop_back();
+        state.RetainedSize -= classSize;
+        --state.NumberOfRetainedBuffers;
+        ++state.NumberOfHits;
+        return ToUser(header);
+      }
+      ++state.NumberOfMisses;
+    }
+  }
+
+  const size_t blockSize = classSize ? classSize : size;
+  header = static_cast<BlockHeader*>(malloc(sizeof(BlockHeader) + blockSize));
+  if (!header && classSize)
+  {
+    // The retained buffers may be what prevents the allocation.
+    vtkBufferPool::ReleaseRetainedBuffers();
+    header = static_cast<BlockHeader*>(malloc(sizeof(BlockHeader) + blockSize));
+  }
+  if (!header)
+  {
+    return nullptr;
+  }
+  header->Info.Size = blockSize;
+  header->Info.Pooled = (classSize != 0);
+  return ToUser(header);
+}
+
+//------------------------------------------------------------------------------
+void* vtkBufferPool::Realloc(void* ptr, size_t size)
+{
+  if (!ptr)
+  {
+    return vtkBufferPool::Malloc(size);
+  }
+  if (size == 0)
+  {
+    vtkBufferPool::Free(ptr);
+    return nullptr;
+  }
+
+  BlockHeader* header = ToHeader(ptr);
+  const vtkTypeUInt64 minimumPooledSize = vtkBufferPool::GetMinimumPooledSize();
+  if (header->Info.Pooled)
+  {
+    // Keep the block when the size class does not change.
+    if (size >= minimumPooledSize && GetClassSize(size) == header->Info.Size)
+    {
+      return ptr;
+    }
+  }
+  else if (size < minimumPooledSize)
+  {
+    header = static_cast<BlockHeader*>(realloc(header, sizeof(BlockHeader) + size));
+    if (!header)
+    {
+      return nullptr;
+    }
+    header->Info.Size = size;
+    return ToUser(header);
+  }
+
+  void* newPtr = vtkBufferPool::Malloc(size);
+  if (!newPtr)
+  {
+    return nullptr;
+  }
+  memcpy(newPtr, ptr, std::min(size, header->Info.Size));
+  vtkBufferPool::Free(ptr);
+  return newPtr;
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferPool::Free(void* ptr)
+{
+  if (!ptr)
+  {
+    return;
+  }
+
+  BlockHeader* header = ToHeader(ptr);
+  if (header->Info.Pooled && Enabled)
+  {
+    PoolState& state = GetState();
+    const size_t classSize = header->Info.Size;
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    if (state.RetainedSize + classSize <= state.MaximumRetainedSize)
+    {
+      state.Retained[classSize].push_back(header);
+      state.RetainedSize += classSize;
+      ++state.NumberOfRetainedBuffers;
+      state.PeakRetainedSize = std::max(state.PeakRetainedSize, state.RetainedSize);
+      return;
+    }
+  }
+  free(header);
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferPool::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkBufferPool::GetEnabled() << "\n";
+  os << indent << "MaximumRetainedSize: " << vtkBufferPool::GetMaximumRetainedSize() << "\n";
+  os << indent << "MinimumPooledSize: " << vtkBufferPool::GetMinimumPooledSize() << "\n";
+  os << indent << "NumberOfHits: " << vtkBufferPool::GetNumberOfHits() << "\n";
+  os << indent << "NumberOfMisses: " << vtkBufferPool::GetNumberOfMisses() << "\n";
+  os << indent << "RetainedSize: " << vtkBufferPool::GetRetainedSize() << "\n";
+  os << indent << "PeakRetainedSize: " << vtkBufferPool::GetPeakRetainedSize() << "\n";
+  os << indent << "NumberOfRetainedBuffers: " << vtkBufferPool::GetNumberOfRetainedBuffers()
+     << "\n";
+}
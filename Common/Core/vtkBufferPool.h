@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBufferPool.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBufferPool
+ * @brief   recycle the memory of large data array buffers
+ *
+ * vtkBufferPool is a process wide allocator for the buffers of the data
+ * arrays (vtkBuffer). When a pipeline re-executes, for instance when the time
+ * step changes, each filter releases its output arrays and allocates new ones
+ * of the same sizes. With the pool enabled, released buffers are kept in size
+ * classes instead of being returned to the system, and the next allocation of
+ * the same size class reuses them, saving the malloc/free and page fault
+ * costs.
+ *
+ * The pool is disabled by default. Once enabled with SetEnabled(), it is used
+ * by every vtkBuffer created afterwards (unless memkind is in use). Buffers
+ * smaller than MinimumPooledSize are allocated and released directly.
+ * Size classes are spaced by a quarter of a power of two, so a buffer
+ * wastes at most 25% of its size.
+ *
+ * The memory retained by the pool is capped by MaximumRetainedSize: a released
+ * buffer that does not fit under the cap is returned to the system.
+ * ReleaseRetainedBuffers() returns all retained memory to the system.
+ *
+ * Statistics are provided: the number of allocations served from the pool
+ * (hits) or from the system (misses), and the number of bytes retained.
+ *
+ * All methods are static and thread safe.
+ *
+ * @sa
+ * vtkBuffer vtkObjectBase::GetCurrentMallocFunction
+ */
+
+#ifndef vtkBufferPool_h
+#define vtkBufferPool_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <cstddef> // For size_t
+
+class VTKCOMMONCORE_EXPORT vtkBufferPool : public vtkObject
+{
+public:
+  static vtkBufferPool* New();
+  vtkTypeMacro(vtkBufferPool, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Enable or disable the pool for the buffers created afterwards.
+   * Disabling the pool releases the retained buffers. Default is false.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of bytes the pool may retain. Default is 1 GiB.
+   * Lowering the cap releases retained buffers until the cap is met.
+   */
+  static void SetMaximumRetainedSize(vtkTypeUInt64 size);
+  static vtkTypeUInt64 GetMaximumRetainedSize();
+  ///@}
+
+  ///@{
+  /**
+   * Allocations smaller than this number of bytes are not pooled.
+   * Default is 64 KiB.
+   */
+  static void SetMinimumPooledSize(vtkTypeUInt64 size);
+  static vtkTypeUInt64 GetMinimumPooledSize();
+  ///@}
+
+  /**
+   * Return all the retained buffers to the system.
+   */
+  static void ReleaseRetainedBuffers();
+
+  ///@{
+  /**
+   * Statistics of the pool. Hits are pooled allocations served by a retained
+   * buffer, misses are pooled allocations served by the system.
+   * ResetStatistics() resets the counters, not the retained memory.
+   */
+  static vtkTypeUInt64 GetNumberOfHits();
+  static vtkTypeUInt64 GetNumberOfMisses();
+  static vtkTypeUInt64 GetRetainedSize();
+  static vtkTypeUInt64 GetPeakRetainedSize();
+  static vtkTypeUInt64 GetNumberOfRetainedBuffers();
+  static void ResetStatistics();
+  ///@}
+
+  ///@{
+  /**
+   * malloc, realloc and free replacements used by vtkBuffer when the pool is
+   * enabled. Memory allocated by Malloc() or Realloc() must be released by
+   * Free(). Realloc() keeps the buffer in place when its size class does not
+   * change.
+   */
+#ifndef __VTK_WRAP__
+  static void* Malloc(size_t size);
+  static void* Realloc(void* ptr, size_t size);
+  static void Free(void* ptr);
+#endif
+  ///@}
+
+protected:
+  vtkBufferPool() = default;
+  ~vtkBufferPool() override = default;
+
+private:
+  vtkBufferPool(const vtkBufferPool&) = delete;
+  void operator=(const vtkBufferPool&) = delete;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompositeArray
+ * @brief   An implicit array concatenating other arrays
+ *
+ * vtkCompositeArray<T> is a vtkImplicitArray whose tuples are the tuples of
+ * several arrays, one after the other. Appending the attributes of several
+ * datasets then costs no copy. The arrays must have the same number of
+ * components. vtk::ConcatenateDataArrays() creates the array:
+ *
+ * @code
+ * vtkSmartPointer<vtkCompositeArray<float>> all =
+ *   vtk::ConcatenateDataArrays<float>({ first, second, third });
+ * @endcode
+ *
+ * The backend keeps references to the arrays, which must not be resized while
+ * the implicit array is used. Looking up the array holding a value is a
+ * binary search over the arrays.
+ *
+ * @sa
+ * vtkImplicitArray vtkIndexedArray
+ */
+
+#ifndef vtkCompositeArray_h
+#define vtkCompositeArray_h
+
+#include "vtkImplicitArray.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm> // For std::upper_bound
+#include <vector>    // For std::vector
+
+/**
+ * Backend of vtkCompositeArray.
+ */
+template <typename ValueType>
+struct vtkCompositeImplicitBackend
+{
+  vtkCompositeImplicitBackend(const std::vector<vtkDataArray*>& arrays)
+  {
+    vtkIdType offset = 0;
+    for (vtkDataArray* array : arrays)
+    {
+      if (!array || array->GetNumberOfValues() == 0)
+      {
+        continue;
+      }
+      this->Readers.emplace_back(array);
+      this->Offsets.push_back(offset);
+      offset += array->GetNumberOfValues();
+    }
+    this->Offsets.push_back(offset);
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    // Offsets[i] is the first value of array i, Offsets.back() the total.
+    const auto it = std::upper_bound(this->Offsets.begin(), this->Offsets.end() - 1, valueIdx);
+    const std::size_t arrayIdx = static_cast<std::size_t>(it - this->Offsets.begin()) - 1;
+    return this->Readers[arrayIdx](valueIdx - this->Offsets[arrayIdx]);
+  }
+
+  std::vector<vtk::detail::ImplicitArrayValueReader<ValueType>> Readers;
+  std::vector<vtkIdType> Offsets;
+};
+
+template <typename T>
+using vtkCompositeArray = vtkImplicitArray<vtkCompositeImplicitBackend<T>>;
+
+namespace vtk
+{
+/**
+ * Create a vtkCompositeArray concatenating @a arrays. The arrays must have the
+ * same number of components. Null arrays are skipped.
+ */
+template <typename T>
+vtkSmartPointer<vtkCompositeArray<T>> ConcatenateDataArrays(
+  const std::vector<vtkDataArray*>& arrays)
+{
+  vtkSmartPointer<vtkCompositeArray<T>> result = vtkSmartPointer<vtkCompositeArray<T>>::New();
+  int numComps = 1;
+  vtkIdType numTuples = 0;
+  for (vtkDataArray* array : arrays)
+  {
+    if (array)
+    {
+      numComps = array->GetNumberOfComponents();
+      numTuples += array->GetNumberOfTuples();
+    }
+  }
+  result->ConstructBackend(arrays);
+  result->SetNumberOfComponents(numComps);
+  result->SetNumberOfTuples(numTuples);
+  return result;
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkCompositeArray.h
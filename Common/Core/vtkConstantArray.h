@@ -0,0 +1,57 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConstantArray
+ * @brief   An implicit array whose values are all equal
+ *
+ * vtkConstantArray<T> is a vtkImplicitArray returning the same value for
+ * every index, for instance a uniform scalar field or a default attribute:
+ *
+ * @code
+ * vtkNew<vtkConstantArray<float>> ones;
+ * ones->ConstructBackend(1.0f);
+ * ones->SetNumberOfTuples(numberOfPoints);
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray vtkAffineArray
+ */
+
+#ifndef vtkConstantArray_h
+#define vtkConstantArray_h
+
+#include "vtkImplicitArray.h"
+
+/**
+ * Backend of vtkConstantArray.
+ */
+template <typename ValueType>
+struct vtkConstantImplicitBackend
+{
+  vtkConstantImplicitBackend(ValueType value)
+    : Value(value)
+  {
+  }
+
+  ValueType operator()(vtkIdType) const { return this->Value; }
+
+  const ValueType Value;
+};
+
+template <typename T>
+using vtkConstantArray = vtkImplicitArray<vtkConstantImplicitBackend<T>>;
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConstantArray.h
@@ -18,6 +18,8 @@
 #include "vtkArrayDispatch.h"
 #include "vtkBitArray.h"
 #include "vtkCharArray.h"
+#include "vtkDataArrayBlockAccessor.h"
+#include "vtkDataArrayKernels.h"
 #include "vtkDataArrayPrivate.txx"
 #include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
@@ -48,9 +50,13 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <algorithm> // for min(), max()
+#include <atomic>    // for std::atomic
 
 namespace
 {
+// Default value of vtkAOSDataArrayTemplate::ParallelFirstTouch.
+std::atomic<bool> DefaultParallelFirstTouch(false);
+
 template <typename ValueType>
 struct threadedCopyFunctor
 {
@@ -64,6 +70,23 @@ struct threadedCopyFunctor
   }
 };
 
+struct threadedConvertFunctor
+{
+  const void* Source;
+  int SourceType;
+  int SourceValueSize;
+  void* Destination;
+  int DestinationType;
+  int DestinationValueSize;
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    vtkDataArrayKernels::ConvertValues(
+      static_cast<const char*>(this->Source) + begin * this->SourceValueSize, this->SourceType,
+      static_cast<char*>(this->Destination) + begin * this->DestinationValueSize,
+      this->DestinationType, end - begin);
+  }
+};
+
 //--------Copy tuples from src to dest------------------------------------------
 struct DeepCopyWorker
 {
@@ -90,6 +113,38 @@ struct DeepCopyWorker
     }
   }
 
+  // AoS --> AoS type conversion, with the vectorized kernels for the common
+  // value types:
+  template <typename SrcValueType, typename DstValueType>
+  void operator()(
+    vtkAOSDataArrayTemplate<SrcValueType>* src, vtkAOSDataArrayTemplate<DstValueType>* dst) const
+  {
+    if (!vtkDataArrayKernels::IsConversionSupported(src->GetDataType()) ||
+      !vtkDataArrayKernels::IsConversionSupported(dst->GetDataType()))
+    {
+      this->DoGenericCopy(src, dst);
+      return;
+    }
+
+    threadedConvertFunctor worker;
+    worker.Source = src->GetPointer(0);
+    worker.SourceType = src->GetDataType();
+    worker.SourceValueSize = static_cast<int>(sizeof(SrcValueType));
+    worker.Destination = dst->GetPointer(0);
+    worker.DestinationType = dst->GetDataType();
+    worker.DestinationValueSize = static_cast<int>(sizeof(DstValueType));
+    vtkIdType len = src->GetNumberOfValues();
+    if (len < 1024 * 1024)
+    {
+      worker(0, len);
+    }
+    else
+    {
+      int numThreads = std::min(vtkSMPTools::GetEstimatedNumberOfThreads(), 16);
+      vtkSMPTools::For(0, len, len / numThreads, worker);
+    }
+  }
+
 #if defined(__clang__) && defined(__has_warning)
 #if __has_warning("-Wunused-template")
 #pragma clang diagnostic push
@@ -164,7 +219,19 @@ struct DeepCopyWorker
     this->DoGenericCopy(src, dst);
   }
 
-  void operator()(vtkDataArray* src, vtkDataArray* dst) const { this->DoGenericCopy(src, dst); }
+  // Dispatch failure: copy blocks of tuples, with one virtual call per tuple
+  // instead of one per component.
+  void operator()(vtkDataArray* src, vtkDataArray* dst) const
+  {
+    vtkDataArrayBlockAccessor<vtkDataArray> srcAccessor(src);
+    vtkDataArrayBlockAccessor<vtkDataArray> dstAccessor(dst);
+    const vtkIdType numTuples = src->GetNumberOfTuples();
+    for (vtkIdType begin = 0; begin < numTuples; begin += srcAccessor.GetBlockSize())
+    {
+      const vtkIdType end = std::min(begin + srcAccessor.GetBlockSize(), numTuples);
+      dstAccessor.Write(begin, end, srcAccessor.Read(begin, end));
+    }
+  }
 };
 
 //------------InterpolateTuple workers------------------------------------------
@@ -303,6 +370,18 @@ struct GetTuplesRangeWorker
       dstTuples[dstT] = srcTuples[srcT];
     }
   }
+
+  // Dispatch failure: copy blocks of tuples through the vtkDataArray API.
+  void operator()(vtkDataArray* src, vtkDataArray* dst) const
+  {
+    vtkDataArrayBlockAccessor<vtkDataArray> srcAccessor(src);
+    vtkDataArrayBlockAccessor<vtkDataArray> dstAccessor(dst);
+    for (vtkIdType begin = this->Start; begin <= this->End; begin += srcAccessor.GetBlockSize())
+    {
+      const vtkIdType end = std::min(begin + srcAccessor.GetBlockSize(), this->End + 1);
+      dstAccessor.Write(begin - this->Start, end - this->Start, srcAccessor.Read(begin, end));
+    }
+  }
 };
 
 //----------------SetTuple (from array)-----------------------------------------
@@ -692,7 +771,7 @@ void vtkDataArray::InsertTuplesStartingAt(
   }
 
   vtkIdType maxSrcTupleId = srcIds->GetId(0);
-  vtkIdType maxDstTupleId = dstStart + srcIds->GetNumberOfIds();
+  vtkIdType maxDstTupleId = dstStart + srcIds->GetNumberOfIds() - 1;
   for (int i = 1; i < srcIds->GetNumberOfIds(); ++i)
   {
     maxSrcTupleId = std::max(maxSrcTupleId, srcIds->GetId(i));
@@ -1397,6 +1476,18 @@ unsigned long vtkDataArray::GetActualMemorySize() const
   return static_cast<unsigned long>(ceil((size * static_cast<double>(numPrims)) / 1024.0));
 }
 
+//------------------------------------------------------------------------------
+void vtkDataArray::SetDefaultParallelFirstTouch(bool parallelFirstTouch)
+{
+  DefaultParallelFirstTouch = parallelFirstTouch;
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArray::GetDefaultParallelFirstTouch()
+{
+  return DefaultParallelFirstTouch;
+}
+
 //------------------------------------------------------------------------------
 vtkDataArray* vtkDataArray::CreateDataArray(int dataType)
 {
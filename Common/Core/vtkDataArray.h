@@ -459,6 +459,16 @@ public:
   VTK_NEWINSTANCE
   static vtkDataArray* CreateDataArray(int dataType);
 
+  ///@{
+  /**
+   * Set/Get the parallel first touch setting of the array-of-structs arrays
+   * (vtkAOSDataArrayTemplate) created afterwards. Off by default.
+   * See vtkAOSDataArrayTemplate::SetParallelFirstTouch().
+   */
+  static void SetDefaultParallelFirstTouch(bool parallelFirstTouch);
+  static bool GetDefaultParallelFirstTouch();
+  ///@}
+
   /**
    * This key is used to hold tight bounds on the range of
    * one component over all tuples of the array.
@@ -587,6 +597,7 @@ inline vtkDataArray* vtkDataArray::FastDownCast(vtkAbstractArray* source)
       case TypedDataArray:
       case DataArray:
       case MappedDataArray:
+      case ImplicitArray:
         return static_cast<vtkDataArray*>(source);
       default:
         break;
@@ -0,0 +1,266 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayBlockAccessor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/**
+ * @class   vtkDataArrayBlockAccessor
+ * @brief   Access a vtkDataArray by contiguous blocks of tuples.
+ *
+ * vtkDataArrayBlockAccessor reads and writes blocks of consecutive tuples of
+ * an array through a contiguous array-of-structs buffer. Kernels written on
+ * this buffer are simple loops over plain pointers that the compiler can
+ * vectorize, whatever the memory layout of the array:
+ *
+ * - vtkAOSDataArrayTemplate: the buffer is the array memory, no copy is made.
+ * - vtkSOADataArrayTemplate: each component array is copied with a strided
+ *   store into a scratch buffer.
+ * - other vtkGenericDataArray subclasses: tuples are copied with the
+ *   non-virtual typed tuple API.
+ * - vtkDataArray (dispatch failure): tuples are copied as doubles with one
+ *   virtual call per tuple instead of one per component.
+ *
+ * It is meant for the fallback path of vtkArrayDispatch, where the array type
+ * is unknown:
+ *
+ * @code
+ * struct ScaleWorker
+ * {
+ *   template <typename ArrayT>
+ *   void operator()(ArrayT* array, double factor)
+ *   {
+ *     using APIType = typename vtkDataArrayBlockAccessor<ArrayT>::APIType;
+ *     vtkDataArrayBlockAccessor<ArrayT> accessor(array);
+ *     const int numComps = array->GetNumberOfComponents();
+ *     const vtkIdType numTuples = array->GetNumberOfTuples();
+ *     for (vtkIdType begin = 0; begin < numTuples; begin += accessor.GetBlockSize())
+ *     {
+ *       const vtkIdType end = std::min(begin + accessor.GetBlockSize(), numTuples);
+ *       APIType* block = accessor.Read(begin, end);
+ *       for (vtkIdType i = 0; i < (end - begin) * numComps; ++i)
+ *       {
+ *         block[i] = static_cast<APIType>(block[i] * factor);
+ *       }
+ *       accessor.Write(begin, end, block);
+ *     }
+ *   }
+ * };
+ *
+ * if (!vtkArrayDispatch::Dispatch::Execute(array, worker, 2.))
+ * {
+ *   worker(array, 2.); // Block copies through the vtkDataArray API.
+ * }
+ * @endcode
+ *
+ * The pointer returned by Read() is valid until the next call to Read() or
+ * GetScratch(). Writing to it modifies the array only for array-of-structs
+ * arrays: call Write() to store the block in the array in every case.
+ *
+ * @sa
+ * vtkArrayDispatch vtkDataArrayAccessor vtk::DataArrayTupleRange
+ */
+
+#ifndef vtkDataArrayBlockAccessor_h
+#define vtkDataArrayBlockAccessor_h
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayMeta.h"
+#include "vtkGenericDataArray.h"
+#include "vtkSOADataArrayTemplate.h"
+
+#include <algorithm> // For std::copy
+#include <vector>    // For std::vector
+
+#ifndef __VTK_WRAP__
+
+namespace vtk
+{
+namespace detail
+{
+//------------------------------------------------------------------------------
+// Read tuples [begin, end) into scratch, or return a pointer to them when the
+// array memory already has the right layout.
+template <typename ValueType>
+ValueType* ReadTupleBlock(
+  vtkAOSDataArrayTemplate<ValueType>* array, vtkIdType begin, vtkIdType, ValueType*)
+{
+  return array->GetPointer(begin * array->GetNumberOfComponents());
+}
+
+template <typename ValueType>
+ValueType* ReadTupleBlock(
+  vtkSOADataArrayTemplate<ValueType>* array, vtkIdType begin, vtkIdType end, ValueType* scratch)
+{
+  const int numComps = array->GetNumberOfComponents();
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    const ValueType* source = array->GetComponentArrayPointer(comp) + begin;
+    ValueType* destination = scratch + comp;
+    for (vtkIdType i = 0; i < end - begin; ++i)
+    {
+      destination[i * numComps] = source[i];
+    }
+  }
+  return scratch;
+}
+
+template <typename DerivedT, typename ValueType>
+ValueType* ReadTupleBlock(vtkGenericDataArray<DerivedT, ValueType>* array, vtkIdType begin,
+  vtkIdType end, ValueType* scratch)
+{
+  DerivedT* derived = static_cast<DerivedT*>(array);
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
+  {
+    derived->GetTypedTuple(tupleIdx, scratch + (tupleIdx - begin) * numComps);
+  }
+  return scratch;
+}
+
+inline double* ReadTupleBlock(vtkDataArray* array, vtkIdType begin, vtkIdType end, double* scratch)
+{
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
+  {
+    array->GetTuple(tupleIdx, scratch + (tupleIdx - begin) * numComps);
+  }
+  return scratch;
+}
+
+//------------------------------------------------------------------------------
+// Write tuples [begin, end) from block.
+template <typename ValueType>
+void WriteTupleBlock(
+  vtkAOSDataArrayTemplate<ValueType>* array, vtkIdType begin, vtkIdType end, const ValueType* block)
+{
+  const int numComps = array->GetNumberOfComponents();
+  ValueType* destination = array->GetPointer(begin * numComps);
+  if (destination != block)
+  {
+    std::copy(block, block + (end - begin) * numComps, destination);
+  }
+}
+
+template <typename ValueType>
+void WriteTupleBlock(
+  vtkSOADataArrayTemplate<ValueType>* array, vtkIdType begin, vtkIdType end, const ValueType* block)
+{
+  const int numComps = array->GetNumberOfComponents();
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    ValueType* destination = array->GetComponentArrayPointer(comp) + begin;
+    const ValueType* source = block + comp;
+    for (vtkIdType i = 0; i < end - begin; ++i)
+    {
+      destination[i] = source[i * numComps];
+    }
+  }
+}
+
+template <typename DerivedT, typename ValueType>
+void WriteTupleBlock(vtkGenericDataArray<DerivedT, ValueType>* array, vtkIdType begin,
+  vtkIdType end, const ValueType* block)
+{
+  DerivedT* derived = static_cast<DerivedT*>(array);
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
+  {
+    derived->SetTypedTuple(tupleIdx, block + (tupleIdx - begin) * numComps);
+  }
+}
+
+inline void WriteTupleBlock(
+  vtkDataArray* array, vtkIdType begin, vtkIdType end, const double* block)
+{
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
+  {
+    array->SetTuple(tupleIdx, block + (tupleIdx - begin) * numComps);
+  }
+}
+} // end namespace detail
+} // end namespace vtk
+
+template <typename ArrayT>
+class vtkDataArrayBlockAccessor
+{
+public:
+  using ArrayType = ArrayT;
+  using APIType = vtk::GetAPIType<ArrayT>;
+
+  /**
+   * Default number of tuples of a block, small enough for the scratch buffer
+   * of a few components to stay in the L1 cache.
+   */
+  static constexpr vtkIdType DefaultBlockSize = 512;
+
+  vtkDataArrayBlockAccessor(ArrayType* array, vtkIdType blockSize = DefaultBlockSize)
+    : Array(array)
+    , BlockSize(blockSize > 0 ? blockSize : DefaultBlockSize)
+  {
+  }
+
+  /**
+   * Number of tuples of the blocks the scratch buffer is sized for. Larger
+   * blocks are supported but grow the scratch buffer.
+   */
+  vtkIdType GetBlockSize() const { return this->BlockSize; }
+
+  /**
+   * Return the values of tuples [begin, end), as (end - begin) *
+   * NumberOfComponents contiguous values.
+   */
+  APIType* Read(vtkIdType begin, vtkIdType end)
+  {
+    return vtk::detail::ReadTupleBlock(this->Array, begin, end, this->GetScratch(end - begin));
+  }
+
+  /**
+   * Store (end - begin) * NumberOfComponents contiguous values in tuples
+   * [begin, end). The tuples must exist.
+   */
+  void Write(vtkIdType begin, vtkIdType end, const APIType* block)
+  {
+    vtk::detail::WriteTupleBlock(this->Array, begin, end, block);
+  }
+
+  /**
+   * Return a scratch buffer for @a numTuples tuples, for instance to compute
+   * a block before writing it.
+   */
+  APIType* GetScratch(vtkIdType numTuples)
+  {
+    const std::size_t size =
+      static_cast<std::size_t>(numTuples * this->Array->GetNumberOfComponents());
+    if (this->Scratch.size() < size)
+    {
+      this->Scratch.resize(std::max(
+        size, static_cast<std::size_t>(this->BlockSize * this->Array->GetNumberOfComponents())));
+    }
+    return this->Scratch.data();
+  }
+
+private:
+  ArrayType* Array;
+  vtkIdType BlockSize;
+  std::vector<APIType> Scratch;
+};
+
+template <typename ArrayT>
+constexpr vtkIdType vtkDataArrayBlockAccessor<ArrayT>::DefaultBlockSize;
+
+#endif
+
+#endif // vtkDataArrayBlockAccessor_h
+// VTK-HeaderTest-Exclude: vtkDataArrayBlockAccessor.h
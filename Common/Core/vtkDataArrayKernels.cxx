@@ -0,0 +1,587 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayKernels.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArrayKernels.h"
+#include "vtkObjectFactory.h"
+
+#include <atomic>  // For std::atomic
+#include <cstring> // For memcpy
+
+vtkStandardNewMacro(vtkDataArrayKernels);
+
+// The kernels are compiled for each instruction set with the target
+// attribute of GCC and Clang.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VTK_DATA_ARRAY_KERNELS_X86
+#endif
+
+#if defined(__GNUC__)
+#define VTK_KERNEL_INLINE inline __attribute__((always_inline))
+#else
+#define VTK_KERNEL_INLINE inline
+#endif
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Kernel bodies. They are inlined in the instruction set specific wrappers
+// below, and vectorized for the instruction set of each wrapper.
+namespace impl
+{
+// NaN values fail both comparisons, so they never enter the range.
+template <typename T, bool FiniteOnly>
+VTK_KERNEL_INLINE void UpdateRange(T value, T& min, T& max)
+{
+  if (FiniteOnly)
+  {
+    // v - v is 0 for finite values, NaN for infinite ones.
+    const bool finite = (value - value) == 0;
+    const T low = finite ? value : min;
+    const T high = finite ? value : max;
+    min = low < min ? low : min;
+    max = high > max ? high : max;
+  }
+  else
+  {
+    min = value < min ? value : min;
+    max = value > max ? value : max;
+  }
+}
+
+// Each component gets enough accumulators to fill a 512 bits register, so the
+// inner loop is a sequence of independent vector min/max operations.
+template <typename T, int NumComps, bool FiniteOnly>
+VTK_KERNEL_INLINE void ComputeRange(const T* values, vtkIdType numTuples, T* ranges)
+{
+  constexpr int Lanes = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+  constexpr int Width = NumComps * Lanes;
+  T mins[Width];
+  T maxs[Width];
+  for (int j = 0; j < Width; ++j)
+  {
+    mins[j] = ranges[2 * (j % NumComps)];
+    maxs[j] = ranges[2 * (j % NumComps) + 1];
+  }
+
+  const vtkIdType numValues = numTuples * NumComps;
+  vtkIdType i = 0;
+  for (; i + Width <= numValues; i += Width)
+  {
+    const T* block = values + i;
+    for (int j = 0; j < Width; ++j)
+    {
+      UpdateRange<T, FiniteOnly>(block[j], mins[j], maxs[j]);
+    }
+  }
+  for (int j = 0; j < Width; ++j)
+  {
+    T& min = ranges[2 * (j % NumComps)];
+    T& max = ranges[2 * (j % NumComps) + 1];
+    min = mins[j] < min ? mins[j] : min;
+    max = maxs[j] > max ? maxs[j] : max;
+  }
+  for (; i < numValues; i += NumComps)
+  {
+    for (int c = 0; c < NumComps; ++c)
+    {
+      UpdateRange<T, FiniteOnly>(values[i + c], ranges[2 * c], ranges[2 * c + 1]);
+    }
+  }
+}
+
+template <typename T, bool FiniteOnly>
+VTK_KERNEL_INLINE void ComputeRange(
+  const T* values, vtkIdType numTuples, int numComps, T* ranges)
+{
+  switch (numComps)
+  {
+    case 1:
+      ComputeRange<T, 1, FiniteOnly>(values, numTuples, ranges);
+      break;
+    case 2:
+      ComputeRange<T, 2, FiniteOnly>(values, numTuples, ranges);
+      break;
+    case 3:
+      ComputeRange<T, 3, FiniteOnly>(values, numTuples, ranges);
+      break;
+    case 4:
+      ComputeRange<T, 4, FiniteOnly>(values, numTuples, ranges);
+      break;
+    default:
+      for (vtkIdType t = 0; t < numTuples; ++t)
+      {
+        const T* tuple = values + t * numComps;
+        for (int c = 0; c < numComps; ++c)
+        {
+          UpdateRange<T, FiniteOnly>(tuple[c], ranges[2 * c], ranges[2 * c + 1]);
+        }
+      }
+      break;
+  }
+}
+
+template <typename S, typename D>
+VTK_KERNEL_INLINE void ConvertValues(const S* source, D* destination, vtkIdType numValues)
+{
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    destination[i] = static_cast<D>(source[i]);
+  }
+}
+
+// Tuple copies, with the tuple index of the source and destination given by
+// an id list or by the loop index when the list is null.
+template <typename T, int NumComps>
+VTK_KERNEL_INLINE void CopyTuples(
+  const T* source, const vtkIdType* sourceIds, const vtkIdType* destIds, vtkIdType numIds, T* dest)
+{
+  if (!destIds)
+  {
+    for (vtkIdType i = 0; i < numIds; ++i)
+    {
+      const T* tuple = source + sourceIds[i] * NumComps;
+      for (int c = 0; c < NumComps; ++c)
+      {
+        dest[i * NumComps + c] = tuple[c];
+      }
+    }
+  }
+  else if (!sourceIds)
+  {
+    for (vtkIdType i = 0; i < numIds; ++i)
+    {
+      T* tuple = dest + destIds[i] * NumComps;
+      for (int c = 0; c < NumComps; ++c)
+      {
+        tuple[c] = source[i * NumComps + c];
+      }
+    }
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < numIds; ++i)
+    {
+      const T* sourceTuple = source + sourceIds[i] * NumComps;
+      T* destTuple = dest + destIds[i] * NumComps;
+      for (int c = 0; c < NumComps; ++c)
+      {
+        destTuple[c] = sourceTuple[c];
+      }
+    }
+  }
+}
+
+template <typename T>
+VTK_KERNEL_INLINE void CopyTuples(const T* source, const vtkIdType* sourceIds,
+  const vtkIdType* destIds, vtkIdType numIds, int numComps, T* dest)
+{
+  switch (numComps)
+  {
+    case 1:
+      CopyTuples<T, 1>(source, sourceIds, destIds, numIds, dest);
+      break;
+    case 2:
+      CopyTuples<T, 2>(source, sourceIds, destIds, numIds, dest);
+      break;
+    case 3:
+      CopyTuples<T, 3>(source, sourceIds, destIds, numIds, dest);
+      break;
+    case 4:
+      CopyTuples<T, 4>(source, sourceIds, destIds, numIds, dest);
+      break;
+    default:
+    {
+      const size_t tupleSize = numComps * sizeof(T);
+      for (vtkIdType i = 0; i < numIds; ++i)
+      {
+        const vtkIdType sourceTuple = sourceIds ? sourceIds[i] : i;
+        const vtkIdType destTuple = destIds ? destIds[i] : i;
+        memcpy(dest + destTuple * numComps, source + sourceTuple * numComps, tupleSize);
+      }
+      break;
+    }
+  }
+}
+} // namespace impl
+
+//------------------------------------------------------------------------------
+// One set of wrappers per instruction set.
+#define VTK_DEFINE_KERNEL_SET(SetName, TargetAttribute)                                            \
+  struct SetName                                                                                   \
+  {                                                                                                \
+    template <typename T, bool FiniteOnly>                                                         \
+    static TargetAttribute void ComputeRange(                                                      \
+      const T* values, vtkIdType numTuples, int numComps, T* ranges)                               \
+    {                                                                                              \
+      impl::ComputeRange<T, FiniteOnly>(values, numTuples, numComps, ranges);                      \
+    }                                                                                              \
+    template <typename S, typename D>                                                              \
+    static TargetAttribute void ConvertValues(const S* source, D* dest, vtkIdType numValues)       \
+    {                                                                                              \
+      impl::ConvertValues(source, dest, numValues);                                                \
+    }                                                                                              \
+    template <typename T>                                                                          \
+    static TargetAttribute void CopyTuples(const T* source, const vtkIdType* sourceIds,            \
+      const vtkIdType* destIds, vtkIdType numIds, int numComps, T* dest)                           \
+    {                                                                                              \
+      impl::CopyTuples(source, sourceIds, destIds, numIds, numComps, dest);                        \
+    }                                                                                              \
+  }
+
+VTK_DEFINE_KERNEL_SET(GenericKernels, );
+#ifdef VTK_DATA_ARRAY_KERNELS_X86
+VTK_DEFINE_KERNEL_SET(SSE42Kernels, __attribute__((target("sse4.2"))));
+VTK_DEFINE_KERNEL_SET(AVX2Kernels, __attribute__((target("avx2"))));
+VTK_DEFINE_KERNEL_SET(AVX512Kernels, __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))));
+#endif
+
+#undef VTK_DEFINE_KERNEL_SET
+
+//------------------------------------------------------------------------------
+int DetectInstructionSet()
+{
+#if defined(VTK_DATA_ARRAY_KERNELS_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+    __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+  {
+    return vtkDataArrayKernels::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return vtkDataArrayKernels::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2"))
+  {
+    return vtkDataArrayKernels::SSE4_2;
+  }
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+  return vtkDataArrayKernels::NEON;
+#endif
+  return vtkDataArrayKernels::GENERIC;
+}
+
+int BestInstructionSet()
+{
+  static const int best = DetectInstructionSet();
+  return best;
+}
+
+// -1 until the instruction set is first used or set.
+std::atomic<int> SelectedInstructionSet(-1);
+
+int ActiveInstructionSet()
+{
+  int selected = SelectedInstructionSet.load(std::memory_order_relaxed);
+  if (selected < 0)
+  {
+    selected = BestInstructionSet();
+    SelectedInstructionSet.store(selected, std::memory_order_relaxed);
+  }
+  return selected;
+}
+
+// Call a kernel of the selected instruction set.
+#ifdef VTK_DATA_ARRAY_KERNELS_X86
+#define VTK_DISPATCH_KERNEL(...)                                                                   \
+  switch (ActiveInstructionSet())                                                                  \
+  {                                                                                                \
+    case vtkDataArrayKernels::AVX512:                                                              \
+      AVX512Kernels::__VA_ARGS__;                                                                  \
+      break;                                                                                       \
+    case vtkDataArrayKernels::AVX2:                                                                \
+      AVX2Kernels::__VA_ARGS__;                                                                    \
+      break;                                                                                       \
+    case vtkDataArrayKernels::SSE4_2:                                                              \
+      SSE42Kernels::__VA_ARGS__;                                                                   \
+      break;                                                                                       \
+    default:                                                                                       \
+      GenericKernels::__VA_ARGS__;                                                                 \
+      break;                                                                                       \
+  }
+#else
+#define VTK_DISPATCH_KERNEL(...) GenericKernels::__VA_ARGS__
+#endif
+
+//------------------------------------------------------------------------------
+template <typename T>
+bool DispatchComputeRange(
+  const T* values, vtkIdType numTuples, int numComps, T* ranges, bool finiteOnly)
+{
+  if (numTuples <= 0 || numComps <= 0)
+  {
+    return true;
+  }
+  if (finiteOnly)
+  {
+    VTK_DISPATCH_KERNEL(ComputeRange<T, true>(values, numTuples, numComps, ranges));
+  }
+  else
+  {
+    VTK_DISPATCH_KERNEL(ComputeRange<T, false>(values, numTuples, numComps, ranges));
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Map the supported VTK types to the value types of the kernels.
+int GetKernelType(int dataType)
+{
+  switch (dataType)
+  {
+    case VTK_FLOAT:
+    case VTK_DOUBLE:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_TYPE_INT32:
+    case VTK_TYPE_INT64:
+      return dataType;
+    case VTK_ID_TYPE:
+      return VTK_ID_TYPE_IMPL == VTK_TYPE_INT64 || VTK_ID_TYPE_IMPL == VTK_TYPE_INT32
+        ? VTK_ID_TYPE_IMPL
+        : -1;
+    default:
+      return -1;
+  }
+}
+
+template <typename S>
+bool DispatchConvertValues(const S* source, int destType, void* dest, vtkIdType numValues)
+{
+  switch (destType)
+  {
+    case VTK_FLOAT:
+      VTK_DISPATCH_KERNEL(ConvertValues(source, static_cast<float*>(dest), numValues));
+      return true;
+    case VTK_DOUBLE:
+      VTK_DISPATCH_KERNEL(ConvertValues(source, static_cast<double*>(dest), numValues));
+      return true;
+    case VTK_UNSIGNED_CHAR:
+      VTK_DISPATCH_KERNEL(ConvertValues(source, static_cast<vtkTypeUInt8*>(dest), numValues));
+      return true;
+    case VTK_TYPE_INT32:
+      VTK_DISPATCH_KERNEL(ConvertValues(source, static_cast<vtkTypeInt32*>(dest), numValues));
+      return true;
+    case VTK_TYPE_INT64:
+      VTK_DISPATCH_KERNEL(ConvertValues(source, static_cast<vtkTypeInt64*>(dest), numValues));
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+void DispatchCopyTuples(const void* source, const vtkIdType* sourceIds, const vtkIdType* destIds,
+  vtkIdType numIds, int numComps, void* dest)
+{
+  VTK_DISPATCH_KERNEL(CopyTuples(static_cast<const T*>(source), sourceIds, destIds, numIds,
+    numComps, static_cast<T*>(dest)));
+}
+
+bool DispatchCopyTuples(const void* source, const vtkIdType* sourceIds, const vtkIdType* destIds,
+  vtkIdType numIds, int valueSize, int numComps, void* dest)
+{
+  if (numIds <= 0 || numComps <= 0)
+  {
+    return valueSize == 1 || valueSize == 2 || valueSize == 4 || valueSize == 8;
+  }
+  // Values are copied as unsigned integers of the same size.
+  switch (valueSize)
+  {
+    case 1:
+      DispatchCopyTuples<vtkTypeUInt8>(source, sourceIds, destIds, numIds, numComps, dest);
+      return true;
+    case 2:
+      DispatchCopyTuples<vtkTypeUInt16>(source, sourceIds, destIds, numIds, numComps, dest);
+      return true;
+    case 4:
+      DispatchCopyTuples<vtkTypeUInt32>(source, sourceIds, destIds, numIds, numComps, dest);
+      return true;
+    case 8:
+      DispatchCopyTuples<vtkTypeUInt64>(source, sourceIds, destIds, numIds, numComps, dest);
+      return true;
+    default:
+      return false;
+  }
+}
+
+#undef VTK_DISPATCH_KERNEL
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void vtkDataArrayKernels::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "InstructionSet: " << GetInstructionSetAsString(GetInstructionSet()) << "\n";
+  os << indent << "BestInstructionSet: " << GetInstructionSetAsString(GetBestInstructionSet())
+     << "\n";
+}
+
+//------------------------------------------------------------------------------
+void vtkDataArrayKernels::SetInstructionSet(int instructionSet)
+{
+  SelectedInstructionSet.store(IsInstructionSetSupported(instructionSet) ? instructionSet
+                                                                         : BestInstructionSet());
+}
+
+//------------------------------------------------------------------------------
+int vtkDataArrayKernels::GetInstructionSet()
+{
+  return ActiveInstructionSet();
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::IsInstructionSetSupported(int instructionSet)
+{
+  const int best = BestInstructionSet();
+  switch (instructionSet)
+  {
+    case GENERIC:
+      return true;
+    case SSE4_2:
+    case AVX2:
+    case AVX512:
+      return best != NEON && instructionSet <= best;
+    case NEON:
+      return best == NEON;
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkDataArrayKernels::GetBestInstructionSet()
+{
+  return BestInstructionSet();
+}
+
+//------------------------------------------------------------------------------
+const char* vtkDataArrayKernels::GetInstructionSetAsString(int instructionSet)
+{
+  switch (instructionSet)
+  {
+    case GENERIC:
+      return "Generic";
+    case SSE4_2:
+      return "SSE4.2";
+    case AVX2:
+      return "AVX2";
+    case AVX512:
+      return "AVX-512";
+    case NEON:
+      return "NEON";
+    default:
+      return "Unknown";
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::ComputeRange(const float* values, vtkIdType numberOfTuples,
+  int numberOfComponents, float* ranges, bool finiteOnly)
+{
+  return DispatchComputeRange(values, numberOfTuples, numberOfComponents, ranges, finiteOnly);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::ComputeRange(const double* values, vtkIdType numberOfTuples,
+  int numberOfComponents, double* ranges, bool finiteOnly)
+{
+  return DispatchComputeRange(values, numberOfTuples, numberOfComponents, ranges, finiteOnly);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::ComputeRange(const vtkTypeInt32* values, vtkIdType numberOfTuples,
+  int numberOfComponents, vtkTypeInt32* ranges, bool finiteOnly)
+{
+  return DispatchComputeRange(values, numberOfTuples, numberOfComponents, ranges, finiteOnly);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::ComputeRange(const vtkTypeInt64* values, vtkIdType numberOfTuples,
+  int numberOfComponents, vtkTypeInt64* ranges, bool finiteOnly)
+{
+  return DispatchComputeRange(values, numberOfTuples, numberOfComponents, ranges, finiteOnly);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::ComputeRange(const vtkTypeUInt8* values, vtkIdType numberOfTuples,
+  int numberOfComponents, vtkTypeUInt8* ranges, bool finiteOnly)
+{
+  return DispatchComputeRange(values, numberOfTuples, numberOfComponents, ranges, finiteOnly);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::IsConversionSupported(int dataType)
+{
+  return GetKernelType(dataType) >= 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::ConvertValues(const void* source, int sourceType, void* destination,
+  int destinationType, vtkIdType numberOfValues)
+{
+  const int destType = GetKernelType(destinationType);
+  if (destType < 0)
+  {
+    return false;
+  }
+  switch (GetKernelType(sourceType))
+  {
+    case VTK_FLOAT:
+      return DispatchConvertValues(
+        static_cast<const float*>(source), destType, destination, numberOfValues);
+    case VTK_DOUBLE:
+      return DispatchConvertValues(
+        static_cast<const double*>(source), destType, destination, numberOfValues);
+    case VTK_UNSIGNED_CHAR:
+      return DispatchConvertValues(
+        static_cast<const vtkTypeUInt8*>(source), destType, destination, numberOfValues);
+    case VTK_TYPE_INT32:
+      return DispatchConvertValues(
+        static_cast<const vtkTypeInt32*>(source), destType, destination, numberOfValues);
+    case VTK_TYPE_INT64:
+      return DispatchConvertValues(
+        static_cast<const vtkTypeInt64*>(source), destType, destination, numberOfValues);
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::GatherTuples(const void* source, const vtkIdType* ids,
+  vtkIdType numberOfIds, int valueSize, int numberOfComponents, void* destination)
+{
+  return DispatchCopyTuples(
+    source, ids, nullptr, numberOfIds, valueSize, numberOfComponents, destination);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::ScatterTuples(const void* source, const vtkIdType* ids,
+  vtkIdType numberOfIds, int valueSize, int numberOfComponents, void* destination)
+{
+  return DispatchCopyTuples(
+    source, nullptr, ids, numberOfIds, valueSize, numberOfComponents, destination);
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataArrayKernels::CopyTuples(const void* source, const vtkIdType* sourceIds,
+  const vtkIdType* destinationIds, vtkIdType numberOfIds, int valueSize, int numberOfComponents,
+  void* destination)
+{
+  if (!sourceIds || !destinationIds)
+  {
+    return false;
+  }
+  return DispatchCopyTuples(
+    source, sourceIds, destinationIds, numberOfIds, valueSize, numberOfComponents, destination);
+}
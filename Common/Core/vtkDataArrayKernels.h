@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataArrayKernels.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDataArrayKernels
+ * @brief   vectorized loops over contiguous array values
+ *
+ * vtkDataArrayKernels provides the bulk loops at the head of most pipelines,
+ * written on plain pointers so that they vectorize, and compiled for several
+ * instruction sets. The best instruction set supported by the processor is
+ * selected at runtime, so a binary built for a generic target still uses
+ * AVX2 or AVX-512 registers where they are available:
+ *
+ * - ComputeRange(): per component minimum and maximum of array-of-structs
+ *   values, optionally skipping non-finite values. NaN values are always
+ *   skipped. Used by vtkDataArray::GetRange() and
+ *   vtkGenericDataArray::GetValueRange() for vtkAOSDataArrayTemplate arrays.
+ * - ConvertValues(): copy with type conversion, used by
+ *   vtkDataArray::DeepCopy() between arrays of different value types.
+ * - GatherTuples(), ScatterTuples() and CopyTuples(): copy tuples selected by
+ *   id lists, used by vtkDataArray::GetTuples() and InsertTuples().
+ *
+ * The kernels support the float, double, 32 and 64 bits integer and unsigned
+ * char value types. ComputeRange() has a template overload and
+ * ConvertValues() a type check returning false for the other types, so that
+ * the caller can fall back to its generic loop. The tuple copies only depend
+ * on the size of the values and support every type.
+ *
+ * The instruction sets are selected with GCC and Clang on x86 processors.
+ * On ARM processors NEON is part of the baseline: the generic kernels use it.
+ * Other compilers use the generic kernels, vectorized for the baseline target.
+ *
+ * All methods are static and thread safe.
+ *
+ * @sa
+ * vtkDataArray vtkAOSDataArrayTemplate vtkArrayDispatch
+ */
+
+#ifndef vtkDataArrayKernels_h
+#define vtkDataArrayKernels_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class VTKCOMMONCORE_EXPORT vtkDataArrayKernels : public vtkObject
+{
+public:
+  static vtkDataArrayKernels* New();
+  vtkTypeMacro(vtkDataArrayKernels, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum InstructionSets
+  {
+    GENERIC = 0,
+    SSE4_2,
+    AVX2,
+    AVX512,
+    NEON
+  };
+
+  ///@{
+  /**
+   * Instruction set used by the kernels. It defaults to the best instruction
+   * set supported by the processor. SetInstructionSet() restricts the kernels
+   * to a lower instruction set, for instance to compare their results or
+   * performance; instruction sets that are not supported select the best
+   * supported one instead.
+   */
+  static void SetInstructionSet(int instructionSet);
+  static int GetInstructionSet();
+  ///@}
+
+  /**
+   * Return true if the kernels can use @a instructionSet on this processor.
+   */
+  static bool IsInstructionSetSupported(int instructionSet);
+
+  /**
+   * Return the best instruction set supported by this processor.
+   */
+  static int GetBestInstructionSet();
+
+  /**
+   * Return the name of @a instructionSet.
+   */
+  static const char* GetInstructionSetAsString(int instructionSet);
+
+  ///@{
+  /**
+   * Update @a ranges, holding the minimum and maximum of each of the
+   * @a numberOfComponents components, with @a numberOfTuples tuples of
+   * array-of-structs @a values. NaN values are ignored, and infinite values
+   * too if @a finiteOnly is true. Initialize ranges to (max, lowest) before
+   * the first call. Return false if the value type is not supported.
+   */
+#ifndef __VTK_WRAP__
+  static bool ComputeRange(const float* values, vtkIdType numberOfTuples, int numberOfComponents,
+    float* ranges, bool finiteOnly);
+  static bool ComputeRange(const double* values, vtkIdType numberOfTuples, int numberOfComponents,
+    double* ranges, bool finiteOnly);
+  static bool ComputeRange(const vtkTypeInt32* values, vtkIdType numberOfTuples,
+    int numberOfComponents, vtkTypeInt32* ranges, bool finiteOnly);
+  static bool ComputeRange(const vtkTypeInt64* values, vtkIdType numberOfTuples,
+    int numberOfComponents, vtkTypeInt64* ranges, bool finiteOnly);
+  static bool ComputeRange(const vtkTypeUInt8* values, vtkIdType numberOfTuples,
+    int numberOfComponents, vtkTypeUInt8* ranges, bool finiteOnly);
+  template <typename ValueType>
+  static bool ComputeRange(const ValueType*, vtkIdType, int, ValueType*, bool)
+  {
+    return false;
+  }
+#endif
+  ///@}
+
+  /**
+   * Return true if ConvertValues() supports the VTK data type @a dataType.
+   */
+  static bool IsConversionSupported(int dataType);
+
+  /**
+   * Convert @a numberOfValues values of VTK type @a sourceType to
+   * @a destinationType, as static_cast does. Return false if a type is not
+   * supported.
+   */
+  static bool ConvertValues(const void* source, int sourceType, void* destination,
+    int destinationType, vtkIdType numberOfValues);
+
+  ///@{
+  /**
+   * Copy tuples of @a numberOfComponents values of @a valueSize bytes:
+   * - GatherTuples() copies the tuples @a ids of @a source to the first
+   *   @a numberOfIds tuples of @a destination,
+   * - ScatterTuples() copies the first @a numberOfIds tuples of @a source to
+   *   the tuples @a ids of @a destination,
+   * - CopyTuples() copies the tuples @a sourceIds of @a source to the tuples
+   *   @a destinationIds of @a destination.
+   * Return false if @a valueSize is not 1, 2, 4 or 8.
+   */
+  static bool GatherTuples(const void* source, const vtkIdType* ids, vtkIdType numberOfIds,
+    int valueSize, int numberOfComponents, void* destination);
+  static bool ScatterTuples(const void* source, const vtkIdType* ids, vtkIdType numberOfIds,
+    int valueSize, int numberOfComponents, void* destination);
+  static bool CopyTuples(const void* source, const vtkIdType* sourceIds,
+    const vtkIdType* destinationIds, vtkIdType numberOfIds, int valueSize,
+    int numberOfComponents, void* destination);
+  ///@}
+
+protected:
+  vtkDataArrayKernels() = default;
+  ~vtkDataArrayKernels() override = default;
+
+private:
+  vtkDataArrayKernels(const vtkDataArrayKernels&) = delete;
+  void operator=(const vtkDataArrayKernels&) = delete;
+};
+
+#endif
@@ -19,6 +19,7 @@
 
 #include "vtkAssume.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayKernels.h"
 #include "vtkDataArrayRange.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
@@ -29,6 +30,9 @@
 #include <limits>
 #include <vector>
 
+template <typename ValueType>
+class vtkAOSDataArrayTemplate;
+
 namespace vtkDataArrayPrivate
 {
 #if (defined(_MSC_VER) && (_MSC_VER < 2000)) ||                                                    \
@@ -464,6 +468,97 @@ bool GenericComputeScalarRange(ArrayT* array, RangeValueType* ranges, FiniteValu
   return true;
 }
 
+//----------------------------------------------------------------------------
+// Array-of-structs values are processed in chunks by the vectorized kernels of
+// vtkDataArrayKernels.
+template <typename APIType>
+class KernelMinAndMax
+{
+private:
+  const APIType* Values;
+  int NumComps;
+  bool FiniteOnly;
+  vtkSMPThreadLocal<std::vector<APIType>> TLRange;
+  std::vector<APIType> ReducedRange;
+
+public:
+  KernelMinAndMax(const APIType* values, int numComps, bool finiteOnly)
+    : Values(values)
+    , NumComps(numComps)
+    , FiniteOnly(finiteOnly)
+    , ReducedRange(2 * numComps)
+  {
+    for (int i = 0, j = 0; i < this->NumComps; ++i, j += 2)
+    {
+      this->ReducedRange[j] = vtkTypeTraits<APIType>::Max();
+      this->ReducedRange[j + 1] = vtkTypeTraits<APIType>::Min();
+    }
+  }
+  void Initialize() { this->TLRange.Local() = this->ReducedRange; }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkDataArrayKernels::ComputeRange(this->Values + begin * this->NumComps, end - begin,
+      this->NumComps, this->TLRange.Local().data(), this->FiniteOnly);
+  }
+  void Reduce()
+  {
+    for (auto itr = this->TLRange.begin(); itr != this->TLRange.end(); ++itr)
+    {
+      auto& range = *itr;
+      for (int i = 0, j = 0; i < this->NumComps; ++i, j += 2)
+      {
+        this->ReducedRange[j] = detail::min(this->ReducedRange[j], range[j]);
+        this->ReducedRange[j + 1] = detail::max(this->ReducedRange[j + 1], range[j + 1]);
+      }
+    }
+  }
+  template <typename T>
+  void CopyRanges(T* ranges)
+  {
+    for (int i = 0, j = 0; i < this->NumComps; ++i, j += 2)
+    {
+      ranges[j] = static_cast<T>(this->ReducedRange[j]);
+      ranges[j + 1] = static_cast<T>(this->ReducedRange[j + 1]);
+    }
+  }
+};
+
+inline bool IsFiniteOnly(AllValues)
+{
+  return false;
+}
+
+inline bool IsFiniteOnly(FiniteValues)
+{
+  return true;
+}
+
+template <typename ArrayT, typename RangeValueType, typename ValueType>
+bool KernelComputeScalarRange(ArrayT*, RangeValueType*, ValueType)
+{
+  return false;
+}
+
+template <typename APIType, typename RangeValueType, typename ValueType>
+bool KernelComputeScalarRange(
+  vtkAOSDataArrayTemplate<APIType>* array, RangeValueType* ranges, ValueType tag)
+{
+  // The template overload of ComputeRange returns false for the value types
+  // without kernels.
+  APIType probe[2];
+  if (!vtkDataArrayKernels::ComputeRange(
+        static_cast<const APIType*>(nullptr), 0, 1, probe, IsFiniteOnly(tag)))
+  {
+    return false;
+  }
+
+  KernelMinAndMax<APIType> minmax(
+    array->GetPointer(0), array->GetNumberOfComponents(), IsFiniteOnly(tag));
+  vtkSMPTools::For(0, array->GetNumberOfTuples(), minmax);
+  minmax.CopyRanges(ranges);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 template <typename ArrayT, typename RangeValueType, typename ValueType>
 bool DoComputeScalarRange(ArrayT* array, RangeValueType* ranges, ValueType tag)
@@ -483,6 +578,11 @@ bool DoComputeScalarRange(ArrayT* array, RangeValueType* ranges, ValueType tag)
     return false;
   }
 
+  if (KernelComputeScalarRange(array, ranges, tag))
+  {
+    return true;
+  }
+
   // Special case for single value scalar range. This is done to help the
   // compiler detect it can perform loop optimizations.
   if (numComp == 1)
@@ -17,10 +17,54 @@
 
 #include "vtkGenericDataArray.h"
 
+#include "vtkDataArrayKernels.h"
 #include "vtkIdList.h"
 #include "vtkMath.h"
 #include "vtkVariantCast.h"
 
+template <typename ValueType>
+class vtkAOSDataArrayTemplate;
+
+namespace vtk_GDA_detail
+{
+// Tuple copies by id lists use the vectorized kernels of vtkDataArrayKernels
+// for array-of-structs arrays. They return false if the copy is not done.
+template <typename ArrayT>
+bool KernelCopyTuples(ArrayT*, const vtkIdType*, ArrayT*, const vtkIdType*, vtkIdType)
+{
+  return false;
+}
+
+template <typename ValueType>
+bool KernelCopyTuples(vtkAOSDataArrayTemplate<ValueType>* source, const vtkIdType* sourceIds,
+  vtkAOSDataArrayTemplate<ValueType>* destination, const vtkIdType* destinationIds,
+  vtkIdType numberOfIds)
+{
+  return vtkDataArrayKernels::CopyTuples(source->GetPointer(0), sourceIds, destinationIds,
+    numberOfIds, static_cast<int>(sizeof(ValueType)), source->GetNumberOfComponents(),
+    destination->GetPointer(0));
+}
+
+// Copy the tuples sourceIds of source to destination, starting at tuple
+// destinationStart.
+template <typename ArrayT>
+bool KernelGatherTuplesAt(ArrayT*, const vtkIdType*, vtkIdType, ArrayT*, vtkIdType)
+{
+  return false;
+}
+
+template <typename ValueType>
+bool KernelGatherTuplesAt(vtkAOSDataArrayTemplate<ValueType>* source, const vtkIdType* sourceIds,
+  vtkIdType numberOfIds, vtkAOSDataArrayTemplate<ValueType>* destination,
+  vtkIdType destinationStart)
+{
+  const int numComps = source->GetNumberOfComponents();
+  return vtkDataArrayKernels::GatherTuples(source->GetPointer(0), sourceIds, numberOfIds,
+    static_cast<int>(sizeof(ValueType)), numComps,
+    destination->GetPointer(destinationStart * numComps));
+}
+} // namespace vtk_GDA_detail
+
 //-----------------------------------------------------------------------------
 template <class DerivedT, class ValueTypeT>
 double* vtkGenericDataArray<DerivedT, ValueTypeT>::GetTuple(vtkIdType tupleIdx)
@@ -591,6 +635,11 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::InsertTuples(
   this->MaxId = (std::max)(this->MaxId, newSize - 1);
 
   vtkIdType numTuples = srcIds->GetNumberOfIds();
+  if (vtk_GDA_detail::KernelCopyTuples(other, srcIds->GetPointer(0), static_cast<DerivedT*>(this),
+        dstIds->GetPointer(0), numTuples))
+  {
+    return;
+  }
   for (vtkIdType t = 0; t < numTuples; ++t)
   {
     vtkIdType srcT = srcIds->GetId(t);
@@ -627,7 +676,7 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::InsertTuplesStartingAt(
   }
 
   vtkIdType maxSrcTupleId = srcIds->GetId(0);
-  vtkIdType maxDstTupleId = dstStart + srcIds->GetNumberOfIds();
+  vtkIdType maxDstTupleId = dstStart + srcIds->GetNumberOfIds() - 1;
   for (int i = 0; i < srcIds->GetNumberOfIds(); ++i)
   {
     // parenthesis around std::max prevent MSVC macro replacement when
@@ -658,6 +707,11 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::InsertTuplesStartingAt(
   this->MaxId = (std::max)(this->MaxId, newSize - 1);
 
   vtkIdType numTuples = srcIds->GetNumberOfIds();
+  if (vtk_GDA_detail::KernelGatherTuplesAt(
+        other, srcIds->GetPointer(0), numTuples, static_cast<DerivedT*>(this), dstStart))
+  {
+    return;
+  }
   for (vtkIdType t = 0; t < numTuples; ++t)
   {
     vtkIdType srcT = srcIds->GetId(t);
@@ -768,6 +822,12 @@ void vtkGenericDataArray<DerivedT, ValueTypeT>::GetTuples(
     return;
   }
 
+  if (vtk_GDA_detail::KernelGatherTuplesAt(static_cast<DerivedT*>(this), tupleIds->GetPointer(0),
+        tupleIds->GetNumberOfIds(), other, 0))
+  {
+    return;
+  }
+
   vtkIdType* srcTuple = tupleIds->GetPointer(0);
   vtkIdType* srcTupleEnd = tupleIds->GetPointer(tupleIds->GetNumberOfIds());
   vtkIdType dstTuple = 0;
@@ -0,0 +1,277 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImplicitArray
+ * @brief   A read-only array computing its values on demand
+ *
+ * vtkImplicitArray is a vtkGenericDataArray whose values are not stored but
+ * computed by a backend when they are read. A constant array, a ramp or the
+ * concatenation of existing arrays can then be used as any other array for
+ * the memory cost of a few values.
+ *
+ * The backend is any type providing a const call operator from the value
+ * index (tuple index * number of components + component index) to the value:
+ *
+ * @code
+ * struct Backend
+ * {
+ *   ValueType operator()(vtkIdType valueIdx) const;
+ * };
+ * @endcode
+ *
+ * The value type of the array is the return type of this operator. The
+ * backend is held through a std::shared_ptr, so copies of an implicit array
+ * share their backend. Set it with SetBackend() or ConstructBackend(), then
+ * set the number of components and tuples of the array as usual:
+ *
+ * @code
+ * vtkNew<vtkConstantArray<double>> array;
+ * array->ConstructBackend(1.0);
+ * array->SetNumberOfComponents(3);
+ * array->SetNumberOfTuples(numberOfPoints);
+ * @endcode
+ *
+ * The array works with vtkArrayDispatch (see VTK_DISPATCH_CONSTANT_ARRAYS and
+ * VTK_DISPATCH_AFFINE_ARRAYS, or dispatch on an explicit array list) and
+ * with vtk::DataArrayValueRange and vtk::DataArrayTupleRange.
+ *
+ * The array is read-only: SetValue() and the other methods writing values do
+ * nothing. NewInstance() returns a vtkAOSDataArrayTemplate of the same value
+ * type, so that filters copying attributes to a new array of the same type
+ * get a writable array. GetVoidPointer() is supported for legacy code but
+ * materializes every value in an internal buffer at each call.
+ *
+ * Available backends: vtkConstantArray, vtkAffineArray, vtkIndexedArray,
+ * vtkCompositeArray and vtkStdFunctionArray.
+ *
+ * @sa
+ * vtkGenericDataArray vtkConstantArray vtkAffineArray vtkIndexedArray
+ * vtkCompositeArray vtkStdFunctionArray
+ */
+
+#ifndef vtkImplicitArray_h
+#define vtkImplicitArray_h
+
+#include "vtkAOSDataArrayTemplate.h" // For NewInstance
+#include "vtkBuffer.h"               // For the GetVoidPointer buffer
+#include "vtkGenericDataArray.h"
+#include "vtkSmartPointer.h" // For ImplicitArrayValueReader
+#include "vtkTypeTraits.h" // For FastDownCast
+
+#include <memory>      // For std::shared_ptr
+#include <type_traits> // For std::decay
+#include <typeinfo>    // For typeid
+#include <utility>     // For std::declval
+
+namespace vtk
+{
+namespace detail
+{
+/**
+ * Value type of the arrays using BackendT: the return type of its call
+ * operator.
+ */
+template <typename BackendT>
+struct ImplicitArrayTraits
+{
+  using ValueType =
+    typename std::decay<decltype(std::declval<const BackendT&>()(vtkIdType(0)))>::type;
+};
+
+/**
+ * Read the values of an array wrapped by a backend as ValueType. Arrays of
+ * ValueType stored as array-of-structs are read directly, others through the
+ * vtkDataArray API.
+ */
+template <typename ValueType>
+class ImplicitArrayValueReader
+{
+public:
+  ImplicitArrayValueReader() = default;
+  explicit ImplicitArrayValueReader(vtkDataArray* array)
+    : Array(array)
+    , TypedArray(vtkAOSDataArrayTemplate<ValueType>::FastDownCast(array))
+  {
+  }
+
+  inline ValueType operator()(vtkIdType valueIdx) const
+  {
+    if (this->TypedArray)
+    {
+      return this->TypedArray->GetValue(valueIdx);
+    }
+    const int numComps = this->Array->GetNumberOfComponents();
+    return static_cast<ValueType>(
+      this->Array->GetComponent(valueIdx / numComps, static_cast<int>(valueIdx % numComps)));
+  }
+
+  vtkDataArray* GetArray() const { return this->Array; }
+
+private:
+  vtkSmartPointer<vtkDataArray> Array;
+  vtkAOSDataArrayTemplate<ValueType>* TypedArray = nullptr;
+};
+} // namespace detail
+} // namespace vtk
+
+template <class BackendT>
+class vtkImplicitArray
+  : public vtkGenericDataArray<vtkImplicitArray<BackendT>,
+      typename vtk::detail::ImplicitArrayTraits<BackendT>::ValueType>
+{
+  using GenericDataArrayType = vtkGenericDataArray<vtkImplicitArray<BackendT>,
+    typename vtk::detail::ImplicitArrayTraits<BackendT>::ValueType>;
+
+public:
+  using SelfType = vtkImplicitArray<BackendT>;
+  vtkAbstractTypeMacroWithNewInstanceType(
+    SelfType, GenericDataArrayType, vtkDataArray, typeid(SelfType).name());
+  using ValueType = typename GenericDataArrayType::ValueType;
+  using BackendType = BackendT;
+
+  static vtkImplicitArray* New();
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  inline ValueType GetValue(vtkIdType valueIdx) const { return (*this->Backend)(valueIdx); }
+
+  /**
+   * The array is read-only: does nothing.
+   */
+  void SetValue(vtkIdType, ValueType) {}
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   */
+  inline void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    for (int comp = 0; comp < this->NumberOfComponents; ++comp)
+    {
+      tuple[comp] = this->GetValue(valueIdx + comp);
+    }
+  }
+
+  /**
+   * The array is read-only: does nothing.
+   */
+  void SetTypedTuple(vtkIdType, const ValueType*) {}
+
+  /**
+   * Get component @a comp of the tuple at @a tupleIdx.
+   */
+  inline ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const
+  {
+    return this->GetValue(tupleIdx * this->NumberOfComponents + comp);
+  }
+
+  /**
+   * The array is read-only: does nothing.
+   */
+  void SetTypedComponent(vtkIdType, int, ValueType) {}
+
+  ///@{
+  /**
+   * Set/Get the backend computing the values. SetBackend() does not change
+   * the number of tuples of the array.
+   */
+  void SetBackend(std::shared_ptr<BackendT> backend);
+  std::shared_ptr<BackendT> GetBackend() const { return this->Backend; }
+  ///@}
+
+  /**
+   * Construct a new backend from the given parameters and use it.
+   */
+  template <typename... Params>
+  void ConstructBackend(Params&&... params)
+  {
+    this->SetBackend(std::make_shared<BackendT>(std::forward<Params>(params)...));
+  }
+
+  /**
+   * Copy the number of components, the number of tuples and share the backend
+   * of @a other if it is an implicit array of the same type. Other arrays
+   * cannot be copied into an implicit array.
+   */
+  void DeepCopy(vtkDataArray* other) override;
+  void DeepCopy(vtkAbstractArray* other) override { this->Superclass::DeepCopy(other); }
+  void ShallowCopy(vtkDataArray* other) override { this->DeepCopy(other); }
+
+  /**
+   * Write every value in an internal buffer and return a pointer to the
+   * value @a valueIdx in it. This is expensive and the buffer is rewritten at
+   * each call: use vtkArrayDispatch or the array ranges instead.
+   */
+  void* GetVoidPointer(vtkIdType valueIdx) override;
+
+  /**
+   * Return the memory used by the materialized values, if any, with a minimum
+   * of 1 KiB for the array itself.
+   */
+  unsigned long GetActualMemorySize() const override;
+
+  int GetArrayType() const override { return vtkAbstractArray::ImplicitArray; }
+
+  /**
+   * Perform a fast, safe cast from a vtkAbstractArray to a vtkImplicitArray
+   * with the same backend type.
+   */
+  static vtkImplicitArray<BackendT>* FastDownCast(vtkAbstractArray* source);
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray() override;
+
+  vtkObjectBase* NewInstanceInternal() const override
+  {
+    return vtkAOSDataArrayTemplate<ValueType>::New();
+  }
+
+  ///@{
+  /**
+   * Nothing is stored: only release the materialized values.
+   */
+  bool AllocateTuples(vtkIdType numTuples);
+  bool ReallocateTuples(vtkIdType numTuples);
+  ///@}
+
+  std::shared_ptr<BackendT> Backend;
+
+  // Values written by GetVoidPointer().
+  vtkBuffer<ValueType>* MaterializedValues;
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&) = delete;
+  void operator=(const vtkImplicitArray&) = delete;
+
+  friend class vtkGenericDataArray<vtkImplicitArray<BackendT>, ValueType>;
+};
+
+// vtkArrayDownCast uses FastDownCast for every backend.
+template <class BackendT>
+struct vtkArrayDownCast_impl<vtkImplicitArray<BackendT>>
+{
+  inline vtkImplicitArray<BackendT>* operator()(vtkAbstractArray* array)
+  {
+    return vtkImplicitArray<BackendT>::FastDownCast(array);
+  }
+};
+
+#include "vtkImplicitArray.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkImplicitArray_txx
+#define vtkImplicitArray_txx
+
+#include "vtkImplicitArray.h"
+
+#include "vtkObjectFactory.h"
+
+#include <cstdlib> // For getenv
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>* vtkImplicitArray<BackendT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkImplicitArray<BackendT>);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::vtkImplicitArray()
+  : MaterializedValues(nullptr)
+{
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::~vtkImplicitArray()
+{
+  if (this->MaterializedValues)
+  {
+    this->MaterializedValues->Delete();
+    this->MaterializedValues = nullptr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Backend: " << this->Backend.get() << "\n";
+  os << indent << "MaterializedValues: " << (this->MaterializedValues ? "yes" : "no") << "\n";
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetBackend(std::shared_ptr<BackendT> backend)
+{
+  if (this->Backend != backend)
+  {
+    this->Backend = backend;
+    this->DataChanged();
+    this->Modified();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::DeepCopy(vtkDataArray* other)
+{
+  if (other == this)
+  {
+    return;
+  }
+
+  SelfType* o = SelfType::FastDownCast(other);
+  if (!o)
+  {
+    vtkErrorMacro(<< "Cannot copy a " << (other ? other->GetClassName() : "null array")
+                  << " into a read-only implicit array.");
+    return;
+  }
+
+  this->SetNumberOfComponents(o->GetNumberOfComponents());
+  this->CopyComponentNames(o);
+  this->SetNumberOfTuples(o->GetNumberOfTuples());
+  this->SetBackend(o->Backend);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void* vtkImplicitArray<BackendT>::GetVoidPointer(vtkIdType valueIdx)
+{
+  // Allow warnings to be silenced:
+  const char* silence = getenv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS");
+  if (!silence)
+  {
+    vtkWarningMacro(<< "GetVoidPointer called. This is very expensive for "
+                       "implicit arrays, as every value must be computed for "
+                       "each call. Using the vtkGenericDataArray API with "
+                       "vtkArrayDispatch is preferred. Define the environment "
+                       "variable VTK_SILENCE_GET_VOID_POINTER_WARNINGS to "
+                       "silence this warning.");
+  }
+
+  const vtkIdType numValues = this->GetNumberOfValues();
+  if (!this->MaterializedValues)
+  {
+    this->MaterializedValues = vtkBuffer<ValueType>::New();
+  }
+
+  if (!this->MaterializedValues->Allocate(numValues))
+  {
+    vtkErrorMacro(<< "Error allocating a buffer of " << numValues << " '"
+                  << this->GetDataTypeAsString() << "' elements.");
+    return nullptr;
+  }
+
+  ValueType* buffer = this->MaterializedValues->GetBuffer();
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    buffer[i] = this->GetValue(i);
+  }
+
+  return static_cast<void*>(buffer + valueIdx);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+unsigned long vtkImplicitArray<BackendT>::GetActualMemorySize() const
+{
+  vtkIdType size = 1024;
+  if (this->MaterializedValues)
+  {
+    size += this->MaterializedValues->GetSize() * static_cast<vtkIdType>(sizeof(ValueType));
+  }
+  return static_cast<unsigned long>(size / 1024);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>* vtkImplicitArray<BackendT>::FastDownCast(vtkAbstractArray* source)
+{
+  if (source && source->GetArrayType() == vtkAbstractArray::ImplicitArray &&
+    vtkDataTypesCompare(source->GetDataType(), vtkTypeTraits<ValueType>::VTK_TYPE_ID))
+  {
+    // Several backends may share the value type: check the backend too.
+    return dynamic_cast<vtkImplicitArray<BackendT>*>(source);
+  }
+  return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+bool vtkImplicitArray<BackendT>::AllocateTuples(vtkIdType)
+{
+  if (this->MaterializedValues)
+  {
+    this->MaterializedValues->Delete();
+    this->MaterializedValues = nullptr;
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+bool vtkImplicitArray<BackendT>::ReallocateTuples(vtkIdType numTuples)
+{
+  return this->AllocateTuples(numTuples);
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIndexedArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkIndexedArray
+ * @brief   An implicit array of the tuples of another array at given indices
+ *
+ * vtkIndexedArray<T> is a vtkImplicitArray whose tuple i is the tuple
+ * indexes[i] of a base array. It represents a subset or a permutation of an
+ * array without copying it, for instance the attributes of the extracted
+ * points of a dataset:
+ *
+ * @code
+ * vtkNew<vtkIndexedArray<double>> subset;
+ * subset->ConstructBackend(pointIds, baseArray);
+ * subset->SetNumberOfComponents(baseArray->GetNumberOfComponents());
+ * subset->SetNumberOfTuples(pointIds->GetNumberOfIds());
+ * @endcode
+ *
+ * The backend keeps references to the index list and to the base array,
+ * which must not be modified while the implicit array is used.
+ *
+ * @sa
+ * vtkImplicitArray vtkCompositeArray
+ */
+
+#ifndef vtkIndexedArray_h
+#define vtkIndexedArray_h
+
+#include "vtkIdList.h"
+#include "vtkImplicitArray.h"
+#include "vtkSmartPointer.h"
+
+/**
+ * Backend of vtkIndexedArray.
+ */
+template <typename ValueType>
+struct vtkIndexedImplicitBackend
+{
+  vtkIndexedImplicitBackend(vtkIdList* indexes, vtkDataArray* array)
+    : Indexes(indexes)
+    , Reader(array)
+    , NumberOfComponents(array->GetNumberOfComponents())
+  {
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    const vtkIdType tupleIdx = valueIdx / this->NumberOfComponents;
+    const vtkIdType comp = valueIdx % this->NumberOfComponents;
+    return this->Reader(this->Indexes->GetId(tupleIdx) * this->NumberOfComponents + comp);
+  }
+
+  vtkSmartPointer<vtkIdList> Indexes;
+  vtk::detail::ImplicitArrayValueReader<ValueType> Reader;
+  const int NumberOfComponents;
+};
+
+template <typename T>
+using vtkIndexedArray = vtkImplicitArray<vtkIndexedImplicitBackend<T>>;
+
+#endif
+// VTK-HeaderTest-Exclude: vtkIndexedArray.h
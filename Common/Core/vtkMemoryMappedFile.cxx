@@ -0,0 +1,264 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMemoryMappedFile.h"
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h"
+
+#include <map>    // For std::map
+#include <mutex>  // For std::mutex
+#include <string> // For std::string
+
+#if defined(_WIN32)
+#include "vtkWindows.h"
+#include <vtksys/Encoding.hxx>
+#define VTK_MEMORY_MAPPING_WIN32
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VTK_MEMORY_MAPPING_POSIX
+#endif
+
+vtkStandardNewMacro(vtkMemoryMappedFile);
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A mapped view of a file. The data pointer handed to the array may be after
+// the start of the view, which must be aligned on the allocation granularity.
+struct Mapping
+{
+  void* Base;
+  size_t Length;
+};
+
+//------------------------------------------------------------------------------
+// Mappings by data pointer. The state is never destroyed: arrays may be
+// released by static objects after the end of main().
+struct MappingRegistry
+{
+  std::mutex Mutex;
+  std::map<const void*, Mapping> Mappings;
+};
+
+MappingRegistry& GetRegistry()
+{
+  static MappingRegistry* registry = new MappingRegistry;
+  return *registry;
+}
+
+//------------------------------------------------------------------------------
+void Unmap(const Mapping& mapping)
+{
+#if defined(VTK_MEMORY_MAPPING_WIN32)
+  UnmapViewOfFile(mapping.Base);
+#elif defined(VTK_MEMORY_MAPPING_POSIX)
+  munmap(mapping.Base, mapping.Length);
+#else
+  (void)mapping;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Free function of the mapped arrays.
+void UnmapArrayMemory(void* ptr)
+{
+  MappingRegistry& registry = GetRegistry();
+  Mapping mapping;
+  {
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    auto it = registry.Mappings.find(ptr);
+    if (it == registry.Mappings.end())
+    {
+      return;
+    }
+    mapping = it->second;
+    registry.Mappings.erase(it);
+  }
+  Unmap(mapping);
+}
+
+//------------------------------------------------------------------------------
+// Map size bytes of fileName at offset. Return the address of the first byte,
+// or nullptr on failure.
+void* MapRegion(const char* fileName, vtkTypeUInt64 offset, vtkTypeUInt64 size, int mode,
+  Mapping& mapping, std::string& error)
+{
+#if defined(VTK_MEMORY_MAPPING_WIN32)
+  const std::wstring wideName = vtksys::Encoding::ToWindowsExtendedPath(fileName);
+  HANDLE file = CreateFileW(wideName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    error = "cannot open the file";
+    return nullptr;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+    static_cast<vtkTypeUInt64>(fileSize.QuadPart) < offset + size)
+  {
+    CloseHandle(file);
+    error = "the file is too small";
+    return nullptr;
+  }
+  HANDLE fileMapping = CreateFileMappingW(file, nullptr,
+    mode == vtkMemoryMappedFile::COPY_ON_WRITE ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!fileMapping)
+  {
+    error = "cannot create the file mapping";
+    return nullptr;
+  }
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const vtkTypeUInt64 alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+  mapping.Length = static_cast<size_t>(size + (offset - alignedOffset));
+  // The view keeps a reference to the file mapping.
+  mapping.Base = MapViewOfFile(fileMapping,
+    mode == vtkMemoryMappedFile::COPY_ON_WRITE ? FILE_MAP_COPY : FILE_MAP_READ,
+    static_cast<DWORD>(alignedOffset >> 32), static_cast<DWORD>(alignedOffset & 0xffffffff),
+    mapping.Length);
+  CloseHandle(fileMapping);
+  if (!mapping.Base)
+  {
+    error = "cannot map a view of the file";
+    return nullptr;
+  }
+  return static_cast<char*>(mapping.Base) + (offset - alignedOffset);
+#elif defined(VTK_MEMORY_MAPPING_POSIX)
+  const int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    error = "cannot open the file";
+    return nullptr;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || static_cast<vtkTypeUInt64>(fileStat.st_size) < offset + size)
+  {
+    close(fd);
+    error = "the file is too small";
+    return nullptr;
+  }
+  const vtkTypeUInt64 pageSize = static_cast<vtkTypeUInt64>(sysconf(_SC_PAGESIZE));
+  const vtkTypeUInt64 alignedOffset = offset - offset % pageSize;
+  mapping.Length = static_cast<size_t>(size + (offset - alignedOffset));
+  const int protection =
+    mode == vtkMemoryMappedFile::COPY_ON_WRITE ? PROT_READ | PROT_WRITE : PROT_READ;
+  const int flags = mode == vtkMemoryMappedFile::COPY_ON_WRITE ? MAP_PRIVATE : MAP_SHARED;
+  mapping.Base =
+    mmap(nullptr, mapping.Length, protection, flags, fd, static_cast<off_t>(alignedOffset));
+  // The mapping keeps a reference to the file.
+  close(fd);
+  if (mapping.Base == MAP_FAILED)
+  {
+    error = "mmap failed";
+    return nullptr;
+  }
+  return static_cast<char*>(mapping.Base) + (offset - alignedOffset);
+#else
+  (void)fileName;
+  (void)offset;
+  (void)size;
+  (void)mode;
+  (void)mapping;
+  error = "memory mapping is not supported on this platform";
+  return nullptr;
+#endif
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryMappedFile::IsSupported()
+{
+#if defined(VTK_MEMORY_MAPPING_WIN32) || defined(VTK_MEMORY_MAPPING_POSIX)
+  return true;
+#else
+  return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkMemoryMappedFile::MapArray(const char* fileName, vtkTypeUInt64 offset,
+  int dataType, int numberOfComponents, vtkIdType numberOfTuples, int mode)
+{
+  if (!fileName || numberOfComponents < 1 || numberOfTuples < 0)
+  {
+    vtkGenericWarningMacro("Invalid parameters for mapping an array.");
+    return nullptr;
+  }
+
+  vtkDataArray* array = vtkDataArray::CreateDataArray(dataType);
+  if (!array || array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate)
+  {
+    vtkGenericWarningMacro("Cannot map arrays of type " << dataType << ".");
+    if (array)
+    {
+      array->Delete();
+    }
+    return nullptr;
+  }
+  array->SetNumberOfComponents(numberOfComponents);
+
+  const vtkIdType numberOfValues = numberOfTuples * numberOfComponents;
+  if (numberOfValues == 0)
+  {
+    return array;
+  }
+
+  const vtkTypeUInt64 size =
+    static_cast<vtkTypeUInt64>(numberOfValues) * array->GetDataTypeSize();
+  Mapping mapping;
+  std::string error;
+  void* data = MapRegion(fileName, offset, size, mode, mapping, error);
+  if (!data)
+  {
+    vtkGenericWarningMacro("Cannot map " << size << " bytes of " << fileName << " at offset "
+                                         << offset << ": " << error);
+    array->Delete();
+    return nullptr;
+  }
+
+  {
+    MappingRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    registry.Mappings[data] = mapping;
+  }
+  array->SetVoidArray(data, numberOfValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(UnmapArrayMemory);
+  return array;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMemoryMappedFile::IsMapped(vtkDataArray* array)
+{
+  if (!array || array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate ||
+    array->GetNumberOfValues() == 0)
+  {
+    return false;
+  }
+  // Non-AOS arrays were rejected above, so this does not copy.
+  const void* data = array->GetVoidPointer(0);
+  MappingRegistry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  return registry.Mappings.find(data) != registry.Mappings.end();
+}
+
+//------------------------------------------------------------------------------
+void vtkMemoryMappedFile::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Supported: " << vtkMemoryMappedFile::IsSupported() << "\n";
+}
@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkMemoryMappedFile.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkMemoryMappedFile
+ * @brief   create data arrays mapping a region of a file
+ *
+ * vtkMemoryMappedFile creates data arrays whose memory is a region of a file
+ * mapped in the address space of the process. No data is read when the array
+ * is created: the pages of the file are loaded by the operating system when
+ * they are first accessed, and may be evicted again under memory pressure.
+ * Readers use it to hand out arrays of raw binary files without copying them,
+ * so that a large time series is paged in lazily instead of being loaded
+ * before the first filter runs.
+ *
+ * The region must hold the values in the native byte order, as an
+ * array-of-structs. The returned arrays are regular vtkAOSDataArrayTemplate
+ * instances, so they take the fast paths of vtkArrayDispatch. The mapping is
+ * released with the array, or when the array is resized, in which case the
+ * values are first copied to regular memory.
+ *
+ * Two modes are available:
+ * - READ_ONLY: the pages are shared with the file cache and cannot be
+ *   written; writing to the array crashes the program.
+ * - COPY_ON_WRITE: writing to a page gives the process a private copy of it;
+ *   the file is never modified. This is the safe choice for arrays handed to
+ *   a pipeline.
+ *
+ * Memory mapping is supported on POSIX systems and Windows. On other systems,
+ * or when the file cannot be mapped, MapArray() returns nullptr and the caller
+ * should read the file instead.
+ *
+ * @sa
+ * vtkAOSDataArrayTemplate vtkImageReader2 vtkHDFReader
+ */
+
+#ifndef vtkMemoryMappedFile_h
+#define vtkMemoryMappedFile_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataArray;
+
+class VTKCOMMONCORE_EXPORT vtkMemoryMappedFile : public vtkObject
+{
+public:
+  static vtkMemoryMappedFile* New();
+  vtkTypeMacro(vtkMemoryMappedFile, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum MappingModes
+  {
+    READ_ONLY = 0,
+    COPY_ON_WRITE
+  };
+
+  /**
+   * Return true if memory mapping is supported on this platform.
+   */
+  static bool IsSupported();
+
+  /**
+   * Create an array of @a numberOfTuples tuples of @a numberOfComponents
+   * values of type @a dataType, mapping the bytes of @a fileName starting at
+   * @a offset. Return nullptr if the file cannot be mapped, for instance if it
+   * is too small. The caller owns the returned array.
+   */
+  VTK_NEWINSTANCE
+  static vtkDataArray* MapArray(const char* fileName, vtkTypeUInt64 offset, int dataType,
+    int numberOfComponents, vtkIdType numberOfTuples, int mode = COPY_ON_WRITE);
+
+  /**
+   * Return true if the memory of @a array is a file mapping created by
+   * MapArray().
+   */
+  static bool IsMapped(vtkDataArray* array);
+
+protected:
+  vtkMemoryMappedFile() = default;
+  ~vtkMemoryMappedFile() override = default;
+
+private:
+  vtkMemoryMappedFile(const vtkMemoryMappedFile&) = delete;
+  void operator=(const vtkMemoryMappedFile&) = delete;
+};
+
+#endif
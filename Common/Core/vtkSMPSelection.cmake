@@ -125,8 +125,10 @@ endif()
 
 set(vtk_smp_common_dir SMP/Common)
 list(APPEND vtk_smp_sources
+  "${vtk_smp_common_dir}/vtkSMPThreadAffinity.cxx"
   "${vtk_smp_common_dir}/vtkSMPToolsAPI.cxx")
 list(APPEND vtk_smp_nowrap_headers
+  "${vtk_smp_common_dir}/vtkSMPThreadAffinity.h"
   "${vtk_smp_common_dir}/vtkSMPThreadLocalAPI.h"
   "${vtk_smp_common_dir}/vtkSMPThreadLocalImplAbstract.h"
   "${vtk_smp_common_dir}/vtkSMPToolsAPI.h"
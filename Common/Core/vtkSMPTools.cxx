@@ -59,6 +59,20 @@ bool vtkSMPTools::GetNestedParallelism()
   return SMPToolsAPI.GetNestedParallelism();
 }
 
+//------------------------------------------------------------------------------
+void vtkSMPTools::SetThreadPinning(bool isPinned)
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.SetThreadPinning(isPinned);
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTools::GetThreadPinning()
+{
+  auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+  return SMPToolsAPI.GetThreadPinning();
+}
+
 //------------------------------------------------------------------------------
 bool vtkSMPTools::IsParallelScope()
 {
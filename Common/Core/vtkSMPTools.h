@@ -34,10 +34,11 @@
 #include "vtkObject.h"
 
 #include "SMP/Common/vtkSMPToolsAPI.h"
+#include "SMP/Common/vtkSMPToolsInternal.h" // For IdentityFunctor
 #include "vtkSMPThreadLocal.h" // For Initialized
 
-#include <functional>  // For std::function
-#include <iterator>    // For std::iterator
+#include <functional>  // For std::function, std::plus, std::less
+#include <iterator>    // For std::iterator, std::iterator_traits
 #include <type_traits> // For std:::enable_if
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -428,7 +429,8 @@ public:
    * When enabled the comportement is different for each backend:
    *    - TBB support nested parallelism by default.
    *    - For OpenMP, we set `omp_set_nested` to true so that it is supported.
-   *    - STDThread support nested parallelism by creating new threads pools.
+   *    - STDThread support nested parallelism by scheduling the nested tasks on the
+   *      work-stealing queues of the same thread pool.
    *    - For Sequential nothing changes.
    *
    * Default to true
@@ -440,6 +442,27 @@ public:
    */
   static bool GetNestedParallelism();
 
+  /**
+   * /!\ This method is not thread safe.
+   * If true, the threads of the current backend are pinned to logical CPUs:
+   * the i-th thread of the backend only runs on the i-th CPU the process is
+   * allowed to run on. Combined with a parallel first touch of the memory
+   * (see vtkAOSDataArrayTemplate::SetParallelFirstTouch()), this keeps the
+   * pages used by a thread on its own NUMA node across vtkSMPTools::For calls.
+   *    - STDThread pins the workers of its thread pool.
+   *    - OpenMP pins the threads of the outermost parallel region.
+   *    - TBB and Sequential ignore this setting.
+   * Pinning is only available on Linux and Windows.
+   *
+   * Default to false
+   */
+  static void SetThreadPinning(bool isPinned);
+
+  /**
+   * Get true if the threads of the current backend are pinned.
+   */
+  static bool GetThreadPinning();
+
   /**
    * Return true if it is called from a parallel scope.
    */
@@ -596,6 +619,145 @@ public:
     auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
     SMPToolsAPI.Sort(begin, end, comp);
   }
+
+  ///@{
+  /**
+   * A convenience method for reducing data. It is a drop in replacement for
+   * std::accumulate() with an associative operation: the values of the range
+   * are combined with reduce in an unspecified grouping and init is combined
+   * first. The default operation is the addition. The grouping only depends on
+   * the size of the range, so the result does not change with the number of
+   * threads, even for floating point values.
+   *
+   * Usage example with vtkDataArray:
+   * \code
+   * const auto range = vtk::DataArrayValueRange<1>(array);
+   * double sum = vtkSMPTools::Reduce(range.cbegin(), range.cend(), 0.0);
+   * double max = vtkSMPTools::Reduce(range.cbegin(), range.cend(), VTK_DOUBLE_MIN,
+   *   [](double x, double y) { return std::max(x, y); });
+   * \endcode
+   */
+  template <typename Iterator, typename T, typename BinaryOp>
+  static T Reduce(Iterator begin, Iterator end, T init, BinaryOp reduce)
+  {
+    vtk::detail::smp::IdentityFunctor identity;
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.TransformReduce(begin, end, init, reduce, identity);
+  }
+
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<T>());
+  }
+  ///@}
+
+  /**
+   * A convenience method for transforming and reducing data in a single pass.
+   * transform is applied to every value of the range and the results are
+   * combined as in Reduce().
+   *
+   * Usage example computing the squared norm of a vector:
+   * \code
+   * double norm2 = vtkSMPTools::TransformReduce(values.cbegin(), values.cend(), 0.0,
+   *   std::plus<double>(), [](double x) { return x * x; });
+   * \endcode
+   */
+  template <typename Iterator, typename T, typename BinaryOp, typename UnaryOp>
+  static T TransformReduce(
+    Iterator begin, Iterator end, T init, BinaryOp reduce, UnaryOp transform)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.TransformReduce(begin, end, init, reduce, transform);
+  }
+
+  ///@{
+  /**
+   * A convenience method computing the inclusive prefix "sum" of a range: the
+   * i-th output value is the combination of the input values 0 to i. op must be
+   * associative and the default is the addition. The output range may be the
+   * input range.
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.InclusiveScan(inBegin, inEnd, outBegin, op);
+  }
+
+  template <typename InputIt, typename OutputIt>
+  static void InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin)
+  {
+    using ValueType = typename std::iterator_traits<InputIt>::value_type;
+    vtkSMPTools::InclusiveScan(inBegin, inEnd, outBegin, std::plus<ValueType>());
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A convenience method computing the exclusive prefix "sum" of a range: the
+   * i-th output value is the combination of init and of the input values 0 to
+   * i - 1. op must be associative and the default is the addition. The output
+   * range may be the input range. It is typically used to turn counts into
+   * offsets.
+   *
+   * Usage example:
+   * \code
+   * // offsets has one more value than counts, the last one being the total
+   * vtkSMPTools::ExclusiveScan(counts, counts + n, offsets, vtkIdType(0));
+   * offsets[n] = offsets[n - 1] + counts[n - 1];
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+  }
+
+  template <typename InputIt, typename OutputIt, typename T>
+  static void ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init)
+  {
+    vtkSMPTools::ExclusiveScan(inBegin, inEnd, outBegin, init, std::plus<T>());
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A convenience method for stable sorting. It is a drop in replacement for
+   * std::stable_sort(): the relative order of equivalent elements is kept. The
+   * parallel backends sort blocks of the range concurrently and merge them in
+   * parallel. The value type must be default constructible.
+   */
+  template <typename RandomAccessIterator>
+  static void StableSort(RandomAccessIterator begin, RandomAccessIterator end)
+  {
+    using ValueType = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    vtkSMPTools::StableSort(begin, end, std::less<ValueType>());
+  }
+
+  template <typename RandomAccessIterator, typename Compare>
+  static void StableSort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    SMPToolsAPI.StableSort(begin, end, comp);
+  }
+  ///@}
+
+  /**
+   * A convenience method reordering a range so that the elements satisfying
+   * pred come first. It is a drop in replacement for std::stable_partition():
+   * the relative order of the elements is kept in both groups. Returns an
+   * iterator to the first element of the second group. The value type must be
+   * default constructible.
+   */
+  template <typename RandomAccessIterator, typename Predicate>
+  static RandomAccessIterator Partition(
+    RandomAccessIterator begin, RandomAccessIterator end, Predicate pred)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.Partition(begin, end, pred);
+  }
 };
 
 #endif
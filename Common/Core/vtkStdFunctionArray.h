@@ -0,0 +1,45 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStdFunctionArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkStdFunctionArray
+ * @brief   An implicit array computing its values with a std::function
+ *
+ * vtkStdFunctionArray<T> is a vtkImplicitArray calling a
+ * std::function<T(vtkIdType)> with the value index. It is convenient for
+ * prototyping, at the cost of an indirect call per value: a dedicated backend
+ * type is faster.
+ *
+ * @code
+ * vtkNew<vtkStdFunctionArray<double>> squares;
+ * squares->ConstructBackend([](vtkIdType i) { return static_cast<double>(i * i); });
+ * squares->SetNumberOfTuples(100);
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray
+ */
+
+#ifndef vtkStdFunctionArray_h
+#define vtkStdFunctionArray_h
+
+#include "vtkImplicitArray.h"
+
+#include <functional> // For std::function
+
+template <typename T>
+using vtkStdFunctionArray = vtkImplicitArray<std::function<T(vtkIdType)>>;
+
+#endif
+// VTK-HeaderTest-Exclude: vtkStdFunctionArray.h
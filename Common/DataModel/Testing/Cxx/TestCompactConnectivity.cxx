@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompactConnectivity.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Memory benchmark of the topology of an unstructured grid of hexahedra
+// with 64-bit and compact 32-bit connectivity and cell links.
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkStaticCellLinksTemplate.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const vtkIdType Dim = 40; // number of hexahedra along each axis
+
+//------------------------------------------------------------------------------
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  const vtkIdType numPtsPerAxis = Dim + 1;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPtsPerAxis * numPtsPerAxis * numPtsPerAxis);
+  vtkIdType ptId = 0;
+  for (vtkIdType k = 0; k < numPtsPerAxis; ++k)
+  {
+    for (vtkIdType j = 0; j < numPtsPerAxis; ++j)
+    {
+      for (vtkIdType i = 0; i < numPtsPerAxis; ++i)
+      {
+        points->SetPoint(ptId++, i, j, k);
+      }
+    }
+  }
+
+  vtkNew<vtkCellArray> cells;
+  cells->Use64BitStorage();
+  cells->AllocateExact(Dim * Dim * Dim, 8 * Dim * Dim * Dim);
+  const vtkIdType dx = 1;
+  const vtkIdType dy = numPtsPerAxis;
+  const vtkIdType dz = numPtsPerAxis * numPtsPerAxis;
+  for (vtkIdType k = 0; k < Dim; ++k)
+  {
+    for (vtkIdType j = 0; j < Dim; ++j)
+    {
+      for (vtkIdType i = 0; i < Dim; ++i)
+      {
+        const vtkIdType p = i * dx + j * dy + k * dz;
+        const vtkIdType hex[8] = { p, p + dx, p + dx + dy, p + dy, p + dz, p + dx + dz,
+          p + dx + dy + dz, p + dy + dz };
+        cells->InsertNextCell(8, hex);
+      }
+    }
+  }
+
+  grid->SetPoints(points);
+  grid->SetCells(VTK_HEXAHEDRON, cells);
+}
+
+//------------------------------------------------------------------------------
+template <typename TIds>
+unsigned long LinksMemorySize(vtkUnstructuredGrid* grid)
+{
+  vtkStaticCellLinksTemplate<TIds> links;
+  links.BuildLinks(grid);
+  return links.GetActualMemorySize() / 1024; // in bytes, unlike vtkDataArray
+}
+
+//------------------------------------------------------------------------------
+bool TestUseStorageOf()
+{
+  vtkNew<vtkCellArray> compact;
+  compact->Use32BitStorage();
+
+  vtkNew<vtkCellArray> cells;
+  cells->Use64BitStorage();
+  cells->AllocateExact(100, 800);
+  cells->UseStorageOf(compact);
+  if (cells->IsStorage64Bit())
+  {
+    std::cerr << "UseStorageOf() did not switch to 32-bit storage." << std::endl;
+    return false;
+  }
+  if (cells->GetConnectivityArray()->GetSize() < 800)
+  {
+    std::cerr << "UseStorageOf() did not keep the capacity." << std::endl;
+    return false;
+  }
+
+  const vtkIdType tri[3] = { 0, 1, 2 };
+  cells->InsertNextCell(3, tri);
+  if (cells->GetNumberOfCells() != 1 || cells->GetNumberOfConnectivityIds() != 3)
+  {
+    std::cerr << "Wrong content after UseStorageOf()." << std::endl;
+    return false;
+  }
+
+  // The cells of an unstructured grid without cells are null
+  cells->UseStorageOf(nullptr);
+  if (cells->IsStorage64Bit() || cells->GetNumberOfCells() != 0)
+  {
+    std::cerr << "UseStorageOf(nullptr) did not only reset the cells." << std::endl;
+    return false;
+  }
+  return true;
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int TestCompactConnectivity(int, char*[])
+{
+  if (!TestUseStorageOf())
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+  vtkCellArray* cells = grid->GetCells();
+
+  const unsigned long cells64 = cells->GetActualMemorySize();
+  const unsigned long links64 = LinksMemorySize<vtkIdType>(grid);
+
+  if (!cells->ConvertToSmallestStorage() || cells->IsStorage64Bit())
+  {
+    std::cerr << "The connectivity was not converted to 32-bit storage." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const unsigned long cells32 = cells->GetActualMemorySize();
+  const unsigned long links32 = LinksMemorySize<int>(grid);
+
+  std::cout << grid->GetNumberOfCells() << " hexahedra, " << grid->GetNumberOfPoints()
+            << " points\n";
+  std::cout << "   Connectivity: " << cells64 << " kb with 64-bit storage, " << cells32
+            << " kb with 32-bit storage\n";
+  std::cout << "   Cell links:   " << links64 << " kb with 64-bit ids, " << links32
+            << " kb with 32-bit ids\n";
+
+  if (sizeof(vtkIdType) == 8 && (2 * cells32 > cells64 + 1 || 2 * links32 > links64 + 1))
+  {
+    std::cerr << "The compact topology does not use half of the memory." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The grid is still usable with compact connectivity
+  vtkNew<vtkIdList> ptIds;
+  grid->GetCellPoints(grid->GetNumberOfCells() - 1, ptIds);
+  const vtkIdType lastPtId = grid->GetNumberOfPoints() - 1;
+  if (ptIds->GetNumberOfIds() != 8 || ptIds->GetId(6) != lastPtId)
+  {
+    std::cerr << "Wrong points for the last cell." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetAttributesInterpolation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that the batched interpolations and copies of vtkDataSetAttributes
+// match the per tuple ones.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                                                     \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(cond))                                                                                   \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;                              \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+const vtkIdType NumberOfInputTuples = 1000;
+const vtkIdType NumberOfOutputTuples = 5000;
+
+//------------------------------------------------------------------------------
+void FillInput(vtkPointData* input)
+{
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(NumberOfInputTuples);
+  vtkNew<vtkIntArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(NumberOfInputTuples);
+  vtkNew<vtkDoubleArray> field;
+  field->SetName("field");
+  field->SetNumberOfComponents(2);
+  field->SetNumberOfTuples(NumberOfInputTuples);
+  vtkNew<vtkStringArray> names;
+  names->SetName("names");
+  names->SetNumberOfTuples(NumberOfInputTuples);
+  for (vtkIdType i = 0; i < NumberOfInputTuples; ++i)
+  {
+    vectors->SetTuple3(i, i, 0.5 * i, -0.25 * i);
+    scalars->SetValue(i, static_cast<int>(3 * i + 1));
+    field->SetTuple2(i, 1.0 / (i + 1), i * i);
+    names->SetValue(i, std::to_string(i));
+  }
+  input->SetVectors(vectors);
+  input->SetScalars(scalars);
+  input->AddArray(field);
+  input->AddArray(names);
+}
+
+//------------------------------------------------------------------------------
+void AllocateOutput(vtkPointData* output, vtkPointData* input)
+{
+  // nearest neighbor interpolation of the scalars
+  output->SetCopyAttribute(vtkDataSetAttributes::SCALARS, 2, vtkDataSetAttributes::INTERPOLATE);
+  output->InterpolateAllocate(input, NumberOfOutputTuples);
+}
+
+//------------------------------------------------------------------------------
+bool CompareOutputs(vtkPointData* expected, vtkPointData* actual)
+{
+  TEST_ASSERT(expected->GetNumberOfArrays() == actual->GetNumberOfArrays(),
+    "Wrong number of arrays: " << actual->GetNumberOfArrays());
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkAbstractArray* expectedArray = expected->GetAbstractArray(a);
+    vtkAbstractArray* actualArray = actual->GetAbstractArray(expectedArray->GetName());
+    TEST_ASSERT(actualArray, "Missing array " << expectedArray->GetName());
+    TEST_ASSERT(actualArray->GetNumberOfTuples() == NumberOfOutputTuples,
+      "Wrong number of tuples in " << expectedArray->GetName() << ": "
+                                   << actualArray->GetNumberOfTuples());
+    vtkIdType numberOfValues = expectedArray->GetNumberOfValues();
+    for (vtkIdType i = 0; i < numberOfValues; ++i)
+    {
+      TEST_ASSERT(expectedArray->GetVariantValue(i) == actualArray->GetVariantValue(i),
+        "Wrong value " << i << " in " << expectedArray->GetName() << ": "
+                       << actualArray->GetVariantValue(i).ToString() << " instead of "
+                       << expectedArray->GetVariantValue(i).ToString());
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestInterpolateTuples(vtkPointData* input)
+{
+  // Output tuple k interpolates between 1 and 8 input tuples.
+  std::vector<vtkIdType> offsets(1, 0);
+  std::vector<vtkIdType> ids;
+  std::vector<double> weights;
+  for (vtkIdType k = 0; k < NumberOfOutputTuples; ++k)
+  {
+    int n = 1 + k % 8;
+    double sum = n * (n + 1) / 2.;
+    for (int j = 0; j < n; ++j)
+    {
+      ids.push_back((7 * k + 13 * j) % NumberOfInputTuples);
+      weights.push_back((j + 1) / sum);
+    }
+    offsets.push_back(static_cast<vtkIdType>(ids.size()));
+  }
+
+  vtkNew<vtkPointData> expected;
+  AllocateOutput(expected, input);
+  vtkNew<vtkIdList> tupleIds;
+  for (vtkIdType k = 0; k < NumberOfOutputTuples; ++k)
+  {
+    tupleIds->SetNumberOfIds(offsets[k + 1] - offsets[k]);
+    for (vtkIdType j = offsets[k]; j < offsets[k + 1]; ++j)
+    {
+      tupleIds->SetId(j - offsets[k], ids[j]);
+    }
+    expected->InterpolatePoint(input, k, tupleIds, weights.data() + offsets[k]);
+  }
+
+  vtkNew<vtkPointData> actual;
+  AllocateOutput(actual, input);
+  actual->InterpolateTuples(
+    input, 0, NumberOfOutputTuples / 2, offsets.data(), ids.data(), weights.data());
+  actual->InterpolateTuples(input, NumberOfOutputTuples / 2, NumberOfOutputTuples / 2,
+    offsets.data() + NumberOfOutputTuples / 2, ids.data(), weights.data());
+
+  return CompareOutputs(expected, actual);
+}
+
+//------------------------------------------------------------------------------
+bool TestInterpolateEdges(vtkPointData* input)
+{
+  std::vector<vtkIdType> p1(NumberOfOutputTuples);
+  std::vector<vtkIdType> p2(NumberOfOutputTuples);
+  std::vector<double> t(NumberOfOutputTuples);
+  for (vtkIdType k = 0; k < NumberOfOutputTuples; ++k)
+  {
+    p1[k] = k % NumberOfInputTuples;
+    p2[k] = (3 * k + 1) % NumberOfInputTuples;
+    t[k] = (k % 11) / 10.;
+  }
+
+  vtkNew<vtkPointData> expected;
+  AllocateOutput(expected, input);
+  for (vtkIdType k = 0; k < NumberOfOutputTuples; ++k)
+  {
+    expected->InterpolateEdge(input, k, p1[k], p2[k], t[k]);
+  }
+
+  vtkNew<vtkPointData> actual;
+  AllocateOutput(actual, input);
+  actual->InterpolateEdges(input, 0, NumberOfOutputTuples, p1.data(), p2.data(), t.data());
+
+  return CompareOutputs(expected, actual);
+}
+
+//------------------------------------------------------------------------------
+bool TestCopyDataStartingAt(vtkPointData* input)
+{
+  // Copy into arrays already holding all the output tuples, from a non-zero
+  // start, so that the threads write into the arrays without resizing them.
+  const vtkIdType destStart = 1000;
+  vtkNew<vtkIdList> fromIds;
+  fromIds->SetNumberOfIds(NumberOfOutputTuples - destStart);
+  for (vtkIdType k = 0; k < fromIds->GetNumberOfIds(); ++k)
+  {
+    fromIds->SetId(k, (11 * k + 5) % NumberOfInputTuples);
+  }
+
+  vtkNew<vtkPointData> expected;
+  vtkNew<vtkPointData> actual;
+  for (vtkPointData* output : { expected.Get(), actual.Get() })
+  {
+    output->CopyAllocate(input, NumberOfOutputTuples);
+    output->SetNumberOfTuples(NumberOfOutputTuples);
+    for (vtkIdType k = 0; k < destStart; ++k)
+    {
+      output->CopyData(input, k % NumberOfInputTuples, k);
+    }
+  }
+  for (vtkIdType k = 0; k < fromIds->GetNumberOfIds(); ++k)
+  {
+    expected->CopyData(input, fromIds->GetId(k), destStart + k);
+  }
+
+  void* vectors = actual->GetVectors()->GetVoidPointer(0);
+  vtkSMPTools::LocalScope(
+    vtkSMPTools::Config{ 4 }, [&]() { actual->CopyData(input, fromIds, destStart); });
+  TEST_ASSERT(actual->GetVectors()->GetVoidPointer(0) == vectors,
+    "The destination arrays were reallocated.");
+
+  return CompareOutputs(expected, actual);
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int TestDataSetAttributesInterpolation(int, char*[])
+{
+  vtkNew<vtkPointData> input;
+  FillInput(input);
+
+  if (!TestInterpolateTuples(input) || !TestInterpolateEdges(input) ||
+    !TestCopyDataStartingAt(input))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -26,9 +27,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+
 //------------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
 {
@@ -57,10 +62,18 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double[numCells][6];
-  for (vtkIdType j = 0; j < numCells; j++)
+  if (numCells < 1)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    return true;
   }
+  // GetCellBounds() is thread safe once called
+  this->DataSet->GetCellBounds(0, this->CellBounds[0]);
+  vtkSMPTools::For(1, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType j = begin; j < end; j++)
+    {
+      this->DataSet->GetCellBounds(j, this->CellBounds[j]);
+    }
+  });
   return true;
 }
 //------------------------------------------------------------------------------
@@ -197,6 +210,61 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   }
   return returnVal;
 }
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::BatchFindCell(vtkPoints* queries, double tol2,
+  vtkIdTypeArray* cellIds, vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  const vtkIdType numQueries = queries->GetNumberOfPoints();
+  const int maxCellSize = this->DataSet ? std::max(this->DataSet->GetMaxCellSize(), 1) : 1;
+  cellIds->SetNumberOfValues(numQueries);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numQueries);
+  }
+  if (weights)
+  {
+    weights->SetNumberOfComponents(maxCellSize);
+    weights->SetNumberOfTuples(numQueries);
+  }
+  if (numQueries == 0)
+  {
+    return;
+  }
+  if (!this->DataSet || this->DataSet->GetNumberOfCells() < 1)
+  {
+    cellIds->FillValue(-1);
+    return;
+  }
+
+  // Locate a point in each thread with its own cell and weights, unless
+  // the weights are returned
+  vtkIdType* ids = cellIds->GetPointer(0);
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  const std::vector<double> weightsExemplar(maxCellSize);
+  vtkSMPThreadLocal<std::vector<double>> localWeights(weightsExemplar);
+  auto locate = [&](vtkIdType q, vtkIdType end) {
+    vtkGenericCell* cell = cells.Local();
+    std::vector<double>& w = localWeights.Local();
+    double x[3], pc[3];
+    for (; q < end; ++q)
+    {
+      queries->GetPoint(q, x);
+      ids[q] = this->FindCell(x, tol2, cell, pcoords ? pcoords->GetPointer(3 * q) : pc,
+        weights ? weights->GetPointer(maxCellSize * q) : w.data());
+    }
+  };
+
+  // The first query builds the locator if it is lazily evaluated, and the
+  // cells of the dataset are built by getting one and its bounds, so that
+  // the other queries are thread safe.
+  double bounds[6];
+  this->DataSet->GetCell(0, cells.Local());
+  this->DataSet->GetCellBounds(0, bounds);
+  locate(0, 1);
+  vtkSMPTools::For(1, numQueries, locate);
+}
+
 //------------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
@@ -43,8 +43,10 @@
 #include <vector> // For Weights
 
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractCellLocator : public vtkLocator
@@ -252,6 +254,23 @@ public:
   virtual vtkIdType FindCell(
     double x[3], double tol2, vtkGenericCell* GenCell, double pcoords[3], double* weights);
 
+  /**
+   * Batched form of FindCell(x, tol2, GenCell, pcoords, weights), locating
+   * each point of queries. cellIds receives the id of the cell containing
+   * each query point, or -1. If given, pcoords receives the parametric
+   * coordinates of each point in its cell, in 3 components, and weights its
+   * interpolation weights, in as many components as the largest cell of the
+   * dataset has points: only the first ones, up to the number of points of
+   * the cell, are meaningful. The arrays are resized. The first point is
+   * located alone, which builds a lazily evaluated locator, then the other
+   * points are located in parallel with vtkSMPTools. This requires FindCell()
+   * to be thread safe once the locator is built, as it is in
+   * vtkStaticCellLocator, vtkCellLocator, vtkCellTreeLocator and
+   * vtkModifiedBSPTree.
+   */
+  virtual void BatchFindCell(vtkPoints* queries, double tol2, vtkIdTypeArray* cellIds,
+    vtkDoubleArray* pcoords = nullptr, vtkDoubleArray* weights = nullptr);
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
@@ -16,6 +16,9 @@
 
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLocatorBatchQuery.h"
+#include "vtkPoints.h"
 
 //------------------------------------------------------------------------------
 vtkAbstractPointLocator::vtkAbstractPointLocator()
@@ -64,6 +67,37 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::BatchFindClosestNPoints(
+  int N, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  // Build the locator now: the queries are not thread safe until it is built
+  this->BuildLocator();
+  vtkLocatorBatchQuery::Execute(
+    queries->GetNumberOfPoints(),
+    [this, N, queries](vtkIdType q, vtkIdList* result) {
+      double x[3];
+      queries->GetPoint(q, x);
+      this->FindClosestNPoints(N, x, result);
+    },
+    offsets, ids);
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::BatchFindPointsWithinRadius(
+  double R, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->BuildLocator();
+  vtkLocatorBatchQuery::Execute(
+    queries->GetNumberOfPoints(),
+    [this, R, queries](vtkIdType q, vtkIdList* result) {
+      double x[3];
+      queries->GetPoint(q, x);
+      this->FindPointsWithinRadius(R, x, result);
+    },
+    offsets, ids);
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
@@ -34,6 +34,8 @@
 #include "vtkLocator.h"
 
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -89,6 +91,23 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   ///@}
 
+  ///@{
+  /**
+   * Batched forms of FindClosestNPoints() and FindPointsWithinRadius(),
+   * running the query of each point of queries. The ids found for the
+   * query point i are ids[offsets[i]] to ids[offsets[i + 1] - 1], in the
+   * order of the single query: offsets holds one more value than there are
+   * query points. Both arrays are resized. The queries are run in parallel
+   * with vtkSMPTools, after BuildLocator() is called, and the results do not
+   * depend on the number of threads. Subclasses may override these methods
+   * to avoid the virtual call and the allocations of each query.
+   */
+  virtual void BatchFindClosestNPoints(
+    int N, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids);
+  virtual void BatchFindPointsWithinRadius(
+    double R, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids);
+  ///@}
+
   ///@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
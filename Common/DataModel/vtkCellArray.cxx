@@ -984,6 +984,32 @@ void vtkCellArray::UseDefaultStorage()
 #endif // VTK_USE_64BIT_IDS
 }
 
+//------------------------------------------------------------------------------
+void vtkCellArray::UseStorageOf(vtkCellArray* other)
+{
+  if (!other || other->IsStorage64Bit() == this->IsStorage64Bit())
+  {
+    this->Reset();
+    return;
+  }
+
+  // Keep the capacity of the previous storage
+  const vtkIdType numCells = std::max<vtkIdType>(this->GetOffsetsArray()->GetSize() - 1, 0);
+  const vtkIdType connectivitySize = this->GetConnectivityArray()->GetSize();
+  if (other->IsStorage64Bit())
+  {
+    this->Use64BitStorage();
+  }
+  else
+  {
+    this->Use32BitStorage();
+  }
+  if (numCells > 0 || connectivitySize > 0)
+  {
+    this->AllocateExact(numCells, connectivitySize);
+  }
+}
+
 //------------------------------------------------------------------------------
 bool vtkCellArray::CanConvertTo32BitStorage() const
 {
@@ -451,6 +451,18 @@ public:
   void UseDefaultStorage();
   /**@}*/
 
+  /**
+   * Use the same 32- or 64-bit storage as @a other. Filters that output a
+   * subset of the cells of their input call it on their output cell arrays:
+   * ids and offsets that fit in the input storage also fit in the output
+   * one, so compact 32-bit connectivity is never widened.
+   *
+   * All existing data is erased, but the capacity reserved by a previous
+   * allocation is kept. A null @a other, such as the cells of an unstructured
+   * grid without cells, leaves the storage unchanged.
+   */
+  void UseStorageOf(vtkCellArray* other);
+
   /**
    * Check if the existing data can safely be converted to use 32- or 64- bit
    * storage. Ensures that all values can be converted to the target storage
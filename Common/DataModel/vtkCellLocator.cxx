@@ -20,8 +20,13 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLocator);
 
@@ -1189,13 +1194,12 @@ void vtkCellLocator::ForceBuildLocator()
 //
 void vtkCellLocator::BuildLocatorInternal()
 {
-  double length, cellBounds[6], *boundsPtr;
+  double length, cellBounds[6];
   vtkIdType numCells;
   int ndivs, product;
-  int i, j, k, ijkMin[3], ijkMax[3];
-  vtkIdType cellId, idx;
+  int i, j, k;
+  vtkIdType idx;
   int parentOffset;
-  vtkIdList* octant;
   int numCellsPerBucket = this->NumberOfCellsPerNode;
   int prod, numOctants;
   double hTol[3];
@@ -1273,62 +1277,137 @@ void vtkCellLocator::BuildLocatorInternal()
     hTol[i] = this->H[i] / 100.0;
   }
 
-  //  Insert each cell into the appropriate octant.  Make sure cell
-  //  falls within octant.
+  //  Insert each cell into the appropriate octants.  Make sure cell
+  //  falls within octant.  The cells of each octant are counted, then
+  //  inserted in parallel, and finally sorted so that they are in increasing
+  //  order as in a serial insertion.
   //
   parentOffset = numOctants - (ndivs * ndivs * ndivs);
   product = ndivs * ndivs;
-  boundsPtr = cellBounds;
-  for (cellId = 0; cellId < numCells; cellId++)
+  const vtkIdType numLeaves = static_cast<vtkIdType>(product) * ndivs;
+  if (!this->CellBounds)
   {
-    if (this->CellBounds)
+    // GetCellBounds() is thread safe once called
+    this->DataSet->GetCellBounds(0, cellBounds);
+  }
+
+  // find min/max locations of bounding box of each cell
+  std::vector<int> cellOctants(6 * numCells);
+  std::unique_ptr<std::atomic<vtkIdType>[]> octantSizes(new std::atomic<vtkIdType>[numLeaves]);
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType begin, vtkIdType end) {
+    for (; begin < end; begin++)
     {
-      boundsPtr = this->CellBounds[cellId];
+      octantSizes[begin] = 0;
     }
-    else
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    double bds[6];
+    for (vtkIdType id = begin; id < end; id++)
     {
-      this->DataSet->GetCellBounds(cellId, cellBounds);
-    }
+      const double* bPtr = bds;
+      if (this->CellBounds)
+      {
+        bPtr = this->CellBounds[id];
+      }
+      else
+      {
+        this->DataSet->GetCellBounds(id, bds);
+      }
 
-    // find min/max locations of bounding box
-    for (i = 0; i < 3; i++)
-    {
-      ijkMin[i] = static_cast<int>((boundsPtr[2 * i] - this->Bounds[2 * i] - hTol[i]) / this->H[i]);
-      ijkMax[i] =
-        static_cast<int>((boundsPtr[2 * i + 1] - this->Bounds[2 * i] + hTol[i]) / this->H[i]);
+      int* octMin = cellOctants.data() + 6 * id;
+      int* octMax = octMin + 3;
+      for (int ii = 0; ii < 3; ii++)
+      {
+        octMin[ii] =
+          static_cast<int>((bPtr[2 * ii] - this->Bounds[2 * ii] - hTol[ii]) / this->H[ii]);
+        octMax[ii] =
+          static_cast<int>((bPtr[2 * ii + 1] - this->Bounds[2 * ii] + hTol[ii]) / this->H[ii]);
+
+        if (octMin[ii] < 0)
+        {
+          octMin[ii] = 0;
+        }
+        if (octMax[ii] >= ndivs)
+        {
+          octMax[ii] = ndivs - 1;
+        }
+      }
 
-      if (ijkMin[i] < 0)
+      // each octant between min/max point may have cell in it
+      for (int kk = octMin[2]; kk <= octMax[2]; kk++)
       {
-        ijkMin[i] = 0;
+        for (int jj = octMin[1]; jj <= octMax[1]; jj++)
+        {
+          for (int ii = octMin[0]; ii <= octMax[0]; ii++)
+          {
+            octantSizes[ii + jj * ndivs + kk * static_cast<vtkIdType>(product)]++;
+          }
+        }
       }
-      if (ijkMax[i] >= ndivs)
+    }
+  });
+
+  // create the cell list of each non-empty octant, its size becoming the
+  // number of cells inserted so far
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType begin, vtkIdType end) {
+    for (; begin < end; begin++)
+    {
+      if (octantSizes[begin] > 0)
       {
-        ijkMax[i] = ndivs - 1;
+        vtkIdList* octant = vtkIdList::New();
+        octant->SetNumberOfIds(octantSizes[begin]);
+        this->Tree[parentOffset + begin] = octant;
+        octantSizes[begin] = 0;
       }
     }
+  });
 
-    // each octant between min/max point may have cell in it
-    for (k = ijkMin[2]; k <= ijkMax[2]; k++)
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType id = begin; id < end; id++)
     {
-      for (j = ijkMin[1]; j <= ijkMax[1]; j++)
+      const int* octMin = cellOctants.data() + 6 * id;
+      const int* octMax = octMin + 3;
+      for (int kk = octMin[2]; kk <= octMax[2]; kk++)
       {
-        for (i = ijkMin[0]; i <= ijkMax[0]; i++)
+        for (int jj = octMin[1]; jj <= octMax[1]; jj++)
         {
-          idx = parentOffset + i + j * ndivs + k * product;
-          this->MarkParents(reinterpret_cast<void*>(VTK_CELL_INSIDE), i, j, k, ndivs, this->Level);
-          octant = this->Tree[idx];
-          if (!octant)
+          for (int ii = octMin[0]; ii <= octMax[0]; ii++)
           {
-            octant = vtkIdList::New();
-            octant->Allocate(numCellsPerBucket, numCellsPerBucket / 2);
-            this->Tree[idx] = octant;
+            const vtkIdType leaf = ii + jj * ndivs + kk * static_cast<vtkIdType>(product);
+            this->Tree[parentOffset + leaf]->SetId(octantSizes[leaf]++, id);
           }
-          octant->InsertNextId(cellId);
         }
       }
     }
+  });
+  std::vector<int>().swap(cellOctants);
 
-  } // for all cells
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType begin, vtkIdType end) {
+    for (; begin < end; begin++)
+    {
+      vtkIdList* octant = this->Tree[parentOffset + begin];
+      if (octant)
+      {
+        vtkIdType* ids = octant->GetPointer(0);
+        if (!std::is_sorted(ids, ids + octant->GetNumberOfIds()))
+        {
+          std::sort(ids, ids + octant->GetNumberOfIds());
+        }
+      }
+    }
+  });
+
+  // mark the parents of the non-empty octants
+  for (idx = 0; idx < numLeaves; idx++)
+  {
+    if (this->Tree[parentOffset + idx])
+    {
+      i = static_cast<int>(idx % ndivs);
+      j = static_cast<int>((idx / ndivs) % ndivs);
+      k = static_cast<int>(idx / product);
+      this->MarkParents(reinterpret_cast<void*>(VTK_CELL_INSIDE), i, j, k, ndivs, this->Level);
+    }
+  }
 
   this->BuildTime.Modified();
 }
@@ -17,6 +17,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkDataArrayRange.h"
+#include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkSMPTools.h"
 #include "vtkStructuredExtent.h"
@@ -1122,6 +1123,231 @@ void vtkDataSetAttributes::InterpolateTime(
   }
 }
 
+namespace
+{
+//==============================================================================
+// Stencil of vtkDataSetAttributes::InterpolateTuples(): output tuple k is the
+// weighted sum of the input tuples Ids[Offsets[k]] to Ids[Offsets[k + 1] - 1].
+struct WeightedTuplesStencil
+{
+  const vtkIdType* Offsets;
+  const vtkIdType* Ids;
+  const double* Weights;
+
+  template <typename ValueType, typename SourceRangeT, typename TupleT>
+  void Interpolate(vtkIdType k, const SourceRangeT& source, TupleT&& tuple) const
+  {
+    const vtkIdType begin = this->Offsets[k];
+    const vtkIdType end = this->Offsets[k + 1];
+    const int numComps = static_cast<int>(tuple.size());
+    for (int c = 0; c < numComps; ++c)
+    {
+      double val = 0.;
+      for (vtkIdType j = begin; j < end; ++j)
+      {
+        val += this->Weights[j] * static_cast<double>(source[this->Ids[j]][c]);
+      }
+      ValueType valT;
+      vtkMath::RoundDoubleToIntegralIfNecessary(val, &valT);
+      tuple[c] = valT;
+    }
+  }
+
+  // Same choice as InterpolatePoint() for nearest neighbor interpolation
+  vtkIdType Nearest(vtkIdType k) const
+  {
+    const vtkIdType begin = this->Offsets[k];
+    const vtkIdType end = this->Offsets[k + 1];
+    vtkIdType nearest = this->Ids[begin];
+    double maxWeight = 0.;
+    for (vtkIdType j = begin; j < end; ++j)
+    {
+      if (this->Weights[j] > maxWeight)
+      {
+        maxWeight = this->Weights[j];
+        nearest = this->Ids[j];
+      }
+    }
+    return nearest;
+  }
+
+  void Fallback(vtkIdType k, vtkAbstractArray* source, vtkAbstractArray* dest, vtkIdType dstId,
+    vtkIdList* ids) const
+  {
+    const vtkIdType begin = this->Offsets[k];
+    ids->SetNumberOfIds(this->Offsets[k + 1] - begin);
+    std::copy(this->Ids + begin, this->Ids + this->Offsets[k + 1], ids->begin());
+    dest->InterpolateTuple(dstId, ids, source, const_cast<double*>(this->Weights + begin));
+  }
+};
+
+//==============================================================================
+// Stencil of vtkDataSetAttributes::InterpolateEdges(): output tuple k is
+// interpolated between the input tuples P1[k] and P2[k] with the factor T[k].
+struct EdgeStencil
+{
+  const vtkIdType* P1;
+  const vtkIdType* P2;
+  const double* T;
+
+  template <typename ValueType, typename SourceRangeT, typename TupleT>
+  void Interpolate(vtkIdType k, const SourceRangeT& source, TupleT&& tuple) const
+  {
+    const auto tuple1 = source[this->P1[k]];
+    const auto tuple2 = source[this->P2[k]];
+    const double t = this->T[k];
+    const double oneMinusT = 1. - t;
+    const int numComps = static_cast<int>(tuple.size());
+    for (int c = 0; c < numComps; ++c)
+    {
+      double val = tuple1[c] * oneMinusT + tuple2[c] * t;
+      ValueType valT;
+      vtkMath::RoundDoubleToIntegralIfNecessary(val, &valT);
+      tuple[c] = valT;
+    }
+  }
+
+  // Same choice as InterpolateEdge() for nearest neighbor interpolation
+  vtkIdType Nearest(vtkIdType k) const { return this->T[k] < .5 ? this->P1[k] : this->P2[k]; }
+
+  void Fallback(vtkIdType k, vtkAbstractArray* source, vtkAbstractArray* dest, vtkIdType dstId,
+    vtkIdList*) const
+  {
+    dest->InterpolateTuple(dstId, this->P1[k], source, this->P2[k], source, this->T[k]);
+  }
+};
+
+//==============================================================================
+// This worker interpolates all the tuples of one array in a single parallel
+// loop. The target array must already hold the interpolated tuples.
+template <typename StencilT>
+struct InterpolateTuplesWorker
+{
+  InterpolateTuplesWorker(const StencilT& stencil, vtkIdType dstStart, vtkIdType n, bool nearest)
+    : Stencil(stencil)
+    , DestStartId(dstStart)
+    , NumberOfTuples(n)
+    , Nearest(nearest)
+  {
+  }
+
+  template <typename SourceArrayT, typename DestArrayT>
+  void operator()(SourceArrayT* sourceArray, DestArrayT* destArray)
+  {
+    const auto source = vtk::DataArrayTupleRange(sourceArray);
+    auto dest = vtk::DataArrayTupleRange(destArray);
+    using ValueType = vtk::GetAPIType<DestArrayT>;
+    const StencilT& stencil = this->Stencil;
+    const vtkIdType destStartId = this->DestStartId;
+    const bool nearest = this->Nearest;
+
+    vtkSMPTools::For(0, this->NumberOfTuples, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType k = begin; k < end; ++k)
+      {
+        if (nearest)
+        {
+          dest[destStartId + k] = source[stencil.Nearest(k)];
+        }
+        else
+        {
+          stencil.template Interpolate<ValueType>(k, source, dest[destStartId + k]);
+        }
+      }
+    });
+  }
+
+  // Arrays that are not dispatched, such as string arrays, are interpolated
+  // one tuple at a time.
+  void Fallback(vtkAbstractArray* source, vtkAbstractArray* dest)
+  {
+    vtkNew<vtkIdList> ids;
+    for (vtkIdType k = 0; k < this->NumberOfTuples; ++k)
+    {
+      if (this->Nearest)
+      {
+        dest->SetTuple(this->DestStartId + k, this->Stencil.Nearest(k), source);
+      }
+      else
+      {
+        this->Stencil.Fallback(k, source, dest, this->DestStartId + k, ids);
+      }
+    }
+  }
+
+  const StencilT& Stencil;
+  vtkIdType DestStartId;
+  vtkIdType NumberOfTuples;
+  bool Nearest;
+};
+
+//------------------------------------------------------------------------------
+template <typename StencilT>
+void InterpolateAllArrays(vtkDataSetAttributes* source, vtkDataSetAttributes* dest,
+  vtkFieldData::BasicIterator& requiredArrays, const int* targetIndices,
+  const int* interpolateFlags, vtkIdType dstStart, vtkIdType n, const StencilT& stencil)
+{
+  vtkIdType numberOfTuples = dstStart + n;
+  for (const int i : requiredArrays)
+  {
+    // Sizing the arrays first lets the tuples be written in parallel.
+    vtkAbstractArray* array = dest->GetAbstractArray(targetIndices[i]);
+    if (numberOfTuples > array->GetNumberOfTuples())
+    {
+      array->Resize(numberOfTuples);            // this preserves already existing data
+      array->SetNumberOfTuples(numberOfTuples); // this sets MaxId
+    }
+  }
+
+  for (const int i : requiredArrays)
+  {
+    vtkAbstractArray* fromArray = source->GetAbstractArray(i);
+    vtkAbstractArray* toArray = dest->GetAbstractArray(targetIndices[i]);
+
+    // check if the destination array needs nearest neighbor interpolation
+    int attributeIndex = dest->IsArrayAnAttribute(targetIndices[i]);
+    bool nearest = attributeIndex != -1 && interpolateFlags[attributeIndex] == 2;
+
+    InterpolateTuplesWorker<StencilT> worker(stencil, dstStart, n, nearest);
+    vtkDataArray* fromData = vtkArrayDownCast<vtkDataArray>(fromArray);
+    vtkDataArray* toData = vtkArrayDownCast<vtkDataArray>(toArray);
+    if (!fromData || !toData ||
+      fromData->GetNumberOfComponents() != toData->GetNumberOfComponents() ||
+      !vtkArrayDispatch::Dispatch2SameValueType::Execute(fromData, toData, worker))
+    {
+      worker.Fallback(fromArray, toArray);
+    }
+  }
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void vtkDataSetAttributes::InterpolateTuples(vtkDataSetAttributes* fromPd, vtkIdType dstStart,
+  vtkIdType n, const vtkIdType* offsets, const vtkIdType* ids, const double* weights)
+{
+  if (n <= 0)
+  {
+    return;
+  }
+
+  WeightedTuplesStencil stencil{ offsets, ids, weights };
+  InterpolateAllArrays(fromPd, this, this->RequiredArrays, this->TargetIndices,
+    this->CopyAttributeFlags[INTERPOLATE], dstStart, n, stencil);
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetAttributes::InterpolateEdges(vtkDataSetAttributes* fromPd, vtkIdType dstStart,
+  vtkIdType n, const vtkIdType* p1, const vtkIdType* p2, const double* t)
+{
+  if (n <= 0)
+  {
+    return;
+  }
+
+  EdgeStencil stencil{ p1, p2, t };
+  InterpolateAllArrays(fromPd, this, this->RequiredArrays, this->TargetIndices,
+    this->CopyAttributeFlags[INTERPOLATE], dstStart, n, stencil);
+}
+
 //------------------------------------------------------------------------------
 // Copy a tuple of data from one data array to another. This method (and
 // following ones) assume that the fromData and toData objects are of the
@@ -584,6 +584,27 @@ public:
   void InterpolateEdge(
     vtkDataSetAttributes* fromPd, vtkIdType toId, vtkIdType p1, vtkIdType p2, double t);
 
+  ///@{
+  /**
+   * Batched forms of InterpolatePoint() and InterpolateEdge(), computing the
+   * @a n output tuples dstStart to dstStart + n - 1 at once. Each array is
+   * processed by a single dispatched loop, run in parallel with vtkSMPTools,
+   * instead of one virtual call per tuple and per array.
+   * InterpolateTuples() computes the output tuple dstStart + k from the input
+   * tuples ids[offsets[k]] to ids[offsets[k + 1] - 1] and the matching
+   * weights: @a offsets holds n + 1 values. InterpolateEdges() computes the
+   * output tuple dstStart + k from the input tuples p1[k] and p2[k] and the
+   * factor t[k], as InterpolateEdge() does.
+   * Make sure that the method InterpolateAllocate() has been invoked before
+   * using these methods. The INTERPOLATION copy flags are honored as in
+   * InterpolatePoint().
+   */
+  void InterpolateTuples(vtkDataSetAttributes* fromPd, vtkIdType dstStart, vtkIdType n,
+    const vtkIdType* offsets, const vtkIdType* ids, const double* weights);
+  void InterpolateEdges(vtkDataSetAttributes* fromPd, vtkIdType dstStart, vtkIdType n,
+    const vtkIdType* p1, const vtkIdType* p2, const double* t);
+  ///@}
+
   /**
    * Interpolate data from the same id (point or cell) at different points
    * in time (parameter t). Two input data set attributes objects are input.
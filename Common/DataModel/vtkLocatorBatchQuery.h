@@ -0,0 +1,102 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLocatorBatchQuery.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkLocatorBatchQuery
+ * @brief   run a locator query on a batch of points and gather the results
+ *
+ * vtkLocatorBatchQuery runs a query returning a list of ids, such as
+ * vtkAbstractPointLocator::FindPointsWithinRadius(), on each of a batch of
+ * query points in parallel with vtkSMPTools. The lists are gathered in the
+ * compressed form of the batched locator queries: the ids of query i are
+ * ids[offsets[i]] to ids[offsets[i + 1] - 1], and offsets holds one more
+ * value than there are queries.
+ *
+ * The queries are run by blocks of a fixed number of queries, each block
+ * appending its lists to its own buffer, and the buffers are then copied in
+ * order. The result does not depend on the number of threads.
+ *
+ * The query is a functor called as query(q, list) for the query q, which
+ * fills the list with the ids of q. It is called concurrently, with a list
+ * that each thread reuses from a query to the next, and must be thread safe.
+ *
+ * @sa
+ * vtkAbstractPointLocator vtkInterpolationKernel
+ */
+
+#ifndef vtkLocatorBatchQuery_h
+#define vtkLocatorBatchQuery_h
+
+#include "vtkIdList.h"               // For the query lists
+#include "vtkIdTypeArray.h"          // For the offsets and ids
+#include "vtkSMPThreadLocalObject.h" // For the query lists
+#include "vtkSMPTools.h"             // For the parallel queries
+
+#include <algorithm> // For std::copy
+#include <vector>    // For the block buffers
+
+class vtkLocatorBatchQuery
+{
+public:
+  /**
+   * Run query on the queries 0 to numQueries - 1 and gather their lists in
+   * offsets and ids, which are resized.
+   */
+  template <typename TQuery>
+  static void Execute(
+    vtkIdType numQueries, const TQuery& query, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+  {
+    offsets->SetNumberOfValues(numQueries + 1);
+    vtkIdType* offs = offsets->GetPointer(0);
+    offs[0] = 0;
+
+    // The number of queries of a block
+    const vtkIdType blockSize = 256;
+    const vtkIdType numBlocks = (numQueries + blockSize - 1) / blockSize;
+    std::vector<std::vector<vtkIdType>> blockIds(numBlocks);
+    vtkSMPThreadLocalObject<vtkIdList> lists;
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+      vtkIdList* list = lists.Local();
+      for (; block < endBlock; ++block)
+      {
+        std::vector<vtkIdType>& bIds = blockIds[block];
+        const vtkIdType end = std::min((block + 1) * blockSize, numQueries);
+        for (vtkIdType q = block * blockSize; q < end; ++q)
+        {
+          list->Reset();
+          query(q, list);
+          const vtkIdType* qIds = list->GetPointer(0);
+          bIds.insert(bIds.end(), qIds, qIds + list->GetNumberOfIds());
+          offs[q + 1] = list->GetNumberOfIds();
+        }
+      }
+    });
+
+    // Convert the counts into offsets, then copy the blocks at their offsets
+    vtkSMPTools::InclusiveScan(offs + 1, offs + numQueries + 1, offs + 1);
+    ids->SetNumberOfValues(offs[numQueries]);
+    vtkIdType* idsPtr = ids->GetPointer(0);
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+      for (; block < endBlock; ++block)
+      {
+        std::copy(
+          blockIds[block].begin(), blockIds[block].end(), idsPtr + offs[block * blockSize]);
+        std::vector<vtkIdType>().swap(blockIds[block]);
+      }
+    });
+  }
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkLocatorBatchQuery.h
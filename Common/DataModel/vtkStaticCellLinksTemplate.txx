@@ -361,14 +361,8 @@ void vtkStaticCellLinksTemplate<TIds>::ThreadedBuildLinks(
   vtkSMPTools::For(0, numCells, count);
 
   // Perform prefix sum to determine offsets
-  vtkIdType ptId, npts;
   this->Offsets = new TIds[numPts + 1];
-  this->Offsets[0] = 0;
-  for (ptId = 1; ptId < numPts; ++ptId)
-  {
-    npts = counts[ptId - 1];
-    this->Offsets[ptId] = this->Offsets[ptId - 1] + npts;
-  }
+  vtkSMPTools::ExclusiveScan(counts, counts + numPts, this->Offsets, static_cast<TIds>(0));
   this->Offsets[numPts] = this->LinksSize;
 
   // Now insert cell ids into cell links.
@@ -18,16 +18,21 @@
 #include "vtkBox.h"
 #include "vtkCellArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 #include "vtkLine.h"
+#include "vtkLocatorBatchQuery.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkStructuredData.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkStandardNewMacro(vtkStaticPointLocator);
@@ -398,6 +403,33 @@ double vtkBucketList::Distance2ToBounds(const double x[3], const double bounds[6
   return distance;
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Obtaining closest points requires sorting nearby points
+struct IdTuple
+{
+  vtkIdType PtId;
+  double Dist2;
+
+  bool operator<(const IdTuple& tuple) const { return Dist2 < tuple.Dist2; }
+};
+
+// The working memory of a closest N points query. The batched queries reuse
+// one per thread instead of allocating it for each query point.
+struct ClosestNPointsScratch
+{
+  ClosestNPointsScratch() = default;
+
+  // A copy has its own memory, as the thread locals copy an exemplar
+  ClosestNPointsScratch(const ClosestNPointsScratch&) {}
+  ClosestNPointsScratch& operator=(const ClosestNPointsScratch&) { return *this; }
+
+  NeighborBuckets Buckets;
+  std::vector<IdTuple> Res;
+};
+}
+
 //------------------------------------------------------------------------------
 // The following tuple is what is sorted in the map. Note that it is templated
 // because depending on the number of points / buckets to process we may want
@@ -487,7 +519,13 @@ struct BucketList : public vtkBucketList
   vtkIdType FindClosestPoint(const double x[3]);
   vtkIdType FindClosestPointWithinRadius(
     double radius, const double x[3], double inputDataLength, double& dist2);
-  void FindClosestNPoints(int N, const double x[3], vtkIdList* result);
+  void FindClosestNPoints(int N, const double x[3], vtkIdList* result)
+  {
+    ClosestNPointsScratch scratch;
+    this->FindClosestNPoints(N, x, result, scratch);
+  }
+  void FindClosestNPoints(int N, const double x[3], vtkIdList* result,
+    ClosestNPointsScratch& scratch, bool approximate = false);
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result);
   int IntersectWithLine(double a0[3], double a1[3], double tol, double& t, double lineX[3],
     double ptX[3], vtkIdType& ptId);
@@ -1188,22 +1226,10 @@ vtkIdType BucketList<TIds>::FindClosestPointWithinRadius(
   return closest;
 }
 
-namespace
-{
-//------------------------------------------------------------------------------
-// Obtaining closest points requires sorting nearby points
-struct IdTuple
-{
-  vtkIdType PtId;
-  double Dist2;
-
-  bool operator<(const IdTuple& tuple) const { return Dist2 < tuple.Dist2; }
-};
-}
-
 //------------------------------------------------------------------------------
 template <typename TIds>
-void BucketList<TIds>::FindClosestNPoints(int N, const double x[3], vtkIdList* result)
+void BucketList<TIds>::FindClosestNPoints(
+  int N, const double x[3], vtkIdList* result, ClosestNPointsScratch& scratch, bool approximate)
 {
   int i, j;
   double dist2;
@@ -1211,7 +1237,7 @@ void BucketList<TIds>::FindClosestNPoints(int N, const double x[3], vtkIdList* r
   int level;
   vtkIdType ptId, cno, numIds;
   int ijk[3], *nei;
-  NeighborBuckets buckets;
+  NeighborBuckets& buckets = scratch.Buckets;
   const LocatorTuple<TIds>* ids;
 
   // Clear out any previous results
@@ -1227,7 +1253,8 @@ void BucketList<TIds>::FindClosestNPoints(int N, const double x[3], vtkIdList* r
   level = 0;
   double maxDistance = 0.0;
   int currentCount = 0;
-  std::vector<IdTuple> res(N);
+  std::vector<IdTuple>& res = scratch.Res;
+  res.assign(N, IdTuple());
 
   this->GetBucketNeighbors(&buckets, ijk, this->Divisions, level);
   while (buckets.GetNumberOfNeighbors() && currentCount < N)
@@ -1276,8 +1303,15 @@ void BucketList<TIds>::FindClosestNPoints(int N, const double x[3], vtkIdList* r
   // do a sort
   std::sort(res.begin(), res.begin() + currentCount);
 
-  // Now do the refinement
-  this->GetOverlappingBuckets(&buckets, x, ijk, sqrt(maxDistance), level - 1);
+  // Now do the refinement, unless approximate points are enough
+  if (approximate)
+  {
+    buckets.Reset();
+  }
+  else
+  {
+    this->GetOverlappingBuckets(&buckets, x, ijk, sqrt(maxDistance), level - 1);
+  }
 
   for (i = 0; i < buckets.GetNumberOfNeighbors(); i++)
   {
@@ -1809,6 +1843,34 @@ void BucketList<TIds>::GenerateRepresentation(int vtkNotUsed(level), vtkPolyData
   pd->Squeeze();
 }
 
+//------------------------------------------------------------------------------
+// The neighbor graph of the points of the dataset, cached by the locator with
+// the query which built it.
+struct vtkNeighborGraph
+{
+  enum
+  {
+    NO_GRAPH,
+    CLOSEST_N_POINTS,
+    POINTS_WITHIN_RADIUS
+  };
+
+  int Type = NO_GRAPH;
+  int N = 0;
+  bool Approximate = false;
+  double Radius = 0.0;
+  vtkTimeStamp BuildTime;
+  vtkNew<vtkIdTypeArray> Offsets;
+  vtkNew<vtkIdTypeArray> Ids;
+
+  void Initialize()
+  {
+    this->Type = NO_GRAPH;
+    this->Offsets->Initialize();
+    this->Ids->Initialize();
+  }
+};
+
 //------------------------------------------------------------------------------
 // Here is the VTK class proper. It's implemented with the templated
 // BucketList class.
@@ -1825,12 +1887,16 @@ vtkStaticPointLocator::vtkStaticPointLocator()
   this->MaxNumberOfBuckets = VTK_INT_MAX;
   this->LargeIds = false;
   this->TraversalOrder = BIN_ORDER;
+  this->UseNeighborGraph = false;
+  this->ApproximateNeighborGraph = false;
+  this->NeighborGraph = new vtkNeighborGraph;
 }
 
 //------------------------------------------------------------------------------
 vtkStaticPointLocator::~vtkStaticPointLocator()
 {
   this->FreeSearchStructure();
+  delete this->NeighborGraph;
 }
 
 //------------------------------------------------------------------------------
@@ -1847,6 +1913,7 @@ void vtkStaticPointLocator::FreeSearchStructure()
     delete this->Buckets;
     this->Buckets = nullptr;
   }
+  this->NeighborGraph->Initialize();
 }
 
 //------------------------------------------------------------------------------
@@ -2110,6 +2177,28 @@ void vtkStaticPointLocator::FindClosestNPoints(int N, const double x[3], vtkIdLi
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindApproximateClosestNPoints(
+  int N, const double x[3], vtkIdList* result)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    return;
+  }
+
+  ClosestNPointsScratch scratch;
+  if (this->LargeIds)
+  {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)
+      ->FindClosestNPoints(N, x, result, scratch, true);
+  }
+  else
+  {
+    static_cast<BucketList<int>*>(this->Buckets)->FindClosestNPoints(N, x, result, scratch, true);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3], vtkIdList* result)
 {
@@ -2129,6 +2218,226 @@ void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3],
   }
 }
 
+//------------------------------------------------------------------------------
+// The batched queries search the buckets directly, each thread reusing its
+// working memory.
+namespace
+{
+template <typename TIds>
+void BatchFindClosestNPoints(BucketList<TIds>* buckets, int N, vtkPoints* queries,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  vtkSMPThreadLocal<ClosestNPointsScratch> scratch;
+  vtkLocatorBatchQuery::Execute(
+    queries->GetNumberOfPoints(),
+    [buckets, N, queries, &scratch](vtkIdType q, vtkIdList* result) {
+      double x[3];
+      queries->GetPoint(q, x);
+      buckets->FindClosestNPoints(N, x, result, scratch.Local());
+    },
+    offsets, ids);
+}
+
+template <typename TIds>
+void BatchFindPointsWithinRadius(BucketList<TIds>* buckets, double R, vtkPoints* queries,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  vtkLocatorBatchQuery::Execute(
+    queries->GetNumberOfPoints(),
+    [buckets, R, queries](vtkIdType q, vtkIdList* result) {
+      double x[3];
+      queries->GetPoint(q, x);
+      buckets->FindPointsWithinRadius(R, x, result);
+    },
+    offsets, ids);
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::BatchFindClosestNPoints(
+  int N, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    // no points: every query finds nothing
+    offsets->SetNumberOfValues(queries->GetNumberOfPoints() + 1);
+    offsets->FillValue(0);
+    ids->SetNumberOfValues(0);
+    return;
+  }
+
+  if (this->LargeIds)
+  {
+    ::BatchFindClosestNPoints(
+      static_cast<BucketList<vtkIdType>*>(this->Buckets), N, queries, offsets, ids);
+  }
+  else
+  {
+    ::BatchFindClosestNPoints(
+      static_cast<BucketList<int>*>(this->Buckets), N, queries, offsets, ids);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::BatchFindPointsWithinRadius(
+  double R, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    offsets->SetNumberOfValues(queries->GetNumberOfPoints() + 1);
+    offsets->FillValue(0);
+    ids->SetNumberOfValues(0);
+    return;
+  }
+
+  if (this->LargeIds)
+  {
+    ::BatchFindPointsWithinRadius(
+      static_cast<BucketList<vtkIdType>*>(this->Buckets), R, queries, offsets, ids);
+  }
+  else
+  {
+    ::BatchFindPointsWithinRadius(
+      static_cast<BucketList<int>*>(this->Buckets), R, queries, offsets, ids);
+  }
+}
+
+//------------------------------------------------------------------------------
+// The neighbor graphs query the buckets with the points of the dataset. Every
+// point has the same number of closest points, so their lists are written in
+// place.
+namespace
+{
+template <typename TIds>
+void BuildClosestNPointsGraph(BucketList<TIds>* buckets, vtkDataSet* dataSet, int N,
+  bool approximate, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  const vtkIdType numPts = dataSet->GetNumberOfPoints();
+  const vtkIdType numNeighbors = std::min<vtkIdType>(std::max(N, 0), numPts);
+  offsets->SetNumberOfValues(numPts + 1);
+  ids->SetNumberOfValues(numPts * numNeighbors);
+  vtkIdType* offs = offsets->GetPointer(0);
+  vtkIdType* neighbors = ids->GetPointer(0);
+
+  vtkSMPThreadLocal<ClosestNPointsScratch> scratch;
+  vtkSMPThreadLocalObject<vtkIdList> lists;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    ClosestNPointsScratch& localScratch = scratch.Local();
+    vtkIdList* list = lists.Local();
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      offs[ptId] = ptId * numNeighbors;
+      if (numNeighbors > 0)
+      {
+        dataSet->GetPoint(ptId, x);
+        buckets->FindClosestNPoints(N, x, list, localScratch, approximate);
+        std::copy_n(list->GetPointer(0), numNeighbors, neighbors + offs[ptId]);
+      }
+    }
+  });
+  offs[numPts] = numPts * numNeighbors;
+}
+
+template <typename TIds>
+void BuildPointsWithinRadiusGraph(BucketList<TIds>* buckets, vtkDataSet* dataSet, double R,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  vtkLocatorBatchQuery::Execute(
+    dataSet->GetNumberOfPoints(),
+    [buckets, dataSet, R](vtkIdType ptId, vtkIdList* result) {
+      double x[3];
+      dataSet->GetPoint(ptId, x);
+      buckets->FindPointsWithinRadius(R, x, result);
+    },
+    offsets, ids);
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::BuildClosestNPointsGraph(int N)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  // Reuse the graph of at least N points built since the locator, unless it
+  // is approximate and an exact graph is requested.
+  vtkNeighborGraph* graph = this->NeighborGraph;
+  const bool approximate = this->ApproximateNeighborGraph != 0;
+  if (graph->Type == vtkNeighborGraph::CLOSEST_N_POINTS && graph->N >= N &&
+    (approximate || !graph->Approximate) && graph->BuildTime > this->BuildTime)
+  {
+    return;
+  }
+
+  if (!this->Buckets)
+  {
+    graph->Initialize();
+    return;
+  }
+
+  if (this->LargeIds)
+  {
+    ::BuildClosestNPointsGraph(static_cast<BucketList<vtkIdType>*>(this->Buckets), this->DataSet,
+      N, approximate, graph->Offsets, graph->Ids);
+  }
+  else
+  {
+    ::BuildClosestNPointsGraph(static_cast<BucketList<int>*>(this->Buckets), this->DataSet, N,
+      approximate, graph->Offsets, graph->Ids);
+  }
+  graph->Type = vtkNeighborGraph::CLOSEST_N_POINTS;
+  graph->N = N;
+  graph->Approximate = approximate;
+  graph->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::BuildPointsWithinRadiusGraph(double R)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  vtkNeighborGraph* graph = this->NeighborGraph;
+  if (graph->Type == vtkNeighborGraph::POINTS_WITHIN_RADIUS && graph->Radius == R &&
+    graph->BuildTime > this->BuildTime)
+  {
+    return;
+  }
+
+  if (!this->Buckets)
+  {
+    graph->Initialize();
+    return;
+  }
+
+  if (this->LargeIds)
+  {
+    ::BuildPointsWithinRadiusGraph(static_cast<BucketList<vtkIdType>*>(this->Buckets),
+      this->DataSet, R, graph->Offsets, graph->Ids);
+  }
+  else
+  {
+    ::BuildPointsWithinRadiusGraph(
+      static_cast<BucketList<int>*>(this->Buckets), this->DataSet, R, graph->Offsets, graph->Ids);
+  }
+  graph->Type = vtkNeighborGraph::POINTS_WITHIN_RADIUS;
+  graph->Radius = R;
+  graph->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+vtkIdTypeArray* vtkStaticPointLocator::GetNeighborGraphOffsets()
+{
+  return this->NeighborGraph->Offsets;
+}
+
+//------------------------------------------------------------------------------
+vtkIdTypeArray* vtkStaticPointLocator::GetNeighborGraphIds()
+{
+  return this->NeighborGraph->Ids;
+}
+
 //------------------------------------------------------------------------------
 // This method traverses the locator along the defined ray, finding the
 // closest point to a0 when projected onto the line (a0,a1) (i.e., min
@@ -2253,4 +2562,9 @@ void vtkStaticPointLocator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Large IDs: " << this->LargeIds << "\n";
 
   os << indent << "Traversal Order: " << (this->TraversalOrder ? "On\n" : "Off\n");
+
+  os << indent << "Use Neighbor Graph: " << (this->UseNeighborGraph ? "On\n" : "Off\n");
+
+  os << indent
+     << "Approximate Neighbor Graph: " << (this->ApproximateNeighborGraph ? "On\n" : "Off\n");
 }
@@ -61,7 +61,10 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 struct vtkBucketList;
+struct vtkNeighborGraph;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkStaticPointLocator : public vtkAbstractPointLocator
 {
@@ -141,6 +144,16 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result) override;
 
+  /**
+   * Find N close points to a position, faster than FindClosestNPoints(): the
+   * buckets are searched in rings of increasing size around the position
+   * until N points are found, but the buckets beyond the last ring, which may
+   * hold closer points, are not searched. The returned points are sorted from
+   * closest to farthest. This method is thread safe if BuildLocator() is
+   * directly or indirectly called from a single thread first.
+   */
+  void FindApproximateClosestNPoints(int N, const double x[3], vtkIdList* result);
+
   /**
    * Find all points within a specified radius R of position x.
    * The result is not sorted in any specific manner.
@@ -149,6 +162,70 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  ///@{
+  /**
+   * Batched forms of FindClosestNPoints() and FindPointsWithinRadius(), see
+   * vtkAbstractPointLocator. The locator is built once, then the buckets are
+   * searched directly in parallel, each thread reusing its working memory.
+   */
+  void BatchFindClosestNPoints(
+    int N, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  void BatchFindPointsWithinRadius(
+    double R, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+  ///@}
+
+  ///@{
+  /**
+   * Build the neighbor graph of the points of the dataset: the neighbors of
+   * each point are the N closest points returned by FindClosestNPoints() (or
+   * by FindApproximateClosestNPoints() if ApproximateNeighborGraph is on),
+   * including the point itself, or the points within radius R returned by
+   * FindPointsWithinRadius(). The graph is computed in parallel and cached
+   * in the locator until the locator is rebuilt, so filters sharing the
+   * locator share the graph. A graph of the N closest points is also reused
+   * for fewer points: since the neighbors are sorted by distance, the first
+   * ones of each point are its closest points. These methods are not thread
+   * safe.
+   */
+  void BuildClosestNPointsGraph(int N);
+  void BuildPointsWithinRadiusGraph(double R);
+  ///@}
+
+  ///@{
+  /**
+   * Return the neighbor graph last built, in the compressed form of the
+   * batched queries: the neighbors of point i are ids[offsets[i]] to
+   * ids[offsets[i + 1] - 1]. The arrays belong to the locator.
+   */
+  vtkIdTypeArray* GetNeighborGraphOffsets();
+  vtkIdTypeArray* GetNeighborGraphIds();
+  ///@}
+
+  ///@{
+  /**
+   * Indicate whether the filters retrieving the neighbors of every point of
+   * the dataset, such as vtkPCANormalEstimation, vtkPCACurvatureEstimation,
+   * vtkStatisticalOutlierRemoval and vtkEuclideanClusterExtraction, take
+   * them from the neighbor graph of the locator instead of querying the
+   * locator for each point. The graph stores the neighbors of all the
+   * points, so this is off by default.
+   */
+  vtkSetMacro(UseNeighborGraph, vtkTypeBool);
+  vtkGetMacro(UseNeighborGraph, vtkTypeBool);
+  vtkBooleanMacro(UseNeighborGraph, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Build the graph of the N closest points with
+   * FindApproximateClosestNPoints(), which is faster but does not always
+   * find the closest points. Off by default.
+   */
+  vtkSetMacro(ApproximateNeighborGraph, vtkTypeBool);
+  vtkGetMacro(ApproximateNeighborGraph, vtkTypeBool);
+  vtkBooleanMacro(ApproximateNeighborGraph, vtkTypeBool);
+  ///@}
+
   /**
    * Intersect the points contained in the locator with the line defined by
    * (a0,a1). Return the point within the tolerance tol that is closest to a0
@@ -290,6 +367,9 @@ protected:
   vtkIdType MaxNumberOfBuckets; // Maximum number of buckets in locator
   bool LargeIds;                // indicate whether integer ids are small or large
   int TraversalOrder;           // Control traversal order when threading
+  vtkTypeBool UseNeighborGraph;         // Let the filters use the neighbor graph
+  vtkTypeBool ApproximateNeighborGraph; // Approximate graph of the N closest points
+  vtkNeighborGraph* NeighborGraph;      // The cached neighbor graph
 
 private:
   vtkStaticPointLocator(const vtkStaticPointLocator&) = delete;
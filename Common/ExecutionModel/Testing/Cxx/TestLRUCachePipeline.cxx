@@ -0,0 +1,235 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLRUCachePipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLRUCachePipeline.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+// Source of a point cloud with (time + 1) * 1000 points.
+class TemporalSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TemporalSource* New();
+  vtkTypeMacro(TemporalSource, vtkPolyDataAlgorithm);
+
+  std::atomic<int> NumberOfExecutions{ 0 };
+  // Duration of an execution in milliseconds.
+  int Delay = 0;
+
+protected:
+  TemporalSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector* outInfoVec)
+    override
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(0);
+    double steps[5] = { 0, 1, 2, 3, 4 };
+    double range[2] = { 0, 4 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 5);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outInfoVec) override
+  {
+    ++this->NumberOfExecutions;
+    std::this_thread::sleep_for(std::chrono::milliseconds(this->Delay));
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkIdType numberOfPoints = static_cast<vtkIdType>(time + 1) * 1000;
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      points->InsertNextPoint(i, time, 0);
+      verts->InsertNextCell(1, &i);
+    }
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TemporalSource);
+
+bool CheckOutput(vtkAlgorithm* algorithm, double time)
+{
+  vtkPolyData* output = vtkPolyData::SafeDownCast(algorithm->GetOutputDataObject(0));
+  vtkIdType expected = static_cast<vtkIdType>(time + 1) * 1000;
+  if (!output || output->GetNumberOfPoints() != expected ||
+    output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != time)
+  {
+    std::cerr << "Wrong output of " << algorithm->GetClassName() << " at time " << time
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckStatistics(vtkLRUCachePipeline* cache, TemporalSource* source, int executions,
+  vtkIdType hits, vtkIdType misses, const char* step)
+{
+  if (source->NumberOfExecutions != executions || cache->GetNumberOfHits() != hits ||
+    cache->GetNumberOfMisses() != misses)
+  {
+    std::cerr << step << ": " << source->NumberOfExecutions << " executions, "
+              << cache->GetNumberOfHits() << " hits, " << cache->GetNumberOfMisses()
+              << " misses, expected " << executions << ", " << hits << ", " << misses
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestLRUCachePipeline(int, char*[])
+{
+  vtkNew<TemporalSource> source;
+  vtkNew<vtkLRUCachePipeline> cache;
+  source->SetExecutive(cache);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+
+  // The second loop over the time steps is served from the cache.
+  for (int loop = 0; loop < 2; ++loop)
+  {
+    for (int t = 0; t < 5; ++t)
+    {
+      elevation->UpdateTimeStep(t);
+      if (!CheckOutput(source, t) || !CheckOutput(elevation, t))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (!CheckStatistics(cache, source, 5, 5, 5, "Time loop") ||
+    cache->GetNumberOfCachedOutputs() != 5)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Requesting the same time step twice does not use the cache.
+  cache->ResetStatistics();
+  source->NumberOfExecutions = 0;
+  elevation->UpdateTimeStep(4);
+  if (!CheckStatistics(cache, source, 0, 0, 0, "Same time step"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the source discards the cached outputs.
+  source->Modified();
+  elevation->UpdateTimeStep(0);
+  elevation->UpdateTimeStep(4);
+  if (!CheckStatistics(cache, source, 2, 0, 2, "Modified source") ||
+    cache->GetNumberOfCachedOutputs() != 2 || !CheckOutput(elevation, 4))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // With a budget of one and a half times the largest output, the least
+  // recently used outputs are evicted.
+  cache->ClearCache();
+  cache->ResetStatistics();
+  source->NumberOfExecutions = 0;
+  elevation->UpdateTimeStep(2);
+  const unsigned long size = cache->GetCacheMemorySize();
+  cache->SetCacheMemoryLimit(size * 3 / 2);
+  elevation->UpdateTimeStep(0);
+  elevation->UpdateTimeStep(1);
+  elevation->UpdateTimeStep(0);
+  elevation->UpdateTimeStep(2);
+  if (!CheckStatistics(cache, source, 4, 1, 4, "Memory budget") ||
+    cache->GetCacheMemorySize() > cache->GetCacheMemoryLimit() || !CheckOutput(elevation, 2))
+  {
+    std::cerr << "Cache memory: " << cache->GetCacheMemorySize() << " KiB for a budget of "
+              << cache->GetCacheMemoryLimit() << " KiB" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The next time step is generated in the background.
+  cache->SetCacheMemoryLimit(1048576);
+  cache->ClearCache();
+  cache->ResetStatistics();
+  cache->PrefetchNextTimeStepOn();
+  source->NumberOfExecutions = 0;
+  elevation->UpdateTimeStep(3);
+  cache->WaitForPrefetch();
+  if (cache->GetNumberOfPrefetches() != 1 || source->NumberOfExecutions != 2 ||
+    !CheckOutput(elevation, 3))
+  {
+    std::cerr << "Wrong prefetch: " << cache->GetNumberOfPrefetches() << " prefetches, "
+              << source->NumberOfExecutions << " executions" << std::endl;
+    return EXIT_FAILURE;
+  }
+  elevation->UpdateTimeStep(4);
+  cache->WaitForPrefetch();
+  if (cache->GetNumberOfHits() != 1 || !CheckOutput(elevation, 4) || !CheckOutput(source, 4))
+  {
+    std::cerr << "The prefetched time step was not used." << std::endl;
+    return EXIT_FAILURE;
+  }
+  // The prefetch loops to the first time step.
+  elevation->UpdateTimeStep(0);
+  cache->WaitForPrefetch();
+  if (cache->GetNumberOfHits() != 2 || !CheckOutput(elevation, 0))
+  {
+    std::cerr << "The first time step was not prefetched." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Requests made while the prefetch is running wait for it, and the
+  // prefetch does not modify the outputs being read.
+  cache->ClearCache();
+  cache->ResetStatistics();
+  source->Delay = 100;
+  for (int t = 1; t < 5; ++t)
+  {
+    elevation->UpdateTimeStep(t);
+    if (!CheckOutput(source, t) || !CheckOutput(elevation, t))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (cache->GetNumberOfMisses() != 1 || cache->GetNumberOfHits() != 3 ||
+    cache->GetNumberOfPrefetches() != 4)
+  {
+    std::cerr << "Wrong statistics with a running prefetch: " << cache->GetNumberOfMisses()
+              << " misses, " << cache->GetNumberOfHits() << " hits, "
+              << cache->GetNumberOfPrefetches() << " prefetches" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+class ProfiledSource : public vtkPolyDataAlgorithm
+{
+public:
+  static ProfiledSource* New();
+  vtkTypeMacro(ProfiledSource, vtkPolyDataAlgorithm);
+
+protected:
+  ProfiledSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outInfo) override
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    for (vtkIdType i = 0; i < 10000; ++i)
+    {
+      points->InsertNextPoint(i, 0, 0);
+      verts->InsertNextCell(1, &i);
+    }
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    return 1;
+  }
+};
+vtkStandardNewMacro(ProfiledSource);
+
+int CountOccurrences(const std::string& text, const std::string& pattern)
+{
+  int count = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + pattern.size()))
+  {
+    ++count;
+  }
+  return count;
+}
+
+std::string ChromeTrace()
+{
+  std::ostringstream trace;
+  vtkPipelineProfiler::WriteChromeTrace(trace);
+  return trace.str();
+}
+}
+
+//------------------------------------------------------------------------------
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<ProfiledSource> source;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+
+  vtkPipelineProfiler::Clear();
+  vtkPipelineProfiler::SetEnabled(true);
+  elevation->Update();
+
+  std::string trace = ChromeTrace();
+  if (trace.find("\"traceEvents\"") == std::string::npos ||
+    CountOccurrences(trace, "\"cat\":\"REQUEST_INFORMATION\"") != 2 ||
+    CountOccurrences(trace, "\"cat\":\"REQUEST_DATA\"") != 2 ||
+    CountOccurrences(trace, "\"reason\":\"first\"") != 2)
+  {
+    std::cerr << "Wrong trace of the first update:\n" << trace << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (CountOccurrences(trace, "\"output_bytes\":0,") != 0)
+  {
+    std::cerr << "Missing output memory:\n" << trace << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Only the modified filter executes.
+  vtkPipelineProfiler::Clear();
+  elevation->SetLowPoint(-1, 0, 0);
+  elevation->Update();
+  trace = ChromeTrace();
+  if (CountOccurrences(trace, "\"reason\":") != 1 ||
+    CountOccurrences(trace, "\"reason\":\"modified\"") != 1)
+  {
+    std::cerr << "Wrong trace after modifying the filter:\n" << trace << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The filter executes because its input changed.
+  vtkPipelineProfiler::Clear();
+  source->Modified();
+  elevation->Update();
+  trace = ChromeTrace();
+  if (CountOccurrences(trace, "\"reason\":\"modified\"") != 1 ||
+    CountOccurrences(trace, "\"reason\":\"input\"") != 1)
+  {
+    std::cerr << "Wrong trace after modifying the source:\n" << trace << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A new piece is requested, nothing was modified.
+  vtkPipelineProfiler::Clear();
+  elevation->UpdatePiece(0, 2, 0);
+  trace = ChromeTrace();
+  if (CountOccurrences(trace, "\"reason\":\"request\"") < 1)
+  {
+    std::cerr << "Missing re-execution on request:\n" << trace << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::ostringstream summary;
+  vtkPipelineProfiler::PrintSummary(summary);
+  if (summary.str().find("vtkElevationFilter") == std::string::npos ||
+    summary.str().find("without algorithm or input change: 1") == std::string::npos)
+  {
+    std::cerr << "Wrong summary:\n" << summary.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << summary.str();
+
+  // Nothing is recorded once disabled.
+  vtkPipelineProfiler::Clear();
+  vtkPipelineProfiler::SetEnabled(false);
+  source->Modified();
+  elevation->Update();
+  if (vtkPipelineProfiler::GetNumberOfEvents() != 0)
+  {
+    std::cerr << "Events recorded while disabled." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The process CPU time increases with the work done.
+  const double cpuTime = vtkPipelineProfiler::GetProcessCPUTime();
+  volatile double sum = 0.0;
+  for (int i = 0; i < 100000 && vtkPipelineProfiler::GetProcessCPUTime() == cpuTime; ++i)
+  {
+    for (int j = 0; j < 10000; ++j)
+    {
+      sum = sum + j;
+    }
+  }
+  if (cpuTime <= 0.0 || vtkPipelineProfiler::GetProcessCPUTime() <= cpuTime)
+  {
+    std::cerr << "Wrong process CPU time." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTaskGraphPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCleanPolyData.h"
+#include "vtkCollection.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMaskPoints.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkTaskGraphPipeline.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Source of a grid of vertices counting its executions.
+class CountingSource : public vtkPolyDataAlgorithm
+{
+public:
+  static CountingSource* New();
+  vtkTypeMacro(CountingSource, vtkPolyDataAlgorithm);
+
+  std::atomic<int> NumberOfExecutions{ 0 };
+
+protected:
+  CountingSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outInfo) override
+  {
+    ++this->NumberOfExecutions;
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    for (vtkIdType i = 0; i < 1000; ++i)
+    {
+      points->InsertNextPoint(i % 10, (i / 10) % 10, i / 100);
+      verts->InsertNextCell(1, &i);
+    }
+    output->SetPoints(points);
+    output->SetVerts(verts);
+    return 1;
+  }
+};
+vtkStandardNewMacro(CountingSource);
+
+#define CHECK(condition, message)                                                                  \
+  if (!(condition))                                                                                \
+  {                                                                                                \
+    std::cerr << message << std::endl;                                                             \
+    return false;                                                                                  \
+  }
+
+//------------------------------------------------------------------------------
+// A source feeding three independent branches which are appended together.
+bool TestDiamond()
+{
+  vtkNew<CountingSource> source;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputConnection(source->GetOutputPort());
+  vtkNew<vtkMaskPoints> mask;
+  mask->SetInputConnection(source->GetOutputPort());
+  mask->SetOnRatio(2);
+  mask->RandomModeOff();
+  mask->GenerateVerticesOn();
+  mask->GetInformation()->Set(vtkTaskGraphPipeline::NON_REENTRANT(), 1);
+
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputConnection(elevation->GetOutputPort());
+  append->AddInputConnection(clean->GetOutputPort());
+  append->AddInputConnection(mask->GetOutputPort());
+  append->Update();
+
+  vtkTaskGraphPipeline* executive = vtkTaskGraphPipeline::SafeDownCast(append->GetExecutive());
+  CHECK(executive, "The default executive prototype was not used.");
+  CHECK(source->NumberOfExecutions == 1,
+    "The shared source executed " << source->NumberOfExecutions << " times.");
+  CHECK(append->GetOutput()->GetNumberOfPoints() == 2500,
+    "Wrong number of points: " << append->GetOutput()->GetNumberOfPoints());
+  CHECK(executive->GetNumberOfTasks() == 4,
+    "Wrong number of tasks: " << executive->GetNumberOfTasks());
+  CHECK(executive->GetCriticalPathLength() == 2,
+    "Wrong critical path length: " << executive->GetCriticalPathLength());
+  CHECK(executive->GetCriticalPathTime() <= executive->GetTotalTaskTime(),
+    "The critical path is longer than the whole graph.");
+
+  // Nothing is executed again when the pipeline is up to date.
+  append->Update();
+  CHECK(source->NumberOfExecutions == 1, "The up to date source executed again.");
+
+  source->Modified();
+  append->Update();
+  CHECK(source->NumberOfExecutions == 2, "The modified source did not execute once.");
+  CHECK(append->GetOutput()->GetNumberOfPoints() == 2500, "Wrong number of points after update.");
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Several sinks updated with a single graph.
+bool TestUpdateAlgorithms()
+{
+  vtkNew<CountingSource> source;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(source->GetOutputPort());
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputConnection(source->GetOutputPort());
+  vtkNew<vtkCleanPolyData> cleanElevation;
+  cleanElevation->SetInputConnection(elevation->GetOutputPort());
+
+  vtkNew<vtkCollection> sinks;
+  sinks->AddItem(clean);
+  sinks->AddItem(cleanElevation);
+
+  vtkNew<vtkTaskGraphPipeline> scheduler;
+  CHECK(scheduler->UpdateAlgorithms(sinks), "UpdateAlgorithms() failed.");
+  CHECK(source->NumberOfExecutions == 1,
+    "The shared source executed " << source->NumberOfExecutions << " times.");
+  CHECK(clean->GetOutput()->GetNumberOfPoints() == 1000 &&
+      cleanElevation->GetOutput()->GetNumberOfPoints() == 1000,
+    "Wrong number of points in the sinks.");
+  CHECK(cleanElevation->GetOutput()->GetPointData()->GetArray("Elevation"),
+    "The elevation branch was not executed.");
+  CHECK(scheduler->GetNumberOfTasks() == 4,
+    "Wrong number of tasks: " << scheduler->GetNumberOfTasks());
+  // The critical path depends on the execution times of the two branches.
+  CHECK(scheduler->GetCriticalPathLength() == 2 || scheduler->GetCriticalPathLength() == 3,
+    "Wrong critical path length: " << scheduler->GetCriticalPathLength());
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestTaskGraphPipeline(int, char*[])
+{
+  vtkNew<vtkTaskGraphPipeline> prototype;
+  vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+
+  bool success = TestDiamond() && TestUpdateAlgorithms();
+
+  vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,187 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    UnitTestSpanSpace.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpanSpace.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int Dim = 24;
+
+float Scalar(int i, int j, int k)
+{
+  return static_cast<float>(std::sin(0.3 * i) * std::cos(0.2 * j) + 0.05 * k);
+}
+
+void MakeScalars(vtkDataSet* ds)
+{
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(Dim * Dim * Dim);
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        scalars->SetValue(i + Dim * (j + Dim * k), Scalar(i, j, k));
+      }
+    }
+  }
+  ds->GetPointData()->SetScalars(scalars);
+}
+
+// Unstructured grid of hexahedra with the points of a Dim^3 lattice.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate((Dim - 1) * (Dim - 1) * (Dim - 1));
+  for (int k = 0; k < Dim - 1; ++k)
+  {
+    for (int j = 0; j < Dim - 1; ++j)
+    {
+      for (int i = 0; i < Dim - 1; ++i)
+      {
+        vtkIdType p = i + Dim * (j + Dim * k);
+        vtkIdType pts[8] = { p, p + 1, p + 1 + Dim, p + Dim, p + Dim * Dim, p + 1 + Dim * Dim,
+          p + 1 + Dim + Dim * Dim, p + Dim + Dim * Dim };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+      }
+    }
+  }
+  MakeScalars(grid);
+  return grid;
+}
+
+// Check that the batches hold each cell spanning the value exactly once.
+bool CheckBatches(vtkSpanSpace* tree, vtkDataSet* ds, double value)
+{
+  vtkDataArray* scalars = ds->GetPointData()->GetScalars();
+  std::vector<int> found(ds->GetNumberOfCells(), 0);
+  vtkIdType numBatches = tree->GetNumberOfCellBatches(value);
+  for (vtkIdType batch = 0; batch < numBatches; ++batch)
+  {
+    vtkIdType numCells;
+    const vtkIdType* cellIds = tree->GetCellBatch(batch, numCells);
+    for (vtkIdType i = 0; i < numCells; ++i)
+    {
+      ++found[cellIds[i]];
+    }
+  }
+
+  vtkNew<vtkIdList> cellPts;
+  vtkIdType numSpanning = 0;
+  for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
+  {
+    if (found[cellId] > 1)
+    {
+      std::cerr << "Cell " << cellId << " found " << found[cellId] << " times" << std::endl;
+      return false;
+    }
+    ds->GetCellPoints(cellId, cellPts);
+    double sMin = VTK_DOUBLE_MAX;
+    double sMax = VTK_DOUBLE_MIN;
+    for (vtkIdType i = 0; i < cellPts->GetNumberOfIds(); ++i)
+    {
+      double s = scalars->GetTuple1(cellPts->GetId(i));
+      sMin = std::min(sMin, s);
+      sMax = std::max(sMax, s);
+    }
+    if (sMin <= value && value <= sMax)
+    {
+      ++numSpanning;
+      if (!found[cellId])
+      {
+        std::cerr << "Cell " << cellId << " spanning " << value << " not found" << std::endl;
+        return false;
+      }
+    }
+  }
+  if (numSpanning == 0)
+  {
+    std::cerr << "No cell spans " << value << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestDataSet(vtkDataSet* ds, const char* name)
+{
+  vtkNew<vtkSpanSpace> tree;
+  tree->SetDataSet(ds);
+  tree->SetBatchSize(137);
+  for (double value = -0.8; value < 1.8; value += 0.25)
+  {
+    if (!CheckBatches(tree, ds, value))
+    {
+      std::cerr << "Wrong batches of " << name << " for " << value << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int UnitTestSpanSpace(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid();
+  if (!TestDataSet(grid, "64-bit unstructured grid"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  grid->GetCells()->ConvertTo32BitStorage();
+  if (!TestDataSet(grid, "32-bit unstructured grid"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dim, Dim, Dim);
+  MakeScalars(image);
+  if (!TestDataSet(image, "image"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -33,6 +33,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkPointData.h"
 
 #include <vector>
@@ -258,7 +259,12 @@ vtkTypeBool vtkDemandDrivenPipeline::ProcessRequest(
 
       // Request data from the algorithm.
       vtkLogF(TRACE, "%s execute-data", vtkLogIdentifier(this->Algorithm));
+      if (vtkPipelineProfiler::GetEnabled())
+      {
+        this->ExecutionReason = this->GetExecutionReason(inInfoVec);
+      }
       result = this->ExecuteData(request, inInfoVec, outInfoVec);
+      this->ExecutionReason = nullptr;
 
       // Data are now up to date.
       this->DataTime.Modified();
@@ -1020,6 +1026,34 @@ int vtkDemandDrivenPipeline ::NeedToExecuteData(
   return 0;
 }
 
+//------------------------------------------------------------------------------
+const char* vtkDemandDrivenPipeline::GetExecutionReason(vtkInformationVector** inInfoVec)
+{
+  if (this->DataTime.GetMTime() == 0)
+  {
+    return "first";
+  }
+  if (this->Algorithm->GetMTime() > this->DataTime.GetMTime())
+  {
+    return "modified";
+  }
+  for (int i = 0; i < this->Algorithm->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < inInfoVec[i]->GetNumberOfInformationObjects(); ++j)
+    {
+      vtkInformation* info = inInfoVec[i]->GetInformationObject(j);
+      vtkDataObject* input = info->Get(vtkDataObject::DATA_OBJECT());
+      if (input && input->GetMTime() > this->DataTime.GetMTime())
+      {
+        return "input";
+      }
+    }
+  }
+  // Neither the algorithm nor its inputs changed: the request or the
+  // pipeline information did.
+  return "request";
+}
+
 //------------------------------------------------------------------------------
 int vtkDemandDrivenPipeline::SetReleaseDataFlag(int port, int n)
 {
@@ -205,6 +205,10 @@ protected:
   virtual int NeedToExecuteData(
     int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec);
 
+  // Describe why the output data are generated again, for
+  // vtkPipelineProfiler.
+  const char* GetExecutionReason(vtkInformationVector** inInfoVec);
+
   // Handle before/after operations for ExecuteData method.
   virtual void ExecuteDataStart(
     vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec);
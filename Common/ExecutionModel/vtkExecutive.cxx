@@ -26,7 +26,9 @@
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
 
 #include <sstream>
 #include <vector>
@@ -118,6 +120,7 @@ vtkExecutive::vtkExecutive()
   this->OutputInformation = vtkInformationVector::New();
   this->Algorithm = nullptr;
   this->InAlgorithm = 0;
+  this->ExecutionReason = nullptr;
   this->SharedInputInformation = nullptr;
   this->SharedOutputInformation = nullptr;
 }
@@ -742,9 +745,17 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  const bool profile = vtkPipelineProfiler::GetEnabled();
+  const double startTime = profile ? vtkTimerLog::GetUniversalTime() : 0.0;
+  const double startCPUTime = profile ? vtkPipelineProfiler::GetProcessCPUTime() : 0.0;
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
+  if (profile)
+  {
+    vtkPipelineProfiler::RecordAlgorithmCall(
+      this->Algorithm, request, outInfo, this->ExecutionReason, startTime, startCPUTime);
+  }
 
   // If the algorithm failed report it now.
   if (!result)
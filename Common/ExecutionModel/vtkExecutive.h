@@ -268,6 +268,10 @@ protected:
   // Flag set when the algorithm is processing a request.
   int InAlgorithm;
 
+  // Why the algorithm is executing REQUEST_DATA, recorded by
+  // vtkPipelineProfiler. Set by the executive around the data request.
+  const char* ExecutionReason;
+
   // Pointers to an outside instance of input or output information.
   // No references are held.  These are used to implement internal
   // pipelines.
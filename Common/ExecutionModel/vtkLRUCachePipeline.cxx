@@ -0,0 +1,483 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLRUCachePipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLRUCachePipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <list>
+#include <mutex>
+#include <thread>
+
+vtkStandardNewMacro(vtkLRUCachePipeline);
+
+//------------------------------------------------------------------------------
+class vtkLRUCachePipeline::vtkInternals
+{
+public:
+  // A cached output and the request it was generated for.
+  struct Entry
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    int Port;
+    bool HasTime;
+    double Time;
+    int Piece;
+    int NumberOfPieces;
+    int GhostLevels;
+    bool HasExtent;
+    int Extent[6];
+    unsigned long Size;
+    vtkMTimeType PipelineMTime;
+  };
+
+  // Most recently used first.
+  std::list<Entry> Entries;
+  unsigned long MemorySize = 0;
+
+  vtkIdType NumberOfHits = 0;
+  vtkIdType NumberOfMisses = 0;
+  vtkIdType NumberOfPrefetches = 0;
+
+  // Held while processing a request or prefetching. The prefetch thread is
+  // only joined without holding it, since the thread needs it to finish.
+  std::recursive_mutex Mutex;
+  std::thread PrefetchThread;
+  // Set before the prefetch thread starts and reset once it is done, so that
+  // the executions of the thread are counted as prefetches.
+  bool Prefetching = false;
+
+  // The key of the output requested by the given output information.
+  static Entry MakeKey(int port, vtkInformation* outInfo)
+  {
+    Entry key;
+    key.Port = port;
+    // Only time dependent outputs are keyed on the time.
+    key.HasTime = outInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_RANGE()) &&
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    key.Time =
+      key.HasTime ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) : 0.0;
+    key.Piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    key.NumberOfPieces = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    key.GhostLevels =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    key.HasExtent = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) != 0;
+    if (key.HasExtent)
+    {
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), key.Extent);
+    }
+    key.Size = 0;
+    key.PipelineMTime = 0;
+    return key;
+  }
+
+  static bool SameKey(const Entry& a, const Entry& b)
+  {
+    if (a.Port != b.Port || a.HasTime != b.HasTime || (a.HasTime && a.Time != b.Time) ||
+      a.Piece != b.Piece || a.NumberOfPieces != b.NumberOfPieces ||
+      a.GhostLevels != b.GhostLevels || a.HasExtent != b.HasExtent)
+    {
+      return false;
+    }
+    for (int i = 0; a.HasExtent && i < 6; ++i)
+    {
+      if (a.Extent[i] != b.Extent[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::list<Entry>::iterator Find(const Entry& key)
+  {
+    for (auto it = this->Entries.begin(); it != this->Entries.end(); ++it)
+    {
+      if (SameKey(*it, key))
+      {
+        return it;
+      }
+    }
+    return this->Entries.end();
+  }
+
+  // Discard the outputs generated before the pipeline was modified.
+  void Invalidate(vtkMTimeType pipelineMTime)
+  {
+    for (auto it = this->Entries.begin(); it != this->Entries.end();)
+    {
+      if (it->PipelineMTime < pipelineMTime)
+      {
+        this->MemorySize -= it->Size;
+        it = this->Entries.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  // Evict the least recently used outputs until the cache fits the limit.
+  void Evict(unsigned long limit)
+  {
+    while (this->MemorySize > limit && !this->Entries.empty())
+    {
+      this->MemorySize -= this->Entries.back().Size;
+      this->Entries.pop_back();
+    }
+  }
+
+  // ShallowCopy() does not copy the pipeline keys describing the piece.
+  static void CopyPieceInformation(vtkDataObject* from, vtkDataObject* to)
+  {
+    vtkInformation* fromInfo = from->GetInformation();
+    vtkInformation* toInfo = to->GetInformation();
+    if (fromInfo->Has(vtkDataObject::DATA_PIECE_NUMBER()))
+    {
+      toInfo->CopyEntry(fromInfo, vtkDataObject::DATA_PIECE_NUMBER());
+    }
+    if (fromInfo->Has(vtkDataObject::DATA_NUMBER_OF_PIECES()))
+    {
+      toInfo->CopyEntry(fromInfo, vtkDataObject::DATA_NUMBER_OF_PIECES());
+    }
+    if (fromInfo->Has(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS()))
+    {
+      toInfo->CopyEntry(fromInfo, vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS());
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkLRUCachePipeline::vtkLRUCachePipeline()
+{
+  this->Internals = new vtkInternals;
+  this->CacheMemoryLimit = 1048576;
+  this->PrefetchNextTimeStep = false;
+}
+
+//------------------------------------------------------------------------------
+vtkLRUCachePipeline::~vtkLRUCachePipeline()
+{
+  this->WaitForPrefetch();
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkLRUCachePipeline::SetCacheMemoryLimit(unsigned long limit)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  if (this->CacheMemoryLimit != limit)
+  {
+    this->CacheMemoryLimit = limit;
+    this->Internals->Evict(limit);
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkLRUCachePipeline::ClearCache()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  this->Internals->Entries.clear();
+  this->Internals->MemorySize = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkLRUCachePipeline::WaitForPrefetch()
+{
+  std::thread& thread = this->Internals->PrefetchThread;
+  if (thread.joinable())
+  {
+    // The prefetch may release the last reference to the algorithm.
+    if (thread.get_id() == std::this_thread::get_id())
+    {
+      thread.detach();
+    }
+    else
+    {
+      thread.join();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkLRUCachePipeline::GetNumberOfHits()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfHits;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkLRUCachePipeline::GetNumberOfMisses()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfMisses;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkLRUCachePipeline::GetNumberOfPrefetches()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfPrefetches;
+}
+
+//------------------------------------------------------------------------------
+int vtkLRUCachePipeline::GetNumberOfCachedOutputs()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkLRUCachePipeline::GetCacheMemorySize()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  return this->Internals->MemorySize;
+}
+
+//------------------------------------------------------------------------------
+void vtkLRUCachePipeline::ResetStatistics()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  this->Internals->NumberOfHits = 0;
+  this->Internals->NumberOfMisses = 0;
+  this->Internals->NumberOfPrefetches = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkLRUCachePipeline::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  // The prefetch thread executes the pipeline, wait for it before taking the
+  // lock it holds.
+  this->WaitForPrefetch();
+
+  std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+  vtkTypeBool result = this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+  if (result && this->PrefetchNextTimeStep && request->Has(REQUEST_DATA()) &&
+    request->Has(FROM_OUTPUT_PORT()) &&
+    request->Get(FROM_OUTPUT_PORT()) >= 0)
+  {
+    this->StartPrefetch(request->Get(FROM_OUTPUT_PORT()));
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkLRUCachePipeline::NeedToExecuteData(
+  int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+  {
+    return 0;
+  }
+  if (outputPort < 0 || this->ContinueExecuting)
+  {
+    return 1;
+  }
+
+  // Look for the requested output in the cache.
+  vtkInternals* internals = this->Internals;
+  internals->Invalidate(this->PipelineMTime);
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
+  auto entry = internals->Find(vtkInternals::MakeKey(outputPort, outInfo));
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (entry == internals->Entries.end() || !output || !output->IsA(entry->Data->GetClassName()))
+  {
+    return 1;
+  }
+
+  internals->Entries.splice(internals->Entries.begin(), internals->Entries, entry);
+  output->ShallowCopy(entry->Data);
+  vtkInternals::CopyPieceInformation(entry->Data, output);
+  output->DataHasBeenGenerated();
+  ++internals->NumberOfHits;
+
+  // Track the time request as if the algorithm executed, see
+  // vtkStreamingDemandDrivenPipeline::NeedToExecuteBasedOnTime().
+  if (outInfo->Has(UPDATE_TIME_STEP()))
+  {
+    outInfo->Set(PREVIOUS_UPDATE_TIME_STEP(), outInfo->Get(UPDATE_TIME_STEP()));
+  }
+  else
+  {
+    outInfo->Remove(PREVIOUS_UPDATE_TIME_STEP());
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkLRUCachePipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  if (!result || request->Get(CONTINUE_EXECUTING()))
+  {
+    return result;
+  }
+
+  vtkInternals* internals = this->Internals;
+  ++(internals->Prefetching ? internals->NumberOfPrefetches : internals->NumberOfMisses);
+
+  // Keep a copy of the generated outputs.
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (!output || outInfo->Get(DATA_NOT_GENERATED()))
+    {
+      continue;
+    }
+    vtkInternals::Entry entry = vtkInternals::MakeKey(i, outInfo);
+    entry.Size = output->GetActualMemorySize();
+    entry.PipelineMTime = this->PipelineMTime;
+
+    auto previous = internals->Find(entry);
+    if (previous != internals->Entries.end())
+    {
+      internals->MemorySize -= previous->Size;
+      internals->Entries.erase(previous);
+    }
+    if (entry.Size > this->CacheMemoryLimit)
+    {
+      continue;
+    }
+    entry.Data = vtkSmartPointer<vtkDataObject>::Take(output->NewInstance());
+    entry.Data->ShallowCopy(output);
+    vtkInternals::CopyPieceInformation(output, entry.Data);
+    internals->Entries.push_front(entry);
+    internals->MemorySize += entry.Size;
+  }
+  internals->Evict(this->CacheMemoryLimit);
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+void vtkLRUCachePipeline::StartPrefetch(int outputPort)
+{
+  vtkInformation* outInfo = this->GetOutputInformation(outputPort);
+  if (!outInfo->Has(TIME_STEPS()) || !outInfo->Has(UPDATE_TIME_STEP()))
+  {
+    return;
+  }
+
+  // The time step following the requested one, looping to the first one.
+  const double* steps = outInfo->Get(TIME_STEPS());
+  const int numberOfSteps = outInfo->Length(TIME_STEPS());
+  const double time = outInfo->Get(UPDATE_TIME_STEP());
+  double nextTime = steps[0];
+  for (int i = 0; i < numberOfSteps; ++i)
+  {
+    if (steps[i] > time)
+    {
+      nextTime = steps[i];
+      break;
+    }
+  }
+  if (numberOfSteps < 2 || nextTime == time)
+  {
+    return;
+  }
+
+  // Iterating a simple algorithm over composite inputs updates the shared
+  // output information, which the caller may be reading.
+  int compositePort;
+  if (this->ShouldIterateOverInput(this->GetInputInformation(), compositePort))
+  {
+    return;
+  }
+
+  // The next time step is generated in private copies of the output
+  // information and data objects so that the current outputs remain valid
+  // downstream.
+  vtkSmartPointer<vtkInformationVector> outputs = vtkSmartPointer<vtkInformationVector>::New();
+  vtkInformationVector* outInfoVec = this->GetOutputInformation();
+  outputs->SetNumberOfInformationObjects(outInfoVec->GetNumberOfInformationObjects());
+  for (int i = 0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkInformation* info = outputs->GetInformationObject(i);
+    info->Copy(outInfoVec->GetInformationObject(i), 1);
+    if (vtkDataObject* data = info->Get(vtkDataObject::DATA_OBJECT()))
+    {
+      vtkSmartPointer<vtkDataObject> newData =
+        vtkSmartPointer<vtkDataObject>::Take(data->NewInstance());
+      info->Set(vtkDataObject::DATA_OBJECT(), newData);
+    }
+  }
+  vtkInformation* nextInfo = outputs->GetInformationObject(outputPort);
+  nextInfo->Set(UPDATE_TIME_STEP(), nextTime);
+  if (this->Internals->Find(vtkInternals::MakeKey(outputPort, nextInfo)) !=
+    this->Internals->Entries.end())
+  {
+    return;
+  }
+
+  // ProcessRequest() waited for the previous prefetch, and the lock is held
+  // until the request is done, so the thread starts once it is released.
+  vtkAlgorithm* algorithm = this->Algorithm;
+  algorithm->Register(this);
+  this->Internals->Prefetching = true;
+  this->Internals->PrefetchThread = std::thread([this, algorithm, outputs, outputPort]() {
+    {
+      std::lock_guard<std::recursive_mutex> lock(this->Internals->Mutex);
+
+      vtkNew<vtkInformation> updateExtentRequest;
+      updateExtentRequest->Set(REQUEST_UPDATE_EXTENT());
+      updateExtentRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+      updateExtentRequest->Set(vtkExecutive::ALGORITHM_BEFORE_FORWARD(), 1);
+      updateExtentRequest->Set(FROM_OUTPUT_PORT(), outputPort);
+
+      vtkNew<vtkInformation> dataRequest;
+      dataRequest->Set(REQUEST_DATA());
+      dataRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+      dataRequest->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+      dataRequest->Set(FROM_OUTPUT_PORT(), outputPort);
+
+      // The superclass processes the requests, ProcessRequest() would wait
+      // for this thread.
+      if (this->Superclass::ProcessRequest(
+            updateExtentRequest, this->GetInputInformation(), outputs))
+      {
+        this->Superclass::ProcessRequest(dataRequest, this->GetInputInformation(), outputs);
+      }
+      this->Internals->Prefetching = false;
+    }
+    algorithm->UnRegister(this);
+  });
+}
+
+//------------------------------------------------------------------------------
+void vtkLRUCachePipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << "\n";
+  os << indent << "PrefetchNextTimeStep: " << this->PrefetchNextTimeStep << "\n";
+  os << indent << "NumberOfCachedOutputs: " << this->GetNumberOfCachedOutputs() << "\n";
+  os << indent << "CacheMemorySize: " << this->GetCacheMemorySize() << "\n";
+  os << indent << "NumberOfHits: " << this->GetNumberOfHits() << "\n";
+  os << indent << "NumberOfMisses: " << this->GetNumberOfMisses() << "\n";
+  os << indent << "NumberOfPrefetches: " << this->GetNumberOfPrefetches() << "\n";
+}
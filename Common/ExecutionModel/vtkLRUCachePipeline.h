@@ -0,0 +1,137 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLRUCachePipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkLRUCachePipeline
+ * @brief   Executive caching the outputs of its algorithm within a memory budget
+ *
+ * vtkLRUCachePipeline keeps shallow copies of the outputs generated by its
+ * algorithm, keyed on the time step, the piece, the number of pieces, the
+ * number of ghost levels and the structured extent they were generated
+ * for. When a request matches a cached output, the output is restored from
+ * the cache instead of executing the algorithm and its upstream pipeline.
+ * This is typically used on a reader or an expensive filter to loop over
+ * the time steps of an animation without reading or computing them again.
+ *
+ * The cache is bounded by a memory budget, computed with
+ * vtkDataObject::GetActualMemorySize(), and the least recently used outputs
+ * are evicted first. All the cached outputs are discarded when the
+ * algorithm or its upstream pipeline is modified. The number of requests
+ * served from the cache (hits) and of executions (misses) are reported.
+ *
+ * When PrefetchNextTimeStep is on, the output of the time step following
+ * the last requested one (looping to the first one) is generated on a
+ * background thread once a request is fulfilled, into private copies of
+ * the output information and data objects, and added to the cache. The
+ * outputs of the algorithm are not modified by the prefetch. Requests to
+ * this executive wait for the prefetch to be done before processing. While
+ * prefetching, the upstream pipeline executes for the next time step, so it
+ * must not be updated by other executives and its outputs must not be read
+ * directly. The algorithm must only use the output information given to
+ * RequestData() to access its outputs. Algorithms iterated over the blocks
+ * of a composite input are not prefetched.
+ *
+ * @sa
+ * vtkCachedStreamingDemandDrivenPipeline vtkTemporalDataSetCache
+ */
+
+#ifndef vtkLRUCachePipeline_h
+#define vtkLRUCachePipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkLRUCachePipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkLRUCachePipeline* New();
+  vtkTypeMacro(vtkLRUCachePipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Generalized interface for asking the executive to fulfill update
+   * requests. The requests wait for a prefetch in progress.
+   */
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inInfo,
+    vtkInformationVector* outInfo) override;
+
+  ///@{
+  /**
+   * Memory budget of the cache in kibibytes. Default is 1048576 (1 GiB).
+   */
+  void SetCacheMemoryLimit(unsigned long limit);
+  vtkGetMacro(CacheMemoryLimit, unsigned long);
+  ///@}
+
+  ///@{
+  /**
+   * When on, generate and cache the output of the next time step in the
+   * background after each request. Off by default.
+   */
+  vtkSetMacro(PrefetchNextTimeStep, bool);
+  vtkGetMacro(PrefetchNextTimeStep, bool);
+  vtkBooleanMacro(PrefetchNextTimeStep, bool);
+  ///@}
+
+  /**
+   * Discard all the cached outputs.
+   */
+  void ClearCache();
+
+  /**
+   * Wait for the prefetch in progress, if any. It must not be called from
+   * the algorithm while it executes.
+   */
+  void WaitForPrefetch();
+
+  ///@{
+  /**
+   * Statistics of the cache: the number of requests served from the cache,
+   * the number of requests that executed the algorithm, the number of
+   * outputs generated by prefetching, the number of cached outputs and
+   * the memory they use in kibibytes.
+   */
+  vtkIdType GetNumberOfHits();
+  vtkIdType GetNumberOfMisses();
+  vtkIdType GetNumberOfPrefetches();
+  int GetNumberOfCachedOutputs();
+  unsigned long GetCacheMemorySize();
+  void ResetStatistics();
+  ///@}
+
+protected:
+  vtkLRUCachePipeline();
+  ~vtkLRUCachePipeline() override;
+
+  int NeedToExecuteData(
+    int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec) override;
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
+  // Start generating the time step following the one of the given output
+  // port in the background.
+  void StartPrefetch(int outputPort);
+
+  unsigned long CacheMemoryLimit;
+  bool PrefetchNextTimeStep;
+
+private:
+  vtkLRUCachePipeline(const vtkLRUCachePipeline&) = delete;
+  void operator=(const vtkLRUCachePipeline&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
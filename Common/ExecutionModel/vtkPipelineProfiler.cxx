@@ -0,0 +1,415 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+struct ProfilerEvent
+{
+  const void* Object;
+  char ClassName[64];
+  const char* Pass;
+  const char* Reason;
+  double Start;
+  double End;
+  double CPUTime;
+  long long Bytes;
+  int NumberOfThreads;
+};
+
+// An event of the ring buffer, with the number of the event it holds (one
+// more than its index), or zero while it is being written. A reader copying
+// the slot while it is rewritten sees the number change and drops the copy.
+// The event is stored in atomic words so that such a copy is not a data race.
+struct EventSlot
+{
+  static_assert(std::is_trivially_copyable<ProfilerEvent>::value, "events are copied as words");
+  static constexpr std::size_t NumberOfWords =
+    (sizeof(ProfilerEvent) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  std::atomic<std::size_t> Sequence{ 0 };
+  std::atomic<std::uint64_t> Words[NumberOfWords];
+
+  void Store(const ProfilerEvent& event)
+  {
+    std::uint64_t words[NumberOfWords] = {};
+    std::memcpy(words, &event, sizeof(ProfilerEvent));
+    for (std::size_t i = 0; i < NumberOfWords; ++i)
+    {
+      this->Words[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  void Load(ProfilerEvent& event) const
+  {
+    std::uint64_t words[NumberOfWords];
+    for (std::size_t i = 0; i < NumberOfWords; ++i)
+    {
+      words[i] = this->Words[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&event, words, sizeof(ProfilerEvent));
+  }
+};
+
+// Events of a thread. Only the owning thread writes, so recording an event
+// only needs to publish the new count.
+struct ThreadBuffer
+{
+  std::unique_ptr<EventSlot[]> Events;
+  std::size_t Capacity = 0;
+  std::atomic<std::size_t> Count{ 0 };
+  int ThreadIndex = 0;
+};
+
+struct ProfilerRegistry
+{
+  std::mutex Mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+  // Incremented by Clear() so that threads register a new buffer.
+  std::atomic<int> Generation{ 0 };
+};
+
+std::atomic<bool> ProfilerEnabled{ false };
+std::atomic<int> ProfilerBufferCapacity{ 65536 };
+
+ProfilerRegistry& GetRegistry()
+{
+  static ProfilerRegistry registry;
+  return registry;
+}
+
+ThreadBuffer* GetThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  thread_local int generation = -1;
+
+  ProfilerRegistry& registry = GetRegistry();
+  if (!buffer || generation != registry.Generation.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    buffer = std::make_shared<ThreadBuffer>();
+    buffer->Capacity = static_cast<std::size_t>(std::max(1, ProfilerBufferCapacity.load()));
+    buffer->Events.reset(new EventSlot[buffer->Capacity]);
+    buffer->ThreadIndex = static_cast<int>(registry.Buffers.size());
+    registry.Buffers.push_back(buffer);
+    generation = registry.Generation.load();
+  }
+  return buffer.get();
+}
+
+// Copy of the recorded events with the index of their thread. The threads
+// may record events meanwhile, overwriting their oldest events: the events
+// overwritten during the copy are dropped.
+void CollectEvents(std::vector<std::pair<int, ProfilerEvent>>& events)
+{
+  ProfilerRegistry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  for (const auto& buffer : registry.Buffers)
+  {
+    const std::size_t count = buffer->Count.load(std::memory_order_acquire);
+    const std::size_t capacity = buffer->Capacity;
+    for (std::size_t i = (count > capacity ? count - capacity : 0); i < count; ++i)
+    {
+      const EventSlot& slot = buffer->Events[i % capacity];
+      if (slot.Sequence.load(std::memory_order_acquire) != i + 1)
+      {
+        continue; // being overwritten
+      }
+      ProfilerEvent event;
+      slot.Load(event);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.Sequence.load(std::memory_order_relaxed) == i + 1)
+      {
+        events.emplace_back(buffer->ThreadIndex, event);
+      }
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler() = default;
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler() = default;
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkPipelineProfiler::GetEnabled() << "\n";
+  os << indent << "BufferCapacity: " << vtkPipelineProfiler::GetBufferCapacity() << "\n";
+  os << indent << "NumberOfEvents: " << vtkPipelineProfiler::GetNumberOfEvents() << "\n";
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::SetEnabled(bool enabled)
+{
+  ProfilerEnabled = enabled;
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::GetEnabled()
+{
+  return ProfilerEnabled.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::SetBufferCapacity(int capacity)
+{
+  ProfilerBufferCapacity = capacity;
+}
+
+//------------------------------------------------------------------------------
+int vtkPipelineProfiler::GetBufferCapacity()
+{
+  return ProfilerBufferCapacity;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Clear()
+{
+  ProfilerRegistry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.Buffers.clear();
+  ++registry.Generation;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfEvents()
+{
+  ProfilerRegistry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  vtkIdType numberOfEvents = 0;
+  for (const auto& buffer : registry.Buffers)
+  {
+    numberOfEvents += static_cast<vtkIdType>(std::min(buffer->Count.load(), buffer->Capacity));
+  }
+  return numberOfEvents;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::RecordAlgorithmCall(vtkAlgorithm* algorithm, vtkInformation* request,
+  vtkInformationVector* outInfo, const char* reason, double startTime, double startCPUTime)
+{
+  const double endTime = vtkTimerLog::GetUniversalTime();
+  const double endCPUTime = vtkPipelineProfiler::GetProcessCPUTime();
+
+  ProfilerEvent event;
+  event.Object = algorithm;
+  std::strncpy(event.ClassName, algorithm->GetClassName(), sizeof(event.ClassName) - 1);
+  event.ClassName[sizeof(event.ClassName) - 1] = '\0';
+  vtkInformationRequestKey* pass = request ? request->GetRequest() : nullptr;
+  event.Pass = pass ? pass->GetName() : "UNKNOWN_REQUEST";
+  event.Start = startTime;
+  event.End = endTime;
+  event.CPUTime = endCPUTime - startCPUTime;
+  event.NumberOfThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+
+  // Memory of the outputs once generated.
+  event.Reason = nullptr;
+  event.Bytes = -1;
+  if (request && outInfo && request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    event.Reason = reason;
+    event.Bytes = 0;
+    for (int i = 0; i < outInfo->GetNumberOfInformationObjects(); ++i)
+    {
+      vtkInformation* info = outInfo->GetInformationObject(i);
+      if (vtkDataObject* output = info->Get(vtkDataObject::DATA_OBJECT()))
+      {
+        event.Bytes += static_cast<long long>(output->GetActualMemorySize()) * 1024;
+      }
+    }
+  }
+
+  ThreadBuffer* buffer = GetThreadBuffer();
+  const std::size_t index = buffer->Count.load(std::memory_order_relaxed);
+  EventSlot& slot = buffer->Events[index % buffer->Capacity];
+  slot.Sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.Store(event);
+  slot.Sequence.store(index + 1, std::memory_order_release);
+  buffer->Count.store(index + 1, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+double vtkPipelineProfiler::GetProcessCPUTime()
+{
+#ifdef _WIN32
+  FILETIME creation, exit, kernel, user;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+  {
+    return 0.0;
+  }
+  // In units of 100 ns.
+  const auto toSeconds = [](const FILETIME& time) {
+    return (static_cast<double>(time.dwHighDateTime) * 4294967296.0 + time.dwLowDateTime) * 1e-7;
+  };
+  return toSeconds(kernel) + toSeconds(user);
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+    static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::WriteChromeTrace(ostream& os)
+{
+  std::vector<std::pair<int, ProfilerEvent>> events;
+  CollectEvents(events);
+
+  double origin = std::numeric_limits<double>::max();
+  int numberOfThreads = 0;
+  for (const auto& item : events)
+  {
+    origin = std::min(origin, item.second.Start);
+    numberOfThreads = std::max(numberOfThreads, item.first + 1);
+  }
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  const char* separator = "\n";
+  for (int thread = 0; thread < numberOfThreads; ++thread)
+  {
+    os << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+       << ",\"args\":{\"name\":\"thread " << thread << "\"}}";
+    separator = ",\n";
+  }
+
+  const std::ios::fmtflags flags = os.flags();
+  const std::streamsize precision = os.precision();
+  os << std::fixed << std::setprecision(3);
+  for (const auto& item : events)
+  {
+    const ProfilerEvent& event = item.second;
+    const double wallTime = event.End - event.Start;
+    const double busyThreads = wallTime > 0.0 ? event.CPUTime / wallTime : 0.0;
+    os << separator << "{\"name\":\"" << event.ClassName << "\",\"cat\":\"" << event.Pass
+       << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << item.first
+       << ",\"ts\":" << (event.Start - origin) * 1e6 << ",\"dur\":" << wallTime * 1e6
+       << ",\"args\":{\"object\":\"" << event.Object << "\",\"busy_threads\":" << busyThreads
+       << ",\"thread_utilization\":" << busyThreads / std::max(1, event.NumberOfThreads);
+    if (event.Bytes >= 0)
+    {
+      os << ",\"output_bytes\":" << event.Bytes;
+    }
+    if (event.Reason)
+    {
+      os << ",\"reason\":\"" << event.Reason << "\"";
+    }
+    os << "}}";
+  }
+  os.flags(flags);
+  os.precision(precision);
+  os << "\n]}\n";
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::WriteChromeTrace(const std::string& fileName)
+{
+  std::ofstream file(fileName.c_str());
+  if (!file)
+  {
+    return false;
+  }
+  vtkPipelineProfiler::WriteChromeTrace(file);
+  return static_cast<bool>(file);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSummary(ostream& os)
+{
+  std::vector<std::pair<int, ProfilerEvent>> events;
+  CollectEvents(events);
+
+  struct AlgorithmSummary
+  {
+    std::string ClassName;
+    double Time = 0.0;
+    std::map<std::string, std::pair<int, double>> Passes;
+    int Executions = 0;
+    int RequestExecutions = 0;
+    long long Bytes = 0;
+  };
+  std::map<const void*, AlgorithmSummary> summaries;
+  for (const auto& item : events)
+  {
+    const ProfilerEvent& event = item.second;
+    AlgorithmSummary& summary = summaries[event.Object];
+    summary.ClassName = event.ClassName;
+    summary.Time += event.End - event.Start;
+    std::pair<int, double>& pass = summary.Passes[event.Pass];
+    ++pass.first;
+    pass.second += event.End - event.Start;
+    if (event.Reason)
+    {
+      ++summary.Executions;
+      summary.RequestExecutions += std::strcmp(event.Reason, "request") == 0;
+    }
+    summary.Bytes = std::max(summary.Bytes, event.Bytes);
+  }
+
+  std::vector<std::pair<const void*, AlgorithmSummary>> sorted(summaries.begin(), summaries.end());
+  std::sort(sorted.begin(), sorted.end(),
+    [](const std::pair<const void*, AlgorithmSummary>& a,
+      const std::pair<const void*, AlgorithmSummary>& b) { return a.second.Time > b.second.Time; });
+
+  for (const auto& item : sorted)
+  {
+    const AlgorithmSummary& summary = item.second;
+    os << summary.ClassName << " (" << item.first << "): " << summary.Time << " s\n";
+    for (const auto& pass : summary.Passes)
+    {
+      os << "  " << pass.first << ": " << pass.second.first << " calls, " << pass.second.second
+         << " s\n";
+    }
+    os << "  Executions: " << summary.Executions
+       << ", without algorithm or input change: " << summary.RequestExecutions
+       << ", output bytes: " << summary.Bytes << "\n";
+  }
+}
@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPipelineProfiler
+ * @brief   records the execution of every algorithm of the pipelines
+ *
+ * vtkPipelineProfiler is an opt-in instrumentation of the executives. Once
+ * enabled, every call of an algorithm by its executive is recorded as an
+ * event holding:
+ *
+ * - the algorithm class and address, and the pass (the request key, e.g.
+ *   REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT or REQUEST_DATA),
+ * - the wall time of the call and the CPU time of the process during the
+ *   call, from which the utilization of the vtkSMPTools threads is derived,
+ * - for REQUEST_DATA, the memory size of the outputs and the reason of the
+ *   execution: "first" execution, algorithm "modified", "input" data
+ *   modified, or "request" when neither the algorithm nor its inputs changed
+ *   since the previous execution. The latter are re-executions caused by a
+ *   new downstream request (time step, piece, extent), by a modified
+ *   information or by an unnecessary Modified() call, and are the first
+ *   place to look for wasted updates.
+ *
+ * Each thread records its events in its own ring buffer, without locks, so
+ * that algorithms executed concurrently can be profiled. When a buffer is
+ * full, the oldest events of the thread are overwritten.
+ *
+ * The events can be exported in the Chrome trace event format, which can be
+ * opened by chrome://tracing, Perfetto or speedscope to display a flame
+ * graph of the updates, or summarized per algorithm:
+ * \code
+ * vtkPipelineProfiler::SetEnabled(true);
+ * writer->Update();
+ * vtkPipelineProfiler::SetEnabled(false);
+ * vtkPipelineProfiler::WriteChromeTrace("update.json");
+ * vtkPipelineProfiler::PrintSummary(cout);
+ * \endcode
+ *
+ * The CPU time, given by GetProcessCPUTime(), is the user and system time of
+ * the whole process, so the utilization of an algorithm executed
+ * concurrently with other work is overestimated.
+ * The events can be exported or printed while algorithms execute on other
+ * threads, but the oldest events of a thread may then be dropped: those the
+ * thread overwrites during the copy. Clearing the events must not be done
+ * while algorithms are executing.
+ *
+ * @sa
+ * vtkExecutive vtkDemandDrivenPipeline vtkLogger
+ */
+
+#ifndef vtkPipelineProfiler_h
+#define vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObjectBase.h"
+#include "vtkSetGet.h" // needed for macros
+
+#include <string> // for std::string
+
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObjectBase
+{
+public:
+  vtkBaseTypeMacro(vtkPipelineProfiler, vtkObjectBase);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Enable or disable the recording of the algorithm calls. Disabled by
+   * default.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  ///@{
+  /**
+   * Number of events kept per thread. The capacity applies to the buffers
+   * created after the call, use Clear() to apply it to all threads.
+   * Default is 65536.
+   */
+  static void SetBufferCapacity(int capacity);
+  static int GetBufferCapacity();
+  ///@}
+
+  /**
+   * Discard all the recorded events.
+   */
+  static void Clear();
+
+  /**
+   * Number of events currently recorded by all the threads.
+   */
+  static vtkIdType GetNumberOfEvents();
+
+  ///@{
+  /**
+   * Write the recorded events in the Chrome trace event JSON format.
+   * Returns false if the file cannot be written.
+   */
+  static void WriteChromeTrace(ostream& os);
+  static bool WriteChromeTrace(const std::string& fileName);
+  ///@}
+
+  /**
+   * Print, for each algorithm, the number of calls and the time of each
+   * pass, the number of executions and of "request" re-executions, and the
+   * largest memory size of its outputs.
+   */
+  static void PrintSummary(ostream& os);
+
+  /**
+   * CPU time used by the process so far, in seconds, summed over all its
+   * threads, user and system time. Unlike vtkTimerLog::GetCPUTime(), based on
+   * clock(), it is not the wall time on Windows.
+   */
+  static double GetProcessCPUTime();
+
+  /**
+   * Record a call of an algorithm by its executive, started at the given
+   * wall and process CPU times (vtkTimerLog::GetUniversalTime() and
+   * GetProcessCPUTime()). Called by vtkExecutive::CallAlgorithm().
+   * The reason is the one of the execution for REQUEST_DATA, nullptr
+   * otherwise.
+   */
+  static void RecordAlgorithmCall(vtkAlgorithm* algorithm, vtkInformation* request,
+    vtkInformationVector* outInfo, const char* reason, double startTime, double startCPUTime);
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler() override;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&) = delete;
+  void operator=(const vtkPipelineProfiler&) = delete;
+};
+
+#endif
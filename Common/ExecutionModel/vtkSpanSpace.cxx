@@ -26,6 +26,9 @@
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 // Methods and functors for processing in parallel
 namespace
 { // begin anonymous namespace
@@ -122,6 +125,41 @@ struct vtkSpanTuple
   }
 };
 
+//------------------------------------------------------------------------------
+// Extract the cell ids from the tuples sorted across span space, and the
+// offsets of the buckets into them. A bucket starts at the first tuple whose
+// index is greater than or equal to the bucket index, so each tuple fills
+// the offsets of the buckets between the index of the previous tuple and its
+// own. This way the offsets are computed in parallel without counting.
+struct BuildOffsets
+{
+  const vtkSpanTuple* Space;
+  vtkIdType* CellIds;
+  vtkIdType* Offsets;
+
+  BuildOffsets(const vtkSpanTuple* space, vtkIdType* cellIds, vtkIdType* offsets)
+    : Space(space)
+    , CellIds(cellIds)
+    , Offsets(offsets)
+  {
+  }
+
+  void operator()(vtkIdType idx, vtkIdType endIdx)
+  {
+    const vtkSpanTuple* space = this->Space;
+    vtkIdType* offsets = this->Offsets;
+    for (; idx < endIdx; ++idx)
+    {
+      this->CellIds[idx] = space[idx].CellId;
+      vtkIdType bucket = (idx > 0 ? space[idx - 1].Index + 1 : 0);
+      for (; bucket <= space[idx].Index; ++bucket)
+      {
+        offsets[bucket] = idx;
+      }
+    }
+  }
+};
+
 } // anonymous
 
 //------------------------------------------------------------------------------
@@ -211,7 +249,6 @@ vtkInternalSpanSpace::vtkInternalSpanSpace(
   this->SMax = sMax;
   this->Range = (sMax - sMin);
   this->Offsets = new vtkIdType[dim * dim + 1]; // leave one extra for numCells
-  std::fill_n(this->Offsets, dim * dim, 0);
   this->NumCells = numCells;
   this->Space = new vtkSpanTuple[numCells];
   this->CellIds = new vtkIdType[numCells];
@@ -247,29 +284,13 @@ void vtkInternalSpanSpace::Build()
   // could use the CellIds already contained in the tuple and not have
   // to duplicate this, but then sorting requires a custom class with
   // iterators, etc.
+  BuildOffsets buildOffsets(this->Space, this->CellIds, this->Offsets);
+  vtkSMPTools::For(0, this->NumCells, buildOffsets);
 
-  // First count the number of contributions in each bucket.
-  vtkIdType cellId, numElems;
-  for (cellId = 0; cellId < this->NumCells; ++cellId)
-  {
-    this->Offsets[this->Space[cellId].Index]++;
-    this->CellIds[cellId] = this->Space[cellId].CellId;
-  }
-
-  // Now accumulate offset array
-  vtkIdType i, j, jOffset, idx, currentOffset = 0;
-  for (j = 0; j < this->Dim; ++j)
-  {
-    jOffset = j * this->Dim;
-    for (i = 0; i < this->Dim; ++i)
-    {
-      idx = i + jOffset;
-      numElems = this->Offsets[idx];
-      this->Offsets[idx] = currentOffset;
-      currentOffset += numElems;
-    }
-  }
-  this->Offsets[this->Dim * this->Dim] = this->NumCells;
+  // The buckets past the last tuple are empty.
+  const vtkIdType numBuckets = this->Dim * this->Dim;
+  const vtkIdType lastIndex = (this->NumCells > 0 ? this->Space[this->NumCells - 1].Index : -1);
+  std::fill(this->Offsets + lastIndex + 1, this->Offsets + numBuckets + 1, this->NumCells);
 
   // We don't need the span space tuple array any more, we have
   // offsets and cell ids computed.
@@ -374,29 +395,36 @@ struct MapUGridToSpanSpace
   {
   }
 
-  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  // Direct access to the connectivity. Unlike GetCellPoints(), this does not
+  // use the temporary id list of the cell array, which is shared by the
+  // threads when the connectivity is not stored as vtkIdType.
+  struct MapCells
   {
-    vtkUnstructuredGrid* grid = this->Grid;
-    TS* scalars = this->Scalars;
-    vtkIdType i, npts;
-    const vtkIdType* pts;
-    double s, sMin, sMax;
-
-    for (; cellId < endCellId; ++cellId)
+    template <typename CellStateT>
+    void operator()(CellStateT& state, vtkIdType cellId, vtkIdType endCellId,
+      vtkInternalSpanSpace* ss, const TS* scalars)
     {
-      sMin = VTK_DOUBLE_MAX;
-      sMax = VTK_DOUBLE_MIN;
-      // A faster version of GetCellPoints()
-      grid->GetCellPoints(cellId, npts, pts);
-      for (i = 0; i < npts; i++)
+      double s, sMin, sMax;
+      for (; cellId < endCellId; ++cellId)
       {
-        s = static_cast<double>(scalars[pts[i]]);
-        sMin = (s < sMin ? s : sMin);
-        sMax = (s > sMax ? s : sMax);
-      } // for all cell scalars
-      // Compute span space id, and prepare to map
-      this->SpanSpace->SetSpanPoint(cellId, sMin, sMax);
-    } // for all cells in this thread
+        sMin = VTK_DOUBLE_MAX;
+        sMax = VTK_DOUBLE_MIN;
+        for (const auto ptId : state.GetCellRange(cellId))
+        {
+          s = static_cast<double>(scalars[ptId]);
+          sMin = (s < sMin ? s : sMin);
+          sMax = (s > sMax ? s : sMax);
+        } // for all cell scalars
+        // Compute span space id, and prepare to map
+        ss->SetSpanPoint(cellId, sMin, sMax);
+      } // for all cells in this thread
+    }
+  };
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    this->Grid->GetCells()->Visit(
+      MapCells{}, cellId, endCellId, this->SpanSpace, static_cast<const TS*>(this->Scalars));
   }
 
   static void Execute(vtkIdType numCells, vtkInternalSpanSpace* ss, vtkUnstructuredGrid* ds, TS* s)
@@ -639,11 +667,15 @@ vtkIdType vtkSpanSpace::GetNumberOfCellBatches(double scalarValue)
   ;
   sp->GetSpanRectangle(scalarValue, this->RMin, this->RMax);
 
-  // Loop over each span row to count total memory allocation required.
+  // Loop over each span row to count total memory allocation required,
+  // and the offset of each row into the candidate cells.
+  std::vector<vtkIdType> rowOffsets;
+  rowOffsets.reserve(this->RMax[1] - this->RMin[1]);
   vtkIdType numCandidates = 0;
-  vtkIdType row, *span, idx, numCells;
+  vtkIdType row, numCells;
   for (row = this->RMin[1]; row < this->RMax[1]; ++row)
   {
+    rowOffsets.push_back(numCandidates);
     sp->GetCellsInSpan(row, this->RMin, this->RMax, numCells);
     numCandidates += numCells;
   } // for all rows in span rectangle
@@ -661,18 +693,17 @@ vtkIdType vtkSpanSpace::GetNumberOfCellBatches(double scalarValue)
     sp->CandidateCells = new vtkIdType[sp->NumCandidates];
   }
 
-  // Now copy cells into the allocated memory. This could be done in
-  // parallel (a parallel write - TODO) but probably wouldn't provide
-  // much of a boost.
-  numCandidates = 0;
-  for (row = this->RMin[1]; row < this->RMax[1]; ++row)
-  {
-    span = sp->GetCellsInSpan(row, this->RMin, this->RMax, numCells);
-    for (idx = 0; idx < numCells; ++idx)
+  // Now copy cells into the allocated memory, the span rows in parallel.
+  vtkIdType rMin[2] = { this->RMin[0], this->RMin[1] };
+  vtkIdType rMax[2] = { this->RMax[0], this->RMax[1] };
+  vtkSMPTools::For(rMin[1], rMax[1], [&](vtkIdType beginRow, vtkIdType endRow) {
+    vtkIdType numRowCells;
+    for (vtkIdType r = beginRow; r < endRow; ++r)
     {
-      sp->CandidateCells[numCandidates++] = span[idx];
+      const vtkIdType* rowSpan = sp->GetCellsInSpan(r, rMin, rMax, numRowCells);
+      std::copy(rowSpan, rowSpan + numRowCells, sp->CandidateCells + rowOffsets[r - rMin[1]]);
     }
-  } // for all rows in span rectangle
+  });
 
   // Watch for boundary conditions. Return BatchSize cells to a batch.
   if (sp->NumCandidates < 1)
@@ -27,6 +27,10 @@
  * (or batches) of cells that lie along a particular row in the span
  * space. These arrays can then be processed separately or in parallel.
  *
+ * The span space is built in parallel with vtkSMPTools the first time it is
+ * traversed, and is reused by the following traversals (e.g., when the
+ * contour value changes) until the dataset or this object is modified.
+ *
  * Learn more about span space in these two publications: 1) "A Near
  * Optimal Isosorface Extraction Algorithm Using the Span Space."
  * Yarden Livnat et al. and 2) Isosurfacing in Span Space with Utmost
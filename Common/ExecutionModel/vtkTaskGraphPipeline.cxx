@@ -0,0 +1,374 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTaskGraphPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTaskGraphPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCollection.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMultiTimeStepAlgorithm.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+vtkStandardNewMacro(vtkTaskGraphPipeline);
+
+vtkInformationKeyMacro(vtkTaskGraphPipeline, NON_REENTRANT, Integer);
+
+//------------------------------------------------------------------------------
+class vtkTaskGraphPipeline::vtkInternals
+{
+public:
+  // Serializes the REQUEST_DATA requests processed by this executive, so
+  // that concurrent tasks reaching a shared upstream algorithm do not
+  // execute it twice.
+  std::recursive_mutex DataMutex;
+
+  // Number of task graphs currently executing this executive. Requests are
+  // then forwarded upstream as usual since the inputs are already updated.
+  int TaskGraphDepth = 0;
+};
+
+//------------------------------------------------------------------------------
+// The dependency graph of an update. Each node is an executive with the
+// output ports requested from it, and the nodes are grouped in levels so
+// that the nodes of a level only depend on nodes of lower levels.
+class vtkTaskGraph
+{
+public:
+  struct Node
+  {
+    vtkExecutive* Executive;
+    std::vector<int> Ports;
+    std::vector<size_t> Inputs;
+    int Level;
+    bool Serial;
+    int Result;
+    double Time;
+  };
+
+  // Add the node of an executive output port and all its upstream nodes.
+  size_t Add(vtkExecutive* executive, int port)
+  {
+    auto found = this->NodeIds.find(executive);
+    if (found != this->NodeIds.end())
+    {
+      std::vector<int>& ports = this->Nodes[found->second].Ports;
+      if (std::find(ports.begin(), ports.end(), port) == ports.end())
+      {
+        ports.push_back(port);
+      }
+      return found->second;
+    }
+
+    std::vector<size_t> inputs;
+    int level = 0;
+    for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < executive->GetNumberOfInputConnections(i); ++j)
+      {
+        vtkExecutive* producer;
+        int producerPort;
+        vtkExecutive::PRODUCER()->Get(
+          executive->GetInputInformation(i, j), producer, producerPort);
+        if (producer)
+        {
+          size_t input = this->Add(producer, producerPort);
+          if (std::find(inputs.begin(), inputs.end(), input) == inputs.end())
+          {
+            inputs.push_back(input);
+          }
+          level = std::max(level, this->Nodes[input].Level + 1);
+        }
+      }
+    }
+
+    Node node;
+    node.Executive = executive;
+    node.Ports.push_back(port);
+    node.Inputs = inputs;
+    node.Level = level;
+    node.Serial = !vtkTaskGraphPipeline::SafeDownCast(executive);
+    vtkAlgorithm* algorithm = executive->GetAlgorithm();
+    if (algorithm &&
+      (algorithm->GetInformation()->Get(vtkTaskGraphPipeline::NON_REENTRANT()) ||
+        vtkMultiTimeStepAlgorithm::SafeDownCast(algorithm)))
+    {
+      node.Serial = true;
+    }
+    node.Result = 1;
+    node.Time = 0.0;
+    this->Nodes.push_back(node);
+    this->NodeIds[executive] = this->Nodes.size() - 1;
+    return this->Nodes.size() - 1;
+  }
+
+  // Execute the request on all the nodes, level by level, and record the
+  // critical path in the given executive.
+  int Execute(vtkInformation* request, vtkTaskGraphPipeline* self)
+  {
+    this->SetTaskGraphDepth(1);
+
+    int maxLevel = 0;
+    for (const Node& node : this->Nodes)
+    {
+      maxLevel = std::max(maxLevel, node.Level);
+    }
+
+    int result = 1;
+    for (int level = 0; level <= maxLevel && result; ++level)
+    {
+      std::vector<size_t> parallelNodes;
+      std::vector<size_t> serialNodes;
+      for (size_t i = 0; i < this->Nodes.size(); ++i)
+      {
+        if (this->Nodes[i].Level == level)
+        {
+          (this->Nodes[i].Serial ? serialNodes : parallelNodes).push_back(i);
+        }
+      }
+
+      if (parallelNodes.size() == 1)
+      {
+        this->ExecuteNode(this->Nodes[parallelNodes[0]], request);
+      }
+      else if (!parallelNodes.empty())
+      {
+        vtkSMPTools::For(0, static_cast<vtkIdType>(parallelNodes.size()), 1,
+          [&](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType i = begin; i < end; ++i)
+            {
+              this->ExecuteNode(this->Nodes[parallelNodes[i]], request);
+            }
+          });
+      }
+      for (size_t i : serialNodes)
+      {
+        this->ExecuteNode(this->Nodes[i], request);
+      }
+
+      for (const Node& node : this->Nodes)
+      {
+        if (node.Level == level && !node.Result)
+        {
+          result = 0;
+        }
+      }
+    }
+
+    this->SetTaskGraphDepth(-1);
+    this->ComputeCriticalPath(self);
+    return result;
+  }
+
+private:
+  void ExecuteNode(Node& node, vtkInformation* request)
+  {
+    // Each task has its own copy of the request since executives modify it
+    // while processing it. Copy() skips the request key.
+    vtkNew<vtkInformation> taskRequest;
+    taskRequest->Copy(request);
+    taskRequest->CopyEntry(request, vtkDemandDrivenPipeline::REQUEST_DATA());
+
+    vtkExecutive* e = node.Executive;
+    double start = vtkTimerLog::GetUniversalTime();
+    for (int port : node.Ports)
+    {
+      taskRequest->Set(vtkExecutive::FROM_OUTPUT_PORT(), port);
+      if (!e->ProcessRequest(taskRequest, e->GetInputInformation(), e->GetOutputInformation()))
+      {
+        node.Result = 0;
+      }
+    }
+    node.Time = vtkTimerLog::GetUniversalTime() - start;
+  }
+
+  void SetTaskGraphDepth(int increment)
+  {
+    for (const Node& node : this->Nodes)
+    {
+      if (vtkTaskGraphPipeline* e = vtkTaskGraphPipeline::SafeDownCast(node.Executive))
+      {
+        e->Internals->TaskGraphDepth += increment;
+      }
+    }
+  }
+
+  // The nodes are sorted so that inputs come before their outputs.
+  void ComputeCriticalPath(vtkTaskGraphPipeline* self)
+  {
+    std::vector<double> pathTimes(this->Nodes.size());
+    std::vector<int> pathLengths(this->Nodes.size());
+    double totalTime = 0.0;
+    size_t last = 0;
+    for (size_t i = 0; i < this->Nodes.size(); ++i)
+    {
+      const Node& node = this->Nodes[i];
+      double inputTime = 0.0;
+      int inputLength = 0;
+      for (size_t input : node.Inputs)
+      {
+        if (pathTimes[input] > inputTime || inputLength == 0)
+        {
+          inputTime = pathTimes[input];
+          inputLength = pathLengths[input];
+        }
+      }
+      pathTimes[i] = inputTime + node.Time;
+      pathLengths[i] = inputLength + 1;
+      totalTime += node.Time;
+      if (pathTimes[i] >= pathTimes[last])
+      {
+        last = i;
+      }
+    }
+
+    self->NumberOfTasks = static_cast<int>(this->Nodes.size());
+    self->TotalTaskTime = totalTime;
+    self->CriticalPathTime = this->Nodes.empty() ? 0.0 : pathTimes[last];
+    self->CriticalPathLength = this->Nodes.empty() ? 0 : pathLengths[last];
+    vtkLogF(TRACE, "task graph: %d algorithms, critical path of %d algorithms, %g s / %g s",
+      self->NumberOfTasks, self->CriticalPathLength, self->CriticalPathTime, totalTime);
+  }
+
+  std::vector<Node> Nodes;
+  std::map<vtkExecutive*, size_t> NodeIds;
+};
+
+//------------------------------------------------------------------------------
+vtkTaskGraphPipeline::vtkTaskGraphPipeline()
+{
+  this->Internals = new vtkInternals;
+  this->CriticalPathLength = 0;
+  this->CriticalPathTime = 0.0;
+  this->TotalTaskTime = 0.0;
+  this->NumberOfTasks = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkTaskGraphPipeline::~vtkTaskGraphPipeline()
+{
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkTaskGraphPipeline::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  if (request && request->Has(REQUEST_DATA()))
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->Internals->DataMutex);
+    return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+  }
+  return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+}
+
+//------------------------------------------------------------------------------
+int vtkTaskGraphPipeline::ForwardUpstream(vtkInformation* request)
+{
+  if (!request->Has(REQUEST_DATA()) || this->Internals->TaskGraphDepth > 0 ||
+    this->SharedInputInformation)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+
+  vtkTaskGraph graph;
+  for (int i = 0; i < this->GetNumberOfInputPorts(); ++i)
+  {
+    for (int j = 0; j < this->GetNumberOfInputConnections(i); ++j)
+    {
+      vtkExecutive* e;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(this->GetInputInformation(i, j), e, producerPort);
+      if (e)
+      {
+        graph.Add(e, producerPort);
+      }
+    }
+  }
+  int result = graph.Execute(request, this);
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkTaskGraphPipeline::UpdateAlgorithms(vtkCollection* algorithms)
+{
+  if (!algorithms)
+  {
+    return 0;
+  }
+
+  // Run the passes preceding REQUEST_DATA on each algorithm.
+  vtkTaskGraph graph;
+  int result = 1;
+  algorithms->InitTraversal();
+  while (vtkObject* object = algorithms->GetNextItemAsObject())
+  {
+    vtkAlgorithm* algorithm = vtkAlgorithm::SafeDownCast(object);
+    vtkStreamingDemandDrivenPipeline* sddp =
+      algorithm ? vtkStreamingDemandDrivenPipeline::SafeDownCast(algorithm->GetExecutive())
+                : nullptr;
+    if (!sddp)
+    {
+      vtkErrorMacro("Cannot update " << object->GetClassName()
+                                     << ", it is not an algorithm with a streaming executive.");
+      result = 0;
+      continue;
+    }
+    int port = algorithm->GetNumberOfOutputPorts() ? 0 : -1;
+    if (!sddp->UpdateInformation() || !sddp->PropagateTime(port) ||
+      !sddp->UpdateTimeDependentInformation(port) || !sddp->PropagateUpdateExtent(port))
+    {
+      result = 0;
+      continue;
+    }
+    graph.Add(sddp, port);
+  }
+
+  vtkNew<vtkInformation> request;
+  request->Set(REQUEST_DATA());
+  request->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+  request->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+  return graph.Execute(request, this) && result;
+}
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfTasks: " << this->NumberOfTasks << "\n";
+  os << indent << "CriticalPathLength: " << this->CriticalPathLength << "\n";
+  os << indent << "CriticalPathTime: " << this->CriticalPathTime << "\n";
+  os << indent << "TotalTaskTime: " << this->TotalTaskTime << "\n";
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTaskGraphPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the above copyright notice for more information.
+
+  =========================================================================*/
+/**
+ * @class   vtkTaskGraphPipeline
+ * @brief   Executive that updates independent branches in parallel
+ *
+ * vtkTaskGraphPipeline is a vtkCompositeDataPipeline that executes the
+ * REQUEST_DATA pass of an update as a task graph. Instead of recursing
+ * depth-first through the inputs, it collects every upstream algorithm of
+ * the update into a dependency graph and executes the algorithms level by
+ * level: all the algorithms of a level only depend on algorithms of lower
+ * levels, so they are executed concurrently with vtkSMPTools. The other
+ * passes (data object, information, update extent) are unchanged.
+ *
+ * For example a reader feeding a contour, a slice and a glyph filter which
+ * are appended together executes the reader first and then the three
+ * branches concurrently. UpdateAlgorithms() does the same for several sinks
+ * that do not share a common downstream algorithm.
+ *
+ * Algorithms executed concurrently must be re-entrant with respect to each
+ * other. An algorithm that is not (it uses global state, invokes observers
+ * that are not thread safe, or loops over time steps with
+ * CONTINUE_EXECUTING) can be marked with the NON_REENTRANT() key in its
+ * information:
+ * \code
+ * filter->GetInformation()->Set(vtkTaskGraphPipeline::NON_REENTRANT(), 1);
+ * \endcode
+ * Such algorithms, the vtkMultiTimeStepAlgorithm subclasses and the
+ * algorithms whose executive is not a vtkTaskGraphPipeline are executed one
+ * at a time once the other algorithms of their level are done. To drive a
+ * whole pipeline with this executive, set it as the default executive:
+ * \code
+ * vtkNew<vtkTaskGraphPipeline> prototype;
+ * vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+ * \endcode
+ *
+ * The algorithms of a level run inside a vtkSMPTools::For, so their own
+ * vtkSMPTools loops are serial unless nested parallelism is enabled with
+ * vtkSMPTools::SetNestedParallelism(). A level with a single algorithm is
+ * executed on the calling thread.
+ *
+ * After each update, the executive reports the critical path of the graph:
+ * the chain of dependent algorithms with the longest total execution time.
+ * Its duration bounds the time of the update however many threads are used.
+ *
+ * @sa
+ * vtkCompositeDataPipeline vtkThreadedCompositeDataPipeline vtkSMPTools
+ */
+
+#ifndef vtkTaskGraphPipeline_h
+#define vtkTaskGraphPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkCollection;
+class vtkInformationIntegerKey;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTaskGraphPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkTaskGraphPipeline* New();
+  vtkTypeMacro(vtkTaskGraphPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Generalized interface for asking the executive to fulfill update
+   * requests. REQUEST_DATA requests are serialized per executive.
+   */
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inInfo,
+    vtkInformationVector* outInfo) override;
+
+  /**
+   * Update all the algorithms of the collection with a single task graph so
+   * that their independent upstream branches, and the algorithms themselves,
+   * are executed concurrently. The first output port of each algorithm is
+   * updated, or the algorithm itself when it has no output. The executive
+   * used to call this method does not need to drive an algorithm, and
+   * reports the critical path of the graph. Returns 0 if any update failed.
+   */
+  int UpdateAlgorithms(vtkCollection* algorithms);
+
+  /**
+   * Key set in the information of an algorithm (vtkAlgorithm::GetInformation())
+   * that cannot be executed concurrently with other algorithms.
+   * \ingroup InformationKeys
+   */
+  static vtkInformationIntegerKey* NON_REENTRANT();
+
+  ///@{
+  /**
+   * Description of the critical path of the last task graph executed by this
+   * executive: the number of algorithms on it and the sum of their
+   * execution times in seconds.
+   */
+  vtkGetMacro(CriticalPathLength, int);
+  vtkGetMacro(CriticalPathTime, double);
+  ///@}
+
+  /**
+   * Sum of the execution times of all the algorithms of the last task graph,
+   * in seconds. The ratio to GetCriticalPathTime() is the parallelism
+   * available in the pipeline.
+   */
+  vtkGetMacro(TotalTaskTime, double);
+
+  /**
+   * Number of algorithms in the last task graph executed by this executive.
+   */
+  vtkGetMacro(NumberOfTasks, int);
+
+protected:
+  vtkTaskGraphPipeline();
+  ~vtkTaskGraphPipeline() override;
+
+  // Executes the upstream algorithms as a task graph, unless this executive
+  // is itself executed by a task graph.
+  int ForwardUpstream(vtkInformation* request) override;
+  using Superclass::ForwardUpstream;
+
+  int CriticalPathLength;
+  double CriticalPathTime;
+  double TotalTaskTime;
+  int NumberOfTasks;
+
+private:
+  vtkTaskGraphPipeline(const vtkTaskGraphPipeline&) = delete;
+  void operator=(const vtkTaskGraphPipeline&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+  friend class vtkTaskGraph;
+};
+
+#endif
@@ -32,6 +32,7 @@
 #include "vtkImageData.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 #include "vtkTimerLog.h"
 
@@ -276,7 +277,15 @@ int vtkThreadedCompositeDataPipeline::CallAlgorithm(vtkInformation* request, int
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  const bool profile = vtkPipelineProfiler::GetEnabled();
+  const double startTime = profile ? vtkTimerLog::GetUniversalTime() : 0.0;
+  const double startCPUTime = profile ? vtkPipelineProfiler::GetProcessCPUTime() : 0.0;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  if (profile)
+  {
+    vtkPipelineProfiler::RecordAlgorithmCall(
+      this->Algorithm, request, outInfo, this->ExecutionReason, startTime, startCPUTime);
+  }
 
   // If the algorithm failed report it now.
   if (!result)
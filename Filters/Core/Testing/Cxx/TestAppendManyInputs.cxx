@@ -0,0 +1,432 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAppendManyInputs.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Append many small blocks and a large one with vtkAppendFilter and
+// vtkAppendPolyData, with and without merging the shared points, and check
+// the output cells, points and attributes against the inputs, and that the
+// output does not depend on the number of threads.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int NumberOfBlocks = 5;
+const int BlockDim = 3;
+const int LargeDim = 24;
+
+double DataValue(const double x[3])
+{
+  return x[0] + 10.0 * x[1] + 100.0 * x[2];
+}
+
+// Hexahedra of a block of dim^3 cells at origin, the last one stored as a
+// polyhedron. The global ids of the points are computed from their
+// coordinates.
+vtkSmartPointer<vtkUnstructuredGrid> MakeBlock(const int origin[3], int dim)
+{
+  auto block = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> data;
+  data->SetName("Data");
+  vtkNew<vtkIdTypeArray> globalIds;
+  globalIds->SetName("GlobalIds");
+  const vtkIdType n = NumberOfBlocks * BlockDim + LargeDim + 1;
+  for (int k = 0; k <= dim; ++k)
+  {
+    for (int j = 0; j <= dim; ++j)
+    {
+      for (int i = 0; i <= dim; ++i)
+      {
+        double x[3] = { static_cast<double>(origin[0] + i), static_cast<double>(origin[1] + j),
+          static_cast<double>(origin[2] + k) };
+        points->InsertNextPoint(x);
+        data->InsertNextValue(DataValue(x));
+        globalIds->InsertNextValue(static_cast<vtkIdType>(x[0] + n * (x[1] + n * x[2])));
+      }
+    }
+  }
+  block->SetPoints(points);
+  block->GetPointData()->AddArray(data);
+  block->GetPointData()->SetGlobalIds(globalIds);
+
+  vtkNew<vtkDoubleArray> cellData;
+  cellData->SetName("CellData");
+  block->Allocate(dim * dim * dim);
+  vtkIdType hex[8];
+  const int d = dim + 1;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        vtkIdType p = i + d * (j + d * k);
+        vtkIdType pts[8] = { p, p + 1, p + 1 + d, p + d, p + d * d, p + 1 + d * d,
+          p + 1 + d + d * d, p + d + d * d };
+        std::copy(pts, pts + 8, hex);
+        if (i == dim - 1 && j == dim - 1 && k == dim - 1)
+        {
+          vtkIdType faces[] = { 4, hex[0], hex[3], hex[2], hex[1], 4, hex[4], hex[5], hex[6],
+            hex[7], 4, hex[0], hex[1], hex[5], hex[4], 4, hex[1], hex[2], hex[6], hex[5], 4,
+            hex[2], hex[3], hex[7], hex[6], 4, hex[3], hex[0], hex[4], hex[7] };
+          block->InsertNextCell(VTK_POLYHEDRON, 8, hex, 6, faces);
+        }
+        else
+        {
+          block->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+        }
+        double center[3];
+        points->GetPoint(p, center);
+        cellData->InsertNextValue(DataValue(center));
+      }
+    }
+  }
+  block->GetCellData()->AddArray(cellData);
+  return block;
+}
+
+// Blocks touching each other in the xy plane, then a large block.
+std::vector<vtkSmartPointer<vtkUnstructuredGrid>> MakeBlocks()
+{
+  std::vector<vtkSmartPointer<vtkUnstructuredGrid>> blocks;
+  for (int b = 0; b < NumberOfBlocks; ++b)
+  {
+    for (int c = 0; c < NumberOfBlocks; ++c)
+    {
+      const int origin[3] = { b * BlockDim, c * BlockDim, 0 };
+      blocks.push_back(MakeBlock(origin, BlockDim));
+    }
+  }
+  const int origin[3] = { NumberOfBlocks * BlockDim, 0, 0 };
+  blocks.push_back(MakeBlock(origin, LargeDim));
+  return blocks;
+}
+
+// Check that the output cells have the coordinates and attributes of the
+// input cells, in the same order.
+bool CheckCells(const std::vector<vtkSmartPointer<vtkUnstructuredGrid>>& blocks,
+  vtkUnstructuredGrid* output)
+{
+  vtkDataArray* data = output->GetPointData()->GetArray("Data");
+  vtkDataArray* cellData = output->GetCellData()->GetArray("CellData");
+  if (!data || !cellData)
+  {
+    std::cerr << "Missing attributes" << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> inIds, outIds;
+  vtkIdType outCellId = 0;
+  for (vtkUnstructuredGrid* block : blocks)
+  {
+    for (vtkIdType cellId = 0; cellId < block->GetNumberOfCells(); ++cellId, ++outCellId)
+    {
+      int cellType = block->GetCellType(cellId);
+      if (output->GetCellType(outCellId) != cellType ||
+        cellData->GetTuple1(outCellId) != block->GetCellData()->GetArray(0)->GetTuple1(cellId))
+      {
+        std::cerr << "Wrong type or data of cell " << outCellId << std::endl;
+        return false;
+      }
+      if (cellType == VTK_POLYHEDRON)
+      {
+        block->GetFaceStream(cellId, inIds);
+        output->GetFaceStream(outCellId, outIds);
+      }
+      else
+      {
+        block->GetCellPoints(cellId, inIds);
+        output->GetCellPoints(outCellId, outIds);
+      }
+      if (inIds->GetNumberOfIds() != outIds->GetNumberOfIds())
+      {
+        std::cerr << "Wrong size of cell " << outCellId << std::endl;
+        return false;
+      }
+      for (vtkIdType i = 0; i < inIds->GetNumberOfIds(); ++i)
+      {
+        if (cellType == VTK_POLYHEDRON && (i == 0 || (i - 1) % 5 == 0))
+        {
+          continue;
+        }
+        double inX[3], outX[3];
+        block->GetPoint(inIds->GetId(i), inX);
+        output->GetPoint(outIds->GetId(i), outX);
+        if (inX[0] != outX[0] || inX[1] != outX[1] || inX[2] != outX[2] ||
+          data->GetTuple1(outIds->GetId(i)) != DataValue(inX))
+        {
+          std::cerr << "Wrong point " << i << " of cell " << outCellId << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return outCellId == output->GetNumberOfCells();
+}
+
+vtkIdType CountUniquePoints(vtkDataSet* output)
+{
+  std::vector<std::array<double, 3>> points(output->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    output->GetPoint(i, points[i].data());
+  }
+  std::sort(points.begin(), points.end());
+  return static_cast<vtkIdType>(std::unique(points.begin(), points.end()) - points.begin());
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> Append(
+  const std::vector<vtkSmartPointer<vtkUnstructuredGrid>>& blocks, bool merge, bool globalIds)
+{
+  vtkNew<vtkAppendFilter> append;
+  for (vtkUnstructuredGrid* block : blocks)
+  {
+    if (globalIds)
+    {
+      append->AddInputData(block);
+    }
+    else
+    {
+      auto copy = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      copy->ShallowCopy(block);
+      copy->GetPointData()->SetGlobalIds(nullptr);
+      append->AddInputData(copy);
+    }
+  }
+  append->SetMergePoints(merge);
+  append->Update();
+  return append->GetOutput();
+}
+
+template <typename T>
+bool SameOutput(T* output1, T* output2)
+{
+  if (output1->GetNumberOfPoints() != output2->GetNumberOfPoints() ||
+    output1->GetNumberOfCells() != output2->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < output1->GetNumberOfPoints(); ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      if (output1->GetPoint(i)[j] != output2->GetPoint(i)[j])
+      {
+        return false;
+      }
+    }
+  }
+  vtkNew<vtkIdList> pts1, pts2;
+  for (vtkIdType i = 0; i < output1->GetNumberOfCells(); ++i)
+  {
+    output1->GetCellPoints(i, pts1);
+    output2->GetCellPoints(i, pts2);
+    if (pts1->GetNumberOfIds() != pts2->GetNumberOfIds())
+    {
+      return false;
+    }
+    for (vtkIdType j = 0; j < pts1->GetNumberOfIds(); ++j)
+    {
+      if (pts1->GetId(j) != pts2->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Polydata with one cell of each type per point of a line, with the cell
+// data giving the cell type.
+vtkSmartPointer<vtkPolyData> MakePolyData(int numPoints, double y)
+{
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> cells[4];
+  vtkNew<vtkDoubleArray> cellData;
+  cellData->SetName("CellType");
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    points->InsertNextPoint(i, y, 0.0);
+  }
+  for (vtkIdType i = 0; i + 2 < numPoints; ++i)
+  {
+    const vtkIdType pts[3] = { i, i + 1, i + 2 };
+    const int sizes[4] = { 1, 2, 3, 3 };
+    for (int type = 0; type < 4; ++type)
+    {
+      cells[type]->InsertNextCell(sizes[type], pts);
+    }
+  }
+  polyData->SetPoints(points);
+  polyData->SetVerts(cells[0]);
+  polyData->SetLines(cells[1]);
+  polyData->SetPolys(cells[2]);
+  polyData->SetStrips(cells[3]);
+  for (int type = 0; type < 4; ++type)
+  {
+    for (vtkIdType i = 0; i < cells[type]->GetNumberOfCells(); ++i)
+    {
+      cellData->InsertNextValue(type);
+    }
+  }
+  polyData->GetCellData()->AddArray(cellData);
+  return polyData;
+}
+
+vtkSmartPointer<vtkPolyData> AppendPolyData(const std::vector<vtkSmartPointer<vtkPolyData>>& inputs)
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (vtkPolyData* input : inputs)
+  {
+    append->AddInputData(input);
+  }
+  append->Update();
+  return append->GetOutput();
+}
+
+bool TestPolyData()
+{
+  std::vector<vtkSmartPointer<vtkPolyData>> inputs;
+  for (int i = 0; i < 40; ++i)
+  {
+    inputs.push_back(MakePolyData(5 + i % 3, i));
+  }
+  inputs.push_back(MakePolyData(20000, 40));
+  vtkSmartPointer<vtkPolyData> output = AppendPolyData(inputs);
+
+  // the cells of each type follow the cells of the previous types, in the
+  // order of the inputs
+  vtkDataArray* cellData = output->GetCellData()->GetArray("CellType");
+  vtkNew<vtkIdList> inIds, outIds;
+  vtkIdType outCellId = 0;
+  for (int type = 0; type < 4; ++type)
+  {
+    for (vtkPolyData* input : inputs)
+    {
+      vtkIdType numCells = input->GetNumberOfCells() / 4;
+      for (vtkIdType cellId = type * numCells; cellId < (type + 1) * numCells; ++cellId)
+      {
+        input->GetCellPoints(cellId, inIds);
+        output->GetCellPoints(outCellId, outIds);
+        if (output->GetCellType(outCellId) != input->GetCellType(cellId) ||
+          cellData->GetTuple1(outCellId) != type ||
+          inIds->GetNumberOfIds() != outIds->GetNumberOfIds())
+        {
+          std::cerr << "Wrong appended cell " << outCellId << std::endl;
+          return false;
+        }
+        for (vtkIdType i = 0; i < inIds->GetNumberOfIds(); ++i)
+        {
+          double inX[3], outX[3];
+          input->GetPoint(inIds->GetId(i), inX);
+          output->GetPoint(outIds->GetId(i), outX);
+          if (inX[0] != outX[0] || inX[1] != outX[1] || inX[2] != outX[2])
+          {
+            std::cerr << "Wrong point " << i << " of appended cell " << outCellId << std::endl;
+            return false;
+          }
+        }
+        ++outCellId;
+      }
+    }
+  }
+  if (outCellId != output->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of appended cells" << std::endl;
+    return false;
+  }
+
+  // the output does not depend on the number of threads
+  vtkSMPTools::Initialize(1);
+  vtkSmartPointer<vtkPolyData> serialOutput = AppendPolyData(inputs);
+  vtkSMPTools::Initialize();
+  if (!SameOutput<vtkPolyData>(output, serialOutput))
+  {
+    std::cerr << "Appended polydata differs with a single thread" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestAppendManyInputs(int, char*[])
+{
+  std::vector<vtkSmartPointer<vtkUnstructuredGrid>> blocks = MakeBlocks();
+  vtkIdType numPoints = 0;
+  for (vtkUnstructuredGrid* block : blocks)
+  {
+    numPoints += block->GetNumberOfPoints();
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> appended = Append(blocks, false, false);
+  if (appended->GetNumberOfPoints() != numPoints || !CheckCells(blocks, appended))
+  {
+    std::cerr << "Wrong output without merging" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const vtkIdType numUniquePoints = CountUniquePoints(appended);
+
+  for (int globalIds = 0; globalIds < 2; ++globalIds)
+  {
+    vtkSmartPointer<vtkUnstructuredGrid> merged = Append(blocks, true, globalIds != 0);
+    if (merged->GetNumberOfPoints() != numUniquePoints ||
+      CountUniquePoints(merged) != numUniquePoints || !CheckCells(blocks, merged))
+    {
+      std::cerr << "Wrong output when merging with global ids " << globalIds << ": "
+                << merged->GetNumberOfPoints() << " points instead of " << numUniquePoints
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // the output does not depend on the number of threads
+    vtkSMPTools::Initialize(1);
+    vtkSmartPointer<vtkUnstructuredGrid> serialMerged = Append(blocks, true, globalIds != 0);
+    vtkSMPTools::Initialize();
+    if (!SameOutput<vtkUnstructuredGrid>(merged, serialMerged))
+    {
+      std::cerr << "Output differs with a single thread when merging with global ids "
+                << globalIds << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!TestPolyData())
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
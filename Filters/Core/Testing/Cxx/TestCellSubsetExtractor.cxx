@@ -0,0 +1,343 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellSubsetExtractor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check the cells, points and attributes extracted by vtkCellSubsetExtractor
+// and vtkThreshold against a serial evaluation of the threshold, and that
+// the output does not depend on the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellSubsetExtractor.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractGeometry.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphere.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int Dim = 21;
+const double Lower = -0.3;
+const double Upper = 0.5;
+
+// Hexahedra with 32-bit connectivity followed by a polyhedron, with point
+// scalars oscillating through the grid.
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+        scalars->InsertNextValue(std::sin(0.7 * i) * std::cos(0.4 * j + 0.3 * k));
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->Allocate((Dim - 1) * (Dim - 1) * (Dim - 1) + 1);
+  grid->GetCells()->Use32BitStorage();
+  vtkIdType hex[8];
+  for (int k = 0; k < Dim - 1; ++k)
+  {
+    for (int j = 0; j < Dim - 1; ++j)
+    {
+      for (int i = 0; i < Dim - 1; ++i)
+      {
+        vtkIdType p = i + Dim * (j + Dim * k);
+        vtkIdType pts[8] = { p, p + 1, p + 1 + Dim, p + Dim, p + Dim * Dim, p + 1 + Dim * Dim,
+          p + 1 + Dim + Dim * Dim, p + Dim + Dim * Dim };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+        std::copy(pts, pts + 8, hex);
+      }
+    }
+  }
+  // the last hexahedron as a polyhedron
+  vtkIdType faces[] = { 4, hex[0], hex[3], hex[2], hex[1], 4, hex[4], hex[5], hex[6], hex[7], 4,
+    hex[0], hex[1], hex[5], hex[4], 4, hex[1], hex[2], hex[6], hex[5], 4, hex[2], hex[3], hex[7],
+    hex[6], 4, hex[3], hex[0], hex[4], hex[7] };
+  grid->InsertNextCell(VTK_POLYHEDRON, 8, hex, 6, faces);
+  for (vtkIdType ptId : hex)
+  {
+    scalars->SetValue(ptId, 0.0);
+  }
+}
+
+bool InRange(vtkDataArray* scalars, vtkIdList* ptIds)
+{
+  for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+  {
+    double s = scalars->GetTuple1(ptIds->GetId(i));
+    if (s < Lower || s > Upper)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check that the output cells are the expected input cells, with the same
+// point coordinates and scalars.
+bool CheckOutput(vtkUnstructuredGrid* input, vtkUnstructuredGrid* output,
+  const std::vector<vtkIdType>& expectedCells)
+{
+  if (output->GetNumberOfCells() != static_cast<vtkIdType>(expectedCells.size()))
+  {
+    std::cerr << "Extracted " << output->GetNumberOfCells() << " cells instead of "
+              << expectedCells.size() << std::endl;
+    return false;
+  }
+  if (output->GetCells()->IsStorage64Bit())
+  {
+    std::cerr << "The 32-bit connectivity was not kept" << std::endl;
+    return false;
+  }
+  vtkDataArray* inScalars = input->GetPointData()->GetScalars();
+  vtkDataArray* outScalars = output->GetPointData()->GetScalars();
+  if (!outScalars)
+  {
+    std::cerr << "Missing point scalars" << std::endl;
+    return false;
+  }
+  vtkNew<vtkIdList> inIds, outIds;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType inCellId = expectedCells[cellId];
+    if (output->GetCellType(cellId) != input->GetCellType(inCellId))
+    {
+      std::cerr << "Wrong type of cell " << cellId << std::endl;
+      return false;
+    }
+    // the face stream of the polyhedron, made of quads, starts with the
+    // number of faces and gives the number of points before each face
+    bool polyhedron = input->GetCellType(inCellId) == VTK_POLYHEDRON;
+    if (polyhedron)
+    {
+      input->GetFaceStream(inCellId, inIds);
+      output->GetFaceStream(cellId, outIds);
+    }
+    else
+    {
+      input->GetCellPoints(inCellId, inIds);
+      output->GetCellPoints(cellId, outIds);
+    }
+    if (inIds->GetNumberOfIds() != outIds->GetNumberOfIds())
+    {
+      std::cerr << "Wrong size of cell " << cellId << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < inIds->GetNumberOfIds(); ++i)
+    {
+      if (polyhedron && (i == 0 || (i - 1) % 5 == 0))
+      {
+        if (inIds->GetId(i) != outIds->GetId(i))
+        {
+          std::cerr << "Wrong face stream of cell " << cellId << std::endl;
+          return false;
+        }
+        continue;
+      }
+      vtkIdType inId = inIds->GetId(i);
+      vtkIdType outId = outIds->GetId(i);
+      double inX[3], outX[3];
+      input->GetPoint(inId, inX);
+      output->GetPoint(outId, outX);
+      if (inX[0] != outX[0] || inX[1] != outX[1] || inX[2] != outX[2] ||
+        inScalars->GetTuple1(inId) != outScalars->GetTuple1(outId))
+      {
+        std::cerr << "Wrong point " << i << " of cell " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> Threshold(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputData(grid);
+  threshold->SetLowerThreshold(Lower);
+  threshold->SetUpperThreshold(Upper);
+  threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+  threshold->Update();
+  return threshold->GetOutput();
+}
+
+bool SameOutput(vtkUnstructuredGrid* output1, vtkUnstructuredGrid* output2)
+{
+  if (output1->GetNumberOfPoints() != output2->GetNumberOfPoints() ||
+    output1->GetNumberOfCells() != output2->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < output1->GetNumberOfPoints(); ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      if (output1->GetPoint(i)[j] != output2->GetPoint(i)[j])
+      {
+        return false;
+      }
+    }
+  }
+  vtkNew<vtkIdList> pts1, pts2;
+  for (vtkIdType i = 0; i < output1->GetNumberOfCells(); ++i)
+  {
+    output1->GetCellPoints(i, pts1);
+    output2->GetCellPoints(i, pts2);
+    for (vtkIdType j = 0; j < pts1->GetNumberOfIds(); ++j)
+    {
+      if (pts1->GetId(j) != pts2->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// A grid without cell array, as after Initialize(), with or without points,
+// gives an empty output.
+bool TestGridWithoutCells(int numPoints)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->Initialize();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int i = 0; i < numPoints; ++i)
+  {
+    points->InsertNextPoint(i, 0.0, 0.0);
+    scalars->InsertNextValue(0.1 * i);
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+
+  vtkSmartPointer<vtkUnstructuredGrid> thresholded = Threshold(grid);
+  if (thresholded->GetNumberOfCells() != 0)
+  {
+    std::cerr << "vtkThreshold extracted cells from a grid without cells" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkSphere> sphere;
+  sphere->SetRadius(10.0);
+  vtkNew<vtkExtractGeometry> extract;
+  extract->SetInputData(grid);
+  extract->SetImplicitFunction(sphere);
+  extract->Update();
+  if (extract->GetOutput()->GetNumberOfCells() != 0)
+  {
+    std::cerr << "vtkExtractGeometry extracted cells from a grid without cells" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCellSubsetExtractor(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+  vtkDataArray* scalars = grid->GetPointData()->GetScalars();
+
+  std::vector<vtkIdType> expectedCells;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCellPoints(cellId, ptIds);
+    if (InRange(scalars, ptIds))
+    {
+      expectedCells.push_back(cellId);
+    }
+  }
+  if (expectedCells.empty() || expectedCells.back() != grid->GetNumberOfCells() - 1)
+  {
+    std::cerr << "The polyhedron should be in range" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the extractor gives the input ids of the output points and cells, the
+  // points by increasing id
+  vtkNew<vtkCellSubsetExtractor> extractor;
+  vtkNew<vtkUnstructuredGrid> output;
+  vtkNew<vtkPoints> newPoints;
+  extractor->Extract(grid,
+    [&](vtkIdType, vtkIdList* cellPts) { return InRange(scalars, cellPts); }, nullptr,
+    newPoints, output);
+  if (!CheckOutput(grid, output, expectedCells))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkIdList* pointIds = extractor->GetPointIds();
+  vtkIdList* cellIds = extractor->GetCellIds();
+  for (vtkIdType i = 0; i < pointIds->GetNumberOfIds(); ++i)
+  {
+    if (i > 0 && pointIds->GetId(i) <= pointIds->GetId(i - 1))
+    {
+      std::cerr << "The output points are not ordered by input id" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+  {
+    if (cellIds->GetId(i) != expectedCells[i])
+    {
+      std::cerr << "Wrong input id of cell " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> thresholded = Threshold(grid);
+  if (!CheckOutput(grid, thresholded, expectedCells))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the output does not depend on the number of threads
+  vtkSMPTools::Initialize(1);
+  vtkSmartPointer<vtkUnstructuredGrid> serialThresholded = Threshold(grid);
+  vtkSMPTools::Initialize();
+  if (!SameOutput(thresholded, serialThresholded))
+  {
+    std::cerr << "Output differs with a single thread" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Empty grid, and grid with points only
+  if (!TestGridWithoutCells(0) || !TestGridWithoutCells(2))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,333 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCleanPolyDataParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that the threaded vtkCleanPolyData gives the output of the
+// incremental one, used by subclasses, and that the outputs of
+// vtkCleanPolyData and vtkStaticCleanPolyData do not depend on the number of
+// threads. Also check that the threaded vtkCleanPolyData can be aborted.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkCommand.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCleanPolyData.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// A subclass always cleaning with the incremental insertion of the points
+class IncrementalCleanPolyData : public vtkCleanPolyData
+{
+public:
+  static IncrementalCleanPolyData* New();
+  vtkTypeMacro(IncrementalCleanPolyData, vtkCleanPolyData);
+
+protected:
+  bool OperatesOnPoints() override { return true; }
+};
+vtkStandardNewMacro(IncrementalCleanPolyData);
+
+const int Dim = 40;
+
+// A grid of points where each point appears twice, an unused point, and
+// cells of all the types with repeated points, some of them degenerate.
+vtkSmartPointer<vtkPolyData> MakePolyData()
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointData;
+  pointData->SetName("PointData");
+  for (int copy = 0; copy < 2; ++copy)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, 0.0);
+        pointData->InsertNextValue(copy * Dim * Dim + i + Dim * j);
+      }
+    }
+  }
+  // Pick one of the two copies of a grid point
+  auto pick = [&](int i, int j) {
+    random->Next();
+    return (random->GetValue() < 0.5 ? 0 : Dim * Dim) + i + Dim * j;
+  };
+
+  vtkNew<vtkCellArray> verts, lines, polys, strips;
+  vtkNew<vtkIntArray> cellData;
+  cellData->SetName("CellData");
+  for (int j = 0; j < Dim - 1; j += 3)
+  {
+    for (int i = 0; i < Dim - 1; ++i)
+    {
+      vtkIdType vert[3] = { pick(i, j), pick(i, j), pick(i + 1, j) };
+      verts->InsertNextCell(1 + (i % 3), vert);
+      vtkIdType line[4] = { pick(i, j), pick(i + (i % 2), j), pick(i, j + 1), pick(i, j + 1) };
+      lines->InsertNextCell(2 + (i % 3), line);
+      vtkIdType degenerateLine[2] = { pick(i, j), pick(i, j) };
+      lines->InsertNextCell(2, degenerateLine);
+    }
+  }
+  for (int j = 0; j < Dim - 1; ++j)
+  {
+    for (int i = 0; i < Dim - 1; ++i)
+    {
+      // quads degenerating into triangles, lines or vertices, some closed
+      // explicitly
+      vtkIdType quad[5] = { pick(i, j), pick(i + 1, j), pick(i + 1, j + 1), pick(i, j + 1),
+        pick(i, j) };
+      switch ((i + j) % 5)
+      {
+        case 1:
+          quad[2] = pick(i + 1, j);
+          break;
+        case 2:
+          quad[2] = pick(i + 1, j);
+          quad[3] = pick(i, j);
+          break;
+        case 3:
+          quad[1] = quad[2] = quad[3] = pick(i, j);
+          break;
+        default:
+          break;
+      }
+      polys->InsertNextCell((i + j) % 2 ? 5 : 4, quad);
+      vtkIdType strip[5] = { pick(i, j), pick(i + 1, j), pick(i, j + 1), pick(i + 1, j + 1),
+        pick(i, j) };
+      if (j % 3 == 1)
+      {
+        strip[3] = strip[2];
+        strip[1] = pick(i, j);
+      }
+      strips->InsertNextCell(3 + ((i + j) % 3), strip);
+    }
+  }
+  // compact storage for the polygons
+  polys->ConvertTo32BitStorage();
+
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  points->InsertNextPoint(-1.0, -1.0, -1.0); // unused
+  pointData->InsertNextValue(-1.0);
+  polyData->SetPoints(points);
+  polyData->GetPointData()->AddArray(pointData);
+  polyData->SetVerts(verts);
+  polyData->SetLines(lines);
+  polyData->SetPolys(polys);
+  polyData->SetStrips(strips);
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); ++cellId)
+  {
+    cellData->InsertNextValue(static_cast<int>(cellId));
+  }
+  polyData->GetCellData()->AddArray(cellData);
+  return polyData;
+}
+
+bool SameCells(vtkCellArray* cells1, vtkCellArray* cells2)
+{
+  if (cells1->GetNumberOfCells() != cells2->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkNew<vtkIdList> pts1, pts2;
+  for (vtkIdType cellId = 0; cellId < cells1->GetNumberOfCells(); ++cellId)
+  {
+    cells1->GetCellAtId(cellId, pts1);
+    cells2->GetCellAtId(cellId, pts2);
+    if (pts1->GetNumberOfIds() != pts2->GetNumberOfIds())
+    {
+      return false;
+    }
+    for (vtkIdType i = 0; i < pts1->GetNumberOfIds(); ++i)
+    {
+      if (pts1->GetId(i) != pts2->GetId(i))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameArray(vtkDataArray* array1, vtkDataArray* array2)
+{
+  if (!array1 || !array2 || array1->GetNumberOfTuples() != array2->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < array1->GetNumberOfTuples(); ++i)
+  {
+    if (array1->GetTuple1(i) != array2->GetTuple1(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* output1, vtkPolyData* output2)
+{
+  if (output1->GetNumberOfPoints() != output2->GetNumberOfPoints())
+  {
+    std::cerr << "Different number of points" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output1->GetNumberOfPoints(); ++ptId)
+  {
+    double x1[3], x2[3];
+    output1->GetPoint(ptId, x1);
+    output2->GetPoint(ptId, x2);
+    if (x1[0] != x2[0] || x1[1] != x2[1] || x1[2] != x2[2])
+    {
+      std::cerr << "Different point " << ptId << std::endl;
+      return false;
+    }
+  }
+  if (!SameCells(output1->GetVerts(), output2->GetVerts()) ||
+    !SameCells(output1->GetLines(), output2->GetLines()) ||
+    !SameCells(output1->GetPolys(), output2->GetPolys()) ||
+    !SameCells(output1->GetStrips(), output2->GetStrips()))
+  {
+    std::cerr << "Different cells" << std::endl;
+    return false;
+  }
+  if (!SameArray(output1->GetPointData()->GetArray("PointData"),
+        output2->GetPointData()->GetArray("PointData")) ||
+    !SameArray(output1->GetCellData()->GetArray("CellData"),
+      output2->GetCellData()->GetArray("CellData")))
+  {
+    std::cerr << "Different attributes" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename CleanT>
+vtkSmartPointer<vtkPolyData> Clean(vtkPolyData* input, bool merging, bool convert)
+{
+  vtkNew<CleanT> clean;
+  clean->SetInputData(input);
+  clean->SetPointMerging(merging);
+  clean->SetConvertLinesToPoints(convert);
+  clean->SetConvertPolysToLines(convert);
+  clean->SetConvertStripsToPolys(convert);
+  clean->Update();
+  return clean->GetOutput();
+}
+
+vtkSmartPointer<vtkPolyData> StaticClean(vtkPolyData* input, bool convert, bool average)
+{
+  vtkNew<vtkStaticCleanPolyData> clean;
+  clean->SetInputData(input);
+  clean->SetConvertLinesToPoints(convert);
+  clean->SetConvertPolysToLines(convert);
+  clean->SetConvertStripsToPolys(convert);
+  clean->SetAveragePointData(average);
+  clean->SetTolerance(0.01);
+  clean->Update();
+  return clean->GetOutput();
+}
+
+// Abort the execution of the filter at its first progress event.
+class AbortCommand : public vtkCommand
+{
+public:
+  static AbortCommand* New() { return new AbortCommand; }
+  void Execute(vtkObject* caller, unsigned long, void*) override
+  {
+    vtkAlgorithm::SafeDownCast(caller)->AbortExecuteOn();
+  }
+};
+}
+
+int TestCleanPolyDataParallel(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = MakePolyData();
+
+  for (int merging = 0; merging < 2; ++merging)
+  {
+    for (int convert = 0; convert < 2; ++convert)
+    {
+      vtkSmartPointer<vtkPolyData> expected =
+        Clean<IncrementalCleanPolyData>(input, merging != 0, convert != 0);
+      vtkSmartPointer<vtkPolyData> output =
+        Clean<vtkCleanPolyData>(input, merging != 0, convert != 0);
+      if (!SameOutput(expected, output))
+      {
+        std::cerr << "Wrong output with PointMerging " << merging << " and conversions "
+                  << convert << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (merging && output->GetNumberOfPoints() != Dim * Dim)
+      {
+        std::cerr << "The points were not merged" << std::endl;
+        return EXIT_FAILURE;
+      }
+      vtkSMPTools::Initialize(1);
+      vtkSmartPointer<vtkPolyData> serialOutput =
+        Clean<vtkCleanPolyData>(input, merging != 0, convert != 0);
+      vtkSMPTools::Initialize();
+      if (!SameOutput(output, serialOutput))
+      {
+        std::cerr << "Output differs with a single thread" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  for (int convert = 0; convert < 2; ++convert)
+  {
+    for (int average = 0; average < 2; ++average)
+    {
+      vtkSmartPointer<vtkPolyData> output = StaticClean(input, convert != 0, average != 0);
+      vtkSMPTools::Initialize(1);
+      vtkSmartPointer<vtkPolyData> serialOutput = StaticClean(input, convert != 0, average != 0);
+      vtkSMPTools::Initialize();
+      if (output->GetNumberOfPoints() != Dim * Dim || !SameOutput(output, serialOutput))
+      {
+        std::cerr << "Static clean output differs with a single thread with conversions "
+                  << convert << " and averaging " << average << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputData(input);
+  vtkNew<AbortCommand> abort;
+  clean->AddObserver(vtkCommand::ProgressEvent, abort);
+  clean->Update();
+  if (clean->GetOutput()->GetNumberOfPoints() != 0 || clean->GetOutput()->GetNumberOfCells() != 0)
+  {
+    std::cerr << "The output of an aborted clean is not empty" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContourFilterScalarTree.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that contouring an unstructured grid of linear cells with a scalar
+// tree gives the same isosurface as without, while the contour value
+// changes.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkContourFilter.h"
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMassProperties.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSpanSpace.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Dim = 20;
+
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Distance");
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+        scalars->InsertNextValue(
+          static_cast<float>(std::sqrt((i - 9.5) * (i - 9.5) + (j - 9.5) * (j - 9.5) + k * k)));
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->Allocate((Dim - 1) * (Dim - 1) * (Dim - 1));
+  for (int k = 0; k < Dim - 1; ++k)
+  {
+    for (int j = 0; j < Dim - 1; ++j)
+    {
+      for (int i = 0; i < Dim - 1; ++i)
+      {
+        vtkIdType p = i + Dim * (j + Dim * k);
+        vtkIdType pts[8] = { p, p + 1, p + 1 + Dim, p + Dim, p + Dim * Dim, p + 1 + Dim * Dim,
+          p + 1 + Dim + Dim * Dim, p + Dim + Dim * Dim };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+      }
+    }
+  }
+}
+
+double SurfaceArea(vtkPolyData* surface)
+{
+  vtkNew<vtkMassProperties> mass;
+  mass->SetInputData(surface);
+  mass->Update();
+  return mass->GetSurfaceArea();
+}
+}
+
+int TestContourFilterScalarTree(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+
+  vtkNew<vtkContourFilter> reference;
+  reference->SetInputData(grid);
+
+  vtkNew<vtkContourFilter> contour;
+  contour->SetInputData(grid);
+  contour->UseScalarTreeOn();
+
+  for (double value = 4.25; value < 16.0; value += 2.0)
+  {
+    reference->SetValue(0, value);
+    reference->Update();
+    contour->SetValue(0, value);
+    contour->Update();
+
+    vtkPolyData* expected = reference->GetOutput();
+    vtkPolyData* output = contour->GetOutput();
+    const double expectedArea = SurfaceArea(expected);
+    const double area = SurfaceArea(output);
+    if (output->GetNumberOfPolys() == 0 || std::abs(area - expectedArea) > 1e-3 * expectedArea)
+    {
+      std::cerr << "Wrong isosurface for " << value << ": " << output->GetNumberOfPolys()
+                << " triangles of area " << area << " instead of " << expected->GetNumberOfPolys()
+                << " triangles of area " << expectedArea << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkDataArray* scalars = output->GetPointData()->GetArray("Distance");
+    if (!scalars || scalars->GetNumberOfTuples() != output->GetNumberOfPoints())
+    {
+      std::cerr << "Missing point data for " << value << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+      if (std::abs(scalars->GetTuple1(i) - value) > 1e-4)
+      {
+        std::cerr << "Wrong scalar " << scalars->GetTuple1(i) << " for " << value << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (!vtkSpanSpace::SafeDownCast(contour->GetScalarTree()))
+  {
+    std::cerr << "The default scalar tree is not a vtkSpanSpace" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Cell data is not handled by vtkContour3DLinearGrid, the grid is
+  // contoured cell by cell.
+  vtkNew<vtkFloatArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  cellScalars->SetNumberOfTuples(grid->GetNumberOfCells());
+  cellScalars->FillValue(1.0f);
+  grid->GetCellData()->AddArray(cellScalars);
+  contour->Update();
+  if (!contour->GetOutput()->GetCellData()->GetArray("CellScalars") ||
+    contour->GetOutput()->GetNumberOfPolys() == 0)
+  {
+    std::cerr << "Missing cell data" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
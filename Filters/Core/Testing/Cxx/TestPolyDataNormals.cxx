@@ -0,0 +1,182 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataNormals.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check the consistency, splitting and point normals of vtkPolyDataNormals
+// on many cubes whose faces are inconsistently ordered, and that the output
+// does not depend on the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int NumberOfCubes = 500;
+
+// Cubes of unit size along the x axis. The first face of each cube is
+// ordered outward, every third other face is reversed.
+void MakeCubes(vtkPolyData* cubes)
+{
+  static const vtkIdType faces[6][4] = { { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 },
+    { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  for (int c = 0; c < NumberOfCubes; ++c)
+  {
+    double x = 2.0 * c;
+    vtkIdType base = points->GetNumberOfPoints();
+    for (int k = 0; k < 2; ++k)
+    {
+      points->InsertNextPoint(x, 0, k);
+      points->InsertNextPoint(x + 1, 0, k);
+      points->InsertNextPoint(x + 1, 1, k);
+      points->InsertNextPoint(x, 1, k);
+    }
+    for (int f = 0; f < 6; ++f)
+    {
+      vtkIdType pts[4];
+      bool reverse = f > 0 && (c + f) % 3 == 0;
+      for (int i = 0; i < 4; ++i)
+      {
+        pts[i] = base + faces[f][reverse ? 3 - i : i];
+      }
+      polys->InsertNextCell(4, pts);
+    }
+  }
+  cubes->SetPoints(points);
+  cubes->SetPolys(polys);
+}
+
+// Check that the normals point out of their cube.
+bool CheckOutward(vtkPolyData* output, bool split)
+{
+  vtkDataArray* normals = output->GetPointData()->GetNormals();
+  if (!normals)
+  {
+    std::cerr << "Missing normals" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    double p[3], n[3];
+    output->GetPoint(i, p);
+    normals->GetTuple(i, n);
+    double center[3] = { 2.0 * std::floor(p[0] / 2.0) + 0.5, 0.5, 0.5 };
+    double dot = 0.0;
+    int numberOfAxes = 0;
+    for (int j = 0; j < 3; ++j)
+    {
+      dot += n[j] * (p[j] - center[j]);
+      numberOfAxes += std::fabs(n[j]) > 1e-6;
+    }
+    // the normals of split points are the normals of the faces
+    if (dot <= 0.0 || (split && numberOfAxes != 1) || (!split && numberOfAxes != 3))
+    {
+      std::cerr << "Wrong normal (" << n[0] << ", " << n[1] << ", " << n[2] << ") at point "
+                << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkPolyData> ComputeNormals(vtkPolyData* cubes, bool split)
+{
+  vtkNew<vtkPolyDataNormals> normals;
+  normals->SetInputData(cubes);
+  normals->SetSplitting(split);
+  normals->ConsistencyOn();
+  normals->Update();
+  return normals->GetOutput();
+}
+
+bool SameOutput(vtkPolyData* output1, vtkPolyData* output2)
+{
+  if (output1->GetNumberOfPoints() != output2->GetNumberOfPoints() ||
+    output1->GetNumberOfCells() != output2->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkDataArray* normals1 = output1->GetPointData()->GetNormals();
+  vtkDataArray* normals2 = output2->GetPointData()->GetNormals();
+  for (vtkIdType i = 0; i < output1->GetNumberOfPoints(); ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      if (output1->GetPoint(i)[j] != output2->GetPoint(i)[j] ||
+        normals1->GetComponent(i, j) != normals2->GetComponent(i, j))
+      {
+        return false;
+      }
+    }
+  }
+  vtkNew<vtkIdList> pts1, pts2;
+  for (vtkIdType i = 0; i < output1->GetNumberOfCells(); ++i)
+  {
+    output1->GetCellPoints(i, pts1);
+    output2->GetCellPoints(i, pts2);
+    for (vtkIdType j = 0; j < pts1->GetNumberOfIds(); ++j)
+    {
+      if (pts1->GetId(j) != pts2->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPolyDataNormals(int, char*[])
+{
+  vtkNew<vtkPolyData> cubes;
+  MakeCubes(cubes);
+
+  for (int split = 0; split < 2; ++split)
+  {
+    vtkSmartPointer<vtkPolyData> output = ComputeNormals(cubes, split != 0);
+    vtkIdType expectedPoints = split ? 24 * NumberOfCubes : 8 * NumberOfCubes;
+    if (output->GetNumberOfPoints() != expectedPoints || !CheckOutward(output, split != 0))
+    {
+      std::cerr << "Wrong output with splitting " << split << ": "
+                << output->GetNumberOfPoints() << " points instead of " << expectedPoints
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // the output does not depend on the number of threads
+    vtkSMPTools::Initialize(1);
+    vtkSmartPointer<vtkPolyData> serialOutput = ComputeNormals(cubes, split != 0);
+    vtkSMPTools::Initialize();
+    if (!SameOutput(output, serialOutput))
+    {
+      std::cerr << "Output differs with a single thread with splitting " << split << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,258 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThresholdMeshCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that vtkThreshold reuses its output mesh while only the attributes
+// of a static mesh change, and extracts it again when the mesh or the
+// thresholded array change.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataObjectMeshCache.h"
+#include "vtkIdList.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Dim = 10;
+
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+
+  vtkNew<vtkFloatArray> material;
+  material->SetName("Material");
+  grid->Allocate((Dim - 1) * (Dim - 1) * (Dim - 1));
+  for (int k = 0; k < Dim - 1; ++k)
+  {
+    for (int j = 0; j < Dim - 1; ++j)
+    {
+      for (int i = 0; i < Dim - 1; ++i)
+      {
+        vtkIdType p = i + Dim * (j + Dim * k);
+        vtkIdType pts[8] = { p, p + 1, p + 1 + Dim, p + Dim, p + Dim * Dim, p + 1 + Dim * Dim,
+          p + 1 + Dim + Dim * Dim, p + Dim + Dim * Dim };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+        material->InsertNextValue(i < Dim / 2 ? 1.0f : 2.0f);
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(material);
+}
+
+// Point data equal to the point id plus the time, and cell data equal to
+// the cell id plus the time.
+void SetTime(vtkUnstructuredGrid* grid, float time)
+{
+  vtkNew<vtkFloatArray> temperature;
+  temperature->SetName("Temperature");
+  temperature->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+  {
+    temperature->SetValue(i, i + time);
+  }
+  grid->GetPointData()->AddArray(temperature);
+
+  vtkNew<vtkFloatArray> pressure;
+  pressure->SetName("Pressure");
+  pressure->SetNumberOfTuples(grid->GetNumberOfCells());
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    pressure->SetValue(i, i + time);
+  }
+  grid->GetCellData()->AddArray(pressure);
+}
+
+// Compare the attributes of the output with those of a threshold without
+// cache.
+bool CheckOutput(vtkUnstructuredGrid* grid, vtkThreshold* threshold, const char* step)
+{
+  vtkNew<vtkThreshold> reference;
+  reference->SetInputData(grid);
+  reference->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "Material");
+  reference->SetLowerThreshold(threshold->GetLowerThreshold());
+  reference->SetUpperThreshold(threshold->GetUpperThreshold());
+  reference->Update();
+
+  vtkUnstructuredGrid* expected = reference->GetOutput();
+  vtkUnstructuredGrid* output = threshold->GetOutput();
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells() ||
+    output->GetNumberOfCells() == 0)
+  {
+    std::cerr << step << ": " << output->GetNumberOfCells() << " cells instead of "
+              << expected->GetNumberOfCells() << std::endl;
+    return false;
+  }
+
+  const char* pointArrays[1] = { "Temperature" };
+  for (const char* name : pointArrays)
+  {
+    vtkDataArray* array = output->GetPointData()->GetArray(name);
+    vtkDataArray* expectedArray = expected->GetPointData()->GetArray(name);
+    for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+    {
+      if (!array || array->GetTuple1(i) != expectedArray->GetTuple1(i))
+      {
+        std::cerr << step << ": wrong " << name << " of point " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  const char* cellArrays[2] = { "Pressure", "Material" };
+  for (const char* name : cellArrays)
+  {
+    vtkDataArray* array = output->GetCellData()->GetArray(name);
+    vtkDataArray* expectedArray = expected->GetCellData()->GetArray(name);
+    for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+    {
+      if (!array || array->GetTuple1(i) != expectedArray->GetTuple1(i))
+      {
+        std::cerr << step << ": wrong " << name << " of cell " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestThresholdMeshCache(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+  SetTime(grid, 0.0f);
+
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputData(grid);
+  threshold->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "Material");
+  threshold->SetLowerThreshold(1.5);
+  threshold->SetUpperThreshold(2.5);
+  threshold->UseMeshCacheOn();
+  threshold->Update();
+  if (!CheckOutput(grid, threshold, "First execution"))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkPoints* points = threshold->GetOutput()->GetPoints();
+  vtkMTimeType meshMTime = threshold->GetOutput()->GetMeshMTime();
+
+  // Only the attributes change: the mesh is reused.
+  for (int t = 1; t < 4; ++t)
+  {
+    SetTime(grid, static_cast<float>(t));
+    threshold->Update();
+    if (!CheckOutput(grid, threshold, "Attribute change"))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (threshold->GetMeshCache()->GetNumberOfReuses() != 3 ||
+    threshold->GetOutput()->GetPoints() != points ||
+    threshold->GetOutput()->GetMeshMTime() != meshMTime)
+  {
+    std::cerr << "The mesh was not reused: " << threshold->GetMeshCache()->GetNumberOfReuses()
+              << " reuses" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The thresholded array changes.
+  vtkDataArray* material = grid->GetCellData()->GetArray("Material");
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); i += 3)
+  {
+    material->SetTuple1(i, 1.0);
+  }
+  material->Modified();
+  threshold->Update();
+  if (threshold->GetMeshCache()->GetNumberOfReuses() != 3 ||
+    !CheckOutput(grid, threshold, "Thresholded array change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The threshold changes.
+  threshold->SetLowerThreshold(0.5);
+  threshold->Update();
+  if (threshold->GetMeshCache()->GetNumberOfReuses() != 3 ||
+    !CheckOutput(grid, threshold, "Threshold change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The points move.
+  grid->GetPoints()->SetPoint(0, -1.0, -1.0, -1.0);
+  grid->GetPoints()->Modified();
+  SetTime(grid, 4.0f);
+  threshold->Update();
+  double p[3];
+  threshold->GetOutput()->GetPoint(0, p);
+  if (threshold->GetMeshCache()->GetNumberOfReuses() != 3 || p[0] != -1.0 ||
+    !CheckOutput(grid, threshold, "Point change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  SetTime(grid, 5.0f);
+  threshold->Update();
+  if (threshold->GetMeshCache()->GetNumberOfReuses() != 4 ||
+    !CheckOutput(grid, threshold, "Attribute change after point change"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // A mesh with a point without input id is not cached.
+  vtkUnstructuredGrid* output = threshold->GetOutput();
+  vtkNew<vtkIdList> pointIds;
+  pointIds->SetNumberOfIds(output->GetNumberOfPoints());
+  pointIds->Fill(0);
+  pointIds->SetId(0, -1);
+  vtkNew<vtkIdList> cellIds;
+  cellIds->SetNumberOfIds(output->GetNumberOfCells());
+  cellIds->Fill(0);
+  vtkNew<vtkDataObjectMeshCache> cache;
+  cache->UpdateCache(grid, output, pointIds, cellIds, 0);
+  if (cache->IsValid(grid, 0))
+  {
+    std::cerr << "A mesh with a negative point id was cached" << std::endl;
+    return EXIT_FAILURE;
+  }
+  pointIds->SetId(0, 0);
+  cache->UpdateCache(grid, output, pointIds, cellIds, 0);
+  if (!cache->IsValid(grid, 0))
+  {
+    std::cerr << "The mesh was not cached" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
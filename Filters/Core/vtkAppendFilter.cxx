@@ -14,29 +14,266 @@
 =========================================================================*/
 #include "vtkAppendFilter.h"
 
+#include "vtkArrayDispatch.h"
+#include "vtkBitArray.h"
 #include "vtkBoundingBox.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCellType.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSetCollection.h"
 #include "vtkExecutive.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
-#include "vtkIncrementalOctreePointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
-#include <string>
-#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendFilter);
 
+namespace
+{
+// Number of points or cells copied by a task. The inputs are split into
+// blocks so that both many small inputs and a few large ones are spread
+// over the threads.
+const vtkIdType BlockSize = 8192;
+
+// A range of the points or cells of one input.
+struct InputBlock
+{
+  int Input;
+  vtkIdType Begin;
+  vtkIdType End;
+};
+
+std::vector<InputBlock> SplitIntoBlocks(const std::vector<vtkIdType>& sizes)
+{
+  std::vector<InputBlock> blocks;
+  for (int input = 0; input < static_cast<int>(sizes.size()); ++input)
+  {
+    for (vtkIdType begin = 0; begin < sizes[input]; begin += BlockSize)
+    {
+      blocks.push_back({ input, begin, std::min(begin + BlockSize, sizes[input]) });
+    }
+  }
+  return blocks;
+}
+
+// Offsets of the inputs in the appended points or cells, with the total as
+// last value.
+std::vector<vtkIdType> ComputeOffsets(const std::vector<vtkIdType>& sizes)
+{
+  std::vector<vtkIdType> offsets(sizes);
+  offsets.push_back(0);
+  vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(), offsets.begin(), vtkIdType(0));
+  return offsets;
+}
+
+// Bits of a vtkBitArray share bytes and cannot be written concurrently.
+bool CanCopyInParallel(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    if (vtkBitArray::SafeDownCast(attributes->GetAbstractArray(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copy a range of the point coordinates of an input at an offset.
+struct AppendPointsWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(
+    InArrayT* inArray, OutArrayT* outArray, vtkIdType begin, vtkIdType end, vtkIdType offset)
+  {
+    const auto inPts = vtk::DataArrayTupleRange<3>(inArray, begin, end);
+    auto outPts = vtk::DataArrayTupleRange<3>(outArray, begin + offset, end + offset);
+    using OutValueType = vtk::GetAPIType<OutArrayT>;
+    auto outPt = outPts.begin();
+    for (const auto inPt : inPts)
+    {
+      (*outPt)[0] = static_cast<OutValueType>(inPt[0]);
+      (*outPt)[1] = static_cast<OutValueType>(inPt[1]);
+      (*outPt)[2] = static_cast<OutValueType>(inPt[2]);
+      ++outPt;
+    }
+  }
+};
+
+// Copy the coordinates of the merged points from the appended points.
+struct GatherPointsWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* inArray, vtkDataArray* outDataArray, const vtkIdType* pointIds)
+  {
+    ArrayT* outArray = ArrayT::FastDownCast(outDataArray);
+    const auto inPts = vtk::DataArrayTupleRange<3>(inArray);
+    auto outPts = vtk::DataArrayTupleRange<3>(outArray);
+    vtkSMPTools::For(0, outPts.size(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        outPts[i] = inPts[pointIds[i]];
+      }
+    });
+  }
+};
+
+// Thread-safe access to the cells of an input.
+struct InputCells
+{
+  vtkDataSet* DataSet;
+  vtkCellArray* Cells;
+  vtkIdTypeArray* FaceLocations;
+  vtkIdTypeArray* Faces;
+
+  InputCells(vtkDataSet* dataSet, vtkIdList* ptIds)
+    : DataSet(dataSet)
+    , Cells(nullptr)
+    , FaceLocations(nullptr)
+    , Faces(nullptr)
+  {
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(dataSet);
+    if (grid)
+    {
+      this->Cells = grid->GetCells();
+      if (grid->GetFaces())
+      {
+        this->FaceLocations = grid->GetFaceLocations();
+        this->Faces = grid->GetFaces();
+      }
+    }
+    else if (dataSet->GetNumberOfCells() > 0)
+    {
+      // make the input API thread-safe by calling it once in a single thread
+      dataSet->GetCellType(0);
+      dataSet->GetCellPoints(0, ptIds);
+    }
+  }
+
+  // Get the output point ids of a cell. When the points are merged, the
+  // points of a polyhedron may collapse and are then listed once.
+  void GetCellPoints(vtkIdType cellId, int cellType, vtkIdType ptOffset, const vtkIdType* pointMap,
+    vtkIdList* ptIds) const
+  {
+    if (this->Cells)
+    {
+      this->Cells->GetCellAtId(cellId, ptIds);
+    }
+    else
+    {
+      this->DataSet->GetCellPoints(cellId, ptIds);
+    }
+    vtkIdType npts = ptIds->GetNumberOfIds();
+    vtkIdType* pts = ptIds->GetPointer(0);
+    if (!pointMap)
+    {
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        pts[i] += ptOffset;
+      }
+      return;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      pts[i] = pointMap[pts[i] + ptOffset];
+    }
+    if (cellType == VTK_POLYHEDRON)
+    {
+      vtkIdType numUnique = 0;
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        if (std::find(pts, pts + numUnique, pts[i]) == pts + numUnique)
+        {
+          pts[numUnique++] = pts[i];
+        }
+      }
+      ptIds->SetNumberOfIds(numUnique);
+    }
+  }
+
+  // Face stream of a polyhedron, or nullptr.
+  const vtkIdType* GetFaceStream(vtkIdType cellId) const
+  {
+    if (!this->FaceLocations)
+    {
+      return nullptr;
+    }
+    vtkIdType location = this->FaceLocations->GetValue(cellId);
+    return location < 0 ? nullptr : this->Faces->GetPointer(location);
+  }
+};
+
+// Number of values of the face stream of a polyhedron.
+vtkIdType GetFaceStreamSize(const vtkIdType* faceStream)
+{
+  const vtkIdType* face = faceStream;
+  vtkIdType numFaces = *face++;
+  for (vtkIdType i = 0; i < numFaces; ++i)
+  {
+    face += *face + 1;
+  }
+  return static_cast<vtkIdType>(face - faceStream);
+}
+
+// Merge the points sharing a global id. Each point is mapped to the first
+// point with its global id.
+void MergeGlobalIds(const std::vector<vtkDataSet*>& dataSets,
+  const std::vector<vtkIdType>& ptOffsets, const std::vector<InputBlock>& blocks,
+  vtkIdType* mergeMap)
+{
+  const vtkIdType numPts = ptOffsets.back();
+  std::vector<std::pair<vtkIdType, vtkIdType>> globalIds(numPts);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType b = begin; b < end; ++b)
+    {
+      const InputBlock& block = blocks[b];
+      vtkDataArray* ids = dataSets[block.Input]->GetPointData()->GetGlobalIds();
+      const vtkIdType* inputIds = vtkIdTypeArray::SafeDownCast(ids)->GetPointer(0);
+      vtkIdType offset = ptOffsets[block.Input];
+      for (vtkIdType ptId = block.Begin; ptId < block.End; ++ptId)
+      {
+        globalIds[ptId + offset] = std::make_pair(inputIds[ptId], ptId + offset);
+      }
+    }
+  });
+  vtkSMPTools::Sort(globalIds.begin(), globalIds.end());
+
+  // the thread finding the first point of a global id maps all its points
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (i > 0 && globalIds[i].first == globalIds[i - 1].first)
+      {
+        continue;
+      }
+      for (vtkIdType j = i; j < numPts && globalIds[j].first == globalIds[i].first; ++j)
+      {
+        mergeMap[globalIds[j].second] = globalIds[i].second;
+      }
+    }
+  });
+}
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 vtkAppendFilter::vtkAppendFilter()
 {
@@ -120,30 +357,31 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkDebugMacro(<< "Appending data together");
 
-  // Loop over all data sets, checking to see what data is common to
-  // all inputs. Note that data is common if 1) it is the same attribute
-  // type (scalar, vector, etc.), 2) it is the same native type (int,
-  // float, etc.), and 3) if a data array in a field, if it has the same name.
-  vtkIdType totalNumPts = 0;
-  vtkIdType totalNumCells = 0;
+  // Collect the non-empty inputs with their number of points and cells.
   // If we only have a single dataset and it's an unstructured grid
   // we can just shallow copy that and exit quickly.
-  int numDataSets = 0;
-  vtkUnstructuredGrid* inputUG = nullptr;
-
   vtkSmartPointer<vtkDataSetCollection> inputs;
   inputs.TakeReference(this->GetNonEmptyInputs(inputVector));
 
+  std::vector<vtkDataSet*> dataSets;
+  std::vector<vtkIdType> numPoints;
+  std::vector<vtkIdType> numCells;
   vtkCollectionSimpleIterator iter;
   inputs->InitTraversal(iter);
   vtkDataSet* dataSet = nullptr;
   while ((dataSet = inputs->GetNextDataSet(iter)))
   {
-    totalNumPts += dataSet->GetNumberOfPoints();
-    totalNumCells += dataSet->GetNumberOfCells();
-    numDataSets++;
-    inputUG = vtkUnstructuredGrid::SafeDownCast(dataSet);
+    dataSets.push_back(dataSet);
+    numPoints.push_back(dataSet->GetNumberOfPoints());
+    numCells.push_back(dataSet->GetNumberOfCells());
   }
+  const int numDataSets = static_cast<int>(dataSets.size());
+
+  // Offsets of the points and cells of each input in the appended data.
+  const std::vector<vtkIdType> ptOffsets = ComputeOffsets(numPoints);
+  const std::vector<vtkIdType> cellOffsets = ComputeOffsets(numCells);
+  const vtkIdType totalNumPts = ptOffsets.back();
+  const vtkIdType totalNumCells = cellOffsets.back();
 
   if (totalNumPts < 1)
   {
@@ -151,17 +389,14 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  if (numDataSets == 1 && inputUG != nullptr)
+  if (numDataSets == 1 && vtkUnstructuredGrid::SafeDownCast(dataSets[0]))
   {
     vtkDebugMacro(
       << "Only a single unstructured grid in the composite dataset and we can shallow copy.");
-    output->ShallowCopy(inputUG);
+    output->ShallowCopy(dataSets[0]);
     return 1;
   }
 
-  // Now we can allocate memory
-  output->Allocate(totalNumCells);
-
   vtkSmartPointer<vtkPoints> newPts = vtkSmartPointer<vtkPoints>::New();
 
   // set precision for the points in the output
@@ -199,17 +434,23 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // Additionally to having this->MergePoints set to true,
   // points can be merge if there are not input cells cells OR if global point ids are
   // available in the inputs.
-  inputs->InitTraversal(iter);
-  dataSet = inputs->GetNextDataSet(iter);
   vtkIdTypeArray* globalIdsArray =
-    vtkIdTypeArray::SafeDownCast(dataSet->GetPointData()->GetGlobalIds());
+    vtkIdTypeArray::SafeDownCast(dataSets[0]->GetPointData()->GetGlobalIds());
 
   bool reallyMergePoints = false;
   if (this->MergePoints == 1 && inputVector[0]->GetNumberOfInformationObjects() > 0)
   {
     reallyMergePoints = true;
 
-    // If global point ids are present, we merge points sharing same global id
+    // If global point ids are present in all the inputs, we merge points
+    // sharing same global id
+    for (vtkDataSet* ds : dataSets)
+    {
+      if (!vtkIdTypeArray::SafeDownCast(ds->GetPointData()->GetGlobalIds()))
+      {
+        globalIdsArray = nullptr;
+      }
+    }
     if (!globalIdsArray)
     {
       // ensure that none of the inputs has ghost-cells.
@@ -228,155 +469,245 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  // If we aren't merging points, we need to allocate the points here.
-  if (!reallyMergePoints)
+  // Copy the points of all the inputs. They are the output points unless
+  // they are merged.
+  vtkSmartPointer<vtkPoints> appendedPts = newPts;
+  if (reallyMergePoints)
   {
-    newPts->SetNumberOfPoints(totalNumPts);
+    appendedPts = vtkSmartPointer<vtkPoints>::New();
+    appendedPts->SetDataType(newPts->GetDataType());
   }
-
-  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
-  ptIds->Allocate(VTK_CELL_SIZE);
-  vtkSmartPointer<vtkIdList> newPtIds = vtkSmartPointer<vtkIdList>::New();
-  newPtIds->Allocate(VTK_CELL_SIZE);
-
-  vtkIdType twentieth = (totalNumPts + totalNumCells) / 20 + 1;
-
-  // For optionally merging duplicate points
-  vtkIdType* globalIndices = new vtkIdType[totalNumPts];
-
-  vtkSmartPointer<vtkIncrementalOctreePointLocator> ptInserter;
-  if (reallyMergePoints)
+  appendedPts->SetNumberOfPoints(totalNumPts);
+  for (vtkDataSet* ds : dataSets)
   {
-    vtkBoundingBox outputBB;
-    inputs->InitTraversal(iter);
-    while ((dataSet = inputs->GetNextDataSet(iter)))
+    if (!vtkPointSet::SafeDownCast(ds) && ds->GetNumberOfPoints() > 0)
     {
-      // Union of bounding boxes
-      double localBox[6];
-      dataSet->GetBounds(localBox);
-      outputBB.AddBounds(localBox);
+      double x[3];
+      ds->GetPoint(0, x); // make GetPoint() thread-safe
     }
-
-    double outputBounds[6];
-    outputBB.GetBounds(outputBounds);
-
-    ptInserter = vtkSmartPointer<vtkIncrementalOctreePointLocator>::New();
-    if (this->ToleranceIsAbsolute)
-    {
-      ptInserter->SetTolerance(this->Tolerance);
-    }
-    else
-    {
-      ptInserter->SetTolerance(this->Tolerance * outputBB.GetDiagonalLength());
-    }
-
-    ptInserter->InitPointInsertion(newPts, outputBounds);
   }
-
-  // append the blocks / pieces in terms of the geometry and topology
-  std::unordered_map<vtkIdType, vtkIdType> addedPointsMap;
-  vtkIdType count = 0;
-  vtkIdType ptOffset = 0;
-  float decimal = 0.0;
-  inputs->InitTraversal(iter);
-  int abort = 0;
-  double p[3];
-  while (!abort && (dataSet = inputs->GetNextDataSet(iter)))
-  {
-    vtkIdType dataSetNumPts = dataSet->GetNumberOfPoints();
-    vtkIdType dataSetNumCells = dataSet->GetNumberOfCells();
-    vtkIdTypeArray* dataSetGlobalIdsArray = globalIdsArray
-      ? vtkIdTypeArray::SafeDownCast(dataSet->GetPointData()->GetGlobalIds())
-      : nullptr;
-
-    // copy points
-    for (vtkIdType ptId = 0; ptId < dataSetNumPts && !abort; ++ptId)
-    {
-      if (reallyMergePoints)
+  const std::vector<InputBlock> pointBlocks = SplitIntoBlocks(numPoints);
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(pointBlocks.size()), [&](vtkIdType begin, vtkIdType end) {
+      using Dispatcher =
+        vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals, vtkArrayDispatch::Reals>;
+      AppendPointsWorker worker;
+      vtkDataArray* outArray = appendedPts->GetData();
+      for (vtkIdType b = begin; b < end; ++b)
       {
-        if (dataSetGlobalIdsArray)
+        const InputBlock& block = pointBlocks[b];
+        vtkDataSet* ds = dataSets[block.Input];
+        vtkIdType offset = ptOffsets[block.Input];
+        vtkPointSet* ps = vtkPointSet::SafeDownCast(ds);
+        if (ps && ps->GetPoints())
         {
-          vtkIdType globalId = dataSetGlobalIdsArray->GetValue(ptId);
-          auto it = addedPointsMap.find(globalId);
-          if (it == addedPointsMap.end())
-          {
-            globalIndices[ptId + ptOffset] = newPts->GetNumberOfPoints();
-            dataSet->GetPoint(ptId, p);
-            vtkIdType newPtId = newPts->InsertNextPoint(p);
-            addedPointsMap.emplace(globalId, newPtId);
-          }
-          else
+          vtkDataArray* inArray = ps->GetPoints()->GetData();
+          if (!Dispatcher::Execute(inArray, outArray, worker, block.Begin, block.End, offset))
           {
-            globalIndices[ptId + ptOffset] = it->second;
+            worker(inArray, outArray, block.Begin, block.End, offset);
           }
         }
         else
         {
-          vtkIdType globalPtId = 0;
-          ptInserter->InsertUniquePoint(dataSet->GetPoint(ptId), globalPtId);
-          globalIndices[ptId + ptOffset] = globalPtId;
-          // The point inserter puts the point into newPts, so we don't have to do that here.
+          double p[3];
+          for (vtkIdType ptId = block.Begin; ptId < block.End; ++ptId)
+          {
+            ds->GetPoint(ptId, p);
+            outArray->SetTuple(ptId + offset, p);
+          }
         }
       }
-      else
+    });
+  this->UpdateProgress(0.25);
+
+  // For optionally merging duplicate points. Each merged point takes the
+  // coordinates and attributes of the appended point the others are merged
+  // to, and the merged points are numbered in the order of these points.
+  std::vector<vtkIdType> pointMap;
+  std::vector<vtkIdType> mergedPointIds;
+  if (reallyMergePoints)
+  {
+    pointMap.resize(totalNumPts);
+    if (globalIdsArray)
+    {
+      MergeGlobalIds(dataSets, ptOffsets, pointBlocks, pointMap.data());
+    }
+    else
+    {
+      vtkBoundingBox outputBB;
+      for (vtkDataSet* ds : dataSets)
       {
-        globalIndices[ptId + ptOffset] = ptId + ptOffset;
-        newPts->SetPoint(ptId + ptOffset, dataSet->GetPoint(ptId));
+        // Union of bounding boxes
+        double localBox[6];
+        ds->GetBounds(localBox);
+        outputBB.AddBounds(localBox);
       }
-
-      // Update progress
-      count++;
-      if (!(count % twentieth))
+      double tolerance = this->Tolerance;
+      if (!this->ToleranceIsAbsolute)
       {
-        decimal += 0.05;
-        this->UpdateProgress(decimal);
-        abort = this->GetAbortExecute();
+        tolerance *= outputBB.GetDiagonalLength();
       }
+
+      // The bins of the locator are traversed in a threaded checkerboard
+      // order, which does not depend on the number of threads.
+      vtkNew<vtkPolyData> candidates;
+      candidates->SetPoints(appendedPts);
+      vtkNew<vtkStaticPointLocator> locator;
+      locator->SetDataSet(candidates);
+      locator->SetTraversalOrderToBinOrder();
+      locator->BuildLocator();
+      locator->MergePoints(tolerance, pointMap.data());
     }
 
-    // copy cell
-    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
-    for (vtkIdType cellId = 0; cellId < dataSetNumCells && !abort; ++cellId)
-    {
-      newPtIds->Reset();
-      if (ug && dataSet->GetCellType(cellId) == VTK_POLYHEDRON)
+    // Number the points merged to themselves, then map all the points.
+    std::vector<vtkIdType> mergedIds(totalNumPts + 1);
+    vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
       {
-        vtkIdType nfaces;
-        const vtkIdType* facePtIds;
-        ug->GetFaceStream(cellId, nfaces, facePtIds);
-        for (vtkIdType id = 0; id < nfaces; ++id)
+        mergedIds[ptId] = pointMap[ptId] == ptId;
+      }
+    });
+    vtkSMPTools::ExclusiveScan(mergedIds.begin(), mergedIds.end(), mergedIds.begin(), vtkIdType(0));
+    mergedPointIds.resize(mergedIds[totalNumPts]);
+    vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        if (pointMap[ptId] == ptId)
         {
-          vtkIdType nPoints = facePtIds[0];
-          newPtIds->InsertNextId(nPoints);
-          for (vtkIdType j = 1; j <= nPoints; ++j)
-          {
-            newPtIds->InsertNextId(globalIndices[facePtIds[j] + ptOffset]);
-          }
-          facePtIds += nPoints + 1;
+          mergedPointIds[mergedIds[ptId]] = ptId;
         }
-        output->InsertNextCell(VTK_POLYHEDRON, nfaces, newPtIds->GetPointer(0));
+        pointMap[ptId] = mergedIds[pointMap[ptId]];
       }
-      else
+    });
+
+    newPts->SetNumberOfPoints(static_cast<vtkIdType>(mergedPointIds.size()));
+    GatherPointsWorker worker;
+    if (!vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::Reals>::Execute(
+          appendedPts->GetData(), worker, newPts->GetData(), mergedPointIds.data()))
+    {
+      worker(appendedPts->GetData(), newPts->GetData(), mergedPointIds.data());
+    }
+  }
+  const vtkIdType* ptMap = reallyMergePoints ? pointMap.data() : nullptr;
+  this->UpdateProgress(0.5);
+
+  // Count the connectivity and faces of the blocks of cells, whose prefix
+  // sums give where each block writes its cells.
+  vtkNew<vtkIdList> ptIds;
+  std::vector<InputCells> cellsOfInputs;
+  bool hasFaces = false;
+  for (vtkDataSet* ds : dataSets)
+  {
+    cellsOfInputs.emplace_back(ds, ptIds);
+    hasFaces |= cellsOfInputs.back().Faces != nullptr;
+  }
+  const std::vector<InputBlock> cellBlocks = SplitIntoBlocks(numCells);
+  const vtkIdType numCellBlocks = static_cast<vtkIdType>(cellBlocks.size());
+  std::vector<vtkIdType> blockConnectivity(numCellBlocks + 1, 0);
+  std::vector<vtkIdType> blockFaces(numCellBlocks + 1, 0);
+  vtkSMPThreadLocalObject<vtkIdList> threadPtIds;
+  vtkSMPTools::For(0, numCellBlocks, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellPtIds = threadPtIds.Local();
+    for (vtkIdType b = begin; b < end; ++b)
+    {
+      const InputBlock& block = cellBlocks[b];
+      const InputCells& cells = cellsOfInputs[block.Input];
+      vtkIdType ptOffset = ptOffsets[block.Input];
+      vtkIdType connectivitySize = 0, facesSize = 0;
+      for (vtkIdType cellId = block.Begin; cellId < block.End; ++cellId)
       {
-        dataSet->GetCellPoints(cellId, ptIds);
-        for (vtkIdType id = 0; id < ptIds->GetNumberOfIds(); ++id)
+        int cellType = cells.DataSet->GetCellType(cellId);
+        cells.GetCellPoints(cellId, cellType, ptOffset, ptMap, cellPtIds);
+        connectivitySize += cellPtIds->GetNumberOfIds();
+        if (const vtkIdType* faceStream = cells.GetFaceStream(cellId))
         {
-          newPtIds->InsertId(id, globalIndices[ptIds->GetId(id) + ptOffset]);
+          facesSize += GetFaceStreamSize(faceStream);
         }
-        output->InsertNextCell(dataSet->GetCellType(cellId), newPtIds);
       }
-
-      // Update progress
-      count++;
-      if (!(count % twentieth))
+      blockConnectivity[b] = connectivitySize;
+      blockFaces[b] = facesSize;
+    }
+  });
+  vtkSMPTools::ExclusiveScan(
+    blockConnectivity.begin(), blockConnectivity.end(), blockConnectivity.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    blockFaces.begin(), blockFaces.end(), blockFaces.begin(), vtkIdType(0));
+
+  // Fill the output cells.
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(totalNumCells);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(totalNumCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(blockConnectivity[numCellBlocks]);
+  vtkSmartPointer<vtkIdTypeArray> faceLocations;
+  vtkSmartPointer<vtkIdTypeArray> faces;
+  if (hasFaces)
+  {
+    faceLocations = vtkSmartPointer<vtkIdTypeArray>::New();
+    faceLocations->SetNumberOfValues(totalNumCells);
+    faces = vtkSmartPointer<vtkIdTypeArray>::New();
+    faces->SetNumberOfValues(blockFaces[numCellBlocks]);
+  }
+  vtkSMPTools::For(0, numCellBlocks, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellPtIds = threadPtIds.Local();
+    for (vtkIdType b = begin; b < end; ++b)
+    {
+      const InputBlock& block = cellBlocks[b];
+      const InputCells& cells = cellsOfInputs[block.Input];
+      vtkIdType ptOffset = ptOffsets[block.Input];
+      vtkIdType outCellId = cellOffsets[block.Input] + block.Begin;
+      vtkIdType connectivityOffset = blockConnectivity[b];
+      vtkIdType facesOffset = blockFaces[b];
+      for (vtkIdType cellId = block.Begin; cellId < block.End; ++cellId, ++outCellId)
       {
-        decimal += 0.05;
-        this->UpdateProgress(decimal);
-        abort = this->GetAbortExecute();
+        int cellType = cells.DataSet->GetCellType(cellId);
+        cells.GetCellPoints(cellId, cellType, ptOffset, ptMap, cellPtIds);
+        vtkIdType npts = cellPtIds->GetNumberOfIds();
+        types->SetValue(outCellId, static_cast<unsigned char>(cellType));
+        offsets->SetValue(outCellId, connectivityOffset);
+        std::copy_n(cellPtIds->GetPointer(0), npts, connectivity->GetPointer(connectivityOffset));
+        connectivityOffset += npts;
+        if (!hasFaces)
+        {
+          continue;
+        }
+
+        const vtkIdType* inFace = cells.GetFaceStream(cellId);
+        if (!inFace)
+        {
+          faceLocations->SetValue(outCellId, -1);
+          continue;
+        }
+        faceLocations->SetValue(outCellId, facesOffset);
+        vtkIdType* outFace = faces->GetPointer(facesOffset);
+        vtkIdType numFaces = *inFace++;
+        *outFace++ = numFaces;
+        for (vtkIdType i = 0; i < numFaces; ++i)
+        {
+          vtkIdType numFacePts = *inFace++;
+          *outFace++ = numFacePts;
+          for (vtkIdType j = 0; j < numFacePts; ++j, ++inFace)
+          {
+            *outFace++ = ptMap ? ptMap[*inFace + ptOffset] : *inFace + ptOffset;
+          }
+        }
+        facesOffset = static_cast<vtkIdType>(outFace - faces->GetPointer(0));
       }
     }
-    ptOffset += dataSetNumPts;
+  });
+  offsets->SetValue(totalNumCells, blockConnectivity[numCellBlocks]);
+  vtkNew<vtkCellArray> cellArray;
+  cellArray->SetData(offsets, connectivity);
+  if (hasFaces)
+  {
+    output->SetCells(types, cellArray, faceLocations, faces);
   }
+  else
+  {
+    output->SetCells(types, cellArray);
+  }
+  this->UpdateProgress(0.75);
 
   // this filter can copy global ids except for global point ids when merging
   // points (see paraview/paraview#18666).
@@ -390,17 +721,13 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->GetCellData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
   // Now copy the array data
-  this->AppendArrays(
-    vtkDataObject::POINT, inputVector, globalIndices, output, newPts->GetNumberOfPoints());
-  this->UpdateProgress(0.75);
-  this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells());
+  this->AppendArrays(vtkDataObject::POINT, inputVector,
+    reallyMergePoints ? mergedPointIds.data() : nullptr, output, newPts->GetNumberOfPoints());
+  this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, totalNumCells);
   this->UpdateProgress(1.0);
 
-  // Update ourselves and release memory
+  // Update ourselves
   output->SetPoints(newPts);
-  output->Squeeze();
-
-  delete[] globalIndices;
 
   return 1;
 }
@@ -433,7 +760,7 @@ vtkDataSetCollection* vtkAppendFilter::GetNonEmptyInputs(vtkInformationVector**
 
 //------------------------------------------------------------------------------
 void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** inputVector,
-  vtkIdType* globalIds, vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements)
+  const vtkIdType* sourceIds, vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements)
 {
   // Check if attributesType is supported
   if (attributesType != vtkDataObject::POINT && attributesType != vtkDataObject::CELL)
@@ -445,6 +772,8 @@ void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** in
 
   vtkDataSetAttributes::FieldList fieldList;
   auto inputs = vtkSmartPointer<vtkDataSetCollection>::Take(this->GetNonEmptyInputs(inputVector));
+  std::vector<vtkDataSetAttributes*> inputsData;
+  std::vector<vtkIdType> numberOfInputTuples;
   vtkCollectionSimpleIterator iter;
   vtkDataSet* dataSet = nullptr;
   for (dataSet = nullptr, inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
@@ -452,34 +781,84 @@ void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** in
     if (auto inputData = dataSet->GetAttributes(attributesType))
     {
       fieldList.IntersectFieldList(inputData);
+      inputsData.push_back(inputData);
+      // The attributes have no tuples when they have no arrays, so the
+      // offsets of the inputs are computed from their number of elements.
+      numberOfInputTuples.push_back(dataSet->GetNumberOfElements(attributesType));
     }
   }
+  const std::vector<vtkIdType> offsets = ComputeOffsets(numberOfInputTuples);
 
+  // The output arrays are sized first so that the tuples can be copied
+  // concurrently with SetTuple(), which unlike InsertTuples() does not
+  // update the size of the array.
   vtkDataSetAttributes* outputData = output->GetAttributes(attributesType);
   outputData->CopyAllocate(fieldList, totalNumberOfElements);
+  for (int i = 0; i < outputData->GetNumberOfArrays(); ++i)
+  {
+    outputData->GetAbstractArray(i)->SetNumberOfTuples(totalNumberOfElements);
+  }
+  const bool parallel = CanCopyInParallel(outputData);
+
+  // The arrays of every input with the output arrays they are copied to.
+  using ArrayPair = std::pair<vtkAbstractArray*, vtkAbstractArray*>;
+  std::vector<std::vector<ArrayPair>> arrayPairs(inputsData.size());
+  for (std::size_t i = 0; i < inputsData.size(); ++i)
+  {
+    fieldList.TransformData(static_cast<int>(i), inputsData[i], outputData,
+      [&arrayPairs, i](vtkAbstractArray* inArray, vtkAbstractArray* outArray) {
+        arrayPairs[i].emplace_back(inArray, outArray);
+      });
+  }
 
   // copy arrays.
-  int inputIndex;
-  vtkIdType offset = 0;
-  for (inputIndex = 0, dataSet = nullptr, inputs->InitTraversal(iter);
-       (dataSet = inputs->GetNextDataSet(iter));)
+  if (sourceIds != nullptr)
   {
-    if (auto inputData = dataSet->GetAttributes(attributesType))
-    {
-      const auto numberOfInputTuples = inputData->GetNumberOfTuples();
-      if (globalIds != nullptr)
+    // each output tuple is copied from the appended tuple sourceIds[id]
+    auto copyTuples = [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType id = begin; id < end; ++id)
       {
-        for (vtkIdType id = 0; id < numberOfInputTuples; ++id)
+        auto input = std::upper_bound(offsets.begin(), offsets.end(), sourceIds[id]) - 1;
+        const vtkIdType inputId = sourceIds[id] - *input;
+        for (const ArrayPair& arrays : arrayPairs[input - offsets.begin()])
         {
-          fieldList.CopyData(inputIndex, inputData, id, outputData, globalIds[offset + id]);
+          arrays.second->SetTuple(id, inputId, arrays.first);
         }
       }
-      else
+    };
+    if (parallel)
+    {
+      vtkSMPTools::For(0, totalNumberOfElements, copyTuples);
+    }
+    else
+    {
+      copyTuples(0, totalNumberOfElements);
+    }
+  }
+  else
+  {
+    const std::vector<InputBlock> blocks = SplitIntoBlocks(numberOfInputTuples);
+    auto copyBlocks = [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType b = begin; b < end; ++b)
       {
-        fieldList.CopyData(inputIndex, inputData, 0, numberOfInputTuples, outputData, offset);
+        const InputBlock& block = blocks[b];
+        const vtkIdType offset = offsets[block.Input];
+        for (const ArrayPair& arrays : arrayPairs[block.Input])
+        {
+          for (vtkIdType inputId = block.Begin; inputId < block.End; ++inputId)
+          {
+            arrays.second->SetTuple(offset + inputId, inputId, arrays.first);
+          }
+        }
       }
-      offset += numberOfInputTuples;
-      ++inputIndex;
+    };
+    if (parallel)
+    {
+      vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), copyBlocks);
+    }
+    else
+    {
+      copyBlocks(0, static_cast<vtkIdType>(blocks.size()));
     }
   }
 }
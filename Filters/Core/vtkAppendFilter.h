@@ -25,9 +25,18 @@
  *
  * You can decide to merge points that are coincident by setting
  * `MergePoints`. If this flag is set, points are merged if they are within
- * `Tolerance` radius. If a point global id array is available (point data named
- * "GlobalPointIds"), then two points are merged if they share the same point global id,
- * without checking for coincident point.
+ * `Tolerance` radius. If a point global id array is available in all the inputs
+ * (point data named "GlobalPointIds"), then two points are merged if they
+ * share the same point global id, without checking for coincident point.
+ *
+ * The points, cells and attributes of the inputs are copied in parallel with
+ * vtkSMPTools, over blocks of each input located by prefix sums of the input
+ * sizes. Coincident points are merged in parallel with a
+ * vtkStaticPointLocator, and points sharing a global id by sorting the
+ * global ids. A merged point takes the coordinates and attributes of one of
+ * the points merged together, chosen so that the output does not depend on
+ * the number of threads: the first one when merging with global ids or a
+ * zero tolerance.
  *
  * @sa
  * vtkAppendPolyData
@@ -73,8 +82,9 @@ public:
    * Get/Set the tolerance to use to find coincident points when `MergePoints`
    * is `true`. Default is 0.0.
    *
-   * This is simply passed on to the internal vtkLocator used to merge points.
-   * @sa `vtkLocator::SetTolerance`.
+   * This is simply passed on to the internal vtkStaticPointLocator used to
+   * merge points.
+   * @sa `vtkStaticPointLocator::MergePoints`.
    */
   vtkSetClampMacro(Tolerance, double, 0.0, VTK_DOUBLE_MAX);
   vtkGetMacro(Tolerance, double);
@@ -144,8 +154,10 @@ private:
   // Caller must delete the returned vtkDataSetCollection.
   vtkDataSetCollection* GetNonEmptyInputs(vtkInformationVector** inputVector);
 
-  void AppendArrays(int attributesType, vtkInformationVector** inputVector, vtkIdType* globalIds,
-    vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements);
+  // Append the point or cell data of the inputs. If sourceIds is not
+  // nullptr, output tuple i is copied from the appended tuple sourceIds[i].
+  void AppendArrays(int attributesType, vtkInformationVector** inputVector,
+    const vtkIdType* sourceIds, vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements);
 };
 
 #endif
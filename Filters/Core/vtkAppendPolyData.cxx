@@ -17,20 +17,25 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkArrayDispatch.h"
 #include "vtkAssume.h"
+#include "vtkBitArray.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendPolyData);
 
@@ -119,18 +124,118 @@ void vtkAppendPolyData::SetInputConnectionByNumber(int num, vtkAlgorithmOutput*
   this->SetNthInputConnection(0, num, input);
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Verts, lines, polys and strips, in the order of the output cells.
+const int AppendedCellTypes = 4;
+
+vtkCellArray* GetCells(vtkPolyData* input, int type)
+{
+  switch (type)
+  {
+    case 0:
+      return input->GetVerts();
+    case 1:
+      return input->GetLines();
+    case 2:
+      return input->GetPolys();
+    default:
+      return input->GetStrips();
+  }
+}
+
+// Number of points or cells copied by a task. The inputs are split into
+// blocks so that both many small inputs and a few large ones are spread
+// over the threads.
+const vtkIdType BlockSize = 8192;
+
+// A range of the points (CellType -1) or of the cells of one type of an
+// input.
+struct AppendBlock
+{
+  int Input;
+  int CellType;
+  vtkIdType Begin;
+  vtkIdType End;
+};
+
+void AddBlocks(std::vector<AppendBlock>& blocks, int input, int cellType, vtkIdType size)
+{
+  for (vtkIdType begin = 0; begin < size; begin += BlockSize)
+  {
+    blocks.push_back({ input, cellType, begin, std::min(begin + BlockSize, size) });
+  }
+}
+
+void ResizeArrays(vtkDataSetAttributes* attributes, vtkIdType numTuples)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    attributes->GetAbstractArray(i)->SetNumberOfTuples(numTuples);
+  }
+}
+
+// Bits of a vtkBitArray share bytes and cannot be written concurrently.
+bool CanCopyInParallel(vtkDataSetAttributes* attributes)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    if (vtkBitArray::SafeDownCast(attributes->GetAbstractArray(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Copy a range of the tuples of src at an offset in dest.
+struct AppendPointsWorker
+{
+  template <typename Array1T, typename Array2T>
+  void operator()(Array1T* dest, Array2T* src, vtkIdType begin, vtkIdType end, vtkIdType offset)
+  {
+    VTK_ASSUME(src->GetNumberOfComponents() == dest->GetNumberOfComponents());
+    const auto srcTuples = vtk::DataArrayTupleRange(src, begin, end);
+    auto dstTuples = vtk::DataArrayTupleRange(dest, begin + offset, end + offset);
+    std::copy(srcTuples.cbegin(), srcTuples.cend(), dstTuples.begin());
+  }
+};
+
+// Copy a range of cells, shifting their connectivity offsets and point ids
+// to their location in the output.
+struct AppendCellsWorker
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType begin, vtkIdType end, vtkIdType* outOffsets,
+    vtkIdType* outConnectivity, vtkIdType connectivityOffset, vtkIdType ptOffset) const
+  {
+    const auto offsets = vtk::DataArrayValueRange<1>(state.GetOffsets());
+    const auto connectivity = vtk::DataArrayValueRange<1>(state.GetConnectivity());
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      *outOffsets++ = static_cast<vtkIdType>(offsets[cellId]) + connectivityOffset;
+    }
+    vtkIdType endId = static_cast<vtkIdType>(offsets[end]);
+    for (vtkIdType i = static_cast<vtkIdType>(offsets[begin]); i < endId; ++i)
+    {
+      outConnectivity[i + connectivityOffset] = static_cast<vtkIdType>(connectivity[i]) + ptOffset;
+    }
+  }
+};
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[], int numInputs)
 {
   int idx;
   vtkPolyData* ds;
-  vtkPoints* inPts;
   vtkPoints* newPts;
-  vtkCellArray *inVerts, *newVerts;
-  vtkCellArray *inLines, *newLines;
-  vtkCellArray *inPolys, *newPolys;
+  vtkCellArray* newVerts;
+  vtkCellArray* newLines;
+  vtkCellArray* newPolys;
   vtkIdType sizePolys, numPolys;
-  vtkCellArray *inStrips, *newStrips;
+  vtkCellArray* newStrips;
   vtkIdType numPts, numCells;
   vtkPointData* inPD = nullptr;
   vtkCellData* inCD = nullptr;
@@ -287,120 +392,167 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
 
   newPts->SetNumberOfPoints(numPts);
 
-  newVerts = vtkCellArray::New();
-  bool allocated = newVerts->AllocateExact(numVerts, sizeVerts);
-
-  if (sizeVerts > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
+  // Offsets of the points, cells and connectivity of each input in the
+  // output, by prefix sums over the inputs. Cells of each type are appended
+  // after the cells of the previous types.
+  const vtkIdType typeCells[AppendedCellTypes] = { numVerts, numLines, numPolys, numStrips };
+  const vtkIdType typeSizes[AppendedCellTypes] = { sizeVerts, sizeLines, sizePolys, sizeStrips };
+  std::vector<vtkIdType> ptOffsets(numInputs + 1, 0);
+  std::vector<vtkIdType> cellOffsets[AppendedCellTypes];
+  std::vector<vtkIdType> connectivityOffsets[AppendedCellTypes];
+  std::vector<int> pdIndices(numInputs, -1);
+  std::vector<int> cdIndices(numInputs, -1);
+  for (int type = 0; type < AppendedCellTypes; ++type)
+  {
+    cellOffsets[type].resize(numInputs + 1, 0);
+    connectivityOffsets[type].resize(numInputs + 1, 0);
   }
-
-  newLines = vtkCellArray::New();
-  allocated = newLines->AllocateExact(numLines, sizeLines);
-
-  if (sizeLines > 0 && !allocated)
+  countPD = countCD = 0;
+  for (idx = 0; idx < numInputs; ++idx)
   {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
+    ds = inputs[idx];
+    if (ds == nullptr)
+    {
+      continue;
+    }
+    if (ds->GetNumberOfPoints() > 0)
+    {
+      ptOffsets[idx] = ds->GetNumberOfPoints();
+      pdIndices[idx] = countPD++;
+    }
+    if (ds->GetNumberOfCells() > 0)
+    {
+      for (int type = 0; type < AppendedCellTypes; ++type)
+      {
+        vtkCellArray* cells = GetCells(ds, type);
+        cellOffsets[type][idx] = cells ? cells->GetNumberOfCells() : 0;
+        connectivityOffsets[type][idx] = cells ? cells->GetNumberOfConnectivityIds() : 0;
+      }
+      cdIndices[idx] = countCD++;
+    }
   }
-
-  newPolys = vtkCellArray::New();
-  allocated = newPolys->AllocateExact(numPolys, sizePolys);
-
-  if (sizePolys > 0 && !allocated)
-  {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
+  vtkSMPTools::ExclusiveScan(ptOffsets.begin(), ptOffsets.end(), ptOffsets.begin(), vtkIdType(0));
+  vtkIdType typeStart = 0;
+  for (int type = 0; type < AppendedCellTypes; ++type)
+  {
+    vtkSMPTools::ExclusiveScan(
+      cellOffsets[type].begin(), cellOffsets[type].end(), cellOffsets[type].begin(), typeStart);
+    vtkSMPTools::ExclusiveScan(connectivityOffsets[type].begin(),
+      connectivityOffsets[type].end(), connectivityOffsets[type].begin(), vtkIdType(0));
+    typeStart += typeCells[type];
   }
 
-  newStrips = vtkCellArray::New();
-  allocated = newStrips->AllocateExact(numStrips, sizeStrips);
-
-  if (sizeStrips > 0 && !allocated)
+  // The cell arrays are sized here and filled in parallel.
+  vtkCellArray* newCells[AppendedCellTypes];
+  vtkIdType* newOffsets[AppendedCellTypes];
+  vtkIdType* newConnectivity[AppendedCellTypes];
+  for (int type = 0; type < AppendedCellTypes; ++type)
   {
-    vtkErrorMacro(<< "Memory allocation failed in append filter");
-    return 0;
+    vtkNew<vtkIdTypeArray> offsets;
+    vtkNew<vtkIdTypeArray> connectivity;
+    if (!offsets->SetNumberOfValues(typeCells[type] + 1) ||
+      !connectivity->SetNumberOfValues(typeSizes[type]))
+    {
+      vtkErrorMacro(<< "Memory allocation failed in append filter");
+      for (int i = 0; i < type; ++i)
+      {
+        newCells[i]->Delete();
+      }
+      newPts->Delete();
+      return 0;
+    }
+    offsets->SetValue(typeCells[type], typeSizes[type]);
+    newOffsets[type] = offsets->GetPointer(0);
+    newConnectivity[type] = connectivity->GetPointer(0);
+    newCells[type] = vtkCellArray::New();
+    newCells[type]->SetData(offsets, connectivity);
   }
+  newVerts = newCells[0];
+  newLines = newCells[1];
+  newPolys = newCells[2];
+  newStrips = newCells[3];
 
   // Since points are cells are not merged,
   // this filter can easily pass all field arrays, including global ids.
   outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
   outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
-  // Allocate the point and cell data
+  // Allocate the point and cell data, sized so that the tuples can be
+  // copied concurrently.
   outputPD->CopyAllocate(ptList, numPts);
   outputCD->CopyAllocate(cellList, numCells);
+  ResizeArrays(outputPD, numPts);
+  ResizeArrays(outputCD, numCells);
+  this->UpdateProgress(0.20);
 
-  // loop over all input sets
-  vtkIdType ptOffset = 0;
-  vtkIdType vertOffset = 0;
-  vtkIdType linesOffset = numVerts;
-  vtkIdType polysOffset = numVerts + numLines;
-  vtkIdType stripsOffset = numVerts + numLines + numPolys;
-  countPD = countCD = 0;
+  // Split the points and the cells of each type of the inputs into blocks,
+  // copied in parallel.
+  std::vector<AppendBlock> blocks;
   for (idx = 0; idx < numInputs; ++idx)
   {
-    this->UpdateProgress(0.2 + 0.8 * idx / numInputs);
     ds = inputs[idx];
-    // this check is not necessary, but I'll put it in anyway
-    if (ds != nullptr)
+    if (ds == nullptr)
     {
-      numPts = ds->GetNumberOfPoints();
-      numCells = ds->GetNumberOfCells();
-      if (numPts <= 0 && numCells <= 0)
-      {
-        continue; // no input, just skip
-      }
-
-      inPD = ds->GetPointData();
-      inCD = ds->GetCellData();
-
-      inPts = ds->GetPoints();
-      inVerts = ds->GetVerts();
-      inLines = ds->GetLines();
-      inPolys = ds->GetPolys();
-      inStrips = ds->GetStrips();
+      continue;
+    }
+    AddBlocks(blocks, idx, -1, pdIndices[idx] < 0 ? 0 : ds->GetNumberOfPoints());
+    for (int type = 0; type < AppendedCellTypes; ++type)
+    {
+      AddBlocks(blocks, idx, type, cellOffsets[type][idx + 1] - cellOffsets[type][idx]);
+    }
+  }
 
-      if (ds->GetNumberOfPoints() > 0)
+  auto appendBlocks = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType b = begin; b < end; ++b)
+    {
+      const AppendBlock& block = blocks[b];
+      vtkPolyData* input = inputs[block.Input];
+      vtkIdType numValues = block.End - block.Begin;
+      if (block.CellType < 0)
       {
         // copy points directly
-        this->AppendData(newPts->GetData(), inPts->GetData(), ptOffset);
-        outputPD->CopyData(ptList, inPD, countPD, ptOffset, numPts, 0);
-        ++countPD;
+        vtkIdType ptOffset = ptOffsets[block.Input];
+        AppendPointsWorker worker;
+        vtkDataArray* inArray = input->GetPoints()->GetData();
+        if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(
+              newPts->GetData(), inArray, worker, block.Begin, block.End, ptOffset))
+        {
+          // Use vtkDataArray API when fast-path dispatch fails.
+          worker(newPts->GetData(), inArray, block.Begin, block.End, ptOffset);
+        }
+        outputPD->CopyData(ptList, input->GetPointData(), pdIndices[block.Input],
+          ptOffset + block.Begin, numValues, block.Begin);
+        continue;
       }
 
-      if (ds->GetNumberOfCells() > 0)
+      // copy the cells with their point ids shifted by the point offset
+      int type = block.CellType;
+      vtkIdType outCellId = cellOffsets[type][block.Input] + block.Begin;
+      vtkIdType typeCellId = outCellId - cellOffsets[type][0];
+      GetCells(input, type)->Visit(AppendCellsWorker{}, block.Begin, block.End,
+        newOffsets[type] + typeCellId, newConnectivity[type],
+        connectivityOffsets[type][block.Input], ptOffsets[block.Input]);
+
+      // copy cell data. The cells of each type of the input start after the
+      // cells of the previous types.
+      vtkIdType inCellId = block.Begin;
+      for (int previous = 0; previous < type; ++previous)
       {
-        // These are the cellIDs at which each of the cell types start.
-        vtkIdType vertsIndex = 0;
-        vtkIdType linesIndex = ds->GetNumberOfVerts();
-        vtkIdType polysIndex = linesIndex + ds->GetNumberOfLines();
-        vtkIdType stripsIndex = polysIndex + ds->GetNumberOfPolys();
-
-        // copy the cells
-        this->AppendCells(newVerts, inVerts, ptOffset);
-        this->AppendCells(newLines, inLines, ptOffset);
-        this->AppendCells(newPolys, inPolys, ptOffset);
-        this->AppendCells(newStrips, inStrips, ptOffset);
-
-        // copy cell data
-        outputCD->CopyData(cellList, inCD, countCD, vertOffset, ds->GetNumberOfVerts(), vertsIndex);
-        vertOffset += ds->GetNumberOfVerts();
-        outputCD->CopyData(
-          cellList, inCD, countCD, linesOffset, ds->GetNumberOfLines(), linesIndex);
-        linesOffset += ds->GetNumberOfLines();
-        outputCD->CopyData(
-          cellList, inCD, countCD, polysOffset, ds->GetNumberOfPolys(), polysIndex);
-        polysOffset += ds->GetNumberOfPolys();
-        outputCD->CopyData(
-          cellList, inCD, countCD, stripsOffset, ds->GetNumberOfStrips(), stripsIndex);
-        stripsOffset += ds->GetNumberOfStrips();
-        ++countCD;
+        inCellId += cellOffsets[previous][block.Input + 1] - cellOffsets[previous][block.Input];
       }
-      ptOffset += numPts;
+      outputCD->CopyData(
+        cellList, input->GetCellData(), cdIndices[block.Input], outCellId, numValues, inCellId);
     }
+  };
+  if (CanCopyInParallel(outputPD) && CanCopyInParallel(outputCD))
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), appendBlocks);
+  }
+  else
+  {
+    appendBlocks(0, static_cast<vtkIdType>(blocks.size()));
   }
+  this->UpdateProgress(0.90);
 
   // Update ourselves and release memory
   //
@@ -0,0 +1,446 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellSubsetExtractor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellSubsetExtractor.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArrayRange.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkCellSubsetExtractor);
+
+namespace
+{
+// Number of cells per block. The sizes of the output of the blocks are
+// prefix summed to locate where each block writes its cells.
+const vtkIdType BlockSize = 1024;
+
+// Thread-safe access to the point ids of the input cells. The connectivity
+// of unstructured grids is read with an iterator per thread.
+struct CellPointsReader
+{
+  vtkDataSet* Input;
+  vtkCellArray* Cells;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterators;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  CellPointsReader(vtkDataSet* input)
+    : Input(input)
+    , Cells(nullptr)
+  {
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+    this->Cells = grid ? grid->GetCells() : nullptr;
+    if (!this->Cells && input->GetNumberOfCells() > 0)
+    {
+      // make the input API thread-safe by calling it once in a single thread
+      input->GetCellType(0);
+      input->GetCellPoints(0, this->PointIds.Local());
+    }
+  }
+
+  vtkIdList* GetCellPoints(vtkIdType cellId)
+  {
+    vtkIdList*& ptIds = this->PointIds.Local();
+    if (this->Cells)
+    {
+      vtkSmartPointer<vtkCellArrayIterator>& iter = this->Iterators.Local();
+      if (!iter)
+      {
+        iter.TakeReference(this->Cells->NewIterator());
+      }
+      iter->GetCellAtId(cellId, ptIds);
+    }
+    else
+    {
+      this->Input->GetCellPoints(cellId, ptIds);
+    }
+    return ptIds;
+  }
+};
+
+// Number of values of the face stream of a polyhedron.
+vtkIdType GetFaceStreamSize(const vtkIdType* faceStream)
+{
+  const vtkIdType* face = faceStream;
+  vtkIdType numFaces = *face++;
+  for (vtkIdType i = 0; i < numFaces; ++i)
+  {
+    face += *face + 1;
+  }
+  return static_cast<vtkIdType>(face - faceStream);
+}
+
+// First pass: evaluate the predicate on the cells, count the cells,
+// connectivity and face stream values kept in each block, and flag the
+// points used by the kept cells.
+struct ClassifyCells
+{
+  vtkDataSet* Input;
+  const vtkCellSubsetExtractor::CellPredicate& Predicate;
+  vtkIdTypeArray* FaceLocations;
+  vtkIdTypeArray* Faces;
+  CellPointsReader& Reader;
+  std::vector<unsigned char>& KeepCell;
+  unsigned char* UsedPoints;
+  std::vector<vtkIdType>& BlockCells;
+  std::vector<vtkIdType>& BlockConnectivity;
+  std::vector<vtkIdType>& BlockFaces;
+
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(this->KeepCell.size());
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      vtkIdType numKeptCells = 0, connectivitySize = 0, facesSize = 0;
+      vtkIdType endCell = std::min((block + 1) * BlockSize, numCells);
+      for (vtkIdType cellId = block * BlockSize; cellId < endCell; ++cellId)
+      {
+        vtkIdList* ptIds = this->Reader.GetCellPoints(cellId);
+        vtkIdType npts = ptIds->GetNumberOfIds();
+        bool keep = npts > 0 && this->Input->GetCellType(cellId) != VTK_EMPTY_CELL &&
+          this->Predicate(cellId, ptIds);
+        this->KeepCell[cellId] = keep;
+        if (!keep)
+        {
+          continue;
+        }
+        ++numKeptCells;
+        connectivitySize += npts;
+        if (this->FaceLocations)
+        {
+          vtkIdType location = this->FaceLocations->GetValue(cellId);
+          if (location >= 0)
+          {
+            facesSize += GetFaceStreamSize(this->Faces->GetPointer(location));
+          }
+        }
+        if (this->UsedPoints)
+        {
+          const vtkIdType* pts = ptIds->GetPointer(0);
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            this->UsedPoints[pts[i]] = 1;
+          }
+        }
+      }
+      this->BlockCells[block] = numKeptCells;
+      this->BlockConnectivity[block] = connectivitySize;
+      this->BlockFaces[block] = facesSize;
+    }
+  }
+};
+
+// Second pass: each block fills the output cells starting at the offsets
+// given by the prefix sums of the first pass. The connectivity is stored in
+// ArrayT, to keep the 32 or 64 bit storage of the input.
+template <typename ArrayT>
+struct FillCells
+{
+  using ValueType = typename ArrayT::ValueType;
+
+  vtkDataSet* Input;
+  vtkIdTypeArray* FaceLocations;
+  vtkIdTypeArray* Faces;
+  CellPointsReader& Reader;
+  const std::vector<unsigned char>& KeepCell;
+  const vtkIdType* PointMap;
+  const std::vector<vtkIdType>& BlockCells;
+  const std::vector<vtkIdType>& BlockConnectivity;
+  const std::vector<vtkIdType>& BlockFaces;
+  ValueType* Offsets;
+  ValueType* Connectivity;
+  unsigned char* Types;
+  vtkIdType* OutFaceLocations;
+  vtkIdType* OutFaces;
+  vtkIdType* CellIds;
+
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(this->KeepCell.size());
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      vtkIdType outCellId = this->BlockCells[block];
+      vtkIdType connectivityOffset = this->BlockConnectivity[block];
+      vtkIdType facesOffset = this->BlockFaces[block];
+      vtkIdType endCell = std::min((block + 1) * BlockSize, numCells);
+      for (vtkIdType cellId = block * BlockSize; cellId < endCell; ++cellId)
+      {
+        if (!this->KeepCell[cellId])
+        {
+          continue;
+        }
+        vtkIdList* ptIds = this->Reader.GetCellPoints(cellId);
+        vtkIdType npts = ptIds->GetNumberOfIds();
+        const vtkIdType* pts = ptIds->GetPointer(0);
+        this->Offsets[outCellId] = static_cast<ValueType>(connectivityOffset);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          this->Connectivity[connectivityOffset + i] =
+            static_cast<ValueType>(this->PointMap[pts[i]]);
+        }
+        connectivityOffset += npts;
+        this->Types[outCellId] = static_cast<unsigned char>(this->Input->GetCellType(cellId));
+        this->CellIds[outCellId] = cellId;
+
+        if (this->FaceLocations)
+        {
+          vtkIdType location = this->FaceLocations->GetValue(cellId);
+          if (location < 0)
+          {
+            this->OutFaceLocations[outCellId] = -1;
+          }
+          else
+          {
+            this->OutFaceLocations[outCellId] = facesOffset;
+            const vtkIdType* inFace = this->Faces->GetPointer(location);
+            vtkIdType* outFace = this->OutFaces + facesOffset;
+            vtkIdType numFaces = *inFace++;
+            *outFace++ = numFaces;
+            for (vtkIdType i = 0; i < numFaces; ++i)
+            {
+              vtkIdType numFacePts = *inFace++;
+              *outFace++ = numFacePts;
+              for (vtkIdType j = 0; j < numFacePts; ++j)
+              {
+                *outFace++ = this->PointMap[*inFace++];
+              }
+            }
+            facesOffset = static_cast<vtkIdType>(outFace - this->OutFaces);
+          }
+        }
+        ++outCellId;
+      }
+    }
+  }
+};
+
+template <typename ArrayT>
+vtkSmartPointer<vtkCellArray> BuildCells(FillCells<ArrayT>& filler, vtkIdType numBlocks)
+{
+  vtkIdType numOutCells = filler.BlockCells[numBlocks];
+  vtkIdType connectivitySize = filler.BlockConnectivity[numBlocks];
+  vtkNew<ArrayT> offsets;
+  offsets->SetNumberOfValues(numOutCells + 1);
+  vtkNew<ArrayT> connectivity;
+  connectivity->SetNumberOfValues(connectivitySize);
+  filler.Offsets = offsets->GetPointer(0);
+  filler.Connectivity = connectivity->GetPointer(0);
+  vtkSMPTools::For(0, numBlocks, filler);
+  offsets->SetValue(numOutCells, static_cast<typename ArrayT::ValueType>(connectivitySize));
+
+  vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+  cells->SetData(offsets, connectivity);
+  return cells;
+}
+
+// Copy the coordinates of the kept points of a point set.
+struct CopyPointsWorker
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* inArray, OutArrayT* outArray, const vtkIdType* pointIds)
+  {
+    const auto inPts = vtk::DataArrayTupleRange<3>(inArray);
+    auto outPts = vtk::DataArrayTupleRange<3>(outArray);
+    using OutValueType = vtk::GetAPIType<OutArrayT>;
+    vtkSMPTools::For(0, outPts.size(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const auto inPt = inPts[pointIds[i]];
+        auto outPt = outPts[i];
+        outPt[0] = static_cast<OutValueType>(inPt[0]);
+        outPt[1] = static_cast<OutValueType>(inPt[1]);
+        outPt[2] = static_cast<OutValueType>(inPt[2]);
+      }
+    });
+  }
+};
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+vtkCellSubsetExtractor::vtkCellSubsetExtractor()
+{
+  this->PointIds = vtkSmartPointer<vtkIdList>::New();
+  this->CellIds = vtkSmartPointer<vtkIdList>::New();
+}
+
+//------------------------------------------------------------------------------
+vtkCellSubsetExtractor::~vtkCellSubsetExtractor() = default;
+
+//------------------------------------------------------------------------------
+void vtkCellSubsetExtractor::Extract(vtkDataSet* input, const CellPredicate& predicate,
+  const unsigned char* pointFlags, vtkPoints* newPoints, vtkUnstructuredGrid* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numBlocks = (numCells + BlockSize - 1) / BlockSize;
+
+  vtkUnstructuredGrid* inputGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  vtkIdTypeArray* faceLocations = inputGrid ? inputGrid->GetFaceLocations() : nullptr;
+  vtkIdTypeArray* faces = inputGrid ? inputGrid->GetFaces() : nullptr;
+  if (!faces)
+  {
+    faceLocations = nullptr;
+  }
+
+  // Classify the cells. The points used by the kept cells are flagged
+  // unless the caller gives the points to keep.
+  CellPointsReader reader(input);
+  std::vector<unsigned char> keepCell(numCells);
+  std::vector<unsigned char> usedPoints;
+  if (!pointFlags)
+  {
+    usedPoints.resize(numPts, 0);
+  }
+  // one more value per block for the totals of the prefix sums
+  std::vector<vtkIdType> blockCells(numBlocks + 1, 0);
+  std::vector<vtkIdType> blockConnectivity(numBlocks + 1, 0);
+  std::vector<vtkIdType> blockFaces(numBlocks + 1, 0);
+  ClassifyCells classify{ input, predicate, faceLocations, faces, reader, keepCell,
+    pointFlags ? nullptr : usedPoints.data(), blockCells, blockConnectivity, blockFaces };
+  vtkSMPTools::For(0, numBlocks, classify);
+  if (!pointFlags)
+  {
+    pointFlags = usedPoints.data();
+  }
+
+  vtkSMPTools::ExclusiveScan(
+    blockCells.begin(), blockCells.end(), blockCells.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    blockConnectivity.begin(), blockConnectivity.end(), blockConnectivity.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    blockFaces.begin(), blockFaces.end(), blockFaces.begin(), vtkIdType(0));
+
+  // The kept points are numbered by increasing input id.
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkSMPTools::ExclusiveScan(pointFlags, pointFlags + numPts, pointMap.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = numPts > 0 ? pointMap[numPts - 1] + (pointFlags[numPts - 1] != 0) : 0;
+  this->PointIds->SetNumberOfIds(numNewPts);
+  vtkIdType* pointIds = this->PointIds->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (pointFlags[ptId])
+      {
+        pointIds[pointMap[ptId]] = ptId;
+      }
+    }
+  });
+
+  // Fill the output cells.
+  const vtkIdType numOutCells = blockCells[numBlocks];
+  this->CellIds->SetNumberOfIds(numOutCells);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numOutCells);
+  vtkSmartPointer<vtkIdTypeArray> outFaceLocations;
+  vtkSmartPointer<vtkIdTypeArray> outFaces;
+  if (faceLocations)
+  {
+    outFaceLocations = vtkSmartPointer<vtkIdTypeArray>::New();
+    outFaceLocations->SetNumberOfValues(numOutCells);
+    outFaces = vtkSmartPointer<vtkIdTypeArray>::New();
+    outFaces->SetNumberOfValues(blockFaces[numBlocks]);
+  }
+
+  vtkSmartPointer<vtkCellArray> cells;
+  if (inputGrid && inputGrid->GetCells() && !inputGrid->GetCells()->IsStorage64Bit())
+  {
+    FillCells<vtkCellArray::ArrayType32> filler{ input, faceLocations, faces, reader, keepCell,
+      pointMap.data(), blockCells, blockConnectivity, blockFaces, nullptr, nullptr,
+      types->GetPointer(0), outFaceLocations ? outFaceLocations->GetPointer(0) : nullptr,
+      outFaces ? outFaces->GetPointer(0) : nullptr, this->CellIds->GetPointer(0) };
+    cells = BuildCells(filler, numBlocks);
+  }
+  else
+  {
+    FillCells<vtkCellArray::ArrayType64> filler{ input, faceLocations, faces, reader, keepCell,
+      pointMap.data(), blockCells, blockConnectivity, blockFaces, nullptr, nullptr,
+      types->GetPointer(0), outFaceLocations ? outFaceLocations->GetPointer(0) : nullptr,
+      outFaces ? outFaces->GetPointer(0) : nullptr, this->CellIds->GetPointer(0) };
+    cells = BuildCells(filler, numBlocks);
+  }
+
+  // Copy the kept points.
+  newPoints->SetNumberOfPoints(numNewPts);
+  vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
+  if (inputPointSet && inputPointSet->GetPoints())
+  {
+    using Dispatcher =
+      vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::Reals, vtkArrayDispatch::Reals>;
+    CopyPointsWorker worker;
+    vtkDataArray* inArray = inputPointSet->GetPoints()->GetData();
+    vtkDataArray* outArray = newPoints->GetData();
+    if (!Dispatcher::Execute(inArray, outArray, worker, pointIds))
+    {
+      worker(inArray, outArray, pointIds);
+    }
+  }
+  else if (numNewPts > 0)
+  {
+    double x[3];
+    input->GetPoint(0, x); // make GetPoint() thread-safe
+    vtkDataArray* outArray = newPoints->GetData();
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+      double p[3];
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        input->GetPoint(pointIds[i], p);
+        outArray->SetTuple(i, p);
+      }
+    });
+  }
+
+  output->SetPoints(newPoints);
+  if (faceLocations)
+  {
+    output->SetCells(types, cells, outFaceLocations, outFaces);
+  }
+  else
+  {
+    output->SetCells(types, cells);
+  }
+
+  // Copy the attributes at once.
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(input->GetPointData(), numNewPts);
+  outPD->CopyData(input->GetPointData(), this->PointIds);
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(input->GetCellData(), numOutCells);
+  outCD->CopyData(input->GetCellData(), this->CellIds);
+}
+
+//------------------------------------------------------------------------------
+void vtkCellSubsetExtractor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Number Of Points: " << this->PointIds->GetNumberOfIds() << endl;
+  os << indent << "Number Of Cells: " << this->CellIds->GetNumberOfIds() << endl;
+}
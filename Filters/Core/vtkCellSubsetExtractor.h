@@ -0,0 +1,101 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellSubsetExtractor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCellSubsetExtractor
+ * @brief   extract the cells of a dataset satisfying a predicate into an
+ * unstructured grid using multiple threads
+ *
+ * vtkCellSubsetExtractor is a helper for filters extracting a subset of the
+ * cells of their input, such as vtkThreshold. The extraction is done in two
+ * passes over blocks of cells processed with vtkSMPTools. The first pass
+ * evaluates the predicate on each cell and counts the cells, connectivity
+ * and polyhedron faces kept in each block, and flags the points used by the
+ * kept cells. Prefix sums of these counts give the location of the output
+ * of every block, and of every kept point. The second pass then fills the
+ * connectivity, cell types and faces of the output in parallel. The point
+ * coordinates are copied in parallel, and the point and cell attributes are
+ * copied at once.
+ *
+ * The output cells are ordered as in the input and the output points by
+ * increasing input id, so that the output does not depend on the number of
+ * threads. The connectivity of an unstructured grid input keeps its 32 or
+ * 64 bit storage.
+ *
+ * @sa
+ * vtkThreshold vtkExtractGeometry vtkExtractUnstructuredGrid vtkSMPTools
+ */
+
+#ifndef vtkCellSubsetExtractor_h
+#define vtkCellSubsetExtractor_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkSmartPointer.h" // For vtkSmartPointer
+
+#include <functional> // For std::function
+
+class vtkDataSet;
+class vtkIdList;
+class vtkPoints;
+class vtkUnstructuredGrid;
+
+class VTKFILTERSCORE_EXPORT vtkCellSubsetExtractor : public vtkObject
+{
+public:
+  static vtkCellSubsetExtractor* New();
+  vtkTypeMacro(vtkCellSubsetExtractor, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Decide whether a cell is extracted, given its id and its point ids. The
+   * predicate is called concurrently from several threads and must be
+   * thread-safe. Empty cells are never extracted.
+   */
+  using CellPredicate = std::function<bool(vtkIdType cellId, vtkIdList* pointIds)>;
+
+  /**
+   * Extract the cells of the input satisfying the predicate into the output.
+   * If pointFlags is not nullptr, the output points are the input points
+   * whose flag is not 0, which must include all the points of the extracted
+   * cells. Otherwise they are the points used by the extracted cells. The
+   * coordinates are stored in newPoints, whose data type is kept, and which
+   * becomes the points of the output. The point and cell data are copied
+   * according to the copy flags of the output attributes.
+   */
+  void Extract(vtkDataSet* input, const CellPredicate& predicate, const unsigned char* pointFlags,
+    vtkPoints* newPoints, vtkUnstructuredGrid* output);
+
+  ///@{
+  /**
+   * Get the input ids of the output points and cells of the last
+   * extraction, e.g. to update a vtkDataObjectMeshCache.
+   */
+  vtkIdList* GetPointIds() { return this->PointIds; }
+  vtkIdList* GetCellIds() { return this->CellIds; }
+  ///@}
+
+protected:
+  vtkCellSubsetExtractor();
+  ~vtkCellSubsetExtractor() override;
+
+  vtkSmartPointer<vtkIdList> PointIds;
+  vtkSmartPointer<vtkIdList> CellIds;
+
+private:
+  vtkCellSubsetExtractor(const vtkCellSubsetExtractor&) = delete;
+  void operator=(const vtkCellSubsetExtractor&) = delete;
+};
+
+#endif
@@ -16,6 +16,8 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCleanPolyDataInternal.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
@@ -25,9 +27,14 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <atomic>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 vtkStandardNewMacro(vtkCleanPolyData);
 
@@ -47,6 +54,287 @@ bool InsertPointUsingGlobalId(vtkIdType globalId, vtkPoints* newPts,
   ptId = it->second;
   return false;
 }
+
+// The threaded clean gives the same output as the incremental insertion of
+// the points when the points are not merged, or are merged exactly (zero
+// tolerance with the default vtkMergePoints locator) without global ids and
+// keep their precision. The points must not be modified by a subclass
+// through OperateOnPoint.
+bool CanCleanInParallel(
+  vtkCleanPolyData* self, bool operatesOnPoints, vtkPolyData* input, vtkPoints* newPts)
+{
+  if (operatesOnPoints)
+  {
+    return false;
+  }
+  if (!self->GetPointMerging())
+  {
+    return true;
+  }
+  const double tol = self->GetToleranceIsAbsolute() ? self->GetAbsoluteTolerance()
+                                                    : self->GetTolerance() * input->GetLength();
+  vtkIncrementalPointLocator* locator = self->GetLocator();
+  return tol == 0.0 && (locator == nullptr || locator->IsA("vtkMergePoints")) &&
+    vtkIdTypeArray::SafeDownCast(input->GetPointData()->GetGlobalIds()) == nullptr &&
+    newPts->GetDataType() == input->GetPoints()->GetDataType();
+}
+
+// The connectivity of a cell array, with 32 or 64 bit storage, located by
+// the position of its first id in the traversal of all the cell arrays.
+struct CleanConnectivity
+{
+  const vtkTypeInt32* Ids32;
+  const vtkTypeInt64* Ids64;
+  vtkIdType Base;
+
+  vtkIdType operator[](vtkIdType i) const
+  {
+    return this->Ids64 ? static_cast<vtkIdType>(this->Ids64[i]) : this->Ids32[i];
+  }
+};
+
+// A block of connectivity ids of one of the cell arrays, with the number of
+// points used there for the first time, later turned into the id of the
+// first of these new points.
+struct CleanConnectivityBlock
+{
+  int Type;
+  vtkIdType Begin;
+  vtkIdType End;
+  vtkIdType NumNewPts;
+};
+
+// Map the points of a cell to the new points as the incremental clean does:
+// consecutive duplicate points are culled out of all but the verts, and
+// polys and strips are not closed explicitly. The cell array of the
+// rewritten cell is given, a cell keeping all its points being possibly
+// moved into a lower cell array.
+struct CleanRewrite
+{
+  const vtkIdType* PointMap;
+  bool Convert[3];
+
+  int operator()(int type, vtkIdList* cellPts, vtkIdList* newPts) const
+  {
+    const vtkIdType npts = cellPts->GetNumberOfIds();
+    newPts->SetNumberOfIds(npts);
+    vtkIdType* ids = newPts->GetPointer(0);
+    vtkIdType numNewPts = 0;
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType ptId = this->PointMap[cellPts->GetId(i)];
+      if (type == CLEAN_VERTS || numNewPts == 0 || ptId != ids[numNewPts - 1])
+      {
+        ids[numNewPts++] = ptId;
+      }
+    }
+    if (((type == CLEAN_POLYS && numNewPts > 2) || (type == CLEAN_STRIPS && numNewPts > 1)) &&
+      ids[0] == ids[numNewPts - 1])
+    {
+      numNewPts--;
+    }
+    newPts->SetNumberOfIds(numNewPts);
+    const bool unmodified = (npts == numNewPts);
+    const bool convert[3] = { this->Convert[0] || unmodified, this->Convert[1] || unmodified,
+      this->Convert[2] || unmodified };
+    return CleanOutputCellArray(type, numNewPts, convert);
+  }
+};
+
+// Clean the input with vtkSMPTools. The output points are numbered in the
+// order of their first use by the cells, and take the coordinates and data
+// of the input point used there, as done by the incremental insertion. The
+// output is left empty if the execution is aborted.
+void CleanInParallel(vtkCleanPolyData* self, vtkPolyData* input, vtkPoints* newPts,
+  vtkPolyData* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // Map the points to the points they are merged to. Exactly coincident
+  // points are merged.
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkIdType* ptMap = pointMap.data();
+  if (self->GetPointMerging())
+  {
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(input);
+    locator->BuildLocator();
+    locator->MergePoints(0.0, ptMap);
+  }
+  else
+  {
+    vtkSMPTools::For(0, numPts, [ptMap](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        ptMap[ptId] = ptId;
+      }
+    }); // end lambda
+  }
+  if (self->GetAbortExecute())
+  {
+    return;
+  }
+
+  // Split the connectivity of all the cell arrays into blocks.
+  const vtkIdType blockSize = 8192;
+  CleanConnectivity conn[CLEAN_NUMBER_OF_CELL_ARRAYS];
+  std::vector<CleanConnectivityBlock> blocks;
+  vtkIdType numConn = 0;
+  for (int type = 0; type < CLEAN_NUMBER_OF_CELL_ARRAYS; ++type)
+  {
+    vtkCellArray* cells = GetCleanCellArray(input, type);
+    const bool is64Bit = cells->IsStorage64Bit();
+    conn[type].Ids32 = is64Bit ? nullptr : cells->GetConnectivityArray32()->GetPointer(0);
+    conn[type].Ids64 = is64Bit ? cells->GetConnectivityArray64()->GetPointer(0) : nullptr;
+    conn[type].Base = numConn;
+    const vtkIdType size = cells->GetNumberOfConnectivityIds();
+    for (vtkIdType begin = 0; begin < size; begin += blockSize)
+    {
+      CleanConnectivityBlock block = { type, begin, std::min(begin + blockSize, size), 0 };
+      blocks.push_back(block);
+    }
+    numConn += size;
+  }
+  const vtkIdType numBlocks = static_cast<vtkIdType>(blocks.size());
+
+  // Find the first use of every merged point, as the smallest position of
+  // the ids of its points in the connectivity.
+  std::unique_ptr<std::atomic<vtkIdType>[]> uFirstUses(new std::atomic<vtkIdType>[numPts]);
+  std::atomic<vtkIdType>* firstUses = uFirstUses.get();
+  vtkSMPTools::For(0, numPts, [firstUses, numConn](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstUses[ptId].store(numConn, std::memory_order_relaxed);
+    }
+  }); // end lambda
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    for (; blockId < endBlockId; ++blockId)
+    {
+      const CleanConnectivityBlock& block = blocks[blockId];
+      const CleanConnectivity& ids = conn[block.Type];
+      for (vtkIdType i = block.Begin; i < block.End; ++i)
+      {
+        const vtkIdType position = ids.Base + i;
+        std::atomic<vtkIdType>& firstUse = firstUses[ptMap[ids[i]]];
+        vtkIdType current = firstUse.load(std::memory_order_relaxed);
+        while (position < current &&
+          !firstUse.compare_exchange_weak(current, position, std::memory_order_relaxed))
+        {
+        }
+      }
+    }
+  }); // end lambda
+  if (self->GetAbortExecute())
+  {
+    return;
+  }
+
+  // Number the new points in the order of their first use, and remember
+  // the input point used there.
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    for (; blockId < endBlockId; ++blockId)
+    {
+      CleanConnectivityBlock& block = blocks[blockId];
+      const CleanConnectivity& ids = conn[block.Type];
+      for (vtkIdType i = block.Begin; i < block.End; ++i)
+      {
+        block.NumNewPts += (firstUses[ptMap[ids[i]]] == ids.Base + i);
+      }
+    }
+  }); // end lambda
+  vtkIdType numNewPts = 0;
+  for (CleanConnectivityBlock& block : blocks)
+  {
+    const vtkIdType blockNewPts = block.NumNewPts;
+    block.NumNewPts = numNewPts;
+    numNewPts += blockNewPts;
+  }
+  std::vector<vtkIdType> newPtIds(numPts, -1);
+  vtkNew<vtkIdList> sourceIds;
+  sourceIds->SetNumberOfIds(numNewPts);
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType blockId, vtkIdType endBlockId) {
+    for (; blockId < endBlockId; ++blockId)
+    {
+      CleanConnectivityBlock& block = blocks[blockId];
+      const CleanConnectivity& ids = conn[block.Type];
+      for (vtkIdType i = block.Begin; i < block.End; ++i)
+      {
+        const vtkIdType mergedId = ptMap[ids[i]];
+        if (firstUses[mergedId] == ids.Base + i)
+        {
+          newPtIds[mergedId] = block.NumNewPts;
+          sourceIds->SetId(block.NumNewPts++, ids[i]);
+        }
+      }
+    }
+  }); // end lambda
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      ptMap[ptId] = newPtIds[ptMap[ptId]];
+    }
+  }); // end lambda
+  if (self->GetAbortExecute())
+  {
+    return;
+  }
+
+  // Copy the points and their data.
+  vtkDataArray* inCoords = input->GetPoints()->GetData();
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkDataArray* newCoords = newPts->GetData();
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      newCoords->SetTuple(ptId, sourceIds->GetId(ptId), inCoords);
+    }
+  }); // end lambda
+  output->SetPoints(newPts);
+  vtkPointData* outputPD = output->GetPointData();
+  if (!self->GetPointMerging())
+  {
+    outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outputPD->CopyAllocate(input->GetPointData(), numNewPts);
+  outputPD->CopyData(input->GetPointData(), sourceIds);
+  self->UpdateProgress(0.5);
+  if (self->GetAbortExecute())
+  {
+    output->Initialize();
+    return;
+  }
+
+  // Rewrite the cells and copy their data.
+  CleanRewrite rewrite;
+  rewrite.PointMap = ptMap;
+  rewrite.Convert[CLEAN_VERTS] = self->GetConvertLinesToPoints() != 0;
+  rewrite.Convert[CLEAN_LINES] = self->GetConvertPolysToLines() != 0;
+  rewrite.Convert[CLEAN_POLYS] = self->GetConvertStripsToPolys() != 0;
+  CleanCells newCells;
+  RewriteCleanCells(input, rewrite, newCells);
+
+  vtkCellData* outputCD = output->GetCellData();
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(input->GetCellData(), newCells.GetNumberOfCells());
+  outputCD->CopyData(input->GetCellData(), newCells.CellIds);
+
+  if (newCells.Cells[CLEAN_VERTS])
+  {
+    output->SetVerts(newCells.Cells[CLEAN_VERTS]);
+  }
+  if (newCells.Cells[CLEAN_LINES])
+  {
+    output->SetLines(newCells.Cells[CLEAN_LINES]);
+  }
+  if (newCells.Cells[CLEAN_POLYS])
+  {
+    output->SetPolys(newCells.Cells[CLEAN_POLYS]);
+  }
+  if (newCells.Cells[CLEAN_STRIPS])
+  {
+    output->SetStrips(newCells.Cells[CLEAN_STRIPS]);
+  }
+}
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -151,8 +439,6 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
-  vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
-
   vtkIdType numNewPts;
   vtkIdType numUsedPts = 0;
   vtkPoints* newPts = inPts->NewInstance();
@@ -171,6 +457,15 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     newPts->SetDataType(VTK_DOUBLE);
   }
 
+  // When it gives the same output, the input is cleaned in parallel.
+  if (CanCleanInParallel(this, this->OperatesOnPoints(), input, newPts))
+  {
+    CleanInParallel(this, input, newPts, output);
+    newPts->Delete();
+    return 1;
+  }
+
+  vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
   newPts->Allocate(numPts);
 
   // we'll be needing these
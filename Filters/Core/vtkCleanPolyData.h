@@ -53,6 +53,12 @@
  * will not be used, and points that are not used by any cells will be
  * eliminated, but never merged.
  *
+ * When the points are not merged, or are merged exactly (zero tolerance
+ * with the default vtkMergePoints locator and no global ids) keeping their
+ * precision, the input is cleaned in parallel with vtkSMPTools. The output
+ * is the same as the one of the incremental insertion of the points, which
+ * is used otherwise and by subclasses.
+ *
  * @warning
  * Merging points can alter topology, including introducing non-manifold
  * forms. The tolerance should be chosen carefully to avoid these problems.
@@ -194,6 +200,13 @@ public:
    */
   virtual void OperateOnBounds(double in[6], double out[6]);
 
+  /**
+   * Return true if OperateOnPoint() modifies the points. The points are then
+   * inserted one at a time, and never cleaned in parallel. Returns false;
+   * subclasses overriding OperateOnPoint() must override it as well.
+   */
+  virtual bool OperatesOnPoints() { return false; }
+
   // This filter is difficult to stream.
   // To get invariant results, the whole input must be processed at once.
   // This flag allows the user to select whether strict piece invariance
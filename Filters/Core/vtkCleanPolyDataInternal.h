@@ -0,0 +1,255 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCleanPolyDataInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCleanPolyDataInternal
+ * @brief   threaded rewriting of the cells of a vtkPolyData
+ *
+ * vtkCleanPolyDataInternal rewrites the verts, lines, polys and strips of a
+ * vtkPolyData with vtkSMPTools, as done by the filters cleaning polygonal
+ * data. A rewrite functor maps the point ids of each input cell, removes the
+ * duplicate points, and tells into which cell array (possibly a lower one
+ * when the cell is degenerate) the rewritten cell goes, or drops it.
+ *
+ * The cells are processed in blocks of a single cell array, in two passes.
+ * The first pass counts the cells and connectivity produced by each block
+ * for each output cell array, prefix sums of these counts locate the output
+ * of every block, and the second pass fills the output. The output cells
+ * of each cell array are ordered as in the input, so that the output does
+ * not depend on the number of threads, and is the one of a serial traversal
+ * of the verts, lines, polys and strips.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkCleanPolyData vtkStaticCleanPolyData
+ */
+
+#ifndef vtkCleanPolyDataInternal_h
+#define vtkCleanPolyDataInternal_h
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// The cell arrays of a vtkPolyData, in the order of the cell ids.
+enum CleanCellArray
+{
+  CLEAN_VERTS = 0,
+  CLEAN_LINES = 1,
+  CLEAN_POLYS = 2,
+  CLEAN_STRIPS = 3,
+  CLEAN_NUMBER_OF_CELL_ARRAYS = 4
+};
+
+inline vtkCellArray* GetCleanCellArray(vtkPolyData* pd, int type)
+{
+  switch (type)
+  {
+    case CLEAN_VERTS:
+      return pd->GetVerts();
+    case CLEAN_LINES:
+      return pd->GetLines();
+    case CLEAN_POLYS:
+      return pd->GetPolys();
+    default:
+      return pd->GetStrips();
+  }
+}
+
+// The minimal number of points of a cell of each cell array
+const vtkIdType CleanMinimumCellSize[CLEAN_NUMBER_OF_CELL_ARRAYS] = { 1, 2, 3, 4 };
+
+// Give the cell array of a rewritten cell of the given cell array with
+// numPts points: its own one if the cell is still valid, or the lower one
+// whose cells have exactly numPts points if the conversion to it is
+// enabled, or -1 if the cell is dropped. The conversions into the verts,
+// lines and polys are given by convert.
+inline int CleanOutputCellArray(int type, vtkIdType numPts, const bool convert[3])
+{
+  if (numPts >= CleanMinimumCellSize[type])
+  {
+    return type;
+  }
+  const int lower = static_cast<int>(numPts) - 1;
+  return (lower >= 0 && convert[lower]) ? lower : -1;
+}
+
+// A block of cells of one of the input cell arrays, with the number of cells
+// and connectivity ids it produces in each output cell array, later turned
+// into the location of its output.
+struct CleanCellBlock
+{
+  int Type;
+  vtkIdType Begin;
+  vtkIdType End;
+  vtkIdType NumCells[CLEAN_NUMBER_OF_CELL_ARRAYS];
+  vtkIdType NumConnectivity[CLEAN_NUMBER_OF_CELL_ARRAYS];
+};
+
+// The rewritten cells: the output cell arrays (nullptr when the input cell
+// array and the rewritten cells are all empty), and the input cell ids of
+// the output cells, ordered as the output cells.
+struct CleanCells
+{
+  vtkSmartPointer<vtkCellArray> Cells[CLEAN_NUMBER_OF_CELL_ARRAYS];
+  vtkNew<vtkIdList> CellIds;
+
+  vtkIdType GetNumberOfCells() const { return this->CellIds->GetNumberOfIds(); }
+};
+
+// Rewrite the cells of the input. The rewrite functor is called
+// concurrently as
+//   int rewrite(int type, vtkIdList* cellPts, vtkIdList* newPts)
+// with the type of the input cell array, and must fill newPts with the
+// output point ids and return the output cell array or -1.
+template <typename RewriteT>
+void RewriteCleanCells(vtkPolyData* input, const RewriteT& rewrite, CleanCells& output)
+{
+  const vtkIdType blockSize = 4096;
+  vtkCellArray* inCells[CLEAN_NUMBER_OF_CELL_ARRAYS];
+  vtkIdType inCellIdBase[CLEAN_NUMBER_OF_CELL_ARRAYS];
+  std::vector<CleanCellBlock> blocks;
+  vtkIdType numInCells = 0;
+  for (int type = 0; type < CLEAN_NUMBER_OF_CELL_ARRAYS; ++type)
+  {
+    inCells[type] = GetCleanCellArray(input, type);
+    inCellIdBase[type] = numInCells;
+    const vtkIdType numCells = inCells[type]->GetNumberOfCells();
+    for (vtkIdType begin = 0; begin < numCells; begin += blockSize)
+    {
+      CleanCellBlock block;
+      block.Type = type;
+      block.Begin = begin;
+      block.End = std::min(begin + blockSize, numCells);
+      blocks.push_back(block);
+    }
+    numInCells += numCells;
+  }
+
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPThreadLocalObject<vtkIdList> tlNewPts;
+
+  // First pass: count the output of every block.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), 1,
+    [&](vtkIdType blockId, vtkIdType endBlockId) {
+      vtkIdList* cellPts = tlCellPts.Local();
+      vtkIdList* newPts = tlNewPts.Local();
+      for (; blockId < endBlockId; ++blockId)
+      {
+        CleanCellBlock& block = blocks[blockId];
+        std::fill_n(block.NumCells, CLEAN_NUMBER_OF_CELL_ARRAYS, 0);
+        std::fill_n(block.NumConnectivity, CLEAN_NUMBER_OF_CELL_ARRAYS, 0);
+        for (vtkIdType cellId = block.Begin; cellId < block.End; ++cellId)
+        {
+          inCells[block.Type]->GetCellAtId(cellId, cellPts);
+          const int outType = rewrite(block.Type, cellPts, newPts);
+          if (outType >= 0)
+          {
+            block.NumCells[outType]++;
+            block.NumConnectivity[outType] += newPts->GetNumberOfIds();
+          }
+        }
+      }
+    });
+
+  // Locate the output of every block. The output cells are numbered by cell
+  // array, and there are few blocks.
+  vtkIdType numCells[CLEAN_NUMBER_OF_CELL_ARRAYS] = { 0, 0, 0, 0 };
+  vtkIdType numConnectivity[CLEAN_NUMBER_OF_CELL_ARRAYS] = { 0, 0, 0, 0 };
+  for (CleanCellBlock& block : blocks)
+  {
+    for (int type = 0; type < CLEAN_NUMBER_OF_CELL_ARRAYS; ++type)
+    {
+      const vtkIdType blockCells = block.NumCells[type];
+      const vtkIdType blockConnectivity = block.NumConnectivity[type];
+      block.NumCells[type] = numCells[type];
+      block.NumConnectivity[type] = numConnectivity[type];
+      numCells[type] += blockCells;
+      numConnectivity[type] += blockConnectivity;
+    }
+  }
+
+  vtkIdType* offsets[CLEAN_NUMBER_OF_CELL_ARRAYS] = { nullptr, nullptr, nullptr, nullptr };
+  vtkIdType* connectivity[CLEAN_NUMBER_OF_CELL_ARRAYS] = { nullptr, nullptr, nullptr, nullptr };
+  vtkIdType outCellIdBase[CLEAN_NUMBER_OF_CELL_ARRAYS];
+  vtkIdType numOutCells = 0;
+  for (int type = 0; type < CLEAN_NUMBER_OF_CELL_ARRAYS; ++type)
+  {
+    outCellIdBase[type] = numOutCells;
+    numOutCells += numCells[type];
+    output.Cells[type] = nullptr;
+    if (numCells[type] == 0 && inCells[type]->GetNumberOfCells() == 0)
+    {
+      continue;
+    }
+    vtkNew<vtkIdTypeArray> offsetsArray;
+    offsetsArray->SetNumberOfValues(numCells[type] + 1);
+    offsetsArray->SetValue(numCells[type], numConnectivity[type]);
+    vtkNew<vtkIdTypeArray> connectivityArray;
+    connectivityArray->SetNumberOfValues(numConnectivity[type]);
+    offsets[type] = offsetsArray->GetPointer(0);
+    connectivity[type] = connectivityArray->GetPointer(0);
+    output.Cells[type] = vtkSmartPointer<vtkCellArray>::New();
+    output.Cells[type]->SetData(offsetsArray, connectivityArray);
+  }
+  output.CellIds->SetNumberOfIds(numOutCells);
+  vtkIdType* cellIds = output.CellIds->GetPointer(0);
+
+  // Second pass: fill the output.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), 1,
+    [&](vtkIdType blockId, vtkIdType endBlockId) {
+      vtkIdList* cellPts = tlCellPts.Local();
+      vtkIdList* newPts = tlNewPts.Local();
+      for (; blockId < endBlockId; ++blockId)
+      {
+        CleanCellBlock& block = blocks[blockId];
+        for (vtkIdType cellId = block.Begin; cellId < block.End; ++cellId)
+        {
+          inCells[block.Type]->GetCellAtId(cellId, cellPts);
+          const int outType = rewrite(block.Type, cellPts, newPts);
+          if (outType < 0)
+          {
+            continue;
+          }
+          const vtkIdType outCellId = block.NumCells[outType]++;
+          offsets[outType][outCellId] = block.NumConnectivity[outType];
+          std::copy_n(newPts->GetPointer(0), newPts->GetNumberOfIds(),
+            connectivity[outType] + block.NumConnectivity[outType]);
+          block.NumConnectivity[outType] += newPts->GetNumberOfIds();
+          cellIds[outCellIdBase[outType] + outCellId] = inCellIdBase[block.Type] + cellId;
+        }
+      }
+    });
+}
+
+} // anonymous namespace
+
+#endif // vtkCleanPolyDataInternal_h
+// VTK-HeaderTest-Exclude: vtkCleanPolyDataInternal.h
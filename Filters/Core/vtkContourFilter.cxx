@@ -18,6 +18,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkContour3DLinearGrid.h"
 #include "vtkContourGrid.h"
 #include "vtkContourHelper.h"
 #include "vtkContourValues.h"
@@ -44,6 +45,7 @@
 #include "vtkSynchronizedTemplates3D.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
+#include "vtkUnstructuredGrid.h"
 
 #include <cmath>
 
@@ -77,6 +79,7 @@ vtkContourFilter::vtkContourFilter()
   this->SynchronizedTemplates3D = vtkSynchronizedTemplates3D::New();
   this->GridSynchronizedTemplates = vtkGridSynchronizedTemplates3D::New();
   this->RectilinearSynchronizedTemplates = vtkRectilinearSynchronizedTemplates::New();
+  this->Contour3DLinearGrid = vtkContour3DLinearGrid::New();
 
   this->InternalProgressCallbackCommand = vtkCallbackCommand::New();
   this->InternalProgressCallbackCommand->SetCallback(
@@ -91,6 +94,8 @@ vtkContourFilter::vtkContourFilter()
     vtkCommand::ProgressEvent, this->InternalProgressCallbackCommand);
   this->RectilinearSynchronizedTemplates->AddObserver(
     vtkCommand::ProgressEvent, this->InternalProgressCallbackCommand);
+  this->Contour3DLinearGrid->AddObserver(
+    vtkCommand::ProgressEvent, this->InternalProgressCallbackCommand);
 
   // by default process active point scalars
   this->SetInputArrayToProcess(
@@ -115,6 +120,7 @@ vtkContourFilter::~vtkContourFilter()
   this->SynchronizedTemplates3D->Delete();
   this->GridSynchronizedTemplates->Delete();
   this->RectilinearSynchronizedTemplates->Delete();
+  this->Contour3DLinearGrid->Delete();
   this->InternalProgressCallbackCommand->Delete();
 }
 
@@ -406,6 +412,34 @@ int vtkContourFilter::RequestData(
   vtkCellData* outCd = output->GetCellData();
 
   vtkDebugMacro(<< "Executing contour filter");
+
+  // handle unstructured grids of linear 3D cells with a scalar tree. The
+  // cells spanning the contour values are processed in parallel, and the
+  // scalar tree is reused until the input is modified.
+  if (this->UseScalarTree && this->GenerateTriangles && vtkUnstructuredGrid::SafeDownCast(input) &&
+    inCd->GetNumberOfArrays() == 0 && inScalars->GetName() &&
+    vtkContour3DLinearGrid::CanFullyProcessDataObject(input, inScalars->GetName()))
+  {
+    if (this->ScalarTree == nullptr)
+    {
+      this->ScalarTree = vtkSpanSpace::New();
+    }
+    this->Contour3DLinearGrid->SetNumberOfContours(numContours);
+    for (i = 0; i < numContours; i++)
+    {
+      this->Contour3DLinearGrid->SetValue(i, values[i]);
+    }
+    this->Contour3DLinearGrid->SetMergePoints(true);
+    this->Contour3DLinearGrid->SetInterpolateAttributes(true);
+    this->Contour3DLinearGrid->SetComputeNormals(this->ComputeNormals != 0);
+    this->Contour3DLinearGrid->SetComputeScalars(this->ComputeScalars);
+    this->Contour3DLinearGrid->SetOutputPointsPrecision(this->OutputPointsPrecision);
+    this->Contour3DLinearGrid->SetUseScalarTree(true);
+    this->Contour3DLinearGrid->SetScalarTree(this->ScalarTree);
+    this->Contour3DLinearGrid->SetInputArrayToProcess(0, this->GetInputArrayInformation(0));
+    return this->Contour3DLinearGrid->ProcessRequest(request, inputVector, outputVector);
+  } // if linear 3D unstructured grid with a scalar tree
+
   if (input->IsA("vtkUnstructuredGridBase"))
   {
     vtkDebugMacro(<< "Processing unstructured grid");
@@ -32,7 +32,12 @@
  * vtkScalarTree. A scalar tree is used to quickly locate cells that
  * contain a contour surface. This is especially effective if multiple
  * contours are being extracted. If you want to use a scalar tree,
- * invoke the method UseScalarTreeOn().
+ * invoke the method UseScalarTreeOn(). The scalar tree is kept between
+ * executions, so that changing the contour values of the same input does
+ * not rebuild it. Unstructured grids of linear 3D cells without cell data
+ * are then contoured in parallel by vtkContour3DLinearGrid, which only
+ * visits the batches of cells of the scalar tree spanning the contour
+ * values.
  *
  * @warning
  * For unstructured data or structured grids, normals and gradients
@@ -60,6 +65,7 @@
 #include "vtkContourValues.h" // Needed for inline methods
 
 class vtkIncrementalPointLocator;
+class vtkContour3DLinearGrid;
 class vtkScalarTree;
 class vtkSynchronizedTemplates2D;
 class vtkSynchronizedTemplates3D;
@@ -227,6 +233,7 @@ protected:
   vtkSynchronizedTemplates3D* SynchronizedTemplates3D;
   vtkGridSynchronizedTemplates3D* GridSynchronizedTemplates;
   vtkRectilinearSynchronizedTemplates* RectilinearSynchronizedTemplates;
+  vtkContour3DLinearGrid* Contour3DLinearGrid;
   vtkCallbackCommand* InternalProgressCallbackCommand;
 
   static void InternalProgressCallbackFunction(
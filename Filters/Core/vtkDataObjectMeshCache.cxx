@@ -0,0 +1,165 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataObjectMeshCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataObjectMeshCache.h"
+
+#include "vtkCellData.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+
+namespace
+{
+// Output points or cells without an input id, e.g. interpolated points, have
+// a negative id and cannot be copied from the input.
+bool HasNegativeId(vtkIdList* ids)
+{
+  return ids && std::any_of(ids->begin(), ids->end(), [](vtkIdType id) { return id < 0; });
+}
+}
+
+vtkStandardNewMacro(vtkDataObjectMeshCache);
+
+//------------------------------------------------------------------------------
+vtkDataObjectMeshCache::vtkDataObjectMeshCache() = default;
+
+//------------------------------------------------------------------------------
+vtkDataObjectMeshCache::~vtkDataObjectMeshCache() = default;
+
+//------------------------------------------------------------------------------
+vtkMTimeType vtkDataObjectMeshCache::GetMeshMTime(vtkDataSet* input)
+{
+  vtkMTimeType time = 0;
+  if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input))
+  {
+    time = grid->GetMeshMTime();
+  }
+  else if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(input))
+  {
+    time = polyData->GetMeshMTime();
+  }
+  if (time == 0)
+  {
+    return 0;
+  }
+
+  // ghost cells and points may be skipped by the filters
+  if (vtkUnsignedCharArray* ghosts = input->GetPointGhostArray())
+  {
+    time = std::max(time, ghosts->GetMTime());
+  }
+  if (vtkUnsignedCharArray* ghosts = input->GetCellGhostArray())
+  {
+    time = std::max(time, ghosts->GetMTime());
+  }
+  return time;
+}
+
+//------------------------------------------------------------------------------
+bool vtkDataObjectMeshCache::IsValid(vtkDataSet* input, vtkMTimeType dependencyMTime)
+{
+  return this->Mesh && this->MeshMTime != 0 && this->MeshMTime == GetMeshMTime(input) &&
+    this->DependencyMTime == dependencyMTime &&
+    this->NumberOfInputPoints == input->GetNumberOfPoints() &&
+    this->NumberOfInputCells == input->GetNumberOfCells();
+}
+
+//------------------------------------------------------------------------------
+void vtkDataObjectMeshCache::UpdateCache(vtkDataSet* input, vtkDataSet* output,
+  vtkIdList* pointIds, vtkIdList* cellIds, vtkMTimeType dependencyMTime)
+{
+  this->ClearCache();
+  this->MeshMTime = GetMeshMTime(input);
+  if (this->MeshMTime == 0 || !cellIds || cellIds->GetNumberOfIds() != output->GetNumberOfCells() ||
+    (pointIds ? pointIds->GetNumberOfIds() != output->GetNumberOfPoints()
+              : output->GetNumberOfPoints() != input->GetNumberOfPoints()) ||
+    HasNegativeId(pointIds) || HasNegativeId(cellIds))
+  {
+    this->MeshMTime = 0;
+    return;
+  }
+
+  // the mesh is shared, not copied
+  this->Mesh = vtkSmartPointer<vtkDataSet>::Take(output->NewInstance());
+  this->Mesh->CopyStructure(output);
+  if (pointIds)
+  {
+    this->PointIds = vtkSmartPointer<vtkIdList>::New();
+    this->PointIds->DeepCopy(pointIds);
+  }
+  this->CellIds = vtkSmartPointer<vtkIdList>::New();
+  this->CellIds->DeepCopy(cellIds);
+  this->DependencyMTime = dependencyMTime;
+  this->NumberOfInputPoints = input->GetNumberOfPoints();
+  this->NumberOfInputCells = input->GetNumberOfCells();
+}
+
+//------------------------------------------------------------------------------
+void vtkDataObjectMeshCache::CopyCacheToDataObject(vtkDataSet* input, vtkDataSet* output)
+{
+  if (!this->Mesh)
+  {
+    vtkErrorMacro("No cached mesh to copy.");
+    return;
+  }
+
+  output->CopyStructure(this->Mesh);
+
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  if (this->PointIds)
+  {
+    outPD->CopyAllocate(inPD, this->PointIds->GetNumberOfIds());
+    outPD->CopyData(inPD, this->PointIds);
+  }
+  else
+  {
+    outPD->PassData(inPD);
+  }
+
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(input->GetCellData(), this->CellIds->GetNumberOfIds());
+  outCD->CopyData(input->GetCellData(), this->CellIds);
+
+  ++this->NumberOfReuses;
+}
+
+//------------------------------------------------------------------------------
+void vtkDataObjectMeshCache::ClearCache()
+{
+  this->Mesh = nullptr;
+  this->PointIds = nullptr;
+  this->CellIds = nullptr;
+  this->MeshMTime = 0;
+  this->DependencyMTime = 0;
+  this->NumberOfInputPoints = 0;
+  this->NumberOfInputCells = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkDataObjectMeshCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Mesh: " << this->Mesh << endl;
+  os << indent << "MeshMTime: " << this->MeshMTime << endl;
+  os << indent << "DependencyMTime: " << this->DependencyMTime << endl;
+  os << indent << "NumberOfReuses: " << this->NumberOfReuses << endl;
+}
@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDataObjectMeshCache.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDataObjectMeshCache
+ * @brief   reuse the mesh generated by a filter while only the attributes
+ * of its input change
+ *
+ * vtkDataObjectMeshCache stores the mesh (points and cells) produced by a
+ * filter together with the input ids of its output points and cells. As
+ * long as the mesh of the input, as given by GetMeshMTime(), and the
+ * settings the filter depends on are unchanged, the filter can skip its
+ * execution: the cached mesh is copied to the output and the attributes of
+ * the input are copied using the cached ids. This is typically the case of
+ * a time series on a static mesh, where only the point or cell data change
+ * from one time step to the next.
+ *
+ * Since the cached mesh is shared with the output, the mesh of the output
+ * keeps its modification time, and downstream filters using a
+ * vtkDataObjectMeshCache can reuse their own mesh as well.
+ *
+ * Only vtkPolyData and vtkUnstructuredGrid inputs are supported. The output
+ * attributes must only be copied from the input, not interpolated: a mesh
+ * with output points or cells without an input id is not cached.
+ *
+ * @sa
+ * vtkThreshold vtkDataSetSurfaceFilter
+ */
+
+#ifndef vtkDataObjectMeshCache_h
+#define vtkDataObjectMeshCache_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkSmartPointer.h" // For vtkSmartPointer
+
+class vtkDataSet;
+class vtkIdList;
+
+class VTKFILTERSCORE_EXPORT vtkDataObjectMeshCache : public vtkObject
+{
+public:
+  static vtkDataObjectMeshCache* New();
+  vtkTypeMacro(vtkDataObjectMeshCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Return the modification time of the mesh of the input: its points, its
+   * cells and its ghost arrays. Return 0 if the input is not supported.
+   */
+  static vtkMTimeType GetMeshMTime(vtkDataSet* input);
+
+  /**
+   * Return true if the cached mesh was generated from the current mesh of
+   * the input, with the same dependency time. The dependency time is the
+   * modification time of everything else the mesh generated by the filter
+   * depends on, e.g. the filter itself and the array it processes.
+   */
+  bool IsValid(vtkDataSet* input, vtkMTimeType dependencyMTime);
+
+  /**
+   * Store the mesh of the output generated from the input. pointIds and
+   * cellIds give the input ids of the output points and cells. A nullptr
+   * pointIds means that the output points are the input points. Nothing is
+   * cached if an id is negative, i.e. if an output point or cell has no
+   * input counterpart, such as a point interpolated by the filter.
+   */
+  void UpdateCache(vtkDataSet* input, vtkDataSet* output, vtkIdList* pointIds,
+    vtkIdList* cellIds, vtkMTimeType dependencyMTime);
+
+  /**
+   * Copy the cached mesh to the output and copy the attributes of the input
+   * with the cached ids. The copy flags of the output attributes are used.
+   * The cache must be valid.
+   */
+  void CopyCacheToDataObject(vtkDataSet* input, vtkDataSet* output);
+
+  /**
+   * Release the cached mesh and ids.
+   */
+  void ClearCache();
+
+  ///@{
+  /**
+   * Get the input ids of the output points and cells of the cached mesh.
+   * The point ids are nullptr if the output points are the input points.
+   */
+  vtkIdList* GetPointIds() { return this->PointIds; }
+  vtkIdList* GetCellIds() { return this->CellIds; }
+  ///@}
+
+  /**
+   * Return the number of times the cached mesh was copied to an output.
+   */
+  vtkGetMacro(NumberOfReuses, vtkIdType);
+
+protected:
+  vtkDataObjectMeshCache();
+  ~vtkDataObjectMeshCache() override;
+
+  vtkSmartPointer<vtkDataSet> Mesh;
+  vtkSmartPointer<vtkIdList> PointIds;
+  vtkSmartPointer<vtkIdList> CellIds;
+  vtkMTimeType MeshMTime = 0;
+  vtkMTimeType DependencyMTime = 0;
+  vtkIdType NumberOfInputPoints = 0;
+  vtkIdType NumberOfInputCells = 0;
+  vtkIdType NumberOfReuses = 0;
+
+private:
+  vtkDataObjectMeshCache(const vtkDataObjectMeshCache&) = delete;
+  void operator=(const vtkDataObjectMeshCache&) = delete;
+};
+
+#endif
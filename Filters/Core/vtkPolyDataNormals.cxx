@@ -15,6 +15,7 @@
 #include "vtkPolyDataNormals.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -27,12 +28,640 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinksTemplate.h"
 #include "vtkTriangleStrip.h"
 
-#include "vtkNew.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataNormals);
 
+namespace
+{
+// Links from the points to the polygons using them.
+using PolyLinks = vtkStaticCellLinksTemplate<vtkIdType>;
+
+// The threaded build of the links inserts the polygons in an arbitrary
+// order. Sort them so that the traversals, the splitting and the
+// accumulation of the normals do not depend on the number of threads.
+struct SortLinks
+{
+  PolyLinks* Links;
+
+  SortLinks(PolyLinks* links)
+    : Links(links)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType* cells = this->Links->GetCells(ptId);
+      std::sort(cells, cells + this->Links->GetNcells(ptId));
+    }
+  }
+};
+
+void BuildSortedLinks(PolyLinks& links, vtkIdType numPts, vtkIdType numPolys, vtkCellArray* polys)
+{
+  links.ThreadedBuildLinks(numPts, numPolys, polys);
+  SortLinks sortLinks(&links);
+  vtkSMPTools::For(0, numPts, sortLinks);
+}
+
+// Get the polygons other than cellId using the edge (p1,p2), like
+// vtkPolyData::GetCellEdgeNeighbors().
+void GetCellEdgeNeighbors(
+  PolyLinks* links, vtkIdType cellId, vtkIdType p1, vtkIdType p2, vtkIdList* cellIds)
+{
+  cellIds->Reset();
+
+  const vtkIdType* cells1 = links->GetCells(p1);
+  const vtkIdType* cells1End = cells1 + links->GetNcells(p1);
+  const vtkIdType* cells2 = links->GetCells(p2);
+  const vtkIdType* cells2End = cells2 + links->GetNcells(p2);
+
+  for (; cells1 != cells1End; ++cells1)
+  {
+    if (*cells1 != cellId && std::find(cells2, cells2End, *cells1) != cells2End)
+    {
+      cellIds->InsertNextId(*cells1);
+    }
+  }
+}
+
+// Compute the normal of each polygon.
+struct ComputePolyNormals
+{
+  vtkPoints* Points;
+  vtkCellArray* Polys;
+  float* Normals;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  ComputePolyNormals(vtkPoints* points, vtkCellArray* polys, float* normals)
+    : Points(points)
+    , Polys(polys)
+    , Normals(normals)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double n[3];
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      vtkPolygon::ComputeNormal(this->Points, npts, pts, n);
+      float* normal = this->Normals + 3 * cellId;
+      normal[0] = static_cast<float>(n[0]);
+      normal[1] = static_cast<float>(n[1]);
+      normal[2] = static_cast<float>(n[2]);
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Propagates waves of consistently ordered polygons. Waves started from
+// polygons of different connected components never meet, so one instance
+// per thread can reorder several components concurrently.
+struct OrderTraversal
+{
+  PolyLinks* Links = nullptr;
+  vtkCellArray* Polys = nullptr;
+  unsigned char* Visited = nullptr;
+  unsigned char* Reversed = nullptr;
+  bool NonManifoldTraversal = true;
+  vtkSmartPointer<vtkCellArrayIterator> Iterator;
+  vtkSmartPointer<vtkIdList> Wave;
+  vtkSmartPointer<vtkIdList> Wave2;
+  vtkSmartPointer<vtkIdList> CellIds;
+  vtkSmartPointer<vtkIdList> CellPoints;
+  vtkSmartPointer<vtkIdList> NeighborPoints;
+  vtkIdType NumFlips = 0;
+
+  void Initialize(PolyLinks* links, vtkCellArray* polys, unsigned char* visited,
+    unsigned char* reversed, bool nonManifoldTraversal)
+  {
+    this->Links = links;
+    this->Polys = polys;
+    this->Visited = visited;
+    this->Reversed = reversed;
+    this->NonManifoldTraversal = nonManifoldTraversal;
+    this->Iterator.TakeReference(polys->NewIterator());
+    this->Wave = vtkSmartPointer<vtkIdList>::New();
+    this->Wave2 = vtkSmartPointer<vtkIdList>::New();
+    this->CellIds = vtkSmartPointer<vtkIdList>::New();
+    this->CellIds->Allocate(VTK_CELL_SIZE);
+    this->CellPoints = vtkSmartPointer<vtkIdList>::New();
+    this->CellPoints->Allocate(VTK_CELL_SIZE);
+    this->NeighborPoints = vtkSmartPointer<vtkIdList>::New();
+    this->NeighborPoints->Allocate(VTK_CELL_SIZE);
+  }
+
+  void ReverseCell(vtkIdType cellId)
+  {
+    this->Polys->ReverseCellAtId(cellId);
+    this->Reversed[cellId] = !this->Reversed[cellId];
+    this->NumFlips++;
+  }
+
+  // Propagate wave of consistently ordered polygons from the seed polygon.
+  void TraverseAndOrder(vtkIdType seedId)
+  {
+    vtkIdType numIds, cellId, npts, numNeiPts, neighbor, k;
+    const vtkIdType* pts;
+    const vtkIdType* neiPts;
+    int j, l, j1;
+
+    this->Visited[seedId] = 1;
+    this->Wave->InsertNextId(seedId);
+
+    // propagate wave until nothing left in wave
+    while ((numIds = this->Wave->GetNumberOfIds()) > 0)
+    {
+      for (vtkIdType i = 0; i < numIds; i++)
+      {
+        cellId = this->Wave->GetId(i);
+
+        // Store the results here in a vtkIdList, since passing npts/pts
+        // directly would result in the data getting invalidated by the
+        // later call to GetCellAtId.
+        this->Iterator->GetCellAtId(cellId, this->CellPoints);
+        npts = this->CellPoints->GetNumberOfIds();
+        pts = this->CellPoints->GetPointer(0);
+
+        for (j = 0, j1 = 1; j < npts; ++j, (j1 = (++j1 < npts) ? j1 : 0)) // for each edge neighbor
+        {
+          GetCellEdgeNeighbors(this->Links, cellId, pts[j], pts[j1], this->CellIds);
+
+          //  Check the direction of the neighbor ordering.  Should be
+          //  consistent with us (i.e., if we are n1->n2,
+          // neighbor should be n2->n1).
+          if (this->CellIds->GetNumberOfIds() == 1 || this->NonManifoldTraversal)
+          {
+            for (k = 0; k < this->CellIds->GetNumberOfIds(); k++)
+            {
+              neighbor = this->CellIds->GetId(k);
+              if (!this->Visited[neighbor])
+              {
+                this->Iterator->GetCellAtId(neighbor, this->NeighborPoints);
+                numNeiPts = this->NeighborPoints->GetNumberOfIds();
+                neiPts = this->NeighborPoints->GetPointer(0);
+
+                for (l = 0; l < numNeiPts; l++)
+                {
+                  if (neiPts[l] == pts[j1])
+                  {
+                    break;
+                  }
+                }
+
+                //  Have to reverse ordering if neighbor not consistent
+                //
+                if (neiPts[(l + 1) % numNeiPts] != pts[j])
+                {
+                  this->ReverseCell(neighbor);
+                }
+                this->Visited[neighbor] = 1;
+                this->Wave2->InsertNextId(neighbor);
+              } // if cell not visited
+            }   // for each edge neighbor
+          }     // for manifold or non-manifold traversal allowed
+        }       // for all edges of this polygon
+      }         // for all cells in wave
+
+      // swap wave and proceed with propagation
+      std::swap(this->Wave, this->Wave2);
+      this->Wave2->Reset();
+    } // while wave still propagating
+  }
+};
+
+// Lock-free union-find of the polygons. Sets are linked to the root with
+// the smallest id, so the root of a set is its smallest polygon id.
+vtkIdType FindRoot(std::atomic<vtkIdType>* parents, vtkIdType id)
+{
+  vtkIdType parent = parents[id].load();
+  while (parent != id)
+  {
+    // path halving
+    vtkIdType grandParent = parents[parent].load();
+    if (grandParent != parent)
+    {
+      parents[id].compare_exchange_weak(parent, grandParent);
+    }
+    id = grandParent;
+    parent = parents[id].load();
+  }
+  return id;
+}
+
+void UnionSets(std::atomic<vtkIdType>* parents, vtkIdType id1, vtkIdType id2)
+{
+  for (;;)
+  {
+    id1 = FindRoot(parents, id1);
+    id2 = FindRoot(parents, id2);
+    if (id1 == id2)
+    {
+      return;
+    }
+    if (id1 < id2)
+    {
+      std::swap(id1, id2);
+    }
+    vtkIdType root = id1;
+    if (parents[id1].compare_exchange_strong(root, id2))
+    {
+      return;
+    }
+  }
+}
+
+// Gather the polygons connected by the consistency traversal into sets.
+// Every polygon reachable from a polygon belongs to its set.
+struct LabelComponents
+{
+  PolyLinks* Links;
+  vtkCellArray* Polys;
+  bool NonManifoldTraversal;
+  std::atomic<vtkIdType>* Parents;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+
+  LabelComponents(PolyLinks* links, vtkCellArray* polys, bool nonManifoldTraversal,
+    std::atomic<vtkIdType>* parents)
+    : Links(links)
+    , Polys(polys)
+    , NonManifoldTraversal(nonManifoldTraversal)
+    , Parents(parents)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->Polys->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkIdList* cellIds = this->CellIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      iter->GetCellAtId(cellId, npts, pts);
+      for (vtkIdType j = 0; j < npts; ++j)
+      {
+        GetCellEdgeNeighbors(this->Links, cellId, pts[j], pts[(j + 1) % npts], cellIds);
+        if (cellIds->GetNumberOfIds() == 1 || this->NonManifoldTraversal)
+        {
+          for (vtkIdType k = 0; k < cellIds->GetNumberOfIds(); ++k)
+          {
+            UnionSets(this->Parents, cellId, cellIds->GetId(k));
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Reorder the polygons of each set, starting from its smallest polygon.
+struct OrientComponents
+{
+  const vtkIdType* Seeds;
+  PolyLinks* Links;
+  vtkCellArray* Polys;
+  unsigned char* Visited;
+  unsigned char* Reversed;
+  bool NonManifoldTraversal;
+  bool FlipNormals;
+  vtkSMPThreadLocal<OrderTraversal> Traversal;
+  vtkIdType NumFlips;
+
+  OrientComponents(const vtkIdType* seeds, PolyLinks* links, vtkCellArray* polys,
+    unsigned char* visited, unsigned char* reversed, bool nonManifoldTraversal, bool flipNormals)
+    : Seeds(seeds)
+    , Links(links)
+    , Polys(polys)
+    , Visited(visited)
+    , Reversed(reversed)
+    , NonManifoldTraversal(nonManifoldTraversal)
+    , FlipNormals(flipNormals)
+    , NumFlips(0)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Traversal.Local().Initialize(
+      this->Links, this->Polys, this->Visited, this->Reversed, this->NonManifoldTraversal);
+  }
+
+  void operator()(vtkIdType seedId, vtkIdType endSeedId)
+  {
+    OrderTraversal& traversal = this->Traversal.Local();
+    for (; seedId < endSeedId; ++seedId)
+    {
+      if (this->FlipNormals)
+      {
+        traversal.ReverseCell(this->Seeds[seedId]);
+      }
+      traversal.TraverseAndOrder(this->Seeds[seedId]);
+    }
+  }
+
+  void Reduce()
+  {
+    for (auto iter = this->Traversal.begin(); iter != this->Traversal.end(); ++iter)
+    {
+      this->NumFlips += iter->NumFlips;
+    }
+  }
+};
+
+// Replace a point of a polygon in the connectivity array.
+struct SetCellPoint
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkIdType cellId, vtkIdType spot, vtkIdType ptId)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    state.GetCellRange(cellId)[spot] = static_cast<ValueType>(ptId);
+  }
+};
+
+// Split the points lying on feature edges. Around each point, the polygons
+// connected and not separated by a feature edge are labeled with a region
+// number. For N regions, N-1 duplicate (split) points are created. The
+// first pass counts the new points; the second pass, given their offsets,
+// replaces the point in the polygons of the other regions.
+struct SplitPoints
+{
+  PolyLinks* Links;
+  vtkCellArray* OldPolys;
+  vtkCellArray* NewPolys;
+  const float* PolyNormals;
+  const unsigned char* Reversed;
+  double CosAngle;
+  vtkIdType* Counts;
+  const vtkIdType* Offsets;
+  vtkIdType* Map;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocal<std::vector<int>> Regions;
+
+  SplitPoints(PolyLinks* links, vtkCellArray* oldPolys, vtkCellArray* newPolys,
+    const float* polyNormals, const unsigned char* reversed, double cosAngle, vtkIdType* counts)
+    : Links(links)
+    , OldPolys(oldPolys)
+    , NewPolys(newPolys)
+    , PolyNormals(polyNormals)
+    , Reversed(reversed)
+    , CosAngle(cosAngle)
+    , Counts(counts)
+    , Offsets(nullptr)
+    , Map(nullptr)
+  {
+  }
+
+  void Initialize() { this->Iterator.Local().TakeReference(this->OldPolys->NewIterator()); }
+
+  // Label the regions of the polygons around the point. The region of a
+  // polygon is stored at its (first) position in the links of the point.
+  int MarkRegions(vtkIdType ptId, vtkCellArrayIterator* iter, vtkIdList* cellIds,
+    std::vector<int>& regions)
+  {
+    const vtkIdType ncells = this->Links->GetNcells(ptId);
+    if (ncells <= 1)
+    {
+      return 1; // point does not need to be further disconnected
+    }
+    const vtkIdType* cells = this->Links->GetCells(ptId);
+    auto region = [&](vtkIdType cellId) -> int& {
+      return regions[std::lower_bound(cells, cells + ncells, cellId) - cells];
+    };
+
+    // Start by initializing the cells as unvisited
+    regions.assign(ncells, -1);
+
+    // Loop over all cells and mark the region that each is in.
+    //
+    vtkIdType numPts;
+    const vtkIdType* pts;
+    int numRegions = 0;
+    vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
+    for (vtkIdType j = 0; j < ncells; j++) // for all cells connected to point
+    {
+      if (region(cells[j]) < 0) // for all unvisited cells
+      {
+        region(cells[j]) = numRegions;
+        // okay, mark all the cells connected to this seed cell and using ptId
+        iter->GetCellAtId(cells[j], numPts, pts);
+
+        // find the two edges
+        for (spot = 0; spot < numPts; spot++)
+        {
+          if (pts[spot] == ptId)
+          {
+            break;
+          }
+        }
+
+        if (spot == 0)
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[numPts - 1];
+        }
+        else if (spot == (numPts - 1))
+        {
+          neiPt[0] = pts[spot - 1];
+          neiPt[1] = pts[0];
+        }
+        else
+        {
+          neiPt[0] = pts[spot + 1];
+          neiPt[1] = pts[spot - 1];
+        }
+
+        for (int i = 0; i < 2; i++) // for each of the two edges of the seed cell
+        {
+          cellId = cells[j];
+          nei = neiPt[i];
+          while (cellId >= 0) // while we can grow this region
+          {
+            GetCellEdgeNeighbors(this->Links, cellId, ptId, nei, cellIds);
+            if (cellIds->GetNumberOfIds() == 1 && region((neiCellId = cellIds->GetId(0))) < 0)
+            {
+              const float* thisNormal = this->PolyNormals + 3 * cellId;
+              const float* neiNormal = this->PolyNormals + 3 * neiCellId;
+
+              if (static_cast<double>(thisNormal[0]) * neiNormal[0] +
+                  static_cast<double>(thisNormal[1]) * neiNormal[1] +
+                  static_cast<double>(thisNormal[2]) * neiNormal[2] >
+                this->CosAngle)
+              {
+                // visit and arrange to visit next edge neighbor
+                region(neiCellId) = numRegions;
+                cellId = neiCellId;
+                iter->GetCellAtId(cellId, numPts, pts);
+
+                for (spot = 0; spot < numPts; spot++)
+                {
+                  if (pts[spot] == ptId)
+                  {
+                    break;
+                  }
+                }
+
+                if (spot == 0)
+                {
+                  nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
+                }
+                else if (spot == (numPts - 1))
+                {
+                  nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
+                }
+                else
+                {
+                  nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
+                }
+
+              } // if not separated by edge angle
+              else
+              {
+                cellId = -1; // separated by edge angle
+              }
+            } // if can move to edge neighbor
+            else
+            {
+              cellId = -1; // separated by previous visit, boundary, or non-manifold
+            }
+          } // while visit wave is propagating
+        }   // for each of the two edges of the starting cell
+        numRegions++;
+      } // if cell is unvisited
+    }   // for all cells connected to point ptId
+
+    return numRegions;
+  }
+
+  // Replace the point in a polygon of the new mesh. The polygon may have
+  // been reversed by the consistency pass.
+  void ReplaceCellPoint(
+    vtkIdType cellId, vtkIdType ptId, vtkIdType newPtId, vtkCellArrayIterator* iter)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCellAtId(cellId, npts, pts);
+    for (vtkIdType spot = 0; spot < npts; ++spot)
+    {
+      if (pts[spot] == ptId)
+      {
+        this->NewPolys->Visit(
+          SetCellPoint{}, cellId, this->Reversed[cellId] ? npts - 1 - spot : spot, newPtId);
+      }
+    }
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    vtkIdList* cellIds = this->CellIds.Local();
+    std::vector<int>& regions = this->Regions.Local();
+    for (; ptId < endPtId; ++ptId)
+    {
+      int numRegions = this->MarkRegions(ptId, iter, cellIds, regions);
+      if (!this->Offsets)
+      {
+        this->Counts[ptId] = numRegions - 1;
+        continue;
+      }
+      if (numRegions <= 1)
+      {
+        continue; // a single region, no splitting ever required
+      }
+
+      // Okay, for all cells not in the first region, the ptId is
+      // replaced with a new ptId, which is a duplicate of the first
+      // point, but disconnected topologically.
+      //
+      const vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      for (vtkIdType j = 0; j < ncells; j++)
+      {
+        if (regions[j] > 0) // replace point if splitting needed
+        {
+          vtkIdType replacementPoint = this->Offsets[ptId] + regions[j] - 1;
+          this->Map[replacementPoint] = ptId;
+          this->ReplaceCellPoint(cells[j], ptId, replacementPoint, iter);
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Average the normals of the polygons using each point. The normals are
+// gathered per point, in increasing polygon order, so no synchronization
+// is needed.
+struct AccumulateNormals
+{
+  PolyLinks* Links;
+  const float* PolyNormals;
+  float* Normals;
+  double FlipDirection;
+
+  AccumulateNormals(
+    PolyLinks* links, const float* polyNormals, float* normals, double flipDirection)
+    : Links(links)
+    , PolyNormals(polyNormals)
+    , Normals(normals)
+    , FlipDirection(flipDirection)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      float n[3] = { 0.0f, 0.0f, 0.0f };
+      const vtkIdType ncells = this->Links->GetNcells(ptId);
+      const vtkIdType* cells = this->Links->GetCells(ptId);
+      for (vtkIdType i = 0; i < ncells; ++i)
+      {
+        const float* polyNormal = this->PolyNormals + 3 * cells[i];
+        n[0] += polyNormal[0];
+        n[1] += polyNormal[1];
+        n[2] += polyNormal[2];
+      }
+
+      const double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * this->FlipDirection;
+      if (length != 0.0)
+      {
+        n[0] /= length;
+        n[1] /= length;
+        n[2] /= length;
+      }
+      std::copy(n, n + 3, this->Normals + 3 * ptId);
+    }
+  }
+};
+} // anonymous namespace
+
 // Construct with feature angle=30, splitting and consistency turned on,
 // flipNormals turned off, and non-manifold traversal turned on.
 vtkPolyDataNormals::vtkPolyDataNormals()
@@ -48,22 +677,8 @@ vtkPolyDataNormals::vtkPolyDataNormals()
   // some internal data
   this->NumFlips = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
-  this->Wave = nullptr;
-  this->Wave2 = nullptr;
-  this->CellIds = nullptr;
-  this->CellPoints = nullptr;
-  this->NeighborPoints = nullptr;
-  this->Map = nullptr;
-  this->OldMesh = nullptr;
-  this->NewMesh = nullptr;
-  this->Visited = nullptr;
-  this->PolyNormals = nullptr;
-  this->CosAngle = 0.0;
 }
 
-#define VTK_CELL_NOT_VISITED 0
-#define VTK_CELL_VISITED 1
-
 // Generate normals for polygon meshes
 int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -91,7 +706,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDataSetAttributes* outCD = output->GetCellData();
   double n[3];
   vtkCellArray* newPolys;
-  vtkIdType ptId, oldId;
+  vtkIdType ptId;
 
   vtkDebugMacro(<< "Generating surface normals");
 
@@ -128,8 +743,6 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   inPolys = input->GetPolys();
   inStrips = input->GetStrips();
 
-  this->OldMesh = vtkPolyData::New();
-  this->OldMesh->SetPoints(inPts);
   if (numStrips > 0) // have to decompose strips into triangles
   {
     vtkDataSetAttributes* inCD = input->GetCellData();
@@ -166,46 +779,29 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
         outCD->CopyData(inCD, inCellIdx, outCellIdx++);
       }
     }
-    this->OldMesh->SetPolys(polys);
-    polys->Delete();
     numPolys = polys->GetNumberOfCells(); // added some new triangles
   }
   else
   {
-    this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
+    polys->Register(this);
   }
-  this->OldMesh->BuildLinks();
+
+  // The links from the points to the polygons are built in parallel.
+  PolyLinks links;
+  BuildSortedLinks(links, numPts, numPolys, polys);
   this->UpdateProgress(0.10);
 
   pd = input->GetPointData();
   outPD = output->GetPointData();
 
-  this->NewMesh = vtkPolyData::New();
-  this->NewMesh->SetPoints(inPts);
   // create a copy because we're modifying it
   newPolys = vtkCellArray::New();
   newPolys->DeepCopy(polys);
-  this->NewMesh->SetPolys(newPolys);
-  this->NewMesh->BuildCells(); // builds connectivity
 
-  // The visited array keeps track of which polygons have been visited.
-  //
-  if (this->Consistency || this->Splitting || this->AutoOrientNormals)
-  {
-    this->Visited = new int[numPolys];
-    memset(this->Visited, VTK_CELL_NOT_VISITED, numPolys * sizeof(int));
-    this->CellIds = vtkIdList::New();
-    this->CellIds->Allocate(VTK_CELL_SIZE);
-    this->CellPoints = vtkIdList::New();
-    this->CellPoints->Allocate(VTK_CELL_SIZE);
-    this->NeighborPoints = vtkIdList::New();
-    this->NeighborPoints->Allocate(VTK_CELL_SIZE);
-  }
-  else
-  {
-    this->Visited = nullptr;
-  }
+  // Polygons reversed in the new mesh, used to locate their points when
+  // splitting.
+  std::vector<unsigned char> reversed(numPolys, 0);
 
   //  Traverse all polygons insuring proper direction of ordering.  This
   //  works by propagating a wave from a seed polygon to the polygon's
@@ -227,7 +823,7 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     // the mesh. Report bugs/issues to cvolpe@ara.com.
     int foundLeftmostCell;
     vtkIdType leftmostCellID = -1, currentPointID, currentCellID;
-    vtkIdType* leftmostCells;
+    const vtkIdType* leftmostCells;
     vtkIdType nleftmostCells;
     const vtkIdType* cellPts;
     vtkIdType nCellPts;
@@ -235,10 +831,11 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     double bestNormalAbsXComponent;
     int bestReverseFlag;
     vtkPriorityQueue* leftmostPoints = vtkPriorityQueue::New();
-    this->Wave = vtkIdList::New();
-    this->Wave->Allocate(numPolys / 4 + 1, numPolys);
-    this->Wave2 = vtkIdList::New();
-    this->Wave2->Allocate(numPolys / 4 + 1, numPolys);
+    std::vector<unsigned char> visited(numPolys, 0);
+    OrderTraversal traversal;
+    traversal.Initialize(
+      &links, newPolys, visited.data(), reversed.data(), this->NonManifoldTraversal != 0);
+    vtkSmartPointer<vtkCellArrayIterator> polyIter = vtk::TakeSmartPointer(polys->NewIterator());
 
     // Put all the points in the priority queue, based on x coord
     // So that we can find leftmost point
@@ -262,17 +859,18 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
       do
       {
         currentPointID = leftmostPoints->Pop();
-        this->OldMesh->GetPointCells(currentPointID, nleftmostCells, leftmostCells);
+        nleftmostCells = links.GetNcells(currentPointID);
+        leftmostCells = links.GetCells(currentPointID);
         bestNormalAbsXComponent = 0.0;
         bestReverseFlag = 0;
         for (cIdx = 0; cIdx < nleftmostCells; cIdx++)
         {
           currentCellID = leftmostCells[cIdx];
-          if (this->Visited[currentCellID] == VTK_CELL_VISITED)
+          if (visited[currentCellID])
           {
             continue;
           }
-          this->OldMesh->GetCellPoints(currentCellID, nCellPts, cellPts);
+          polyIter->GetCellAtId(currentCellID, nCellPts, cellPts);
           vtkPolygon::ComputeNormal(inPts, nCellPts, cellPts, n);
           // Ok, see if this leftmost cell candidate is the best
           // so far
@@ -295,49 +893,65 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
         // normals, but if both are true, then we leave it as it is.
         if (bestReverseFlag ^ this->FlipNormals)
         {
-          this->NewMesh->ReverseCell(leftmostCellID);
-          this->NumFlips++;
+          traversal.ReverseCell(leftmostCellID);
         }
-        this->Wave->InsertNextId(leftmostCellID);
-        this->Visited[leftmostCellID] = VTK_CELL_VISITED;
-        this->TraverseAndOrder();
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        traversal.TraverseAndOrder(leftmostCellID);
       } // if found leftmost cell
     }   // Still some points in the queue
-    this->Wave->Delete();
-    this->Wave2->Delete();
     leftmostPoints->Delete();
+    this->NumFlips = static_cast<int>(traversal.NumFlips);
     vtkDebugMacro(<< "Reversed ordering of " << this->NumFlips << " polygons");
   } // automatically orient normals
   else
   {
     if (this->Consistency)
     {
-      this->Wave = vtkIdList::New();
-      this->Wave->Allocate(numPolys / 4 + 1, numPolys);
-      this->Wave2 = vtkIdList::New();
-      this->Wave2->Allocate(numPolys / 4 + 1, numPolys);
+      // The polygons connected by the traversal are gathered into sets,
+      // which are then reordered in parallel, each from its smallest
+      // polygon as in a serial traversal of the polygons.
+      std::vector<std::atomic<vtkIdType>> parents(numPolys);
+      vtkSMPTools::For(0, numPolys, [&](vtkIdType begin, vtkIdType end) {
+        for (; begin < end; ++begin)
+        {
+          parents[begin].store(begin);
+        }
+      });
+      LabelComponents labelComponents(
+        &links, newPolys, this->NonManifoldTraversal != 0, parents.data());
+      vtkSMPTools::For(0, numPolys, labelComponents);
+
+      std::vector<vtkIdType> seeds;
       for (cellId = 0; cellId < numPolys; cellId++)
       {
-        if (this->Visited[cellId] == VTK_CELL_NOT_VISITED)
+        if (parents[cellId].load() == cellId)
+        {
+          seeds.push_back(cellId);
+        }
+      }
+      std::vector<unsigned char> visited(numPolys, 0);
+      OrientComponents orientComponents(seeds.data(), &links, newPolys, visited.data(),
+        reversed.data(), this->NonManifoldTraversal != 0, this->FlipNormals != 0);
+      vtkSMPTools::For(0, static_cast<vtkIdType>(seeds.size()), orientComponents);
+
+      // The traversal between polygons sharing an edge is not symmetric
+      // when the edge is a diagonal of one of them: finish the polygons
+      // not reached from the smallest polygon of their set.
+      OrderTraversal traversal;
+      traversal.Initialize(
+        &links, newPolys, visited.data(), reversed.data(), this->NonManifoldTraversal != 0);
+      for (cellId = 0; cellId < numPolys; cellId++)
+      {
+        if (!visited[cellId])
         {
           if (this->FlipNormals)
           {
-            this->NumFlips++;
-            this->NewMesh->ReverseCell(cellId);
+            traversal.ReverseCell(cellId);
           }
-          this->Wave->InsertNextId(cellId);
-          this->Visited[cellId] = VTK_CELL_VISITED;
-          this->TraverseAndOrder();
+          traversal.TraverseAndOrder(cellId);
         }
-
-        this->Wave->Reset();
-        this->Wave2->Reset();
       }
 
-      this->Wave->Delete();
-      this->Wave2->Delete();
+      this->NumFlips = static_cast<int>(orientComponents.NumFlips + traversal.NumFlips);
       vtkDebugMacro(<< "Reversed ordering of " << this->NumFlips << " polygons");
     } // Consistent ordering
   }   // don't automatically orient normals
@@ -346,10 +960,10 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   //  Initial pass to compute polygon normals without effects of neighbors
   //
-  this->PolyNormals = vtkFloatArray::New();
-  this->PolyNormals->SetNumberOfComponents(3);
-  this->PolyNormals->SetName("Normals");
-  this->PolyNormals->SetNumberOfTuples(numVerts + numLines + numPolys);
+  vtkFloatArray* polyNormals = vtkFloatArray::New();
+  polyNormals->SetNumberOfComponents(3);
+  polyNormals->SetName("Normals");
+  polyNormals->SetNumberOfTuples(numVerts + numLines + numPolys);
 
   vtkIdType offsetCells = numVerts + numLines;
   n[0] = 1.0;
@@ -359,47 +973,49 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   {
     // add a default value for vertices and lines
     // normals do not have meaningful values, we set them to X
-    this->PolyNormals->SetTuple(cellId, n);
+    polyNormals->SetTuple(cellId, n);
   }
 
-  for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
-  {
-    if ((cellId % 1000) == 0)
-    {
-      this->UpdateProgress(0.333 + 0.333 * (double)cellId / (double)numPolys);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
-    }
-    vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-    this->PolyNormals->SetTuple(offsetCells + cellId, n);
-  }
+  float* fPolyNormals = polyNormals->WritePointer(3 * offsetCells, 3 * numPolys);
+  ComputePolyNormals computePolyNormals(inPts, newPolys, fPolyNormals);
+  vtkSMPTools::For(0, numPolys, computePolyNormals);
+  this->UpdateProgress(0.666);
 
   // Split mesh if sharp features
   if (this->Splitting)
   {
     //  Traverse all nodes; evaluate loops and feature edges.  If feature
     //  edges found, split mesh creating new nodes.  Update polygon
-    // connectivity.
+    // connectivity. The new points are counted first so that the points
+    // can be processed in parallel: their ids are given by a prefix sum.
     //
-    this->CosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+    const double cosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
+    std::vector<vtkIdType> counts(numPts);
+    SplitPoints splitPoints(
+      &links, polys, newPolys, fPolyNormals, reversed.data(), cosAngle, counts.data());
+    vtkSMPTools::For(0, numPts, splitPoints);
+
+    std::vector<vtkIdType> offsets(numPts);
+    vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), offsets.begin(), numPts);
+    numNewPts = offsets[numPts - 1] + counts[numPts - 1];
+
     //  Splitting will create new points.  We have to create index array
     // to map new points into old points.
     //
-    this->Map = vtkIdList::New();
-    this->Map->SetNumberOfIds(numPts);
-    for (vtkIdType i = 0; i < numPts; i++)
-    {
-      this->Map->SetId(i, i);
-    }
+    vtkNew<vtkIdList> map;
+    map->SetNumberOfIds(numNewPts);
+    vtkIdType* mapPtr = map->GetPointer(0);
+    std::iota(mapPtr, mapPtr + numPts, 0);
 
-    for (ptId = 0; ptId < numPts; ptId++)
+    if (numNewPts > numPts)
     {
-      this->MarkAndSplit(ptId);
-    } // for all input points
-
-    numNewPts = this->Map->GetNumberOfIds();
+      SplitPoints replacePoints(
+        &links, polys, newPolys, fPolyNormals, reversed.data(), cosAngle, counts.data());
+      replacePoints.Offsets = offsets.data();
+      replacePoints.Map = mapPtr;
+      vtkSMPTools::For(0, numPts, replacePoints);
+      newPolys->Modified();
+    }
 
     vtkDebugMacro(<< "Created " << numNewPts - numPts << " new points");
 
@@ -432,14 +1048,15 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
       newPts->SetDataType(VTK_DOUBLE);
     }
 
-    newPts->SetNumberOfPoints(numNewPts);
-    for (ptId = 0; ptId < numNewPts; ptId++)
+    inPts->GetPoints(map, newPts);
+    outPD->CopyData(pd, map);
+
+    // The links of the split points are needed to accumulate the normals
+    if (numNewPts > numPts && this->ComputePointNormals)
     {
-      oldId = this->Map->GetId(ptId);
-      newPts->SetPoint(ptId, inPts->GetPoint(oldId));
-      outPD->CopyData(pd, oldId, ptId);
+      links.Initialize();
+      BuildSortedLinks(links, numNewPts, numPolys, newPolys);
     }
-    this->Map->Delete();
   } // splitting
 
   else // no splitting, so no new points
@@ -449,17 +1066,6 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
     outPD->PassData(pd);
   }
 
-  if (this->Consistency || this->Splitting)
-  {
-    delete[] this->Visited;
-    this->CellIds->Delete();
-    this->CellIds = nullptr;
-    this->CellPoints->Delete();
-    this->CellPoints = nullptr;
-    this->NeighborPoints->Delete();
-    this->NeighborPoints = nullptr;
-  }
-
   this->UpdateProgress(0.80);
 
   //  Finally, traverse all elements, computing polygon normals and
@@ -474,36 +1080,16 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
   newNormals->SetNumberOfComponents(3);
   newNormals->SetNumberOfTuples(numNewPts);
   newNormals->SetName("Normals");
-  float* fNormals = newNormals->WritePointer(0, 3 * numNewPts);
-  std::fill_n(fNormals, 3 * numNewPts, 0);
-
-  float* fPolyNormals = this->PolyNormals->WritePointer(3 * offsetCells, 3 * numPolys);
 
   if (this->ComputePointNormals)
   {
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); ++cellId)
-    {
-      for (vtkIdType i = 0; i < npts; ++i)
-      {
-        fNormals[3 * pts[i]] += fPolyNormals[3 * cellId];
-        fNormals[3 * pts[i] + 1] += fPolyNormals[3 * cellId + 1];
-        fNormals[3 * pts[i] + 2] += fPolyNormals[3 * cellId + 2];
-      }
-    }
-
-    for (vtkIdType i = 0; i < numNewPts; ++i)
-    {
-      const double length =
-        sqrt(fNormals[3 * i] * fNormals[3 * i] + fNormals[3 * i + 1] * fNormals[3 * i + 1] +
-          fNormals[3 * i + 2] * fNormals[3 * i + 2]) *
-        flipDirection;
-      if (length != 0.0)
-      {
-        fNormals[3 * i] /= length;
-        fNormals[3 * i + 1] /= length;
-        fNormals[3 * i + 2] /= length;
-      }
-    }
+    AccumulateNormals accumulateNormals(
+      &links, fPolyNormals, newNormals->WritePointer(0, 3 * numNewPts), flipDirection);
+    vtkSMPTools::For(0, numNewPts, accumulateNormals);
+  }
+  else
+  {
+    newNormals->Fill(0.0);
   }
 
   //  Update ourselves.  If no new nodes have been created (i.e., no
@@ -524,9 +1110,9 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   if (this->ComputeCellNormals)
   {
-    outCD->SetNormals(this->PolyNormals);
+    outCD->SetNormals(polyNormals);
   }
-  this->PolyNormals->Delete();
+  polyNormals->Delete();
 
   if (this->ComputePointNormals)
   {
@@ -536,243 +1122,15 @@ int vtkPolyDataNormals::RequestData(vtkInformation* vtkNotUsed(request),
 
   output->SetPolys(newPolys);
   newPolys->Delete();
+  polys->UnRegister(this);
 
   // copy the original vertices and lines to the output
   output->SetVerts(input->GetVerts());
   output->SetLines(input->GetLines());
 
-  this->OldMesh->Delete();
-  this->NewMesh->Delete();
-
   return 1;
 }
 
-//  Propagate wave of consistently ordered polygons.
-//
-void vtkPolyDataNormals::TraverseAndOrder()
-{
-  vtkIdType i, k;
-  int j, l, j1;
-  vtkIdType numIds, cellId;
-  const vtkIdType* pts;
-  const vtkIdType* neiPts;
-  vtkIdType npts;
-  vtkIdType numNeiPts;
-  vtkIdType neighbor;
-  vtkIdList* tmpWave;
-
-  // propagate wave until nothing left in wave
-  while ((numIds = this->Wave->GetNumberOfIds()) > 0)
-  {
-    for (i = 0; i < numIds; i++)
-    {
-      cellId = this->Wave->GetId(i);
-
-      // Store the results here in a vtkIdList, since passing npts/pts directly
-      // would result in the data getting invalidated by the later call to
-      // NewMesh->GetCellPoints.
-      this->NewMesh->GetCellPoints(cellId, this->CellPoints);
-      npts = this->CellPoints->GetNumberOfIds();
-      pts = this->CellPoints->GetPointer(0);
-
-      for (j = 0, j1 = 1; j < npts; ++j, (j1 = (++j1 < npts) ? j1 : 0)) // for each edge neighbor
-      {
-        this->OldMesh->GetCellEdgeNeighbors(cellId, pts[j], pts[j1], this->CellIds);
-
-        //  Check the direction of the neighbor ordering.  Should be
-        //  consistent with us (i.e., if we are n1->n2,
-        // neighbor should be n2->n1).
-        if (this->CellIds->GetNumberOfIds() == 1 || this->NonManifoldTraversal)
-        {
-          for (k = 0; k < this->CellIds->GetNumberOfIds(); k++)
-          {
-            if (this->Visited[this->CellIds->GetId(k)] == VTK_CELL_NOT_VISITED)
-            {
-              neighbor = this->CellIds->GetId(k);
-              this->NewMesh->GetCellPoints(neighbor, this->NeighborPoints);
-              numNeiPts = this->NeighborPoints->GetNumberOfIds();
-              neiPts = this->NeighborPoints->GetPointer(0);
-
-              for (l = 0; l < numNeiPts; l++)
-              {
-                if (neiPts[l] == pts[j1])
-                {
-                  break;
-                }
-              }
-
-              //  Have to reverse ordering if neighbor not consistent
-              //
-              if (neiPts[(l + 1) % numNeiPts] != pts[j])
-              {
-                this->NumFlips++;
-                this->NewMesh->ReverseCell(neighbor);
-              }
-              this->Visited[neighbor] = VTK_CELL_VISITED;
-              this->Wave2->InsertNextId(neighbor);
-            } // if cell not visited
-          }   // for each edge neighbor
-        }     // for manifold or non-manifold traversal allowed
-      }       // for all edges of this polygon
-    }         // for all cells in wave
-
-    // swap wave and proceed with propagation
-    tmpWave = this->Wave;
-    this->Wave = this->Wave2;
-    this->Wave2 = tmpWave;
-    this->Wave2->Reset();
-  } // while wave still propagating
-}
-
-//
-//  Mark polygons around vertex.  Create new vertex (if necessary) and
-//  replace (i.e., split mesh).
-//
-void vtkPolyDataNormals::MarkAndSplit(vtkIdType ptId)
-{
-  int i, j;
-
-  // Get the cells using this point and make sure that we have to do something
-  vtkIdType ncells;
-  vtkIdType* cells;
-  this->OldMesh->GetPointCells(ptId, ncells, cells);
-  if (ncells <= 1)
-  {
-    return; // point does not need to be further disconnected
-  }
-
-  // Start moving around the "cycle" of points using the point. Label
-  // each point as requiring a visit. Then label each subregion of cells
-  // connected to this point that are connected (and not separated by
-  // a feature edge) with a given region number. For each N regions
-  // created, N-1 duplicate (split) points are created. The split point
-  // replaces the current point ptId in the polygons connectivity array.
-  //
-  // Start by initializing the cells as unvisited
-  for (i = 0; i < ncells; i++)
-  {
-    this->Visited[cells[i]] = -1;
-  }
-
-  // Loop over all cells and mark the region that each is in.
-  //
-  vtkIdType numPts;
-  const vtkIdType* pts;
-  int numRegions = 0;
-  vtkIdType spot, neiPt[2], nei, cellId, neiCellId;
-  double thisNormal[3], neiNormal[3];
-  for (j = 0; j < ncells; j++) // for all cells connected to point
-  {
-    if (this->Visited[cells[j]] < 0) // for all unvisited cells
-    {
-      this->Visited[cells[j]] = numRegions;
-      // okay, mark all the cells connected to this seed cell and using ptId
-      this->OldMesh->GetCellPoints(cells[j], numPts, pts);
-
-      // find the two edges
-      for (spot = 0; spot < numPts; spot++)
-      {
-        if (pts[spot] == ptId)
-        {
-          break;
-        }
-      }
-
-      if (spot == 0)
-      {
-        neiPt[0] = pts[spot + 1];
-        neiPt[1] = pts[numPts - 1];
-      }
-      else if (spot == (numPts - 1))
-      {
-        neiPt[0] = pts[spot - 1];
-        neiPt[1] = pts[0];
-      }
-      else
-      {
-        neiPt[0] = pts[spot + 1];
-        neiPt[1] = pts[spot - 1];
-      }
-
-      for (i = 0; i < 2; i++) // for each of the two edges of the seed cell
-      {
-        cellId = cells[j];
-        nei = neiPt[i];
-        while (cellId >= 0) // while we can grow this region
-        {
-          this->OldMesh->GetCellEdgeNeighbors(cellId, ptId, nei, this->CellIds);
-          if (this->CellIds->GetNumberOfIds() == 1 &&
-            this->Visited[(neiCellId = this->CellIds->GetId(0))] < 0)
-          {
-            this->PolyNormals->GetTuple(cellId, thisNormal);
-            this->PolyNormals->GetTuple(neiCellId, neiNormal);
-
-            if (vtkMath::Dot(thisNormal, neiNormal) > CosAngle)
-            {
-              // visit and arrange to visit next edge neighbor
-              this->Visited[neiCellId] = numRegions;
-              cellId = neiCellId;
-              this->OldMesh->GetCellPoints(cellId, numPts, pts);
-
-              for (spot = 0; spot < numPts; spot++)
-              {
-                if (pts[spot] == ptId)
-                {
-                  break;
-                }
-              }
-
-              if (spot == 0)
-              {
-                nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[numPts - 1]);
-              }
-              else if (spot == (numPts - 1))
-              {
-                nei = (pts[spot - 1] != nei ? pts[spot - 1] : pts[0]);
-              }
-              else
-              {
-                nei = (pts[spot + 1] != nei ? pts[spot + 1] : pts[spot - 1]);
-              }
-
-            } // if not separated by edge angle
-            else
-            {
-              cellId = -1; // separated by edge angle
-            }
-          } // if can move to edge neighbor
-          else
-          {
-            cellId = -1; // separated by previous visit, boundary, or non-manifold
-          }
-        } // while visit wave is propagating
-      }   // for each of the two edges of the starting cell
-      numRegions++;
-    } // if cell is unvisited
-  }   // for all cells connected to point ptId
-
-  if (numRegions <= 1)
-  {
-    return; // a single region, no splitting ever required
-  }
-
-  // Okay, for all cells not in the first region, the ptId is
-  // replaced with a new ptId, which is a duplicate of the first
-  // point, but disconnected topologically.
-  //
-  vtkIdType lastId = this->Map->GetNumberOfIds();
-  vtkIdType replacementPoint;
-  for (j = 0; j < ncells; j++)
-  {
-    if (this->Visited[cells[j]] > 0) // replace point if splitting needed
-    {
-      replacementPoint = lastId + this->Visited[cells[j]] - 1;
-      this->Map->InsertId(replacementPoint, ptId);
-      this->NewMesh->ReplaceCellPoint(cells[j], ptId, replacementPoint);
-    } // if not in first regions and requiring splitting
-  }   // for all cells connected to ptId
-}
-
 void vtkPolyDataNormals::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
@@ -60,10 +60,6 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
-class vtkFloatArray;
-class vtkIdList;
-class vtkPolyData;
-
 class VTKFILTERSCORE_EXPORT vtkPolyDataNormals : public vtkPolyDataAlgorithm
 {
 public:
@@ -191,28 +187,6 @@ protected:
   int NumFlips;
   int OutputPointsPrecision;
 
-private:
-  vtkIdList* Wave;
-  vtkIdList* Wave2;
-  vtkIdList* CellIds;
-  vtkIdList* CellPoints;
-  vtkIdList* NeighborPoints;
-  vtkIdList* Map;
-  vtkPolyData* OldMesh;
-  vtkPolyData* NewMesh;
-  int* Visited;
-  vtkFloatArray* PolyNormals;
-  double CosAngle;
-
-  // Uses the list of cell ids (this->Wave) to propagate a wave of
-  // checked and properly ordered polygons.
-  void TraverseAndOrder(void);
-
-  // Check the point id give to see whether it lies on a feature
-  // edge. If so, split the point (i.e., duplicate it) to topologically
-  // separate the mesh.
-  void MarkAndSplit(vtkIdType ptId);
-
 private:
   vtkPolyDataNormals(const vtkPolyDataNormals&) = delete;
   void operator=(const vtkPolyDataNormals&) = delete;
@@ -20,6 +20,7 @@
 #include "vtkCellData.h"
 #include "vtkCellLocatorStrategy.h"
 #include "vtkCharArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkFindCellStrategy.h"
 #include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
@@ -27,9 +28,11 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
@@ -37,6 +40,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 vtkStandardNewMacro(vtkProbeFilter);
@@ -45,6 +49,9 @@ vtkCxxSetObjectMacro(vtkProbeFilter, FindCellStrategy, vtkFindCellStrategy);
 
 #define CELL_TOLERANCE_FACTOR_SQR 1e-6
 
+// The number of points located by one batched query
+#define VTK_PROBE_BATCH_SIZE 16384
+
 static inline bool IsBlankedCell(vtkUnsignedCharArray* gcells, vtkIdType cellId)
 {
   if (gcells)
@@ -475,6 +482,19 @@ void vtkProbeFilter::ProbeEmptyPoints(
     vtkDebugMacro(<< "Using strategy: " << strategy->GetClassName());
   }
 
+  // A cell locator locates the points by batches, in parallel
+  vtkCellLocatorStrategy* locatorStrategy = vtkCellLocatorStrategy::SafeDownCast(strategy);
+  if (locatorStrategy && locatorStrategy->GetCellLocator())
+  {
+    this->ProbeEmptyPointsWithLocator(
+      input, srcIdx, source, output, locatorStrategy->GetCellLocator(), tol2);
+    if (mcs > 256)
+    {
+      delete[] weights;
+    }
+    return;
+  }
+
   // Loop over all input points, interpolating source data
   //
   vtkNew<vtkGenericCell> gcell;
@@ -544,6 +564,112 @@ void vtkProbeFilter::ProbeEmptyPoints(
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkProbeFilter::ProbeEmptyPointsWithLocator(vtkDataSet* input, int srcIdx,
+  vtkDataSet* source, vtkDataSet* output, vtkAbstractCellLocator* locator, double tol2)
+{
+  vtkPointData* pd = source->GetPointData();
+  vtkCellData* cd = source->GetCellData();
+  vtkPointData* outPD = output->GetPointData();
+  auto sourceGhostFlags =
+    vtkUnsignedCharArray::SafeDownCast(cd->GetArray(vtkDataSetAttributes::GhostArrayName()));
+  char* maskArray = this->MaskPoints->GetPointer(0);
+  vtkIdType numPts = input->GetNumberOfPoints();
+
+  // The cell arrays to copy, with the source arrays they are copied from
+  std::vector<std::pair<vtkDataArray*, vtkDataArray*>> cellArrays;
+  for (vtkDataArray* outArray : *this->CellArrays)
+  {
+    vtkDataArray* inArray = cd->GetArray(outArray->GetName());
+    if (inArray)
+    {
+      cellArrays.emplace_back(inArray, outArray);
+    }
+  }
+
+  // The points not probed yet are located by batches with the batched
+  // FindCell() of the locator, then the data of the points found in a cell
+  // is interpolated in parallel.
+  std::vector<vtkIdType> ptIds;
+  vtkNew<vtkPoints> queries;
+  queries->SetDataTypeToDouble();
+  vtkNew<vtkIdTypeArray> cellIdsArray;
+  vtkNew<vtkDoubleArray> weightsArray;
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  for (vtkIdType startId = 0; startId < numPts; startId += VTK_PROBE_BATCH_SIZE)
+  {
+    this->UpdateProgress(static_cast<double>(startId) / numPts);
+    if (this->GetAbortExecute())
+    {
+      break;
+    }
+
+    // skip points which have already been probed with success.
+    // This is helpful for multiblock dataset probing.
+    const vtkIdType endId = std::min<vtkIdType>(startId + VTK_PROBE_BATCH_SIZE, numPts);
+    ptIds.clear();
+    for (vtkIdType ptId = startId; ptId < endId; ++ptId)
+    {
+      if (maskArray[ptId] != static_cast<char>(1))
+      {
+        ptIds.push_back(ptId);
+      }
+    }
+    const vtkIdType numQueries = static_cast<vtkIdType>(ptIds.size());
+    queries->SetNumberOfPoints(numQueries);
+    vtkSMPTools::For(0, numQueries, [&](vtkIdType q, vtkIdType endQ) {
+      double x[3];
+      for (; q < endQ; ++q)
+      {
+        input->GetPoint(ptIds[q], x);
+        queries->SetPoint(q, x);
+      }
+    });
+
+    locator->BatchFindCell(queries, tol2, cellIdsArray, nullptr, weightsArray);
+    const vtkIdType* cellIds = cellIdsArray->GetPointer(0);
+    const int numWeights = weightsArray->GetNumberOfComponents();
+
+    vtkSMPTools::For(0, numQueries, [&](vtkIdType q, vtkIdType endQ) {
+      vtkGenericCell* cell = cells.Local();
+      for (; q < endQ; ++q)
+      {
+        const vtkIdType cellId = cellIds[q];
+        if (cellId < 0 || ::IsBlankedCell(sourceGhostFlags, cellId))
+        {
+          continue;
+        }
+        const vtkIdType ptId = ptIds[q];
+        double* weights = weightsArray->GetPointer(numWeights * q);
+        source->GetCell(cellId, cell);
+        if (this->ComputeTolerance)
+        {
+          // If ComputeTolerance is set, compute a tolerance proportional to the
+          // cell length.
+          double x[3], closestPoint[3], pcoords[3], dist2;
+          int subId;
+          queries->GetPoint(q, x);
+          cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights);
+          if (dist2 > (cell->GetLength2() * CELL_TOLERANCE_FACTOR_SQR))
+          {
+            continue;
+          }
+        }
+
+        // Interpolate the point data
+        outPD->InterpolatePoint((*this->PointList), pd, srcIdx, ptId, cell->PointIds, weights);
+        for (const auto& arrays : cellArrays)
+        {
+          outPD->CopyTuple(arrays.first, arrays.second, cellId, ptId);
+        }
+        maskArray[ptId] = static_cast<char>(1);
+      }
+    });
+  }
+
+  this->MaskPoints->Modified();
+}
+
 //------------------------------------------------------------------------------
 static void GetPointIdsInRange(double rangeMin, double rangeMax, double start, double stepsize,
   int numSteps, int& minid, int& maxid)
@@ -289,6 +289,11 @@ private:
   // array.
   void ProbeEmptyPoints(vtkDataSet* input, int srcIdx, vtkDataSet* source, vtkDataSet* output);
 
+  // Probe the points not probed yet by batches, with the batched FindCell()
+  // of a cell locator, in parallel.
+  void ProbeEmptyPointsWithLocator(vtkDataSet* input, int srcIdx, vtkDataSet* source,
+    vtkDataSet* output, vtkAbstractCellLocator* locator, double tol2);
+
   // A faster implementation for vtkImageData input.
   void ProbePointsImageData(
     vtkImageData* input, int srcIdx, vtkDataSet* source, vtkImageData* output);
@@ -18,7 +18,9 @@
 #include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCleanPolyDataInternal.h"
 #include "vtkDataArrayRange.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
@@ -37,6 +39,30 @@ vtkStandardNewMacro(vtkStaticCleanPolyData);
 // This filter uses methods found in vtkStaticCleanUnstructuredGrid.
 using PointUses = unsigned char;
 
+namespace
+{ // anonymous
+
+// Map the points of a cell to the new points, culling out the duplicate
+// points, and give the cell array of the rewritten cell.
+struct StaticCleanRewrite
+{
+  const vtkIdType* PointMap;
+  bool Convert[3];
+
+  int operator()(int type, vtkIdList* cellPts, vtkIdList* newPts) const
+  {
+    newPts->Reset();
+    const vtkIdType npts = cellPts->GetNumberOfIds();
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      newPts->InsertUniqueId(this->PointMap[cellPts->GetId(i)]);
+    }
+    return CleanOutputCellArray(type, newPts->GetNumberOfIds(), this->Convert);
+  }
+};
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Construct object with initial Tolerance of 0.0
 vtkStaticCleanPolyData::vtkStaticCleanPolyData()
@@ -115,21 +141,10 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // we'll be needing these
-  vtkIdType newId;
-  vtkIdType i;
-  vtkIdType ptId;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-
   vtkCellArray* inVerts = input->GetVerts();
-  vtkSmartPointer<vtkCellArray> newVerts;
   vtkCellArray* inLines = input->GetLines();
-  vtkSmartPointer<vtkCellArray> newLines;
   vtkCellArray* inPolys = input->GetPolys();
-  vtkSmartPointer<vtkCellArray> newPolys;
   vtkCellArray* inStrips = input->GetStrips();
-  vtkSmartPointer<vtkCellArray> newStrips;
 
   vtkPointData* inPD = input->GetPointData();
   vtkCellData* inCD = input->GetCellData();
@@ -213,264 +228,50 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   }
   this->UpdateProgress(0.6);
 
-  // Finally, remap the topology to use new point ids. Celldata needs to be
-  // copied correctly. If a poly is converted to a line, or a line to a
-  // point, then using a CellCounter will not do, as the cells should be
-  // ordered verts, lines, polys, strips. We need to maintain separate cell
-  // data lists so we can copy them all correctly. Tedious but easy to
-  // implement. We can use outCD for vertex cell data, then add the rest
-  // at the end.
-  vtkSmartPointer<vtkCellData> outLineData;
-  vtkSmartPointer<vtkCellData> outPolyData;
-  vtkSmartPointer<vtkCellData> outStrpData;
-  outCD->CopyAllocate(inCD);
-
-  // Begin to adjust topology. We need to cull out duplicate points and see
-  // what's left.  Just use a vector to keep track of unique ids - it's a
-  // small set so find() will execute relatively fast.
-  std::vector<vtkIdType> cellIds;
-  vtkIdType inCellID = 0;
-
-  //
-  // Vertices are renumbered and we remove duplicates
-  if (!this->GetAbortExecute() && inVerts->GetNumberOfCells() > 0)
+  // Finally, remap the topology to use new point ids. Duplicate points are
+  // culled out of the cells, and the degenerate cells are either eliminated
+  // or converted into lower cells if enabled. The cells are rewritten in
+  // parallel, and the output cells are ordered verts, lines, polys, strips,
+  // each in the order of the input cells they come from.
+  CleanCells newCells;
+  if (!this->GetAbortExecute())
   {
-    newVerts.TakeReference(vtkCellArray::New());
-    newVerts->AllocateEstimate(inVerts->GetNumberOfCells(), 1);
-
-    vtkDebugMacro(<< "Starting Verts " << inCellID);
-    for (inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts); inCellID++)
-    {
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for all points of vertex cell
-
-      if (cellIds.size() > 0)
-      {
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-  }
-  this->UpdateProgress(0.7);
-
-  // lines reduced to one point are eliminated or made into verts
-  if (!this->GetAbortExecute() && inLines->GetNumberOfCells() > 0)
-  {
-    newLines.TakeReference(vtkCellArray::New());
-    newLines->AllocateEstimate(inLines->GetNumberOfCells(), 2);
-    outLineData.TakeReference(vtkCellData::New());
-    outLineData->CopyAllocate(inCD);
-    //
-    vtkDebugMacro(<< "Starting Lines " << inCellID);
-    for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts); inCellID++)
-    {
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for all cell points
-
-      if (cellIds.size() > 1)
-      {
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inLines->GetNumberOfCells() - newLines->GetNumberOfCells()
-                  << " lines");
-  }
-  this->UpdateProgress(0.8);
-
-  // polygons reduced to two points or less are either eliminated
-  // or converted to lines or points if enabled
-  if (!this->GetAbortExecute() && inPolys->GetNumberOfCells() > 0)
-  {
-    newPolys.TakeReference(vtkCellArray::New());
-    newPolys->AllocateCopy(inPolys);
-    outPolyData.TakeReference(vtkCellData::New());
-    outPolyData->CopyAllocate(inCD);
-
-    vtkDebugMacro(<< "Starting Polys " << inCellID);
-    for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts); inCellID++)
-    {
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for points in cell
-
-      if (cellIds.size() > 2)
-      {
-        newId = newPolys->InsertNextCell(cellIds.size(), cellIds.data());
-        outPolyData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 2 && this->ConvertPolysToLines)
-      {
-        if (!newLines)
-        {
-          newLines.TakeReference(vtkCellArray::New());
-          newLines->AllocateEstimate(5, 2);
-          outLineData.TakeReference(vtkCellData::New());
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inPolys->GetNumberOfCells() - newPolys->GetNumberOfCells()
-                  << " polys");
+    StaticCleanRewrite rewrite;
+    rewrite.PointMap = pmap;
+    rewrite.Convert[CLEAN_VERTS] = this->ConvertLinesToPoints;
+    rewrite.Convert[CLEAN_LINES] = this->ConvertPolysToLines;
+    rewrite.Convert[CLEAN_POLYS] = this->ConvertStripsToPolys;
+    RewriteCleanCells(input, rewrite, newCells);
   }
   this->UpdateProgress(0.9);
 
-  // triangle strips can reduced to polys/lines/points etc
-  if (!this->GetAbortExecute() && inStrips->GetNumberOfCells() > 0)
-  {
-    newStrips.TakeReference(vtkCellArray::New());
-    newStrips->AllocateCopy(inStrips);
-    outStrpData.TakeReference(vtkCellData::New());
-    outStrpData->CopyAllocate(inCD);
-
-    for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts); inCellID++)
-    {
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      }
-      if (cellIds.size() > 3)
-      {
-        newId = newStrips->InsertNextCell(cellIds.size(), cellIds.data());
-        outStrpData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 3 && this->ConvertStripsToPolys)
-      {
-        if (!newPolys)
-        {
-          newPolys.TakeReference(vtkCellArray::New());
-          newPolys->AllocateEstimate(5, 3);
-          outPolyData.TakeReference(vtkCellData::New());
-          outPolyData->CopyAllocate(inCD);
-        }
-        newId = newPolys->InsertNextCell(cellIds.size(), cellIds.data());
-        outPolyData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 2 && this->ConvertPolysToLines)
-      {
-        if (!newLines)
-        {
-          newLines.TakeReference(vtkCellArray::New());
-          newLines->AllocateEstimate(5, 2);
-          outLineData.TakeReference(vtkCellData::New());
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inStrips->GetNumberOfCells() - newStrips->GetNumberOfCells()
-                  << " strips");
-  }
-
-  vtkDebugMacro(<< "Removed " << numNewPts - newPts->GetNumberOfPoints() << " points");
+  vtkDebugMacro(<< "Removed " << input->GetNumberOfCells() - newCells.GetNumberOfCells()
+                << " cells");
 
   // Update ourselves and release memory
   //
   this->Locator->Initialize(); // release memory.
 
-  // Now transfer all CellData from Lines/Polys/Strips into final
-  // cell attribute data. The vertex cell data has already been inserted.
-  vtkIdType cellCounter = (newVerts == nullptr ? 0 : newVerts->GetNumberOfCells());
-  vtkIdType lineCounter = (newLines == nullptr ? 0 : newLines->GetNumberOfCells());
-  vtkIdType polyCounter = (newPolys == nullptr ? 0 : newPolys->GetNumberOfCells());
-  vtkIdType strpCounter = (newStrips == nullptr ? 0 : newStrips->GetNumberOfCells());
-
-  if (newLines)
-  {
-    for (i = 0; i < lineCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outLineData, i, cellCounter);
-    }
-  }
-  if (newPolys)
-  {
-    for (i = 0; i < polyCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outPolyData, i, cellCounter);
-    }
-  }
-  if (newStrips)
-  {
-    for (i = 0; i < strpCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outStrpData, i, cellCounter);
-    }
-  }
+  // Copy the cell data of the input cells the output cells come from.
+  outCD->CopyAllocate(inCD, newCells.GetNumberOfCells());
+  outCD->CopyData(inCD, newCells.CellIds);
 
   // Update the output connectivity
-  if (newVerts)
+  if (newCells.Cells[CLEAN_VERTS])
   {
-    output->SetVerts(newVerts);
+    output->SetVerts(newCells.Cells[CLEAN_VERTS]);
   }
-  if (newLines)
+  if (newCells.Cells[CLEAN_LINES])
   {
-    output->SetLines(newLines);
+    output->SetLines(newCells.Cells[CLEAN_LINES]);
   }
-  if (newPolys)
+  if (newCells.Cells[CLEAN_POLYS])
   {
-    output->SetPolys(newPolys);
+    output->SetPolys(newCells.Cells[CLEAN_POLYS]);
   }
-  if (newStrips)
+  if (newCells.Cells[CLEAN_STRIPS])
   {
-    output->SetStrips(newStrips);
+    output->SetStrips(newCells.Cells[CLEAN_STRIPS]);
   }
 
   return 1;
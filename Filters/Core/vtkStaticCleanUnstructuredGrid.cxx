@@ -30,6 +30,8 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 vtkStandardNewMacro(vtkStaticCleanUnstructuredGrid);
@@ -40,14 +42,17 @@ namespace
 using PointUses = unsigned char;
 
 // Helper functions to mark points used by cells taking into account
-// the point merging information.
+// the point merging information. Threads only ever set the uses to 1.
 template <typename UType>
 void MarkUses(vtkIdType numIds, UType* connArray, vtkIdType* mergeMap, PointUses* ptUses)
 {
-  for (auto i = 0; i < numIds; ++i)
-  {
-    ptUses[mergeMap[connArray->GetValue(i)]] = 1;
-  }
+  const auto conn = connArray->GetPointer(0);
+  vtkSMPTools::For(0, numIds, [conn, mergeMap, ptUses](vtkIdType i, vtkIdType endI) {
+    for (; i < endI; ++i)
+    {
+      ptUses[mergeMap[conn[i]]] = 1;
+    }
+  }); // end lambda
 }
 
 //------------------------------------------------------------------------------
@@ -71,21 +76,35 @@ struct CopyPointsAlgorithm
     this->Arrays.AddArrays(numNewPts, inPD, outPD);
 
     // Need to define a reverse point map (which maps the new/output points
-    // to the input points from which they were merged). This could be
-    // threaded for minimal performance gain - it's probably not worth it.
-    this->ReversePtMap.resize(numNewPts);
-    std::fill(this->ReversePtMap.begin(), this->ReversePtMap.end(), -1);
-
-    // Since we are copying (not averaging), just find the first point from
-    // the input which merged to the output point.
-    vtkIdType numInPts = inPts->GetNumberOfTuples();
-    for (auto inPtId = 0; inPtId < numInPts; ++inPtId)
-    {
-      if (ptMap[inPtId] != -1 && this->ReversePtMap[ptMap[inPtId]] == -1)
+    // to the input points from which they were merged). Since we are copying
+    // (not averaging), just find the first point from the input which merged
+    // to the output point, as a concurrent minimum of the input point ids.
+    const vtkIdType numInPts = inPts->GetNumberOfTuples();
+    std::unique_ptr<std::atomic<vtkIdType>[]> firstPts(new std::atomic<vtkIdType>[numNewPts]);
+    std::atomic<vtkIdType>* first = firstPts.get();
+    vtkSMPTools::For(0, numNewPts, [first, numInPts](vtkIdType outPtId, vtkIdType endPtId) {
+      for (; outPtId < endPtId; ++outPtId)
       {
-        this->ReversePtMap[ptMap[inPtId]] = inPtId;
+        first[outPtId].store(numInPts, std::memory_order_relaxed);
       }
-    }
+    }); // end lambda
+    vtkSMPTools::For(0, numInPts, [first, ptMap](vtkIdType inPtId, vtkIdType endPtId) {
+      for (; inPtId < endPtId; ++inPtId)
+      {
+        if (ptMap[inPtId] != -1)
+        {
+          std::atomic<vtkIdType>& outFirst = first[ptMap[inPtId]];
+          vtkIdType current = outFirst.load(std::memory_order_relaxed);
+          while (inPtId < current &&
+            !outFirst.compare_exchange_weak(current, inPtId, std::memory_order_relaxed))
+          {
+          }
+        }
+      }
+    }); // end lambda
+
+    this->ReversePtMap.resize(numNewPts);
+    std::copy(first, first + numNewPts, this->ReversePtMap.begin());
   }
 
   // Threaded copy point coordinates and attribute data
@@ -561,24 +580,39 @@ vtkIdType vtkStaticCleanUnstructuredGrid::BuildPointMap(
 {
   // Count and map points to new points, taking into account
   // point uses (if requested).
-  vtkIdType id, numNewPts = 0;
-  // Perform a prefix sum to count the number of new points.
-  std::fill_n(pmap, numPts, (-1));
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] == id && (ptUses == nullptr || ptUses[id] != 0))
+  const vtkIdType* merge = mergeMap.data();
+  std::vector<unsigned char> kept(numPts);
+  unsigned char* keep = kept.data();
+  vtkSMPTools::For(0, numPts, [merge, ptUses, keep](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
     {
-      pmap[id] = numNewPts++;
+      keep[id] = (merge[id] == id && (ptUses == nullptr || ptUses[id] != 0));
     }
-  }
-  // Now map old merged points to new points
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] != id)
+  }); // end lambda
+
+  // Perform a prefix sum to number the new points.
+  vtkSMPTools::ExclusiveScan(keep, keep + numPts, pmap, vtkIdType(0));
+  const vtkIdType numNewPts = (numPts > 0 ? pmap[numPts - 1] + keep[numPts - 1] : 0);
+
+  // Discard the unused points, then map old merged points to new points
+  vtkSMPTools::For(0, numPts, [pmap, keep](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
     {
-      pmap[id] = pmap[mergeMap[id]];
+      if (!keep[id])
+      {
+        pmap[id] = (-1);
+      }
     }
-  }
+  }); // end lambda
+  vtkSMPTools::For(0, numPts, [merge, pmap](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      if (merge[id] != id)
+      {
+        pmap[id] = pmap[merge[id]];
+      }
+    }
+  }); // end lambda
   return numNewPts;
 }
 
@@ -622,15 +656,10 @@ void vtkStaticCleanUnstructuredGrid::AveragePoints(vtkPoints* inPts, vtkPointDat
   vtkSMPTools::For(0, numInPts, count);
 
   // Perform a prefix sum to determine the offsets.
-  vtkIdType ptId, npts;
   std::unique_ptr<vtkIdType> uOffsets(new vtkIdType[numOutPts + 1]); // extra +1 for convenience
   vtkIdType* offsets = uOffsets.get();
-  offsets[0] = 0;
-  for (ptId = 1; ptId <= numOutPts; ++ptId)
-  {
-    npts = counts[ptId - 1];
-    offsets[ptId] = offsets[ptId - 1] + npts;
-  }
+  vtkSMPTools::ExclusiveScan(counts, counts + numOutPts, offsets, vtkIdType(0));
+  offsets[numOutPts] = (numOutPts > 0 ? offsets[numOutPts - 1] + counts[numOutPts - 1] : 0);
 
   // Configure the "links" which are, for each output point, lists
   // the input points merged to that output point. The offsets point into
@@ -642,6 +671,15 @@ void vtkStaticCleanUnstructuredGrid::AveragePoints(vtkPoints* inPts, vtkPointDat
   InsertLinks insertLinks(ptMap, counts, links, offsets);
   vtkSMPTools::For(0, numInPts, insertLinks);
 
+  // The links are inserted concurrently. Sort them so that the averages do
+  // not depend on the number of threads.
+  vtkSMPTools::For(0, numOutPts, [links, offsets](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      std::sort(links + offsets[ptId], links + offsets[ptId + 1]);
+    }
+  }); // end lambda
+
   // Okay, now we can actually average the point coordinates and
   // point attribute data.
   AverageWorklet average;
@@ -20,11 +20,13 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
-#include "vtkCellIterator.h"
+#include "vtkCellSubsetExtractor.h"
+#include "vtkDataObjectMeshCache.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -159,8 +161,8 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   vtkUnstructuredGrid* output =
     vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkPointData *pd = input->GetPointData(), *outPD = output->GetPointData();
-  vtkCellData *cd = input->GetCellData(), *outCD = output->GetCellData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* outCD = output->GetCellData();
 
   vtkDebugMacro(<< "Executing threshold filter");
 
@@ -180,12 +182,21 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   outPD->CopyGlobalIdsOn();
-  outPD->CopyAllocate(pd);
   outCD->CopyGlobalIdsOn();
-  outCD->CopyAllocate(cd);
 
-  vtkIdType numPts = input->GetNumberOfPoints();
-  output->Allocate(input->GetNumberOfCells());
+  // the extracted mesh only depends on the input mesh, the thresholded
+  // array and this filter
+  vtkMTimeType dependencyMTime = std::max(this->GetMTime(), inScalars->GetMTime());
+  if (!this->UseMeshCache)
+  {
+    this->MeshCache->ClearCache();
+  }
+  else if (this->MeshCache->IsValid(input, dependencyMTime))
+  {
+    vtkDebugMacro(<< "Reusing the cached mesh");
+    this->MeshCache->CopyCacheToDataObject(input, output);
+    return 1;
+  }
 
   vtkSmartPointer<vtkPoints> newPoints = vtkSmartPointer<vtkPoints>::Take(vtkPoints::New());
 
@@ -211,113 +222,60 @@ int vtkThreshold::RequestData(vtkInformation* vtkNotUsed(request),
     newPoints->SetDataType(VTK_DOUBLE);
   }
 
-  newPoints->Allocate(numPts);
-
-  vtkSmartPointer<vtkIdList> pointMap =
-    vtkSmartPointer<vtkIdList>::Take(vtkIdList::New()); // maps old point ids into new
-  pointMap->SetNumberOfIds(numPts);
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    pointMap->SetId(i, -1);
-  }
-
-  vtkSmartPointer<vtkIdList> newCellPts = vtkSmartPointer<vtkIdList>::Take(vtkIdList::New());
-
   // are we using pointScalars?
   int fieldAssociation = this->GetInputArrayAssociation(0, inputVector);
   bool usePointScalars = fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS;
 
-  // Check that the scalars of each cell satisfy the threshold criterion
-  vtkSmartPointer<vtkCellIterator> it =
-    vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
-  for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextCell())
-  {
-    int cellType = it->GetCellType();
-    if (cellType == VTK_EMPTY_CELL)
-    {
-      continue;
-    }
-
-    vtkIdType cellId = it->GetCellId();
-    vtkIdList* cellPts = it->GetPointIds();
-    int numCellPts = it->GetNumberOfPoints();
-
-    int keepCell(0);
+  // Check that the scalars of each cell satisfy the threshold criterion. The
+  // cells are classified and extracted in parallel.
+  auto keepCell = [&](vtkIdType cellId, vtkIdList* cellPts) {
+    int numCellPts = static_cast<int>(cellPts->GetNumberOfIds());
+    int keep(0);
     if (usePointScalars)
     {
       if (this->AllScalars)
       {
-        keepCell = 1;
-        for (int i = 0; keepCell && (i < numCellPts); i++)
+        keep = 1;
+        for (int i = 0; keep && (i < numCellPts); i++)
         {
-          vtkIdType ptId = cellPts->GetId(i);
-          keepCell = this->EvaluateComponents(inScalars, ptId);
+          keep = this->EvaluateComponents(inScalars, cellPts->GetId(i));
         }
       }
       else
       {
         if (!this->UseContinuousCellRange)
         {
-          keepCell = 0;
-          for (int i = 0; (!keepCell) && (i < numCellPts); i++)
+          keep = 0;
+          for (int i = 0; (!keep) && (i < numCellPts); i++)
           {
-            vtkIdType ptId = cellPts->GetId(i);
-            keepCell = this->EvaluateComponents(inScalars, ptId);
+            keep = this->EvaluateComponents(inScalars, cellPts->GetId(i));
           }
         }
         else
         {
-          keepCell = this->EvaluateCell(inScalars, cellPts, numCellPts);
+          keep = this->EvaluateCell(inScalars, cellPts, numCellPts);
         }
       }
     }
     else // use cell scalars
     {
-      keepCell = this->EvaluateComponents(inScalars, cellId);
+      keep = this->EvaluateComponents(inScalars, cellId);
     }
 
     // Invert the keep flag if the Invert option is enabled.
-    keepCell = this->Invert ? (1 - keepCell) : keepCell;
+    return (this->Invert ? (1 - keep) : keep) != 0;
+  };
 
-    if (numCellPts > 0 && keepCell)
-    {
-      // satisfied thresholding (also non-empty cell, i.e. not VTK_EMPTY_CELL)
-      for (vtkIdType i = 0; i < numCellPts; i++)
-      {
-        vtkIdType ptId = cellPts->GetId(i);
-        vtkIdType newId = pointMap->GetId(ptId);
-        if (newId < 0)
-        {
-          double x[3];
-          input->GetPoint(ptId, x);
-          newId = newPoints->InsertNextPoint(x);
-          pointMap->SetId(ptId, newId);
-          outPD->CopyData(pd, ptId, newId);
-        }
-        newCellPts->InsertId(i, newId);
-      }
-      // special handling for polyhedron cells
-      if (cellType == VTK_POLYHEDRON)
-      {
-        newCellPts->Reset();
-        vtkIdList* faces = it->GetFaces();
-        for (vtkIdType j = 0; j < faces->GetNumberOfIds(); ++j)
-        {
-          newCellPts->InsertNextId(faces->GetId(j));
-        }
-        vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap->GetPointer(0));
-      }
-      vtkIdType newCellId = output->InsertNextCell(it->GetCellType(), newCellPts);
-      outCD->CopyData(cd, cellId, newCellId);
-      newCellPts->Reset();
-    } // satisfied thresholding
-  }   // for all cells
+  vtkNew<vtkCellSubsetExtractor> extractor;
+  extractor->Extract(input, keepCell, nullptr, newPoints, output);
 
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfCells() << " number of cells.");
 
-  // now  update ourselves
-  output->SetPoints(newPoints);
-  output->Squeeze();
+  if (this->UseMeshCache)
+  {
+    this->MeshCache->UpdateCache(
+      input, output, extractor->GetPointIds(), extractor->GetCellIds(), dependencyMTime);
+  }
 
   return 1;
 }
@@ -504,4 +462,5 @@ void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Upper Threshold: " << this->UpperThreshold << "\n";
   os << indent << "Precision of the output points: " << this->OutputPointsPrecision << "\n";
   os << indent << "Use Continuous Cell Range: " << this->UseContinuousCellRange << endl;
+  os << indent << "Use Mesh Cache: " << this->UseMeshCache << endl;
 }
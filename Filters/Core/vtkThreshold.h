@@ -39,6 +39,7 @@
 
 #include "vtkDeprecation.h"       // For VTK_DEPRECATED_IN_9_1_0
 #include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkNew.h"                // For vtkNew
 #include "vtkUnstructuredGridAlgorithm.h"
 
 #define VTK_ATTRIBUTE_MODE_DEFAULT 0
@@ -51,6 +52,7 @@
 #define VTK_COMPONENT_MODE_USE_ANY 2
 
 class vtkDataArray;
+class vtkDataObjectMeshCache;
 class vtkIdList;
 
 class VTKFILTERSCORE_EXPORT vtkThreshold : public vtkUnstructuredGridAlgorithm
@@ -219,6 +221,25 @@ public:
   int GetOutputPointsPrecision() const;
   ///@}
 
+  ///@{
+  /**
+   * When on, keep the extracted mesh and the ids of the extracted points and
+   * cells, and reuse them while the mesh of the input (see
+   * vtkDataObjectMeshCache::GetMeshMTime()), the thresholded array and this
+   * filter are unchanged. Only the attributes are then copied, which speeds
+   * up the thresholding of a time series on a static mesh by another array.
+   * Off by default.
+   */
+  vtkSetMacro(UseMeshCache, vtkTypeBool);
+  vtkGetMacro(UseMeshCache, vtkTypeBool);
+  vtkBooleanMacro(UseMeshCache, vtkTypeBool);
+  ///@}
+
+  /**
+   * Get the cache of the extracted mesh used when UseMeshCache is on.
+   */
+  vtkDataObjectMeshCache* GetMeshCache() { return this->MeshCache; }
+
   ///@{
   /**
    * Methods used for thresholding. vtkThreshold::Lower returns true if s is lower than the lower
@@ -255,6 +276,8 @@ protected:
   int ComponentMode = VTK_COMPONENT_MODE_USE_SELECTED;
   int SelectedComponent = 0;
   int OutputPointsPrecision = DEFAULT_PRECISION;
+  vtkTypeBool UseMeshCache = 0;
+  vtkNew<vtkDataObjectMeshCache> MeshCache;
 
   int (vtkThreshold::*ThresholdFunction)(double s) const = &vtkThreshold::Between;
 
@@ -0,0 +1,161 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExtractCompactConnectivity.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the extraction filters keep the 32-bit connectivity of their
+// input, and that they handle inputs without cells.
+
+#include "vtkCellArray.h"
+#include "vtkExtractCells.h"
+#include "vtkExtractGeometry.h"
+#include "vtkExtractPolyDataGeometry.h"
+#include "vtkExtractUnstructuredGrid.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphere.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const vtkIdType NumberOfTriangles = 100;
+
+//------------------------------------------------------------------------------
+// A strip of triangles with 32-bit connectivity when numCells is not 0, and
+// points only otherwise.
+void MakeInput(vtkPointSet* input, vtkIdType numCells)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  for (vtkIdType i = 0; i < NumberOfTriangles + 2; ++i)
+  {
+    points->InsertNextPoint(0.1 * i, 0.1 * (i % 2), 0.);
+    scalars->InsertNextValue(static_cast<float>(i));
+  }
+  vtkNew<vtkCellArray> cells;
+  cells->Use32BitStorage();
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    const vtkIdType tri[3] = { i, i + 1, i + 2 };
+    cells->InsertNextCell(3, tri);
+  }
+
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input))
+  {
+    if (numCells > 0)
+    {
+      grid->SetCells(VTK_TRIANGLE, cells);
+    }
+  }
+  else
+  {
+    vtkPolyData::SafeDownCast(input)->SetPolys(cells);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool CheckOutput(const char* name, vtkCellArray* cells, vtkIdType numCells, vtkIdType expected)
+{
+  const vtkIdType numOutputCells = cells ? cells->GetNumberOfCells() : 0;
+  if (numOutputCells != expected)
+  {
+    std::cerr << name << ": " << numOutputCells << " cells instead of " << expected
+              << " with an input of " << numCells << " cells." << std::endl;
+    return false;
+  }
+  if (numOutputCells > 0 && cells->IsStorage64Bit())
+  {
+    std::cerr << name << ": the 32-bit connectivity was not kept." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestFilters(vtkIdType numCells)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeInput(grid, numCells);
+  vtkNew<vtkPolyData> polyData;
+  MakeInput(polyData, numCells);
+  // The sphere contains the first half of the triangles.
+  vtkNew<vtkSphere> sphere;
+  sphere->SetRadius(0.1 * (NumberOfTriangles / 2 + 1) + 0.05);
+  const vtkIdType half = numCells > 0 ? NumberOfTriangles / 2 : 0;
+
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputData(grid);
+  threshold->SetLowerThreshold(0.);
+  threshold->SetUpperThreshold(NumberOfTriangles / 2 + 1);
+  threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+  threshold->SetAllScalars(true);
+  threshold->Update();
+  bool ok = CheckOutput("vtkThreshold", threshold->GetOutput()->GetCells(), numCells, half);
+
+  vtkNew<vtkExtractCells> extractCells;
+  extractCells->SetInputData(grid);
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType i = 0; i < half; ++i)
+  {
+    cellIds->InsertNextId(2 * i);
+  }
+  extractCells->SetCellList(cellIds);
+  extractCells->Update();
+  ok &= CheckOutput("vtkExtractCells", extractCells->GetOutput()->GetCells(), numCells, half);
+
+  vtkNew<vtkExtractGeometry> extractGeometry;
+  extractGeometry->SetInputData(grid);
+  extractGeometry->SetImplicitFunction(sphere);
+  extractGeometry->Update();
+  ok &=
+    CheckOutput("vtkExtractGeometry", extractGeometry->GetOutput()->GetCells(), numCells, half);
+
+  vtkNew<vtkExtractUnstructuredGrid> extractGrid;
+  extractGrid->SetInputData(grid);
+  extractGrid->CellClippingOn();
+  extractGrid->SetCellMinimum(0);
+  extractGrid->SetCellMaximum(half - 1);
+  extractGrid->Update();
+  ok &=
+    CheckOutput("vtkExtractUnstructuredGrid", extractGrid->GetOutput()->GetCells(), numCells, half);
+
+  vtkNew<vtkExtractPolyDataGeometry> extractPolyData;
+  extractPolyData->SetInputData(polyData);
+  extractPolyData->SetImplicitFunction(sphere);
+  extractPolyData->Update();
+  ok &= CheckOutput(
+    "vtkExtractPolyDataGeometry", extractPolyData->GetOutput()->GetPolys(), numCells, half);
+
+  return ok;
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int TestExtractCompactConnectivity(int, char*[])
+{
+  if (!TestFilters(NumberOfTriangles) || !TestFilters(0))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
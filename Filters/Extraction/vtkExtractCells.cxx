@@ -171,6 +171,11 @@ static ExtractedCellsT DoExtractCells(vtkDataSet* input, const CellWorkT& work)
 
   ExtractedCellsT result;
   result.Connectivity.TakeReference(vtkCellArray::New());
+  if (vtkUnstructuredGrid* inputUG = vtkUnstructuredGrid::SafeDownCast(input))
+  {
+    // keep compact 32-bit connectivity
+    result.Connectivity->UseStorageOf(inputUG->GetCells());
+  }
   result.Connectivity->AllocateEstimate(numCells, input->GetMaxCellSize());
   result.CellTypes.TakeReference(vtkUnsignedCharArray::New());
   result.CellTypes->Allocate(numCells);
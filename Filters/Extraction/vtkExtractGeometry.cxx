@@ -15,11 +15,10 @@
 #include "vtkExtractGeometry.h"
 
 #include "vtk3DLinearGridCrinkleExtractor.h"
-#include "vtkCell.h"
 #include "vtkCellData.h"
-#include "vtkCellIterator.h"
+#include "vtkCellSubsetExtractor.h"
+#include "vtkDoubleArray.h"
 #include "vtkEventForwarderCommand.h"
-#include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkImplicitFunction.h"
 #include "vtkInformation.h"
@@ -28,9 +27,13 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
-#include "vtkSmartPointer.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkExtractGeometry);
 vtkCxxSetObjectMacro(vtkExtractGeometry, ImplicitFunction, vtkImplicitFunction);
 
@@ -102,22 +105,8 @@ int vtkExtractGeometry::RequestData(
     return retval;
   }
 
-  vtkIdType ptId, numPts, numCells, i, newCellId, newId, *pointMap;
-  vtkSmartPointer<vtkCellIterator> cellIter =
-    vtkSmartPointer<vtkCellIterator>::Take(input->NewCellIterator());
-  vtkIdList* pointIdList;
-  int cellType;
-  vtkIdType numCellPts;
-  double x[3];
-  double multiplier;
-  vtkPoints* newPts;
-  vtkIdList* newCellPts;
-  vtkIdList* faces;
-  vtkPointData* pd = input->GetPointData();
-  vtkCellData* cd = input->GetCellData();
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
-  int npts;
 
   vtkDebugMacro(<< "Extracting geometry");
 
@@ -132,178 +121,64 @@ int vtkExtractGeometry::RequestData(
   outputPD->CopyGlobalIdsOn();
   outputCD->CopyGlobalIdsOn();
 
-  newCellPts = vtkIdList::New();
-  newCellPts->Allocate(VTK_CELL_SIZE);
-
-  if (this->ExtractInside)
-  {
-    multiplier = 1.0;
-  }
-  else
-  {
-    multiplier = -1.0;
-  }
-
-  // Loop over all points determining whether they are inside the
-  // implicit function. Copy the points and point data if they are.
-  //
-  numPts = input->GetNumberOfPoints();
-  numCells = input->GetNumberOfCells();
-  pointMap = new vtkIdType[numPts]; // maps old point ids into new
-  for (i = 0; i < numPts; i++)
-  {
-    pointMap[i] = -1;
-  }
-
-  output->Allocate(numCells / 4); // allocate storage for geometry/topology
-  newPts = vtkPoints::New();
-  newPts->Allocate(numPts / 4, numPts);
-  outputPD->CopyAllocate(pd);
-  outputCD->CopyAllocate(cd);
-  vtkFloatArray* newScalars = nullptr;
+  double multiplier = this->ExtractInside ? 1.0 : -1.0;
 
-  if (!this->ExtractBoundaryCells)
+  // Evaluate the implicit function at all the points, at once for point
+  // sets. Implicit functions are not thread-safe, so this is done before
+  // the cells are processed in parallel.
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> values;
+  vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
+  if (inputPointSet && inputPointSet->GetPoints())
   {
-    for (ptId = 0; ptId < numPts; ptId++)
-    {
-      input->GetPoint(ptId, x);
-      if ((this->ImplicitFunction->FunctionValue(x) * multiplier) < 0.0)
-      {
-        newId = newPts->InsertNextPoint(x);
-        pointMap[ptId] = newId;
-        outputPD->CopyData(pd, ptId, newId);
-      }
-    }
+    this->ImplicitFunction->FunctionValue(inputPointSet->GetPoints()->GetData(), values);
   }
   else
   {
-    // To extract boundary cells, we have to create supplemental information
-    double val;
-    newScalars = vtkFloatArray::New();
-    newScalars->SetNumberOfValues(numPts);
-
-    for (ptId = 0; ptId < numPts; ptId++)
+    values->SetNumberOfValues(numPts);
+    double x[3];
+    for (vtkIdType ptId = 0; ptId < numPts; ptId++)
     {
       input->GetPoint(ptId, x);
-      val = this->ImplicitFunction->FunctionValue(x) * multiplier;
-      newScalars->SetValue(ptId, val);
+      values->SetValue(ptId, this->ImplicitFunction->FunctionValue(x));
     }
   }
 
-  // Now loop over all cells to see whether they are inside implicit
-  // function (or on boundary if ExtractBoundaryCells is on).
-  //
-  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal(); cellIter->GoToNextCell())
-  {
-    cellType = cellIter->GetCellType();
-    numCellPts = cellIter->GetNumberOfPoints();
-    pointIdList = cellIter->GetPointIds();
-
-    newCellPts->Reset();
-    if (!this->ExtractBoundaryCells) // requires less work
-    {
-      for (npts = 0, i = 0; i < numCellPts; i++, npts++)
-      {
-        ptId = pointIdList->GetId(i);
-        if (pointMap[ptId] < 0)
-        {
-          break; // this cell won't be inserted
-        }
-        else
-        {
-          newCellPts->InsertId(i, pointMap[ptId]);
-        }
-      }
-    } // if don't want to extract boundary cells
-
-    else // want boundary cells
+  // Flag the points inside the implicit function, on its boundary included
+  // when extracting boundary cells.
+  std::vector<unsigned char> inside(numPts);
+  const bool boundary = this->ExtractBoundaryCells != 0;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
     {
-      for (npts = 0, i = 0; i < numCellPts; i++)
-      {
-        ptId = pointIdList->GetId(i);
-        if (newScalars->GetValue(ptId) <= 0.0)
-        {
-          npts++;
-        }
-      }
-      int extraction_condition = 0;
-      if (this->ExtractOnlyBoundaryCells)
-      {
-        if ((npts > 0) && (npts != numCellPts))
-        {
-          extraction_condition = 1;
-        }
-      }
-      else
-      {
-        if (npts > 0)
-        {
-          extraction_condition = 1;
-        }
-      }
-      if (extraction_condition)
-      {
-        for (i = 0; i < numCellPts; i++)
-        {
-          ptId = pointIdList->GetId(i);
-          if (pointMap[ptId] < 0)
-          {
-            input->GetPoint(ptId, x);
-            newId = newPts->InsertNextPoint(x);
-            pointMap[ptId] = newId;
-            outputPD->CopyData(pd, ptId, newId);
-          }
-          newCellPts->InsertId(i, pointMap[ptId]);
-        }
-      } // a boundary or interior cell
-    }   // if mapping boundary cells
-
-    int extraction_condition = 0;
-    if (this->ExtractOnlyBoundaryCells)
-    {
-      if (npts != numCellPts && (this->ExtractBoundaryCells && npts > 0))
-      {
-        extraction_condition = 1;
-      }
+      double val = values->GetValue(ptId) * multiplier;
+      inside[ptId] = boundary ? val <= 0.0 : val < 0.0;
     }
-    else
+  });
+
+  // Cells are extracted when all their points are inside, or when some of
+  // their points are inside (but not all of them for boundary cells only)
+  // if boundary cells are extracted.
+  const bool onlyBoundary = this->ExtractOnlyBoundaryCells != 0;
+  auto keepCell = [&](vtkIdType, vtkIdList* cellPts) {
+    vtkIdType numCellPts = cellPts->GetNumberOfIds();
+    vtkIdType npts = 0;
+    for (vtkIdType i = 0; i < numCellPts; i++)
     {
-      if (npts >= numCellPts || (this->ExtractBoundaryCells && npts > 0))
-      {
-        extraction_condition = 1;
-      }
+      npts += inside[cellPts->GetId(i)];
     }
-    if (extraction_condition)
+    if (!boundary)
     {
-      // special handling for polyhedron cells
-      if (cellType == VTK_POLYHEDRON)
-      {
-        newCellPts->Reset();
-        faces = cellIter->GetFaces();
-        for (i = 0; i < faces->GetNumberOfIds(); ++i)
-        {
-          newCellPts->InsertNextId(faces->GetId(i));
-        }
-        vtkUnstructuredGrid::ConvertFaceStreamPointIds(newCellPts, pointMap);
-      }
-      newCellId = output->InsertNextCell(cellType, newCellPts);
-      outputCD->CopyData(cd, cellIter->GetCellId(), newCellId);
+      return !onlyBoundary && npts == numCellPts;
     }
-  } // for all cells
-
-  // Update ourselves and release memory
-  //
-  delete[] pointMap;
-  newCellPts->Delete();
-  output->SetPoints(newPts);
-  newPts->Delete();
-
-  if (this->ExtractBoundaryCells)
-  {
-    newScalars->Delete();
-  }
-
-  output->Squeeze();
+    return npts > 0 && (!onlyBoundary || npts != numCellPts);
+  };
+
+  // Without boundary cells, all the points inside are extracted, otherwise
+  // the points of the extracted cells.
+  vtkNew<vtkPoints> newPts;
+  vtkNew<vtkCellSubsetExtractor> extractor;
+  extractor->Extract(input, keepCell, boundary ? nullptr : inside.data(), newPts, output);
 
   return 1;
 }
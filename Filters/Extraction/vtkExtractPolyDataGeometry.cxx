@@ -17,9 +17,11 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkImplicitFunction.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -82,7 +84,7 @@ int vtkExtractPolyDataGeometry::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   vtkPoints* inPts = input->GetPoints();
-  vtkIdType numPts, i, cellId = 0, newId = 0, ptId = 0, *pointMap = nullptr;
+  vtkIdType numPts, i, cellId = 0, ptId = 0, *pointMap = nullptr;
   float multiplier;
   vtkCellArray *inVerts = nullptr, *inLines = nullptr, *inPolys = nullptr, *inStrips = nullptr;
   vtkCellArray *newVerts = nullptr, *newLines = nullptr, *newPolys = nullptr, *newStrips = nullptr;
@@ -143,6 +145,10 @@ int vtkExtractPolyDataGeometry::RequestData(vtkInformation* vtkNotUsed(request),
   }
   outputCD->CopyAllocate(cd);
 
+  // input ids of the output cells, whose attributes are copied at once after
+  // the extraction
+  vtkNew<vtkIdList> keptCellIds;
+
   // Now loop over all cells to see whether they are inside the implicit
   // function. Copy if they are. Note: there is an awful hack here, that
   // can result in bugs. The cellId is assumed to be arranged starting
@@ -155,24 +161,28 @@ int vtkExtractPolyDataGeometry::RequestData(vtkInformation* vtkNotUsed(request),
   {
     inVerts = input->GetVerts();
     newVerts = vtkCellArray::New();
+    newVerts->UseStorageOf(inVerts);
     newVerts->AllocateCopy(inVerts);
   }
   if (input->GetNumberOfLines())
   {
     inLines = input->GetLines();
     newLines = vtkCellArray::New();
+    newLines->UseStorageOf(inLines);
     newLines->AllocateCopy(inLines);
   }
   if (input->GetNumberOfPolys())
   {
     inPolys = input->GetPolys();
     newPolys = vtkCellArray::New();
+    newPolys->UseStorageOf(inPolys);
     newPolys->AllocateCopy(inPolys);
   }
   if (input->GetNumberOfStrips())
   {
     inStrips = input->GetStrips();
     newStrips = vtkCellArray::New();
+    newStrips->UseStorageOf(inStrips);
     newStrips->AllocateCopy(inStrips);
   }
 
@@ -210,8 +220,7 @@ int vtkExtractPolyDataGeometry::RequestData(vtkInformation* vtkNotUsed(request),
             newVerts->InsertCellPoint(ptId);
           }
         }
-        outputCD->CopyData(cd, cellId, newId);
-        newId++;
+        keptCellIds->InsertNextId(cellId);
       }
       cellId++;
     }
@@ -252,8 +261,7 @@ int vtkExtractPolyDataGeometry::RequestData(vtkInformation* vtkNotUsed(request),
             newLines->InsertCellPoint(ptId);
           }
         }
-        outputCD->CopyData(cd, cellId, newId);
-        newId++;
+        keptCellIds->InsertNextId(cellId);
       }
       cellId++;
     }
@@ -294,8 +302,7 @@ int vtkExtractPolyDataGeometry::RequestData(vtkInformation* vtkNotUsed(request),
             newPolys->InsertCellPoint(ptId);
           }
         }
-        outputCD->CopyData(cd, cellId, newId);
-        newId++;
+        keptCellIds->InsertNextId(cellId);
       }
       cellId++;
     }
@@ -336,12 +343,12 @@ int vtkExtractPolyDataGeometry::RequestData(vtkInformation* vtkNotUsed(request),
             newStrips->InsertCellPoint(ptId);
           }
         }
-        outputCD->CopyData(cd, cellId, newId);
-        newId++;
+        keptCellIds->InsertNextId(cellId);
       }
       cellId++;
     }
   }
+  outputCD->CopyData(cd, keptCellIds);
   this->UpdateProgress(1.0);
 
   // Update ourselves and release memory
@@ -352,13 +359,17 @@ int vtkExtractPolyDataGeometry::RequestData(vtkInformation* vtkNotUsed(request),
     output->SetPoints(newPts);
     newPts->Delete();
     outputPD->CopyAllocate(pd);
+    vtkNew<vtkIdList> srcPointIds;
+    vtkNew<vtkIdList> dstPointIds;
     for (i = 0; i < numPts; i++)
     {
       if (pointMap[i] >= 0)
       {
-        outputPD->CopyData(pd, i, pointMap[i]);
+        srcPointIds->InsertNextId(i);
+        dstPointIds->InsertNextId(pointMap[i]);
       }
     }
+    outputPD->CopyData(pd, srcPointIds, dstPointIds);
     delete[] pointMap;
   }
 
@@ -14,15 +14,18 @@
 =========================================================================*/
 #include "vtkExtractUnstructuredGrid.h"
 
-#include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCellSubsetExtractor.h"
 #include "vtkIdList.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkUnstructuredGrid.h"
 
 vtkStandardNewMacro(vtkExtractUnstructuredGrid);
@@ -104,24 +107,13 @@ int vtkExtractUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
   vtkUnstructuredGrid* output =
     vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType cellId, i, newCellId;
-  vtkIdType newPtId;
   vtkIdType numPts = input->GetNumberOfPoints();
   vtkIdType numCells = input->GetNumberOfCells();
-  vtkPoints *inPts = input->GetPoints(), *newPts;
-  char* cellVis;
-  vtkCell* cell;
-  double x[3];
-  vtkIdList* ptIds;
-  vtkIdList* cellIds;
-  vtkIdType ptId;
+  vtkPoints* inPts = input->GetPoints();
   vtkPointData* pd = input->GetPointData();
   vtkCellData* cd = input->GetCellData();
-  int allVisible;
-  vtkIdType numIds;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
-  vtkIdType* pointMap = nullptr;
 
   vtkDebugMacro(<< "Executing extraction filter");
 
@@ -130,140 +122,106 @@ int vtkExtractUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to extract!");
     return 1;
   }
-  cellIds = vtkIdList::New();
-
-  if ((!this->CellClipping) && (!this->PointClipping) && (!this->ExtentClipping))
-  {
-    allVisible = 1;
-    cellVis = nullptr;
-  }
-  else
-  {
-    allVisible = 0;
-    cellVis = new char[numCells];
-  }
 
-  // Mark cells as being visible or not
-  if (!allVisible)
-  {
-    for (cellId = 0; cellId < numCells; cellId++)
+  // Cells are visible unless they are clipped by their id, or one of their
+  // points is clipped by its id or the extent. The test is thread-safe.
+  auto isVisible = [&](vtkIdType cellId, vtkIdList* ptIds) {
+    if (this->CellClipping && (cellId < this->CellMinimum || cellId > this->CellMaximum))
     {
-      if (this->CellClipping && (cellId < this->CellMinimum || cellId > this->CellMaximum))
-      {
-        cellVis[cellId] = 0;
-      }
-      else
+      return false;
+    }
+    if (!this->PointClipping && !this->ExtentClipping)
+    {
+      return true;
+    }
+    double x[3];
+    for (vtkIdType i = 0, numIds = ptIds->GetNumberOfIds(); i < numIds; i++)
+    {
+      vtkIdType ptId = ptIds->GetId(i);
+      inPts->GetPoint(ptId, x);
+      if ((this->PointClipping && (ptId < this->PointMinimum || ptId > this->PointMaximum)) ||
+        (this->ExtentClipping &&
+          (x[0] < this->Extent[0] || x[0] > this->Extent[1] || x[1] < this->Extent[2] ||
+            x[1] > this->Extent[3] || x[2] < this->Extent[4] || x[2] > this->Extent[5])))
       {
-        cell = input->GetCell(cellId);
-        ptIds = cell->GetPointIds();
-        numIds = ptIds->GetNumberOfIds();
-        for (i = 0; i < numIds; i++)
-        {
-          ptId = ptIds->GetId(i);
-          input->GetPoint(ptId, x);
-
-          if ((this->PointClipping && (ptId < this->PointMinimum || ptId > this->PointMaximum)) ||
-            (this->ExtentClipping &&
-              (x[0] < this->Extent[0] || x[0] > this->Extent[1] || x[1] < this->Extent[2] ||
-                x[1] > this->Extent[3] || x[2] < this->Extent[4] || x[2] > this->Extent[5])))
-          {
-            cellVis[cellId] = 0;
-            break;
-          }
-        }
-        if (i >= numIds)
-        {
-          cellVis[cellId] = 1;
-        }
+        return false;
       }
     }
+    return true;
+  };
+
+  vtkNew<vtkPoints> newPts;
+  if (!this->Merging)
+  {
+    // keeping original point list: the cells are classified and extracted
+    // in parallel
+    vtkNew<vtkCellSubsetExtractor> extractor;
+    extractor->Extract(input, isVisible, nullptr, newPts, output);
+
+    vtkDebugMacro(<< "Extracted " << output->GetNumberOfPoints() << " points,"
+                  << output->GetNumberOfCells() << " cells.");
+    return 1;
   }
 
-  // Allocate
-  newPts = vtkPoints::New();
+  // Merging coincident points goes through the locator, one cell after the
+  // other.
   newPts->Allocate(numPts);
   output->Allocate(numCells);
+  output->GetCells()->UseStorageOf(input->GetCells()); // keep compact 32-bit connectivity
   outputPD->CopyAllocate(pd, numPts, numPts / 2);
   outputCD->CopyAllocate(cd, numCells, numCells / 2);
 
-  if (this->Merging)
-  {
-    if (this->Locator == nullptr)
-    {
-      this->CreateDefaultLocator();
-    }
-    this->Locator->InitPointInsertion(newPts, input->GetBounds());
-  }
-  else
+  if (this->Locator == nullptr)
   {
-    pointMap = new vtkIdType[numPts];
-    for (i = 0; i < numPts; i++)
-    {
-      pointMap[i] = (-1); // initialize as unused
-    }
+    this->CreateDefaultLocator();
   }
+  this->Locator->InitPointInsertion(newPts, input->GetBounds());
+
+  // input ids of the output points and cells, whose attributes are copied
+  // at once after the extraction
+  vtkNew<vtkIdList> keptPointIds;
+  vtkNew<vtkIdList> keptCellIds;
 
   // Traverse cells to extract geometry
-  for (cellId = 0; cellId < numCells; cellId++)
+  vtkNew<vtkIdList> ptIds;
+  vtkNew<vtkIdList> cellIds;
+  double x[3];
+  vtkIdType newPtId;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
   {
-    if (allVisible || cellVis[cellId])
+    input->GetCellPoints(cellId, ptIds);
+    if (isVisible(cellId, ptIds))
     {
-      cell = input->GetCell(cellId);
-      numIds = cell->PointIds->GetNumberOfIds();
+      vtkIdType numIds = ptIds->GetNumberOfIds();
       cellIds->Reset();
-      if (this->Merging)
+      for (vtkIdType i = 0; i < numIds; i++)
       {
-        for (i = 0; i < numIds; i++)
+        vtkIdType ptId = ptIds->GetId(i);
+        inPts->GetPoint(ptId, x);
+        if (this->Locator->InsertUniquePoint(x, newPtId))
         {
-          ptId = cell->PointIds->GetId(i);
-          input->GetPoint(ptId, x);
-          if (this->Locator->InsertUniquePoint(x, newPtId))
-          {
-            outputPD->CopyData(pd, ptId, newPtId);
-          }
-          cellIds->InsertNextId(newPtId);
+          keptPointIds->InsertNextId(ptId);
         }
-      } // merging coincident points
-      else
-      {
-        for (i = 0; i < numIds; i++)
-        {
-          ptId = cell->PointIds->GetId(i);
-          if (pointMap[ptId] < 0)
-          {
-            pointMap[ptId] = newPtId = newPts->InsertNextPoint(inPts->GetPoint(ptId));
-            outputPD->CopyData(pd, ptId, newPtId);
-          }
-          cellIds->InsertNextId(pointMap[ptId]);
-        }
-      } // keeping original point list
-
-      newCellId = output->InsertNextCell(input->GetCellType(cellId), cellIds);
-      outputCD->CopyData(cd, cellId, newCellId);
+        cellIds->InsertNextId(newPtId);
+      }
 
+      output->InsertNextCell(input->GetCellType(cellId), cellIds);
+      keptCellIds->InsertNextId(cellId);
     } // if cell is visible
   }   // for all cells
 
+  outputPD->CopyData(pd, keptPointIds);
+  outputCD->CopyData(cd, keptCellIds);
+
   // Update ourselves and release memory
   output->SetPoints(newPts);
-  newPts->Delete();
 
   vtkDebugMacro(<< "Extracted " << output->GetNumberOfPoints() << " points,"
                 << output->GetNumberOfCells() << " cells.");
 
-  if (this->Merging && this->Locator)
-  {
-    this->Locator->Initialize();
-  }
-  else
-  {
-    delete[] pointMap;
-  }
+  this->Locator->Initialize();
   output->Squeeze();
 
-  delete[] cellVis;
-  cellIds->Delete();
-
   return 1;
 }
 
@@ -0,0 +1,362 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestParticleTracersParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that the particles advected in parallel by vtkParticlePathFilter,
+// vtkStreaklineFilter and vtkParticleTracer, in static and dynamic meshes,
+// do not depend on the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkParticlePathFilter.h"
+#include "vtkParticleTracer.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreaklineFilter.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Dim = 12;
+const int NumberOfTimeSteps = 6;
+
+// A swirl around the center of the grid, growing with time, with an axial
+// drift taking the particles out of the grid
+void Velocity(const double x[3], double t, double v[3])
+{
+  const double c = 0.5 * (Dim - 1);
+  const double s = 0.4 + 0.1 * t;
+  v[0] = -s * (x[1] - c) + 0.1 * x[2];
+  v[1] = s * (x[0] - c);
+  v[2] = 0.8 + 0.1 * (x[0] - c);
+}
+
+void AddPointData(vtkDataSet* dataset, double t)
+{
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (vtkIdType i = 0; i < dataset->GetNumberOfPoints(); ++i)
+  {
+    double x[3], v[3];
+    dataset->GetPoint(i, x);
+    Velocity(x, t, v);
+    velocity->InsertNextTuple(v);
+    scalars->InsertNextValue(x[0] * x[1] - x[2] + t);
+  }
+  dataset->GetPointData()->SetVectors(velocity);
+  dataset->GetPointData()->AddArray(scalars);
+}
+
+// Hexahedra between the planes z = zBegin and z = zEnd of the grid
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int zBegin, int zEnd, double t)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = zBegin; k <= zEnd; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate((Dim - 1) * (Dim - 1) * (zEnd - zBegin));
+  for (int k = 0; k < zEnd - zBegin; ++k)
+  {
+    for (int j = 0; j < Dim - 1; ++j)
+    {
+      for (int i = 0; i < Dim - 1; ++i)
+      {
+        vtkIdType p = i + Dim * (j + Dim * k);
+        vtkIdType hex[8] = { p, p + 1, p + 1 + Dim, p + Dim, p + Dim * Dim, p + 1 + Dim * Dim,
+          p + 1 + Dim + Dim * Dim, p + Dim + Dim * Dim };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+  AddPointData(grid, t);
+  return grid;
+}
+
+// A time dependent flow in two unstructured grids, or in an image
+class TimeSource : public vtkMultiBlockDataSetAlgorithm
+{
+public:
+  static TimeSource* New();
+  vtkTypeMacro(TimeSource, vtkMultiBlockDataSetAlgorithm);
+
+  vtkSetMacro(Image, bool);
+
+protected:
+  TimeSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double times[NumberOfTimeSteps];
+    for (int i = 0; i < NumberOfTimeSteps; ++i)
+    {
+      times[i] = i;
+    }
+    double range[2] = { 0.0, NumberOfTimeSteps - 1.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times, NumberOfTimeSteps);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::GetData(outInfo);
+    double t = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    if (this->Image)
+    {
+      vtkNew<vtkImageData> image;
+      image->SetDimensions(Dim, Dim, Dim);
+      AddPointData(image, t);
+      output->SetNumberOfBlocks(1);
+      output->SetBlock(0, image);
+    }
+    else
+    {
+      // the particles go from a block to the other
+      output->SetNumberOfBlocks(2);
+      output->SetBlock(0, MakeGrid(0, Dim / 2, t));
+      output->SetBlock(1, MakeGrid(Dim / 2, Dim - 1, t));
+    }
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), t);
+    return 1;
+  }
+
+private:
+  bool Image = false;
+};
+vtkStandardNewMacro(TimeSource);
+
+// Random seeds in and around the grid
+vtkSmartPointer<vtkPolyData> MakeSeeds()
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(5);
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 300; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetRangeValue(-1.0, Dim);
+    }
+    points->InsertNextPoint(x);
+  }
+  vtkSmartPointer<vtkPolyData> seeds = vtkSmartPointer<vtkPolyData>::New();
+  seeds->SetPoints(points);
+  return seeds;
+}
+
+template <typename TracerT>
+vtkSmartPointer<vtkPolyData> Trace(TimeSource* source, vtkPolyData* seeds, bool staticMesh)
+{
+  vtkNew<TracerT> tracer;
+  tracer->SetInputConnection(0, source->GetOutputPort());
+  tracer->SetInputData(1, seeds);
+  tracer->SetStartTime(0.0);
+  tracer->SetTerminationTime(NumberOfTimeSteps - 1.5);
+  tracer->SetForceReinjectionEveryNSteps(2);
+  tracer->SetComputeVorticity(true);
+  tracer->SetStaticMesh(staticMesh);
+  tracer->Update();
+  return tracer->GetOutput();
+}
+
+bool SameCells(vtkCellArray* cells1, vtkCellArray* cells2)
+{
+  if (!cells1 || !cells2)
+  {
+    return cells1 == cells2;
+  }
+  if (cells1->GetNumberOfCells() != cells2->GetNumberOfCells())
+  {
+    return false;
+  }
+  vtkNew<vtkIdList> pts1, pts2;
+  for (vtkIdType i = 0; i < cells1->GetNumberOfCells(); ++i)
+  {
+    cells1->GetCellAtId(i, pts1);
+    cells2->GetCellAtId(i, pts2);
+    if (pts1->GetNumberOfIds() != pts2->GetNumberOfIds())
+    {
+      return false;
+    }
+    for (vtkIdType j = 0; j < pts1->GetNumberOfIds(); ++j)
+    {
+      if (pts1->GetId(j) != pts2->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* output1, vtkPolyData* output2)
+{
+  if (output1->GetNumberOfPoints() != output2->GetNumberOfPoints())
+  {
+    std::cerr << "Different number of points" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output1->GetNumberOfPoints(); ++i)
+  {
+    double x1[3], x2[3];
+    output1->GetPoint(i, x1);
+    output2->GetPoint(i, x2);
+    if (x1[0] != x2[0] || x1[1] != x2[1] || x1[2] != x2[2])
+    {
+      std::cerr << "Different point " << i << std::endl;
+      return false;
+    }
+  }
+  if (!SameCells(output1->GetVerts(), output2->GetVerts()) ||
+    !SameCells(output1->GetLines(), output2->GetLines()))
+  {
+    std::cerr << "Different cells" << std::endl;
+    return false;
+  }
+  vtkPointData* pd1 = output1->GetPointData();
+  vtkPointData* pd2 = output2->GetPointData();
+  if (pd1->GetNumberOfArrays() != pd2->GetNumberOfArrays())
+  {
+    std::cerr << "Different number of arrays" << std::endl;
+    return false;
+  }
+  for (int i = 0; i < pd1->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array1 = pd1->GetArray(i);
+    vtkDataArray* array2 = pd2->GetArray(array1->GetName());
+    if (!array2 || array1->GetNumberOfTuples() != array2->GetNumberOfTuples() ||
+      array1->GetNumberOfComponents() != array2->GetNumberOfComponents())
+    {
+      std::cerr << "Different array " << array1->GetName() << std::endl;
+      return false;
+    }
+    for (vtkIdType j = 0; j < array1->GetNumberOfTuples(); ++j)
+    {
+      for (int c = 0; c < array1->GetNumberOfComponents(); ++c)
+      {
+        if (array1->GetComponent(j, c) != array2->GetComponent(j, c))
+        {
+          std::cerr << "Different values of " << array1->GetName() << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <typename TracerT>
+bool CheckTracer(TimeSource* source, vtkPolyData* seeds, bool staticMesh)
+{
+  vtkSmartPointer<vtkPolyData> output = Trace<TracerT>(source, seeds, staticMesh);
+  if (output->GetNumberOfPoints() < 100 || !output->GetPointData()->GetArray("Scalars") ||
+    !output->GetPointData()->GetArray("Vorticity") ||
+    !output->GetPointData()->GetArray("ParticleAge"))
+  {
+    std::cerr << "Unexpected output" << std::endl;
+    return false;
+  }
+
+  vtkSMPTools::Initialize(1);
+  vtkSmartPointer<vtkPolyData> serialOutput = Trace<TracerT>(source, seeds, staticMesh);
+  vtkSMPTools::Initialize();
+  if (!SameOutput(output, serialOutput))
+  {
+    std::cerr << "Output differs with a single thread" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckTracers(TimeSource* source, vtkPolyData* seeds)
+{
+  for (int staticMesh = 0; staticMesh < 2; ++staticMesh)
+  {
+    if (!CheckTracer<vtkParticlePathFilter>(source, seeds, staticMesh != 0))
+    {
+      std::cerr << "Wrong particle paths with StaticMesh " << staticMesh << std::endl;
+      return false;
+    }
+    if (!CheckTracer<vtkStreaklineFilter>(source, seeds, staticMesh != 0))
+    {
+      std::cerr << "Wrong streaklines with StaticMesh " << staticMesh << std::endl;
+      return false;
+    }
+    if (!CheckTracer<vtkParticleTracer>(source, seeds, staticMesh != 0))
+    {
+      std::cerr << "Wrong particles with StaticMesh " << staticMesh << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestParticleTracersParallel(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> seeds = MakeSeeds();
+
+  vtkNew<TimeSource> gridSource;
+  if (!CheckTracers(gridSource, seeds))
+  {
+    std::cerr << "Wrong particles in the unstructured grids" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<TimeSource> imageSource;
+  imageSource->SetImage(true);
+  if (!CheckTracers(imageSource, seeds))
+  {
+    std::cerr << "Wrong particles in the image" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
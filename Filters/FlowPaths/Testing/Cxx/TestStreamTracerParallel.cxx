@@ -0,0 +1,304 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStreamTracerParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that the streamlines integrated in parallel by vtkStreamTracer are
+// the ones of the serial integration, used with custom termination
+// callbacks, in the same order, and that they do not depend on the number
+// of threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRungeKutta45.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamTracer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Dim = 16;
+
+// A swirl around the center of the grid with an axial drift
+void Velocity(const double x[3], double v[3])
+{
+  const double c = 0.5 * (Dim - 1);
+  v[0] = -(x[1] - c) + 0.1 * x[2];
+  v[1] = (x[0] - c);
+  v[2] = 0.3 + 0.05 * (x[0] - c);
+}
+
+void AddPointData(vtkDataSet* dataset)
+{
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (vtkIdType i = 0; i < dataset->GetNumberOfPoints(); ++i)
+  {
+    double x[3], v[3];
+    dataset->GetPoint(i, x);
+    Velocity(x, v);
+    velocity->InsertNextTuple(v);
+    scalars->InsertNextValue(x[0] * x[1] - x[2]);
+  }
+  dataset->GetPointData()->SetVectors(velocity);
+  dataset->GetPointData()->AddArray(scalars);
+}
+
+// Hexahedra between the planes z = zBegin and z = zEnd of the grid
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int zBegin, int zEnd)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = zBegin; k <= zEnd; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate((Dim - 1) * (Dim - 1) * (zEnd - zBegin));
+  for (int k = 0; k < zEnd - zBegin; ++k)
+  {
+    for (int j = 0; j < Dim - 1; ++j)
+    {
+      for (int i = 0; i < Dim - 1; ++i)
+      {
+        vtkIdType p = i + Dim * (j + Dim * k);
+        vtkIdType hex[8] = { p, p + 1, p + 1 + Dim, p + Dim, p + Dim * Dim, p + 1 + Dim * Dim,
+          p + 1 + Dim + Dim * Dim, p + Dim + Dim * Dim };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+  AddPointData(grid);
+  return grid;
+}
+
+vtkSmartPointer<vtkImageData> MakeImage()
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(Dim, Dim, Dim);
+  AddPointData(image);
+  return image;
+}
+
+// Random seeds in and around the grid
+vtkSmartPointer<vtkPolyData> MakeSeeds()
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3);
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 200; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetRangeValue(-1.0, Dim);
+    }
+    points->InsertNextPoint(x);
+  }
+  vtkSmartPointer<vtkPolyData> seeds = vtkSmartPointer<vtkPolyData>::New();
+  seeds->SetPoints(points);
+  return seeds;
+}
+
+bool NeverTerminate(void*, vtkPoints*, vtkDataArray*, int)
+{
+  return false;
+}
+
+vtkSmartPointer<vtkPolyData> Trace(vtkDataObject* input, vtkPolyData* seeds, bool cellLocator,
+  bool serial)
+{
+  vtkNew<vtkStreamTracer> tracer;
+  tracer->SetInputData(input);
+  tracer->SetSourceData(seeds);
+  if (cellLocator)
+  {
+    tracer->SetInterpolatorTypeToCellLocator();
+  }
+  vtkNew<vtkRungeKutta45> integrator;
+  tracer->SetIntegrator(integrator);
+  tracer->SetIntegrationDirectionToBoth();
+  tracer->SetMaximumPropagation(60.0);
+  tracer->SetComputeVorticity(true);
+  if (serial)
+  {
+    // the custom termination callbacks are called by the serial integration
+    tracer->AddCustomTerminationCallback(&NeverTerminate, nullptr, 0);
+  }
+  tracer->Update();
+  return tracer->GetOutput();
+}
+
+bool SameArrays(vtkFieldData* data1, vtkFieldData* data2)
+{
+  if (data1->GetNumberOfArrays() != data2->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < data1->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array1 = data1->GetArray(i);
+    vtkDataArray* array2 = data2->GetArray(array1->GetName());
+    if (!array2 || array1->GetNumberOfTuples() != array2->GetNumberOfTuples() ||
+      array1->GetNumberOfComponents() != array2->GetNumberOfComponents())
+    {
+      return false;
+    }
+    for (vtkIdType j = 0; j < array1->GetNumberOfTuples(); ++j)
+    {
+      for (int c = 0; c < array1->GetNumberOfComponents(); ++c)
+      {
+        if (array1->GetComponent(j, c) != array2->GetComponent(j, c))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* output1, vtkPolyData* output2)
+{
+  if (output1->GetNumberOfPoints() != output2->GetNumberOfPoints() ||
+    output1->GetNumberOfLines() != output2->GetNumberOfLines())
+  {
+    std::cerr << "Different number of points or lines" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output1->GetNumberOfPoints(); ++i)
+  {
+    double x1[3], x2[3];
+    output1->GetPoint(i, x1);
+    output2->GetPoint(i, x2);
+    if (x1[0] != x2[0] || x1[1] != x2[1] || x1[2] != x2[2])
+    {
+      std::cerr << "Different point " << i << std::endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> pts1, pts2;
+  for (vtkIdType i = 0; i < output1->GetNumberOfLines(); ++i)
+  {
+    output1->GetLines()->GetCellAtId(i, pts1);
+    output2->GetLines()->GetCellAtId(i, pts2);
+    if (pts1->GetNumberOfIds() != pts2->GetNumberOfIds())
+    {
+      std::cerr << "Different line " << i << std::endl;
+      return false;
+    }
+    for (vtkIdType j = 0; j < pts1->GetNumberOfIds(); ++j)
+    {
+      if (pts1->GetId(j) != pts2->GetId(j))
+      {
+        std::cerr << "Different line " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  if (!SameArrays(output1->GetPointData(), output2->GetPointData()) ||
+    !SameArrays(output1->GetCellData(), output2->GetCellData()))
+  {
+    std::cerr << "Different attributes" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckTracer(vtkDataObject* input, vtkPolyData* seeds, bool cellLocator)
+{
+  vtkSmartPointer<vtkPolyData> output = Trace(input, seeds, cellLocator, false);
+  vtkDataArray* seedIds = output->GetCellData()->GetArray("SeedIds");
+  if (output->GetNumberOfLines() < 100 || !seedIds ||
+    !output->GetPointData()->GetArray("Scalars") || !output->GetPointData()->GetArray("Rotation"))
+  {
+    std::cerr << "Unexpected output" << std::endl;
+    return false;
+  }
+
+  // the streamlines are ordered by seed as in the serial integration
+  vtkSmartPointer<vtkPolyData> serialOutput = Trace(input, seeds, cellLocator, true);
+  if (!SameOutput(output, serialOutput))
+  {
+    std::cerr << "Output differs from the serial integration" << std::endl;
+    return false;
+  }
+
+  vtkSMPTools::Initialize(1);
+  vtkSmartPointer<vtkPolyData> singleThreadOutput = Trace(input, seeds, cellLocator, false);
+  vtkSMPTools::Initialize();
+  if (!SameOutput(output, singleThreadOutput))
+  {
+    std::cerr << "Output differs with a single thread" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestStreamTracerParallel(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> seeds = MakeSeeds();
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(0, Dim - 1);
+  if (!CheckTracer(grid, seeds, true))
+  {
+    std::cerr << "Wrong streamlines in the unstructured grid" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the streamlines go from a block to the other
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(2);
+  blocks->SetBlock(0, MakeGrid(0, Dim / 2));
+  blocks->SetBlock(1, MakeGrid(Dim / 2, Dim - 1));
+  if (!CheckTracer(blocks, seeds, true))
+  {
+    std::cerr << "Wrong streamlines in the multiblock dataset" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkImageData> image = MakeImage();
+  if (!CheckTracer(image, seeds, false))
+  {
+    std::cerr << "Wrong streamlines in the image" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -22,6 +22,7 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
 #include "vtkSmartPointer.h"
 
 #include <vector>
@@ -151,6 +152,49 @@ void vtkCachingInterpolatedVelocityField::SetDataSet(
   this->Weights.assign(maxsize, 0.0);
 }
 //------------------------------------------------------------------------------
+void vtkCachingInterpolatedVelocityField::CopyDataSets(vtkCachingInterpolatedVelocityField* from)
+{
+  this->SetVectorsSelection(from->VectorsSelection);
+  this->ClearLastCellInfo();
+  this->LastCacheIndex = 0;
+  this->CacheList = from->CacheList;
+  for (IVFDataSetInfo& data : this->CacheList)
+  {
+    data.Cell = vtkSmartPointer<vtkGenericCell>::New();
+  }
+  this->Weights.assign(from->Weights.size(), 0.0);
+}
+//------------------------------------------------------------------------------
+bool vtkCachingInterpolatedVelocityField::BuildLocators()
+{
+  bool threadSafe = true;
+  for (IVFDataSetInfo& data : this->CacheList)
+  {
+    if (!data.DataSet)
+    {
+      continue;
+    }
+    if (vtkCellLocator* cellLocator = vtkCellLocator::SafeDownCast(data.BSPTree))
+    {
+      cellLocator->BuildLocatorIfNeeded();
+    }
+    else if (data.BSPTree)
+    {
+      data.BSPTree->BuildLocator();
+    }
+    else
+    {
+      threadSafe &= !vtkPointSet::SafeDownCast(data.DataSet);
+    }
+    // the first call of GetCell() may build internal structures
+    if (data.DataSet->GetNumberOfCells() > 0)
+    {
+      data.DataSet->GetCell(0, this->TempCell);
+    }
+  }
+  return threadSafe;
+}
+//------------------------------------------------------------------------------
 void vtkCachingInterpolatedVelocityField::SetLastCellInfo(vtkIdType c, int datasetindex)
 {
   if ((this->LastCacheIndex != datasetindex) || (this->LastCellId != c))
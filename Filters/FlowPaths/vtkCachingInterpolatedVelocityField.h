@@ -92,6 +92,21 @@ public:
   virtual void SetDataSet(
     int I, vtkDataSet* dataset, bool staticdataset, vtkAbstractCellLocator* locator);
 
+  /**
+   * Copy the datasets and vectors selection of another instance. The datasets,
+   * their cell locators and vectors are shared, but not the cached cells, so
+   * that each thread can evaluate the velocity with its own copy.
+   */
+  void CopyDataSets(vtkCachingInterpolatedVelocityField* from);
+
+  /**
+   * Build the cell locators of the datasets, as the first search would do.
+   * Returns true when the datasets can then be searched concurrently by
+   * copies made with CopyDataSets(): each of them has a cell locator or is not
+   * a vtkPointSet, whose point locator and links are built lazily.
+   */
+  bool BuildLocators();
+
   ///@{
   /**
    * If you want to work with an arbitrary vector array, then set its name
@@ -259,6 +259,43 @@ void vtkCellLocatorInterpolatedVelocityField::AddDataSet(vtkDataSet* dataset)
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkCellLocatorInterpolatedVelocityField::CopyDataSets(
+  vtkCompositeInterpolatedVelocityField* from)
+{
+  vtkCellLocatorInterpolatedVelocityField* fromLocator =
+    vtkCellLocatorInterpolatedVelocityField::SafeDownCast(from);
+  if (!fromLocator)
+  {
+    this->Superclass::CopyDataSets(from);
+    return;
+  }
+
+  for (std::size_t i = 0; i < fromLocator->DataSets->size(); ++i)
+  {
+    vtkDataSet* dataset = (*fromLocator->DataSets)[i];
+    vtkAbstractCellLocator* locator = (*fromLocator->CellLocators)[i];
+    if (!vtkStaticCellLocator::SafeDownCast(locator))
+    {
+      this->AddDataSet(dataset);
+      continue;
+    }
+
+    // build the shared locator now, as its lazy build is not thread safe
+    locator->BuildLocator();
+    this->DataSets->push_back(dataset);
+    this->CellLocators->push_back(locator);
+
+    int size = dataset->GetMaxCellSize();
+    if (size > this->WeightsSize)
+    {
+      this->WeightsSize = size;
+      delete[] this->Weights;
+      this->Weights = new double[size];
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkCellLocatorInterpolatedVelocityField::CopyParameters(
   vtkAbstractInterpolatedVelocityField* from)
@@ -103,6 +103,15 @@ public:
    */
   void AddDataSet(vtkDataSet* dataset) override;
 
+  /**
+   * Add the datasets of another interpolated velocity field. The
+   * vtkStaticCellLocator instances of from, which are thread safe once built,
+   * are built if needed and shared, so that copies of a velocity field made
+   * for several threads search a single locator per dataset. The other cell
+   * locators are instantiated anew with AddDataSet().
+   */
+  void CopyDataSets(vtkCompositeInterpolatedVelocityField* from) override;
+
   using Superclass::FunctionValues;
   /**
    * Evaluate the velocity field f at point (x, y, z).
@@ -35,6 +35,28 @@ vtkCompositeInterpolatedVelocityField::~vtkCompositeInterpolatedVelocityField()
   this->DataSets = nullptr;
 }
 
+//------------------------------------------------------------------------------
+void vtkCompositeInterpolatedVelocityField::CopyDataSets(
+  vtkCompositeInterpolatedVelocityField* from)
+{
+  for (vtkDataSet* dataset : *from->DataSets)
+  {
+    this->AddDataSet(dataset);
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkCompositeInterpolatedVelocityField::GetNumberOfDataSets()
+{
+  return static_cast<int>(this->DataSets->size());
+}
+
+//------------------------------------------------------------------------------
+vtkDataSet* vtkCompositeInterpolatedVelocityField::GetDataSet(int dataindex)
+{
+  return (*this->DataSets)[dataindex];
+}
+
 //------------------------------------------------------------------------------
 void vtkCompositeInterpolatedVelocityField::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -59,6 +59,22 @@ public:
    */
   virtual void AddDataSet(vtkDataSet* dataset) = 0;
 
+  /**
+   * Add the datasets of another composite interpolated velocity field, as
+   * done to make one copy of a velocity field per thread. The default
+   * implementation calls AddDataSet() for each dataset. Subclasses may share
+   * the search structures of from instead of building new ones.
+   */
+  virtual void CopyDataSets(vtkCompositeInterpolatedVelocityField* from);
+
+  ///@{
+  /**
+   * Get the number of datasets added and one of them.
+   */
+  int GetNumberOfDataSets();
+  vtkDataSet* GetDataSet(int dataindex);
+  ///@}
+
   ///@{
   /**
    * Get the most recently visited dataset and its id. The dataset is used
@@ -18,8 +18,10 @@
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <stack>
 #include <vector>
@@ -84,7 +86,7 @@ public:
 
 typedef cell_extents* cell_extents_List;
 
-static int global_list_count = 0;
+static std::atomic<int> global_list_count(0);
 
 class Sorted_cell_extents_Lists
 {
@@ -112,33 +114,31 @@ public:
   }
 };
 
-extern "C" int _compareMin(const void* pA, const void* B)
+// A node whose subtree remains to be built, and the statistics of a subtree
+class BSP_subtree
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->min == tB->min)
-  {
-    return 0;
-  }
-  else
+public:
+  BSPNode* node;
+  Sorted_cell_extents_Lists* lists;
+  vtkIdType nCells;
+  int npn, nln, tot_depth, MaxDepth;
+  //
+  BSP_subtree(BSPNode* n, Sorted_cell_extents_Lists* l, vtkIdType c)
+    : node(n)
+    , lists(l)
+    , nCells(c)
+    , npn(0)
+    , nln(0)
+    , tot_depth(0)
+    , MaxDepth(0)
   {
-    return tA->min < tB->min ? -1 : 1;
   }
-}
+};
 
-extern "C" int _compareMax(const void* pA, const void* B)
-{
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->max == tB->max)
-  {
-    return 0;
-  }
-  else
-  {
-    return tA->max > tB->max ? -1 : 1;
-  }
-}
+// The nodes of fewer cells are the roots of subtrees built concurrently,
+// the larger ones are divided one at a time, with their lists partitioned
+// in parallel.
+static const vtkIdType BSP_parallel_cells = 32768;
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -202,7 +202,7 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 
   // create the root node
   this->mRoot = new BSPNode();
-  this->mRoot->mAxis = rand() % 3;
+  this->mRoot->mAxis = 0;
   this->mRoot->depth = 0;
   //
   if (numCells == 0)
@@ -216,19 +216,23 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   Sorted_cell_extents_Lists* lists = new Sorted_cell_extents_Lists(numCells);
   for (int i = 0; i < 3; i++)
   { // loop over each axis
-    for (vtkIdType j = 0; j < numCells; j++)
-    {                                                   // loop over each cell
-      lists->Mins[i][j].min = CellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max = CellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min = CellBounds[j][i * 2];
-      lists->Maxs[i][j].max = CellBounds[j][i * 2 + 1];
-      lists->Maxs[i][j].cell_ID = j;
-    }
-    // Sort
-    qsort(lists->Mins[i], numCells, sizeof(cell_extents), _compareMin);
-    qsort(lists->Maxs[i], numCells, sizeof(cell_extents), _compareMax);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType j = begin; j < end; j++)
+      {                                                   // loop over each cell
+        lists->Mins[i][j].min = CellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
+        lists->Mins[i][j].max = CellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
+        lists->Mins[i][j].cell_ID = j;
+        //
+        lists->Maxs[i][j].min = CellBounds[j][i * 2];
+        lists->Maxs[i][j].max = CellBounds[j][i * 2 + 1];
+        lists->Maxs[i][j].cell_ID = j;
+      }
+    });
+    // Sort, the cells of equal extents remaining in increasing order
+    vtkSMPTools::StableSort(lists->Mins[i], lists->Mins[i] + numCells,
+      [](const cell_extents& a, const cell_extents& b) { return a.min < b.min; });
+    vtkSMPTools::StableSort(lists->Maxs[i], lists->Maxs[i] + numCells,
+      [](const cell_extents& a, const cell_extents& b) { return a.max > b.max; });
   }
   //
   // call the recursive subdivision routine
@@ -256,19 +260,107 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 //
 // The main BSP subdivision routine : The code which does the division is only
 // a small part of this, the rest is just bookkeeping - it looks worse than it is.
+// The large nodes are divided first, then the subtrees of the small ones are
+// built concurrently.
 //
 void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists,
-  vtkDataSet* dataset, vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int& MaxDepth)
+  vtkDataSet* vtkNotUsed(dataset), vtkIdType nCells, int vtkNotUsed(depth), int maxlevel,
+  vtkIdType maxCells, int& MaxDepth)
+{
+  //
+  // Divide a node, pushing its children and updating the statistics.
+  // The lists of the children are deleted once they are divided.
+  auto divide = [&](const BSP_subtree& sub, std::vector<BSP_subtree>& pending,
+                  BSP_subtree& stats) {
+    if (sub.node->depth > stats.MaxDepth)
+    {
+      stats.MaxDepth = sub.node->depth;
+    }
+    Sorted_cell_extents_Lists* childLists[3];
+    vtkIdType childCells[3];
+    if (this->DivideNode(sub.node, sub.lists, sub.nCells, maxlevel, maxCells, childLists,
+          childCells))
+    {
+      stats.npn += 1; // Parent node
+      for (int i = 2; i >= 0; i--)
+      {
+        if (childLists[i])
+        {
+          pending.push_back(BSP_subtree(sub.node->mChild[i], childLists[i], childCells[i]));
+        }
+      }
+    }
+    else
+    {
+      stats.nln += 1; // Leaf node
+      stats.tot_depth += sub.node->depth;
+    }
+    if (sub.lists != lists)
+    {
+      delete sub.lists;
+    }
+  };
+  //
+  BSP_subtree stats(node, lists, nCells);
+  std::vector<BSP_subtree> large(1, stats);
+  std::vector<BSP_subtree> subtrees;
+  while (!large.empty())
+  {
+    BSP_subtree sub = large.back();
+    large.pop_back();
+    if (sub.nCells < BSP_parallel_cells)
+    {
+      subtrees.push_back(sub);
+    }
+    else
+    {
+      divide(sub, large, stats);
+    }
+  }
+  //
+  // the subtrees do not share any cell list
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+    [&](vtkIdType first, vtkIdType last) {
+      std::vector<BSP_subtree> pending;
+      for (; first < last; first++)
+      {
+        BSP_subtree& subtree = subtrees[first];
+        pending.push_back(subtree);
+        while (!pending.empty())
+        {
+          BSP_subtree sub = pending.back();
+          pending.pop_back();
+          divide(sub, pending, subtree);
+        }
+      }
+    });
+  //
+  for (const BSP_subtree& subtree : subtrees)
+  {
+    stats.npn += subtree.npn;
+    stats.nln += subtree.nln;
+    stats.tot_depth += subtree.tot_depth;
+    stats.MaxDepth = std::max(stats.MaxDepth, subtree.MaxDepth);
+  }
+  npn += stats.npn;
+  nln += stats.nln;
+  tot_depth += stats.tot_depth;
+  MaxDepth = std::max(MaxDepth, stats.MaxDepth);
+}
+
+//------------------------------------------------------------------------------
+//
+// Find the division plane of a node and partition its sorted lists into the
+// lists of its children, or make it a leaf.
+//
+bool vtkModifiedBSPTree::DivideNode(BSPNode* node, Sorted_cell_extents_Lists* lists,
+  vtkIdType nCells, int maxlevel, vtkIdType maxCells, Sorted_cell_extents_Lists* childLists[3],
+  vtkIdType childCells[3])
 {
   //
   // We've got lists sorted on the axes, so we can easily get BBox
   node->setMin(lists->Mins[0][0].min, lists->Mins[1][0].min, lists->Mins[2][0].min);
   node->setMax(lists->Maxs[0][0].max, lists->Maxs[1][0].max, lists->Maxs[2][0].max);
-  // Update depth info
-  if (node->depth > MaxDepth)
-  {
-    MaxDepth = depth;
-  }
   //
   // Make sure child nodes are clear to start with
   node->mChild[2] = node->mChild[1] = node->mChild[0] = nullptr;
@@ -276,10 +368,11 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
   // Do we want to subdivide this node ?
   //
   double pDiv = 0.0;
-  if ((nCells > maxCells) && (depth < maxlevel))
+  bool found = false;
+  if ((nCells > maxCells) && (node->depth < maxlevel))
   {
     // test for optimal subdivision
-    bool found = false, abort = false;
+    bool abort = false;
     int Daxis;
     vtkIdType TargetCount = (3 * nCells) / 4;
     //
@@ -312,190 +405,67 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
         }
       }
     }
-    // construct the 3 children
-    if (found)
+  }
+  if (found)
+  {
+    // The child of a cell : 0 when its max is on left of middle node,
+    // 2 when its min is on right of middle node, or 1
+    const double(*cellBounds)[6] = this->CellBounds;
+    const int Daxis = node->mAxis;
+    auto child = [cellBounds, Daxis, pDiv](const cell_extents& ext) {
+      return cellBounds[ext.cell_ID][2 * Daxis + 1] < pDiv
+        ? 0
+        : (cellBounds[ext.cell_ID][2 * Daxis] > pDiv ? 2 : 1);
+    };
+    // All the lists hold the same cells, so the children sizes are counted once
+    const bool parallel = nCells >= BSP_parallel_cells;
+    childCells[0] = childCells[1] = childCells[2] = 0;
+    for (vtkIdType i = 0; i < nCells; i++)
+    {
+      childCells[child(lists->Mins[Daxis][i])]++;
+    }
+    //
+    // Bug : Can sometimes get unbalanced leaves
+    //
+    if (childCells[0] && childCells[2])
     {
       for (int i = 0; i < 3; i++)
       {
-        node->mChild[i] = new BSPNode();
-        node->mChild[i]->depth = node->depth + 1;
-        node->mChild[i]->mAxis = rand() % 3;
-      }
-      Daxis = node->mAxis;
-      Sorted_cell_extents_Lists* left = new Sorted_cell_extents_Lists(nCells);
-      Sorted_cell_extents_Lists* mid = new Sorted_cell_extents_Lists(nCells);
-      Sorted_cell_extents_Lists* right = new Sorted_cell_extents_Lists(nCells);
-      // we ought to keep track of how many we are adding to each list
-      vtkIdType Cmin_l[3] = { 0, 0, 0 }, Cmin_m[3] = { 0, 0, 0 }, Cmin_r[3] = { 0, 0, 0 };
-      vtkIdType Cmax_l[3] = { 0, 0, 0 }, Cmax_m[3] = { 0, 0, 0 }, Cmax_r[3] = { 0, 0, 0 };
-      // Partition the cells into the correct child lists
-      // here we use the lists for the axis we're dividing along
-      for (vtkIdType i = 0; i < nCells; i++)
-      {
-        // process the MIN-List
-        cell_extents ext = lists->Mins[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
+        childLists[i] = nullptr;
+        if (childCells[i])
         {
-          left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-        }
-        //
-        // process the MAX-List
-        ext = lists->Maxs[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
-        {
-          left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
+          childLists[i] = new Sorted_cell_extents_Lists(childCells[i]);
+          node->mChild[i] = new BSPNode();
+          node->mChild[i]->depth = node->depth + 1;
+          node->mChild[i]->mAxis = (Daxis + 1 + i) % 3;
         }
       }
-      // construct the sorted list of extents for the 2 remaining axes
-      // do everything in order so our sorted lists aren't munged
-      for (Daxis = (node->mAxis + 1) % 3; Daxis != node->mAxis; Daxis = (Daxis + 1) % 3)
-      {
-        for (vtkIdType i = 0; i < nCells; i++)
+      // Partition each of the 6 lists into the child lists, where they
+      // remain sorted
+      auto partition = [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType l = first; l < last; l++)
         {
-          // process the MIN-List
-          cell_extents ext = lists->Mins[Daxis][i];
-          if (this->CellBounds[ext.cell_ID][2 * node->mAxis + 1] < pDiv)
-          {
-            left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-          }
-          else if (this->CellBounds[ext.cell_ID][2 * node->mAxis] > pDiv)
+          const int axis = static_cast<int>(l / 2);
+          const bool maxs = (l % 2) != 0;
+          const cell_extents_List in = maxs ? lists->Maxs[axis] : lists->Mins[axis];
+          vtkIdType counts[3] = { 0, 0, 0 };
+          for (vtkIdType i = 0; i < nCells; i++)
           {
-            right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-          }
-          else
-          {
-            mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-          }
-          //
-          // process the MAX-List
-          ext = lists->Maxs[Daxis][i];
-          if (this->CellBounds[ext.cell_ID][2 * node->mAxis + 1] < pDiv)
-          {
-            left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-          }
-          else if (this->CellBounds[ext.cell_ID][2 * node->mAxis] > pDiv)
-          {
-            right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-          }
-          else
-          {
-            mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
+            const int c = child(in[i]);
+            cell_extents_List out = maxs ? childLists[c]->Maxs[axis] : childLists[c]->Mins[axis];
+            out[counts[c]++] = in[i];
           }
         }
-      }
-      //
-      // Better check we didn't make a diddly
-      // this is overkill but for now I want a FULL DEBUG!
-      if ((Cmin_l[0] + Cmin_r[0] + Cmin_m[0]) != nCells)
-      {
-        vtkWarningMacro("Error count in min lists");
-      }
-      if ((Cmin_l[1] + Cmin_r[1] + Cmin_m[1]) != nCells)
-      {
-        vtkWarningMacro("Error count in min lists");
-      }
-      if ((Cmin_l[2] + Cmin_r[2] + Cmin_m[2]) != nCells)
-      {
-        vtkWarningMacro("Error count in min lists");
-      }
-      if ((Cmax_l[0] + Cmax_r[0] + Cmax_m[0]) != nCells)
+      };
+      if (parallel)
       {
-        vtkWarningMacro("Error count in max lists");
-      }
-      if ((Cmax_l[1] + Cmax_r[1] + Cmax_m[1]) != nCells)
-      {
-        vtkWarningMacro("Error count in max lists");
-      }
-      if ((Cmax_l[2] + Cmax_r[2] + Cmax_m[2]) != nCells)
-      {
-        vtkWarningMacro("Error count in max lists");
-      }
-      //
-      // Bug : Can sometimes get unbalanced leaves
-      //
-      if (!Cmin_l[0] || !Cmin_r[0])
-      {
-        // vtkDebugMacro(<<"Child 0 or 2 empty : Aborting subdivision for node " << Cmin_l[0] << " "
-        // << Cmin_m[0] << " " << Cmin_r[0]); clean up all the memory we allocated. Yikes.
-        for (int i = 0; i < 3; i++)
-        {
-          delete node->mChild[i];
-          node->mChild[i] = nullptr;
-        }
-        delete left;
-        delete mid;
-        delete right;
+        vtkSMPTools::For(0, 6, 1, partition);
       }
       else
       {
-        //
-        // Now we can delete the lists that the parent passed on to us
-        //
-        //
-        // And of course, we really ought to subdivide again - Hoorah!
-        // NB: it is possible for a node to be empty now, so check and delete if necessary
-        if (Cmin_l[0])
-        {
-          Subdivide(
-            node->mChild[0], left, dataset, Cmin_l[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
-        {
-          vtkWarningMacro(<< "Child 0 Empty ! - this shouldn't happen");
-        }
-        delete left;
-
-        if (Cmin_m[0])
-        {
-          Subdivide(
-            node->mChild[1], mid, dataset, Cmin_m[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
-        {
-          delete node->mChild[1];
-          node->mChild[1] = nullptr;
-        }
-        delete mid;
-
-        if (Cmin_r[0])
-        {
-          Subdivide(
-            node->mChild[2], right, dataset, Cmin_r[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
-        {
-          vtkWarningMacro(<< "Child 2 Empty ! - this shouldn't happen");
-        }
-        delete right;
-        //
-        npn += 1; // Parent node
-        //
-        // we've done all we were asked to do
-        //
-        return;
+        partition(0, 6);
       }
+      return true;
     }
   }
   // if we got here, either no further subdivision is necessary,
@@ -503,8 +473,6 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
   //
   // Copy the cell IDs into the actual node structure for proper use
   node->num_cells = nCells;
-  nln += 1; // Leaf node
-  tot_depth += node->depth;
   for (int i = 0; i < 6; i++)
   {
     node->sorted_cell_lists[i] = new vtkIdType[nCells];
@@ -519,6 +487,7 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
     }
   }
   // Thank buggery that's all over.
+  return false;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -15,6 +15,7 @@
 #include "vtkParticleTracerBase.h"
 
 #include "vtkAbstractParticleWriter.h"
+#include "vtkBitArray.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
@@ -22,17 +23,21 @@
 #include "vtkExecutive.h"
 #include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSignedCharArray.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -41,6 +46,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <numeric>
 #ifdef DEBUGPARTICLETRACE
 #define Assert(x) assert(x)
 #define PRINT(x) cout << __LINE__ << ": " << x << endl;
@@ -99,6 +105,78 @@ inline int FindInterval(double a, const std::vector<double>& A)
 
   return -1;
 }
+
+// How the integration of a particle over a time step ended
+enum ParticleStatus
+{
+  PARTICLE_SKIPPED, // not integrated, the execution was aborted
+  PARTICLE_LOST,    // the integration failed, even with a push
+  PARTICLE_OUTSIDE, // the particle ended outside of the datasets
+  PARTICLE_MOVED,   // the particle ended inside the datasets
+  PARTICLE_UNMOVED  // the particle was at the target time already
+};
+
+// The integration of a particle over a time step, resolved once all the
+// particles of a pass are integrated
+struct ParticleStep
+{
+  ParticleListIterator It;
+  ParticleInformation Previous;
+  int Status;
+  double Velocity[3];
+  vtkIdType CachedCellId[2];
+  int CachedDataSetId[2];
+};
+
+// The objects a thread traces particles with: a copy of the interpolator
+// sharing its datasets and cell locators, an integrator evaluating it, and
+// the vectors of a cell to compute the vorticity.
+struct ParticleTracerLocal
+{
+  vtkSmartPointer<vtkTemporalInterpolatedVelocityField> Interpolator;
+  vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+  vtkSmartPointer<vtkDoubleArray> CellVectors;
+
+  void Initialize(
+    vtkTemporalInterpolatedVelocityField* interpolator, vtkInitialValueProblemSolver* integrator)
+  {
+    this->Interpolator = vtkSmartPointer<vtkTemporalInterpolatedVelocityField>::New();
+    this->Interpolator->CopyDataSets(interpolator);
+    if (integrator)
+    {
+      this->Integrator.TakeReference(integrator->NewInstance());
+      this->Integrator->SetFunctionSet(this->Interpolator);
+    }
+    this->CellVectors = vtkSmartPointer<vtkDoubleArray>::New();
+    this->CellVectors->SetNumberOfComponents(3);
+    this->CellVectors->Allocate(3 * VTK_CELL_SIZE);
+  }
+};
+
+// Extend an array to numTuples tuples, keeping its values, so that the new
+// tuples can be set by index
+void ExtendArray(vtkAbstractArray* array, vtkIdType numTuples)
+{
+  if (numTuples * array->GetNumberOfComponents() > array->GetSize())
+  {
+    array->Resize(numTuples);
+  }
+  array->SetNumberOfTuples(numTuples);
+}
+
+// Process the particles [0, n) with vtkSMPTools, or serially
+template <typename FunctorT>
+void ForEachParticle(vtkIdType n, vtkIdType grain, bool parallel, FunctorT& functor)
+{
+  if (parallel)
+  {
+    vtkSMPTools::For(0, n, grain, functor);
+  }
+  else
+  {
+    functor(0, n);
+  }
+}
 };
 
 //------------------------------------------------------------------------------
@@ -134,6 +212,8 @@ vtkParticleTracerBase::vtkParticleTracerBase()
   this->IntegrationStep = 0.5;
 
   this->Interpolator = vtkSmartPointer<vtkTemporalInterpolatedVelocityField>::New();
+  this->ParallelInterpolation = false;
+  this->NumberOfInterpolatedArrays = 0;
   this->SetNumberOfInputPorts(2);
 
 #ifdef JB_H5PART_PARTICLE_OUTPUT
@@ -605,30 +685,47 @@ void vtkParticleTracerBase::TestParticles(
 void vtkParticleTracerBase::TestParticles(
   vtkParticleTracerBaseNamespace::ParticleVector& candidates, std::vector<int>& passed)
 {
-  int i = 0;
-  for (ParticleIterator it = candidates.begin(); it != candidates.end(); ++it, ++i)
-  {
-    ParticleInformation& info = (*it);
-    double* pos = &info.CurrentPosition.x[0];
-    // if outside bounds, reject instantly
-    if (this->InsideBounds(pos))
+  // test the particles concurrently, then keep the ones inside in order
+  std::vector<unsigned char> inside(candidates.size(), 0);
+  vtkSMPThreadLocal<ParticleTracerLocal> tlLocal;
+  auto testParticles = [&](vtkIdType begin, vtkIdType end) {
+    ParticleTracerLocal& local = tlLocal.Local();
+    if (!local.Interpolator)
     {
-      // since this is first test, avoid bad cache tests
-      this->Interpolator->ClearCache();
-      info.LocationState = this->Interpolator->TestPoint(pos);
-      if (info.LocationState == ID_OUTSIDE_ALL /*|| location==ID_OUTSIDE_T0*/)
-      {
-        // can't really use this particle.
-        vtkDebugMacro(<< "TestParticles rejected particle");
-      }
-      else
+      local.Initialize(this->Interpolator, nullptr);
+    }
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      ParticleInformation& info = candidates[i];
+      double* pos = &info.CurrentPosition.x[0];
+      // if outside bounds, reject instantly
+      if (this->InsideBounds(pos))
       {
-        // get the cached ids and datasets from the TestPoint call
-        this->Interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
-        passed.push_back(i);
+        // since this is first test, avoid bad cache tests
+        local.Interpolator->ClearCache();
+        info.LocationState = local.Interpolator->TestPoint(pos);
+        if (info.LocationState != ID_OUTSIDE_ALL /*&& location!=ID_OUTSIDE_T0*/)
+        {
+          // get the cached ids and datasets from the TestPoint call
+          local.Interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+          inside[i] = 1;
+        }
       }
     }
+  };
+  ForEachParticle(
+    static_cast<vtkIdType>(candidates.size()), 0, this->ParallelInterpolation, testParticles);
+
+  for (size_t i = 0; i < inside.size(); i++)
+  {
+    if (inside[i])
+    {
+      passed.push_back(static_cast<int>(i));
+    }
   }
+  vtkDebugMacro(<< "TestParticles rejected "
+                << std::count(inside.begin(), inside.end(), static_cast<unsigned char>(0))
+                << " particles");
 }
 
 //------------------------------------------------------------------------------
@@ -758,6 +855,9 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
     vtkErrorMacro(<< "InitializeInterpolator failed");
     return output;
   }
+  // Build the cell locators before the copies of the interpolator used by
+  // the threads share them.
+  this->ParallelInterpolation = this->Interpolator->BuildLocators();
 
   vtkDebugMacro(<< "About to allocate point arrays ");
   this->ParticleAge = vtkSmartPointer<vtkFloatArray>::New();
@@ -769,7 +869,6 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
   this->ParticleVorticity = vtkSmartPointer<vtkFloatArray>::New();
   this->ParticleRotation = vtkSmartPointer<vtkFloatArray>::New();
   this->ParticleAngularVel = vtkSmartPointer<vtkFloatArray>::New();
-  this->CellVectors = vtkSmartPointer<vtkDoubleArray>::New();
   this->ParticleCells = vtkSmartPointer<vtkCellArray>::New();
   this->OutputCoordinates = vtkSmartPointer<vtkPoints>::New();
 
@@ -777,6 +876,7 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
   this->OutputPointData->Initialize();
   vtkDebugMacro(<< "About to Interpolate allocate space");
   this->OutputPointData->InterpolateAllocate(this->DataReferenceT[0]->GetPointData());
+  this->NumberOfInterpolatedArrays = this->OutputPointData->GetNumberOfArrays();
   this->ParticleAge->SetName("ParticleAge");
   this->ParticleIds->SetName("ParticleId");
   this->ParticleSourceIds->SetName("ParticleSourceId");
@@ -786,8 +886,6 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
 
   if (this->ComputeVorticity)
   {
-    this->CellVectors->SetNumberOfComponents(3);
-    this->CellVectors->Allocate(3 * VTK_CELL_SIZE);
     this->ParticleVorticity->SetName("Vorticity");
     this->ParticleRotation->SetName("Rotation");
     this->ParticleAngularVel->SetName("AngularVelocity");
@@ -804,13 +902,6 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
   std::vector<vtkDataSet*> seedSources =
     this->GetSeedSources(inputVector[1], this->CurrentTimeStep);
 
-  //
-  // Setup some variables
-  //
-  vtkSmartPointer<vtkInitialValueProblemSolver> integrator;
-  integrator.TakeReference(this->GetIntegrator()->NewInstance());
-  integrator->SetFunctionSet(this->Interpolator);
-
   //
   // Make sure the Particle Positions are initialized with Seed particles
   //
@@ -843,22 +934,18 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
 
   if (this->CurrentTimeStep == this->StartTimeStep) // just add all the particles
   {
+    std::vector<ParticleInformation*> particles;
     for (ParticleListIterator itr = this->ParticleHistories.begin();
          itr != this->ParticleHistories.end(); itr++)
     {
-      ParticleInformation& info(*itr);
-      this->Interpolator->TestPoint(info.CurrentPosition.x);
-      double velocity[3];
-      this->Interpolator->GetLastGoodVelocity(velocity);
-      info.speed = vtkMath::Norm(velocity);
-      this->AddParticle(*itr, velocity);
+      particles.push_back(&(*itr));
     }
+    this->AddParticles(particles, nullptr);
   }
   else
   {
     ParticleListIterator it_first = this->ParticleHistories.begin();
     ParticleListIterator it_last = this->ParticleHistories.end();
-    ParticleListIterator it_next;
 
     //
     // Perform multiple passes. The number of passes is equal to one more than
@@ -869,19 +956,7 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
     {
       vtkDebugMacro(<< "Begin Pass " << pass << " with " << this->ParticleHistories.size()
                     << " Particles");
-      for (ParticleListIterator it = it_first; it != it_last;)
-      {
-        // Keep the 'next' iterator handy because if a particle is terminated
-        // or leaves the domain, the 'current' iterator will be deleted.
-        it_next = it;
-        it_next++;
-        this->IntegrateParticle(it, from, this->CurrentTimeValue, integrator);
-        if (this->GetAbortExecute())
-        {
-          break;
-        }
-        it = it_next;
-      }
+      this->IntegrateParticles(it_first, it_last, from, this->CurrentTimeValue);
       // Particles might have been deleted during the first pass as they move
       // out of domain or age. Before adding any new particles that are sent
       // to us, we must know the starting point ready for the next pass
@@ -943,16 +1018,24 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
       itr = this->ParticleHistories.begin();
     }
 
+    std::vector<ParticleInformation*> particles;
     for (; itr != this->ParticleHistories.end(); ++itr)
     {
-      this->Interpolator->TestPoint(itr->CurrentPosition.x);
-      double velocity[3];
-      this->Interpolator->GetLastGoodVelocity(velocity);
-      itr->speed = vtkMath::Norm(velocity);
-      this->AddParticle(*itr, velocity);
+      particles.push_back(&(*itr));
     }
+    this->AddParticles(particles, nullptr);
   }
 
+  // a vertex for each particle
+  vtkIdType numParticles = this->OutputCoordinates->GetNumberOfPoints();
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numParticles + 1);
+  std::iota(offsets->GetPointer(0), offsets->GetPointer(0) + numParticles + 1, 0);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numParticles);
+  std::iota(connectivity->GetPointer(0), connectivity->GetPointer(0) + numParticles, 0);
+  this->ParticleCells->SetData(offsets, connectivity);
+
   this->OutputPointData->AddArray(this->ParticleIds);
   this->OutputPointData->AddArray(this->ParticleSourceIds);
   this->OutputPointData->AddArray(this->InjectedPointIds);
@@ -1066,170 +1149,179 @@ int vtkParticleTracerBase::RequestData(
 //------------------------------------------------------------------------------
 void vtkParticleTracerBase::IntegrateParticle(ParticleListIterator& it, double currenttime,
   double targettime, vtkInitialValueProblemSolver* integrator)
+{
+  ParticleInformation previous = (*it);
+  double velocity[3];
+  int status = this->AdvanceParticle(
+    *it, currenttime, targettime, this->Interpolator, integrator, velocity);
+  vtkIdType cachedCellId[2];
+  int cachedDataSetId[2];
+  this->Interpolator->GetCachedCellIds(cachedCellId, cachedDataSetId);
+  if (this->ResolveParticle(it, previous, status, velocity, cachedCellId, cachedDataSetId))
+  {
+    this->AddParticle(*it, velocity);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkParticleTracerBase::IntegrateParticles(ParticleListIterator it_first,
+  ParticleListIterator it_last, double currenttime, double targettime)
+{
+  std::vector<ParticleStep> steps;
+  for (ParticleListIterator it = it_first; it != it_last; ++it)
+  {
+    ParticleStep step;
+    step.It = it;
+    step.Status = PARTICLE_SKIPPED;
+    steps.push_back(step);
+  }
+
+  // Integrate the particles one at a time, as their cost varies, with the
+  // interpolator and integrator of each thread.
+  vtkSMPThreadLocal<ParticleTracerLocal> tlLocal;
+  auto integrateParticles = [&](vtkIdType begin, vtkIdType end) {
+    ParticleTracerLocal& local = tlLocal.Local();
+    if (!local.Interpolator)
+    {
+      local.Initialize(this->Interpolator, this->GetIntegrator());
+    }
+    for (vtkIdType i = begin; i < end && !this->GetAbortExecute(); ++i)
+    {
+      ParticleStep& step = steps[i];
+      step.Previous = *step.It;
+      step.Status = this->AdvanceParticle(
+        *step.It, currenttime, targettime, local.Interpolator, local.Integrator, step.Velocity);
+      local.Interpolator->GetCachedCellIds(step.CachedCellId, step.CachedDataSetId);
+    }
+  };
+  ForEachParticle(
+    static_cast<vtkIdType>(steps.size()), 1, this->ParallelInterpolation, integrateParticles);
+
+  // Remove the particles or send them to other processes in the order of
+  // the list, then add the remaining ones to the output.
+  std::vector<ParticleInformation*> particles;
+  std::vector<double> velocities;
+  for (ParticleStep& step : steps)
+  {
+    if (step.Status != PARTICLE_SKIPPED &&
+      this->ResolveParticle(step.It, step.Previous, step.Status, step.Velocity, step.CachedCellId,
+        step.CachedDataSetId))
+    {
+      particles.push_back(&(*step.It));
+      velocities.insert(velocities.end(), step.Velocity, step.Velocity + 3);
+    }
+  }
+  this->AddParticles(particles, velocities.data());
+}
+
+//------------------------------------------------------------------------------
+int vtkParticleTracerBase::AdvanceParticle(ParticleInformation& info, double currenttime,
+  double targettime, vtkTemporalInterpolatedVelocityField* interpolator,
+  vtkInitialValueProblemSolver* integrator, double velocity[3])
 {
   double epsilon = (targettime - currenttime) / 100.0;
-  double velocity[3], point1[4], point2[4] = { 0.0, 0.0, 0.0, 0.0 };
+  double point1[4], point2[4] = { 0.0, 0.0, 0.0, 0.0 };
   double minStep = 0, maxStep = 0;
   double stepWanted, stepTaken = 0.0;
   int substeps = 0;
 
-  ParticleInformation& info = (*it);
-  ParticleInformation previous = (*it);
-  bool particle_good = true;
-
   info.ErrorCode = 0;
+  velocity[0] = velocity[1] = velocity[2] = 0.0;
 
   // Get the Initial point {x,y,z,t}
   memcpy(point1, &info.CurrentPosition, sizeof(Position));
 
-  if (currenttime == targettime)
+  //
+  // begin interpolation between available time values, if the particle has
+  // a cached cell ID and dataset - try to use it,
+  //
+  if (this->AllFixedGeometry)
   {
-    Assert(point1[3] == currenttime);
+    interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
   }
   else
   {
-    Assert(point1[3] >= (currenttime - epsilon) && point1[3] <= (targettime + epsilon));
+    interpolator->ClearCache();
+  }
 
+  if (currenttime == targettime)
+  {
+    Assert(point1[3] == currenttime);
+    interpolator->TestPoint(point1);
+    interpolator->GetLastGoodVelocity(velocity);
+    return PARTICLE_UNMOVED;
+  }
+
+  Assert(point1[3] >= (currenttime - epsilon) && point1[3] <= (targettime + epsilon));
+
+  double delT = (targettime - currenttime) * this->IntegrationStep;
+  epsilon = delT * 1E-3;
+
+  while (point1[3] < (targettime - epsilon))
+  {
     //
-    // begin interpolation between available time values, if the particle has
-    // a cached cell ID and dataset - try to use it,
+    // Here beginneth the real work
     //
-    if (this->AllFixedGeometry)
-    {
-      this->Interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
-    }
-    else
+    double error = 0;
+
+    // If, with the next step, propagation will be larger than
+    // max, reduce it so that it is (approximately) equal to max.
+    stepWanted = delT;
+    if ((point1[3] + stepWanted) > targettime)
     {
-      this->Interpolator->ClearCache();
+      stepWanted = targettime - point1[3];
+      maxStep = stepWanted;
     }
 
-    double delT = (targettime - currenttime) * this->IntegrationStep;
-    epsilon = delT * 1E-3;
-
-    while (point1[3] < (targettime - epsilon))
+    // Calculate the next step using the integrator provided.
+    // If the next point is out of bounds, send it to another process
+    if (integrator->ComputeNextStep(point1, point2, point1[3], stepWanted, stepTaken, minStep,
+          maxStep, this->MaximumError, error) != 0)
     {
-      //
-      // Here beginneth the real work
-      //
-      double error = 0;
-
-      // If, with the next step, propagation will be larger than
-      // max, reduce it so that it is (approximately) equal to max.
-      stepWanted = delT;
-      if ((point1[3] + stepWanted) > targettime)
+      info.ErrorCode = 1;
+      if (!this->RetryWithPush(info, point1, delT, substeps, interpolator))
       {
-        stepWanted = targettime - point1[3];
-        maxStep = stepWanted;
-      }
-
-      // Calculate the next step using the integrator provided.
-      // If the next point is out of bounds, send it to another process
-      if (integrator->ComputeNextStep(point1, point2, point1[3], stepWanted, stepTaken, minStep,
-            maxStep, this->MaximumError, error) != 0)
-      {
-        // if the particle is sent, remove it from the list
-        info.ErrorCode = 1;
-        if (!this->RetryWithPush(info, point1, delT, substeps))
-        {
-          if (previous.PointId < 0 && previous.TailPointId < 0)
-          {
-            vtkErrorMacro("the particle should have been added");
-          }
-          else
-          {
-            this->SendParticleToAnotherProcess(info, previous, this->ParticlePointData);
-          }
-          this->ParticleHistories.erase(it);
-          particle_good = false;
-          break;
-        }
-        else
-        {
-          // particle was not sent, retry saved it, so copy info back
-          substeps++;
-          memcpy(point1, &info.CurrentPosition, sizeof(Position));
-        }
-      }
-      else // success, increment position/time
-      {
-        substeps++;
-
-        // increment the particle time
-        point2[3] = point1[3] + stepTaken;
-        info.age += stepTaken;
-        info.SimulationTime += stepTaken;
-
-        // Point is valid. Insert it.
-        memcpy(&info.CurrentPosition, point2, sizeof(Position));
-        memcpy(point1, point2, sizeof(Position));
-      }
-
-      // If the solver is adaptive and the next time step (delT.Interval)
-      // that the solver wants to use is smaller than minStep or larger
-      // than maxStep, re-adjust it. This has to be done every step
-      // because minStep and maxStep can change depending on the Cell
-      // size (unless it is specified in time units)
-      if (integrator->IsAdaptive())
-      {
-        // code removed. Put it back when this is stable
+        return PARTICLE_LOST;
       }
+      // particle was not sent, retry saved it, so copy info back
+      substeps++;
+      memcpy(point1, &info.CurrentPosition, sizeof(Position));
     }
-
-    if (particle_good)
+    else // success, increment position/time
     {
-      // The integration succeeded, but check the computed final position
-      // is actually inside the domain (the intermediate steps taken inside
-      // the integrator were ok, but the final step may just pass out)
-      // if it moves out, we can't interpolate scalars, so we must send it away
-      info.LocationState = this->Interpolator->TestPoint(info.CurrentPosition.x);
-      if (info.LocationState == ID_OUTSIDE_ALL)
-      {
-        info.ErrorCode = 2;
-        // if the particle is sent, remove it from the list
-        if (this->SendParticleToAnotherProcess(info, previous, this->OutputPointData))
-        {
-          this->ParticleHistories.erase(it);
-          particle_good = false;
-        }
-      }
+      substeps++;
+
+      // increment the particle time
+      point2[3] = point1[3] + stepTaken;
+      info.age += stepTaken;
+      info.SimulationTime += stepTaken;
+
+      // Point is valid. Insert it.
+      memcpy(&info.CurrentPosition, point2, sizeof(Position));
+      memcpy(point1, point2, sizeof(Position));
     }
 
-    // Has this particle stagnated
-    //
-    if (particle_good)
+    // If the solver is adaptive and the next time step (delT.Interval)
+    // that the solver wants to use is smaller than minStep or larger
+    // than maxStep, re-adjust it. This has to be done every step
+    // because minStep and maxStep can change depending on the Cell
+    // size (unless it is specified in time units)
+    if (integrator->IsAdaptive())
     {
-      this->Interpolator->GetLastGoodVelocity(velocity);
-      info.speed = vtkMath::Norm(velocity);
-      if (it->speed <= this->TerminalSpeed)
-      {
-        this->ParticleHistories.erase(it);
-        particle_good = false;
-      }
+      // code removed. Put it back when this is stable
     }
   }
 
-  //
-  // We got this far without error :
-  // Insert the point into the output
-  // Create any new scalars and interpolate existing ones
-  // Cache cell ids and datasets
-  //
-  if (particle_good)
-  {
-    //
-    // store the last Cell Ids and dataset indices for next time particle is updated
-    //
-    this->Interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
-    //
-    info.TimeStepAge += 1;
-    //
-    // Now generate the output geometry and scalars
-    //
-    this->AddParticle(info, velocity);
-  }
-  else
+  // The integration succeeded, but check the computed final position
+  // is actually inside the domain (the intermediate steps taken inside
+  // the integrator were ok, but the final step may just pass out)
+  // if it moves out, we can't interpolate scalars, so we must send it away
+  info.LocationState = interpolator->TestPoint(info.CurrentPosition.x);
+  interpolator->GetLastGoodVelocity(velocity);
+  if (info.LocationState == ID_OUTSIDE_ALL)
   {
-    this->Interpolator->ClearCache();
+    info.ErrorCode = 2;
+    return PARTICLE_OUTSIDE;
   }
 
 #ifdef DEBUGPARTICLETRACE
@@ -1237,6 +1329,59 @@ void vtkParticleTracerBase::IntegrateParticle(ParticleListIterator& it, double c
   Assert(point1[3] >= (this->GetCacheDataTime(0) - eps) &&
     point1[3] <= (this->GetCacheDataTime(1) + eps));
 #endif
+  return PARTICLE_MOVED;
+}
+
+//------------------------------------------------------------------------------
+bool vtkParticleTracerBase::ResolveParticle(ParticleListIterator it, ParticleInformation& previous,
+  int status, double velocity[3], vtkIdType cachedCellId[2], int cachedDataSetId[2])
+{
+  ParticleInformation& info = (*it);
+  if (status == PARTICLE_LOST)
+  {
+    // if the particle is sent, remove it from the list
+    if (previous.PointId < 0 && previous.TailPointId < 0)
+    {
+      vtkErrorMacro("the particle should have been added");
+    }
+    else
+    {
+      this->SendParticleToAnotherProcess(info, previous, this->ParticlePointData);
+    }
+    this->ParticleHistories.erase(it);
+    return false;
+  }
+  // The point data of the particle is where its PointId is, in the output of
+  // the previous time step.
+  if (status == PARTICLE_OUTSIDE &&
+    this->SendParticleToAnotherProcess(info, previous, this->ParticlePointData))
+  {
+    this->ParticleHistories.erase(it);
+    return false;
+  }
+
+  // Has this particle stagnated
+  //
+  if (status != PARTICLE_UNMOVED)
+  {
+    info.speed = vtkMath::Norm(velocity);
+    if (info.speed <= this->TerminalSpeed)
+    {
+      this->ParticleHistories.erase(it);
+      return false;
+    }
+  }
+
+  //
+  // store the last Cell Ids and dataset indices for next time particle is updated
+  //
+  info.CachedCellId[0] = cachedCellId[0];
+  info.CachedCellId[1] = cachedCellId[1];
+  info.CachedDataSetId[0] = cachedDataSetId[0];
+  info.CachedDataSetId[1] = cachedDataSetId[1];
+  //
+  info.TimeStepAge += 1;
+  return true;
 }
 
 //------------------------------------------------------------------------------
@@ -1448,13 +1593,13 @@ void vtkParticleTracerBase::CreateProtoPD(vtkDataObject* input)
 }
 
 //------------------------------------------------------------------------------
-bool vtkParticleTracerBase::RetryWithPush(
-  ParticleInformation& info, double* point1, double delT, int substeps)
+bool vtkParticleTracerBase::RetryWithPush(ParticleInformation& info, double* point1, double delT,
+  int substeps, vtkTemporalInterpolatedVelocityField* interpolator)
 {
   double velocity[3];
-  this->Interpolator->ClearCache();
+  interpolator->ClearCache();
 
-  info.LocationState = this->Interpolator->TestPoint(point1);
+  info.LocationState = interpolator->TestPoint(point1);
 
   if (info.LocationState == ID_OUTSIDE_ALL)
   {
@@ -1463,7 +1608,7 @@ bool vtkParticleTracerBase::RetryWithPush(
     // send the particle 'as is' and hope it lands in another process
     if (substeps > 0)
     {
-      this->Interpolator->GetLastGoodVelocity(velocity);
+      interpolator->GetLastGoodVelocity(velocity);
     }
     else
     {
@@ -1474,19 +1619,19 @@ bool vtkParticleTracerBase::RetryWithPush(
   else if (info.LocationState == ID_OUTSIDE_T0)
   {
     // the particle left the volume but can be tested at T2, so use the velocity at T2
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
     info.ErrorCode = 4;
   }
   else if (info.LocationState == ID_OUTSIDE_T1)
   {
     // the particle left the volume but can be tested at T1, so use the velocity at T1
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
     info.ErrorCode = 5;
   }
   else
   {
     // The test returned INSIDE_ALL, so test failed near start of integration,
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
   }
 
   // try adding a one increment push to the particle to get over a rotating/moving boundary
@@ -1496,7 +1641,7 @@ bool vtkParticleTracerBase::RetryWithPush(
   }
 
   info.CurrentPosition.x[3] += delT;
-  info.LocationState = this->Interpolator->TestPoint(info.CurrentPosition.x);
+  info.LocationState = interpolator->TestPoint(info.CurrentPosition.x);
   info.age += delT;
   info.SimulationTime += delT; // = this->GetCurrentTimeValue();
 
@@ -1513,19 +1658,94 @@ bool vtkParticleTracerBase::RetryWithPush(
 void vtkParticleTracerBase::AddParticle(
   vtkParticleTracerBaseNamespace::ParticleInformation& info, double* velocity)
 {
-  const double* coord = info.CurrentPosition.x;
-  vtkIdType tempId = this->OutputCoordinates->InsertNextPoint(coord);
-  // create the cell
-  this->ParticleCells->InsertNextCell(1, &tempId);
+  std::vector<ParticleInformation*> particles(1, &info);
+  this->AddParticles(particles, velocity);
+}
+
+//------------------------------------------------------------------------------
+void vtkParticleTracerBase::AddParticles(
+  const std::vector<ParticleInformation*>& particles, const double* velocities)
+{
+  vtkIdType numParticles = static_cast<vtkIdType>(particles.size());
+  if (numParticles == 0)
+  {
+    return;
+  }
+
+  // Each particle is written at its own index of the output arrays. The
+  // interpolated arrays are written concurrently if they are all data arrays
+  // whose tuples are stored apart, unlike the bits of a vtkBitArray.
+  vtkIdType firstId = this->OutputCoordinates->GetNumberOfPoints();
+  vtkIdType numIds = firstId + numParticles;
+  vtkDataArray* arrays[] = { this->OutputCoordinates->GetData(), this->ParticleIds,
+    this->ParticleSourceIds, this->InjectedPointIds, this->InjectedStepIds, this->ErrorCodeArray,
+    this->ParticleAge };
+  for (vtkDataArray* array : arrays)
+  {
+    ExtendArray(array, numIds);
+  }
+  if (this->ComputeVorticity)
+  {
+    ExtendArray(this->ParticleVorticity, numIds);
+    ExtendArray(this->ParticleRotation, numIds);
+    ExtendArray(this->ParticleAngularVel, numIds);
+  }
+  bool parallel = this->ParallelInterpolation;
+  for (int i = 0; i < this->NumberOfInterpolatedArrays; ++i)
+  {
+    vtkAbstractArray* array = this->OutputPointData->GetAbstractArray(i);
+    ExtendArray(array, numIds);
+    parallel &= vtkDataArray::SafeDownCast(array) && !vtkBitArray::SafeDownCast(array);
+  }
+
+  vtkSMPThreadLocal<ParticleTracerLocal> tlLocal;
+  auto addParticles = [&](vtkIdType begin, vtkIdType end) {
+    ParticleTracerLocal& local = tlLocal.Local();
+    if (!local.Interpolator)
+    {
+      local.Initialize(this->Interpolator, nullptr);
+    }
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      ParticleInformation& info = *particles[i];
+      // evaluate the interpolator where the particle is, from its cached cell
+      local.Interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+      local.Interpolator->TestPoint(info.CurrentPosition.x);
+      double velocity[3];
+      if (velocities)
+      {
+        std::copy(velocities + 3 * i, velocities + 3 * i + 3, velocity);
+      }
+      else
+      {
+        local.Interpolator->GetLastGoodVelocity(velocity);
+        info.speed = vtkMath::Norm(velocity);
+      }
+      this->SetParticle(info, velocity, firstId + i, local.Interpolator, local.CellVectors);
+    }
+  };
+  ForEachParticle(numParticles, 0, parallel, addParticles);
+
+  for (ParticleInformation* info : particles)
+  {
+    this->AppendToExtraPointDataArrays(*info);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkParticleTracerBase::SetParticle(ParticleInformation& info, double* velocity,
+  vtkIdType pointId, vtkTemporalInterpolatedVelocityField* interpolator,
+  vtkDoubleArray* cellVectors)
+{
+  this->OutputCoordinates->SetPoint(pointId, info.CurrentPosition.x);
   // set the easy scalars for this particle
-  this->ParticleIds->InsertNextValue(info.UniqueParticleId);
-  this->ParticleSourceIds->InsertNextValue(info.SourceID);
-  this->InjectedPointIds->InsertNextValue(info.InjectedPointId);
-  this->InjectedStepIds->InsertNextValue(info.InjectedStepId);
-  this->ErrorCodeArray->InsertNextValue(info.ErrorCode);
-  this->ParticleAge->InsertNextValue(info.age);
-  this->AppendToExtraPointDataArrays(info);
-  info.PointId = tempId;
+  this->ParticleIds->SetValue(pointId, info.UniqueParticleId);
+  this->ParticleSourceIds->SetValue(pointId, info.SourceID);
+  this->InjectedPointIds->SetValue(pointId, info.InjectedPointId);
+  this->InjectedStepIds->SetValue(pointId, info.InjectedStepId);
+  this->ErrorCodeArray->SetValue(pointId, info.ErrorCode);
+  this->ParticleAge->SetValue(pointId, info.age);
+  info.PointId = pointId;
   info.TailPointId = -1;
 
   //
@@ -1537,11 +1757,11 @@ void vtkParticleTracerBase::AddParticle(
   //
   if (info.LocationState == ID_OUTSIDE_T1)
   {
-    this->Interpolator->InterpolatePoint(0, this->OutputPointData, tempId);
+    interpolator->InterpolatePoint(0, this->OutputPointData, pointId);
   }
   else
   {
-    this->Interpolator->InterpolatePoint(1, this->OutputPointData, tempId);
+    interpolator->InterpolatePoint(1, this->OutputPointData, pointId);
   }
   //
   // Compute vorticity
@@ -1554,15 +1774,15 @@ void vtkParticleTracerBase::AddParticle(
     // have to use T0 if particle is out at T1, otherwise use T1
     if (info.LocationState == ID_OUTSIDE_T1)
     {
-      this->Interpolator->GetVorticityData(0, pcoords, weights, cell, this->CellVectors);
+      interpolator->GetVorticityData(0, pcoords, weights, cell, cellVectors);
     }
     else
     {
-      this->Interpolator->GetVorticityData(1, pcoords, weights, cell, this->CellVectors);
+      interpolator->GetVorticityData(1, pcoords, weights, cell, cellVectors);
     }
 
-    this->CalculateVorticity(cell, pcoords, CellVectors, vorticity);
-    this->ParticleVorticity->InsertNextTuple(vorticity);
+    this->CalculateVorticity(cell, pcoords, cellVectors, vorticity);
+    this->ParticleVorticity->SetTuple(pointId, vorticity);
     // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
     if (info.speed != 0.0)
     {
@@ -1574,8 +1794,8 @@ void vtkParticleTracerBase::AddParticle(
     {
       omega = 0.0;
     }
-    vtkIdType index = this->ParticleAngularVel->InsertNextValue(omega);
-    if (index > 0)
+    this->ParticleAngularVel->SetValue(pointId, omega);
+    if (pointId > 0)
     {
       rotation =
         info.rotation + (info.angularVel + omega) / 2 * (info.CurrentPosition.x[3] - info.time);
@@ -1584,7 +1804,7 @@ void vtkParticleTracerBase::AddParticle(
     {
       rotation = 0.0;
     }
-    this->ParticleRotation->InsertNextValue(rotation);
+    this->ParticleRotation->SetValue(pointId, rotation);
     info.rotation = rotation;
     info.angularVel = omega;
     info.time = info.CurrentPosition.x[3];
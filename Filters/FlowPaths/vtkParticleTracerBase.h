@@ -389,7 +389,8 @@ protected:
   virtual bool UpdateParticleListFromOtherProcesses() { return false; }
 
   /**
-   * particle between the two times supplied.
+   * particle between the two times supplied, and add it to the output
+   * unless it is removed or sent to another process.
    */
   void IntegrateParticle(vtkParticleTracerBaseNamespace::ParticleListIterator& it,
     double currenttime, double terminationtime, vtkInitialValueProblemSolver* integrator);
@@ -440,6 +441,15 @@ protected:
   virtual void ResetCache();
   void AddParticle(vtkParticleTracerBaseNamespace::ParticleInformation& info, double* velocity);
 
+  /**
+   * Add particles to the output, in parallel when possible. The velocities
+   * of the particles are given as consecutive triplets, or are evaluated
+   * where the particles are, setting their speed, when velocities is nullptr.
+   */
+  void AddParticles(
+    const std::vector<vtkParticleTracerBaseNamespace::ParticleInformation*>& particles,
+    const double* velocities);
+
   ///@{
   /**
    * Methods that check that the input arrays are ordered the
@@ -486,7 +496,42 @@ private:
    * to the integrator that is used.
    */
   bool RetryWithPush(vtkParticleTracerBaseNamespace::ParticleInformation& info, double* point1,
-    double delT, int subSteps);
+    double delT, int subSteps, vtkTemporalInterpolatedVelocityField* interpolator);
+
+  /**
+   * Move the particles from it_first to it_last between the two times
+   * supplied, in parallel when the interpolator allows it, then remove or
+   * send the particles as IntegrateParticle() does, in the order of the list,
+   * and add the remaining ones to the output.
+   */
+  void IntegrateParticles(vtkParticleTracerBaseNamespace::ParticleListIterator it_first,
+    vtkParticleTracerBaseNamespace::ParticleListIterator it_last, double currenttime,
+    double targettime);
+
+  /**
+   * Move a particle between the two times supplied with the given
+   * interpolator and integrator, without changing the particle list or the
+   * output. Returns how the integration ended, and the last velocity.
+   */
+  int AdvanceParticle(vtkParticleTracerBaseNamespace::ParticleInformation& info,
+    double currenttime, double targettime, vtkTemporalInterpolatedVelocityField* interpolator,
+    vtkInitialValueProblemSolver* integrator, double velocity[3]);
+
+  /**
+   * Remove or send a particle after AdvanceParticle(), or keep it with the
+   * cell ids cached by the interpolator. Returns true if the particle is kept.
+   */
+  bool ResolveParticle(vtkParticleTracerBaseNamespace::ParticleListIterator it,
+    vtkParticleTracerBaseNamespace::ParticleInformation& previous, int status, double velocity[3],
+    vtkIdType cachedCellId[2], int cachedDataSetId[2]);
+
+  /**
+   * Write a particle at the given index of the output arrays, interpolating
+   * the point data with an interpolator evaluated where the particle is.
+   */
+  void SetParticle(vtkParticleTracerBaseNamespace::ParticleInformation& info, double* velocity,
+    vtkIdType pointId, vtkTemporalInterpolatedVelocityField* interpolator,
+    vtkDoubleArray* cellVectors);
 
   bool SetTerminationTimeNoModify(double t);
 
@@ -534,6 +579,10 @@ private:
   vtkSmartPointer<vtkTemporalInterpolatedVelocityField> Interpolator;
   vtkAbstractInterpolatedVelocityField* InterpolatorPrototype;
 
+  // Whether copies of the interpolator can search the datasets concurrently,
+  // so that the particles are advanced and added to the output in parallel
+  bool ParallelInterpolation;
+
   // Data for time step CurrentTimeStep-1 and CurrentTimeStep
   vtkSmartPointer<vtkMultiBlockDataSet> CachedData[2];
 
@@ -557,8 +606,8 @@ private:
   vtkSmartPointer<vtkFloatArray> ParticleVorticity;
   vtkSmartPointer<vtkFloatArray> ParticleRotation;
   vtkSmartPointer<vtkFloatArray> ParticleAngularVel;
-  vtkSmartPointer<vtkDoubleArray> CellVectors;
   vtkSmartPointer<vtkPointData> OutputPointData;
+  int NumberOfInterpolatedArrays; // the first arrays of OutputPointData
   vtkSmartPointer<vtkDataSet> DataReferenceT[2];
   vtkSmartPointer<vtkCellArray> ParticleCells;
 
@@ -16,6 +16,7 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkAMRInterpolatedVelocityField.h"
 #include "vtkAbstractInterpolatedVelocityField.h"
+#include "vtkBitArray.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellLocatorInterpolatedVelocityField.h"
@@ -27,6 +28,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkExecutive.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
@@ -43,9 +45,13 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStaticCellLocator.h"
 
+#include <atomic>
+#include <numeric>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkStreamTracer);
@@ -88,6 +94,64 @@ void InterpolatePoint(vtkDataSetAttributes* outPointData, vtkDataSetAttributes*
   }
 }
 
+// The objects streamlines are integrated with and the arrays they are
+// appended to. Each thread has its own when integrating in parallel.
+struct StreamTracerLocal
+{
+  vtkSmartPointer<vtkAbstractInterpolatedVelocityField> Func;
+  vtkInterpolatedVelocityField* SurfaceFunc = nullptr;
+  vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+  vtkSmartPointer<vtkGenericCell> Cell;
+  std::vector<double> Weights;
+  vtkSmartPointer<vtkDoubleArray> CellVectors;
+
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkDataSetAttributes> PointData;
+  vtkSmartPointer<vtkDoubleArray> Time;
+  vtkSmartPointer<vtkDoubleArray> VelocityVectors;
+  vtkSmartPointer<vtkDoubleArray> Vorticity;
+  vtkSmartPointer<vtkDoubleArray> Rotation;
+  vtkSmartPointer<vtkDoubleArray> AngularVelocity;
+  std::vector<vtkAbstractArray*> Arrays;
+};
+
+// The streamline of a seed: where its points are, and the state of the
+// integration when it terminated.
+struct StreamTracerLine
+{
+  StreamTracerLocal* Local = nullptr;
+  vtkIdType Begin = 0;
+  vtkIdType NumberOfPoints = 0;
+  int ReasonForTermination = 0;
+  bool Integrated = false; // false when the seed is skipped
+  double Propagation = 0.0;
+  vtkIdType NumberOfSteps = 0;
+  double IntegrationTime = 0.0;
+  bool HasLastPoint = false;
+  double LastPoint[3] = { 0.0, 0.0, 0.0 };
+  bool HasStepSize = false;
+  double LastUsedStepSize = 0.0;
+};
+
+// The point arrays of the output, in the same order for all threads.
+std::vector<vtkAbstractArray*> GetStreamTracerArrays(StreamTracerLocal& local)
+{
+  std::vector<vtkAbstractArray*> arrays{ local.Points->GetData(), local.Time };
+  for (vtkDoubleArray* array :
+    { local.VelocityVectors, local.Vorticity, local.Rotation, local.AngularVelocity })
+  {
+    if (array)
+    {
+      arrays.push_back(array);
+    }
+  }
+  for (int i = 0; i < local.PointData->GetNumberOfArrays(); ++i)
+  {
+    arrays.push_back(local.PointData->GetAbstractArray(i));
+  }
+  return arrays;
+}
+
 }
 
 //------------------------------------------------------------------------------
@@ -664,18 +728,10 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   const char* vecName, double& inPropagation, vtkIdType& inNumSteps, double& inIntegrationTime)
 {
   vtkIdType numLines = seedIds->GetNumberOfIds();
-  double propagation = inPropagation;
-  vtkIdType numSteps = inNumSteps;
-  double integrationTime = inIntegrationTime;
 
   // Useful pointers
   vtkDataSetAttributes* outputPD = output->GetPointData();
   vtkDataSetAttributes* outputCD = output->GetCellData();
-  vtkPointData* inputPD;
-  vtkDataSet* input;
-  vtkDataArray* inVectors;
-
-  int direction = 1;
 
   if (this->GetIntegrator() == nullptr)
   {
@@ -683,28 +739,25 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
     return;
   }
 
-  double* weights = nullptr;
-  if (maxCellSize > 0)
+  // The seeds are integrated in parallel by copies of func when these can
+  // search the shared datasets concurrently: with the vtkStaticCellLocator
+  // instances of a vtkCellLocatorInterpolatedVelocityField, or when no
+  // dataset is a vtkPointSet, whose FindCell() builds search structures
+  // lazily. The custom termination callbacks are called serially, and so is
+  // a continued integration, which passes its state to the first streamline.
+  vtkCompositeInterpolatedVelocityField* compositeFunc =
+    vtkCompositeInterpolatedVelocityField::SafeDownCast(func);
+  bool parallel = numLines > 1 && compositeFunc != nullptr &&
+    this->CustomTerminationCallback.empty() && this->HasMatchingPointAttributes &&
+    inPropagation == 0.0 && inNumSteps == 0 && inIntegrationTime == 0.0;
+  if (parallel && !vtkCellLocatorInterpolatedVelocityField::SafeDownCast(func))
   {
-    weights = new double[maxCellSize];
-  }
-
-  // Used in GetCell()
-  vtkGenericCell* cell = vtkGenericCell::New();
-
-  // Create a new integrator, the type is the same as Integrator
-  vtkInitialValueProblemSolver* integrator = this->GetIntegrator()->NewInstance();
-  integrator->SetFunctionSet(func);
-
-  // Check Surface option
-  vtkInterpolatedVelocityField* surfaceFunc = nullptr;
-  if (this->SurfaceStreamlines == true)
-  {
-    surfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
-    if (surfaceFunc)
+    for (int i = 0; i < compositeFunc->GetNumberOfDataSets(); ++i)
     {
-      surfaceFunc->SetForceSurfaceTangentVector(true);
-      surfaceFunc->SetSurfaceDataset(true);
+      if (vtkPointSet::SafeDownCast(compositeFunc->GetDataSet(i)))
+      {
+        parallel = false;
+      }
     }
   }
 
@@ -714,48 +767,7 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   // were to allocate any points here, potentially, we can
   // waste a lot of memory if a lot of streamers are used.
   // Always insert the first point
-  vtkPoints* outputPoints = vtkPoints::New();
-  vtkCellArray* outputLines = vtkCellArray::New();
-
-  // We will keep track of integration time in this array
-  vtkDoubleArray* time = vtkDoubleArray::New();
-  time->SetName("IntegrationTime");
-
-  // This array explains why the integration stopped
-  vtkIntArray* retVals = vtkIntArray::New();
-  retVals->SetName("ReasonForTermination");
-
-  vtkIntArray* sids = vtkIntArray::New();
-  sids->SetName("SeedIds");
-
-  vtkSmartPointer<vtkDoubleArray> velocityVectors;
-  if (vecType != vtkDataObject::POINT)
-  {
-    velocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
-    velocityVectors->SetName(vecName);
-    velocityVectors->SetNumberOfComponents(3);
-  }
-  vtkDoubleArray* cellVectors = nullptr;
-  vtkDoubleArray* vorticity = nullptr;
-  vtkDoubleArray* rotation = nullptr;
-  vtkDoubleArray* angularVel = nullptr;
-  if (this->ComputeVorticity)
-  {
-    cellVectors = vtkDoubleArray::New();
-    cellVectors->SetNumberOfComponents(3);
-    cellVectors->Allocate(3 * VTK_CELL_SIZE);
-
-    vorticity = vtkDoubleArray::New();
-    vorticity->SetName("Vorticity");
-    vorticity->SetNumberOfComponents(3);
-
-    rotation = vtkDoubleArray::New();
-    rotation->SetName("Rotation");
-
-    angularVel = vtkDoubleArray::New();
-    angularVel->SetName("AngularVelocity");
-  }
-
+  //
   // We will interpolate all point attributes of the input on each point of
   // the output (unless they are turned off). Note that we are using only
   // the first input, if there are more than one, the attributes have to match.
@@ -771,18 +783,97 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
   //       as a consequence a large number of such small vtkPolyData objects
   //       are needed to represent a streamline, consuming up the memory before
   //       the intermediate memory is timely released.
-  outputPD->InterpolateAllocate(input0Data, this->MaximumNumberOfSteps);
+  auto allocateArrays = [&](StreamTracerLocal& local, vtkDataSetAttributes* pointData) {
+    local.Points = vtkSmartPointer<vtkPoints>::New();
 
-  vtkIdType numPtsTotal = 0;
-  double velocity[3];
+    // We will keep track of integration time in this array
+    local.Time = vtkSmartPointer<vtkDoubleArray>::New();
+    local.Time->SetName("IntegrationTime");
 
-  int shouldAbort = 0;
+    if (vecType != vtkDataObject::POINT)
+    {
+      local.VelocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
+      local.VelocityVectors->SetName(vecName);
+      local.VelocityVectors->SetNumberOfComponents(3);
+    }
+    if (this->ComputeVorticity)
+    {
+      local.Vorticity = vtkSmartPointer<vtkDoubleArray>::New();
+      local.Vorticity->SetName("Vorticity");
+      local.Vorticity->SetNumberOfComponents(3);
 
-  for (int currentLine = 0; currentLine < numLines; currentLine++)
-  {
-    double progress = static_cast<double>(currentLine) / numLines;
-    this->UpdateProgress(progress);
+      local.Rotation = vtkSmartPointer<vtkDoubleArray>::New();
+      local.Rotation->SetName("Rotation");
+
+      local.AngularVelocity = vtkSmartPointer<vtkDoubleArray>::New();
+      local.AngularVelocity->SetName("AngularVelocity");
+    }
+
+    local.PointData = pointData;
+    pointData->InterpolateAllocate(input0Data, this->MaximumNumberOfSteps);
+  };
+
+  // Prepare the integration of streamlines with a velocity field
+  auto initializeLocal = [&](StreamTracerLocal& local, vtkAbstractInterpolatedVelocityField* f,
+                           vtkDataSetAttributes* pointData) {
+    local.Func = f;
 
+    // Create a new integrator, the type is the same as Integrator
+    local.Integrator.TakeReference(this->GetIntegrator()->NewInstance());
+    local.Integrator->SetFunctionSet(f);
+
+    // Used in GetCell()
+    local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    local.Weights.resize(maxCellSize > 0 ? maxCellSize : 0);
+
+    // Check Surface option
+    local.SurfaceFunc = nullptr;
+    if (this->SurfaceStreamlines == true)
+    {
+      local.SurfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(f);
+      if (local.SurfaceFunc)
+      {
+        local.SurfaceFunc->SetForceSurfaceTangentVector(true);
+        local.SurfaceFunc->SetSurfaceDataset(true);
+      }
+    }
+
+    if (this->ComputeVorticity)
+    {
+      local.CellVectors = vtkSmartPointer<vtkDoubleArray>::New();
+      local.CellVectors->SetNumberOfComponents(3);
+      local.CellVectors->Allocate(3 * VTK_CELL_SIZE);
+    }
+
+    allocateArrays(local, pointData);
+  };
+
+  std::vector<StreamTracerLine> lines(numLines);
+  std::atomic<bool> shouldAbort(false);
+
+  // Integrate the streamline of a seed from the given state, appending its
+  // points to the arrays of local.
+  auto integrateLine = [&](vtkIdType currentLine, StreamTracerLocal& local,
+                         StreamTracerLine& line, double propagation, vtkIdType numSteps,
+                         double integrationTime, bool reportProgress) {
+    vtkAbstractInterpolatedVelocityField* lineFunc = local.Func;
+    vtkInitialValueProblemSolver* integrator = local.Integrator;
+    vtkInterpolatedVelocityField* surfaceFunc = local.SurfaceFunc;
+    vtkGenericCell* cell = local.Cell;
+    double* weights = local.Weights.empty() ? nullptr : local.Weights.data();
+    vtkDoubleArray* cellVectors = local.CellVectors;
+    vtkPoints* outputPoints = local.Points;
+    vtkDataSetAttributes* linePD = local.PointData;
+    vtkDoubleArray* time = local.Time;
+    vtkDoubleArray* velocityVectors = local.VelocityVectors;
+    vtkDoubleArray* vorticity = local.Vorticity;
+    vtkDoubleArray* rotation = local.Rotation;
+    vtkDoubleArray* angularVel = local.AngularVelocity;
+    vtkPointData* inputPD;
+    vtkDataSet* input;
+    vtkDataArray* inVectors;
+
+    int direction = 1;
     switch (integrationDirections->GetValue(currentLine))
     {
       case FORWARD:
@@ -794,28 +885,31 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
     }
 
     // temporary variables used in the integration
-    double point1[3], point2[3], pcoords[3], vort[3], omega;
+    double point1[3], point2[3], pcoords[3], vort[3], omega, velocity[3];
     vtkIdType index, numPts = 0;
 
     // Clear the last cell to avoid starting a search from
     // the last point in the streamline
-    func->ClearLastCellId();
+    lineFunc->ClearLastCellId();
 
     // Initial point
     seedSource->GetTuple(seedIds->GetId(currentLine), point1);
     memcpy(point2, point1, 3 * sizeof(double));
-    if (!func->FunctionValues(point1, velocity))
+    if (!lineFunc->FunctionValues(point1, velocity))
     {
-      continue;
+      return;
     }
 
     if (propagation >= this->MaximumPropagation || numSteps > this->MaximumNumberOfSteps)
     {
-      continue;
+      return;
     }
 
+    line.Local = &local;
+    line.Begin = outputPoints->GetNumberOfPoints();
+    line.Integrated = true;
+
     numPts++;
-    numPtsTotal++;
     vtkIdType nextPoint = outputPoints->InsertNextPoint(point1);
     double lastInsertedPoint[3];
     outputPoints->GetPoint(nextPoint, lastInsertedPoint);
@@ -836,11 +930,11 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
     int retVal = OUT_OF_LENGTH, tmp;
 
     // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-    input = func->GetLastDataSet();
+    input = lineFunc->GetLastDataSet();
     inputPD = input->GetPointData();
     inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
     // Convert intervals to arc-length unit
-    input->GetCell(func->GetLastCellId(), cell);
+    input->GetCell(lineFunc->GetLastCellId(), cell);
     cellLength = sqrt(static_cast<double>(cell->GetLength2()));
     speed = vtkMath::Norm(velocity);
     // Never call conversion methods if speed == 0
@@ -850,11 +944,11 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
     }
 
     // Interpolate all point attributes on first point
-    func->GetLastWeights(weights);
+    lineFunc->GetLastWeights(weights);
     InterpolatePoint(
-      outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
+      linePD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
     // handle both point and cell velocity attributes.
-    vtkDataArray* outputVelocityVectors = outputPD->GetArray(vecName);
+    vtkDataArray* outputVelocityVectors = linePD->GetArray(vecName);
     if (vecType != vtkDataObject::POINT)
     {
       velocityVectors->InsertNextTuple(velocity);
@@ -868,7 +962,7 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
       if (vecType == vtkDataObject::POINT)
       {
         inVectors->GetTuples(cell->PointIds, cellVectors);
-        func->GetLastLocalCoordinates(pcoords);
+        lineFunc->GetLastLocalCoordinates(pcoords);
         vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
       }
       else
@@ -926,12 +1020,15 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
 
       if (numSteps++ % 1000 == 1)
       {
-        progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
-        this->UpdateProgress(progress);
+        if (reportProgress)
+        {
+          double progress = (currentLine + propagation / this->MaximumPropagation) / numLines;
+          this->UpdateProgress(progress);
+        }
 
         if (this->GetAbortExecute())
         {
-          shouldAbort = 1;
+          shouldAbort = true;
           break;
         }
       }
@@ -960,18 +1057,20 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
         }
         maxStep = stepSize.Interval;
       }
-      this->LastUsedStepSize = stepSize.Interval;
+      line.HasStepSize = true;
+      line.LastUsedStepSize = stepSize.Interval;
 
       // Calculate the next step using the integrator provided
       // Break if the next point is out of bounds.
-      func->SetNormalizeVector(true);
+      lineFunc->SetNormalizeVector(true);
       tmp = integrator->ComputeNextStep(point1, point2, 0, stepSize.Interval, stepTaken, minStep,
         maxStep, this->MaximumError, error);
-      func->SetNormalizeVector(false);
+      lineFunc->SetNormalizeVector(false);
       if (tmp != 0)
       {
         retVal = tmp;
-        memcpy(lastPoint, point2, 3 * sizeof(double));
+        line.HasLastPoint = true;
+        memcpy(line.LastPoint, point2, 3 * sizeof(double));
         break;
       }
 
@@ -981,7 +1080,8 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
         if (surfaceFunc->SnapPointOnCell(point2, point1) != 1)
         {
           retVal = OUT_OF_DOMAIN;
-          memcpy(lastPoint, point2, 3 * sizeof(double));
+          line.HasLastPoint = true;
+          memcpy(line.LastPoint, point2, 3 * sizeof(double));
           break;
         }
       }
@@ -994,10 +1094,11 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
       }
 
       // Interpolate the velocity at the next point
-      if (!func->FunctionValues(point2, velocity))
+      if (!lineFunc->FunctionValues(point2, velocity))
       {
         retVal = OUT_OF_DOMAIN;
-        memcpy(lastPoint, point2, 3 * sizeof(double));
+        line.HasLastPoint = true;
+        memcpy(line.LastPoint, point2, 3 * sizeof(double));
         break;
       }
 
@@ -1015,12 +1116,12 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
       propagation += fabs(stepSize.Interval);
 
       // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-      input = func->GetLastDataSet();
+      input = lineFunc->GetLastDataSet();
       inputPD = input->GetPointData();
       inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
 
       // Calculate cell length and speed to be used in unit conversions
-      input->GetCell(func->GetLastCellId(), cell);
+      input->GetCell(lineFunc->GetLastCellId(), cell);
       cellLength = sqrt(static_cast<double>(cell->GetLength2()));
       speed = speed2;
 
@@ -1035,15 +1136,14 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
       {
         // Point is valid. Insert it.
         numPts++;
-        numPtsTotal++;
         nextPoint = outputPoints->InsertNextPoint(point1);
         outputPoints->GetPoint(nextPoint, lastInsertedPoint);
         time->InsertNextValue(integrationTime);
 
         // Interpolate all point attributes on current point
-        func->GetLastWeights(weights);
+        lineFunc->GetLastWeights(weights);
         InterpolatePoint(
-          outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
+          linePD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
 
         if (vecType != vtkDataObject::POINT)
         {
@@ -1056,7 +1156,7 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
           if (vecType == vtkDataObject::POINT)
           {
             inVectors->GetTuples(cell->PointIds, cellVectors);
-            func->GetLastLocalCoordinates(pcoords);
+            lineFunc->GetLastLocalCoordinates(pcoords);
             vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
           }
           else
@@ -1111,53 +1211,190 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
       }
     }
 
-    if (shouldAbort)
+    line.NumberOfPoints = numPts;
+    line.ReasonForTermination = retVal;
+    line.Propagation = propagation;
+    line.NumberOfSteps = numSteps;
+    line.IntegrationTime = integrationTime;
+  };
+
+  // The arrays the streamlines end up in
+  StreamTracerLocal result;
+
+  if (!parallel)
+  {
+    initializeLocal(result, func, outputPD);
+
+    double propagation = inPropagation;
+    vtkIdType numSteps = inNumSteps;
+    double integrationTime = inIntegrationTime;
+    for (vtkIdType currentLine = 0; currentLine < numLines && !shouldAbort; currentLine++)
     {
-      break;
-    }
+      double progress = static_cast<double>(currentLine) / numLines;
+      this->UpdateProgress(progress);
 
-    if (numPts > 1)
+      integrateLine(
+        currentLine, result, lines[currentLine], propagation, numSteps, integrationTime, true);
+
+      // Initialize these to 0 before starting the next line.
+      // The values passed in the function call are only used
+      // for the first line.
+      if (lines[currentLine].Integrated)
+      {
+        propagation = 0;
+        numSteps = 0;
+        integrationTime = 0;
+      }
+    }
+  }
+  else
+  {
+    // Make the dataset API thread safe by calling it once in a single thread,
+    // and build the cell locators the copies of func share with a first copy.
+    vtkSmartPointer<vtkCompositeInterpolatedVelocityField> firstCopy;
+    firstCopy.TakeReference(compositeFunc->NewInstance());
+    firstCopy->CopyDataSets(compositeFunc);
+    vtkNew<vtkGenericCell> cell;
+    for (int i = 0; i < compositeFunc->GetNumberOfDataSets(); ++i)
     {
-      outputLines->InsertNextCell(numPts);
-      for (int i = numPtsTotal - numPts; i < numPtsTotal; i++)
+      vtkDataSet* dataset = compositeFunc->GetDataSet(i);
+      if (dataset->GetNumberOfCells() > 0)
       {
-        outputLines->InsertCellPoint(i);
+        dataset->GetCell(0, cell);
       }
-      retVals->InsertNextValue(retVal);
-      sids->InsertNextValue(seedIds->GetId(currentLine));
+      dataset->GetLength();
     }
 
-    // Initialize these to 0 before starting the next line.
-    // The values passed in the function call are only used
-    // for the first line.
-    inPropagation = propagation;
-    inNumSteps = numSteps;
-    inIntegrationTime = integrationTime;
+    // Integrate the seeds one at a time, so that the threads done with short
+    // streamlines take the next seeds while others integrate long ones.
+    vtkSMPThreadLocal<StreamTracerLocal> locals;
+    vtkSMPTools::For(0, numLines, 1, [&](vtkIdType currentLine, vtkIdType endLine) {
+      StreamTracerLocal& local = locals.Local();
+      if (!local.Func)
+      {
+        vtkSmartPointer<vtkCompositeInterpolatedVelocityField> localFunc;
+        localFunc.TakeReference(compositeFunc->NewInstance());
+        localFunc->CopyParameters(func);
+        localFunc->SelectVectors(func->GetVectorsType(), func->GetVectorsSelection());
+        localFunc->CopyDataSets(compositeFunc);
+        vtkNew<vtkPointData> localPD;
+        initializeLocal(local, localFunc, localPD);
+      }
+      for (; currentLine < endLine && !shouldAbort; ++currentLine)
+      {
+        integrateLine(currentLine, local, lines[currentLine], 0.0, 0, 0.0, false);
+      }
+    });
+
+    if (!shouldAbort)
+    {
+      // Copy the points of the streamlines to the output in seed order
+      vtkIdType numPtsTotal = 0;
+      for (const StreamTracerLine& line : lines)
+      {
+        numPtsTotal += line.NumberOfPoints;
+      }
+      allocateArrays(result, outputPD);
+      std::vector<vtkAbstractArray*> outArrays = GetStreamTracerArrays(result);
+      bool threadSafe = true;
+      for (vtkAbstractArray* array : outArrays)
+      {
+        array->SetNumberOfTuples(numPtsTotal);
+        threadSafe &= vtkDataArray::SafeDownCast(array) && !vtkBitArray::SafeDownCast(array);
+      }
+      for (auto iter = locals.begin(); iter != locals.end(); ++iter)
+      {
+        iter->Arrays = GetStreamTracerArrays(*iter);
+      }
 
-    propagation = 0;
-    numSteps = 0;
-    integrationTime = 0;
+      std::vector<vtkIdType> lineOffsets(numLines + 1);
+      for (vtkIdType currentLine = 0; currentLine < numLines; ++currentLine)
+      {
+        lineOffsets[currentLine + 1] = lineOffsets[currentLine] + lines[currentLine].NumberOfPoints;
+      }
+      auto copyLines = [&](vtkIdType currentLine, vtkIdType endLine) {
+        for (; currentLine < endLine; ++currentLine)
+        {
+          const StreamTracerLine& line = lines[currentLine];
+          for (std::size_t i = 0; line.NumberOfPoints > 0 && i < outArrays.size(); ++i)
+          {
+            outArrays[i]->InsertTuples(
+              lineOffsets[currentLine], line.NumberOfPoints, line.Begin, line.Local->Arrays[i]);
+          }
+        }
+      };
+      if (threadSafe)
+      {
+        vtkSMPTools::For(0, numLines, copyLines);
+      }
+      else
+      {
+        copyLines(0, numLines);
+      }
+    }
   }
 
   if (!shouldAbort)
   {
     // Create the output polyline
-    output->SetPoints(outputPoints);
-    outputPD->AddArray(time);
+    output->SetPoints(result.Points);
+    outputPD->AddArray(result.Time);
     if (vecType != vtkDataObject::POINT)
     {
-      outputPD->AddArray(velocityVectors);
+      outputPD->AddArray(result.VelocityVectors);
     }
-    if (vorticity)
+    if (result.Vorticity)
     {
-      outputPD->AddArray(vorticity);
-      outputPD->AddArray(rotation);
-      outputPD->AddArray(angularVel);
+      outputPD->AddArray(result.Vorticity);
+      outputPD->AddArray(result.Rotation);
+      outputPD->AddArray(result.AngularVelocity);
     }
 
-    vtkIdType numPts = outputPoints->GetNumberOfPoints();
+    vtkIdType numPts = result.Points->GetNumberOfPoints();
     if (numPts > 1)
     {
+      // The streamlines with more than one point, ordered by seed
+      vtkNew<vtkIdTypeArray> offsets;
+      offsets->InsertNextValue(0);
+      vtkNew<vtkIntArray> retVals;
+      retVals->SetName("ReasonForTermination");
+      vtkNew<vtkIntArray> sids;
+      sids->SetName("SeedIds");
+      std::vector<vtkIdType> linePoints(numLines);
+      std::vector<vtkIdType> lineConnectivity(numLines);
+      vtkIdType firstPoint = 0;
+      vtkIdType connectivitySize = 0;
+      for (vtkIdType currentLine = 0; currentLine < numLines; ++currentLine)
+      {
+        const StreamTracerLine& line = lines[currentLine];
+        linePoints[currentLine] = firstPoint;
+        lineConnectivity[currentLine] = connectivitySize;
+        firstPoint += line.NumberOfPoints;
+        if (line.NumberOfPoints > 1)
+        {
+          connectivitySize += line.NumberOfPoints;
+          offsets->InsertNextValue(connectivitySize);
+          retVals->InsertNextValue(line.ReasonForTermination);
+          sids->InsertNextValue(seedIds->GetId(currentLine));
+        }
+      }
+      vtkNew<vtkIdTypeArray> connectivity;
+      connectivity->SetNumberOfValues(connectivitySize);
+      vtkIdType* conn = connectivity->GetPointer(0);
+      vtkSMPTools::For(0, numLines, [&](vtkIdType currentLine, vtkIdType endLine) {
+        for (; currentLine < endLine; ++currentLine)
+        {
+          vtkIdType lineNumPts = lines[currentLine].NumberOfPoints;
+          if (lineNumPts > 1)
+          {
+            vtkIdType* lineConn = conn + lineConnectivity[currentLine];
+            std::iota(lineConn, lineConn + lineNumPts, linePoints[currentLine]);
+          }
+        }
+      });
+      vtkNew<vtkCellArray> outputLines;
+      outputLines->SetData(offsets, connectivity);
+
       // Assign geometry and attributes
       output->SetLines(outputLines);
       if (this->GenerateNormalsInIntegrate)
@@ -1170,29 +1407,25 @@ void vtkStreamTracer::Integrate(vtkPointData* input0Data, vtkPolyData* output,
     }
   }
 
-  if (vorticity)
-  {
-    vorticity->Delete();
-    rotation->Delete();
-    angularVel->Delete();
-  }
-
-  if (cellVectors)
+  // Pass the state of the last streamline, the last point out of the domain
+  // and the last step size to the caller, as a serial integration does.
+  for (const StreamTracerLine& line : lines)
   {
-    cellVectors->Delete();
+    if (line.Integrated)
+    {
+      inPropagation = line.Propagation;
+      inNumSteps = line.NumberOfSteps;
+      inIntegrationTime = line.IntegrationTime;
+    }
+    if (line.HasLastPoint)
+    {
+      memcpy(lastPoint, line.LastPoint, 3 * sizeof(double));
+    }
+    if (line.HasStepSize)
+    {
+      this->LastUsedStepSize = line.LastUsedStepSize;
+    }
   }
-  retVals->Delete();
-  sids->Delete();
-
-  outputPoints->Delete();
-  outputLines->Delete();
-
-  time->Delete();
-
-  integrator->Delete();
-  cell->Delete();
-
-  delete[] weights;
 
   output->Squeeze();
 }
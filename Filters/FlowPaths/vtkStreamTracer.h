@@ -69,6 +69,16 @@
  * a source object, traces will be generated from each point in the source
  * that is inside the dataset.
  *
+ * The seeds are integrated in parallel with vtkSMPTools, each thread taking
+ * the next seed when done with a streamline and using its own copy of the
+ * interpolated velocity field, when the copies can search the datasets
+ * concurrently: with a vtkCellLocatorInterpolatedVelocityField, whose
+ * vtkStaticCellLocator instances are shared by the copies (see
+ * SetInterpolatorTypeToCellLocator()), or with datasets that are not
+ * vtkPointSet. The output does not depend on the number of threads: the
+ * streamlines are ordered by seed, as in the serial integration used
+ * otherwise and when custom termination callbacks are set.
+ *
  * @note Field data is shallow copied to the output. When the input is a
  * composite data set, field data associated with the root block is shallow-
  * copied to the output vtkPolyData.
@@ -75,7 +75,9 @@ void vtkTemporalInterpolatedVelocityField::SetDataSetAtTime(
     {
       this->StaticDataSets.resize(I + 1, is_static);
     }
-    if (is_static)
+    // the locator of T0 is also valid at T1 when the mesh is static, or when
+    // the datasets are the same, as they are at the start time
+    if (is_static || dataset == this->IVF[0]->CacheList[I].DataSet)
     {
       this->IVF[N]->SetDataSet(I, dataset, staticdataset, this->IVF[0]->CacheList[I].BSPTree);
     }
@@ -86,6 +88,22 @@ void vtkTemporalInterpolatedVelocityField::SetDataSetAtTime(
   }
 }
 //------------------------------------------------------------------------------
+void vtkTemporalInterpolatedVelocityField::CopyDataSets(vtkTemporalInterpolatedVelocityField* from)
+{
+  this->Times[0] = from->Times[0];
+  this->Times[1] = from->Times[1];
+  this->ScaleCoeff = from->ScaleCoeff;
+  this->StaticDataSets = from->StaticDataSets;
+  this->IVF[0]->CopyDataSets(from->IVF[0]);
+  this->IVF[1]->CopyDataSets(from->IVF[1]);
+}
+//------------------------------------------------------------------------------
+bool vtkTemporalInterpolatedVelocityField::BuildLocators()
+{
+  bool threadSafe = this->IVF[0]->BuildLocators();
+  return this->IVF[1]->BuildLocators() && threadSafe;
+}
+//------------------------------------------------------------------------------
 bool vtkTemporalInterpolatedVelocityField::IsStatic(int datasetIndex)
 {
   return this->StaticDataSets[datasetIndex];
@@ -136,18 +154,23 @@ bool vtkTemporalInterpolatedVelocityField::GetCachedCellIds(vtkIdType id[2], int
 //------------------------------------------------------------------------------
 void vtkTemporalInterpolatedVelocityField::AdvanceOneTimeStep()
 {
+  // The datasets at T1 become those at T0: when any of them is dynamic, keep
+  // their cell locators, built during this step, for the next one. Swapping
+  // once per dynamic dataset would drop them when there are several.
+  bool allStatic = true;
   for (unsigned int i = 0; i < this->IVF[0]->CacheList.size(); i++)
   {
-    if (this->IsStatic(i))
-    {
-      this->IVF[0]->ClearLastCellInfo();
-      this->IVF[1]->ClearLastCellInfo();
-    }
-    else
-    {
-      this->IVF[0] = this->IVF[1];
-      this->IVF[1] = vtkSmartPointer<vtkCachingInterpolatedVelocityField>::New();
-    }
+    allStatic &= this->IsStatic(i);
+  }
+  if (allStatic)
+  {
+    this->IVF[0]->ClearLastCellInfo();
+    this->IVF[1]->ClearLastCellInfo();
+  }
+  else
+  {
+    this->IVF[0] = this->IVF[1];
+    this->IVF[1] = vtkSmartPointer<vtkCachingInterpolatedVelocityField>::New();
   }
 }
 //------------------------------------------------------------------------------
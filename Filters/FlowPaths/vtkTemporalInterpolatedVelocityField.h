@@ -30,8 +30,8 @@
  * values and computing vorticity etc.
  *
  * @warning
- * vtkTemporalInterpolatedVelocityField is probably not thread safe.
- * A new instance should be created by each thread.
+ * vtkTemporalInterpolatedVelocityField is not thread safe. Each thread should
+ * use its own copy, made with CopyDataSets() once BuildLocators() is done.
  *
  * @warning
  * Datasets are added in lists. The list for T1 must be identical to that for T0
@@ -102,6 +102,19 @@ public:
    */
   void SetDataSetAtTime(int I, int N, double T, vtkDataSet* dataset, bool staticdataset);
 
+  /**
+   * Copy the datasets, times and vectors selection of another instance. The
+   * datasets and their cell locators are shared, but not the cached cells, so
+   * that each thread can trace particles with its own copy.
+   */
+  void CopyDataSets(vtkTemporalInterpolatedVelocityField* from);
+
+  /**
+   * Build the cell locators of the datasets of both times. Returns true when
+   * copies made with CopyDataSets() can then be used concurrently.
+   */
+  bool BuildLocators();
+
   ///@{
   /**
    * Between iterations of the Particle Tracer, Id's of the Cell
@@ -0,0 +1,270 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLocatorsParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that the cell locators built in parallel answer the queries as
+// when built with a single thread, on datasets large enough for their
+// nodes to be split in parallel, and that they locate the points. Also
+// check the OBB of a list of cells computed by a vtkOBBTree subclass.
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkOBBTree.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const int NumberOfLocators = 5;
+const int NumberOfQueries = 300;
+
+vtkSmartPointer<vtkAbstractCellLocator> NewLocator(int i)
+{
+  vtkSmartPointer<vtkAbstractCellLocator> locator;
+  switch (i)
+  {
+    case 0:
+      locator = vtkSmartPointer<vtkCellLocator>::New();
+      break;
+    case 1:
+      locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+      break;
+    case 2:
+      locator = vtkSmartPointer<vtkCellTreeLocator>::New();
+      break;
+    case 3:
+      locator = vtkSmartPointer<vtkModifiedBSPTree>::New();
+      break;
+    default:
+      locator = vtkSmartPointer<vtkOBBTree>::New();
+      break;
+  }
+  locator->LazyEvaluationOff();
+  return locator;
+}
+
+// A grid of dim^3 hexahedra in [-1,1]^3
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int dim)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= dim; ++k)
+  {
+    for (int j = 0; j <= dim; ++j)
+    {
+      for (int i = 0; i <= dim; ++i)
+      {
+        points->InsertNextPoint(-1.0 + 2.0 * i / dim, -1.0 + 2.0 * j / dim, -1.0 + 2.0 * k / dim);
+      }
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate(dim * dim * dim);
+  const vtkIdType n = dim + 1;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        vtkIdType p = i + n * (j + n * k);
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n, p + 1 + n * n,
+          p + 1 + n + n * n, p + n + n * n };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+  return grid;
+}
+
+bool InCellBounds(vtkDataSet* dataset, vtkIdType cellId, const double x[3])
+{
+  if (cellId < 0)
+  {
+    return false;
+  }
+  double bounds[6];
+  dataset->GetCellBounds(cellId, bounds);
+  return bounds[0] <= x[0] && x[0] <= bounds[1] && bounds[2] <= x[1] && x[1] <= bounds[3] &&
+    bounds[4] <= x[2] && x[2] <= bounds[5];
+}
+
+// The results of the queries: the parametric coordinate and the cell of the
+// line intersections with a surface, or the cells containing the points of a
+// volume.
+struct QueryResults
+{
+  std::vector<double> T;
+  std::vector<vtkIdType> CellIds;
+};
+
+QueryResults Query(int i, vtkDataSet* dataset, vtkPoints* queryPoints, bool findCells)
+{
+  vtkSmartPointer<vtkAbstractCellLocator> locator = NewLocator(i);
+  locator->SetDataSet(dataset);
+  locator->BuildLocator();
+
+  QueryResults results;
+  vtkNew<vtkGenericCell> cell;
+  double p1[3], p2[3], t, x[3], pcoords[3], weights[8];
+  int subId;
+  vtkIdType cellId;
+  for (vtkIdType q = 0; !findCells && q < NumberOfQueries; ++q)
+  {
+    queryPoints->GetPoint(2 * q, p1);
+    queryPoints->GetPoint(2 * q + 1, p2);
+    cellId = -1;
+    t = -1.0;
+    locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell);
+    results.T.push_back(t);
+    results.CellIds.push_back(cellId);
+  }
+  if (findCells)
+  {
+    for (vtkIdType q = 0; q < NumberOfQueries; ++q)
+    {
+      queryPoints->GetPoint(q, x);
+      cellId = locator->FindCell(x, 0.0, cell, pcoords, weights);
+      if (!InCellBounds(dataset, cellId, x))
+      {
+        std::cerr << "Point " << q << " is not located" << std::endl;
+        results.CellIds.push_back(-2);
+      }
+      else
+      {
+        results.CellIds.push_back(cellId);
+      }
+    }
+  }
+  return results;
+}
+
+// A subclass computing the OBB of a list of cells of its built tree.
+class CellsOBBTree : public vtkOBBTree
+{
+public:
+  static CellsOBBTree* New();
+  vtkTypeMacro(CellsOBBTree, vtkOBBTree);
+
+  void ComputeCellsOBB(vtkIdList* cells, double corner[3], double max[3], double mid[3],
+    double min[3], double size[3])
+  {
+    this->ComputeOBB(cells, corner, max, mid, min, size);
+  }
+};
+vtkStandardNewMacro(CellsOBBTree);
+
+bool TestCellsOBB(vtkDataSet* dataset)
+{
+  vtkNew<CellsOBBTree> tree;
+  tree->SetDataSet(dataset);
+  tree->BuildLocator();
+  vtkNew<vtkIdList> cells;
+  cells->SetNumberOfIds(dataset->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < dataset->GetNumberOfCells(); ++cellId)
+  {
+    cells->SetId(cellId, cellId);
+  }
+  double corner[3], max[3], mid[3], min[3], size[3];
+  tree->ComputeCellsOBB(cells, corner, max, mid, min, size);
+  double expected[5][3];
+  tree->ComputeOBB(dataset, expected[0], expected[1], expected[2], expected[3], expected[4]);
+  const double* actual[5] = { corner, max, mid, min, size };
+  for (int i = 0; i < 5; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      if (actual[i][j] != expected[i][j])
+      {
+        std::cerr << "Wrong OBB of the cells of a built vtkOBBTree" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestCellLocatorsParallel(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+  sphere->Update();
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(36);
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> queryPoints;
+  for (int q = 0; q < 2 * NumberOfQueries; ++q)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetRangeValue(-0.99, 0.99);
+    }
+    queryPoints->InsertNextPoint(x);
+  }
+
+  vtkDataSet* datasets[2] = { sphere->GetOutput(), grid };
+  if (!TestCellsOBB(datasets[0]))
+  {
+    return EXIT_FAILURE;
+  }
+  for (int d = 0; d < 2; ++d)
+  {
+    // vtkOBBTree does not locate points in cells
+    for (int i = 0; i < (d == 0 ? NumberOfLocators : NumberOfLocators - 1); ++i)
+    {
+      const bool findCells = d == 1;
+      QueryResults results = Query(i, datasets[d], queryPoints, findCells);
+      vtkSMPTools::Initialize(1);
+      QueryResults serialResults = Query(i, datasets[d], queryPoints, findCells);
+      vtkSMPTools::Initialize();
+      if (results.T != serialResults.T || results.CellIds != serialResults.CellIds)
+      {
+        std::cerr << "Queries of " << NewLocator(i)->GetClassName() << " on dataset " << d
+                  << " differ with a single thread" << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (vtkIdType cellId : results.CellIds)
+      {
+        if (cellId == -2)
+        {
+          std::cerr << NewLocator(i)->GetClassName() << " failed to locate a point" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
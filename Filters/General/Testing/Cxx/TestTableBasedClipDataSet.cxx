@@ -0,0 +1,294 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTableBasedClipDataSet.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Clip the same grid stored as rectilinear, structured and unstructured grids
+// with vtkTableBasedClipDataSet, and check that the outputs are identical,
+// that the points are merged and interpolated, and that the output does not
+// depend on the number of threads. Image data is checked likewise.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const double IsoValue = 9.3;
+
+double Coordinate(int i)
+{
+  return 1.1 * i + 0.05 * i * i;
+}
+
+double ScalarValue(const double x[3])
+{
+  return x[0] + 0.7 * x[1] + 0.3 * x[2];
+}
+
+double DataValue(const double x[3])
+{
+  return 2.0 * x[0] - x[1] + 3.0 * x[2];
+}
+
+void AddPointData(vtkDataSet* grid)
+{
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> data;
+  data->SetName("Data");
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    grid->GetPoint(i, x);
+    scalars->InsertNextValue(ScalarValue(x));
+    data->InsertNextValue(DataValue(x));
+  }
+  grid->GetPointData()->SetScalars(scalars);
+  grid->GetPointData()->AddArray(data);
+}
+
+void MakeRectilinearGrid(const int dims[3], vtkRectilinearGrid* grid)
+{
+  grid->SetDimensions(dims[0], dims[1], dims[2]);
+  vtkNew<vtkDoubleArray> coords[3];
+  for (int j = 0; j < 3; ++j)
+  {
+    for (int i = 0; i < dims[j]; ++i)
+    {
+      coords[j]->InsertNextValue(Coordinate(i));
+    }
+  }
+  grid->SetXCoordinates(coords[0]);
+  grid->SetYCoordinates(coords[1]);
+  grid->SetZCoordinates(coords[2]);
+  AddPointData(grid);
+}
+
+// The origin and spacing keep the points off the clip surface.
+void MakeImageData(const int dims[3], vtkImageData* image)
+{
+  image->SetDimensions(dims[0], dims[1], dims[2]);
+  image->SetOrigin(-0.31, 0.23, 0.17);
+  image->SetSpacing(1.07, 0.93, 1.21);
+  AddPointData(image);
+}
+
+void MakeStructuredGrid(vtkRectilinearGrid* rectGrid, vtkStructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  for (vtkIdType i = 0; i < rectGrid->GetNumberOfPoints(); ++i)
+  {
+    points->InsertNextPoint(rectGrid->GetPoint(i));
+  }
+  grid->SetDimensions(rectGrid->GetDimensions());
+  grid->SetPoints(points);
+  AddPointData(grid);
+}
+
+void MakeUnstructuredGrid(vtkStructuredGrid* structGrid, vtkUnstructuredGrid* grid)
+{
+  grid->SetPoints(structGrid->GetPoints());
+  grid->Allocate(structGrid->GetNumberOfCells());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < structGrid->GetNumberOfCells(); ++cellId)
+  {
+    structGrid->GetCellPoints(cellId, ptIds);
+    grid->InsertNextCell(VTK_HEXAHEDRON, ptIds);
+  }
+  AddPointData(grid);
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> Clip(vtkDataSet* grid, bool insideOut)
+{
+  vtkNew<vtkTableBasedClipDataSet> clipper;
+  clipper->SetInputData(grid);
+  clipper->SetValue(IsoValue);
+  clipper->SetInsideOut(insideOut);
+  clipper->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  clipper->Update();
+  return clipper->GetOutput();
+}
+
+// Check that the points are on the kept side, that the data is interpolated,
+// and that no point is duplicated.
+bool CheckOutput(vtkUnstructuredGrid* output, bool insideOut)
+{
+  if (output->GetNumberOfCells() == 0)
+  {
+    std::cerr << "Empty output" << std::endl;
+    return false;
+  }
+  vtkDataArray* data = output->GetPointData()->GetArray("Data");
+  if (!data)
+  {
+    std::cerr << "Missing point data" << std::endl;
+    return false;
+  }
+  std::vector<std::array<double, 3>> points(output->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    output->GetPoint(i, x);
+    double s = ScalarValue(x) - IsoValue;
+    if ((insideOut ? s : -s) > 1e-6 || std::fabs(data->GetTuple1(i) - DataValue(x)) > 1e-6)
+    {
+      std::cerr << "Wrong point " << i << std::endl;
+      return false;
+    }
+    points[i] = { x[0], x[1], x[2] };
+  }
+  std::sort(points.begin(), points.end());
+  if (std::adjacent_find(points.begin(), points.end()) != points.end())
+  {
+    std::cerr << "Duplicate points" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool SameOutput(vtkUnstructuredGrid* output1, vtkUnstructuredGrid* output2)
+{
+  if (output1->GetNumberOfPoints() != output2->GetNumberOfPoints() ||
+    output1->GetNumberOfCells() != output2->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < output1->GetNumberOfPoints(); ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      if (output1->GetPoint(i)[j] != output2->GetPoint(i)[j])
+      {
+        return false;
+      }
+    }
+  }
+  vtkNew<vtkIdList> pts1, pts2;
+  for (vtkIdType i = 0; i < output1->GetNumberOfCells(); ++i)
+  {
+    output1->GetCellPoints(i, pts1);
+    output2->GetCellPoints(i, pts2);
+    if (output1->GetCellType(i) != output2->GetCellType(i) ||
+      pts1->GetNumberOfIds() != pts2->GetNumberOfIds())
+    {
+      return false;
+    }
+    for (vtkIdType j = 0; j < pts1->GetNumberOfIds(); ++j)
+    {
+      if (pts1->GetId(j) != pts2->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestTableBasedClipDataSet(int, char*[])
+{
+  const int dims[3] = { 23, 19, 17 };
+  vtkNew<vtkRectilinearGrid> rectGrid;
+  MakeRectilinearGrid(dims, rectGrid);
+  vtkNew<vtkStructuredGrid> structGrid;
+  MakeStructuredGrid(rectGrid, structGrid);
+  vtkNew<vtkUnstructuredGrid> unstructGrid;
+  MakeUnstructuredGrid(structGrid, unstructGrid);
+  vtkNew<vtkImageData> image;
+  MakeImageData(dims, image);
+  vtkDataSet* grids[4] = { rectGrid, structGrid, unstructGrid, image };
+
+  for (int insideOut = 0; insideOut < 2; ++insideOut)
+  {
+    vtkSmartPointer<vtkUnstructuredGrid> rectOutput = Clip(rectGrid, insideOut != 0);
+    vtkSmartPointer<vtkUnstructuredGrid> structOutput = Clip(structGrid, insideOut != 0);
+    vtkSmartPointer<vtkUnstructuredGrid> unstructOutput = Clip(unstructGrid, insideOut != 0);
+    if (!CheckOutput(unstructOutput, insideOut != 0))
+    {
+      std::cerr << "Wrong output with InsideOut " << insideOut << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // the cells and points are ordered the same way for all grid types
+    if (!SameOutput(unstructOutput, structOutput) || !SameOutput(unstructOutput, rectOutput))
+    {
+      std::cerr << "Output differs between grid types with InsideOut " << insideOut << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkSmartPointer<vtkUnstructuredGrid> imageOutput = Clip(image, insideOut != 0);
+    if (!CheckOutput(imageOutput, insideOut != 0))
+    {
+      std::cerr << "Wrong output of image data with InsideOut " << insideOut << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // the output does not depend on the number of threads
+    for (vtkDataSet* grid : grids)
+    {
+      vtkSmartPointer<vtkUnstructuredGrid> output = Clip(grid, insideOut != 0);
+      vtkSMPTools::Initialize(1);
+      vtkSmartPointer<vtkUnstructuredGrid> serialOutput = Clip(grid, insideOut != 0);
+      vtkSMPTools::Initialize();
+      if (!SameOutput(output, serialOutput))
+      {
+        std::cerr << "Output of " << grid->GetClassName()
+                  << " differs with a single thread with InsideOut " << insideOut << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // a 2D grid in the XZ plane is clipped as quads
+  const int dims2D[3] = { 31, 1, 29 };
+  vtkNew<vtkRectilinearGrid> rectGrid2D;
+  MakeRectilinearGrid(dims2D, rectGrid2D);
+  vtkSmartPointer<vtkUnstructuredGrid> output2D = Clip(rectGrid2D, false);
+  if (!CheckOutput(output2D, false))
+  {
+    std::cerr << "Wrong output of 2D grid" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < output2D->GetNumberOfCells(); ++i)
+  {
+    int cellType = output2D->GetCellType(i);
+    if (cellType != VTK_QUAD && cellType != VTK_TRIANGLE)
+    {
+      std::cerr << "Unexpected cell type " << cellType << " in the output of 2D grid"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,221 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeCellLocators.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time the build of the cell locators with one thread and with all the
+// threads, and their line intersection and point location queries.
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkMath.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkOBBTree.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+const int NumberOfLocators = 5;
+const char* LocatorNames[NumberOfLocators] = { "Cell", "Static", "Cell Tree", "BSP Tree",
+  "OBB Tree" };
+
+vtkSmartPointer<vtkAbstractCellLocator> NewLocator(int i)
+{
+  vtkSmartPointer<vtkAbstractCellLocator> locator;
+  switch (i)
+  {
+    case 0:
+      locator = vtkSmartPointer<vtkCellLocator>::New();
+      break;
+    case 1:
+      locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+      break;
+    case 2:
+      locator = vtkSmartPointer<vtkCellTreeLocator>::New();
+      break;
+    case 3:
+      locator = vtkSmartPointer<vtkModifiedBSPTree>::New();
+      break;
+    default:
+      locator = vtkSmartPointer<vtkOBBTree>::New();
+      break;
+  }
+  // build the locators in BuildLocator(), not on the first query
+  locator->LazyEvaluationOff();
+  return locator;
+}
+
+// A grid of dim^3 hexahedra in [-1,1]^3
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int dim)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= dim; ++k)
+  {
+    for (int j = 0; j <= dim; ++j)
+    {
+      for (int i = 0; i <= dim; ++i)
+      {
+        points->InsertNextPoint(-1.0 + 2.0 * i / dim, -1.0 + 2.0 * j / dim, -1.0 + 2.0 * k / dim);
+      }
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate(dim * dim * dim);
+  const vtkIdType n = dim + 1;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        vtkIdType p = i + n * (j + n * k);
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n, p + 1 + n * n,
+          p + 1 + n + n * n, p + n + n * n };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+  return grid;
+}
+
+// Time the build of a locator, deleting it as well
+double TimeBuild(int i, vtkDataSet* dataset, vtkTimerLog* timer)
+{
+  timer->StartTimer();
+  vtkSmartPointer<vtkAbstractCellLocator> locator = NewLocator(i);
+  locator->SetDataSet(dataset);
+  locator->BuildLocator();
+  locator = nullptr;
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+}
+
+int TimeCellLocators(int, char*[])
+{
+  const int nQ = 1000;
+  vtkNew<vtkTimerLog> timer;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(400);
+  sphere->SetPhiResolution(400);
+  sphere->Update();
+  vtkPolyData* surface = sphere->GetOutput();
+  vtkSmartPointer<vtkUnstructuredGrid> volume = MakeGrid(60);
+
+  cout << "\nTiming for " << surface->GetNumberOfCells() << " triangles, "
+       << volume->GetNumberOfCells() << " hexahedra, " << nQ << " queries, "
+       << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  // Lines through the sphere, and points in the grid
+  vtkMath::RandomSeed(314159);
+  vtkNew<vtkPoints> lineEnds;
+  vtkNew<vtkPoints> qPoints;
+  for (int i = 0; i < nQ; ++i)
+  {
+    lineEnds->InsertNextPoint(
+      vtkMath::Random(-1, 1), vtkMath::Random(-1, 1), vtkMath::Random(-1, 1));
+    lineEnds->InsertNextPoint(
+      vtkMath::Random(-1, 1), vtkMath::Random(-1, 1), vtkMath::Random(-1, 1));
+    qPoints->InsertNextPoint(
+      vtkMath::Random(-1, 1), vtkMath::Random(-1, 1), vtkMath::Random(-1, 1));
+  }
+
+  double serialBuildTime[2][NumberOfLocators], buildTime[2][NumberOfLocators];
+  double lineTime[NumberOfLocators], findCellTime[NumberOfLocators];
+  vtkNew<vtkGenericCell> cell;
+  for (int i = 0; i < NumberOfLocators; ++i)
+  {
+    vtkDataSet* datasets[2] = { surface, volume };
+    for (int d = 0; d < 2; ++d)
+    {
+      vtkSMPTools::Initialize(1);
+      serialBuildTime[d][i] = TimeBuild(i, datasets[d], timer);
+      vtkSMPTools::Initialize();
+      buildTime[d][i] = TimeBuild(i, datasets[d], timer);
+    }
+
+    vtkSmartPointer<vtkAbstractCellLocator> locator = NewLocator(i);
+    locator->SetDataSet(surface);
+    locator->BuildLocator();
+    double p1[3], p2[3], t, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId;
+    timer->StartTimer();
+    for (int j = 0; j < nQ; ++j)
+    {
+      lineEnds->GetPoint(2 * j, p1);
+      lineEnds->GetPoint(2 * j + 1, p2);
+      locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell);
+    }
+    timer->StopTimer();
+    lineTime[i] = timer->GetElapsedTime();
+
+    // vtkOBBTree does not locate points in cells
+    findCellTime[i] = 0.0;
+    if (i < NumberOfLocators - 1)
+    {
+      locator = NewLocator(i);
+      locator->SetDataSet(volume);
+      locator->BuildLocator();
+      double weights[8];
+      timer->StartTimer();
+      for (int j = 0; j < nQ; ++j)
+      {
+        qPoints->GetPoint(j, x);
+        locator->FindCell(x, 0.0, cell, pcoords, weights);
+      }
+      timer->StopTimer();
+      findCellTime[i] = timer->GetElapsedTime();
+    }
+  }
+
+  //---------------------------------------------------------------------------
+  // Print out the statistics
+  const char* datasetNames[2] = { "triangles", "hexahedra" };
+  for (int d = 0; d < 2; ++d)
+  {
+    cout << "Build and delete locator of " << datasetNames[d] << " (1 thread / all threads)\n";
+    for (int i = 0; i < NumberOfLocators; ++i)
+    {
+      cout << "\t" << LocatorNames[i] << ": " << serialBuildTime[d][i] << " / " << buildTime[d][i]
+           << "\n";
+    }
+  }
+
+  cout << "Line intersection queries\n";
+  for (int i = 0; i < NumberOfLocators; ++i)
+  {
+    cout << "\t" << LocatorNames[i] << ": " << lineTime[i] << "\n";
+  }
+
+  cout << "Find cell queries\n";
+  for (int i = 0; i < NumberOfLocators - 1; ++i)
+  {
+    cout << "\t" << LocatorNames[i] << ": " << findCellTime[i] << "\n";
+  }
+
+  // Always return success, although the test infrastructure should catch
+  // excessive execution times.
+  return 0;
+}
@@ -21,6 +21,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include <algorithm>
 #include <cassert>
@@ -201,6 +203,12 @@ public:
 // This class builds the CellTree according to the algorithm given in the paper.
 // This class is derived from the avtCellLocatorBIH class in VisIT.  Member variables of this class
 // starts with m_*
+//
+// The bounds of the cells are computed in parallel. The nodes of at least m_parallelsize cells
+// are split one at a time, bucketing and partitioning their cells in parallel, and the smaller
+// nodes below them are the roots of subtrees built concurrently, then appended to the tree. How
+// a node is split only depends on its cells, so the tree does not depend on the number of
+// threads.
 //------------------------------------------------------------------------------
 class vtkCellTreeBuilder
 {
@@ -232,6 +240,20 @@ private:
         Max = _max;
       }
     }
+
+    void Merge(const Bucket& b)
+    {
+      Cnt += b.Cnt;
+      Min = std::min(Min, b.Min);
+      Max = std::max(Max, b.Max);
+    }
+  };
+
+  static const int NumberOfBuckets = 6;
+
+  struct Buckets
+  {
+    Bucket B[3][NumberOfBuckets];
   };
 
   struct PerCell
@@ -241,6 +263,13 @@ private:
     unsigned int Ind;
   };
 
+  // Bounds of a range of cells
+  struct Box
+  {
+    float Min[3];
+    float Max[3];
+  };
+
   struct CenterOrder
   {
     unsigned int d;
@@ -249,7 +278,7 @@ private:
     {
     }
 
-    bool operator()(const PerCell& pc0, const PerCell& pc1)
+    bool operator()(const PerCell& pc0, const PerCell& pc1) const
     {
       return (pc0.Min[d] + pc0.Max[d]) < (pc1.Min[d] + pc1.Max[d]);
     }
@@ -265,11 +294,107 @@ private:
     {
     }
 
-    bool operator()(const PerCell& pc) { return (pc.Min[d] + pc.Max[d]) < p; }
+    bool operator()(const PerCell& pc) const { return (pc.Min[d] + pc.Max[d]) < p; }
+  };
+
+  // Bucket the cells of a large node in parallel
+  struct BucketCells
+  {
+    const PerCell* Begin;
+    const float* Min;
+    const float* IExt;
+    vtkSMPThreadLocal<Buckets> LocalBuckets;
+    Buckets Result;
+
+    BucketCells(const PerCell* begin, const float* min, const float* iext)
+      : Begin(begin)
+      , Min(min)
+      , IExt(iext)
+    {
+    }
+
+    void Initialize() {}
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      AddToBuckets(this->Begin + begin, this->Begin + end, this->Min, this->IExt,
+        this->LocalBuckets.Local());
+    }
+
+    void Reduce()
+    {
+      for (const Buckets& b : this->LocalBuckets)
+      {
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+          for (int n = 0; n < NumberOfBuckets; ++n)
+          {
+            this->Result.B[d][n].Merge(b.B[d][n]);
+          }
+        }
+      }
+    }
+  };
+
+  // A node whose subtree is built by a single thread
+  struct Subtree
+  {
+    unsigned int Index;
+    float Min[3];
+    float Max[3];
+    std::vector<vtkCellTreeLocator::vtkCellTreeNode> Nodes;
   };
 
   // -------------------------------------------------------------------------
 
+  static void AddToBuckets(
+    const PerCell* begin, const PerCell* end, const float* min, const float* iext, Buckets& b)
+  {
+    for (const PerCell* pc = begin; pc != end; ++pc)
+    {
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        float cen = (pc->Min[d] + pc->Max[d]) / 2.0f;
+        int ind = (int)((cen - min[d]) * iext[d]);
+
+        if (ind < 0)
+        {
+          ind = 0;
+        }
+
+        if (ind >= NumberOfBuckets)
+        {
+          ind = NumberOfBuckets - 1;
+        }
+
+        b.B[d][ind].Add(pc->Min[d], pc->Max[d]);
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+
+  static Box CellBox(const PerCell& pc)
+  {
+    Box box;
+    std::copy(pc.Min, pc.Min + 3, box.Min);
+    std::copy(pc.Max, pc.Max + 3, box.Max);
+    return box;
+  }
+
+  static Box MergeBoxes(const Box& box0, const Box& box1)
+  {
+    Box box;
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      box.Min[d] = std::min(box0.Min[d], box1.Min[d]);
+      box.Max[d] = std::max(box0.Max[d], box1.Max[d]);
+    }
+    return box;
+  }
+
+  // -------------------------------------------------------------------------
+
   void FindMinMax(const PerCell* begin, const PerCell* end, float* min, float* max)
   {
     if (begin == end)
@@ -277,6 +402,17 @@ private:
       return;
     }
 
+    if (static_cast<unsigned int>(end - begin) >= this->m_parallelsize)
+    {
+      Box init;
+      std::fill(init.Min, init.Min + 3, std::numeric_limits<float>::max());
+      std::fill(init.Max, init.Max + 3, -std::numeric_limits<float>::max());
+      const Box box = vtkSMPTools::TransformReduce(begin, end, init, MergeBoxes, CellBox);
+      std::copy(box.Min, box.Min + 3, min);
+      std::copy(box.Max, box.Max + 3, max);
+      return;
+    }
+
     for (unsigned int d = 0; d < 3; ++d)
     {
       min[d] = begin->Min[d];
@@ -297,47 +433,40 @@ private:
 
   // -------------------------------------------------------------------------
 
-  void Split(unsigned int index, float min[3], float max[3])
+  // Split a node into two children appended to nodes and give their bounds, or return false if
+  // the node remains a leaf.
+  bool SplitNode(std::vector<vtkCellTreeLocator::vtkCellTreeNode>& nodes, unsigned int index,
+    const float min[3], const float max[3], float childMin[2][3], float childMax[2][3])
   {
-    unsigned int start = this->m_nodes[index].Start();
-    unsigned int size = this->m_nodes[index].Size();
+    unsigned int start = nodes[index].Start();
+    unsigned int size = nodes[index].Size();
 
     if (size < this->m_leafsize)
     {
-      return;
+      return false;
     }
 
     PerCell* begin = &(this->m_pc[start]);
     PerCell* end = &(this->m_pc[0]) + start + size;
     PerCell* mid = begin;
-
-    const int nbuckets = 6;
+    const bool parallel = size >= this->m_parallelsize;
 
     const float ext[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
-    const float iext[3] = { nbuckets / ext[0], nbuckets / ext[1], nbuckets / ext[2] };
-
-    Bucket b[3][nbuckets];
+    const float iext[3] = { NumberOfBuckets / ext[0], NumberOfBuckets / ext[1],
+      NumberOfBuckets / ext[2] };
 
-    for (const PerCell* pc = begin; pc != end; ++pc)
+    Buckets buckets;
+    if (parallel)
     {
-      for (unsigned int d = 0; d < 3; ++d)
-      {
-        float cen = (pc->Min[d] + pc->Max[d]) / 2.0f;
-        int ind = (int)((cen - min[d]) * iext[d]);
-
-        if (ind < 0)
-        {
-          ind = 0;
-        }
-
-        if (ind >= nbuckets)
-        {
-          ind = nbuckets - 1;
-        }
-
-        b[d][ind].Add(pc->Min[d], pc->Max[d]);
-      }
+      BucketCells bucketCells(begin, min, iext);
+      vtkSMPTools::For(0, size, bucketCells);
+      buckets = bucketCells.Result;
     }
+    else
+    {
+      AddToBuckets(begin, end, min, iext, buckets);
+    }
+    const Bucket(&b)[3][NumberOfBuckets] = buckets.B;
 
     float cost = std::numeric_limits<float>::max();
     float plane = VTK_FLOAT_MIN;    // bad value in case it doesn't get setx
@@ -347,7 +476,7 @@ private:
     {
       unsigned int sum = 0;
 
-      for (unsigned int n = 0; n < (unsigned int)nbuckets - 1; ++n)
+      for (unsigned int n = 0; n < (unsigned int)NumberOfBuckets - 1; ++n)
       {
         float lmax = -std::numeric_limits<float>::max();
         float rmin = std::numeric_limits<float>::max();
@@ -360,7 +489,7 @@ private:
           }
         }
 
-        for (unsigned int m = n + 1; m < (unsigned int)nbuckets; ++m)
+        for (unsigned int m = n + 1; m < (unsigned int)NumberOfBuckets; ++m)
         {
           if (b[d][m].Min < rmin)
           {
@@ -393,7 +522,9 @@ private:
 
     if (cost != std::numeric_limits<float>::max())
     {
-      mid = std::partition(begin, end, LeftPredicate(dim, plane));
+      // large nodes are partitioned in parallel, keeping the order of their cells
+      mid = parallel ? vtkSMPTools::Partition(begin, end, LeftPredicate(dim, plane))
+                     : std::partition(begin, end, LeftPredicate(dim, plane));
     }
 
     // fallback
@@ -405,22 +536,95 @@ private:
       std::nth_element(begin, mid, end, CenterOrder(dim));
     }
 
-    float lmin[3], lmax[3], rmin[3], rmax[3];
+    FindMinMax(begin, mid, childMin[0], childMax[0]);
+    FindMinMax(mid, end, childMin[1], childMax[1]);
 
-    FindMinMax(begin, mid, lmin, lmax);
-    FindMinMax(mid, end, rmin, rmax);
-
-    float clip[2] = { lmax[dim], rmin[dim] };
+    float clip[2] = { childMax[0][dim], childMin[1][dim] };
 
     vtkCellTreeLocator::vtkCellTreeNode child[2];
     child[0].MakeLeaf(begin - &(this->m_pc[0]), mid - begin);
     child[1].MakeLeaf(mid - &(this->m_pc[0]), end - mid);
 
-    this->m_nodes[index].MakeNode((int)m_nodes.size(), dim, clip);
-    this->m_nodes.insert(m_nodes.end(), child, child + 2);
+    nodes[index].MakeNode((int)nodes.size(), dim, clip);
+    nodes.insert(nodes.end(), child, child + 2);
+    return true;
+  }
+
+  // -------------------------------------------------------------------------
+
+  void Split(std::vector<vtkCellTreeLocator::vtkCellTreeNode>& nodes, unsigned int index,
+    const float min[3], const float max[3])
+  {
+    float childMin[2][3], childMax[2][3];
+    if (this->SplitNode(nodes, index, min, max, childMin, childMax))
+    {
+      const unsigned int left = nodes[index].GetLeftChildIndex();
+      Split(nodes, left, childMin[0], childMax[0]);
+      Split(nodes, left + 1, childMin[1], childMax[1]);
+    }
+  }
+
+  // -------------------------------------------------------------------------
+
+  // Split the root node, given its bounds, into the tree m_nodes
+  void BuildNodes(const float min[3], const float max[3])
+  {
+    Subtree root;
+    root.Index = 0;
+    std::copy(min, min + 3, root.Min);
+    std::copy(max, max + 3, root.Max);
+
+    // split the large nodes, and gather the roots of the subtrees below them
+    std::vector<Subtree> large(1, root);
+    std::vector<Subtree> subtrees;
+    while (!large.empty())
+    {
+      Subtree node = large.back();
+      large.pop_back();
+      if (this->m_nodes[node.Index].Size() < this->m_parallelsize)
+      {
+        subtrees.push_back(node);
+        continue;
+      }
+      float childMin[2][3], childMax[2][3];
+      if (this->SplitNode(this->m_nodes, node.Index, node.Min, node.Max, childMin, childMax))
+      {
+        for (int c = 1; c >= 0; --c)
+        {
+          Subtree child;
+          child.Index = this->m_nodes[node.Index].GetLeftChildIndex() + c;
+          std::copy(childMin[c], childMin[c] + 3, child.Min);
+          std::copy(childMax[c], childMax[c] + 3, child.Max);
+          large.push_back(child);
+        }
+      }
+    }
+
+    // build the subtrees, whose cells do not overlap
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+      [&](vtkIdType first, vtkIdType last) {
+        for (; first < last; ++first)
+        {
+          Subtree& subtree = subtrees[first];
+          subtree.Nodes.push_back(this->m_nodes[subtree.Index]);
+          this->Split(subtree.Nodes, 0, subtree.Min, subtree.Max);
+        }
+      });
 
-    Split(this->m_nodes[index].GetLeftChildIndex(), lmin, lmax);
-    Split(this->m_nodes[index].GetRightChildIndex(), rmin, rmax);
+    // append the subtrees, whose root replaces the node they were built from
+    for (Subtree& subtree : subtrees)
+    {
+      const unsigned int offset = static_cast<unsigned int>(this->m_nodes.size()) - 1;
+      for (vtkCellTreeLocator::vtkCellTreeNode& node : subtree.Nodes)
+      {
+        if (node.IsNode())
+        {
+          node.SetChildren(node.GetLeftChildIndex() + offset);
+        }
+      }
+      this->m_nodes[subtree.Index] = subtree.Nodes[0];
+      this->m_nodes.insert(this->m_nodes.end(), subtree.Nodes.begin() + 1, subtree.Nodes.end());
+    }
   }
 
 public:
@@ -428,53 +632,48 @@ public:
   {
     this->m_buckets = 5;
     this->m_leafsize = 8;
+    this->m_parallelsize = 32768;
   }
 
   void Build(vtkCellTreeLocator* ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds)
   {
     const vtkIdType size = ds->GetNumberOfCells();
-    double cellBounds[6];
+    double(*cellBounds)[6] = ctl->CellBounds;
     this->m_pc.resize(size);
 
-    float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-      std::numeric_limits<float>::max() };
-
-    float max[3] = {
-      -std::numeric_limits<float>::max(),
-      -std::numeric_limits<float>::max(),
-      -std::numeric_limits<float>::max(),
-    };
-
-    for (vtkIdType i = 0; i < size; ++i)
+    if (!cellBounds)
     {
-      this->m_pc[i].Ind = i;
-
-      double* boundsPtr = cellBounds;
-      if (ctl->CellBounds)
-      {
-        boundsPtr = ctl->CellBounds[i];
-      }
-      else
-      {
-        ds->GetCellBounds(i, boundsPtr);
-      }
-
-      for (int d = 0; d < 3; ++d)
+      // GetCellBounds() is thread safe once called
+      double bounds[6];
+      ds->GetCellBounds(0, bounds);
+    }
+    vtkSMPTools::For(0, size, [&](vtkIdType begin, vtkIdType end) {
+      double bounds[6];
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
-        this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
+        PerCell& pc = this->m_pc[i];
+        pc.Ind = i;
 
-        if (this->m_pc[i].Min[d] < min[d])
+        const double* boundsPtr = bounds;
+        if (cellBounds)
         {
-          min[d] = this->m_pc[i].Min[d];
+          boundsPtr = cellBounds[i];
+        }
+        else
+        {
+          ds->GetCellBounds(i, bounds);
         }
 
-        if (this->m_pc[i].Max[d] > max[d]) /// This can be m_pc[i].max[d] instead of min
+        for (int d = 0; d < 3; ++d)
         {
-          max[d] = this->m_pc[i].Max[d];
+          pc.Min[d] = boundsPtr[2 * d + 0];
+          pc.Max[d] = boundsPtr[2 * d + 1];
         }
       }
-    }
+    });
+
+    float min[3], max[3];
+    FindMinMax(&(this->m_pc[0]), &(this->m_pc[0]) + size, min, max);
 
     ct.DataBBox[0] = min[0];
     ct.DataBBox[1] = max[0];
@@ -487,7 +686,7 @@ public:
     root.MakeLeaf(0, size);
     this->m_nodes.push_back(root);
 
-    Split(0, min, max);
+    BuildNodes(min, max);
 
     ct.Nodes.resize(this->m_nodes.size());
     ct.Nodes[0] = this->m_nodes[0];
@@ -512,16 +711,19 @@ public:
 
     ct.Leaves.resize(size);
 
-    for (int i = 0; i < size; ++i)
-    {
-      ct.Leaves[i] = this->m_pc[i].Ind;
-    }
+    vtkSMPTools::For(0, size, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        ct.Leaves[i] = this->m_pc[i].Ind;
+      }
+    });
 
     this->m_pc.clear();
   }
 
   unsigned int m_buckets;
   unsigned int m_leafsize;
+  unsigned int m_parallelsize; // the number of cells of the nodes split in parallel
   std::vector<PerCell> m_pc;
   std::vector<vtkCellTreeLocator::vtkCellTreeNode> m_nodes;
 };
@@ -32,6 +32,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyhedron.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -306,10 +308,19 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
     {
       inPD->SetScalars(tmpScalars);
     }
-    for (i = 0; i < numPts; i++)
+    // evaluate the clip function at once for point sets
+    vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
+    if (inputPointSet && inputPointSet->GetPoints())
+    {
+      this->ClipFunction->FunctionValue(inputPointSet->GetPoints()->GetData(), tmpScalars);
+    }
+    else
     {
-      s = this->ClipFunction->FunctionValue(input->GetPoint(i));
-      tmpScalars->SetTuple1(i, s);
+      for (i = 0; i < numPts; i++)
+      {
+        s = this->ClipFunction->FunctionValue(input->GetPoint(i));
+        tmpScalars->SetTuple1(i, s);
+      }
     }
     clipScalars = tmpScalars;
   }
@@ -23,9 +23,13 @@
 #include "vtkPlane.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 vtkStandardNewMacro(vtkOBBTree);
@@ -272,7 +276,9 @@ void vtkOBBTree::ComputeOBB(
 
   this->DataSet = origDataSet;
   delete[] this->InsertedPoints;
+  this->InsertedPoints = nullptr;
   this->PointsList->Delete();
+  this->PointsList = nullptr;
   cellList->Delete();
 }
 
@@ -291,6 +297,23 @@ void vtkOBBTree::ComputeOBB(
   double tMin[3], tMax[3], closest[3], t;
   double dp0[3], dp1[3], tri_mass, tot_mass, c[3];
 
+  // BuildLocator() does not allocate the scratch lists: when called outside
+  // of ComputeOBB(vtkDataSet*), e.g. by a subclass, allocate them for the
+  // call.
+  if (!this->InsertedPoints || !this->PointsList)
+  {
+    const vtkIdType numDataSetPts = this->DataSet->GetNumberOfPoints();
+    this->InsertedPoints = new int[numDataSetPts]();
+    this->PointsList = vtkPoints::New();
+    this->PointsList->Allocate(numDataSetPts);
+    this->ComputeOBB(cells, corner, max, mid, min, size);
+    delete[] this->InsertedPoints;
+    this->InsertedPoints = nullptr;
+    this->PointsList->Delete();
+    this->PointsList = nullptr;
+    return;
+  }
+
   this->OBBCount++;
   this->PointsList->Reset();
   //
@@ -1039,6 +1062,434 @@ void vtkOBBNode::DebugPrintTree(int level, double* leaf_vol, int* minCells, int*
   }
 }
 
+namespace
+{
+// The nodes of at least this number of cells are built one at a time, their
+// OBB and split computed in parallel. The smaller ones are the roots of
+// subtrees built concurrently, each one by a single thread.
+const vtkIdType OBBParallelCells = 32768;
+
+// The size of the blocks of cells whose moments are summed in parallel. The
+// blocks only depend on the number of cells, so that the tree does not depend
+// on the number of threads.
+const vtkIdType OBBBlockSize = 4096;
+
+// The moments of a block of cells, and the range of the projections of
+// their points on the axes of the OBB.
+struct vtkOBBBlock
+{
+  double Mass;
+  double Mean[3];
+  double A[3][3];
+  double TMin[3];
+  double TMax[3];
+};
+
+// The parametric coordinate of the projection of x on the line through p1
+// along p21, as computed by vtkLine::DistanceToLine() where p2 = p1 + p21.
+inline double ProjectOnAxis(const double x[3], const double p1[3], const double p21[3],
+  double denom)
+{
+  const double num = p21[0] * (x[0] - p1[0]) + p21[1] * (x[1] - p1[1]) + p21[2] * (x[2] - p1[2]);
+  if (num == 0.0)
+  {
+    return 0.0;
+  }
+  if (denom < fabs(VTK_TOL * num)) // numerically bad!
+  {
+    return num > 0 ? VTK_DOUBLE_MAX : VTK_DOUBLE_MIN;
+  }
+  return num / denom;
+}
+
+// A node whose subtree remains to be built, with the deepest level and the
+// number of nodes of the subtree once built.
+struct vtkOBBSubtree
+{
+  vtkIdList* Cells;
+  vtkOBBNode* Node;
+  int Level;
+  int DeepestLevel;
+  int NumberOfNodes;
+};
+
+// Build the nodes of a vtkOBBTree. The cells and points of the dataset are
+// accessed concurrently, through thread safe methods only.
+class vtkOBBTreeBuilder
+{
+public:
+  vtkDataSet* DataSet;
+  int MaxLevel;
+  int NumberOfCellsPerNode;
+  bool RetainCellLists;
+  vtkSMPThreadLocalObject<vtkIdList> CellPoints;
+
+  // Call functor(begin, end, cellPts) on the range [0, num), concurrently
+  // when parallel, with a list to gather the points of the cells.
+  template <typename FunctorT>
+  void ForEach(vtkIdType num, bool parallel, const FunctorT& functor)
+  {
+    if (parallel)
+    {
+      vtkSMPTools::For(0, num,
+        [&](vtkIdType begin, vtkIdType end) { functor(begin, end, this->CellPoints.Local()); });
+    }
+    else
+    {
+      functor(0, num, this->CellPoints.Local());
+    }
+  }
+
+  // Add the moments of inertia of the triangles of a cell.
+  void AddMoments(vtkIdType cellId, vtkIdList* cellPts, vtkOBBBlock& block)
+  {
+    const int type = this->DataSet->GetCellType(cellId);
+    this->DataSet->GetCellPoints(cellId, cellPts);
+    const vtkIdType numPts = cellPts->GetNumberOfIds();
+    const vtkIdType* ptIds = cellPts->GetPointer(0);
+    vtkIdType pId, qId, rId;
+    double p[3], q[3], r[3], dp0[3], dp1[3], c[3], xp[3];
+    for (vtkIdType j = 0; j < numPts - 2; j++)
+    {
+      vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
+      if (pId < 0)
+      {
+        continue;
+      }
+      this->DataSet->GetPoint(pId, p);
+      this->DataSet->GetPoint(qId, q);
+      this->DataSet->GetPoint(rId, r);
+      // p, q, and r are the oriented triangle points.
+      // Compute the components of the moment of inertia tensor.
+      for (int k = 0; k < 3; k++)
+      {
+        // two edge vectors
+        dp0[k] = q[k] - p[k];
+        dp1[k] = r[k] - p[k];
+        // centroid
+        c[k] = (p[k] + q[k] + r[k]) / 3;
+      }
+      vtkMath::Cross(dp0, dp1, xp);
+      const double triMass = 0.5 * vtkMath::Norm(xp);
+      block.Mass += triMass;
+      for (int k = 0; k < 3; k++)
+      {
+        block.Mean[k] += triMass * c[k];
+      }
+      double(*a)[3] = block.A;
+
+      // on-diagonal terms
+      a[0][0] += triMass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
+      a[1][1] += triMass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
+      a[2][2] += triMass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
+
+      // off-diagonal terms
+      a[0][1] += triMass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
+      a[0][2] += triMass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
+      a[1][2] += triMass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
+    }
+  }
+
+  // Compute the OBB of the cells as vtkOBBTree::ComputeOBB() does. The
+  // moments are summed by block, and the points shared by several cells
+  // are projected once per cell, which gives the same range.
+  void ComputeOBB(vtkIdList* cells, vtkOBBNode* node, bool parallel)
+  {
+    const vtkIdType numCells = cells->GetNumberOfIds();
+    const vtkIdType* cellIds = cells->GetPointer(0);
+    const vtkIdType blockSize = parallel ? OBBBlockSize : std::max<vtkIdType>(numCells, 1);
+    const vtkIdType numBlocks = (numCells + blockSize - 1) / blockSize;
+    std::vector<vtkOBBBlock> blocks(numBlocks);
+
+    this->ForEach(numBlocks, parallel, [&](vtkIdType blockId, vtkIdType endBlockId,
+                                         vtkIdList* cellPts) {
+      for (; blockId < endBlockId; ++blockId)
+      {
+        vtkOBBBlock& block = blocks[blockId];
+        block.Mass = 0.0;
+        std::fill_n(block.Mean, 3, 0.0);
+        std::fill_n(&block.A[0][0], 9, 0.0);
+        const vtkIdType end = std::min(numCells, (blockId + 1) * blockSize);
+        for (vtkIdType i = blockId * blockSize; i < end; ++i)
+        {
+          this->AddMoments(cellIds[i], cellPts, block);
+        }
+      }
+    });
+
+    double totMass = 0.0, mean[3] = { 0.0, 0.0, 0.0 };
+    double a0[3] = { 0.0, 0.0, 0.0 }, a1[3] = { 0.0, 0.0, 0.0 }, a2[3] = { 0.0, 0.0, 0.0 };
+    double* a[3] = { a0, a1, a2 };
+    for (const vtkOBBBlock& block : blocks)
+    {
+      totMass += block.Mass;
+      for (int i = 0; i < 3; i++)
+      {
+        mean[i] += block.Mean[i];
+        for (int j = i; j < 3; j++)
+        {
+          a[i][j] += block.A[i][j];
+        }
+      }
+    }
+
+    // normalize data
+    for (int i = 0; i < 3; i++)
+    {
+      mean[i] = mean[i] / totMass;
+    }
+
+    // matrix is symmetric
+    a1[0] = a0[1];
+    a2[0] = a0[2];
+    a2[1] = a1[2];
+
+    // get covariance from moments
+    for (int i = 0; i < 3; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        a[i][j] = a[i][j] / totMass - mean[i] * mean[j];
+      }
+    }
+
+    //
+    // Extract axes (i.e., eigenvectors) from covariance matrix.
+    //
+    double v0[3], v1[3], v2[3], size[3];
+    double* v[3] = { v0, v1, v2 };
+    vtkMath::Jacobi(a, size, v);
+    double axes[3][3];
+    for (int i = 0; i < 3; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        axes[i][j] = v[j][i];
+      }
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      a[0][i] = mean[i] + axes[0][i];
+      a[1][i] = mean[i] + axes[1][i];
+      a[2][i] = mean[i] + axes[2][i];
+    }
+
+    //
+    // Create oriented bounding box by projecting points onto eigenvectors.
+    //
+    double a21[3][3], denom[3];
+    for (int k = 0; k < 3; k++)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        a21[k][i] = a[k][i] - mean[i];
+      }
+      denom[k] = vtkMath::Dot(a21[k], a21[k]);
+    }
+    this->ForEach(numBlocks, parallel, [&](vtkIdType blockId, vtkIdType endBlockId,
+                                         vtkIdList* cellPts) {
+      double p[3], t;
+      for (; blockId < endBlockId; ++blockId)
+      {
+        vtkOBBBlock& block = blocks[blockId];
+        std::fill_n(block.TMin, 3, VTK_DOUBLE_MAX);
+        std::fill_n(block.TMax, 3, -VTK_DOUBLE_MAX);
+        const vtkIdType end = std::min(numCells, (blockId + 1) * blockSize);
+        for (vtkIdType i = blockId * blockSize; i < end; ++i)
+        {
+          this->DataSet->GetCellPoints(cellIds[i], cellPts);
+          for (vtkIdType j = 0; j < cellPts->GetNumberOfIds(); j++)
+          {
+            this->DataSet->GetPoint(cellPts->GetId(j), p);
+            for (int k = 0; k < 3; k++)
+            {
+              t = ProjectOnAxis(p, mean, a21[k], denom[k]);
+              block.TMin[k] = std::min(block.TMin[k], t);
+              block.TMax[k] = std::max(block.TMax[k], t);
+            }
+          }
+        }
+      }
+    });
+
+    double tMin[3], tMax[3];
+    std::fill_n(tMin, 3, VTK_DOUBLE_MAX);
+    std::fill_n(tMax, 3, -VTK_DOUBLE_MAX);
+    for (const vtkOBBBlock& block : blocks)
+    {
+      for (int k = 0; k < 3; k++)
+      {
+        tMin[k] = std::min(tMin[k], block.TMin[k]);
+        tMax[k] = std::max(tMax[k], block.TMax[k]);
+      }
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+      node->Corner[i] =
+        mean[i] + tMin[0] * axes[0][i] + tMin[1] * axes[1][i] + tMin[2] * axes[2][i];
+      for (int k = 0; k < 3; k++)
+      {
+        node->Axes[k][i] = (tMax[k] - tMin[k]) * axes[k][i];
+      }
+    }
+  }
+
+  // Whether a cell is on the negative side of the plane through p of normal
+  // n. The centroid of the cell decides when it straddles the plane.
+  bool IsOnNegativeSide(vtkIdType cellId, const double p[3], const double n[3], vtkIdList* cellPts)
+  {
+    this->DataSet->GetCellPoints(cellId, cellPts);
+    const vtkIdType numPts = cellPts->GetNumberOfIds();
+    double c[3] = { 0.0, 0.0, 0.0 }, x[3];
+    bool negative = false, positive = false;
+    for (vtkIdType j = 0; j < numPts; j++)
+    {
+      this->DataSet->GetPoint(cellPts->GetId(j), x);
+      const double val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
+      c[0] += x[0];
+      c[1] += x[1];
+      c[2] += x[2];
+      if (val < 0.0)
+      {
+        negative = true;
+      }
+      else
+      {
+        positive = true;
+      }
+    }
+    if (negative && positive)
+    { // Use centroid to decide straddle cases
+      c[0] /= numPts;
+      c[1] /= numPts;
+      c[2] /= numPts;
+      return n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0;
+    }
+    return negative;
+  }
+
+  // Split the cells of a node with a plane through the center of its OBB,
+  // normal to one of its axes, trying the three axes to find an acceptable
+  // split. The cells of the children are ordered as in the node.
+  bool SplitCells(vtkIdList* cells, vtkOBBNode* node, bool parallel, vtkIdList* lhList,
+    vtkIdList* rhList)
+  {
+    const vtkIdType numCells = cells->GetNumberOfIds();
+    const vtkIdType* cellIds = cells->GetPointer(0);
+    std::vector<unsigned char> negativeSide(numCells);
+    double p[3], n[3];
+    for (int i = 0; i < 3; i++) // compute split point
+    {
+      p[i] = node->Corner[i] + node->Axes[0][i] / 2.0 + node->Axes[1][i] / 2.0 +
+        node->Axes[2][i] / 2.0;
+    }
+
+    double bestRatio = 1.0; // worst case ratio
+    bool foundBestSplit = false;
+    for (int splitPlane = 0, bestPlane = 0; splitPlane < 3;)
+    {
+      // compute split normal
+      for (int i = 0; i < 3; i++)
+      {
+        n[i] = node->Axes[splitPlane][i];
+      }
+      vtkMath::Normalize(n);
+
+      // classify the cells, then assign them to the child lists in order
+      this->ForEach(numCells, parallel, [&](vtkIdType i, vtkIdType end, vtkIdList* cellPts) {
+        for (; i < end; ++i)
+        {
+          negativeSide[i] = this->IsOnNegativeSide(cellIds[i], p, n, cellPts);
+        }
+      });
+      const vtkIdType numInLHnode = std::count(negativeSide.begin(), negativeSide.end(), 1);
+      const vtkIdType numInRHnode = numCells - numInLHnode;
+      const double ratio = fabs((static_cast<double>(numInRHnode) - numInLHnode) / numCells);
+
+      // see whether we've found acceptable split plane
+      if (ratio < 0.6 || foundBestSplit) // accept right off the bat
+      {
+        lhList->SetNumberOfIds(numInLHnode);
+        rhList->SetNumberOfIds(numInRHnode);
+        vtkIdType* lhIds = lhList->GetPointer(0);
+        vtkIdType* rhIds = rhList->GetPointer(0);
+        for (vtkIdType i = 0; i < numCells; i++)
+        {
+          *(negativeSide[i] ? lhIds++ : rhIds++) = cellIds[i];
+        }
+        return true;
+      }
+
+      // not a great split try another
+      if (ratio < bestRatio)
+      {
+        bestRatio = ratio;
+        bestPlane = splitPlane;
+      }
+      if (++splitPlane == 3 && bestRatio < 0.95)
+      { // at closing time, even the ugly ones look good
+        splitPlane = bestPlane;
+        foundBestSplit = true;
+      }
+    }
+    return false;
+  }
+
+  // Create the children of a node whose OBB is computed, giving them their
+  // cells, or make it a leaf. The cells of the node are deleted unless they
+  // are retained by a leaf.
+  bool DivideNode(
+    vtkIdList* cells, vtkOBBNode* node, int level, bool parallel, vtkIdList* kidCells[2])
+  {
+    if (level < this->MaxLevel && cells->GetNumberOfIds() > this->NumberOfCellsPerNode)
+    {
+      kidCells[0] = vtkIdList::New();
+      kidCells[1] = vtkIdList::New();
+      if (this->SplitCells(cells, node, parallel, kidCells[0], kidCells[1]))
+      {
+        node->Kids = new vtkOBBNode*[2];
+        for (int i = 0; i < 2; i++)
+        {
+          node->Kids[i] = new vtkOBBNode;
+          node->Kids[i]->Parent = node;
+        }
+        cells->Delete(); // don't need to keep anymore
+        return true;
+      }
+      // free up local objects
+      kidCells[0]->Delete();
+      kidCells[1]->Delete();
+    }
+
+    if (this->RetainCellLists)
+    {
+      cells->Squeeze();
+      node->Cells = cells;
+    }
+    else
+    {
+      cells->Delete();
+    }
+    return false;
+  }
+
+  // Build a subtree by a single thread.
+  void BuildSubtree(vtkIdList* cells, vtkOBBNode* node, int level, vtkOBBSubtree& subtree)
+  {
+    subtree.DeepestLevel = std::max(subtree.DeepestLevel, level);
+    subtree.NumberOfNodes++;
+    this->ComputeOBB(cells, node, false);
+    vtkIdList* kidCells[2];
+    if (this->DivideNode(cells, node, level, false, kidCells))
+    {
+      this->BuildSubtree(kidCells[0], node->Kids[0], level + 1, subtree);
+      this->BuildSubtree(kidCells[1], node->Kids[1], level + 1, subtree);
+    }
+  }
+};
+}
+
 //
 //  Method to form subdivision of space based on the cells provided and
 //  subject to the constraints of levels and NumberOfCellsInOctant.
@@ -1046,7 +1497,7 @@ void vtkOBBNode::DebugPrintTree(int level, double* leaf_vol, int* minCells, int*
 //
 void vtkOBBTree::BuildLocator()
 {
-  vtkIdType numPts, numCells, i;
+  vtkIdType numPts, numCells;
   vtkIdList* cellList;
 
   vtkDebugMacro(<< "Building OBB tree");
@@ -1064,24 +1515,16 @@ void vtkOBBTree::BuildLocator()
     return;
   }
 
+  // Build the cells of a polydata now, they are accessed concurrently.
+  this->DataSet->GetCellType(0);
   this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->InsertedPoints[i] = 0;
-  }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
 
   //
   // Begin recursively creating OBB's
   //
   cellList = vtkIdList::New();
-  cellList->Allocate(numCells);
-  for (i = 0; i < numCells; i++)
-  {
-    cellList->InsertId(i, i);
-  }
+  cellList->SetNumberOfIds(numCells);
+  std::iota(cellList->GetPointer(0), cellList->GetPointer(0) + numCells, 0);
 
   if (this->Tree)
   {
@@ -1104,180 +1547,59 @@ void vtkOBBTree::BuildLocator()
     cout.flush();
   }
 
-  //
-  // Clean up
-  //
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-
   this->BuildTime.Modified();
 }
 
-// NOTE: for better memory usage this recursive method
-// frees its first argument
+// NOTE: for better memory usage this method frees its first argument.
+// The large nodes are built one at a time, computing their OBB and split in
+// parallel, then the subtrees of the smaller ones are built concurrently.
+// The tree only depends on the cells, not on the number of threads.
 void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 {
-  vtkIdType i, j, numCells = cells->GetNumberOfIds();
-  vtkIdType cellId;
-  vtkIdType ptId;
-  vtkIdList* cellPts = vtkIdList::New();
-  double size[3];
-
-  if (level > this->Level)
-  {
-    this->Level = level;
-  }
-  //
-  // Now compute the OBB
-  //
-  this->ComputeOBB(cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size);
-
-  //
-  // Check whether to continue recursing; if so, create two children and
-  // assign cells to appropriate child.
-  //
-  if (level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
-  {
-    vtkIdList* LHlist = vtkIdList::New();
-    LHlist->Allocate(cells->GetNumberOfIds() / 2);
-    vtkIdList* RHlist = vtkIdList::New();
-    RHlist->Allocate(cells->GetNumberOfIds() / 2);
-    double n[3], p[3], c[3], x[3], val, ratio, bestRatio;
-    int negative, positive, splitAcceptable, splitPlane;
-    int foundBestSplit, bestPlane = 0, numPts;
-    int numInLHnode, numInRHnode;
-
-    // loop over three split planes to find acceptable one
-    for (i = 0; i < 3; i++) // compute split point
+  vtkOBBTreeBuilder builder;
+  builder.DataSet = this->DataSet;
+  builder.MaxLevel = this->MaxLevel;
+  builder.NumberOfCellsPerNode = this->NumberOfCellsPerNode;
+  builder.RetainCellLists = this->RetainCellLists != 0;
+
+  std::vector<vtkOBBSubtree> subtrees;
+  std::vector<vtkOBBSubtree> nodes(1, vtkOBBSubtree{ cells, OBBptr, level, level, 0 });
+  while (!nodes.empty())
+  {
+    vtkOBBSubtree node = nodes.back();
+    nodes.pop_back();
+    if (node.Cells->GetNumberOfIds() < OBBParallelCells)
     {
-      p[i] = OBBptr->Corner[i] + OBBptr->Axes[0][i] / 2.0 + OBBptr->Axes[1][i] / 2.0 +
-        OBBptr->Axes[2][i] / 2.0;
+      subtrees.push_back(node);
+      continue;
     }
-
-    bestRatio = 1.0; // worst case ratio
-    foundBestSplit = 0;
-    for (splitPlane = 0, splitAcceptable = 0; !splitAcceptable && splitPlane < 3;)
+    this->Level = std::max(this->Level, node.Level);
+    this->OBBCount++;
+    builder.ComputeOBB(node.Cells, node.Node, true);
+    vtkIdList* kidCells[2];
+    if (builder.DivideNode(node.Cells, node.Node, node.Level, true, kidCells))
     {
-      // compute split normal
-      for (i = 0; i < 3; i++)
+      for (int i = 1; i >= 0; i--)
       {
-        n[i] = OBBptr->Axes[splitPlane][i];
+        nodes.push_back(vtkOBBSubtree{ kidCells[i], node.Node->Kids[i], node.Level + 1,
+          node.Level + 1, 0 });
       }
-      vtkMath::Normalize(n);
-
-      // traverse cells, assigning to appropriate child list as necessary
-      for (i = 0; i < numCells; i++)
-      {
-        cellId = cells->GetId(i);
-        this->DataSet->GetCellPoints(cellId, cellPts);
-        c[0] = c[1] = c[2] = 0.0;
-        numPts = cellPts->GetNumberOfIds();
-        for (negative = positive = j = 0; j < numPts; j++)
-        {
-          ptId = cellPts->GetId(j);
-          this->DataSet->GetPoint(ptId, x);
-          val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
-          c[0] += x[0];
-          c[1] += x[1];
-          c[2] += x[2];
-          if (val < 0.0)
-          {
-            negative = 1;
-          }
-          else
-          {
-            positive = 1;
-          }
-        }
-
-        if (negative && positive)
-        { // Use centroid to decide straddle cases
-          c[0] /= numPts;
-          c[1] /= numPts;
-          c[2] /= numPts;
-          if (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-        else
-        {
-          if (negative)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-      } // for all cells
-
-      // evaluate this split
-      numInLHnode = LHlist->GetNumberOfIds();
-      numInRHnode = RHlist->GetNumberOfIds();
-      ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
+    }
+  }
 
-      // see whether we've found acceptable split plane
-      if (ratio < 0.6 || foundBestSplit) // accept right off the bat
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+    [&](vtkIdType begin, vtkIdType end) {
+      for (; begin < end; ++begin)
       {
-        splitAcceptable = 1;
+        vtkOBBSubtree& subtree = subtrees[begin];
+        builder.BuildSubtree(subtree.Cells, subtree.Node, subtree.Level, subtree);
       }
-      else
-      { // not a great split try another
-        LHlist->Reset();
-        RHlist->Reset();
-        if (ratio < bestRatio)
-        {
-          bestRatio = ratio;
-          bestPlane = splitPlane;
-        }
-        if (++splitPlane == 3 && bestRatio < 0.95)
-        { // at closing time, even the ugly ones look good
-          splitPlane = bestPlane;
-          foundBestSplit = 1;
-        }
-      } // try another split
-
-    } // for each split
-
-    if (splitAcceptable) // otherwise recursion terminates
-    {
-      vtkOBBNode* LHnode = new vtkOBBNode;
-      vtkOBBNode* RHnode = new vtkOBBNode;
-      OBBptr->Kids = new vtkOBBNode*[2];
-      OBBptr->Kids[0] = LHnode;
-      OBBptr->Kids[1] = RHnode;
-      LHnode->Parent = OBBptr;
-      RHnode->Parent = OBBptr;
-
-      cells->Delete();
-      cells = nullptr; // don't need to keep anymore
-      this->BuildTree(LHlist, LHnode, level + 1);
-      this->BuildTree(RHlist, RHnode, level + 1);
-    }
-    else
-    {
-      // free up local objects
-      LHlist->Delete();
-      RHlist->Delete();
-    }
-  } // if should build tree
-
-  if (cells && this->RetainCellLists)
-  {
-    cells->Squeeze();
-    OBBptr->Cells = cells;
-  }
-  else if (cells)
+    });
+  for (const vtkOBBSubtree& subtree : subtrees)
   {
-    cells->Delete();
+    this->Level = std::max(this->Level, subtree.DeepestLevel);
+    this->OBBCount += subtree.NumberOfNodes;
   }
-  cellPts->Delete();
 }
 
 // Create polygonal representation for OBB tree at specified level. If
@@ -70,6 +70,11 @@ public:
    */
   void OperateOnBounds(double in[6], double out[6]) override;
 
+  /**
+   * The points are quantized.
+   */
+  bool OperatesOnPoints() override { return true; }
+
 protected:
   vtkQuantizePolyDataPoints();
   ~vtkQuantizePolyDataPoints() override = default;
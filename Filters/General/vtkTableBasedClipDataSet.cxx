@@ -45,18 +45,31 @@
 #include "vtkPlane.h"
 
 #include "vtkAppendFilter.h"
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 // NOLINTNEXTLINE(bugprone-suspicious-include)
 #include "vtkTableBasedClipCases.cxx"
 
@@ -1543,1399 +1556,1220 @@ inline void GetPoint(
 // =============== vtkTableBasedClipperVolumeFromVolume ( end ) ===============
 // ============================================================================
 
-//------------------------------------------------------------------------------
-// Construct with user-specified implicit function; InsideOut turned off; value
-// set to 0.0; and generate clip scalars turned off.
-vtkTableBasedClipDataSet::vtkTableBasedClipDataSet(vtkImplicitFunction* cf)
-{
-  this->Locator = nullptr;
-  this->ClipFunction = cf;
+// ============================================================================
+// =================== vtkTableBasedClipperFragment (begin) ===================
+// ============================================================================
 
-  // setup a callback to report progress
-  this->InternalProgressObserver = vtkCallbackCommand::New();
-  this->InternalProgressObserver->SetCallback(
-    &vtkTableBasedClipDataSet::InternalProgressCallbackFunction);
-  this->InternalProgressObserver->SetClientData(this);
+namespace
+{
+// Number of cells clipped into each fragment. The fragments are combined in
+// the order of their cells, so that the output does not depend on the number
+// of threads.
+const vtkIdType ClipBatchSize = 1024;
 
-  this->Value = 0.0;
-  this->InsideOut = 0;
-  this->MergeTolerance = 0.01;
-  this->UseValueAsOffset = true;
-  this->GenerateClipScalars = 0;
-  this->GenerateClippedOutput = 0;
+typedef const int EDGEIDXS[2];
 
-  this->OutputPointsPrecision = DEFAULT_PRECISION;
+struct TableBasedClipperFragmentCentroid
+{
+  int nPts;
+  vtkIdType ptIds[8];
+};
 
-  this->SetNumberOfOutputPorts(2);
-  vtkUnstructuredGrid* output2 = vtkUnstructuredGrid::New();
-  this->GetExecutive()->SetOutputData(1, output2);
-  output2->Delete();
-  output2 = nullptr;
+// The shapes and new points resulting from the clipping of a batch of cells.
+// As in vtkTableBasedClipperVolumeFromVolume, the shapes refer to the input
+// points by their id, to the edge points by the number of input points plus
+// their index, and to the centroid points by -1 minus their index. The edge
+// points are not merged here but when the fragments are combined.
+struct vtkTableBasedClipperFragment
+{
+  vtkIdType NumberOfInputPoints = 0;
+  std::vector<TableBasedClipperPointEntry> Edges;
+  std::vector<TableBasedClipperFragmentCentroid> Centroids;
+  // the VTK type, input cell id, number of points and point ids of each shape
+  std::vector<vtkIdType> Shapes;
+  vtkIdType NumberOfShapes = 0;
+  // the input cells which cannot be clipped with the tables
+  std::vector<vtkIdType> SpecialCells;
 
-  // process active point scalars by default
-  this->SetInputArrayToProcess(
-    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
-}
+  vtkIdType AddPoint(vtkIdType p1, vtkIdType p2, double percent)
+  {
+    TableBasedClipperPointEntry entry;
+    if (p2 < p1)
+    {
+      entry.ptIds[0] = p2;
+      entry.ptIds[1] = p1;
+      entry.percent = 1.0 - percent;
+    }
+    else
+    {
+      entry.ptIds[0] = p1;
+      entry.ptIds[1] = p2;
+      entry.percent = percent;
+    }
+    this->Edges.push_back(entry);
+    return this->NumberOfInputPoints + static_cast<vtkIdType>(this->Edges.size()) - 1;
+  }
 
-//------------------------------------------------------------------------------
-vtkTableBasedClipDataSet::~vtkTableBasedClipDataSet()
-{
-  if (this->Locator)
+  vtkIdType AddCentroidPoint(int nPts, const vtkIdType* ptIds)
   {
-    this->Locator->UnRegister(this);
-    this->Locator = nullptr;
+    TableBasedClipperFragmentCentroid entry;
+    entry.nPts = nPts;
+    std::copy(ptIds, ptIds + nPts, entry.ptIds);
+    this->Centroids.push_back(entry);
+    return -static_cast<vtkIdType>(this->Centroids.size());
   }
-  this->SetClipFunction(nullptr);
-  this->InternalProgressObserver->Delete();
-  this->InternalProgressObserver = nullptr;
-}
 
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::InternalProgressCallbackFunction(
-  vtkObject* arg, unsigned long, void* clientdata, void*)
-{
-  reinterpret_cast<vtkTableBasedClipDataSet*>(clientdata)
-    ->InternalProgressCallback(static_cast<vtkAlgorithm*>(arg));
-}
+  void AddShape(int vtkType, vtkIdType cellId, int nPts, const vtkIdType* ptIds)
+  {
+    this->Shapes.push_back(vtkType);
+    this->Shapes.push_back(cellId);
+    this->Shapes.push_back(nPts);
+    this->Shapes.insert(this->Shapes.end(), ptIds, ptIds + nPts);
+    this->NumberOfShapes++;
+  }
+};
 
 //------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::InternalProgressCallback(vtkAlgorithm* algorithm)
+bool CanClipWithTables(int cellType)
 {
-  double progress = algorithm->GetProgress();
-  this->UpdateProgress(progress);
-
-  if (this->AbortExecute)
+  switch (cellType)
   {
-    algorithm->SetAbortExecute(1);
+    case VTK_TETRA:
+    case VTK_PYRAMID:
+    case VTK_WEDGE:
+    case VTK_HEXAHEDRON:
+    case VTK_VOXEL:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_LINE:
+    case VTK_VERTEX:
+      return true;
+    default:
+      return false;
   }
 }
 
 //------------------------------------------------------------------------------
-vtkMTimeType vtkTableBasedClipDataSet::GetMTime()
-{
-  vtkMTimeType time;
-  vtkMTimeType mTime = this->Superclass::GetMTime();
+// Clip a cell with the case tables and add the shapes on the kept side to the
+// fragment. The point ids of the cell are given in the order of the tables.
+// Returns false if an invalid entry was found in the tables.
+bool ClipCellWithTables(vtkTableBasedClipperFragment& fragment, vtkIdType cellId, int cellType,
+  vtkIdType numbPnts, const vtkIdType* pntIndxs, vtkDataArray* clipAray, double isoValue,
+  bool insideOut)
+{
+  int caseIndx = 0;
+  double grdDiffs[8];
+  for (vtkIdType j = numbPnts - 1; j >= 0; j--)
+  {
+    grdDiffs[j] = clipAray->GetComponent(pntIndxs[j], 0) - isoValue;
+    caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
+    caseIndx <<= (1 - (!j));
+  }
+
+  int startIdx = 0;
+  int nOutputs = 0;
+  EDGEIDXS* edgeVtxs = nullptr;
+  unsigned char* thisCase = nullptr;
+
+  // start index, split case, number of output, and vertices from edges
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
+      break;
 
-  if (this->ClipFunction != nullptr)
-  {
-    time = this->ClipFunction->GetMTime();
-    mTime = (time > mTime ? time : mTime);
-  }
+    case VTK_PYRAMID:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
+      break;
 
-  if (this->Locator != nullptr)
-  {
-    time = this->Locator->GetMTime();
-    mTime = (time > mTime ? time : mTime);
-  }
+    case VTK_WEDGE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
+      break;
 
-  return mTime;
-}
+    case VTK_HEXAHEDRON:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
+      break;
 
-vtkUnstructuredGrid* vtkTableBasedClipDataSet::GetClippedOutput()
-{
-  if (!this->GenerateClippedOutput)
-  {
-    return nullptr;
-  }
+    case VTK_VOXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
+      break;
 
-  return vtkUnstructuredGrid::SafeDownCast(this->GetExecutive()->GetOutputData(1));
-}
+    case VTK_TRIANGLE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
+      break;
 
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::SetLocator(vtkIncrementalPointLocator* locator)
-{
-  if (this->Locator == locator)
-  {
-    return;
-  }
+    case VTK_QUAD:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
+      break;
 
-  if (this->Locator)
-  {
-    this->Locator->UnRegister(this);
-    this->Locator = nullptr;
-  }
+    case VTK_PIXEL:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
+      break;
 
-  if (locator)
-  {
-    locator->Register(this);
-  }
+    case VTK_LINE:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
+      edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
+      break;
 
-  this->Locator = locator;
-  this->Modified();
-}
+    case VTK_VERTEX:
+      startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
+      thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
+      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
+      edgeVtxs = nullptr;
+      break;
 
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::CreateDefaultLocator()
-{
-  if (this->Locator == nullptr)
-  {
-    this->Locator = vtkMergePoints::New();
-    this->Locator->Register(this);
-    this->Locator->Delete();
+    default:
+      return false;
   }
-}
 
-//------------------------------------------------------------------------------
-int vtkTableBasedClipDataSet::FillInputPortInformation(int, vtkInformation* info)
-{
-  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
-  return 1;
-}
+  vtkIdType intrpIds[4];
+  for (int j = 0; j < nOutputs; j++)
+  {
+    int nCellPts = 0;
+    int theColor = -1;
+    int intrpIdx = -1;
+    int vtkType = VTK_EMPTY_CELL;
+    unsigned char theShape = *thisCase++;
 
-//------------------------------------------------------------------------------
-int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
-{
-  // input and output information objects
-  vtkInformation* inputInf = inputVector[0]->GetInformationObject(0);
-  vtkInformation* outInfor = outputVector->GetInformationObject(0);
+    // number of points and color
+    switch (theShape)
+    {
+      case ST_HEX:
+        nCellPts = 8;
+        vtkType = VTK_HEXAHEDRON;
+        theColor = *thisCase++;
+        break;
 
-  // Get the input of which we have to create a copy since the clipper requires
-  // that InterpolateAllocate() be invoked for the output based on its input in
-  // terms of the point data. If the input and output arrays are different,
-  // vtkCell3D's Clip will fail. The last argument of InterpolateAllocate makes
-  // sure that arrays are shallow-copied from theInput to cpyInput.
-  vtkDataSet* theInput = vtkDataSet::SafeDownCast(inputInf->Get(vtkDataObject::DATA_OBJECT()));
-  vtkSmartPointer<vtkDataSet> cpyInput;
-  cpyInput.TakeReference(theInput->NewInstance());
-  cpyInput->CopyStructure(theInput);
-  cpyInput->GetCellData()->PassData(theInput->GetCellData());
-  cpyInput->GetFieldData()->PassData(theInput->GetFieldData());
-  cpyInput->GetPointData()->InterpolateAllocate(theInput->GetPointData(), 0, 0, 1);
+      case ST_WDG:
+        nCellPts = 6;
+        vtkType = VTK_WEDGE;
+        theColor = *thisCase++;
+        break;
 
-  // get the output (the remaining and the clipped parts)
-  vtkUnstructuredGrid* outputUG =
-    vtkUnstructuredGrid::SafeDownCast(outInfor->Get(vtkDataObject::DATA_OBJECT()));
-  vtkUnstructuredGrid* clippedOutputUG = this->GetClippedOutput();
+      case ST_PYR:
+        nCellPts = 5;
+        vtkType = VTK_PYRAMID;
+        theColor = *thisCase++;
+        break;
 
-  inputInf = nullptr;
-  outInfor = nullptr;
-  theInput = nullptr;
-  vtkDebugMacro(<< "Clipping dataset" << endl);
+      case ST_TET:
+        nCellPts = 4;
+        vtkType = VTK_TETRA;
+        theColor = *thisCase++;
+        break;
 
-  int i;
-  vtkIdType numbPnts = cpyInput->GetNumberOfPoints();
+      case ST_QUA:
+        nCellPts = 4;
+        vtkType = VTK_QUAD;
+        theColor = *thisCase++;
+        break;
 
-  // handling exceptions
-  if (numbPnts < 1)
-  {
-    vtkDebugMacro(<< "No data to clip" << endl);
-    outputUG = nullptr;
-    return 1;
-  }
+      case ST_TRI:
+        nCellPts = 3;
+        vtkType = VTK_TRIANGLE;
+        theColor = *thisCase++;
+        break;
 
-  if (!this->ClipFunction && this->GenerateClipScalars)
-  {
-    vtkErrorMacro(<< "Cannot generate clip scalars "
-                  << "if no clip function defined" << endl);
-    outputUG = nullptr;
-    return 1;
-  }
+      case ST_LIN:
+        nCellPts = 2;
+        vtkType = VTK_LINE;
+        theColor = *thisCase++;
+        break;
 
-  vtkDataArray* clipAray = nullptr;
-  vtkDoubleArray* pScalars = nullptr;
+      case ST_VTX:
+        nCellPts = 1;
+        vtkType = VTK_VERTEX;
+        theColor = *thisCase++;
+        break;
 
-  // check whether the cells are clipped with input scalars or a clip function
-  if (this->ClipFunction)
-  {
-    pScalars = vtkDoubleArray::New();
-    pScalars->SetNumberOfTuples(numbPnts);
-    pScalars->SetName("ClipDataSetScalars");
+      case ST_PNT:
+        intrpIdx = *thisCase++;
+        theColor = *thisCase++;
+        nCellPts = *thisCase++;
+        break;
 
-    // enable clipDataSetScalars to be passed to the output
-    if (this->GenerateClipScalars)
-    {
-      cpyInput->GetPointData()->SetScalars(pScalars);
+      default:
+        return false;
     }
 
-    for (i = 0; i < numbPnts; i++)
+    if ((!insideOut && theColor == COLOR0) || (insideOut && theColor == COLOR1))
     {
-      double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
-      pScalars->SetTuple1(i, s);
+      // We don't want this one; it's the wrong side.
+      thisCase += nCellPts;
+      continue;
     }
 
-    clipAray = pScalars;
-  }
-  else // using input scalars
-  {
-    clipAray = this->GetInputArrayToProcess(0, inputVector);
-    if (!clipAray)
+    vtkIdType shapeIds[8];
+    for (int p = 0; p < nCellPts; p++)
     {
-      vtkErrorMacro(<< "no input scalars." << endl);
-      return 1;
+      unsigned char pntIndex = *thisCase++;
+
+      if (pntIndex <= P7)
+      {
+        shapeIds[p] = pntIndxs[pntIndex];
+      }
+      else if (edgeVtxs && pntIndex >= EA && pntIndex <= EL)
+      {
+        int pt1Index = edgeVtxs[pntIndex - EA][0];
+        int pt2Index = edgeVtxs[pntIndex - EA][1];
+        if (pt2Index < pt1Index)
+        {
+          std::swap(pt1Index, pt2Index);
+        }
+        double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
+        double pt1ToIso = 0.0 - grdDiffs[pt1Index];
+        double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
+
+        shapeIds[p] = fragment.AddPoint(pntIndxs[pt1Index], pntIndxs[pt2Index], p1Weight);
+      }
+      else if (pntIndex >= N0 && pntIndex <= N3)
+      {
+        shapeIds[p] = intrpIds[pntIndex - N0];
+      }
+      else
+      {
+        return false;
+      }
     }
-  }
 
-  int gridType = cpyInput->GetDataObjectType();
-  double isoValue = (!this->ClipFunction || this->UseValueAsOffset) ? this->Value : 0.0;
-  if (gridType == VTK_IMAGE_DATA || gridType == VTK_STRUCTURED_POINTS)
-  {
-    this->ClipImageData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
+    if (theShape == ST_PNT)
     {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipImageData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
+      intrpIds[intrpIdx] = fragment.AddCentroidPoint(nCellPts, shapeIds);
     }
-  }
-  else if (gridType == VTK_POLY_DATA)
-  {
-    this->ClipPolyData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
+    else
     {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipPolyData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
+      fragment.AddShape(vtkType, cellId, nCellPts, shapeIds);
     }
   }
-  else if (gridType == VTK_RECTILINEAR_GRID)
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Clip the cells of an unstructured grid with the tables, one fragment per
+// batch of cells. The cells of other types are collected in the fragments to
+// be clipped by vtkClipDataSet.
+struct ClipUnstructuredCells
+{
+  vtkUnstructuredGrid* Input;
+  vtkDataArray* ClipArray;
+  double IsoValue;
+  bool InsideOut;
+  std::vector<vtkTableBasedClipperFragment>& Fragments;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterators;
+  std::atomic<bool> InvalidCase;
+
+  ClipUnstructuredCells(vtkUnstructuredGrid* input, vtkDataArray* clipArray, double isoValue,
+    bool insideOut, std::vector<vtkTableBasedClipperFragment>& fragments)
+    : Input(input)
+    , ClipArray(clipArray)
+    , IsoValue(isoValue)
+    , InsideOut(insideOut)
+    , Fragments(fragments)
+    , InvalidCase(false)
   {
-    this->ClipRectilinearGridData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipRectilinearGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-  else if (gridType == VTK_STRUCTURED_GRID)
-  {
-    this->ClipStructuredGridData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipStructuredGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-  else if (gridType == VTK_UNSTRUCTURED_GRID)
-  {
-    this->ClipUnstructuredGridData(cpyInput, clipAray, isoValue, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipUnstructuredGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-  else
-  {
-    this->ClipDataSet(cpyInput, clipAray, outputUG);
-    if (clippedOutputUG)
-    {
-      this->InsideOut = !(this->InsideOut);
-      this->ClipDataSet(cpyInput, clipAray, clippedOutputUG);
-      this->InsideOut = !(this->InsideOut);
-    }
-  }
-
-  outputUG->Squeeze();
-  outputUG->GetFieldData()->PassData(cpyInput->GetFieldData());
-
-  if (clippedOutputUG)
-  {
-    clippedOutputUG->Squeeze();
-    clippedOutputUG->GetFieldData()->PassData(cpyInput->GetFieldData());
-  }
-
-  if (pScalars)
-  {
-    pScalars->Delete();
-  }
-  pScalars = nullptr;
-  outputUG = nullptr;
-  clippedOutputUG = nullptr;
-  clipAray = nullptr;
-
-  return 1;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipDataSet(
-  vtkDataSet* pDataSet, vtkDataArray* clipAray, vtkUnstructuredGrid* unstruct)
-{
-  vtkClipDataSet* clipData = vtkClipDataSet::New();
-  clipData->SetInputData(pDataSet);
-  clipData->SetValue(this->Value);
-  clipData->SetInsideOut(this->InsideOut);
-  clipData->SetClipFunction(this->ClipFunction);
-  clipData->SetUseValueAsOffset(this->UseValueAsOffset);
-  clipData->SetGenerateClipScalars(this->GenerateClipScalars);
-
-  if (!this->ClipFunction)
-  {
-    pDataSet->GetPointData()->SetScalars(clipAray);
-  }
-
-  clipData->Update();
-  unstruct->ShallowCopy(clipData->GetOutput());
-
-  clipData->Delete();
-  clipData = nullptr;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipImageData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
-{
-  int i, j;
-  int dataDims[3];
-  double spacings[3];
-  double tmpValue = 0.0;
-  vtkRectilinearGrid* rectGrid = nullptr;
-  vtkImageData* volImage = vtkImageData::SafeDownCast(inputGrd);
-  volImage->GetDimensions(dataDims);
-  volImage->GetSpacing(spacings);
-  const double* dataBBox = volImage->GetBounds();
-
-  vtkDoubleArray* pxCoords = vtkDoubleArray::New();
-  vtkDoubleArray* pyCoords = vtkDoubleArray::New();
-  vtkDoubleArray* pzCoords = vtkDoubleArray::New();
-  vtkDoubleArray* tmpArays[3] = { pxCoords, pyCoords, pzCoords };
-  for (j = 0; j < 3; j++)
-  {
-    tmpArays[j]->SetNumberOfComponents(1);
-    tmpArays[j]->SetNumberOfTuples(dataDims[j]);
-    for (tmpValue = dataBBox[j << 1], i = 0; i < dataDims[j]; i++, tmpValue += spacings[j])
-    {
-      tmpArays[j]->SetComponent(i, 0, tmpValue);
-    }
-    tmpArays[j] = nullptr;
-  }
-
-  rectGrid = vtkRectilinearGrid::New();
-  rectGrid->SetDimensions(dataDims);
-  rectGrid->SetXCoordinates(pxCoords);
-  rectGrid->SetYCoordinates(pyCoords);
-  rectGrid->SetZCoordinates(pzCoords);
-  rectGrid->GetPointData()->ShallowCopy(volImage->GetPointData());
-  rectGrid->GetCellData()->ShallowCopy(volImage->GetCellData());
-
-  this->ClipRectilinearGridData(rectGrid, clipAray, isoValue, outputUG);
-
-  pxCoords->Delete();
-  pyCoords->Delete();
-  pzCoords->Delete();
-  rectGrid->Delete();
-  pxCoords = nullptr;
-  pyCoords = nullptr;
-  pzCoords = nullptr;
-  rectGrid = nullptr;
-  volImage = nullptr;
-  dataBBox = nullptr;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipPolyData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
-{
-  vtkPolyData* polyData = vtkPolyData::SafeDownCast(inputGrd);
-  vtkIdType numCells = polyData->GetNumberOfCells();
-
-  vtkTableBasedClipperVolumeFromVolume* visItVFV =
-    new vtkTableBasedClipperVolumeFromVolume(this->OutputPointsPrecision,
-      polyData->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
-
-  vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
-  specials->SetPoints(polyData->GetPoints());
-  specials->GetPointData()->ShallowCopy(polyData->GetPointData());
-  specials->Allocate(numCells);
-
-  vtkIdType i, j;
-  vtkIdType numbPnts = 0;
-  int numCants = 0; // number of cells not clipped by this filter
-
-  for (i = 0; i < numCells; i++)
-  {
-    int cellType = polyData->GetCellType(i);
-    bool bCanClip = false;
-    const vtkIdType* pntIndxs = nullptr;
-    polyData->GetCellPoints(i, numbPnts, pntIndxs);
-
-    switch (cellType)
-    {
-      case VTK_TETRA:
-      case VTK_PYRAMID:
-      case VTK_WEDGE:
-      case VTK_HEXAHEDRON:
-      case VTK_TRIANGLE:
-      case VTK_QUAD:
-      case VTK_LINE:
-      case VTK_VERTEX:
-        bCanClip = true;
-        break;
-
-      default:
-        bCanClip = false;
-        break;
-    }
-
-    if (bCanClip)
-    {
-      double grdDiffs[8];
-      int caseIndx = 0;
-
-      for (j = numbPnts - 1; j >= 0; j--)
-      {
-        grdDiffs[j] = clipAray->GetComponent(pntIndxs[j], 0) - isoValue;
-        caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-        caseIndx <<= (1 - (!j));
-      }
-
-      int startIdx = 0;
-      int nOutputs = 0;
-      typedef int EDGEIDXS[2];
-      const EDGEIDXS* edgeVtxs = nullptr;
-      unsigned char* thisCase = nullptr;
-
-      switch (cellType)
-      {
-        case VTK_TETRA:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
-          break;
-
-        case VTK_PYRAMID:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
-          break;
-
-        case VTK_WEDGE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
-          break;
-
-        case VTK_HEXAHEDRON:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
-          break;
-
-        case VTK_TRIANGLE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
-          break;
-
-        case VTK_QUAD:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
-          break;
-
-        case VTK_LINE:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
-          edgeVtxs = vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
-          break;
-
-        case VTK_VERTEX:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVtx[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVtx[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVtx[caseIndx];
-          edgeVtxs = nullptr;
-          break;
-      }
-
-      vtkIdType intrpIds[4];
-      for (j = 0; j < nOutputs; j++)
-      {
-        int nCellPts = 0;
-        int intrpIdx = -1;
-        int theColor = -1;
-        unsigned char theShape = *thisCase++;
-
-        switch (theShape)
-        {
-          case ST_HEX:
-            nCellPts = 8;
-            theColor = *thisCase++;
-            break;
-
-          case ST_WDG:
-            nCellPts = 6;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PYR:
-            nCellPts = 5;
-            theColor = *thisCase++;
-            break;
-          case ST_TET:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_QUA:
-            nCellPts = 4;
-            theColor = *thisCase++;
-            break;
-
-          case ST_TRI:
-            nCellPts = 3;
-            theColor = *thisCase++;
-            break;
-
-          case ST_LIN:
-            nCellPts = 2;
-            theColor = *thisCase++;
-            break;
-
-          case ST_VTX:
-            nCellPts = 1;
-            theColor = *thisCase++;
-            break;
-
-          case ST_PNT:
-            intrpIdx = *thisCase++;
-            theColor = *thisCase++;
-            nCellPts = *thisCase++;
-            break;
-
-          default:
-            vtkErrorMacro(<< "An invalid output shape was found in "
-                          << "the ClipCases." << endl);
-        }
-
-        if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
-        {
-          // We don't want this one; it's the wrong side.
-          thisCase += nCellPts;
-          continue;
-        }
-
-        vtkIdType shapeIds[8];
-        for (int p = 0; p < nCellPts; p++)
-        {
-          unsigned char pntIndex = *thisCase++;
-
-          if (pntIndex <= P7)
-          {
-            shapeIds[p] = pntIndxs[pntIndex];
-          }
-          else if (pntIndex >= EA && pntIndex <= EL)
-          {
-            int pt1Index = edgeVtxs[pntIndex - EA][0];
-            int pt2Index = edgeVtxs[pntIndex - EA][1];
-            if (pt2Index < pt1Index)
-            {
-              int temp = pt2Index;
-              pt2Index = pt1Index;
-              pt1Index = temp;
-            }
-            double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-            double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-            double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-            vtkIdType pntIndx1 = pntIndxs[pt1Index];
-            vtkIdType pntIndx2 = pntIndxs[pt2Index];
-
-            shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-          }
-          else if (pntIndex >= N0 && pntIndex <= N3)
-          {
-            shapeIds[p] = static_cast<int>(intrpIds[pntIndex - N0]);
-          }
-          else
-          {
-            vtkErrorMacro(<< "An invalid output point value "
-                          << "was found in the ClipCases." << endl);
-          }
-        }
-
-        switch (theShape)
-        {
-          case ST_HEX:
-            visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-              shapeIds[5], shapeIds[6], shapeIds[7]);
-            break;
-
-          case ST_WDG:
-            visItVFV->AddWedge(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-            break;
-
-          case ST_PYR:
-            visItVFV->AddPyramid(
-              i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-            break;
-
-          case ST_TET:
-            visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_QUA:
-            visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-            break;
-
-          case ST_TRI:
-            visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-            break;
-
-          case ST_LIN:
-            visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-            break;
-
-          case ST_VTX:
-            visItVFV->AddVertex(i, shapeIds[0]);
-            break;
-
-          case ST_PNT:
-            intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-            break;
-        }
-      }
-
-      edgeVtxs = nullptr;
-      thisCase = nullptr;
-    }
-    else
-    {
-      if (numCants == 0)
-      {
-        specials->GetCellData()->CopyAllocate(polyData->GetCellData(), numCells);
-      }
-
-      specials->InsertNextCell(cellType, numbPnts, pntIndxs);
-      specials->GetCellData()->CopyData(polyData->GetCellData(), i, numCants);
-      numCants++;
-    }
-
-    pntIndxs = nullptr;
-  }
-
-  int toDelete = 0;
-  double* theCords = nullptr;
-  vtkPoints* inputPts = polyData->GetPoints();
-  if (inputPts->GetDataType() == VTK_DOUBLE)
-  {
-    theCords = static_cast<double*>(inputPts->GetVoidPointer(0));
-  }
-  else
-  {
-    toDelete = 1;
-    numbPnts = inputPts->GetNumberOfPoints();
-    theCords = new double[numbPnts * 3];
-    for (i = 0; i < numbPnts; i++)
-    {
-      inputPts->GetPoint(i, theCords + (i << 1) + i);
-    }
-  }
-  inputPts = nullptr;
-
-  if (numCants > 0)
-  {
-    vtkUnstructuredGrid* vtkUGrid = vtkUnstructuredGrid::New();
-    this->ClipDataSet(specials, clipAray, vtkUGrid);
-
-    vtkUnstructuredGrid* visItGrd = vtkUnstructuredGrid::New();
-    visItVFV->ConstructDataSet(polyData, visItGrd, theCords);
-
-    vtkAppendFilter* appender = vtkAppendFilter::New();
-    appender->AddInputData(vtkUGrid);
-    appender->AddInputData(visItGrd);
-    appender->Update();
-
-    outputUG->ShallowCopy(appender->GetOutput());
-
-    appender->Delete();
-    vtkUGrid->Delete();
-    visItGrd->Delete();
-    appender = nullptr;
-    vtkUGrid = nullptr;
-    visItGrd = nullptr;
-  }
-  else
-  {
-    visItVFV->ConstructDataSet(polyData, outputUG, theCords);
-  }
-
-  specials->Delete();
-  delete visItVFV;
-  if (toDelete)
-  {
-    delete[] theCords;
   }
-  specials = nullptr;
-  visItVFV = nullptr;
-  theCords = nullptr;
-  polyData = nullptr;
-}
-
-//------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipRectilinearGridData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
-{
-  vtkRectilinearGrid* rectGrid = vtkRectilinearGrid::SafeDownCast(inputGrd);
-
-  vtkIdType i, j;
-  vtkIdType numCells = 0;
-  int isTwoDim = 0;
-  enum TwoDimType
-  {
-    XY,
-    YZ,
-    XZ
-  };
-  TwoDimType twoDimType;
-  int rectDims[3];
-  rectGrid->GetDimensions(rectDims);
-  isTwoDim = int(rectDims[0] <= 1 || rectDims[1] <= 1 || rectDims[2] <= 1);
-  if (rectDims[0] <= 1)
-    twoDimType = YZ;
-  else if (rectDims[1] <= 1)
-    twoDimType = XZ;
-  else
-    twoDimType = XY;
-  numCells = rectGrid->GetNumberOfCells();
-
-  vtkTableBasedClipperVolumeFromVolume* visItVFV = new vtkTableBasedClipperVolumeFromVolume(
-    this->OutputPointsPrecision, rectGrid->GetNumberOfPoints(),
-    static_cast<vtkIdType>(pow(double(numCells), double(0.6667f)) * 5 + 100));
-
-  int shiftLUTx[8] = { 0, 1, 1, 0, 0, 1, 1, 0 };
-  int shiftLUTy[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
-  int shiftLUTz[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
 
-  int* shiftLUT[3];
-  if (isTwoDim && twoDimType == XZ)
+  void Initialize()
   {
-    shiftLUT[0] = shiftLUTx;
-    shiftLUT[1] = shiftLUTz;
-    shiftLUT[2] = shiftLUTy;
+    this->Iterators.Local().TakeReference(this->Input->GetCells()->NewIterator());
   }
-  else if (isTwoDim && twoDimType == YZ)
-  {
-    shiftLUT[0] = shiftLUTy;
-    shiftLUT[1] = shiftLUTz;
-    shiftLUT[2] = shiftLUTx;
-  }
-  else
-  {
-    shiftLUT[0] = shiftLUTx;
-    shiftLUT[1] = shiftLUTy;
-    shiftLUT[2] = shiftLUTz;
-  }
-
-  int cellDims[3] = { rectDims[0] - 1, rectDims[1] - 1, rectDims[2] - 1 };
-  int cyStride = (cellDims[0] ? cellDims[0] : 1);
-  int czStride = (cellDims[0] ? cellDims[0] : 1) * (cellDims[1] ? cellDims[1] : 1);
-  int pyStride = rectDims[0];
-  int pzStride = rectDims[0] * rectDims[1];
 
-  for (i = 0; i < numCells; i++)
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
   {
-    int caseIndx = 0;
-    int nCellPts = isTwoDim ? 4 : 8;
-    vtkIdType theCellI = (cellDims[0] > 0 ? i % cellDims[0] : 0);
-    vtkIdType theCellJ = (cellDims[1] > 0 ? (i / cyStride) % cellDims[1] : 0);
-    vtkIdType theCellK = (cellDims[2] > 0 ? (i / czStride) : 0);
-    double grdDiffs[8];
-
-    for (j = static_cast<vtkIdType>(nCellPts) - 1; j >= 0; j--)
+    vtkCellArrayIterator* iter = this->Iterators.Local();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
     {
-      grdDiffs[j] = clipAray->GetComponent((theCellK + shiftLUT[2][j]) * pzStride +
-                        (theCellJ + shiftLUT[1][j]) * pyStride + (theCellI + shiftLUT[0][j]),
-                      0) -
-        isoValue;
-      caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-      caseIndx <<= (1 - (!j));
+      vtkTableBasedClipperFragment& fragment = this->Fragments[batch];
+      fragment.NumberOfInputPoints = this->Input->GetNumberOfPoints();
+      const vtkIdType endCellId = std::min((batch + 1) * ClipBatchSize, numCells);
+      for (vtkIdType cellId = batch * ClipBatchSize; cellId < endCellId; ++cellId)
+      {
+        int cellType = this->Input->GetCellType(cellId);
+        if (!CanClipWithTables(cellType))
+        {
+          fragment.SpecialCells.push_back(cellId);
+          continue;
+        }
+        vtkIdType numbPnts;
+        const vtkIdType* pntIndxs;
+        iter->GetCellAtId(cellId, numbPnts, pntIndxs);
+        if (!ClipCellWithTables(fragment, cellId, cellType, numbPnts, pntIndxs, this->ClipArray,
+              this->IsoValue, this->InsideOut))
+        {
+          this->InvalidCase = true;
+        }
+      }
     }
+  }
 
-    int nOutputs;
-    int intrpIds[4];
-    unsigned char* thisCase = nullptr;
+  void Reduce() {}
+};
 
-    if (isTwoDim)
+//------------------------------------------------------------------------------
+// Clip the cells of a rectilinear or structured grid with the tables, as
+// hexahedra, or as quads for 2D grids, one fragment per batch of cells.
+struct ClipStructuredCells
+{
+  vtkIdType NumberOfCells;
+  vtkIdType NumberOfPoints;
+  vtkDataArray* ClipArray;
+  double IsoValue;
+  bool InsideOut;
+  std::vector<vtkTableBasedClipperFragment>& Fragments;
+  std::atomic<bool> InvalidCase;
+  bool IsTwoDim;
+  const int* ShiftLUT[3];
+  int CellDims[3];
+  vtkIdType CyStride;
+  vtkIdType CzStride;
+  vtkIdType PyStride;
+  vtkIdType PzStride;
+
+  ClipStructuredCells(const int dims[3], vtkIdType numCells, vtkDataArray* clipArray,
+    double isoValue, bool insideOut, std::vector<vtkTableBasedClipperFragment>& fragments)
+    : NumberOfCells(numCells)
+    , NumberOfPoints(static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2])
+    , ClipArray(clipArray)
+    , IsoValue(isoValue)
+    , InsideOut(insideOut)
+    , Fragments(fragments)
+    , InvalidCase(false)
+  {
+    static const int shiftLUTx[8] = { 0, 1, 1, 0, 0, 1, 1, 0 };
+    static const int shiftLUTy[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
+    static const int shiftLUTz[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
+
+    this->IsTwoDim = dims[0] <= 1 || dims[1] <= 1 || dims[2] <= 1;
+    if (this->IsTwoDim && dims[0] <= 1)
     {
-      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua
-                   [vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx]];
-      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
+      // YZ plane
+      this->ShiftLUT[0] = shiftLUTy;
+      this->ShiftLUT[1] = shiftLUTz;
+      this->ShiftLUT[2] = shiftLUTx;
+    }
+    else if (this->IsTwoDim && dims[1] <= 1)
+    {
+      // XZ plane
+      this->ShiftLUT[0] = shiftLUTx;
+      this->ShiftLUT[1] = shiftLUTz;
+      this->ShiftLUT[2] = shiftLUTy;
     }
     else
     {
-      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex
-                   [vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx]];
-      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
+      this->ShiftLUT[0] = shiftLUTx;
+      this->ShiftLUT[1] = shiftLUTy;
+      this->ShiftLUT[2] = shiftLUTz;
     }
 
-    for (j = 0; j < nOutputs; j++)
+    for (int i = 0; i < 3; ++i)
     {
-      int intrpIdx = -1;
-      int theColor = -1;
-      unsigned char theShape = *thisCase++;
+      this->CellDims[i] = dims[i] - 1;
+    }
+    this->CyStride = (this->CellDims[0] ? this->CellDims[0] : 1);
+    this->CzStride = this->CyStride * (this->CellDims[1] ? this->CellDims[1] : 1);
+    this->PyStride = dims[0];
+    this->PzStride = static_cast<vtkIdType>(dims[0]) * dims[1];
+  }
 
-      nCellPts = 0;
-      switch (theShape)
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    const int cellType = this->IsTwoDim ? VTK_QUAD : VTK_HEXAHEDRON;
+    const vtkIdType numbPnts = this->IsTwoDim ? 4 : 8;
+    vtkIdType pntIndxs[8];
+    for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
+    {
+      vtkTableBasedClipperFragment& fragment = this->Fragments[batch];
+      fragment.NumberOfInputPoints = this->NumberOfPoints;
+      const vtkIdType endCellId = std::min((batch + 1) * ClipBatchSize, this->NumberOfCells);
+      for (vtkIdType cellId = batch * ClipBatchSize; cellId < endCellId; ++cellId)
       {
-        case ST_HEX:
-          nCellPts = 8;
-          theColor = *thisCase++;
-          break;
-
-        case ST_WDG:
-          nCellPts = 6;
-          theColor = *thisCase++;
-          break;
-
-        case ST_PYR:
-          nCellPts = 5;
-          theColor = *thisCase++;
-          break;
-
-        case ST_TET:
-          nCellPts = 4;
-          theColor = *thisCase++;
-          break;
-
-        case ST_QUA:
-          nCellPts = 4;
-          theColor = *thisCase++;
-          break;
+        vtkIdType theCellI = (this->CellDims[0] > 0 ? cellId % this->CellDims[0] : 0);
+        vtkIdType theCellJ =
+          (this->CellDims[1] > 0 ? (cellId / this->CyStride) % this->CellDims[1] : 0);
+        vtkIdType theCellK = (this->CellDims[2] > 0 ? (cellId / this->CzStride) : 0);
+        for (vtkIdType j = 0; j < numbPnts; ++j)
+        {
+          pntIndxs[j] = (theCellI + this->ShiftLUT[0][j]) +
+            (theCellJ + this->ShiftLUT[1][j]) * this->PyStride +
+            (theCellK + this->ShiftLUT[2][j]) * this->PzStride;
+        }
+        if (!ClipCellWithTables(fragment, cellId, cellType, numbPnts, pntIndxs, this->ClipArray,
+              this->IsoValue, this->InsideOut))
+        {
+          this->InvalidCase = true;
+        }
+      }
+    }
+  }
+};
 
-        case ST_TRI:
-          nCellPts = 3;
-          theColor = *thisCase++;
-          break;
+//------------------------------------------------------------------------------
+// Combine the clipped fragments into the output. The output points are the
+// used input points by increasing id, then the edge points ordered by edge,
+// then the centroid points in the order of the fragments. Identical edge
+// points requested by different cells are merged with
+// vtkStaticEdgeLocatorTemplate, each one being interpolated as requested by
+// the first cell. The output cells are ordered as their input cells.
+void ConstructClippedDataSet(vtkDataSet* input,
+  std::vector<vtkTableBasedClipperFragment>& fragments, int outputPointsPrecision,
+  vtkUnstructuredGrid* output)
+{
+  const vtkIdType numInPts = input->GetNumberOfPoints();
+  const vtkIdType numFragments = static_cast<vtkIdType>(fragments.size());
+
+  // Locate the edge points, centroid points, cells and connectivity of each
+  // fragment, with one more entry for the totals.
+  std::vector<vtkIdType> edgeOffsets(numFragments + 1, 0);
+  std::vector<vtkIdType> centroidOffsets(numFragments + 1, 0);
+  std::vector<vtkIdType> cellOffsets(numFragments + 1, 0);
+  std::vector<vtkIdType> connOffsets(numFragments + 1, 0);
+  for (vtkIdType f = 0; f < numFragments; ++f)
+  {
+    const vtkTableBasedClipperFragment& fragment = fragments[f];
+    edgeOffsets[f] = static_cast<vtkIdType>(fragment.Edges.size());
+    centroidOffsets[f] = static_cast<vtkIdType>(fragment.Centroids.size());
+    cellOffsets[f] = fragment.NumberOfShapes;
+    connOffsets[f] = static_cast<vtkIdType>(fragment.Shapes.size()) - 3 * fragment.NumberOfShapes;
+  }
+  vtkSMPTools::ExclusiveScan(
+    edgeOffsets.begin(), edgeOffsets.end(), edgeOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    centroidOffsets.begin(), centroidOffsets.end(), centroidOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    cellOffsets.begin(), cellOffsets.end(), cellOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    connOffsets.begin(), connOffsets.end(), connOffsets.begin(), vtkIdType(0));
+  const vtkIdType numEdges = edgeOffsets[numFragments];
+  const vtkIdType numCentroids = centroidOffsets[numFragments];
+  const vtkIdType numCells = cellOffsets[numFragments];
+  const vtkIdType connSize = connOffsets[numFragments];
+
+  // Gather the edge points, and flag the input points used by the shapes and
+  // the centroid points.
+  using EdgeTupleType = EdgeTuple<vtkIdType, vtkIdType>;
+  std::vector<EdgeTupleType> edges(numEdges);
+  std::vector<double> percents(numEdges);
+  std::vector<unsigned char> usedPoints(numInPts, 0);
+  vtkSMPTools::For(0, numFragments, [&](vtkIdType beginFragment, vtkIdType endFragment) {
+    for (vtkIdType f = beginFragment; f < endFragment; ++f)
+    {
+      const vtkTableBasedClipperFragment& fragment = fragments[f];
+      vtkIdType edgeId = edgeOffsets[f];
+      for (const TableBasedClipperPointEntry& entry : fragment.Edges)
+      {
+        edges[edgeId] = EdgeTupleType(entry.ptIds[0], entry.ptIds[1], edgeId);
+        percents[edgeId++] = entry.percent;
+      }
+      auto shape = fragment.Shapes.begin();
+      while (shape != fragment.Shapes.end())
+      {
+        vtkIdType nPts = shape[2];
+        for (auto ptId = shape + 3; ptId != shape + 3 + nPts; ++ptId)
+        {
+          if (*ptId >= 0 && *ptId < numInPts)
+          {
+            usedPoints[*ptId] = 1;
+          }
+        }
+        shape += 3 + nPts;
+      }
+      for (const TableBasedClipperFragmentCentroid& centroid : fragment.Centroids)
+      {
+        for (int k = 0; k < centroid.nPts; ++k)
+        {
+          if (centroid.ptIds[k] >= 0 && centroid.ptIds[k] < numInPts)
+          {
+            usedPoints[centroid.ptIds[k]] = 1;
+          }
+        }
+      }
+    }
+  });
+
+  // The used input points are numbered by increasing id.
+  std::vector<vtkIdType> pointMap(numInPts);
+  vtkSMPTools::ExclusiveScan(
+    usedPoints.begin(), usedPoints.end(), pointMap.begin(), vtkIdType(0));
+  const vtkIdType numUsed = numInPts > 0 ? pointMap[numInPts - 1] + usedPoints[numInPts - 1] : 0;
+
+  // Merge the identical edges. The edge points are numbered in the order of
+  // the sorted edges, each request being mapped to its merged edge.
+  vtkStaticEdgeLocatorTemplate<vtkIdType, vtkIdType> edgeLocator;
+  vtkIdType numUniqueEdges = 0;
+  const vtkIdType* mergeOffsets = edgeLocator.MergeEdges(numEdges, edges.data(), numUniqueEdges);
+  std::vector<vtkIdType> edgeMap(numEdges);
+  std::vector<vtkIdType> uniqueEdges(numUniqueEdges);
+  vtkSMPTools::For(0, numUniqueEdges, [&](vtkIdType beginEdge, vtkIdType endEdge) {
+    for (vtkIdType edgeId = beginEdge; edgeId < endEdge; ++edgeId)
+    {
+      vtkIdType first = edges[mergeOffsets[edgeId]].Data;
+      for (vtkIdType i = mergeOffsets[edgeId]; i < mergeOffsets[edgeId + 1]; ++i)
+      {
+        edgeMap[edges[i].Data] = edgeId;
+        first = std::min(first, edges[i].Data);
+      }
+      uniqueEdges[edgeId] = first;
+    }
+  });
 
-        case ST_LIN:
-          nCellPts = 2;
-          theColor = *thisCase++;
-          break;
+  const vtkIdType centroidStart = numUsed + numUniqueEdges;
+  const vtkIdType numOutPts = centroidStart + numCentroids;
+  auto outputPointId = [&](vtkIdType f, vtkIdType ptId) -> vtkIdType {
+    if (ptId < 0)
+    {
+      return centroidStart + centroidOffsets[f] - 1 - ptId;
+    }
+    if (ptId >= numInPts)
+    {
+      return numUsed + edgeMap[edgeOffsets[f] + ptId - numInPts];
+    }
+    return pointMap[ptId];
+  };
 
-        case ST_VTX:
-          nCellPts = 1;
-          theColor = *thisCase++;
-          break;
+  // Set up the output points and their point data.
+  vtkNew<vtkPoints> outPts;
+  if (outputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
+    if (inputPointSet && inputPointSet->GetPoints())
+    {
+      outPts->SetDataType(inputPointSet->GetPoints()->GetDataType());
+    }
+    else
+    {
+      outPts->SetDataType(VTK_FLOAT);
+    }
+  }
+  else if (outputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_FLOAT);
+  }
+  else if (outputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    outPts->SetDataType(VTK_DOUBLE);
+  }
+  outPts->SetNumberOfPoints(numOutPts);
 
-        case ST_PNT:
-          intrpIdx = *thisCase++;
-          theColor = *thisCase++;
-          nCellPts = *thisCase++;
-          break;
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(inPD, numOutPts);
 
-        default:
-          vtkErrorMacro(<< "An invalid output shape was found in "
-                        << "the ClipCases." << endl);
-      }
+  // The original node numbers of VisIt are not interpolated: the edge points
+  // take the number of their nearest node and the centroid points -1.
+  vtkIntArray* origNodes = vtkArrayDownCast<vtkIntArray>(inPD->GetArray("avtOriginalNodeNumbers"));
+  vtkSmartPointer<vtkIntArray> newOrigNodes;
+  ArrayList pointArrays;
+  ArrayList centroidArrays;
+  if (origNodes)
+  {
+    newOrigNodes = vtkSmartPointer<vtkIntArray>::New();
+    newOrigNodes->SetNumberOfComponents(origNodes->GetNumberOfComponents());
+    newOrigNodes->SetNumberOfTuples(numOutPts);
+    newOrigNodes->SetName(origNodes->GetName());
+    pointArrays.ExcludeArray(origNodes);
+    centroidArrays.ExcludeArray(outPD->GetArray(origNodes->GetName()));
+  }
+  pointArrays.AddArrays(numOutPts, inPD, outPD, 0.0, false);
+  centroidArrays.AddSelfInterpolatingArrays(numOutPts, outPD);
 
-      if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
+  // Copy the used input points.
+  double x[3];
+  if (numInPts > 0)
+  {
+    input->GetPoint(0, x); // make GetPoint() thread-safe
+  }
+  vtkSMPTools::For(0, numInPts, [&](vtkIdType beginPtId, vtkIdType endPtId) {
+    double p[3];
+    for (vtkIdType ptId = beginPtId; ptId < endPtId; ++ptId)
+    {
+      if (!usedPoints[ptId])
       {
-        // We don't want this one; it's the wrong side.
-        thisCase += nCellPts;
         continue;
       }
-
-      vtkIdType shapeIds[8];
-      for (int p = 0; p < nCellPts; p++)
+      vtkIdType outId = pointMap[ptId];
+      input->GetPoint(ptId, p);
+      outPts->SetPoint(outId, p);
+      pointArrays.Copy(ptId, outId);
+      if (newOrigNodes)
       {
-        unsigned char pntIndex = *thisCase++;
+        newOrigNodes->SetTuple(outId, ptId, origNodes);
+      }
+    }
+  });
 
-        if (pntIndex <= P7)
+  // Interpolate the edge points.
+  vtkSMPTools::For(0, numUniqueEdges, [&](vtkIdType beginEdge, vtkIdType endEdge) {
+    double pt1[3], pt2[3], pt[3];
+    for (vtkIdType edgeId = beginEdge; edgeId < endEdge; ++edgeId)
+    {
+      const EdgeTupleType& edge = edges[mergeOffsets[edgeId]];
+      vtkIdType outId = numUsed + edgeId;
+      double p = percents[uniqueEdges[edgeId]];
+      double bp = 1.0 - p;
+      input->GetPoint(edge.V0, pt1);
+      input->GetPoint(edge.V1, pt2);
+      pt[0] = pt1[0] * p + pt2[0] * bp;
+      pt[1] = pt1[1] * p + pt2[1] * bp;
+      pt[2] = pt1[2] * p + pt2[2] * bp;
+      outPts->SetPoint(outId, pt);
+      pointArrays.InterpolateEdge(edge.V0, edge.V1, bp, outId);
+      if (newOrigNodes)
+      {
+        newOrigNodes->SetTuple(outId, bp <= 0.5 ? edge.V0 : edge.V1, origNodes);
+      }
+    }
+  });
+
+  // Average the centroid points, which may depend on the previous centroid
+  // points of their fragment.
+  vtkSMPTools::For(0, numFragments, [&](vtkIdType beginFragment, vtkIdType endFragment) {
+    vtkIdType ids[8];
+    double pts[3], pt[3];
+    for (vtkIdType f = beginFragment; f < endFragment; ++f)
+    {
+      vtkIdType outId = centroidStart + centroidOffsets[f];
+      for (const TableBasedClipperFragmentCentroid& centroid : fragments[f].Centroids)
+      {
+        pt[0] = pt[1] = pt[2] = 0.0;
+        for (int k = 0; k < centroid.nPts; ++k)
         {
-          // We know pt P0 must be >P0 since we already
-          // assume P0 == 0.  This is why we do not
-          // bother subtracting P0 from pt here.
-          shapeIds[p] =
-            ((theCellI + shiftLUT[0][pntIndex]) + (theCellJ + shiftLUT[1][pntIndex]) * pyStride +
-              (theCellK + shiftLUT[2][pntIndex]) * pzStride);
+          ids[k] = outputPointId(f, centroid.ptIds[k]);
+          outPts->GetPoint(ids[k], pts);
+          pt[0] += pts[0];
+          pt[1] += pts[1];
+          pt[2] += pts[2];
         }
-        else if (pntIndex >= EA && pntIndex <= EL)
+        double weight = 1.0 / centroid.nPts;
+        pt[0] *= weight;
+        pt[1] *= weight;
+        pt[2] *= weight;
+        outPts->SetPoint(outId, pt);
+        centroidArrays.Average(centroid.nPts, ids, outId);
+        if (newOrigNodes)
         {
-          int pt1Index =
-            vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges[pntIndex - EA][0];
-          int pt2Index =
-            vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges[pntIndex - EA][1];
-
-          if (pt2Index < pt1Index)
+          // these 'created' nodes have no original designation
+          for (int z = 0; z < newOrigNodes->GetNumberOfComponents(); z++)
           {
-            int temp = pt2Index;
-            pt2Index = pt1Index;
-            pt1Index = temp;
+            newOrigNodes->SetTypedComponent(outId, z, -1);
           }
+        }
+        outId++;
+      }
+    }
+  });
 
-          double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-          double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-          double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-          int pntIndx1 =
-            ((theCellI + shiftLUT[0][pt1Index]) + (theCellJ + shiftLUT[1][pt1Index]) * pyStride +
-              (theCellK + shiftLUT[2][pt1Index]) * pzStride);
-          int pntIndx2 =
-            ((theCellI + shiftLUT[0][pt2Index]) + (theCellJ + shiftLUT[1][pt2Index]) * pyStride +
-              (theCellK + shiftLUT[2][pt2Index]) * pzStride);
-
-          /* We may have physically (though not logically) degenerate cells
-          // if p1Weight == 0 or p1Weight == 1. We could pretty easily and
-          // mostly safely clamp percent to the range [1e-4, 1 - 1e-4].
-          if( p1Weight == 1.0)
-            {
-            shapeIds[p] = pntIndx1;
-            }
-          else
-          if( p1Weight == 0.0 )
-            {
-            shapeIds[p] = pntIndx2;
-            }
-          else
+  output->SetPoints(outPts);
+  if (newOrigNodes)
+  {
+    // AddArray will overwrite an already existing array with
+    // the same name, exactly what we want here.
+    outPD->AddArray(newOrigNodes);
+  }
 
-            {
-            shapeIds[p] = visItVFV->AddPoint( pntIndx1, pntIndx2, p1Weight );
-            }
-          */
-
-          // Turning on the above code segment, the alternative, would cause
-          // a bug with a synthetic Wavelet dataset (vtkImageData) when the
-          // the clipping plane (x/y/z axis) is positioned exactly at (0,0,0).
-          // The problem occurs in the form of an open 'box', as opposed to an
-          // expected closed one. This is due to the use of hash instead of a
-          // point-locator based detection of duplicate points.
-          shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-        }
-        else if (pntIndex >= N0 && pntIndex <= N3)
-        {
-          shapeIds[p] = intrpIds[pntIndex - N0];
-        }
-        else
+  // Fill the cells and their cell data.
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, numCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numCells, inCD, outCD, 0.0, false);
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connSize);
+  vtkNew<vtkUnsignedCharArray> cellTypes;
+  cellTypes->SetNumberOfValues(numCells);
+  vtkIdType* offs = offsets->GetPointer(0);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  unsigned char* types = cellTypes->GetPointer(0);
+  vtkSMPTools::For(0, numFragments, [&](vtkIdType beginFragment, vtkIdType endFragment) {
+    for (vtkIdType f = beginFragment; f < endFragment; ++f)
+    {
+      vtkIdType cellId = cellOffsets[f];
+      vtkIdType connId = connOffsets[f];
+      const vtkTableBasedClipperFragment& fragment = fragments[f];
+      auto shape = fragment.Shapes.begin();
+      while (shape != fragment.Shapes.end())
+      {
+        vtkIdType nPts = shape[2];
+        types[cellId] = static_cast<unsigned char>(shape[0]);
+        cellArrays.Copy(shape[1], cellId);
+        offs[cellId++] = connId;
+        for (auto ptId = shape + 3; ptId != shape + 3 + nPts; ++ptId)
         {
-          vtkErrorMacro(<< "An invalid output point value "
-                        << "was found in the ClipCases." << endl);
+          conn[connId++] = outputPointId(f, *ptId);
         }
+        shape += 3 + nPts;
       }
+    }
+  });
+  offs[numCells] = connSize;
 
-      switch (theShape)
-      {
-        case ST_HEX:
-          visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-            shapeIds[5], shapeIds[6], shapeIds[7]);
-          break;
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  output->SetCells(cellTypes, cells);
+}
+} // anonymous namespace
 
-        case ST_WDG:
-          visItVFV->AddWedge(
-            i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-          break;
+// ============================================================================
+// =================== vtkTableBasedClipperFragment ( end ) ===================
+// ============================================================================
 
-        case ST_PYR:
-          visItVFV->AddPyramid(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-          break;
+//------------------------------------------------------------------------------
+// Construct with user-specified implicit function; InsideOut turned off; value
+// set to 0.0; and generate clip scalars turned off.
+vtkTableBasedClipDataSet::vtkTableBasedClipDataSet(vtkImplicitFunction* cf)
+{
+  this->Locator = nullptr;
+  this->ClipFunction = cf;
 
-        case ST_TET:
-          visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-          break;
+  // setup a callback to report progress
+  this->InternalProgressObserver = vtkCallbackCommand::New();
+  this->InternalProgressObserver->SetCallback(
+    &vtkTableBasedClipDataSet::InternalProgressCallbackFunction);
+  this->InternalProgressObserver->SetClientData(this);
 
-        case ST_QUA:
-          visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-          break;
+  this->Value = 0.0;
+  this->InsideOut = 0;
+  this->MergeTolerance = 0.01;
+  this->UseValueAsOffset = true;
+  this->GenerateClipScalars = 0;
+  this->GenerateClippedOutput = 0;
 
-        case ST_TRI:
-          visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-          break;
+  this->OutputPointsPrecision = DEFAULT_PRECISION;
 
-        case ST_LIN:
-          visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-          break;
+  this->SetNumberOfOutputPorts(2);
+  vtkUnstructuredGrid* output2 = vtkUnstructuredGrid::New();
+  this->GetExecutive()->SetOutputData(1, output2);
+  output2->Delete();
+  output2 = nullptr;
 
-        case ST_VTX:
-          visItVFV->AddVertex(i, shapeIds[0]);
-          break;
+  // process active point scalars by default
+  this->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
+}
+
+//------------------------------------------------------------------------------
+vtkTableBasedClipDataSet::~vtkTableBasedClipDataSet()
+{
+  if (this->Locator)
+  {
+    this->Locator->UnRegister(this);
+    this->Locator = nullptr;
+  }
+  this->SetClipFunction(nullptr);
+  this->InternalProgressObserver->Delete();
+  this->InternalProgressObserver = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::InternalProgressCallbackFunction(
+  vtkObject* arg, unsigned long, void* clientdata, void*)
+{
+  reinterpret_cast<vtkTableBasedClipDataSet*>(clientdata)
+    ->InternalProgressCallback(static_cast<vtkAlgorithm*>(arg));
+}
+
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::InternalProgressCallback(vtkAlgorithm* algorithm)
+{
+  double progress = algorithm->GetProgress();
+  this->UpdateProgress(progress);
+
+  if (this->AbortExecute)
+  {
+    algorithm->SetAbortExecute(1);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkMTimeType vtkTableBasedClipDataSet::GetMTime()
+{
+  vtkMTimeType time;
+  vtkMTimeType mTime = this->Superclass::GetMTime();
+
+  if (this->ClipFunction != nullptr)
+  {
+    time = this->ClipFunction->GetMTime();
+    mTime = (time > mTime ? time : mTime);
+  }
+
+  if (this->Locator != nullptr)
+  {
+    time = this->Locator->GetMTime();
+    mTime = (time > mTime ? time : mTime);
+  }
 
-        case ST_PNT:
-          intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-          break;
-      }
-    }
+  return mTime;
+}
 
-    thisCase = nullptr;
+vtkUnstructuredGrid* vtkTableBasedClipDataSet::GetClippedOutput()
+{
+  if (!this->GenerateClippedOutput)
+  {
+    return nullptr;
   }
 
-  int toDelete = 0;
-  double* theCords[3] = { nullptr, nullptr, nullptr };
-  vtkDataArray* theArays[3] = { nullptr, nullptr, nullptr };
+  return vtkUnstructuredGrid::SafeDownCast(this->GetExecutive()->GetOutputData(1));
+}
 
-  if (rectGrid->GetXCoordinates()->GetDataType() == VTK_DOUBLE &&
-    rectGrid->GetYCoordinates()->GetDataType() == VTK_DOUBLE &&
-    rectGrid->GetZCoordinates()->GetDataType() == VTK_DOUBLE)
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::SetLocator(vtkIncrementalPointLocator* locator)
+{
+  if (this->Locator == locator)
   {
-    theCords[0] = static_cast<double*>(rectGrid->GetXCoordinates()->GetVoidPointer(0));
-    theCords[1] = static_cast<double*>(rectGrid->GetYCoordinates()->GetVoidPointer(0));
-    theCords[2] = static_cast<double*>(rectGrid->GetZCoordinates()->GetVoidPointer(0));
+    return;
   }
-  else
+
+  if (this->Locator)
   {
-    toDelete = 1;
-    theArays[0] = rectGrid->GetXCoordinates();
-    theArays[1] = rectGrid->GetYCoordinates();
-    theArays[2] = rectGrid->GetZCoordinates();
-    for (j = 0; j < 3; j++)
-    {
-      theCords[j] = new double[rectDims[j]];
-      for (i = 0; i < rectDims[j]; i++)
-      {
-        theCords[j][i] = theArays[j]->GetComponent(i, 0);
-      }
-      theArays[j] = nullptr;
-    }
+    this->Locator->UnRegister(this);
+    this->Locator = nullptr;
   }
 
-  visItVFV->ConstructDataSet(rectGrid, outputUG, rectDims, theCords[0], theCords[1], theCords[2]);
+  if (locator)
+  {
+    locator->Register(this);
+  }
 
-  delete visItVFV;
-  visItVFV = nullptr;
-  rectGrid = nullptr;
+  this->Locator = locator;
+  this->Modified();
+}
 
-  for (i = 0; i < 3; i++)
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::CreateDefaultLocator()
+{
+  if (this->Locator == nullptr)
   {
-    if (toDelete)
-    {
-      delete[] theCords[i];
-    }
-    theCords[i] = nullptr;
+    this->Locator = vtkMergePoints::New();
+    this->Locator->Register(this);
+    this->Locator->Delete();
   }
 }
 
 //------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipStructuredGridData(
-  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+int vtkTableBasedClipDataSet::FillInputPortInformation(int, vtkInformation* info)
 {
-  vtkStructuredGrid* strcGrid = vtkStructuredGrid::SafeDownCast(inputGrd);
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  return 1;
+}
 
-  vtkIdType i, j;
-  int isTwoDim = 0;
-  enum TwoDimType
-  {
-    XY,
-    YZ,
-    XZ
-  };
-  TwoDimType twoDimType;
-  vtkIdType numCells = 0;
-  int gridDims[3] = { 0, 0, 0 };
-  strcGrid->GetDimensions(gridDims);
-  isTwoDim = int(gridDims[0] <= 1 || gridDims[1] <= 1 || gridDims[2] <= 1);
-  if (gridDims[0] <= 1)
-    twoDimType = YZ;
-  else if (gridDims[1] <= 1)
-    twoDimType = XZ;
-  else
-    twoDimType = XY;
-  numCells = strcGrid->GetNumberOfCells();
+//------------------------------------------------------------------------------
+int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // input and output information objects
+  vtkInformation* inputInf = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfor = outputVector->GetInformationObject(0);
 
-  vtkTableBasedClipperVolumeFromVolume* visItVFV =
-    new vtkTableBasedClipperVolumeFromVolume(this->OutputPointsPrecision,
-      strcGrid->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
+  // Get the input of which we have to create a copy since the clipper requires
+  // that InterpolateAllocate() be invoked for the output based on its input in
+  // terms of the point data. If the input and output arrays are different,
+  // vtkCell3D's Clip will fail. The last argument of InterpolateAllocate makes
+  // sure that arrays are shallow-copied from theInput to cpyInput.
+  vtkDataSet* theInput = vtkDataSet::SafeDownCast(inputInf->Get(vtkDataObject::DATA_OBJECT()));
+  vtkSmartPointer<vtkDataSet> cpyInput;
+  cpyInput.TakeReference(theInput->NewInstance());
+  cpyInput->CopyStructure(theInput);
+  cpyInput->GetCellData()->PassData(theInput->GetCellData());
+  cpyInput->GetFieldData()->PassData(theInput->GetFieldData());
+  cpyInput->GetPointData()->InterpolateAllocate(theInput->GetPointData(), 0, 0, 1);
+
+  // get the output (the remaining and the clipped parts)
+  vtkUnstructuredGrid* outputUG =
+    vtkUnstructuredGrid::SafeDownCast(outInfor->Get(vtkDataObject::DATA_OBJECT()));
+  vtkUnstructuredGrid* clippedOutputUG = this->GetClippedOutput();
 
-  int shiftLUTx[8] = { 0, 1, 1, 0, 0, 1, 1, 0 };
-  int shiftLUTy[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
-  int shiftLUTz[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
+  inputInf = nullptr;
+  outInfor = nullptr;
+  theInput = nullptr;
+  vtkDebugMacro(<< "Clipping dataset" << endl);
 
-  int* shiftLUT[3];
-  if (isTwoDim && twoDimType == XZ)
-  {
-    shiftLUT[0] = shiftLUTx;
-    shiftLUT[1] = shiftLUTz;
-    shiftLUT[2] = shiftLUTy;
-  }
-  else if (isTwoDim && twoDimType == YZ)
+  int i;
+  vtkIdType numbPnts = cpyInput->GetNumberOfPoints();
+
+  // handling exceptions
+  if (numbPnts < 1)
   {
-    shiftLUT[0] = shiftLUTy;
-    shiftLUT[1] = shiftLUTz;
-    shiftLUT[2] = shiftLUTx;
+    vtkDebugMacro(<< "No data to clip" << endl);
+    outputUG = nullptr;
+    return 1;
   }
-  else
+
+  if (!this->ClipFunction && this->GenerateClipScalars)
   {
-    shiftLUT[0] = shiftLUTx;
-    shiftLUT[1] = shiftLUTy;
-    shiftLUT[2] = shiftLUTz;
+    vtkErrorMacro(<< "Cannot generate clip scalars "
+                  << "if no clip function defined" << endl);
+    outputUG = nullptr;
+    return 1;
   }
 
-  vtkIdType numbPnts = 0;
-  int cellDims[3] = { gridDims[0] - 1, gridDims[1] - 1, gridDims[2] - 1 };
-  int cyStride = (cellDims[0] ? cellDims[0] : 1);
-  int czStride = (cellDims[0] ? cellDims[0] : 1) * (cellDims[1] ? cellDims[1] : 1);
-  int pyStride = gridDims[0];
-  int pzStride = gridDims[0] * gridDims[1];
+  vtkDataArray* clipAray = nullptr;
+  vtkDoubleArray* pScalars = nullptr;
 
-  for (i = 0; i < numCells; i++)
+  // check whether the cells are clipped with input scalars or a clip function
+  if (this->ClipFunction)
   {
-    int caseIndx = 0;
-    int theCellI = (cellDims[0] > 0 ? i % cellDims[0] : 0);
-    int theCellJ = (cellDims[1] > 0 ? (i / cyStride) % cellDims[1] : 0);
-    int theCellK = (cellDims[2] > 0 ? (i / czStride) : 0);
-    double grdDiffs[8];
-
-    numbPnts = isTwoDim ? 4 : 8;
+    pScalars = vtkDoubleArray::New();
+    pScalars->SetNumberOfTuples(numbPnts);
+    pScalars->SetName("ClipDataSetScalars");
 
-    for (j = numbPnts - 1; j >= 0; j--)
+    // enable clipDataSetScalars to be passed to the output
+    if (this->GenerateClipScalars)
     {
-      int pntIndex = (theCellI + shiftLUT[0][j]) + (theCellJ + shiftLUT[1][j]) * pyStride +
-        (theCellK + shiftLUT[2][j]) * pzStride;
-
-      grdDiffs[j] = clipAray->GetComponent(pntIndex, 0) - isoValue;
-      caseIndx += ((grdDiffs[j] >= 0.0) ? 1 : 0);
-      caseIndx <<= (1 - (!j));
+      cpyInput->GetPointData()->SetScalars(pScalars);
     }
 
-    int nOutputs;
-    vtkIdType intrpIds[4];
-    unsigned char* thisCase = nullptr;
-
-    if (isTwoDim)
+    // evaluate the clip function at once for point sets
+    vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(cpyInput);
+    if (inputPointSet && inputPointSet->GetPoints())
     {
-      thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua
-                   [vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx]];
-      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
+      this->ClipFunction->FunctionValue(inputPointSet->GetPoints()->GetData(), pScalars);
     }
     else
     {
-      thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex
-                   [vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx]];
-      nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-    }
-
-    for (j = 0; j < nOutputs; j++)
-    {
-      int nCellPts = 0;
-      int intrpIdx = -1;
-      int theColor = -1;
-      unsigned char theShape = *thisCase++;
-
-      switch (theShape)
-      {
-        case ST_HEX:
-          nCellPts = 8;
-          theColor = *thisCase++;
-          break;
-
-        case ST_WDG:
-          nCellPts = 6;
-          theColor = *thisCase++;
-          break;
-
-        case ST_PYR:
-          nCellPts = 5;
-          theColor = *thisCase++;
-          break;
-
-        case ST_TET:
-          nCellPts = 4;
-          theColor = *thisCase++;
-          break;
-
-        case ST_QUA:
-          nCellPts = 4;
-          theColor = *thisCase++;
-          break;
-
-        case ST_TRI:
-          nCellPts = 3;
-          theColor = *thisCase++;
-          break;
-
-        case ST_LIN:
-          nCellPts = 2;
-          theColor = *thisCase++;
-          break;
-
-        case ST_VTX:
-          nCellPts = 1;
-          theColor = *thisCase++;
-          break;
-
-        case ST_PNT:
-          intrpIdx = *thisCase++;
-          theColor = *thisCase++;
-          nCellPts = *thisCase++;
-          break;
-
-        default:
-          vtkErrorMacro(<< "An invalid output shape was found in "
-                        << "the ClipCases." << endl);
-      }
-
-      if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
+      for (i = 0; i < numbPnts; i++)
       {
-        // We don't want this one; it's the wrong side.
-        thisCase += nCellPts;
-        continue;
+        double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
+        pScalars->SetTuple1(i, s);
       }
+    }
 
-      vtkIdType shapeIds[8];
-      for (int p = 0; p < nCellPts; p++)
-      {
-        unsigned char pntIndex = *thisCase++;
-
-        if (pntIndex <= P7)
-        {
-          // We know pt P0 must be >P0 since we already
-          // assume P0 == 0.  This is why we do not
-          // bother subtracting P0 from pt here.
-          shapeIds[p] =
-            ((theCellI + shiftLUT[0][pntIndex]) + (theCellJ + shiftLUT[1][pntIndex]) * pyStride +
-              (theCellK + shiftLUT[2][pntIndex]) * pzStride);
-        }
-        else if (pntIndex >= EA && pntIndex <= EL)
-        {
-          int pt1Index =
-            vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges[pntIndex - EA][0];
-          int pt2Index =
-            vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges[pntIndex - EA][1];
-
-          if (pt2Index < pt1Index)
-          {
-            int temp = pt2Index;
-            pt2Index = pt1Index;
-            pt1Index = temp;
-          }
-
-          double pt1ToPt2 = grdDiffs[pt2Index] - grdDiffs[pt1Index];
-          double pt1ToIso = 0.0 - grdDiffs[pt1Index];
-          double p1Weight = 1.0 - pt1ToIso / pt1ToPt2;
-
-          int pntIndx1 =
-            ((theCellI + shiftLUT[0][pt1Index]) + (theCellJ + shiftLUT[1][pt1Index]) * pyStride +
-              (theCellK + shiftLUT[2][pt1Index]) * pzStride);
-          int pntIndx2 =
-            ((theCellI + shiftLUT[0][pt2Index]) + (theCellJ + shiftLUT[1][pt2Index]) * pyStride +
-              (theCellK + shiftLUT[2][pt2Index]) * pzStride);
-
-          shapeIds[p] = visItVFV->AddPoint(pntIndx1, pntIndx2, p1Weight);
-        }
-        else if (pntIndex >= N0 && pntIndex <= N3)
-        {
-          shapeIds[p] = intrpIds[pntIndex - N0];
-        }
-        else
-        {
-          vtkErrorMacro(<< "An invalid output point value "
-                        << "was found in the ClipCases." << endl);
-        }
-      }
+    clipAray = pScalars;
+  }
+  else // using input scalars
+  {
+    clipAray = this->GetInputArrayToProcess(0, inputVector);
+    if (!clipAray)
+    {
+      vtkErrorMacro(<< "no input scalars." << endl);
+      return 1;
+    }
+  }
 
-      switch (theShape)
-      {
-        case ST_HEX:
-          visItVFV->AddHex(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4],
-            shapeIds[5], shapeIds[6], shapeIds[7]);
-          break;
+  int gridType = cpyInput->GetDataObjectType();
+  double isoValue = (!this->ClipFunction || this->UseValueAsOffset) ? this->Value : 0.0;
+  if (gridType == VTK_IMAGE_DATA || gridType == VTK_STRUCTURED_POINTS)
+  {
+    this->ClipImageData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipImageData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else if (gridType == VTK_POLY_DATA)
+  {
+    this->ClipPolyData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipPolyData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else if (gridType == VTK_RECTILINEAR_GRID)
+  {
+    this->ClipRectilinearGridData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipRectilinearGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else if (gridType == VTK_STRUCTURED_GRID)
+  {
+    this->ClipStructuredGridData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipStructuredGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else if (gridType == VTK_UNSTRUCTURED_GRID)
+  {
+    this->ClipUnstructuredGridData(cpyInput, clipAray, isoValue, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipUnstructuredGridData(cpyInput, clipAray, isoValue, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
+  else
+  {
+    this->ClipDataSet(cpyInput, clipAray, outputUG);
+    if (clippedOutputUG)
+    {
+      this->InsideOut = !(this->InsideOut);
+      this->ClipDataSet(cpyInput, clipAray, clippedOutputUG);
+      this->InsideOut = !(this->InsideOut);
+    }
+  }
 
-        case ST_WDG:
-          visItVFV->AddWedge(
-            i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4], shapeIds[5]);
-          break;
+  outputUG->Squeeze();
+  outputUG->GetFieldData()->PassData(cpyInput->GetFieldData());
 
-        case ST_PYR:
-          visItVFV->AddPyramid(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3], shapeIds[4]);
-          break;
+  if (clippedOutputUG)
+  {
+    clippedOutputUG->Squeeze();
+    clippedOutputUG->GetFieldData()->PassData(cpyInput->GetFieldData());
+  }
 
-        case ST_TET:
-          visItVFV->AddTet(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-          break;
+  if (pScalars)
+  {
+    pScalars->Delete();
+  }
+  pScalars = nullptr;
+  outputUG = nullptr;
+  clippedOutputUG = nullptr;
+  clipAray = nullptr;
 
-        case ST_QUA:
-          visItVFV->AddQuad(i, shapeIds[0], shapeIds[1], shapeIds[2], shapeIds[3]);
-          break;
+  return 1;
+}
 
-        case ST_TRI:
-          visItVFV->AddTri(i, shapeIds[0], shapeIds[1], shapeIds[2]);
-          break;
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipDataSet(
+  vtkDataSet* pDataSet, vtkDataArray* clipAray, vtkUnstructuredGrid* unstruct)
+{
+  vtkClipDataSet* clipData = vtkClipDataSet::New();
+  clipData->SetInputData(pDataSet);
+  clipData->SetValue(this->Value);
+  clipData->SetInsideOut(this->InsideOut);
+  clipData->SetClipFunction(this->ClipFunction);
+  clipData->SetUseValueAsOffset(this->UseValueAsOffset);
+  clipData->SetGenerateClipScalars(this->GenerateClipScalars);
 
-        case ST_LIN:
-          visItVFV->AddLine(i, shapeIds[0], shapeIds[1]);
-          break;
+  if (!this->ClipFunction)
+  {
+    pDataSet->GetPointData()->SetScalars(clipAray);
+  }
 
-        case ST_VTX:
-          visItVFV->AddVertex(i, shapeIds[0]);
-          break;
+  clipData->Update();
+  unstruct->ShallowCopy(clipData->GetOutput());
 
-        case ST_PNT:
-          intrpIds[intrpIdx] = visItVFV->AddCentroidPoint(nCellPts, shapeIds);
-          break;
-      }
-    }
+  clipData->Delete();
+  clipData = nullptr;
+}
 
-    thisCase = nullptr;
-  }
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipImageData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  int i, j;
+  int dataDims[3];
+  double spacings[3];
+  double tmpValue = 0.0;
+  vtkRectilinearGrid* rectGrid = nullptr;
+  vtkImageData* volImage = vtkImageData::SafeDownCast(inputGrd);
+  volImage->GetDimensions(dataDims);
+  volImage->GetSpacing(spacings);
+  const double* dataBBox = volImage->GetBounds();
 
-  int toDelete = 0;
-  double* theCords = nullptr;
-  vtkPoints* inputPts = strcGrid->GetPoints();
-  if (inputPts->GetDataType() == VTK_DOUBLE)
-  {
-    theCords = static_cast<double*>(inputPts->GetVoidPointer(0));
-  }
-  else
+  vtkDoubleArray* pxCoords = vtkDoubleArray::New();
+  vtkDoubleArray* pyCoords = vtkDoubleArray::New();
+  vtkDoubleArray* pzCoords = vtkDoubleArray::New();
+  vtkDoubleArray* tmpArays[3] = { pxCoords, pyCoords, pzCoords };
+  for (j = 0; j < 3; j++)
   {
-    toDelete = 1;
-    numbPnts = inputPts->GetNumberOfPoints();
-    theCords = new double[numbPnts * 3];
-    for (i = 0; i < numbPnts; i++)
+    tmpArays[j]->SetNumberOfComponents(1);
+    tmpArays[j]->SetNumberOfTuples(dataDims[j]);
+    for (tmpValue = dataBBox[j << 1], i = 0; i < dataDims[j]; i++, tmpValue += spacings[j])
     {
-      inputPts->GetPoint(i, theCords + (i << 1) + i);
+      tmpArays[j]->SetComponent(i, 0, tmpValue);
     }
+    tmpArays[j] = nullptr;
   }
-  inputPts = nullptr;
 
-  visItVFV->ConstructDataSet(strcGrid, outputUG, theCords);
+  rectGrid = vtkRectilinearGrid::New();
+  rectGrid->SetDimensions(dataDims);
+  rectGrid->SetXCoordinates(pxCoords);
+  rectGrid->SetYCoordinates(pyCoords);
+  rectGrid->SetZCoordinates(pzCoords);
+  rectGrid->GetPointData()->ShallowCopy(volImage->GetPointData());
+  rectGrid->GetCellData()->ShallowCopy(volImage->GetCellData());
+
+  this->ClipRectilinearGridData(rectGrid, clipAray, isoValue, outputUG);
 
-  delete visItVFV;
-  if (toDelete)
-  {
-    delete[] theCords;
-  }
-  visItVFV = nullptr;
-  theCords = nullptr;
-  strcGrid = nullptr;
+  pxCoords->Delete();
+  pyCoords->Delete();
+  pzCoords->Delete();
+  rectGrid->Delete();
+  pxCoords = nullptr;
+  pyCoords = nullptr;
+  pzCoords = nullptr;
+  rectGrid = nullptr;
+  volImage = nullptr;
+  dataBBox = nullptr;
 }
 
 //------------------------------------------------------------------------------
-void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
+void vtkTableBasedClipDataSet::ClipPolyData(
   vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
 {
-  vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
-
-  vtkIdType i, j;
-  vtkIdType numbPnts = 0;
-  int numCants = 0; // number of cells not clipped by this filter
-  vtkIdType numCells = unstruct->GetNumberOfCells();
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(inputGrd);
+  vtkIdType numCells = polyData->GetNumberOfCells();
 
-  // volume from volume
   vtkTableBasedClipperVolumeFromVolume* visItVFV =
     new vtkTableBasedClipperVolumeFromVolume(this->OutputPointsPrecision,
-      unstruct->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
+      polyData->GetNumberOfPoints(), int(pow(double(numCells), double(0.6667f))) * 5 + 100);
 
-  // the stuffs that can not be clipped by this filter
   vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
-  specials->SetPoints(unstruct->GetPoints());
-  specials->GetPointData()->ShallowCopy(unstruct->GetPointData());
+  specials->SetPoints(polyData->GetPoints());
+  specials->GetPointData()->ShallowCopy(polyData->GetPointData());
   specials->Allocate(numCells);
 
+  vtkIdType i, j;
+  vtkIdType numbPnts = 0;
+  int numCants = 0; // number of cells not clipped by this filter
+
   for (i = 0; i < numCells; i++)
   {
-    int cellType = unstruct->GetCellType(i);
+    int cellType = polyData->GetCellType(i);
+    bool bCanClip = false;
     const vtkIdType* pntIndxs = nullptr;
-    unstruct->GetCellPoints(i, numbPnts, pntIndxs);
+    polyData->GetCellPoints(i, numbPnts, pntIndxs);
 
-    bool bCanClip = false;
     switch (cellType)
     {
       case VTK_TETRA:
       case VTK_PYRAMID:
       case VTK_WEDGE:
       case VTK_HEXAHEDRON:
-      case VTK_VOXEL:
       case VTK_TRIANGLE:
       case VTK_QUAD:
-      case VTK_PIXEL:
       case VTK_LINE:
       case VTK_VERTEX:
         bCanClip = true;
@@ -2948,8 +2782,8 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
 
     if (bCanClip)
     {
-      int caseIndx = 0;
       double grdDiffs[8];
+      int caseIndx = 0;
 
       for (j = numbPnts - 1; j >= 0; j--)
       {
@@ -2960,74 +2794,59 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
 
       int startIdx = 0;
       int nOutputs = 0;
-      typedef const int EDGEIDXS[2];
-      EDGEIDXS* edgeVtxs = nullptr;
+      typedef int EDGEIDXS[2];
+      const EDGEIDXS* edgeVtxs = nullptr;
       unsigned char* thisCase = nullptr;
 
-      // start index, split case, number of output, and vertices from edges
       switch (cellType)
       {
         case VTK_TETRA:
           startIdx = vtkTableBasedClipperClipTables::StartClipShapesTet[caseIndx];
           thisCase = &vtkTableBasedClipperClipTables::ClipShapesTet[startIdx];
           nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTet[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
+          edgeVtxs = vtkTableBasedClipperTriangulationTables::TetVerticesFromEdges;
           break;
 
         case VTK_PYRAMID:
           startIdx = vtkTableBasedClipperClipTables::StartClipShapesPyr[caseIndx];
           thisCase = &vtkTableBasedClipperClipTables::ClipShapesPyr[startIdx];
           nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPyr[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
+          edgeVtxs = vtkTableBasedClipperTriangulationTables::PyramidVerticesFromEdges;
           break;
 
         case VTK_WEDGE:
           startIdx = vtkTableBasedClipperClipTables::StartClipShapesWdg[caseIndx];
           thisCase = &vtkTableBasedClipperClipTables::ClipShapesWdg[startIdx];
           nOutputs = vtkTableBasedClipperClipTables::NumClipShapesWdg[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
+          edgeVtxs = vtkTableBasedClipperTriangulationTables::WedgeVerticesFromEdges;
           break;
 
         case VTK_HEXAHEDRON:
           startIdx = vtkTableBasedClipperClipTables::StartClipShapesHex[caseIndx];
           thisCase = &vtkTableBasedClipperClipTables::ClipShapesHex[startIdx];
           nOutputs = vtkTableBasedClipperClipTables::NumClipShapesHex[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
-          break;
-
-        case VTK_VOXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesVox[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesVox[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesVox[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::VoxVerticesFromEdges;
+          edgeVtxs = vtkTableBasedClipperTriangulationTables::HexVerticesFromEdges;
           break;
 
         case VTK_TRIANGLE:
           startIdx = vtkTableBasedClipperClipTables::StartClipShapesTri[caseIndx];
           thisCase = &vtkTableBasedClipperClipTables::ClipShapesTri[startIdx];
           nOutputs = vtkTableBasedClipperClipTables::NumClipShapesTri[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
+          edgeVtxs = vtkTableBasedClipperTriangulationTables::TriVerticesFromEdges;
           break;
 
         case VTK_QUAD:
           startIdx = vtkTableBasedClipperClipTables::StartClipShapesQua[caseIndx];
           thisCase = &vtkTableBasedClipperClipTables::ClipShapesQua[startIdx];
           nOutputs = vtkTableBasedClipperClipTables::NumClipShapesQua[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
-          break;
-
-        case VTK_PIXEL:
-          startIdx = vtkTableBasedClipperClipTables::StartClipShapesPix[caseIndx];
-          thisCase = &vtkTableBasedClipperClipTables::ClipShapesPix[startIdx];
-          nOutputs = vtkTableBasedClipperClipTables::NumClipShapesPix[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::PixelVerticesFromEdges;
+          edgeVtxs = vtkTableBasedClipperTriangulationTables::QuadVerticesFromEdges;
           break;
 
         case VTK_LINE:
           startIdx = vtkTableBasedClipperClipTables::StartClipShapesLin[caseIndx];
           thisCase = &vtkTableBasedClipperClipTables::ClipShapesLin[startIdx];
           nOutputs = vtkTableBasedClipperClipTables::NumClipShapesLin[caseIndx];
-          edgeVtxs = (EDGEIDXS*)vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
+          edgeVtxs = vtkTableBasedClipperTriangulationTables::LineVerticesFromEdges;
           break;
 
         case VTK_VERTEX:
@@ -3038,15 +2857,14 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
           break;
       }
 
-      int intrpIds[4];
+      vtkIdType intrpIds[4];
       for (j = 0; j < nOutputs; j++)
       {
         int nCellPts = 0;
-        int theColor = -1;
         int intrpIdx = -1;
+        int theColor = -1;
         unsigned char theShape = *thisCase++;
 
-        // number of points and color
         switch (theShape)
         {
           case ST_HEX:
@@ -3063,7 +2881,6 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
             nCellPts = 5;
             theColor = *thisCase++;
             break;
-
           case ST_TET:
             nCellPts = 4;
             theColor = *thisCase++;
@@ -3096,8 +2913,8 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
             break;
 
           default:
-            vtkErrorMacro(<< "An invalid output shape was found "
-                          << "in the ClipCases." << endl);
+            vtkErrorMacro(<< "An invalid output shape was found in "
+                          << "the ClipCases." << endl);
         }
 
         if ((!this->InsideOut && theColor == COLOR0) || (this->InsideOut && theColor == COLOR1))
@@ -3114,9 +2931,6 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
 
           if (pntIndex <= P7)
           {
-            // We know pt P0 must be >P0 since we already
-            // assume P0 == 0.  This is why we do not
-            // bother subtracting P0 from pt here.
             shapeIds[p] = pntIndxs[pntIndex];
           }
           else if (pntIndex >= EA && pntIndex <= EL)
@@ -3140,12 +2954,12 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
           }
           else if (pntIndex >= N0 && pntIndex <= N3)
           {
-            shapeIds[p] = intrpIds[pntIndex - N0];
+            shapeIds[p] = static_cast<int>(intrpIds[pntIndex - N0]);
           }
           else
           {
-            vtkErrorMacro(<< "An invalid output point value was found "
-                          << "in the ClipCases." << endl);
+            vtkErrorMacro(<< "An invalid output point value "
+                          << "was found in the ClipCases." << endl);
           }
         }
 
@@ -3195,27 +3009,15 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
       edgeVtxs = nullptr;
       thisCase = nullptr;
     }
-    else if (cellType == VTK_POLYHEDRON)
-    {
-      if (numCants == 0)
-      {
-        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
-      }
-      vtkIdType nfaces;
-      const vtkIdType* facePtIds;
-      unstruct->GetFaceStream(i, nfaces, facePtIds);
-      specials->InsertNextCell(cellType, nfaces, facePtIds);
-      specials->GetCellData()->CopyData(unstruct->GetCellData(), i, numCants);
-      numCants++;
-    }
     else
     {
       if (numCants == 0)
       {
-        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
+        specials->GetCellData()->CopyAllocate(polyData->GetCellData(), numCells);
       }
+
       specials->InsertNextCell(cellType, numbPnts, pntIndxs);
-      specials->GetCellData()->CopyData(unstruct->GetCellData(), i, numCants);
+      specials->GetCellData()->CopyData(polyData->GetCellData(), i, numCants);
       numCants++;
     }
 
@@ -3224,7 +3026,7 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
 
   int toDelete = 0;
   double* theCords = nullptr;
-  vtkPoints* inputPts = unstruct->GetPoints();
+  vtkPoints* inputPts = polyData->GetPoints();
   if (inputPts->GetDataType() == VTK_DOUBLE)
   {
     theCords = static_cast<double*>(inputPts->GetVoidPointer(0));
@@ -3241,14 +3043,13 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   }
   inputPts = nullptr;
 
-  // the stuff that can not be clipped
   if (numCants > 0)
   {
     vtkUnstructuredGrid* vtkUGrid = vtkUnstructuredGrid::New();
     this->ClipDataSet(specials, clipAray, vtkUGrid);
 
     vtkUnstructuredGrid* visItGrd = vtkUnstructuredGrid::New();
-    visItVFV->ConstructDataSet(unstruct, visItGrd, theCords);
+    visItVFV->ConstructDataSet(polyData, visItGrd, theCords);
 
     vtkAppendFilter* appender = vtkAppendFilter::New();
     appender->AddInputData(vtkUGrid);
@@ -3258,15 +3059,15 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
     outputUG->ShallowCopy(appender->GetOutput());
 
     appender->Delete();
-    visItGrd->Delete();
     vtkUGrid->Delete();
+    visItGrd->Delete();
     appender = nullptr;
     vtkUGrid = nullptr;
     visItGrd = nullptr;
   }
   else
   {
-    visItVFV->ConstructDataSet(unstruct, outputUG, theCords);
+    visItVFV->ConstructDataSet(polyData, outputUG, theCords);
   }
 
   specials->Delete();
@@ -3278,6 +3079,138 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   specials = nullptr;
   visItVFV = nullptr;
   theCords = nullptr;
+  polyData = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipRectilinearGridData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  vtkRectilinearGrid* rectGrid = vtkRectilinearGrid::SafeDownCast(inputGrd);
+
+  int rectDims[3];
+  rectGrid->GetDimensions(rectDims);
+  vtkIdType numCells = rectGrid->GetNumberOfCells();
+
+  std::vector<vtkTableBasedClipperFragment> fragments(
+    (numCells + ClipBatchSize - 1) / ClipBatchSize);
+  ClipStructuredCells clipper(
+    rectDims, numCells, clipAray, isoValue, this->InsideOut != 0, fragments);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(fragments.size()), clipper);
+  if (clipper.InvalidCase)
+  {
+    vtkErrorMacro(<< "An invalid output shape or point value was found "
+                  << "in the ClipCases." << endl);
+  }
+
+  ConstructClippedDataSet(rectGrid, fragments, this->OutputPointsPrecision, outputUG);
+}
+
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipStructuredGridData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  vtkStructuredGrid* strcGrid = vtkStructuredGrid::SafeDownCast(inputGrd);
+
+  int gridDims[3] = { 0, 0, 0 };
+  strcGrid->GetDimensions(gridDims);
+  vtkIdType numCells = strcGrid->GetNumberOfCells();
+
+  std::vector<vtkTableBasedClipperFragment> fragments(
+    (numCells + ClipBatchSize - 1) / ClipBatchSize);
+  ClipStructuredCells clipper(
+    gridDims, numCells, clipAray, isoValue, this->InsideOut != 0, fragments);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(fragments.size()), clipper);
+  if (clipper.InvalidCase)
+  {
+    vtkErrorMacro(<< "An invalid output shape or point value was found "
+                  << "in the ClipCases." << endl);
+  }
+
+  ConstructClippedDataSet(strcGrid, fragments, this->OutputPointsPrecision, outputUG);
+}
+
+//------------------------------------------------------------------------------
+void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
+  vtkDataSet* inputGrd, vtkDataArray* clipAray, double isoValue, vtkUnstructuredGrid* outputUG)
+{
+  vtkUnstructuredGrid* unstruct = vtkUnstructuredGrid::SafeDownCast(inputGrd);
+
+  vtkIdType numCells = unstruct->GetNumberOfCells();
+
+  std::vector<vtkTableBasedClipperFragment> fragments(
+    (numCells + ClipBatchSize - 1) / ClipBatchSize);
+  ClipUnstructuredCells clipper(unstruct, clipAray, isoValue, this->InsideOut != 0, fragments);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(fragments.size()), clipper);
+  if (clipper.InvalidCase)
+  {
+    vtkErrorMacro(<< "An invalid output shape or point value was found "
+                  << "in the ClipCases." << endl);
+  }
+
+  // the stuffs that can not be clipped by this filter
+  int numCants = 0;
+  vtkUnstructuredGrid* specials = vtkUnstructuredGrid::New();
+  specials->SetPoints(unstruct->GetPoints());
+  specials->GetPointData()->ShallowCopy(unstruct->GetPointData());
+  for (const vtkTableBasedClipperFragment& fragment : fragments)
+  {
+    for (vtkIdType i : fragment.SpecialCells)
+    {
+      if (numCants == 0)
+      {
+        specials->Allocate(numCells);
+        specials->GetCellData()->CopyAllocate(unstruct->GetCellData(), numCells);
+      }
+      int cellType = unstruct->GetCellType(i);
+      if (cellType == VTK_POLYHEDRON)
+      {
+        vtkIdType nfaces;
+        const vtkIdType* facePtIds;
+        unstruct->GetFaceStream(i, nfaces, facePtIds);
+        specials->InsertNextCell(cellType, nfaces, facePtIds);
+      }
+      else
+      {
+        vtkIdType numbPnts;
+        const vtkIdType* pntIndxs;
+        unstruct->GetCellPoints(i, numbPnts, pntIndxs);
+        specials->InsertNextCell(cellType, numbPnts, pntIndxs);
+      }
+      specials->GetCellData()->CopyData(unstruct->GetCellData(), i, numCants);
+      numCants++;
+    }
+  }
+
+  if (numCants > 0)
+  {
+    vtkUnstructuredGrid* vtkUGrid = vtkUnstructuredGrid::New();
+    this->ClipDataSet(specials, clipAray, vtkUGrid);
+
+    vtkUnstructuredGrid* visItGrd = vtkUnstructuredGrid::New();
+    ConstructClippedDataSet(unstruct, fragments, this->OutputPointsPrecision, visItGrd);
+
+    vtkAppendFilter* appender = vtkAppendFilter::New();
+    appender->AddInputData(vtkUGrid);
+    appender->AddInputData(visItGrd);
+    appender->Update();
+
+    outputUG->ShallowCopy(appender->GetOutput());
+
+    appender->Delete();
+    visItGrd->Delete();
+    vtkUGrid->Delete();
+    appender = nullptr;
+    vtkUGrid = nullptr;
+    visItGrd = nullptr;
+  }
+  else
+  {
+    ConstructClippedDataSet(unstruct, fragments, this->OutputPointsPrecision, outputUG);
+  }
+
+  specials->Delete();
+  specials = nullptr;
   unstruct = nullptr;
 }
 
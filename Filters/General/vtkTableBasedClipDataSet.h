@@ -68,12 +68,19 @@
  *  advantages are gained by adopting the unique clipping and triangulation tables
  *  proposed by VisIt.
  *
+ *  Unstructured, structured, rectilinear and image data are clipped with
+ *  vtkSMPTools: batches of cells are clipped in parallel into fragments, whose
+ *  edge points are then merged with vtkStaticEdgeLocatorTemplate. The output
+ *  cells are ordered as their input cells, and the output points start with the
+ *  used input points by increasing id, so that the output does not depend on
+ *  the number of threads.
+ *
  * @warning
- *  vtkTableBasedClipDataSet makes use of a hash table (that is provided by class
- *  maintained by internal class vtkTableBasedClipperDataSetFromVolume) to achieve
- *  rapid removal of duplicate points. The hash-based mechanism simply compares the
- *  point Ids, without considering the actual inter-point distance (vtkClipDataSet
- *  adopts vtkMergePoints that though considers the inter-point distance for robust
+ *  vtkTableBasedClipDataSet merges the duplicate points by the point Ids of
+ *  their edges (with a hash table for polydata), to achieve rapid removal of
+ *  duplicate points. This mechanism simply compares the point Ids, without
+ *  considering the actual inter-point distance (vtkClipDataSet adopts
+ *  vtkMergePoints that though considers the inter-point distance for robust
  *  points merging ). As a result, some duplicate points may be present in the output.
  *  This problem occurs when some boundary (cut-through cells) happen to have faces
  *  EXACTLY aligned with the clipping plane (such as Plane, Box, or other implicit
@@ -0,0 +1,263 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterMeshCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that vtkDataSetSurfaceFilter reuses the surface of an unstructured
+// grid while only its attributes change, and that the surface of nonlinear
+// cells, which are subdivided, is not reused.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int Dim = 6;
+
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < Dim; ++k)
+  {
+    for (int j = 0; j < Dim; ++j)
+    {
+      for (int i = 0; i < Dim; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate((Dim - 1) * (Dim - 1) * (Dim - 1));
+  for (int k = 0; k < Dim - 1; ++k)
+  {
+    for (int j = 0; j < Dim - 1; ++j)
+    {
+      for (int i = 0; i < Dim - 1; ++i)
+      {
+        vtkIdType p = i + Dim * (j + Dim * k);
+        vtkIdType pts[8] = { p, p + 1, p + 1 + Dim, p + Dim, p + Dim * Dim, p + 1 + Dim * Dim,
+          p + 1 + Dim + Dim * Dim, p + Dim + Dim * Dim };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+      }
+    }
+  }
+}
+
+// Point data equal to the point id plus the time, and cell data equal to
+// the cell id plus the time.
+void SetTime(vtkUnstructuredGrid* grid, float time)
+{
+  vtkNew<vtkFloatArray> pointTime;
+  pointTime->SetName("PointTime");
+  pointTime->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+  {
+    pointTime->SetValue(i, i + time);
+  }
+  grid->GetPointData()->AddArray(pointTime);
+
+  vtkNew<vtkFloatArray> cellTime;
+  cellTime->SetName("CellTime");
+  cellTime->SetNumberOfTuples(grid->GetNumberOfCells());
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellTime->SetValue(i, i + time);
+  }
+  grid->GetCellData()->AddArray(cellTime);
+}
+
+// Check the attributes of the surface against its original ids.
+bool CheckOutput(vtkPolyData* output, float time, const char* step)
+{
+  vtkDataArray* pointTime = output->GetPointData()->GetArray("PointTime");
+  vtkIdTypeArray* pointIds =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkDataArray* cellTime = output->GetCellData()->GetArray("CellTime");
+  vtkIdTypeArray* cellIds =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  if (!pointTime || !pointIds || !cellTime || !cellIds || output->GetNumberOfCells() == 0)
+  {
+    std::cerr << step << ": missing arrays" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    if (pointTime->GetTuple1(i) != pointIds->GetValue(i) + time)
+    {
+      std::cerr << step << ": wrong attribute of point " << i << std::endl;
+      return false;
+    }
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    if (cellTime->GetTuple1(i) != cellIds->GetValue(i) + time)
+    {
+      std::cerr << step << ": wrong attribute of cell " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Two quadratic tetrahedra sharing a face.
+void MakeQuadraticGrid(vtkUnstructuredGrid* grid)
+{
+  const double coords[][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+    { 0.5, 0, 0 }, { 0.5, 0.5, 0 }, { 0, 0.5, 0 }, { 0, 0, 0.5 }, { 0.5, 0, 0.5 },
+    { 0, 0.5, 0.5 }, { 1, 1, 1 }, { 1, 0.5, 0.5 }, { 0.5, 1, 0.5 }, { 0.5, 0.5, 1 } };
+  vtkNew<vtkPoints> points;
+  for (const auto& coord : coords)
+  {
+    points->InsertNextPoint(coord);
+  }
+  grid->SetPoints(points);
+  const vtkIdType tetra0[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  const vtkIdType tetra1[10] = { 1, 3, 2, 10, 8, 9, 5, 11, 13, 12 };
+  grid->Allocate(2);
+  grid->InsertNextCell(VTK_QUADRATIC_TETRA, 10, tetra0);
+  grid->InsertNextCell(VTK_QUADRATIC_TETRA, 10, tetra1);
+}
+
+// Compare the surfaces of a filter using the mesh cache and of a filter
+// without it while the attributes change.
+bool TestQuadraticCells(int subdivisionLevel)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeQuadraticGrid(grid);
+  SetTime(grid, 0.0f);
+
+  vtkNew<vtkDataSetSurfaceFilter> cached;
+  cached->SetInputData(grid);
+  cached->SetNonlinearSubdivisionLevel(subdivisionLevel);
+  cached->UseMeshCacheOn();
+  vtkNew<vtkDataSetSurfaceFilter> reference;
+  reference->SetInputData(grid);
+  reference->SetNonlinearSubdivisionLevel(subdivisionLevel);
+
+  cached->Update();
+  vtkPoints* points = cached->GetOutput()->GetPoints();
+  for (int t = 1; t < 3; ++t)
+  {
+    SetTime(grid, static_cast<float>(t));
+    cached->Update();
+    reference->Update();
+    vtkDataArray* cachedTime = cached->GetOutput()->GetPointData()->GetArray("PointTime");
+    vtkDataArray* referenceTime = reference->GetOutput()->GetPointData()->GetArray("PointTime");
+    if (!cachedTime || !referenceTime ||
+      cachedTime->GetNumberOfTuples() != referenceTime->GetNumberOfTuples())
+    {
+      std::cerr << "Wrong surface with subdivision level " << subdivisionLevel << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < cachedTime->GetNumberOfTuples(); ++i)
+    {
+      if (cachedTime->GetTuple1(i) != referenceTime->GetTuple1(i))
+      {
+        std::cerr << "Wrong attribute of point " << i << " with subdivision level "
+                  << subdivisionLevel << std::endl;
+        return false;
+      }
+    }
+  }
+
+  if (cached->GetOutput()->GetPoints() == points)
+  {
+    std::cerr << "The surface was reused with subdivision level " << subdivisionLevel
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDataSetSurfaceFilterMeshCache(int, char*[])
+{
+  if (!TestQuadraticCells(0) || !TestQuadraticCells(1) || !TestQuadraticCells(2))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+
+  for (int delegation = 0; delegation < 2; ++delegation)
+  {
+    SetTime(grid, 0.0f);
+    vtkNew<vtkDataSetSurfaceFilter> surface;
+    surface->SetInputData(grid);
+    surface->SetDelegation(delegation);
+    surface->PassThroughPointIdsOn();
+    surface->PassThroughCellIdsOn();
+    surface->UseMeshCacheOn();
+    surface->Update();
+    if (!CheckOutput(surface->GetOutput(), 0.0f, "First execution"))
+    {
+      return EXIT_FAILURE;
+    }
+    vtkPoints* points = surface->GetOutput()->GetPoints();
+    vtkIdType numberOfCells = surface->GetOutput()->GetNumberOfCells();
+
+    // Only the attributes change: the surface is reused.
+    for (int t = 1; t < 3; ++t)
+    {
+      SetTime(grid, static_cast<float>(t));
+      surface->Update();
+      if (!CheckOutput(surface->GetOutput(), static_cast<float>(t), "Attribute change") ||
+        surface->GetOutput()->GetPoints() != points ||
+        surface->GetOutput()->GetNumberOfCells() != numberOfCells)
+      {
+        std::cerr << "The surface was not reused with delegation " << delegation << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // The original ids are not passed unless requested.
+    surface->PassThroughPointIdsOff();
+    surface->Update();
+    if (surface->GetOutput()->GetPointData()->GetArray("vtkOriginalPointIds") ||
+      !surface->GetOutput()->GetCellData()->GetArray("vtkOriginalCellIds"))
+    {
+      std::cerr << "Wrong original ids with delegation " << delegation << std::endl;
+      return EXIT_FAILURE;
+    }
+    surface->PassThroughPointIdsOn();
+
+    // The points move: the surface is extracted again.
+    grid->GetPoints()->SetPoint(0, -1.0, -1.0, -1.0);
+    grid->GetPoints()->Modified();
+    surface->Update();
+    if (!CheckOutput(surface->GetOutput(), 2.0f, "Point change") ||
+      surface->GetOutput()->GetPoints() == points)
+    {
+      std::cerr << "The surface was not extracted again with delegation " << delegation
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    grid->GetPoints()->SetPoint(0, 0.0, 0.0, 0.0);
+    grid->GetPoints()->Modified();
+  }
+
+  return EXIT_SUCCESS;
+}
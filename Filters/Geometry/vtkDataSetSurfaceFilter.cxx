@@ -23,6 +23,7 @@
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
 #include "vtkCellTypes.h"
+#include "vtkDataObjectMeshCache.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkHexahedron.h"
@@ -364,6 +365,9 @@ vtkDataSetSurfaceFilter::vtkDataSetSurfaceFilter()
   this->NonlinearSubdivisionLevel = 1;
 
   this->Delegation = false;
+
+  this->UseMeshCache = 0;
+  this->MeshCache = vtkDataObjectMeshCache::New();
 }
 
 //------------------------------------------------------------------------------
@@ -381,6 +385,105 @@ vtkDataSetSurfaceFilter::~vtkDataSetSurfaceFilter()
     this->OriginalCellIds->Delete();
     this->OriginalCellIds = nullptr;
   }
+  this->MeshCache->Delete();
+}
+
+namespace
+{
+// Copy the original ids array of the output to an id list and remove it if
+// it was not requested.
+vtkSmartPointer<vtkIdList> ExtractOriginalIds(
+  vtkDataSetAttributes* attributes, const char* name, bool requested)
+{
+  vtkIdTypeArray* array = vtkIdTypeArray::SafeDownCast(attributes->GetArray(name));
+  if (!array)
+  {
+    return nullptr;
+  }
+  vtkNew<vtkIdList> ids;
+  ids->SetNumberOfIds(array->GetNumberOfTuples());
+  std::copy(array->GetPointer(0), array->GetPointer(0) + array->GetNumberOfTuples(),
+    ids->GetPointer(0));
+  if (!requested)
+  {
+    attributes->RemoveArray(name);
+  }
+  return ids;
+}
+
+// Add the original ids array of the cached surface to the output.
+void AddOriginalIds(vtkDataSetAttributes* attributes, const char* name, vtkIdList* ids)
+{
+  vtkNew<vtkIdTypeArray> array;
+  array->SetName(name);
+  array->SetNumberOfTuples(ids->GetNumberOfIds());
+  std::copy(ids->begin(), ids->end(), array->GetPointer(0));
+  attributes->AddArray(array);
+}
+
+// Return true if the grid has nonlinear cells.
+bool HasNonlinearCells(vtkUnstructuredGrid* grid)
+{
+  vtkUnsignedCharArray* types = grid->GetDistinctCellTypesArray();
+  for (vtkIdType i = 0; i < types->GetNumberOfValues(); ++i)
+  {
+    if (!vtkCellTypes::IsLinear(types->GetValue(i)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+//------------------------------------------------------------------------------
+int vtkDataSetSurfaceFilter::UnstructuredGridExecuteWithMeshCache(
+  vtkDataSet* input, vtkPolyData* output)
+{
+  // Nonlinear cells are subdivided through the faces extracted by
+  // vtkUnstructuredGridGeometryFilter, whose ids are not the input ids, and
+  // may add interpolated points: their surface is not cached.
+  if (HasNonlinearCells(vtkUnstructuredGrid::SafeDownCast(input)))
+  {
+    vtkDebugMacro(<< "The surface of nonlinear cells is not cached");
+    this->MeshCache->ClearCache();
+    return this->UnstructuredGridExecute(input, output);
+  }
+
+  vtkMTimeType dependencyMTime = this->GetMTime();
+  if (this->MeshCache->IsValid(input, dependencyMTime))
+  {
+    vtkDebugMacro(<< "Reusing the cached surface");
+    this->MeshCache->CopyCacheToDataObject(input, output);
+    output->GetFieldData()->ShallowCopy(input->GetFieldData());
+    if (this->PassThroughCellIds)
+    {
+      AddOriginalIds(
+        output->GetCellData(), this->GetOriginalCellIdsName(), this->MeshCache->GetCellIds());
+    }
+    if (this->PassThroughPointIds && this->MeshCache->GetPointIds())
+    {
+      AddOriginalIds(
+        output->GetPointData(), this->GetOriginalPointIdsName(), this->MeshCache->GetPointIds());
+    }
+    return 1;
+  }
+
+  // The original ids give the input points and cells of the surface.
+  vtkTypeBool passThroughCellIds = this->PassThroughCellIds;
+  vtkTypeBool passThroughPointIds = this->PassThroughPointIds;
+  this->PassThroughCellIds = 1;
+  this->PassThroughPointIds = 1;
+  int ret = this->UnstructuredGridExecute(input, output);
+  this->PassThroughCellIds = passThroughCellIds;
+  this->PassThroughPointIds = passThroughPointIds;
+
+  vtkSmartPointer<vtkIdList> cellIds = ExtractOriginalIds(
+    output->GetCellData(), this->GetOriginalCellIdsName(), passThroughCellIds != 0);
+  vtkSmartPointer<vtkIdList> pointIds = ExtractOriginalIds(
+    output->GetPointData(), this->GetOriginalPointIdsName(), passThroughPointIds != 0);
+  this->MeshCache->UpdateCache(input, output, pointIds, cellIds, dependencyMTime);
+  return ret;
 }
 
 //------------------------------------------------------------------------------
@@ -420,6 +523,13 @@ int vtkDataSetSurfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     case VTK_UNSTRUCTURED_GRID:
     case VTK_UNSTRUCTURED_GRID_BASE:
     {
+      if (this->UseMeshCache && input->GetDataObjectType() == VTK_UNSTRUCTURED_GRID)
+      {
+        this->UnstructuredGridExecuteWithMeshCache(input, output);
+        output->CheckAttributes();
+        return 1;
+      }
+      this->MeshCache->ClearCache();
       this->UnstructuredGridExecute(input, output);
       output->CheckAttributes();
       return 1;
@@ -1282,6 +1392,7 @@ void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OriginalPointIdsName: " << this->GetOriginalPointIdsName() << endl;
   os << indent << "NonlinearSubdivisionLevel: " << this->GetNonlinearSubdivisionLevel() << endl;
   os << indent << "FastMode: " << this->FastMode << endl;
+  os << indent << "UseMeshCache: " << (this->UseMeshCache ? "On\n" : "Off\n");
 }
 
 //========================================================================
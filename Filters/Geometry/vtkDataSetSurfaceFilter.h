@@ -96,6 +96,7 @@ template <typename ArrayType>
 class vtkSmartPointer;
 
 class vtkCellIterator;
+class vtkDataObjectMeshCache;
 class vtkPointData;
 class vtkPoints;
 class vtkIdTypeArray;
@@ -226,6 +227,21 @@ public:
   vtkBooleanMacro(Delegation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * When on, keep the surface extracted from an unstructured grid and the
+   * ids of its points and cells, and reuse them while the mesh of the input
+   * (see vtkDataObjectMeshCache::GetMeshMTime()) and this filter are
+   * unchanged. Only the attributes are then copied, which speeds up the
+   * extraction of the surface of a time series on a static mesh. The surface
+   * of grids with nonlinear cells, which are subdivided, is not cached. Off
+   * by default.
+   */
+  vtkSetMacro(UseMeshCache, vtkTypeBool);
+  vtkGetMacro(UseMeshCache, vtkTypeBool);
+  vtkBooleanMacro(UseMeshCache, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Direct access methods so that this class can be used as an
@@ -380,8 +396,12 @@ protected:
   vtkTypeBool Delegation;
   bool FastMode;
 
+  vtkTypeBool UseMeshCache;
+  vtkDataObjectMeshCache* MeshCache;
+
 private:
   int UnstructuredGridBaseExecute(vtkDataSet* input, vtkPolyData* output);
+  int UnstructuredGridExecuteWithMeshCache(vtkDataSet* input, vtkPolyData* output);
   int UnstructuredGridExecuteInternal(vtkUnstructuredGridBase* input, vtkPolyData* output,
     bool handleSubdivision, vtkSmartPointer<vtkCellIterator> cellIter);
 
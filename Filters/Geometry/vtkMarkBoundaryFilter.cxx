@@ -187,18 +187,19 @@ struct MarkCellBoundary
   }
 };
 
+template <typename TIds>
 struct MarkPolys : MarkCellBoundary
 {
   vtkPolyData* Mesh;
   vtkIdType Offset;
   vtkCellArray* Polys;
-  vtkStaticCellLinksTemplate<vtkIdType>* Links;
+  vtkStaticCellLinksTemplate<TIds>* Links;
   // Working objects to avoid repeated allocation
   vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIter;
   vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> Neighbors;
 
   MarkPolys(vtkPolyData* mesh, const unsigned char* ghosts, vtkIdType offset, vtkCellArray* polys,
-    vtkStaticCellLinksTemplate<vtkIdType>* links, unsigned char* ptMarks, unsigned char* cellMarks,
+    vtkStaticCellLinksTemplate<TIds>* links, unsigned char* ptMarks, unsigned char* cellMarks,
     vtkIdType* faceMarks)
     : MarkCellBoundary(ghosts, ptMarks, cellMarks, faceMarks)
     , Mesh(mesh)
@@ -249,6 +250,18 @@ struct MarkPolys : MarkCellBoundary
   void Reduce() {}
 };
 
+// Build the links of the polygons and mark their boundary.
+template <typename TIds>
+void MarkPolygons(vtkPolyData* input, const unsigned char* ghosts, vtkIdType offset,
+  vtkCellArray* polys, unsigned char* bPoints, unsigned char* bCells, vtkIdType* bFaces)
+{
+  vtkIdType numPolys = polys->GetNumberOfCells();
+  vtkStaticCellLinksTemplate<TIds> links;
+  links.ThreadedBuildLinks(input->GetNumberOfPoints(), numPolys, polys);
+  MarkPolys<TIds> mark(input, ghosts, offset, polys, &links, bPoints, bCells, bFaces);
+  vtkSMPTools::For(0, numPolys, mark);
+}
+
 int PolyDataExecute(vtkDataSet* dsInput, const unsigned char* ghosts, unsigned char* bPoints,
   unsigned char* bCells, vtkIdType* bFaces)
 {
@@ -315,10 +328,15 @@ int PolyDataExecute(vtkDataSet* dsInput, const unsigned char* ghosts, unsigned c
   // polygon edges (i.e., the 1D faces of polygons).
   if (numPolys > 0)
   {
-    vtkStaticCellLinksTemplate<vtkIdType> links;
-    links.ThreadedBuildLinks(numPts, numPolys, polys);
-    MarkPolys mark(input, ghosts, (numVerts + numLines), polys, &links, bPoints, bCells, bFaces);
-    vtkSMPTools::For(0, numPolys, mark);
+    // Use compact links when the ids fit in them
+    if (numPts < VTK_INT_MAX && polys->GetNumberOfConnectivityIds() < VTK_INT_MAX)
+    {
+      MarkPolygons<int>(input, ghosts, (numVerts + numLines), polys, bPoints, bCells, bFaces);
+    }
+    else
+    {
+      MarkPolygons<vtkIdType>(input, ghosts, (numVerts + numLines), polys, bPoints, bCells, bFaces);
+    }
   }
 
   return 1;
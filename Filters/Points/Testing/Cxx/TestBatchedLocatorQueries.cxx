@@ -0,0 +1,344 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBatchedLocatorQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check that the batched locator queries return the results of the single
+// queries, and that the interpolation and probe filters using them do not
+// depend on the number of threads.
+
+#include "vtkCellLocator.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGaussianKernel.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkLinearKernel.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointInterpolator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkProbeFilter.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int NumberOfPoints = 20000;
+const int NumberOfQueries = 3000;
+
+vtkSmartPointer<vtkPoints> RandomPoints(int numPts, int seed, double min, double max)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (int i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetRangeValue(min, max);
+    }
+    points->SetPoint(i, x);
+  }
+  return points;
+}
+
+// A grid of dim^3 hexahedra in [-1,1]^3, with a linear point scalar
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int dim)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int k = 0; k <= dim; ++k)
+  {
+    for (int j = 0; j <= dim; ++j)
+    {
+      for (int i = 0; i <= dim; ++i)
+      {
+        double x[3] = { -1.0 + 2.0 * i / dim, -1.0 + 2.0 * j / dim, -1.0 + 2.0 * k / dim };
+        points->InsertNextPoint(x);
+        scalars->InsertNextValue(x[0] + 2.0 * x[1] + 3.0 * x[2]);
+      }
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->Allocate(dim * dim * dim);
+  const vtkIdType n = dim + 1;
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        vtkIdType p = i + n * (j + n * k);
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n, p + n * n, p + 1 + n * n,
+          p + 1 + n + n * n, p + n + n * n };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+  return grid;
+}
+
+// Check that the batched lists of a query match the list of its single query
+bool SameLists(const char* name, vtkIdType q, vtkIdTypeArray* offsets, vtkIdTypeArray* ids,
+  vtkIdList* list)
+{
+  const vtkIdType begin = offsets->GetValue(q);
+  const vtkIdType numIds = offsets->GetValue(q + 1) - begin;
+  bool same = numIds == list->GetNumberOfIds();
+  for (vtkIdType i = 0; same && i < numIds; ++i)
+  {
+    same = ids->GetValue(begin + i) == list->GetId(i);
+  }
+  if (!same)
+  {
+    std::cerr << name << ": batched query " << q << " differs from the single query"
+              << std::endl;
+  }
+  return same;
+}
+
+bool TestPointLocator(vtkAbstractPointLocator* locator, vtkPoints* queries)
+{
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  vtkNew<vtkIdList> list;
+  const char* name = locator->GetClassName();
+
+  locator->BatchFindClosestNPoints(10, queries, offsets, ids);
+  if (offsets->GetNumberOfValues() != NumberOfQueries + 1)
+  {
+    std::cerr << name << ": wrong number of offsets" << std::endl;
+    return false;
+  }
+  for (vtkIdType q = 0; q < NumberOfQueries; ++q)
+  {
+    locator->FindClosestNPoints(10, queries->GetPoint(q), list);
+    if (!SameLists(name, q, offsets, ids, list))
+    {
+      return false;
+    }
+  }
+
+  locator->BatchFindPointsWithinRadius(0.08, queries, offsets, ids);
+  for (vtkIdType q = 0; q < NumberOfQueries; ++q)
+  {
+    locator->FindPointsWithinRadius(0.08, queries->GetPoint(q), list);
+    if (!SameLists(name, q, offsets, ids, list))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestCellLocator(vtkAbstractCellLocator* locator, vtkDataSet* grid, vtkPoints* queries)
+{
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+  const char* name = locator->GetClassName();
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  vtkNew<vtkDoubleArray> weights;
+  locator->BatchFindCell(queries, 0.0, cellIds, pcoords, weights);
+  if (cellIds->GetNumberOfValues() != NumberOfQueries || weights->GetNumberOfComponents() != 8)
+  {
+    std::cerr << name << ": wrong size of the batched FindCell() results" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  double pc[3], w[8];
+  for (vtkIdType q = 0; q < NumberOfQueries; ++q)
+  {
+    vtkIdType cellId = locator->FindCell(queries->GetPoint(q), 0.0, cell, pc, w);
+    bool same = cellId == cellIds->GetValue(q);
+    for (int i = 0; same && cellId >= 0 && i < 3; ++i)
+    {
+      same = pc[i] == pcoords->GetComponent(q, i);
+    }
+    for (int i = 0; same && cellId >= 0 && i < 8; ++i)
+    {
+      same = w[i] == weights->GetComponent(q, i);
+    }
+    if (!same)
+    {
+      std::cerr << name << ": batched FindCell() " << q << " differs from the single query"
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameArrays(const char* name, vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    std::cerr << name << ": missing arrays or wrong sizes" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetVariantValue(i) != b->GetVariantValue(i))
+    {
+      std::cerr << name << ": value " << i << " differs with a single thread" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkDataArray> Interpolate(vtkPolyData* source, vtkDataSet* input, bool gaussian)
+{
+  vtkNew<vtkPointInterpolator> interpolator;
+  interpolator->SetInputData(input);
+  interpolator->SetSourceData(source);
+  if (gaussian)
+  {
+    vtkNew<vtkGaussianKernel> kernel;
+    kernel->SetRadius(0.1);
+    interpolator->SetKernel(kernel);
+  }
+  else
+  {
+    vtkNew<vtkLinearKernel> kernel;
+    kernel->SetKernelFootprintToNClosest();
+    kernel->SetNumberOfPoints(8);
+    interpolator->SetKernel(kernel);
+  }
+  interpolator->Update();
+  return interpolator->GetOutput()->GetPointData()->GetArray("Scalars");
+}
+
+vtkSmartPointer<vtkDataArray> Probe(vtkDataSet* source, vtkPolyData* input, bool useLocator)
+{
+  vtkNew<vtkProbeFilter> probe;
+  probe->SetInputData(input);
+  probe->SetSourceData(source);
+  if (useLocator)
+  {
+    vtkNew<vtkStaticCellLocator> locator;
+    probe->SetCellLocatorPrototype(locator);
+  }
+  probe->Update();
+  return probe->GetOutput()->GetPointData()->GetArray("Scalars");
+}
+}
+
+int TestBatchedLocatorQueries(int, char*[])
+{
+  vtkSmartPointer<vtkPoints> points = RandomPoints(NumberOfPoints, 1, 0.0, 1.0);
+  vtkSmartPointer<vtkPoints> queries = RandomPoints(NumberOfQueries, 2, -0.1, 1.1);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  // Batched point queries, by vtkStaticPointLocator and by the default
+  // implementation of vtkAbstractPointLocator
+  vtkNew<vtkStaticPointLocator> staticLocator;
+  staticLocator->SetDataSet(cloud);
+  vtkNew<vtkKdTreePointLocator> kdTreeLocator;
+  kdTreeLocator->SetDataSet(cloud);
+  if (!TestPointLocator(staticLocator, queries) || !TestPointLocator(kdTreeLocator, queries))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Batched FindCell()
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(20);
+  vtkSmartPointer<vtkPoints> cellQueries = RandomPoints(NumberOfQueries, 3, -1.1, 1.1);
+  vtkNew<vtkStaticCellLocator> staticCellLocator;
+  vtkNew<vtkCellLocator> cellLocator;
+  if (!TestCellLocator(staticCellLocator, grid, cellQueries) ||
+    !TestCellLocator(cellLocator, grid, cellQueries))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The interpolation of scattered points on scattered points and on an
+  // image, and the probe of a grid by scattered points
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfValues(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    scalars->SetValue(i, std::sin(6.0 * x[0]) * std::cos(4.0 * x[1]) + x[2]);
+  }
+  cloud->GetPointData()->SetScalars(scalars);
+  vtkNew<vtkPolyData> queryCloud;
+  queryCloud->SetPoints(queries);
+  vtkNew<vtkPolyData> cellQueryCloud;
+  cellQueryCloud->SetPoints(cellQueries);
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 40, 40);
+  image->SetOrigin(0.0, 0.0, 0.0);
+  image->SetSpacing(1.0 / 39, 1.0 / 39, 1.0 / 39);
+
+  vtkSmartPointer<vtkDataArray> results[4];
+  vtkSmartPointer<vtkDataArray> serialResults[4];
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    vtkSmartPointer<vtkDataArray>* r = pass == 0 ? results : serialResults;
+    vtkSMPTools::Initialize(pass == 0 ? 0 : 1);
+    r[0] = Interpolate(cloud, queryCloud, true);
+    r[1] = Interpolate(cloud, queryCloud, false);
+    r[2] = Interpolate(cloud, image, true);
+    r[3] = Probe(grid, cellQueryCloud, true);
+  }
+  vtkSMPTools::Initialize();
+  const char* names[4] = { "Gaussian interpolation", "Linear interpolation",
+    "Image interpolation", "Probe" };
+  for (int i = 0; i < 4; ++i)
+  {
+    if (!SameArrays(names[i], results[i], serialResults[i]))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The probe with a cell locator matches the probe with vtkDataSet::FindCell()
+  vtkSmartPointer<vtkDataArray> probed = Probe(grid, cellQueryCloud, false);
+  for (vtkIdType i = 0; i < NumberOfQueries; ++i)
+  {
+    if (std::abs(probed->GetComponent(i, 0) - results[3]->GetComponent(i, 0)) > 1e-9)
+    {
+      std::cerr << "Probe: value " << i << " differs without a cell locator" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
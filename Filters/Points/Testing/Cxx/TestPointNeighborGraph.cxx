@@ -0,0 +1,251 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointNeighborGraph.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Check the neighbor graphs of vtkStaticPointLocator against its queries,
+// and that the point filters using the graph produce the same output as
+// when they query the locator for each point.
+
+#include "vtkDataArray.h"
+#include "vtkEuclideanClusterExtraction.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPCACurvatureEstimation.h"
+#include "vtkPCANormalEstimation.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkStatisticalOutlierRemoval.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+const int NumberOfPoints = 20000;
+
+// Check that the neighbors of each point in the graph of the locator match
+// the list of a query, returned by getList.
+template <typename TQuery>
+bool CheckGraph(const char* name, vtkStaticPointLocator* locator, vtkIdType numNeighbors,
+  const TQuery& getList)
+{
+  vtkIdTypeArray* offsets = locator->GetNeighborGraphOffsets();
+  vtkIdTypeArray* ids = locator->GetNeighborGraphIds();
+  if (offsets->GetNumberOfValues() != NumberOfPoints + 1)
+  {
+    std::cerr << name << ": wrong number of offsets" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkIdList> list;
+  for (vtkIdType ptId = 0; ptId < NumberOfPoints; ++ptId)
+  {
+    getList(ptId, list);
+    const vtkIdType begin = offsets->GetValue(ptId);
+    const vtkIdType numIds = offsets->GetValue(ptId + 1) - begin;
+    bool same = numNeighbors >= 0 ? numIds >= numNeighbors : numIds == list->GetNumberOfIds();
+    const vtkIdType numChecked = numNeighbors >= 0 ? numNeighbors : numIds;
+    for (vtkIdType i = 0; same && i < numChecked; ++i)
+    {
+      same = ids->GetValue(begin + i) == list->GetId(i);
+    }
+    if (!same)
+    {
+      std::cerr << name << ": neighbors of point " << ptId << " differ from the query"
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameArrays(const char* name, vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    std::cerr << name << ": missing arrays or wrong sizes" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetVariantValue(i) != b->GetVariantValue(i))
+    {
+      std::cerr << name << ": value " << i << " differs with the neighbor graph" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Run a point filter on the cloud with a locator shared by the filters, so
+// that they share its neighbor graph
+vtkSmartPointer<vtkDataArray> RunFilter(
+  vtkPolyData* cloud, vtkStaticPointLocator* locator, int filter)
+{
+  switch (filter)
+  {
+    case 0:
+    {
+      vtkNew<vtkPCANormalEstimation> normals;
+      normals->SetInputData(cloud);
+      normals->SetLocator(locator);
+      normals->SetSampleSize(12);
+      normals->SetNormalOrientationToGraphTraversal();
+      normals->Update();
+      return normals->GetOutput()->GetPointData()->GetNormals();
+    }
+    case 1:
+    {
+      vtkNew<vtkPCACurvatureEstimation> curvature;
+      curvature->SetInputData(cloud);
+      curvature->SetLocator(locator);
+      curvature->SetSampleSize(10);
+      curvature->Update();
+      return curvature->GetOutput()->GetPointData()->GetArray("PCACurvature");
+    }
+    case 2:
+    {
+      vtkNew<vtkStatisticalOutlierRemoval> outliers;
+      outliers->SetInputData(cloud);
+      outliers->SetLocator(locator);
+      outliers->SetSampleSize(8);
+      outliers->SetStandardDeviationFactor(1.0);
+      outliers->GenerateOutliersOn();
+      outliers->Update();
+      return outliers->GetOutput()->GetPoints()->GetData();
+    }
+    default:
+    {
+      vtkNew<vtkEuclideanClusterExtraction> clusters;
+      clusters->SetInputData(cloud);
+      clusters->SetLocator(locator);
+      clusters->SetRadius(0.025);
+      clusters->SetExtractionModeToAllClusters();
+      clusters->ColorClustersOn();
+      clusters->Update();
+      return clusters->GetOutput()->GetPointData()->GetArray("ClusterId");
+    }
+  }
+}
+}
+
+int TestPointNeighborGraph(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetRangeValue(0.0, 1.0);
+    }
+    points->SetPoint(i, x);
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(cloud);
+  locator->BuildLocator();
+
+  // The exact graph of the closest points, also used for fewer points
+  const int N = 12;
+  locator->BuildClosestNPointsGraph(N);
+  auto closestN = [&](vtkIdType ptId, vtkIdList* list) {
+    locator->FindClosestNPoints(N, points->GetPoint(ptId), list);
+  };
+  if (!CheckGraph("Closest points graph", locator, -1, closestN))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkIdTypeArray* graphIds = locator->GetNeighborGraphIds();
+  vtkMTimeType graphTime = graphIds->GetMTime();
+  locator->BuildClosestNPointsGraph(N / 2);
+  if (locator->GetNeighborGraphIds()->GetMTime() != graphTime ||
+    !CheckGraph("Closest points graph", locator, N / 2, [&](vtkIdType ptId, vtkIdList* list) {
+      locator->FindClosestNPoints(N / 2, points->GetPoint(ptId), list);
+    }))
+  {
+    std::cerr << "The graph of the closest points is not reused for fewer points" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The approximate graph of the closest points finds most of them
+  locator->ApproximateNeighborGraphOn();
+  locator->BuildClosestNPointsGraph(N);
+  if (!CheckGraph("Approximate closest points graph", locator, -1,
+        [&](vtkIdType ptId, vtkIdList* list) {
+          locator->FindApproximateClosestNPoints(N, points->GetPoint(ptId), list);
+        }))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkIdTypeArray* ids = locator->GetNeighborGraphIds();
+  vtkNew<vtkIdList> list;
+  vtkIdType numFound = 0;
+  for (vtkIdType ptId = 0; ptId < NumberOfPoints; ++ptId)
+  {
+    locator->FindClosestNPoints(N, points->GetPoint(ptId), list);
+    const vtkIdType* begin = ids->GetPointer(ptId * N);
+    for (vtkIdType i = 0; i < N; ++i)
+    {
+      numFound += std::find(begin, begin + N, list->GetId(i)) != begin + N;
+    }
+  }
+  if (numFound < 0.9 * N * NumberOfPoints)
+  {
+    std::cerr << "The approximate graph finds " << numFound << " of the "
+              << N * NumberOfPoints << " closest points" << std::endl;
+    return EXIT_FAILURE;
+  }
+  locator->ApproximateNeighborGraphOff();
+
+  // The graph of the points within a radius
+  locator->BuildPointsWithinRadiusGraph(0.03);
+  if (!CheckGraph("Radius graph", locator, -1, [&](vtkIdType ptId, vtkIdList* radiusList) {
+        locator->FindPointsWithinRadius(0.03, points->GetPoint(ptId), radiusList);
+      }))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The filters produce the same output with the neighbor graph
+  const char* names[4] = { "vtkPCANormalEstimation", "vtkPCACurvatureEstimation",
+    "vtkStatisticalOutlierRemoval", "vtkEuclideanClusterExtraction" };
+  vtkNew<vtkStaticPointLocator> queryLocator;
+  vtkNew<vtkStaticPointLocator> graphLocator;
+  graphLocator->UseNeighborGraphOn();
+  for (int filter = 0; filter < 4; ++filter)
+  {
+    vtkSmartPointer<vtkDataArray> result = RunFilter(cloud, queryLocator, filter);
+    vtkSmartPointer<vtkDataArray> graphResult = RunFilter(cloud, graphLocator, filter);
+    if (!SameArrays(names[filter], result, graphResult))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,8 @@
 #include "vtkPoints.h"
 #include "vtkStaticPointLocator.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkEuclideanClusterExtraction);
 vtkCxxSetObjectMacro(vtkEuclideanClusterExtraction, Locator, vtkAbstractPointLocator);
 
@@ -51,6 +53,8 @@ vtkEuclideanClusterExtraction::vtkEuclideanClusterExtraction()
 
   this->NeighborPointIds = vtkIdList::New();
   this->NeighborPointIds->Allocate(64);
+  this->GraphOffsets = nullptr;
+  this->GraphIds = nullptr;
 
   this->Seeds = vtkIdList::New();
   this->SpecifiedClusterIds = vtkIdList::New();
@@ -158,6 +162,17 @@ int vtkEuclideanClusterExtraction::RequestData(vtkInformation* vtkNotUsed(reques
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_CLUSTERS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_CLUSTER)
   { // visit all points assigning cluster number
+    // Since all the points are visited, take their neighbors from the
+    // neighbor graph of the locator if requested, instead of querying the
+    // locator for each point.
+    vtkStaticPointLocator* staticLocator = vtkStaticPointLocator::SafeDownCast(this->Locator);
+    if (staticLocator && staticLocator->GetUseNeighborGraph())
+    {
+      staticLocator->BuildPointsWithinRadiusGraph(this->Radius);
+      this->GraphOffsets = staticLocator->GetNeighborGraphOffsets()->GetPointer(0);
+      this->GraphIds = staticLocator->GetNeighborGraphIds()->GetPointer(0);
+    }
+
     for (ptId = 0; ptId < numPts; ptId++)
     {
       if (ptId && !(ptId % 10000))
@@ -216,6 +231,8 @@ int vtkEuclideanClusterExtraction::RequestData(vtkInformation* vtkNotUsed(reques
   }
 
   vtkDebugMacro(<< "Extracted " << this->ClusterNumber << " cluster(s)");
+  this->GraphOffsets = nullptr;
+  this->GraphIds = nullptr;
   this->Wave->Delete();
   this->Wave2->Delete();
   delete[] this->Visited;
@@ -345,8 +362,18 @@ void vtkEuclideanClusterExtraction::TraverseAndMark(vtkPoints* inPts)
       this->NewScalars->SetValue(this->PointMap[ptId], this->ClusterNumber);
       this->NumPointsInCluster++;
 
-      inPts->GetPoint(ptId, x);
-      this->Locator->FindPointsWithinRadius(this->Radius, x, this->NeighborPointIds);
+      if (this->GraphOffsets)
+      {
+        const vtkIdType offset = this->GraphOffsets[ptId];
+        this->NeighborPointIds->SetNumberOfIds(this->GraphOffsets[ptId + 1] - offset);
+        std::copy_n(this->GraphIds + offset, this->NeighborPointIds->GetNumberOfIds(),
+          this->NeighborPointIds->GetPointer(0));
+      }
+      else
+      {
+        inPts->GetPoint(ptId, x);
+        this->Locator->FindPointsWithinRadius(this->Radius, x, this->NeighborPointIds);
+      }
 
       numPts = this->NeighborPointIds->GetNumberOfIds();
       for (j = 0; j < numPts; ++j)
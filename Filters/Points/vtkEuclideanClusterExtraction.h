@@ -225,6 +225,8 @@ private:
   // used to support algorithm execution
   vtkFloatArray* NeighborScalars;
   vtkIdList* NeighborPointIds;
+  const vtkIdType* GraphOffsets; // neighbor graph of the locator, if used
+  const vtkIdType* GraphIds;
   char* Visited;
   vtkIdType* PointMap;
   vtkIdTypeArray* NewScalars;
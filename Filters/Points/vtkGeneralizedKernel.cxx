@@ -48,6 +48,20 @@ vtkIdType vtkGeneralizedKernel::ComputeBasis(double x[3], vtkIdList* pIds, vtkId
   return pIds->GetNumberOfIds();
 }
 
+//------------------------------------------------------------------------------
+void vtkGeneralizedKernel::BatchComputeBasis(
+  vtkPoints* queries, vtkIdType, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (this->KernelFootprint == vtkGeneralizedKernel::RADIUS)
+  {
+    this->Locator->BatchFindPointsWithinRadius(this->Radius, queries, offsets, ids);
+  }
+  else
+  {
+    this->Locator->BatchFindClosestNPoints(this->NumberOfPoints, queries, offsets, ids);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkGeneralizedKernel::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -89,6 +89,13 @@ public:
    */
   vtkIdType ComputeBasis(double x[3], vtkIdList* pIds, vtkIdType ptId = 0) override;
 
+  /**
+   * Batched form of ComputeBasis(), running the batched locator query of
+   * the kernel footprint, see vtkInterpolationKernel.
+   */
+  void BatchComputeBasis(
+    vtkPoints* queries, vtkIdType startId, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+
   /**
    * Given a point x, a list of basis points pIds, and a probability
    * weighting function prob, compute interpolation weights associated with
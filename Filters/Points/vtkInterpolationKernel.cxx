@@ -15,7 +15,10 @@
 #include "vtkInterpolationKernel.h"
 #include "vtkAbstractPointLocator.h"
 #include "vtkDataSet.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLocatorBatchQuery.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 
 //------------------------------------------------------------------------------
 vtkInterpolationKernel::vtkInterpolationKernel()
@@ -80,6 +83,20 @@ void vtkInterpolationKernel::Initialize(
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkInterpolationKernel::BatchComputeBasis(
+  vtkPoints* queries, vtkIdType startId, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  vtkLocatorBatchQuery::Execute(
+    queries->GetNumberOfPoints(),
+    [this, queries, startId](vtkIdType q, vtkIdList* pIds) {
+      double x[3];
+      queries->GetPoint(q, x);
+      this->ComputeBasis(x, pIds, startId + q);
+    },
+    offsets, ids);
+}
+
 //------------------------------------------------------------------------------
 void vtkInterpolationKernel::PrintSelf(ostream& os, vtkIndent indent)
 {
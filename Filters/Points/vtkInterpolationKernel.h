@@ -56,9 +56,11 @@
 
 class vtkAbstractPointLocator;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkDoubleArray;
 class vtkDataSet;
 class vtkPointData;
+class vtkPoints;
 
 class VTKFILTERSPOINTS_EXPORT vtkInterpolationKernel : public vtkObject
 {
@@ -105,6 +107,19 @@ public:
    */
   virtual vtkIdType ComputeBasis(double x[3], vtkIdList* pIds, vtkIdType ptId = 0) = 0;
 
+  /**
+   * Batched form of ComputeBasis(), computing the basis of each point of
+   * queries, the query point i having the id startId + i (the optional ptId
+   * of ComputeBasis()). The basis of the query point i is ids[offsets[i]] to
+   * ids[offsets[i + 1] - 1]: offsets holds one more value than there are
+   * query points, as in the batched queries of vtkAbstractPointLocator. The
+   * default implementation calls ComputeBasis() in parallel. Kernels whose
+   * footprint is a fixed radius or number of points override it to use the
+   * batched queries of the locator.
+   */
+  virtual void BatchComputeBasis(
+    vtkPoints* queries, vtkIdType startId, vtkIdTypeArray* offsets, vtkIdTypeArray* ids);
+
   /**
    * Given a point x, and a list of basis points pIds, compute interpolation
    * weights associated with these basis points.  Note that both the nearby
@@ -16,6 +16,8 @@
 
 #include "vtkAbstractPointLocator.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -27,6 +29,8 @@
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkPCACurvatureEstimation);
 vtkCxxSetObjectMacro(vtkPCACurvatureEstimation, Locator, vtkAbstractPointLocator);
 
@@ -42,16 +46,21 @@ struct GenerateCurvature
   vtkAbstractPointLocator* Locator;
   int SampleSize;
   float* Curvature;
+  const vtkIdType* GraphOffsets;
+  const vtkIdType* GraphIds;
 
   // Don't want to allocate working arrays on every thread invocation. Thread local
   // storage lots of new/delete.
   vtkSMPThreadLocalObject<vtkIdList> PIds;
 
-  GenerateCurvature(T* points, vtkAbstractPointLocator* loc, int sample, float* curve)
+  GenerateCurvature(T* points, vtkAbstractPointLocator* loc, int sample, float* curve,
+    const vtkIdType* graphOffsets, const vtkIdType* graphIds)
     : Points(points)
     , Locator(loc)
     , SampleSize(sample)
     , Curvature(curve)
+    , GraphOffsets(graphOffsets)
+    , GraphIds(graphIds)
   {
   }
 
@@ -87,8 +96,18 @@ struct GenerateCurvature
       x[1] = static_cast<double>(*px++);
       x[2] = static_cast<double>(*px++);
 
-      // Retrieve the local neighborhood
-      this->Locator->FindClosestNPoints(this->SampleSize, x, pIds);
+      // Retrieve the local neighborhood, from the neighbor graph if any
+      if (this->GraphOffsets)
+      {
+        const vtkIdType* graphIds = this->GraphIds + this->GraphOffsets[ptId];
+        pIds->SetNumberOfIds(std::min<vtkIdType>(
+          this->SampleSize, this->GraphOffsets[ptId + 1] - this->GraphOffsets[ptId]));
+        std::copy_n(graphIds, pIds->GetNumberOfIds(), pIds->GetPointer(0));
+      }
+      else
+      {
+        this->Locator->FindClosestNPoints(this->SampleSize, x, pIds);
+      }
       numPts = pIds->GetNumberOfIds();
 
       // First step: compute the mean position of the neighborhood.
@@ -144,10 +163,11 @@ struct GenerateCurvature
 
   void Reduce() {}
 
-  static void Execute(
-    vtkPCACurvatureEstimation* self, vtkIdType numPts, T* points, float* curvature)
+  static void Execute(vtkPCACurvatureEstimation* self, vtkIdType numPts, T* points,
+    float* curvature, const vtkIdType* graphOffsets, const vtkIdType* graphIds)
   {
-    GenerateCurvature gen(points, self->GetLocator(), self->GetSampleSize(), curvature);
+    GenerateCurvature gen(
+      points, self->GetLocator(), self->GetSampleSize(), curvature, graphOffsets, graphIds);
     vtkSMPTools::For(0, numPts, gen);
   }
 }; // GenerateCurvature
@@ -202,6 +222,18 @@ int vtkPCACurvatureEstimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->Locator->SetDataSet(input);
   this->Locator->BuildLocator();
 
+  // Take the neighborhoods from the neighbor graph of the locator if
+  // requested, instead of querying the locator for each point.
+  const vtkIdType* graphOffsets = nullptr;
+  const vtkIdType* graphIds = nullptr;
+  vtkStaticPointLocator* staticLocator = vtkStaticPointLocator::SafeDownCast(this->Locator);
+  if (staticLocator && staticLocator->GetUseNeighborGraph())
+  {
+    staticLocator->BuildClosestNPointsGraph(this->SampleSize);
+    graphOffsets = staticLocator->GetNeighborGraphOffsets()->GetPointer(0);
+    graphIds = staticLocator->GetNeighborGraphIds()->GetPointer(0);
+  }
+
   // Generate the point curvature.
   vtkFloatArray* curvature = vtkFloatArray::New();
   curvature->SetNumberOfComponents(3);
@@ -212,7 +244,8 @@ int vtkPCACurvatureEstimation::RequestData(vtkInformation* vtkNotUsed(request),
   void* inPtr = input->GetPoints()->GetVoidPointer(0);
   switch (input->GetPoints()->GetDataType())
   {
-    vtkTemplateMacro(GenerateCurvature<VTK_TT>::Execute(this, numPts, (VTK_TT*)inPtr, c));
+    vtkTemplateMacro(
+      GenerateCurvature<VTK_TT>::Execute(this, numPts, (VTK_TT*)inPtr, c, graphOffsets, graphIds));
   }
 
   // Now send the curvatures to the output and clean up
@@ -17,6 +17,7 @@
 #include "vtkAbstractPointLocator.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -28,6 +29,8 @@
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkPCANormalEstimation);
 vtkCxxSetObjectMacro(vtkPCANormalEstimation, Locator, vtkAbstractPointLocator);
 
@@ -46,19 +49,23 @@ struct GenerateNormals
   int Orient;
   double OPoint[3];
   bool Flip;
+  const vtkIdType* GraphOffsets;
+  const vtkIdType* GraphIds;
 
   // Don't want to allocate working arrays on every thread invocation. Thread local
   // storage lots of new/delete.
   vtkSMPThreadLocalObject<vtkIdList> PIds;
 
   GenerateNormals(T* points, vtkAbstractPointLocator* loc, int sample, float* normals, int orient,
-    double opoint[3], bool flip)
+    double opoint[3], bool flip, const vtkIdType* graphOffsets, const vtkIdType* graphIds)
     : Points(points)
     , Locator(loc)
     , SampleSize(sample)
     , Normals(normals)
     , Orient(orient)
     , Flip(flip)
+    , GraphOffsets(graphOffsets)
+    , GraphIds(graphIds)
   {
     this->OPoint[0] = opoint[0];
     this->OPoint[1] = opoint[1];
@@ -98,8 +105,18 @@ struct GenerateNormals
       x[1] = static_cast<double>(*px++);
       x[2] = static_cast<double>(*px++);
 
-      // Retrieve the local neighborhood
-      this->Locator->FindClosestNPoints(this->SampleSize, x, pIds);
+      // Retrieve the local neighborhood, from the neighbor graph if any
+      if (this->GraphOffsets)
+      {
+        const vtkIdType* graphIds = this->GraphIds + this->GraphOffsets[ptId];
+        pIds->SetNumberOfIds(std::min<vtkIdType>(
+          this->SampleSize, this->GraphOffsets[ptId + 1] - this->GraphOffsets[ptId]));
+        std::copy_n(graphIds, pIds->GetNumberOfIds(), pIds->GetPointer(0));
+      }
+      else
+      {
+        this->Locator->FindClosestNPoints(this->SampleSize, x, pIds);
+      }
       numPts = pIds->GetNumberOfIds();
 
       // First step: compute the mean position of the neighborhood.
@@ -174,10 +191,11 @@ struct GenerateNormals
   void Reduce() {}
 
   static void Execute(vtkPCANormalEstimation* self, vtkIdType numPts, T* points, float* normals,
-    int orient, double opoint[3], bool flip)
+    int orient, double opoint[3], bool flip, const vtkIdType* graphOffsets,
+    const vtkIdType* graphIds)
   {
-    GenerateNormals gen(
-      points, self->GetLocator(), self->GetSampleSize(), normals, orient, opoint, flip);
+    GenerateNormals gen(points, self->GetLocator(), self->GetSampleSize(), normals, orient, opoint,
+      flip, graphOffsets, graphIds);
     vtkSMPTools::For(0, numPts, gen);
   }
 }; // GenerateNormals
@@ -235,6 +253,18 @@ int vtkPCANormalEstimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->Locator->SetDataSet(input);
   this->Locator->BuildLocator();
 
+  // Take the neighborhoods from the neighbor graph of the locator if
+  // requested, instead of querying the locator for each point.
+  const vtkIdType* graphOffsets = nullptr;
+  const vtkIdType* graphIds = nullptr;
+  vtkStaticPointLocator* staticLocator = vtkStaticPointLocator::SafeDownCast(this->Locator);
+  if (staticLocator && staticLocator->GetUseNeighborGraph())
+  {
+    staticLocator->BuildClosestNPointsGraph(this->SampleSize);
+    graphOffsets = staticLocator->GetNeighborGraphOffsets()->GetPointer(0);
+    graphIds = staticLocator->GetNeighborGraphIds()->GetPointer(0);
+  }
+
   // Generate the point normals.
   vtkFloatArray* normals = vtkFloatArray::New();
   normals->SetNumberOfComponents(3);
@@ -246,7 +276,7 @@ int vtkPCANormalEstimation::RequestData(vtkInformation* vtkNotUsed(request),
   switch (input->GetPoints()->GetDataType())
   {
     vtkTemplateMacro(GenerateNormals<VTK_TT>::Execute(this, numPts, (VTK_TT*)inPtr, n,
-      this->NormalOrientation, this->OrientationPoint, this->FlipNormals));
+      this->NormalOrientation, this->OrientationPoint, this->FlipNormals, graphOffsets, graphIds));
   }
 
   // Orient the normals in a consistent fashion (if requested). This requires a traversal
@@ -299,14 +329,32 @@ void vtkPCANormalEstimation::TraverseAndFlip(
   float *n, *n2;
   vtkIdList* neighborPointIds = vtkIdList::New();
 
+  // The neighbor graph of the locator, if any, was built with the normals
+  vtkStaticPointLocator* staticLocator = vtkStaticPointLocator::SafeDownCast(this->Locator);
+  const bool useGraph = staticLocator && staticLocator->GetUseNeighborGraph();
+  const vtkIdType* graphOffsets =
+    useGraph ? staticLocator->GetNeighborGraphOffsets()->GetPointer(0) : nullptr;
+  const vtkIdType* graphIds =
+    useGraph ? staticLocator->GetNeighborGraphIds()->GetPointer(0) : nullptr;
+
   while ((numIds = wave->GetNumberOfIds()) > 0)
   {
     for (i = 0; i < numIds; i++) // for all points in this wave
     {
       ptId = wave->GetId(i);
-      inPts->GetPoint(ptId, x);
       n = normals + 3 * ptId;
-      this->Locator->FindClosestNPoints(this->SampleSize, x, neighborPointIds);
+      if (useGraph)
+      {
+        neighborPointIds->SetNumberOfIds(
+          std::min<vtkIdType>(this->SampleSize, graphOffsets[ptId + 1] - graphOffsets[ptId]));
+        std::copy_n(graphIds + graphOffsets[ptId], neighborPointIds->GetNumberOfIds(),
+          neighborPointIds->GetPointer(0));
+      }
+      else
+      {
+        inPts->GetPoint(ptId, x);
+        this->Locator->FindClosestNPoints(this->SampleSize, x, neighborPointIds);
+      }
 
       numPts = neighborPointIds->GetNumberOfIds();
       for (j = 0; j < numPts; ++j)
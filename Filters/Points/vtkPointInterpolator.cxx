@@ -23,11 +23,13 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLinearKernel.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -36,6 +38,7 @@
 #include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -43,6 +46,9 @@ vtkStandardNewMacro(vtkPointInterpolator);
 vtkCxxSetObjectMacro(vtkPointInterpolator, Locator, vtkAbstractPointLocator);
 vtkCxxSetObjectMacro(vtkPointInterpolator, Kernel, vtkInterpolationKernel);
 
+// The number of points whose basis is computed by one batched query
+#define VTK_INTERPOLATION_BATCH_SIZE 16384
+
 //------------------------------------------------------------------------------
 // Helper classes to support efficient computing, and threaded execution.
 namespace
@@ -61,6 +67,13 @@ struct ProbePoints
   int Strategy;
   bool Promote;
 
+  // The batch of points to interpolate and their basis, computed by the
+  // kernel
+  vtkIdType StartId;
+  vtkPoints* Queries;
+  const vtkIdType* Offsets;
+  const vtkIdType* Ids;
+
   // Don't want to allocate these working arrays on every thread invocation,
   // so make them thread local.
   vtkSMPThreadLocalObject<vtkIdList> PIds;
@@ -127,20 +140,32 @@ struct ProbePoints
     }
   }
 
-  // Threaded interpolation method
-  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  // Set the batch of points to interpolate, and their basis
+  void SetBatch(vtkIdType startId, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+  {
+    this->StartId = startId;
+    this->Queries = queries;
+    this->Offsets = offsets->GetPointer(0);
+    this->Ids = ids->GetPointer(0);
+  }
+
+  // Threaded interpolation method, over the points of a batch
+  void operator()(vtkIdType q, vtkIdType endQ)
   {
     double x[3];
     vtkIdList*& pIds = this->PIds.Local();
-    vtkIdType numWeights;
+    vtkIdType numIds, numWeights;
     vtkDoubleArray*& weights = this->Weights.Local();
 
-    for (; ptId < endPtId; ++ptId)
+    for (; q < endQ; ++q)
     {
-      this->Input->GetPoint(ptId, x);
+      const vtkIdType ptId = this->StartId + q;
+      this->Queries->GetPoint(q, x);
 
-      if (this->Kernel->ComputeBasis(x, pIds) > 0)
+      if ((numIds = this->Offsets[q + 1] - this->Offsets[q]) > 0)
       {
+        pIds->SetNumberOfIds(numIds);
+        std::copy_n(this->Ids + this->Offsets[q], numIds, pIds->GetPointer(0));
         numWeights = this->Kernel->ComputeWeights(x, pIds, weights);
         this->Arrays.Interpolate(numWeights, pIds->GetPointer(0), weights->GetPointer(0), ptId);
       }
@@ -148,74 +173,58 @@ struct ProbePoints
       {
         this->AssignNullPoint(x, pIds, weights, ptId);
       } // null point
-    }   // for all dataset points
+    }   // for all points of the batch
   }
 
   void Reduce() {}
 
 }; // ProbePoints
 
-// Probe points using an image. Uses a more efficient iteration scheme.
-struct ImageProbePoints : public ProbePoints
+// Gather the coordinates of a batch of points of the input
+struct GetBatchPoints
 {
-  int Dims[3];
-  double Origin[3];
-  double Spacing[3];
+  vtkDataSet* Input;
+  vtkIdType StartId;
+  vtkPoints* Queries;
 
-  ImageProbePoints(vtkPointInterpolator* ptInt, vtkImageData* image, int dims[3], double origin[3],
-    double spacing[3], vtkPointData* inPD, vtkPointData* outPD, char* valid)
-    : ProbePoints(ptInt, image, inPD, outPD, valid)
+  void operator()(vtkIdType q, vtkIdType endQ)
   {
-    for (int i = 0; i < 3; ++i)
+    double x[3];
+    for (; q < endQ; ++q)
     {
-      this->Dims[i] = dims[i];
-      this->Origin[i] = origin[i];
-      this->Spacing[i] = spacing[i];
+      this->Input->GetPoint(this->StartId + q, x);
+      this->Queries->SetPoint(q, x);
     }
   }
+};
+
+// Compute the coordinates of a batch of points of an image, which is faster
+// than getting them from the image.
+struct GetBatchImagePoints
+{
+  int Dims[3];
+  double Origin[3];
+  double Spacing[3];
+  vtkIdType StartId;
+  vtkPoints* Queries;
 
-  // Threaded interpolation method specialized to image traversal
-  void operator()(vtkIdType slice, vtkIdType sliceEnd)
+  void operator()(vtkIdType q, vtkIdType endQ)
   {
     double x[3];
-    vtkIdType numWeights;
-    double* origin = this->Origin;
-    double* spacing = this->Spacing;
-    int* dims = this->Dims;
-    vtkIdType ptId, jOffset, kOffset, sliceSize = dims[0] * dims[1];
-    vtkIdList*& pIds = this->PIds.Local();
-    vtkDoubleArray*& weights = this->Weights.Local();
-
-    for (; slice < sliceEnd; ++slice)
+    const vtkIdType sliceSize = static_cast<vtkIdType>(this->Dims[0]) * this->Dims[1];
+    for (; q < endQ; ++q)
     {
-      x[2] = origin[2] + slice * spacing[2];
-      kOffset = slice * sliceSize;
-
-      for (int j = 0; j < dims[1]; ++j)
-      {
-        x[1] = origin[1] + j * spacing[1];
-        jOffset = j * dims[0];
-
-        for (int i = 0; i < dims[0]; ++i)
-        {
-          x[0] = origin[0] + i * spacing[0];
-          ptId = i + jOffset + kOffset;
-
-          if (this->Kernel->ComputeBasis(x, pIds) > 0)
-          {
-            numWeights = this->Kernel->ComputeWeights(x, pIds, weights);
-            this->Arrays.Interpolate(numWeights, pIds->GetPointer(0), weights->GetPointer(0), ptId);
-          }
-          else
-          {
-            this->AssignNullPoint(x, pIds, weights, ptId);
-          } // null point
-
-        } // over i
-      }   // over j
-    }     // over slices
+      const vtkIdType ptId = this->StartId + q;
+      const vtkIdType slice = ptId / sliceSize;
+      const vtkIdType j = (ptId - slice * sliceSize) / this->Dims[0];
+      const vtkIdType i = ptId - slice * sliceSize - j * this->Dims[0];
+      x[0] = this->Origin[0] + i * this->Spacing[0];
+      x[1] = this->Origin[1] + j * this->Spacing[1];
+      x[2] = this->Origin[2] + slice * this->Spacing[2];
+      this->Queries->SetPoint(q, x);
+    }
   }
-}; // ImageProbePoints
+};
 
 } // anonymous namespace
 
@@ -328,20 +337,44 @@ void vtkPointInterpolator::Probe(vtkDataSet* input, vtkDataSet* source, vtkDataS
     this->Kernel->Initialize(this->Locator, source, inPD);
   }
 
-  // If the input is image data then there is a faster path
+  // The points are interpolated by batches: the basis of the points of a
+  // batch is computed by a batched query of the kernel, then the points are
+  // interpolated. If the input is image data then there is a faster path to
+  // the point coordinates.
+  GetBatchPoints getPoints = { input, 0, nullptr };
+  GetBatchImagePoints getImagePoints;
   vtkImageData* imgInput = vtkImageData::SafeDownCast(input);
   if (imgInput)
   {
-    int dims[3];
-    double origin[3], spacing[3];
-    this->ExtractImageDescription(imgInput, dims, origin, spacing);
-    ImageProbePoints imageProbe(this, imgInput, dims, origin, spacing, inPD, outPD, mask);
-    vtkSMPTools::For(0, dims[2], imageProbe); // over slices
+    this->ExtractImageDescription(
+      imgInput, getImagePoints.Dims, getImagePoints.Origin, getImagePoints.Spacing);
   }
-  else
+
+  ProbePoints probe(this, input, inPD, outPD, mask);
+  vtkNew<vtkPoints> queries;
+  queries->SetDataTypeToDouble();
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  for (vtkIdType startId = 0; startId < numPts; startId += VTK_INTERPOLATION_BATCH_SIZE)
   {
-    ProbePoints probe(this, input, inPD, outPD, mask);
-    vtkSMPTools::For(0, numPts, probe);
+    const vtkIdType batchSize = std::min<vtkIdType>(VTK_INTERPOLATION_BATCH_SIZE, numPts - startId);
+    queries->SetNumberOfPoints(batchSize);
+    if (imgInput)
+    {
+      getImagePoints.StartId = startId;
+      getImagePoints.Queries = queries;
+      vtkSMPTools::For(0, batchSize, getImagePoints);
+    }
+    else
+    {
+      getPoints.StartId = startId;
+      getPoints.Queries = queries;
+      vtkSMPTools::For(0, batchSize, getPoints);
+    }
+
+    this->Kernel->BatchComputeBasis(queries, startId, offsets, ids);
+    probe.SetBatch(startId, queries, offsets, ids);
+    vtkSMPTools::For(0, batchSize, probe);
   }
 
   // Clean up
@@ -23,10 +23,12 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -38,12 +40,16 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkVoronoiKernel.h"
 
+#include <algorithm>
 #include <cassert>
 
 vtkStandardNewMacro(vtkSPHInterpolator);
 vtkCxxSetObjectMacro(vtkSPHInterpolator, Locator, vtkAbstractPointLocator);
 vtkCxxSetObjectMacro(vtkSPHInterpolator, Kernel, vtkSPHKernel);
 
+// The number of points whose basis is computed by one batched query
+#define VTK_INTERPOLATION_BATCH_SIZE 16384
+
 //------------------------------------------------------------------------------
 // Helper classes to support efficient computing, and threaded execution.
 namespace
@@ -65,6 +71,13 @@ struct ProbePoints
   float* Shepard;
   vtkTypeBool Promote;
 
+  // The batch of points to interpolate and their basis, computed by the
+  // kernel
+  vtkIdType StartId;
+  vtkPoints* Queries;
+  const vtkIdType* Offsets;
+  const vtkIdType* Ids;
+
   // Don't want to allocate these working arrays on every thread invocation,
   // so make them thread local.
   vtkSMPThreadLocalObject<vtkIdList> PIds;
@@ -131,8 +144,17 @@ struct ProbePoints
     gradWeights->Allocate(128);
   }
 
-  // Threaded interpolation method
-  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  // Set the batch of points to interpolate, and their basis
+  void SetBatch(vtkIdType startId, vtkPoints* queries, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+  {
+    this->StartId = startId;
+    this->Queries = queries;
+    this->Offsets = offsets->GetPointer(0);
+    this->Ids = ids->GetPointer(0);
+  }
+
+  // Threaded interpolation method, over the points of a batch
+  void operator()(vtkIdType q, vtkIdType endQ)
   {
     double x[3];
     vtkIdList*& pIds = this->PIds.Local();
@@ -140,12 +162,15 @@ struct ProbePoints
     vtkDoubleArray*& weights = this->Weights.Local();
     vtkDoubleArray*& gradWeights = this->DerivWeights.Local();
 
-    for (; ptId < endPtId; ++ptId)
+    for (; q < endQ; ++q)
     {
-      this->Input->GetPoint(ptId, x);
+      const vtkIdType ptId = this->StartId + q;
+      this->Queries->GetPoint(q, x);
 
-      if ((numWeights = this->Kernel->ComputeBasis(x, pIds, ptId)) > 0)
+      if ((numWeights = this->Offsets[q + 1] - this->Offsets[q]) > 0)
       {
+        pIds->SetNumberOfIds(numWeights);
+        std::copy_n(this->Ids + this->Offsets[q], numWeights, pIds->GetPointer(0));
         if (!this->ComputeDerivArrays)
         {
           this->Kernel->ComputeWeights(x, pIds, weights);
@@ -177,13 +202,31 @@ struct ProbePoints
         }
         this->Shepard[ptId] = sum;
       }
-    } // for all dataset points
+    } // for all points of the batch
   }
 
   void Reduce() {}
 
 }; // ProbePoints
 
+// Gather the coordinates of a batch of points of the input
+struct GetBatchPoints
+{
+  vtkDataSet* Input;
+  vtkIdType StartId;
+  vtkPoints* Queries;
+
+  void operator()(vtkIdType q, vtkIdType endQ)
+  {
+    double x[3];
+    for (; q < endQ; ++q)
+    {
+      this->Input->GetPoint(this->StartId + q, x);
+      this->Queries->SetPoint(q, x);
+    }
+  }
+};
+
 // Used when normalizing arrays by the Shepard coefficient
 template <typename T>
 struct NormalizeArray
@@ -366,9 +409,26 @@ void vtkSPHInterpolator::Probe(vtkDataSet* input, vtkDataSet* source, vtkDataSet
     this->Kernel->Initialize(this->Locator, source, sourcePD);
   }
 
-  // Now loop over input points, finding closest points and invoking kernel.
+  // Now loop over input points by batches, finding the closest points of a
+  // batch with a batched query of the kernel, then invoking the kernel.
   ProbePoints probe(this, input, sourcePD, outPD, mask, shepardArray);
-  vtkSMPTools::For(0, numPts, probe);
+  GetBatchPoints getPoints = { input, 0, nullptr };
+  vtkNew<vtkPoints> queries;
+  queries->SetDataTypeToDouble();
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  for (vtkIdType startId = 0; startId < numPts; startId += VTK_INTERPOLATION_BATCH_SIZE)
+  {
+    const vtkIdType batchSize = std::min<vtkIdType>(VTK_INTERPOLATION_BATCH_SIZE, numPts - startId);
+    queries->SetNumberOfPoints(batchSize);
+    getPoints.StartId = startId;
+    getPoints.Queries = queries;
+    vtkSMPTools::For(0, batchSize, getPoints);
+
+    this->Kernel->BatchComputeBasis(queries, startId, offsets, ids);
+    probe.SetBatch(startId, queries, offsets, ids);
+    vtkSMPTools::For(0, batchSize, probe);
+  }
 
   // If Shepard normalization requested, normalize all arrays except density
   // array.
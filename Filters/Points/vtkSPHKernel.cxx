@@ -99,6 +99,20 @@ vtkIdType vtkSPHKernel::ComputeBasis(double x[3], vtkIdList* pIds, vtkIdType ptI
   return pIds->GetNumberOfIds();
 }
 
+//------------------------------------------------------------------------------
+void vtkSPHKernel::BatchComputeBasis(
+  vtkPoints* queries, vtkIdType startId, vtkIdTypeArray* offsets, vtkIdTypeArray* ids)
+{
+  if (this->UseCutoffArray)
+  {
+    this->Superclass::BatchComputeBasis(queries, startId, offsets, ids);
+  }
+  else
+  {
+    this->Locator->BatchFindPointsWithinRadius(this->Cutoff, queries, offsets, ids);
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkIdType vtkSPHKernel::ComputeWeights(double x[3], vtkIdList* pIds, vtkDoubleArray* weights)
 {
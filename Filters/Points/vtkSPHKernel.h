@@ -145,6 +145,14 @@ public:
    */
   vtkIdType ComputeBasis(double x[3], vtkIdList* pIds, vtkIdType ptId = 0) override;
 
+  /**
+   * Batched form of ComputeBasis(), running the batched radius query of the
+   * locator unless the cutoff varies with the point, see
+   * vtkInterpolationKernel.
+   */
+  void BatchComputeBasis(
+    vtkPoints* queries, vtkIdType startId, vtkIdTypeArray* offsets, vtkIdTypeArray* ids) override;
+
   /**
    * Given a point x, and a list of basis points pIds, compute interpolation
    * weights associated with these basis points.
@@ -16,6 +16,7 @@
 
 #include "vtkAbstractPointLocator.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
@@ -24,6 +25,8 @@
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkStatisticalOutlierRemoval);
 vtkCxxSetObjectMacro(vtkStatisticalOutlierRemoval, Locator, vtkAbstractPointLocator);
 
@@ -42,6 +45,8 @@ struct ComputeMeanDistance
   int SampleSize;
   float* Distance;
   double Mean;
+  const vtkIdType* GraphOffsets;
+  const vtkIdType* GraphIds;
 
   // Don't want to allocate working arrays on every thread invocation. Thread local
   // storage lots of new/delete.
@@ -49,12 +54,15 @@ struct ComputeMeanDistance
   vtkSMPThreadLocal<double> ThreadMean;
   vtkSMPThreadLocal<vtkIdType> ThreadCount;
 
-  ComputeMeanDistance(T* points, vtkAbstractPointLocator* loc, int size, float* d)
+  ComputeMeanDistance(T* points, vtkAbstractPointLocator* loc, int size, float* d,
+    const vtkIdType* graphOffsets, const vtkIdType* graphIds)
     : Points(points)
     , Locator(loc)
     , SampleSize(size)
     , Distance(d)
     , Mean(0.0)
+    , GraphOffsets(graphOffsets)
+    , GraphIds(graphIds)
   {
   }
 
@@ -89,8 +97,19 @@ struct ComputeMeanDistance
       x[2] = static_cast<double>(*px++);
 
       // The method FindClosestNPoints will include the current point, so
-      // we increase the sample size by one.
-      this->Locator->FindClosestNPoints(this->SampleSize + 1, x, pIds);
+      // we increase the sample size by one. The neighbor graph, if any,
+      // includes it as well.
+      if (this->GraphOffsets)
+      {
+        const vtkIdType* graphIds = this->GraphIds + this->GraphOffsets[ptId];
+        pIds->SetNumberOfIds(std::min<vtkIdType>(
+          this->SampleSize + 1, this->GraphOffsets[ptId + 1] - this->GraphOffsets[ptId]));
+        std::copy_n(graphIds, pIds->GetNumberOfIds(), pIds->GetPointer(0));
+      }
+      else
+      {
+        this->Locator->FindClosestNPoints(this->SampleSize + 1, x, pIds);
+      }
       vtkIdType numPts = pIds->GetNumberOfIds();
 
       double sum = 0.0;
@@ -146,10 +165,11 @@ struct ComputeMeanDistance
     this->Mean = mean / static_cast<double>(count);
   }
 
-  static void Execute(
-    vtkStatisticalOutlierRemoval* self, vtkIdType numPts, T* points, float* distances, double& mean)
+  static void Execute(vtkStatisticalOutlierRemoval* self, vtkIdType numPts, T* points,
+    float* distances, double& mean, const vtkIdType* graphOffsets, const vtkIdType* graphIds)
   {
-    ComputeMeanDistance compute(points, self->GetLocator(), self->GetSampleSize(), distances);
+    ComputeMeanDistance compute(
+      points, self->GetLocator(), self->GetSampleSize(), distances, graphOffsets, graphIds);
     vtkSMPTools::For(0, numPts, compute);
     mean = compute.Mean;
   }
@@ -307,6 +327,18 @@ int vtkStatisticalOutlierRemoval::FilterPoints(vtkPointSet* input)
   this->Locator->SetDataSet(input);
   this->Locator->BuildLocator();
 
+  // Take the neighbors from the neighbor graph of the locator if requested,
+  // instead of querying the locator for each point.
+  const vtkIdType* graphOffsets = nullptr;
+  const vtkIdType* graphIds = nullptr;
+  vtkStaticPointLocator* staticLocator = vtkStaticPointLocator::SafeDownCast(this->Locator);
+  if (staticLocator && staticLocator->GetUseNeighborGraph())
+  {
+    staticLocator->BuildClosestNPointsGraph(this->SampleSize + 1);
+    graphOffsets = staticLocator->GetNeighborGraphOffsets()->GetPointer(0);
+    graphIds = staticLocator->GetNeighborGraphIds()->GetPointer(0);
+  }
+
   // Compute statistics across the point cloud. Start my computing
   // mean distance to N closest neighbors.
   vtkIdType numPts = input->GetNumberOfPoints();
@@ -315,8 +347,8 @@ int vtkStatisticalOutlierRemoval::FilterPoints(vtkPointSet* input)
   double mean = 0.0, sigma = 0.0;
   switch (input->GetPoints()->GetDataType())
   {
-    vtkTemplateMacro(
-      ComputeMeanDistance<VTK_TT>::Execute(this, numPts, (VTK_TT*)inPtr, dist, mean));
+    vtkTemplateMacro(ComputeMeanDistance<VTK_TT>::Execute(
+      this, numPts, (VTK_TT*)inPtr, dist, mean, graphOffsets, graphIds));
   }
 
   // At this point the mean distance for each point, and across the point
@@ -19,6 +19,7 @@
 #include "vtkImageData.h"
 #include "vtkLogger.h"
 #include "vtkMathUtilities.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkNew.h"
 #include "vtkPointData.h"
 #include "vtkTesting.h"
@@ -183,18 +184,20 @@ int TestDataSet(vtkDataSet* data, vtkDataSet* expectedData)
   return EXIT_SUCCESS;
 }
 
-int TestImageData(const std::string& dataRoot)
+int TestImageData(const std::string& dataRoot, bool memoryMapping)
 {
   // ImageData file
   // ------------------------------------------------------------
   std::string fileName = dataRoot + "/Data/mandelbrot-vti.hdf";
-  std::cout << "Testing: " << fileName << std::endl;
+  std::cout << "Testing: " << fileName << (memoryMapping ? " with memory mapping" : "")
+            << std::endl;
   vtkNew<vtkHDFReader> reader;
   if (!reader->CanReadFile(fileName.c_str()))
   {
     return EXIT_FAILURE;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapping(memoryMapping);
   reader->Update();
   vtkImageData* data = vtkImageData::SafeDownCast(reader->GetOutput());
   vtkSmartPointer<vtkImageData> expectedData = ReadImageData(dataRoot + "/Data/mandelbrot.vti");
@@ -211,11 +214,27 @@ int TestImageData(const std::string& dataRoot)
     return EXIT_FAILURE;
   }
 
+  // The point data of the image is stored contiguously in the native format.
+  if (memoryMapping && vtkMemoryMappedFile::IsSupported())
+  {
+    vtkPointData* pointData = data->GetPointData();
+    bool mapped = false;
+    for (int i = 0; i < pointData->GetNumberOfArrays(); ++i)
+    {
+      mapped |= vtkMemoryMappedFile::IsMapped(pointData->GetArray(i));
+    }
+    if (!mapped)
+    {
+      std::cerr << "Error: no point data array was mapped." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return TestDataSet(data, expectedData);
 }
 
 template <bool parallel>
-int TestUnstructuredGrid(const std::string& dataRoot)
+int TestUnstructuredGrid(const std::string& dataRoot, bool memoryMapping)
 {
   std::string fileName, expectedName;
   vtkNew<vtkHDFReader> reader;
@@ -234,12 +253,14 @@ int TestUnstructuredGrid(const std::string& dataRoot)
     expectedName = dataRoot + "/Data/can.vtu";
     oreader = expectedReader;
   }
-  std::cout << "Testing: " << fileName << std::endl;
+  std::cout << "Testing: " << fileName << (memoryMapping ? " with memory mapping" : "")
+            << std::endl;
   if (!reader->CanReadFile(fileName.c_str()))
   {
     return EXIT_FAILURE;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetMemoryMapping(memoryMapping);
   reader->Update();
   vtkUnstructuredGrid* data = vtkUnstructuredGrid::SafeDownCast(reader->GetOutputAsDataSet());
 
@@ -261,18 +282,21 @@ int TestHDFReader(int argc, char* argv[])
   }
 
   std::string dataRoot = testHelper->GetDataRoot();
-  if (TestImageData(dataRoot))
+  for (bool memoryMapping : { false, true })
   {
-    return EXIT_FAILURE;
-  }
+    if (TestImageData(dataRoot, memoryMapping))
+    {
+      return EXIT_FAILURE;
+    }
 
-  if (TestUnstructuredGrid<false /*parallel*/>(dataRoot))
-  {
-    return EXIT_FAILURE;
-  }
-  if (TestUnstructuredGrid<true /*parallel*/>(dataRoot))
-  {
-    return EXIT_FAILURE;
+    if (TestUnstructuredGrid<false /*parallel*/>(dataRoot, memoryMapping))
+    {
+      return EXIT_FAILURE;
+    }
+    if (TestUnstructuredGrid<true /*parallel*/>(dataRoot, memoryMapping))
+    {
+      return EXIT_FAILURE;
+    }
   }
   return EXIT_SUCCESS;
 }
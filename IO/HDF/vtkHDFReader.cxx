@@ -83,6 +83,7 @@ std::vector<hsize_t> ReduceDimension(int* updateExtent, int* wholeExtent)
 vtkHDFReader::vtkHDFReader()
 {
   this->FileName = nullptr;
+  this->MemoryMapping = false;
   // Setup the selection callback to modify this object when an array
   // selection is changed.
   this->SelectionObserver = vtkCallbackCommand::New();
@@ -124,6 +125,7 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
      << "\n";
   os << indent << "PointDataArraySelection: " << this->DataArraySelection[vtkDataObject::POINT]
      << "\n";
+  os << indent << "MemoryMapping: " << this->MemoryMapping << "\n";
 }
 
 //----------------------------------------------------------------------------
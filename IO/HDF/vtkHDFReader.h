@@ -103,6 +103,19 @@ public:
   const char* GetCellArrayName(int index);
   //@}
 
+  //@{
+  /**
+   * When on, contiguous, uncompressed datasets stored in the native byte
+   * order are mapped in memory instead of being read: the arrays use the file
+   * pages, which are loaded on first access, and writes to them are private
+   * to the process (see vtkMemoryMappedFile). Other datasets are read as
+   * usual. Default is off.
+   */
+  vtkSetMacro(MemoryMapping, bool);
+  vtkGetMacro(MemoryMapping, bool);
+  vtkBooleanMacro(MemoryMapping, bool);
+  //@}
+
 protected:
   vtkHDFReader();
   ~vtkHDFReader() override;
@@ -185,6 +198,12 @@ protected:
    * modified.
    */
   vtkCallbackCommand* SelectionObserver;
+
+  /**
+   * Map contiguous datasets instead of reading them.
+   */
+  bool MemoryMapping;
+
   //@{
   /**
    * Image data topology and geometry.
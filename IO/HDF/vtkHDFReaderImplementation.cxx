@@ -30,8 +30,10 @@
 #include "vtkLogger.h"
 #include "vtkLongArray.h"
 #include "vtkLongLongArray.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkShortArray.h"
 #include "vtkStringArray.h"
+#include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedLongArray.h"
@@ -793,6 +795,13 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
     size_t j = i << 1;
     numberOfTuples *= (fileExtent[j + 1] - fileExtent[j] + 1);
   }
+  if (this->Reader->GetMemoryMapping())
+  {
+    if (vtkDataArray* mapped = this->NewMappedArray<T>(dataset, fileExtent, numberOfComponents))
+    {
+      return mapped;
+    }
+  }
   auto array = vtkAOSDataArrayTemplate<T>::SafeDownCast(NewVtkDataArray<T>());
   array->SetNumberOfComponents(numberOfComponents);
   array->SetNumberOfTuples(numberOfTuples);
@@ -805,6 +814,77 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
   return array;
 }
 
+//------------------------------------------------------------------------------
+template <typename T>
+vtkDataArray* vtkHDFReader::Implementation::NewMappedArray(
+  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents)
+{
+  // The dataset must be stored in one block of the file, in the native format.
+  hid_t plist = H5Dget_create_plist(dataset);
+  if (plist < 0)
+  {
+    return nullptr;
+  }
+  const bool contiguous =
+    H5Pget_layout(plist) == H5D_CONTIGUOUS && H5Pget_external_count(plist) == 0;
+  H5Pclose(plist);
+  const haddr_t address = H5Dget_offset(dataset);
+  if (!contiguous || address == HADDR_UNDEF)
+  {
+    return nullptr;
+  }
+  hid_t fileType = H5Dget_type(dataset);
+  const bool nativeType = H5Tequal(fileType, TemplateTypeToHdfNativeType<T>()) > 0;
+  H5Tclose(fileType);
+  if (!nativeType)
+  {
+    return nullptr;
+  }
+
+  // The slab must be contiguous: only the slowest axis may be partial.
+  hid_t filespace = H5Dget_space(dataset);
+  if (filespace < 0)
+  {
+    return nullptr;
+  }
+  std::vector<hsize_t> dims(H5Sget_simple_extent_ndims(filespace));
+  H5Sget_simple_extent_dims(filespace, dims.data(), nullptr);
+  H5Sclose(filespace);
+  std::vector<hsize_t> count(fileExtent.size() >> 1), start(fileExtent.size() >> 1);
+  for (size_t i = 0; i < count.size(); ++i)
+  {
+    size_t j = (count.size() - 1 - i) << 1;
+    count[i] = fileExtent[j + 1] - fileExtent[j] + 1;
+    start[i] = fileExtent[j];
+  }
+  if (numberOfComponents > 1)
+  {
+    count.push_back(numberOfComponents);
+    start.push_back(0);
+  }
+  if (count.empty() || count.size() != dims.size())
+  {
+    return nullptr;
+  }
+  hsize_t sliceSize = 1;
+  for (size_t i = 1; i < dims.size(); ++i)
+  {
+    if (start[i] != 0 || count[i] != dims[i])
+    {
+      return nullptr;
+    }
+    sliceSize *= dims[i];
+  }
+
+  const vtkIdType numberOfTuples =
+    static_cast<vtkIdType>(count[0] * sliceSize / numberOfComponents);
+  const vtkTypeUInt64 offset =
+    static_cast<vtkTypeUInt64>(address) + start[0] * sliceSize * sizeof(T);
+  return vtkMemoryMappedFile::MapArray(this->FileName.c_str(), offset,
+    vtkTypeTraits<T>::VTK_TYPE_ID, static_cast<int>(numberOfComponents), numberOfTuples,
+    vtkMemoryMappedFile::COPY_ON_WRITE);
+}
+
 //------------------------------------------------------------------------------
 template <typename T>
 bool vtkHDFReader::Implementation::NewArray(
@@ -169,6 +169,14 @@ protected:
   template <typename T>
   bool NewArray(
     hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents, T* data);
+  /**
+   * Map the fileExtent slab of a dataset in memory if the dataset is stored
+   * contiguously, uncompressed and in the native byte order, and if the slab
+   * is contiguous in the file. Returns nullptr otherwise.
+   */
+  template <typename T>
+  vtkDataArray* NewMappedArray(
+    hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents);
   vtkStringArray* NewStringArray(hid_t dataset, hsize_t size);
   //@}
   /**
@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReader2MemoryMapping.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the memory mapping of raw files by vtkMemoryMappedFile and
+// vtkImageReader2.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageReader2.h"
+#include "vtkMemoryMappedFile.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define TEST_ASSERT(cond, msg)                                                                     \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(cond))                                                                                   \
+    {                                                                                              \
+      std::cerr << "Line " << __LINE__ << ": " << msg << std::endl;                                \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+int TestImageReader2MemoryMapping(int argc, char* argv[])
+{
+  if (!vtkMemoryMappedFile::IsSupported())
+  {
+    std::cout << "Memory mapping is not supported on this platform.\n";
+    return EXIT_SUCCESS;
+  }
+
+  const char* tdir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tdir) + "/TestImageReader2MemoryMapping.raw";
+  delete[] tdir;
+
+  // A 7x5x3 volume of shorts after a 100 bytes header.
+  const int dims[3] = { 7, 5, 3 };
+  const int headerSize = 100;
+  const int numberOfValues = dims[0] * dims[1] * dims[2];
+  std::vector<short> values(numberOfValues);
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    values[i] = static_cast<short>(3 * i - 50);
+  }
+  {
+    std::ofstream file(fileName.c_str(), std::ios::binary);
+    const std::string header(headerSize, 'h');
+    file.write(header.data(), headerSize);
+    file.write(reinterpret_cast<const char*>(values.data()), numberOfValues * sizeof(short));
+  }
+
+  // Direct mapping.
+  vtkSmartPointer<vtkDataArray> mapped = vtk::TakeSmartPointer(vtkMemoryMappedFile::MapArray(
+    fileName.c_str(), headerSize, VTK_SHORT, 1, numberOfValues, vtkMemoryMappedFile::READ_ONLY));
+  TEST_ASSERT(mapped, "Mapping failed.");
+  TEST_ASSERT(vtkMemoryMappedFile::IsMapped(mapped), "IsMapped failed.");
+  TEST_ASSERT(mapped->GetDataType() == VTK_SHORT, "Wrong data type.");
+  TEST_ASSERT(mapped->GetNumberOfTuples() == numberOfValues, "Wrong number of tuples.");
+  TEST_ASSERT(mapped->GetComponent(numberOfValues - 1, 0) == values[numberOfValues - 1],
+    "Wrong mapped values.");
+
+  // The file is too small.
+  vtkObject::GlobalWarningDisplayOff();
+  vtkDataArray* tooLarge =
+    vtkMemoryMappedFile::MapArray(fileName.c_str(), headerSize, VTK_SHORT, 1, numberOfValues + 1);
+  vtkObject::GlobalWarningDisplayOn();
+  TEST_ASSERT(!tooLarge, "Mapping past the end of the file must fail.");
+
+  // Copy-on-write: writes are private to the array.
+  vtkSmartPointer<vtkDataArray> copyOnWrite =
+    vtk::TakeSmartPointer(vtkMemoryMappedFile::MapArray(fileName.c_str(), headerSize, VTK_SHORT, 1,
+      numberOfValues, vtkMemoryMappedFile::COPY_ON_WRITE));
+  TEST_ASSERT(copyOnWrite, "Copy-on-write mapping failed.");
+  copyOnWrite->SetComponent(0, 0, 1234);
+  TEST_ASSERT(copyOnWrite->GetComponent(0, 0) == 1234, "Write to a mapped array failed.");
+  TEST_ASSERT(mapped->GetComponent(0, 0) == values[0], "A private write modified the file.");
+
+  // Resizing copies the values to regular memory.
+  copyOnWrite->Resize(2 * numberOfValues);
+  TEST_ASSERT(!vtkMemoryMappedFile::IsMapped(copyOnWrite), "A resized array is still mapped.");
+  TEST_ASSERT(copyOnWrite->GetComponent(1, 0) == values[1], "Resize lost the values.");
+
+  // Reader.
+  vtkNew<vtkImageReader2> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetFileDimensionality(3);
+  reader->SetDataExtent(0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1);
+  reader->SetDataScalarTypeToShort();
+  reader->SetHeaderSize(headerSize);
+  reader->FileLowerLeftOn();
+  reader->MemoryMappingOn();
+  reader->Update();
+  vtkDataArray* scalars = reader->GetOutput()->GetPointData()->GetScalars();
+  TEST_ASSERT(scalars, "No scalars.");
+  TEST_ASSERT(vtkMemoryMappedFile::IsMapped(scalars), "The reader did not map the file.");
+  TEST_ASSERT(scalars->GetNumberOfTuples() == numberOfValues, "Wrong number of tuples.");
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    TEST_ASSERT(scalars->GetComponent(i, 0) == values[i], "Wrong value " << i << ".");
+  }
+
+  // A partial extent is read.
+  const int slice[6] = { 0, dims[0] - 1, 0, dims[1] - 1, 1, 1 };
+  reader->UpdateExtent(slice);
+  scalars = reader->GetOutput()->GetPointData()->GetScalars();
+  TEST_ASSERT(!vtkMemoryMappedFile::IsMapped(scalars), "A partial extent must be read.");
+  TEST_ASSERT(scalars->GetComponent(0, 0) == values[dims[0] * dims[1]], "Wrong value read.");
+
+  // Swapped bytes are read.
+  reader->SetSwapBytes(!reader->GetSwapBytes());
+  reader->UpdateWholeExtent();
+  scalars = reader->GetOutput()->GetPointData()->GetScalars();
+  TEST_ASSERT(!vtkMemoryMappedFile::IsMapped(scalars), "Swapped bytes must be read.");
+
+  return EXIT_SUCCESS;
+}
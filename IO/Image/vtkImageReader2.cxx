@@ -21,8 +21,10 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryMappedFile.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
@@ -71,6 +73,8 @@ vtkImageReader2::vtkImageReader2()
   this->FileNameSliceOffset = 0;
   this->FileNameSliceSpacing = 1;
 
+  this->MemoryMapping = false;
+
   // Left over from short reader
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
@@ -436,6 +440,7 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
   os << ")\n";
 
   os << indent << "HeaderSize: " << this->HeaderSize << "\n";
+  os << indent << "MemoryMapping: " << this->MemoryMapping << "\n";
 
   if (this->InternalFileName)
   {
@@ -750,6 +755,11 @@ void vtkImageReader2Update(vtkImageReader2* self, vtkImageData* data, OT* outPtr
 // are assumed to be the same as the file extent/order.
 void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject* output, vtkInformation* outInfo)
 {
+  if (this->MemoryMapping && this->MapOutputData(output, outInfo))
+  {
+    return;
+  }
+
   vtkImageData* data = this->AllocateOutputData(output, outInfo);
 
   void* ptr;
@@ -781,6 +791,54 @@ void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject* output, vtkInfor
   }
 }
 
+//------------------------------------------------------------------------------
+bool vtkImageReader2::MapOutputData(vtkDataObject* output, vtkInformation* outInfo)
+{
+  vtkImageData* data = vtkImageData::SafeDownCast(output);
+  int* outExtent = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT());
+  if (!data || !outExtent || !this->FileName || this->MemoryBuffer ||
+    this->GetFileDimensionality() != 3)
+  {
+    return false;
+  }
+
+  // The requested extent must be the whole file, rows in file order, bytes in
+  // native order.
+  const int dataTypeSize = vtkDataArray::GetDataTypeSize(this->DataScalarType);
+  if (!this->FileLowerLeft || (this->SwapBytes && dataTypeSize > 1))
+  {
+    return false;
+  }
+  for (int i = 0; i < 6; ++i)
+  {
+    if (outExtent[i] != this->DataExtent[i])
+    {
+      return false;
+    }
+  }
+
+  this->ComputeDataIncrements();
+  const vtkTypeUInt64 offset = this->GetHeaderSize(outExtent[4]);
+  this->ComputeInternalFileName(0);
+  const vtkIdType numberOfTuples =
+    static_cast<vtkIdType>(outExtent[1] - outExtent[0] + 1) * (outExtent[3] - outExtent[2] + 1) *
+    (outExtent[5] - outExtent[4] + 1);
+  vtkSmartPointer<vtkDataArray> scalars =
+    vtk::TakeSmartPointer(vtkMemoryMappedFile::MapArray(this->InternalFileName, offset,
+      this->DataScalarType, this->NumberOfScalarComponents, numberOfTuples,
+      vtkMemoryMappedFile::COPY_ON_WRITE));
+  if (!scalars)
+  {
+    return false;
+  }
+
+  vtkDebugMacro("Mapped " << this->InternalFileName << " at offset " << offset);
+  data->SetExtent(outExtent);
+  scalars->SetName("ImageFile");
+  data->GetPointData()->SetScalars(scalars);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkImageReader2::SetMemoryBuffer(const void* membuf)
 {
@@ -246,6 +246,19 @@ public:
   vtkBooleanMacro(SwapBytes, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * When on, a single raw file holding exactly the requested extent in the
+   * native byte order is mapped in memory instead of being read: the output
+   * scalars use the file pages, which are loaded on first access, and writes
+   * to them are private to the process (see vtkMemoryMappedFile). Files that
+   * cannot be mapped are read as usual. Default is off.
+   */
+  vtkSetMacro(MemoryMapping, bool);
+  vtkGetMacro(MemoryMapping, bool);
+  vtkBooleanMacro(MemoryMapping, bool);
+  ///@}
+
   istream* GetFile() { return this->File; }
   vtkGetVectorMacro(DataIncrements, unsigned long, 4);
 
@@ -329,12 +342,21 @@ protected:
   int FileNameSliceOffset;
   int FileNameSliceSpacing;
 
+  bool MemoryMapping;
+
   int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
   virtual void ExecuteInformation();
   void ExecuteDataWithInformation(vtkDataObject* data, vtkInformation* outInfo) override;
   virtual void ComputeDataIncrements();
 
+  /**
+   * Map the file into the output scalars if MemoryMapping is on and the
+   * requested extent is stored contiguously in the file. Return false if the
+   * data must be read instead.
+   */
+  virtual bool MapOutputData(vtkDataObject* output, vtkInformation* outInfo);
+
 private:
   vtkImageReader2(const vtkImageReader2&) = delete;
   void operator=(const vtkImageReader2&) = delete;
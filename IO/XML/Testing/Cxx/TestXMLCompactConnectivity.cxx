@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompactConnectivity.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write cells with 64-bit ids and read them back with the CompactConnectivity
+// option of the XML unstructured readers.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfCells = 100;
+
+//------------------------------------------------------------------------------
+void MakeCells(vtkPoints* points, vtkCellArray* cells)
+{
+  points->SetNumberOfPoints(NumberOfCells + 2);
+  for (vtkIdType i = 0; i < NumberOfCells + 2; ++i)
+  {
+    points->SetPoint(i, i, i % 2, 0.);
+  }
+  cells->Use64BitStorage();
+  for (vtkIdType i = 0; i < NumberOfCells; ++i)
+  {
+    const vtkIdType tri[3] = { i, i + 1, i + 2 };
+    cells->InsertNextCell(3, tri);
+  }
+}
+
+//------------------------------------------------------------------------------
+bool SameCells(const char* name, vtkCellArray* expected, vtkCellArray* actual, bool compact)
+{
+  if (!actual || actual->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << name << ": wrong number of cells." << std::endl;
+    return false;
+  }
+  if (compact && actual->GetNumberOfCells() > 0 && actual->IsStorage64Bit())
+  {
+    std::cerr << name << ": the cells were not read with 32-bit storage." << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfConnectivityIds(); ++i)
+  {
+    if (actual->GetConnectivityArray()->GetTuple1(i) !=
+      expected->GetConnectivityArray()->GetTuple1(i))
+    {
+      std::cerr << name << ": wrong connectivity id " << i << "." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestUnstructuredGrid(const std::string& fileName, vtkIdType numCells)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> cells;
+  MakeCells(points, cells);
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  if (numCells > 0)
+  {
+    grid->SetCells(VTK_TRIANGLE, cells);
+  }
+
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetIdTypeToInt64();
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(grid);
+  writer->Write();
+
+  vtkNew<vtkCellArray> noCells;
+  vtkCellArray* expected = numCells > 0 ? cells.Get() : noCells.Get();
+  for (bool compact : { false, true })
+  {
+    vtkNew<vtkXMLUnstructuredGridReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->SetCompactConnectivity(compact);
+    reader->Update();
+    vtkCellArray* actual = reader->GetOutput()->GetCells();
+    if (numCells == 0 && !actual)
+    {
+      actual = noCells;
+    }
+    if (!SameCells("vtkXMLUnstructuredGridReader", expected, actual, compact))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestPolyData(const std::string& fileName)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> cells;
+  MakeCells(points, cells);
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->SetPolys(cells);
+
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetIdTypeToInt64();
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(polyData);
+  writer->Write();
+
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->CompactConnectivityOn();
+  reader->Update();
+  if (!SameCells("vtkXMLPolyDataReader", cells, reader->GetOutput()->GetPolys(), true))
+  {
+    return false;
+  }
+
+  // The empty verts, lines and strips keep the default storage.
+  vtkNew<vtkCellArray> defaultCells;
+  vtkNew<vtkPolyData> empty;
+  if (empty->GetVerts()->IsStorage64Bit() != defaultCells->IsStorage64Bit() ||
+    reader->GetOutput()->GetLines()->IsStorage64Bit() != defaultCells->IsStorage64Bit())
+  {
+    std::cerr << "vtkXMLPolyDataReader: empty cell arrays were converted." << std::endl;
+    return false;
+  }
+  return true;
+}
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int TestXMLCompactConnectivity(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string dir(tempDir);
+  delete[] tempDir;
+  if (dir.empty())
+  {
+    std::cerr << "Could not determine temporary directory." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!TestUnstructuredGrid(dir + "/TestXMLCompactConnectivity.vtu", NumberOfCells) ||
+    !TestUnstructuredGrid(dir + "/TestXMLCompactConnectivityEmpty.vtu", 0) ||
+    !TestPolyData(dir + "/TestXMLCompactConnectivity.vtp"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
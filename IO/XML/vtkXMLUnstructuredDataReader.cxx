@@ -23,9 +23,11 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 #include "vtkXMLDataElement.h"
 
 #include <cassert>
@@ -74,6 +76,8 @@ vtkXMLUnstructuredDataReader::vtkXMLUnstructuredDataReader()
 
   this->PointsTimeStep = -1; // invalid state
   this->PointsOffset = static_cast<unsigned long>(-1);
+
+  this->CompactConnectivity = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -89,6 +93,7 @@ vtkXMLUnstructuredDataReader::~vtkXMLUnstructuredDataReader()
 void vtkXMLUnstructuredDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CompactConnectivity: " << (this->CompactConnectivity ? "On" : "Off") << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -288,6 +293,32 @@ void vtkXMLUnstructuredDataReader::ReadXMLData()
   }
 
   delete[] fractions;
+
+  // Pieces are appended to the output cell arrays, so their storage is
+  // only narrowed once all of them are read.
+  if (this->CompactConnectivity && !this->DataError && !this->AbortExecute)
+  {
+    // Without cells, the cell arrays may be null or shared empty arrays,
+    // which must not be converted.
+    auto compact = [](vtkCellArray* cells) {
+      if (cells && cells->GetNumberOfCells() > 0)
+      {
+        cells->ConvertToSmallestStorage();
+      }
+    };
+    vtkDataObject* output = this->GetCurrentOutput();
+    if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(output))
+    {
+      compact(grid->GetCells());
+    }
+    else if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(output))
+    {
+      compact(polyData->GetVerts());
+      compact(polyData->GetLines());
+      compact(polyData->GetPolys());
+      compact(polyData->GetStrips());
+    }
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -67,6 +67,18 @@ public:
   // SetupOutputInformation to outInfo
   void CopyOutputInformation(vtkInformation* outInfo, int port) override;
 
+  ///@{
+  /**
+   * When on, the cell connectivity of the output is converted to 32-bit
+   * storage after reading if all its ids and offsets fit, whatever the
+   * integer type used in the file. This halves the memory used by the
+   * topology of files written with 64-bit ids. Off by default.
+   */
+  vtkSetMacro(CompactConnectivity, vtkTypeBool);
+  vtkGetMacro(CompactConnectivity, vtkTypeBool);
+  vtkBooleanMacro(CompactConnectivity, vtkTypeBool);
+  ///@}
+
 protected:
   vtkXMLUnstructuredDataReader();
   ~vtkXMLUnstructuredDataReader() override;
@@ -128,6 +140,8 @@ protected:
 
   int PointsTimeStep;
   unsigned long PointsOffset;
+
+  vtkTypeBool CompactConnectivity;
   int PointsNeedToReadTimeStep(vtkXMLDataElement* eNested);
   int CellsNeedToReadTimeStep(
     vtkXMLDataElement* eNested, int& cellstimestep, unsigned long& cellsoffset);